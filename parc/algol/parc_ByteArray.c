@@ -74,6 +74,7 @@ struct parc_byte_array {
     uint8_t *array;
     size_t length;
     void (*freeFunction)(void **);
+    PARCObject *owner;
 };
 #define MAGIC 0x0ddba11c1a55e5
 
@@ -93,6 +94,9 @@ _parcByteArray_Destructor(PARCByteArray **byteArrayPtr)
             byteArray->freeFunction((void **) &(byteArray->array));
         }
     }
+    if (byteArray->owner != NULL) {
+        parcObject_Release(&byteArray->owner);
+    }
     return true;
 }
 
@@ -141,6 +145,7 @@ parcByteArray_Allocate(const size_t length)
         result->array = array;
         result->length = length;
         result->freeFunction = parcMemory_DeallocateImpl;
+        result->owner = NULL;
         return result;
     } else {
         parcMemory_Deallocate(&array);
@@ -157,12 +162,25 @@ parcByteArray_Wrap(const size_t length, uint8_t array[length])
             result->array = array;
             result->length = length;
             result->freeFunction = NULL;
+            result->owner = NULL;
             return result;
         }
     }
     return NULL;
 }
 
+PARCByteArray *
+parcByteArray_WrapOwned(const size_t length, uint8_t array[length], const PARCObject *owner)
+{
+    assertNotNull(owner, "Parameter owner must be a non-null PARCObject");
+
+    PARCByteArray *result = parcByteArray_Wrap(length, array);
+    if (result != NULL) {
+        result->owner = parcObject_Acquire(owner);
+    }
+    return result;
+}
+
 parcObject_ImplementAcquire(parcByteArray, PARCByteArray);
 
 parcObject_ImplementRelease(parcByteArray, PARCByteArray);
@@ -123,6 +123,7 @@ struct parc_byte_array;
 typedef struct parc_byte_array PARCByteArray;
 
 #include <parc/algol/parc_HashCode.h>
+#include <parc/algol/parc_Object.h>
 
 #ifdef PARCLibrary_DISABLE_VALIDATION
 #  define parcByteArray_OptionalAssertValid(_instance_)
@@ -200,6 +201,34 @@ PARCByteArray *parcByteArray_Allocate(const size_t capacity);
  */
 PARCByteArray *parcByteArray_Wrap(size_t capacity, uint8_t array[capacity]);
 
+/**
+ * Wrap existing memory, owned by another `PARCObject`, in a {@link PARCByteArray}.
+ *
+ * A copy of the memory is not made.
+ * Instead the `PARCByteArray` acquires a reference to @p owner and releases it when the `PARCByteArray` is destroyed,
+ * so the wrapped memory remains valid for as long as the `PARCByteArray`, or any `PARCBuffer` wrapping it, is alive.
+ *
+ * @param [in] capacity The maximum capacity of the backing array.
+ * @param [in] array A pointer to the backing array.
+ * @param [in] owner A pointer to a valid `PARCObject` instance that keeps @p array alive.
+ *
+ * @return A pointer to an allocated `PARCByteArray` instance which must be released via {@link parcByteArray_Release()}.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *storage = parcBuffer_Allocate(10);
+ *     PARCByteArray *byteArray = parcByteArray_WrapOwned(10, parcBuffer_Overlay(storage, 0), storage);
+ *     parcBuffer_Release(&storage);
+ *
+ *     parcByteArray_Release(&byteArray);
+ * }
+ * @endcode
+ *
+ * @see parcByteArray_Wrap
+ */
+PARCByteArray *parcByteArray_WrapOwned(size_t capacity, uint8_t array[capacity], const PARCObject *owner);
+
 /**
  * Returns the pointer to the `uint8_t` array that backs this `PARCByteArray`.
  *
@@ -59,6 +59,8 @@
 
 #include <config.h>
 #include <time.h>
+#include <stdbool.h>
+#include <pthread.h>
 #include <parc/algol/parc_Clock.h>
 
 #if __APPLE__
@@ -67,6 +69,11 @@
 #include <mach/mach_time.h>
 #endif
 
+#if defined(__x86_64__)
+#include <cpuid.h>
+#define _PARC_CLOCK_TSC 1
+#endif
+
 // These are used by the counter Clock
 #include <parc/algol/parc_AtomicInteger.h>
 #include <parc/algol/parc_Object.h>
@@ -257,6 +264,226 @@ parcClock_Monotonic(void)
     return &_monoclock;
 }
 
+// ==========================
+// TSC clock
+
+/*
+ * The cycle counter is converted to nanoseconds as
+ *
+ *     baseNanoseconds + ((cycles - baseCycles) * multiplier) >> 32
+ *
+ * where the multiplier is nanoseconds per cycle in 32.32 fixed point, measured against the
+ * monotonic system clock when the clock is first used.  The base is the moment the calibration
+ * finished, so the two clocks agree at that point.
+ */
+static struct {
+    uint64_t baseCycles;
+    uint64_t baseNanoseconds;
+    uint64_t multiplier;
+} _tscclock_Calibration;
+
+static pthread_once_t _tscclock_Once = PTHREAD_ONCE_INIT;
+
+// The time spent measuring the cycle counter against the system clock.
+#define _TSCCLOCK_CALIBRATION_NANOSECONDS 10000000ULL
+
+static uint64_t
+_tscclock_SystemNanoseconds(void)
+{
+#if __linux__
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#else
+    static mach_timebase_info_data_t timebase;
+    if (timebase.denom == 0) {
+        mach_timebase_info(&timebase);
+    }
+    return mach_absolute_time() * timebase.numer / timebase.denom;
+#endif
+}
+
+static uint64_t
+_tscclock_SystemGetTime(const PARCClock *clock __attribute__((unused)))
+{
+    return _tscclock_SystemNanoseconds();
+}
+
+#ifdef _PARC_CLOCK_TSC
+/*
+ * RDTSCP does not read the counter until all previous instructions have executed, so the
+ * measured interval cannot begin early.  Processors without it get the same guarantee from
+ * LFENCE before RDTSC.
+ */
+static inline uint64_t
+_tscclock_ReadRdtscp(void)
+{
+    uint32_t lo, hi;
+    __asm volatile ("rdtscp" : "=a" (lo), "=d" (hi) : : "ecx", "memory");
+    return ((uint64_t) hi << 32) | lo;
+}
+
+static inline uint64_t
+_tscclock_ReadLfence(void)
+{
+    uint32_t lo, hi;
+    __asm volatile ("lfence\n\trdtsc" : "=a" (lo), "=d" (hi) : : "memory");
+    return ((uint64_t) hi << 32) | lo;
+}
+
+/*
+ * The counters of different cores are not exactly in step, so a core that calibrated slightly
+ * ahead of the one reading it can see cycles before baseCycles.  The delta is signed so such a
+ * reading lands just before baseNanoseconds instead of wrapping around.
+ */
+static inline uint64_t
+_tscclock_ToNanoseconds(uint64_t cycles)
+{
+    int64_t delta = (int64_t) (cycles - _tscclock_Calibration.baseCycles);
+    if (delta < 0) {
+        unsigned __int128 before = (unsigned __int128) (uint64_t) -delta * _tscclock_Calibration.multiplier;
+        return _tscclock_Calibration.baseNanoseconds - (uint64_t) (before >> 32);
+    }
+    unsigned __int128 elapsed = (unsigned __int128) (uint64_t) delta * _tscclock_Calibration.multiplier;
+    return _tscclock_Calibration.baseNanoseconds + (uint64_t) (elapsed >> 32);
+}
+
+static uint64_t
+_tscclock_RdtscpGetTime(const PARCClock *clock __attribute__((unused)))
+{
+    return _tscclock_ToNanoseconds(_tscclock_ReadRdtscp());
+}
+
+static uint64_t
+_tscclock_LfenceGetTime(const PARCClock *clock __attribute__((unused)))
+{
+    return _tscclock_ToNanoseconds(_tscclock_ReadLfence());
+}
+
+/*
+ * The counter is only usable as a clock if it is invariant: it ticks at a constant rate in every
+ * P-, C- and T-state (CPUID 0x80000007, EDX bit 8).
+ */
+static bool
+_tscclock_IsInvariant(void)
+{
+    unsigned eax, ebx, ecx, edx;
+
+    if (__get_cpuid_max(0x80000000, NULL) >= 0x80000007) {
+        if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)) {
+            return (edx & (1 << 8)) != 0;
+        }
+    }
+    return false;
+}
+
+static bool
+_tscclock_HasRdtscp(void)
+{
+    unsigned eax, ebx, ecx, edx;
+
+    if (__get_cpuid_max(0x80000000, NULL) >= 0x80000001) {
+        if (__get_cpuid(0x80000001, &eax, &ebx, &ecx, &edx)) {
+            return (edx & (1 << 27)) != 0;
+        }
+    }
+    return false;
+}
+
+/*
+ * Read the cycle counter and the system clock at (nearly) the same instant.
+ * The system clock read is bracketed by two counter reads and the tightest of a few tries is kept.
+ */
+static void
+_tscclock_Sample(uint64_t (*read)(void), uint64_t *cycles, uint64_t *nanoseconds)
+{
+    uint64_t narrowest = UINT64_MAX;
+
+    for (int i = 0; i < 8; i++) {
+        uint64_t before = read();
+        uint64_t now = _tscclock_SystemNanoseconds();
+        uint64_t after = read();
+
+        if (after - before < narrowest) {
+            narrowest = after - before;
+            *cycles = before + (after - before) / 2;
+            *nanoseconds = now;
+        }
+    }
+}
+#endif // _PARC_CLOCK_TSC
+
+static void _tscclock_GetTimeval(const PARCClock *clock, struct timeval *output);
+static PARCClock *_tscclock_Acquire(const PARCClock *clock);
+static void _tscclock_Release(PARCClock **clockPtr);
+
+static PARCClock _tscclock = {
+    .closure    = NULL,
+    .getTime    = _tscclock_SystemGetTime,
+    .getTimeval = _tscclock_GetTimeval,
+    .acquire    = _tscclock_Acquire,
+    .release    = _tscclock_Release
+};
+
+static void
+_tscclock_Calibrate(void)
+{
+#ifdef _PARC_CLOCK_TSC
+    if (_tscclock_IsInvariant()) {
+        uint64_t (*read)(void) = _tscclock_HasRdtscp() ? _tscclock_ReadRdtscp : _tscclock_ReadLfence;
+
+        uint64_t cycles0, nanoseconds0, cycles1, nanoseconds1;
+        _tscclock_Sample(read, &cycles0, &nanoseconds0);
+
+        struct timespec pause = { .tv_sec = 0, .tv_nsec = _TSCCLOCK_CALIBRATION_NANOSECONDS };
+        while (nanosleep(&pause, &pause) != 0) {
+        }
+
+        _tscclock_Sample(read, &cycles1, &nanoseconds1);
+
+        if (cycles1 > cycles0 && nanoseconds1 > nanoseconds0) {
+            _tscclock_Calibration.multiplier = ((nanoseconds1 - nanoseconds0) << 32) / (cycles1 - cycles0);
+            _tscclock_Calibration.baseCycles = cycles1;
+            _tscclock_Calibration.baseNanoseconds = nanoseconds1;
+            _tscclock.getTime = (read == _tscclock_ReadRdtscp) ? _tscclock_RdtscpGetTime : _tscclock_LfenceGetTime;
+        }
+    }
+#endif // _PARC_CLOCK_TSC
+}
+
+static void
+_tscclock_GetTimeval(const PARCClock *clock, struct timeval *output)
+{
+    uint64_t nanoseconds = clock->getTime(clock);
+    output->tv_sec = nanoseconds / 1000000000ULL;
+    output->tv_usec = (nanoseconds % 1000000000ULL) / 1000;
+}
+
+static PARCClock *
+_tscclock_Acquire(const PARCClock *clock)
+{
+    return (PARCClock *) clock;
+}
+
+static void
+_tscclock_Release(PARCClock **clockPtr)
+{
+    *clockPtr = NULL;
+}
+
+PARCClock *
+parcClock_TSC(void)
+{
+    pthread_once(&_tscclock_Once, _tscclock_Calibrate);
+    return &_tscclock;
+}
+
+bool
+parcClock_IsTSC(const PARCClock *clock)
+{
+    return clock == &_tscclock && clock->getTime != _tscclock_SystemGetTime;
+}
+
 // ===========================
 // Facade API
 
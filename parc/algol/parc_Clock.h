@@ -62,6 +62,10 @@
  * @see parcClock_Monotonic()
  * and
  * @see parcClock_Wallclock()
+ * For timing short intervals there is a low-overhead monotonic clock driven by the processor's
+ * time stamp counter.
+ * @see parcClock_TSC()
+ *
  * Also provided is a counting clock.
  * @see parcClock_Counter()
  *
@@ -140,6 +144,7 @@
 #define PARC_parc_Clock_h
 
 #include <inttypes.h>
+#include <stdbool.h>
 #include <sys/time.h>
 
 struct parc_clock;
@@ -277,6 +282,56 @@ PARCClock *parcClock_Wallclock(void);
  */
 PARCClock *parcClock_Monotonic(void);
 
+/**
+ * A monotonic nanosecond clock read from the processor's time stamp counter
+ *
+ * On x86-64 processors with an invariant TSC, getTime() is a single RDTSCP (or LFENCE; RDTSC)
+ * instruction and a multiply, with no system call.  The cycles-to-nanoseconds rate is
+ * calibrated against CLOCK_MONOTONIC by the first call to this function, which takes about
+ * 10 milliseconds.  Elsewhere, or if the counter is not invariant, the clock reads
+ * CLOCK_MONOTONIC (the SYSTEM_CLOCK on Darwin) instead.
+ *
+ * getTime() returns nanoseconds on the CLOCK_MONOTONIC time line.  The two agree at
+ * calibration and drift apart only by the calibration error, a few parts per million.
+ * getTimeval() returns the same time in seconds and micro-seconds.
+ *
+ * @retval non-null A PARCClock, which must be released via parcClock_Release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCClock *clock = parcClock_TSC();
+ *     uint64_t start = parcClock_GetTime(clock);
+ *     // ... work to measure ...
+ *     uint64_t elapsedNanoseconds = parcClock_GetTime(clock) - start;
+ *     parcClock_Release(&clock);
+ * }
+ * @endcode
+ */
+PARCClock *parcClock_TSC(void);
+
+/**
+ * Determine if a clock is the time stamp counter clock and is reading the counter,
+ * rather than falling back to the system clock.
+ *
+ * @param [in] clock A clock provider
+ *
+ * @retval true The clock is `parcClock_TSC()` and reads the time stamp counter.
+ * @retval false Otherwise.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCClock *clock = parcClock_TSC();
+ *     if (parcClock_IsTSC(clock)) {
+ *         printf("Timing with the time stamp counter\n");
+ *     }
+ *     parcClock_Release(&clock);
+ * }
+ * @endcode
+ */
+bool parcClock_IsTSC(const PARCClock *clock);
+
 
 /**
  * The counter clock begins at 0 and increments for every call to getTime or getTimeval
@@ -95,16 +95,30 @@ PARCListInterface *PARCDequeAsPARCList = &(PARCListInterface) {
     .ToArray                = (void**    (*)(const void *))                               NULL,
 };
 
-struct parc_deque_node {
-    void *element;
-    struct parc_deque_node *previous;
-    struct parc_deque_node *next;
+/*
+ * The elements are stored in fixed size blocks of element slots, rather than one node per element.
+ * The blocks form a ring: `blocks` is an array of `blockCapacity` (a power of 2) block pointers,
+ * of which `blockCount` consecutive entries, starting at `firstBlock` and wrapping around,
+ * hold the elements.
+ * The first element is in slot `head` of the first block and the rest follow in order.
+ *
+ * Blocks that become empty stay in the ring and are reused by later additions,
+ * so a deque that repeatedly grows and shrinks within its high-water mark performs no allocations.
+ */
+#define _parcDeque_BlockSize 64
+#define _parcDeque_InitialBlockCapacity 4
+
+struct parc_deque_block {
+    void *element[_parcDeque_BlockSize];
 };
 
 struct parc_deque {
     PARCObjectDescriptor object;
-    struct parc_deque_node *head;
-    struct parc_deque_node *tail;
+    struct parc_deque_block **blocks;
+    size_t blockCapacity;
+    size_t firstBlock;
+    size_t blockCount;
+    size_t head;
     size_t size;
 };
 
@@ -120,37 +134,50 @@ _defaultElementEquals(const void *x, const void *y)
     return (x == y);
 }
 
-static inline struct parc_deque_node *
-_parcDequeNode_Create(void *element, struct parc_deque_node *previous, struct parc_deque_node *next)
+static inline size_t
+_parcDeque_RingIndex(const PARCDeque *deque, size_t blockOffset)
 {
-    struct parc_deque_node *result = parcMemory_Allocate(sizeof(struct parc_deque_node));
-    if (result != NULL) {
-        result->element = element;
-        result->next = next;
-        result->previous = previous;
-    }
+    return (deque->firstBlock + blockOffset) & (deque->blockCapacity - 1);
+}
 
-    return result;
+static inline void **
+_parcDeque_Slot(const PARCDeque *deque, size_t index)
+{
+    size_t position = deque->head + index;
+    struct parc_deque_block *block = deque->blocks[_parcDeque_RingIndex(deque, position / _parcDeque_BlockSize)];
+    return &block->element[position % _parcDeque_BlockSize];
 }
 
+/*
+ * Double the size of the ring, preserving the order of the blocks (including the unused ones),
+ * so that the first block is at index 0.
+ */
 static void
-_parcDequeNode_Destroy(PARCDeque *deque __attribute__((unused)), struct parc_deque_node **nodePtr)
+_parcDeque_GrowRing(PARCDeque *deque)
 {
-    struct parc_deque_node *node = *nodePtr;
+    size_t blockCapacity = (deque->blockCapacity == 0) ? _parcDeque_InitialBlockCapacity : deque->blockCapacity * 2;
 
-    parcMemory_Deallocate((void **) &node);
-    *nodePtr = 0;
+    struct parc_deque_block **blocks = parcMemory_AllocateAndClear(blockCapacity * sizeof(struct parc_deque_block *));
+    assertNotNull(blocks, "parcMemory_AllocateAndClear(%zu) returned NULL", blockCapacity * sizeof(struct parc_deque_block *));
+
+    for (size_t i = 0; i < deque->blockCapacity; i++) {
+        blocks[i] = deque->blocks[_parcDeque_RingIndex(deque, i)];
+    }
+    if (deque->blocks != NULL) {
+        parcMemory_Deallocate((void **) &deque->blocks);
+    }
+
+    deque->blocks = blocks;
+    deque->blockCapacity = blockCapacity;
+    deque->firstBlock = 0;
 }
 
 static void
-_parcDequeNode_AssertInvariants(struct parc_deque_node *node)
+_parcDeque_EnsureBlock(PARCDeque *deque, size_t ringIndex)
 {
-    assertNotNull(node, "Expected non-null node pointer.");
-    if (node->next != NULL) {
-        assertTrue(node->next->previous == node, "Expected next node to point to this node.");
-    }
-    if (node->previous != NULL) {
-        assertTrue(node->previous->next == node, "Expected previous node to point to this node.");
+    if (deque->blocks[ringIndex] == NULL) {
+        deque->blocks[ringIndex] = parcMemory_Allocate(sizeof(struct parc_deque_block));
+        assertNotNull(deque->blocks[ringIndex], "parcMemory_Allocate(%zu) returned NULL", sizeof(struct parc_deque_block));
     }
 }
 
@@ -158,14 +185,14 @@ static void
 _parcDeque_AssertInvariants(const PARCDeque *deque)
 {
     assertNotNull(deque, "Parameter cannot be null.");
-    if (deque->head != NULL) {
-        assertTrue(deque->size != 0, "PARCDeque head is not-null, but size is zero.");
-        assertNotNull(deque->tail, "PARCDeque head is not-null, but tail is null.");
-        _parcDequeNode_AssertInvariants(deque->head);
-        _parcDequeNode_AssertInvariants(deque->tail);
+    if (deque->size == 0) {
+        assertTrue(deque->blockCount == 0, "PARCDeque is empty, but is using %zd blocks.", deque->blockCount);
     } else {
-        assertNull(deque->tail, "PARCDeque head is null, but tail is not null.");
-        assertTrue(deque->size == 0, "PARCDeque head is null, but size is not zero.");
+        assertTrue(deque->blockCount <= deque->blockCapacity,
+                   "PARCDeque is using %zd blocks, but the ring has only %zd.", deque->blockCount, deque->blockCapacity);
+        assertTrue(deque->head < _parcDeque_BlockSize, "PARCDeque head %zd is outside of the first block.", deque->head);
+        assertTrue((deque->head + deque->size + _parcDeque_BlockSize - 1) / _parcDeque_BlockSize == deque->blockCount,
+                   "PARCDeque of %zd elements starting at %zd should not use %zd blocks.", deque->size, deque->head, deque->blockCount);
     }
 }
 
@@ -174,49 +201,49 @@ _parcDeque_Destroy(PARCDeque **dequePtr)
 {
     PARCDeque *deque = *dequePtr;
 
-    struct parc_deque_node *next = NULL; //deque->head;
-
-    for (struct parc_deque_node *node = deque->head; node != NULL; node = next) {
-        next = node->next;
-        _parcDequeNode_Destroy(deque, &node);
+    for (size_t i = 0; i < deque->blockCapacity; i++) {
+        if (deque->blocks[i] != NULL) {
+            parcMemory_Deallocate((void **) &deque->blocks[i]);
+        }
+    }
+    if (deque->blocks != NULL) {
+        parcMemory_Deallocate((void **) &deque->blocks);
     }
 }
 
-static struct parc_deque_node *
-_parcDequeNode_Init(PARCDeque *deque __attribute__((unused)))
+/*
+ * The iterator state is the number of elements already returned, so iterating allocates nothing.
+ */
+static void *
+_parcDequeIterator_Init(PARCDeque *deque __attribute__((unused)))
 {
-    return NULL;
+    return (void *) (uintptr_t) 0;
 }
 
 static bool
-_parcDequeNode_Fini(PARCDeque *deque __attribute__((unused)), const struct parc_deque_node *node __attribute__((unused)))
+_parcDequeIterator_Fini(PARCDeque *deque __attribute__((unused)), const void *state __attribute__((unused)))
 {
     return true;
 }
 
-static struct parc_deque_node *
-_parcDequeNode_Next(PARCDeque *deque __attribute__((unused)), const struct parc_deque_node *node)
+static void *
+_parcDequeIterator_Next(PARCDeque *deque, const void *state)
 {
-    if (node == NULL) {
-        return deque->head;
-    }
-    trapOutOfBoundsIf(node->next == NULL, "No more elements.");
-    return node->next;
+    size_t index = (uintptr_t) state;
+    trapOutOfBoundsIf(index >= deque->size, "No more elements.");
+    return (void *) (uintptr_t) (index + 1);
 }
 
 static bool
-_parcDequeNode_HasNext(PARCDeque *deque __attribute__((unused)), const struct parc_deque_node *node)
+_parcDequeIterator_HasNext(PARCDeque *deque, const void *state)
 {
-    if (node == NULL) {
-        return (deque->head != NULL);
-    }
-    return (node->next != NULL);
+    return (uintptr_t) state < deque->size;
 }
 
 static void *
-_parcDequeNode_Element(PARCDeque *deque __attribute__((unused)), const struct parc_deque_node *node)
+_parcDequeIterator_Element(PARCDeque *deque, const void *state)
 {
-    return node->element;
+    return *_parcDeque_Slot(deque, (uintptr_t) state - 1);
 }
 
 parcObject_ExtendPARCObject(PARCDeque, _parcDeque_Destroy, parcDeque_Copy, NULL, parcDeque_Equals, NULL, NULL, NULL);
@@ -228,8 +255,11 @@ _create(const PARCObjectDescriptor *interface)
 
     if (result != NULL) {
         result->object = *interface;
-        result->head = NULL;
-        result->tail = NULL;
+        result->blocks = NULL;
+        result->blockCapacity = 0;
+        result->firstBlock = 0;
+        result->blockCount = 0;
+        result->head = 0;
         result->size = 0;
     }
     return result;
@@ -239,12 +269,12 @@ PARCIterator *
 parcDeque_Iterator(PARCDeque *deque)
 {
     PARCIterator *iterator = parcIterator_Create(deque,
-                                                 (void *(*)(PARCObject *))_parcDequeNode_Init,
-                                                 (bool (*)(PARCObject *, void *))_parcDequeNode_HasNext,
-                                                 (void *(*)(PARCObject *, void *))_parcDequeNode_Next,
+                                                 (void *(*)(PARCObject *))_parcDequeIterator_Init,
+                                                 (bool (*)(PARCObject *, void *))_parcDequeIterator_HasNext,
+                                                 (void *(*)(PARCObject *, void *))_parcDequeIterator_Next,
                                                  NULL,
-                                                 (void *(*)(PARCObject *, void *))_parcDequeNode_Element,
-                                                 (void  (*)(PARCObject *, void *))_parcDequeNode_Fini,
+                                                 (void *(*)(PARCObject *, void *))_parcDequeIterator_Element,
+                                                 (void  (*)(PARCObject *, void *))_parcDequeIterator_Fini,
                                                  NULL);
 
     return iterator;
@@ -290,11 +320,8 @@ parcDeque_Copy(const PARCDeque *deque)
 {
     PARCDeque *result = _create(&deque->object);
 
-    struct parc_deque_node *node = deque->head;
-
-    while (node != NULL) {
-        parcDeque_Append(result, deque->object.copy(node->element));
-        node = node->next;
+    for (size_t i = 0; i < deque->size; i++) {
+        parcDeque_Append(result, deque->object.copy(*_parcDeque_Slot(deque, i)));
     }
 
     return result;
@@ -303,19 +330,15 @@ parcDeque_Copy(const PARCDeque *deque)
 PARCDeque *
 parcDeque_Append(PARCDeque *deque, void *element)
 {
-    struct parc_deque_node *node = _parcDequeNode_Create(element, deque->tail, NULL);
-
-    if (deque->tail == NULL) {
-        deque->tail = node;
-    } else {
-        deque->tail->next = node;
-        deque->tail = node;
-    }
-
-    if (deque->head == NULL) {
-        deque->head = deque->tail;
+    if (deque->head + deque->size == deque->blockCount * _parcDeque_BlockSize) {
+        if (deque->blockCount == deque->blockCapacity) {
+            _parcDeque_GrowRing(deque);
+        }
+        _parcDeque_EnsureBlock(deque, _parcDeque_RingIndex(deque, deque->blockCount));
+        deque->blockCount++;
     }
 
+    *_parcDeque_Slot(deque, deque->size) = element;
     deque->size++;
 
     return deque;
@@ -324,21 +347,20 @@ parcDeque_Append(PARCDeque *deque, void *element)
 PARCDeque *
 parcDeque_Prepend(PARCDeque *deque, void *element)
 {
-    struct parc_deque_node *node = _parcDequeNode_Create(element, NULL, deque->head);
-
-    if (deque->head == NULL) {
-        deque->head = node;
-    } else {
-        deque->head->previous = node;
-        deque->head = node;
+    if (deque->head == 0) {
+        if (deque->blockCount == deque->blockCapacity) {
+            _parcDeque_GrowRing(deque);
+        }
+        deque->firstBlock = _parcDeque_RingIndex(deque, deque->blockCapacity - 1);
+        _parcDeque_EnsureBlock(deque, deque->firstBlock);
+        deque->blockCount++;
+        deque->head = _parcDeque_BlockSize;
     }
 
-    if (deque->tail == NULL) {
-        deque->tail = deque->head;
-    }
+    deque->head--;
+    deque->blocks[deque->firstBlock]->element[deque->head] = element;
     deque->size++;
 
-    _parcDequeNode_AssertInvariants(node);
     _parcDeque_AssertInvariants(deque);
 
     return deque;
@@ -349,18 +371,19 @@ parcDeque_RemoveFirst(PARCDeque *deque)
 {
     void *result = NULL;
 
-    if (deque->head != NULL) {
-        struct parc_deque_node *node = deque->head;
-        result = node->element;
-        if (deque->head == deque->tail) {
-            deque->head = NULL;
-            deque->tail = NULL;
-        } else {
-            deque->head = node->next;
-            deque->head->previous = NULL;
-        }
-        parcMemory_Deallocate((void **) &node);
+    if (deque->size > 0) {
+        result = *_parcDeque_Slot(deque, 0);
+        deque->head++;
         deque->size--;
+
+        if (deque->size == 0) {
+            deque->blockCount = 0;
+            deque->head = 0;
+        } else if (deque->head == _parcDeque_BlockSize) {
+            deque->firstBlock = _parcDeque_RingIndex(deque, 1);
+            deque->blockCount--;
+            deque->head = 0;
+        }
     }
 
     _parcDeque_AssertInvariants(deque);
@@ -373,14 +396,16 @@ parcDeque_RemoveLast(PARCDeque *deque)
 {
     void *result = NULL;
 
-    if (deque->tail != NULL) {
-        struct parc_deque_node *node = deque->tail;
-        deque->tail = node->previous;
-        deque->tail->next = NULL;
-
-        result = node->element;
-        parcMemory_Deallocate((void **) &node);
+    if (deque->size > 0) {
+        result = *_parcDeque_Slot(deque, deque->size - 1);
         deque->size--;
+
+        if (deque->size == 0) {
+            deque->blockCount = 0;
+            deque->head = 0;
+        } else if (deque->head + deque->size <= (deque->blockCount - 1) * _parcDeque_BlockSize) {
+            deque->blockCount--;
+        }
     }
 
     _parcDeque_AssertInvariants(deque);
@@ -392,9 +417,8 @@ parcDeque_PeekFirst(const PARCDeque *deque)
 {
     void *result = NULL;
 
-    if (deque->head != NULL) {
-        struct parc_deque_node *node = deque->head;
-        result = node->element;
+    if (deque->size > 0) {
+        result = *_parcDeque_Slot(deque, 0);
     }
     return result;
 }
@@ -404,9 +428,8 @@ parcDeque_PeekLast(const PARCDeque *deque)
 {
     void *result = NULL;
 
-    if (deque->tail != NULL) {
-        struct parc_deque_node *node = deque->tail;
-        result = node->element;
+    if (deque->size > 0) {
+        result = *_parcDeque_Slot(deque, deque->size - 1);
     }
     return result;
 }
@@ -426,15 +449,11 @@ parcDeque_IsEmpty(const PARCDeque *deque)
 void *
 parcDeque_GetAtIndex(const PARCDeque *deque, size_t index)
 {
-    if (index > (parcDeque_Size(deque) - 1)) {
+    if (index >= parcDeque_Size(deque)) {
         trapOutOfBounds(index, "[0, %zd]", parcDeque_Size(deque) - 1);
     }
-    struct parc_deque_node *node = deque->head;
-    while (index--) {
-        node = node->next;
-    }
 
-    return node->element;
+    return *_parcDeque_Slot(deque, index);
 }
 
 bool
@@ -449,15 +468,10 @@ parcDeque_Equals(const PARCDeque *x, const PARCDeque *y)
 
     if (x->object.equals == y->object.equals) {
         if (x->size == y->size) {
-            struct parc_deque_node *xNode = x->head;
-            struct parc_deque_node *yNode = y->head;
-
-            while (xNode != NULL) {
-                if (x->object.equals(xNode->element, yNode->element) == false) {
+            for (size_t i = 0; i < x->size; i++) {
+                if (x->object.equals(*_parcDeque_Slot(x, i), *_parcDeque_Slot(y, i)) == false) {
                     return false;
                 }
-                xNode = xNode->next;
-                yNode = yNode->next;
             }
             return true;
         }
@@ -471,15 +485,11 @@ parcDeque_Display(const PARCDeque *deque, const int indentation)
     if (deque == NULL) {
         parcDisplayIndented_PrintLine(indentation, "PARCDeque@NULL");
     } else {
-        parcDisplayIndented_PrintLine(indentation, "PARCDeque@%p {", (void *) deque);
-
-        struct parc_deque_node *node = deque->head;
+        parcDisplayIndented_PrintLine(indentation, "PARCDeque@%p { .size=%zd, .blocks=%zd/%zd, .head=%zd",
+                                      (void *) deque, deque->size, deque->blockCount, deque->blockCapacity, deque->head);
 
-        while (node != NULL) {
-            parcDisplayIndented_PrintLine(indentation + 1,
-                                          ".previous=%11p, %11p=%11p, .next=%11p",
-                                          node->previous, node, node->element, node->next);
-            node = node->next;
+        for (size_t i = 0; i < deque->size; i++) {
+            parcDisplayIndented_PrintLine(indentation + 1, "[%zd]=%11p", i, *_parcDeque_Slot(deque, i));
         }
 
         parcDisplayIndented_PrintLine(indentation, "}\n");
@@ -74,6 +74,11 @@ struct parc_deque;
 /**
  * A double-ended queue.
  *
+ * Elements are stored in a ring of fixed size blocks rather than in individually allocated nodes.
+ * Adding and removing at either end, and getting an element by index, take constant time.
+ * Blocks emptied by removal are kept and reused, so adding elements allocates memory only
+ * when the deque grows beyond the largest size it has previously had.
+ *
  * @see {@link parcDeque_Create}
  * @see {@link parcDeque_CreateCustom}
  */
@@ -320,6 +325,8 @@ bool parcDeque_IsEmpty(const PARCDeque *deque);
 /**
  * Get a pointer to the specified element.
  *
+ * This takes constant time.
+ *
  * @param [in] deque A pointer to a `PARCDeque` instance.
  * @param [in] index The index of the element to be retrieved.
  *
@@ -64,6 +64,7 @@
 #include <parc/algol/parc_EventScheduler.h>
 #include <parc/algol/parc_Event.h>
 #include <parc/algol/parc_FileOutputStream.h>
+#include <parc/developer/parc_Trace.h>
 #include <parc/logging/parc_Log.h>
 #include <parc/logging/parc_LogReporterFile.h>
 
@@ -104,6 +105,7 @@ _parc_event_callback(evutil_socket_t fd, short flags, void *context)
     PARCEvent *parcEvent = (PARCEvent *) context;
     parcEvent_LogDebug(parcEvent, "_parc_event_callback(fd=%x,flags=%x,parcEvent=%p)\n", fd, flags, parcEvent);
 
+    parcTrace_Scope("PARCEventScheduler", "event");
     parcEvent->callback((int) fd, internal_libevent_type_to_PARCEventType(flags), parcEvent->callbackUserData);
 }
 
@@ -64,6 +64,7 @@
 #include <parc/algol/parc_Event.h>
 #include <parc/algol/parc_EventBuffer.h>
 #include <parc/algol/parc_FileOutputStream.h>
+#include <parc/algol/parc_Object.h>
 #include <parc/logging/parc_Log.h>
 #include <parc/logging/parc_LogReporterFile.h>
 
@@ -263,6 +264,37 @@ parcEventBuffer_Append(PARCEventBuffer *parcEventBuffer, void *data, size_t leng
     return evbuffer_add(parcEventBuffer->evbuffer, data, length);
 }
 
+static void
+_parcEventBuffer_ReleaseReference(const void *data, size_t length, void *extra)
+{
+    PARCBuffer *buffer = (PARCBuffer *) extra;
+    parcBuffer_Release(&buffer);
+}
+
+int
+parcEventBuffer_AppendPARCBuffer(PARCEventBuffer *parcEventBuffer, PARCBuffer *buffer)
+{
+    parcEventBuffer_OptionalAssertValid(parcEventBuffer);
+    assertNotNull(buffer, "parcEventBuffer_AppendPARCBuffer was passed a null PARCBuffer\n");
+
+    size_t length = parcBuffer_Remaining(buffer);
+    if (length == 0) {
+        return 0;
+    }
+
+    uint8_t *data = parcBuffer_Overlay(buffer, 0);
+    if (length < PARCEventBuffer_ReferenceThreshold) {
+        return evbuffer_add(parcEventBuffer->evbuffer, data, length);
+    }
+
+    PARCBuffer *reference = parcBuffer_Acquire(buffer);
+    int result = evbuffer_add_reference(parcEventBuffer->evbuffer, data, length, _parcEventBuffer_ReleaseReference, reference);
+    if (result != 0) {
+        parcBuffer_Release(&reference);
+    }
+    return result;
+}
+
 int
 parcEventBuffer_Prepend(PARCEventBuffer *readBuffer, void *data, size_t length)
 {
@@ -274,6 +306,114 @@ parcEventBuffer_Prepend(PARCEventBuffer *readBuffer, void *data, size_t length)
     return evbuffer_prepend(readBuffer->evbuffer, data, length);
 }
 
+/**
+ * A segment of a PARCEventBuffer that has been handed out as a PARCBuffer view.
+ *
+ * The evbuffer holds the libevent chain backing the view, so the chain memory is not freed or reused
+ * until the last PARCBuffer referring to it is released.
+ */
+typedef struct {
+    struct evbuffer *evbuffer;
+} _PARCEventBufferSegment;
+
+static bool
+_parcEventBufferSegment_Destructor(_PARCEventBufferSegment **segmentPtr)
+{
+    evbuffer_free((*segmentPtr)->evbuffer);
+    return true;
+}
+
+parcObject_Override(_PARCEventBufferSegment, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcEventBufferSegment_Destructor);
+
+size_t
+parcEventBuffer_GetContiguousLength(PARCEventBuffer *parcEventBuffer)
+{
+    parcEventBuffer_OptionalAssertValid(parcEventBuffer);
+
+    struct evbuffer_iovec extent;
+    if (evbuffer_peek(parcEventBuffer->evbuffer, -1, NULL, &extent, 1) < 1) {
+        return 0;
+    }
+    return extent.iov_len;
+}
+
+/*
+ * Move the first chain of the source, which holds at least `length` bytes, into an evbuffer owned by a
+ * _PARCEventBufferSegment, and wrap the bytes in a PARCBuffer that keeps the segment alive.
+ *
+ * If the chain holds more than `length` bytes, the segment references the chain (which libevent then treats as
+ * immutable) and the chain itself, less the bytes read, is returned to the front of the source.
+ */
+static PARCBuffer *
+_parcEventBuffer_ReadView(struct evbuffer *source, size_t chainLength, size_t length)
+{
+    struct evbuffer *chain = evbuffer_new();
+    assertNotNull(chain, "libevent returned a null evbuffer.\n");
+    if (evbuffer_remove_buffer(source, chain, chainLength) != (int) chainLength) {
+        evbuffer_prepend_buffer(source, chain);
+        evbuffer_free(chain);
+        return NULL;
+    }
+
+    struct evbuffer *view = chain;
+    if (chainLength > length) {
+        view = evbuffer_new();
+        assertNotNull(view, "libevent returned a null evbuffer.\n");
+        if (evbuffer_add_buffer_reference(view, chain) != 0) {
+            evbuffer_prepend_buffer(source, chain);
+            evbuffer_free(chain);
+            evbuffer_free(view);
+            return NULL;
+        }
+        evbuffer_drain(chain, length);
+        evbuffer_prepend_buffer(source, chain);
+        evbuffer_free(chain);
+    }
+
+    struct evbuffer_iovec extent;
+    evbuffer_peek(view, length, NULL, &extent, 1);
+
+    _PARCEventBufferSegment *segment = parcObject_CreateInstance(_PARCEventBufferSegment);
+    assertNotNull(segment, "parcObject_CreateInstance returned NULL");
+    segment->evbuffer = view;
+
+    PARCByteArray *array = parcByteArray_WrapOwned(length, extent.iov_base, segment);
+    PARCBuffer *result = parcBuffer_WrapByteArray(array, 0, length);
+    parcByteArray_Release(&array);
+    parcObject_Release((PARCObject **) &segment);
+
+    return result;
+}
+
+PARCBuffer *
+parcEventBuffer_ReadPARCBuffer(PARCEventBuffer *parcEventBuffer, size_t length)
+{
+    parcEventBuffer_OptionalAssertValid(parcEventBuffer);
+
+    size_t available = evbuffer_get_length(parcEventBuffer->evbuffer);
+    if (length > available) {
+        length = available;
+    }
+
+    if (length >= PARCEventBuffer_ReferenceThreshold) {
+        struct evbuffer_iovec extent;
+        if (evbuffer_peek(parcEventBuffer->evbuffer, length, NULL, &extent, 1) == 1) {
+            PARCBuffer *result = _parcEventBuffer_ReadView(parcEventBuffer->evbuffer, extent.iov_len, length);
+            if (result != NULL) {
+                return result;
+            }
+        }
+    }
+
+    PARCBuffer *result = parcBuffer_Allocate(length);
+    assertNotNull(result, "parcBuffer_Allocate(%zu) returned NULL", length);
+    if (length > 0) {
+        evbuffer_remove(parcEventBuffer->evbuffer, parcBuffer_Overlay(result, 0), length);
+    }
+    return result;
+}
+
 PARCEventBuffer *
 parcEventBuffer_GetQueueBufferInput(PARCEventQueue *queue)
 {
@@ -69,6 +69,7 @@
 #define libparc_parc_EventBuffer_h
 
 #include <parc/algol/parc_EventQueue.h>
+#include <parc/algol/parc_Buffer.h>
 
 #ifdef PARCLibrary_DISABLE_VALIDATION
 #  define parcEventBuffer_OptionalAssertValid(_instance_)
@@ -82,6 +83,11 @@
  */
 typedef struct PARCEventBuffer PARCEventBuffer;
 
+/**
+ * PARCBuffers with fewer remaining bytes than this are copied by parcEventBuffer_AppendPARCBuffer rather than referenced.
+ */
+#define PARCEventBuffer_ReferenceThreshold 2048
+
 /**
  * Create an event buffer instance.
  *
@@ -312,6 +318,81 @@ int parcEventBuffer_AppendBuffer(PARCEventBuffer *source, PARCEventBuffer *desti
  */
 int parcEventBuffer_Append(PARCEventBuffer *parcEventBuffer, void *sourceData, size_t length);
 
+/**
+ * Append the remaining content of a PARCBuffer to a parcEventBuffer by reference
+ *
+ * The bytes between the position and the limit of the PARCBuffer are not copied.
+ * Instead the PARCBuffer is acquired and released once the parcEventBuffer no longer references its memory,
+ * e.g. after the bytes have been written to a socket or drained.
+ * Buffers shorter than `PARCEventBuffer_ReferenceThreshold` bytes are copied,
+ * as referencing them costs more than the copy.
+ *
+ * The position of the PARCBuffer is not changed.
+ * The referenced content must not be modified until the PARCBuffer is released by the parcEventBuffer.
+ *
+ * @param [in] parcEventBuffer - The buffer to write into
+ * @param [in] buffer - The PARCBuffer whose remaining bytes are to be appended
+ * @returns 0 on success, -1 on failure
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *message = parcBuffer_WrapCString("hello");
+ *     int result = parcEventBuffer_AppendPARCBuffer(parcEventBuffer, message);
+ *     parcBuffer_Release(&message);
+ * }
+ * @endcode
+ *
+ */
+int parcEventBuffer_AppendPARCBuffer(PARCEventBuffer *parcEventBuffer, PARCBuffer *buffer);
+
+/**
+ * Remove bytes from the front of a parcEventBuffer and return them as a PARCBuffer
+ *
+ * When the bytes lie in a single segment of the parcEventBuffer they are not copied:
+ * the returned PARCBuffer is a view of the segment and keeps it alive until the PARCBuffer is released.
+ * Otherwise the bytes are copied, once, into a newly allocated PARCBuffer.
+ * The returned PARCBuffer is read-only and must not be modified.
+ *
+ * Views share state with the parcEventBuffer they were taken from and must be released on the thread that
+ * uses the parcEventBuffer.
+ *
+ * @param [in] parcEventBuffer - The buffer to read from
+ * @param [in] length - The number of bytes to read, clamped to the length of the parcEventBuffer
+ * @returns A PARCBuffer positioned at the first byte read, which must be released via parcBuffer_Release
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *message = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, messageLength);
+ *     ...
+ *     parcBuffer_Release(&message);
+ * }
+ * @endcode
+ *
+ */
+PARCBuffer *parcEventBuffer_ReadPARCBuffer(PARCEventBuffer *parcEventBuffer, size_t length);
+
+/**
+ * Return the number of bytes at the front of a parcEventBuffer that are held in one contiguous segment
+ *
+ * parcEventBuffer_ReadPARCBuffer returns up to this many bytes without copying them,
+ * unless fewer than `PARCEventBuffer_ReferenceThreshold` bytes are read, which are still copied.
+ *
+ * @param [in] parcEventBuffer - The buffer to examine
+ * @returns The length of the first segment of the parcEventBuffer, 0 if it is empty
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t length = parcEventBuffer_GetContiguousLength(parcEventBuffer);
+ *     PARCBuffer *segment = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, length);
+ * }
+ * @endcode
+ *
+ */
+size_t parcEventBuffer_GetContiguousLength(PARCEventBuffer *parcEventBuffer);
+
 /**
  * Prepend data to the associated parcEventBuffer
  *
@@ -0,0 +1,790 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#ifdef HAVE_LINUX_IO_URING_H
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_ByteArray.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Event.h>
+#include <parc/algol/parc_EventTimer.h>
+#include <parc/algol/parc_EventIOEngine.h>
+#include <parc/developer/parc_Trace.h>
+
+typedef enum {
+    _PARCEventIOEngineOperation_Receive,
+    _PARCEventIOEngineOperation_Send,
+    _PARCEventIOEngineOperation_Read,
+    _PARCEventIOEngineOperation_Write
+} _PARCEventIOEngineOperation;
+
+typedef struct parc_event_io_engine_request {
+    // Every outstanding request, so Destroy can reclaim them.
+    struct parc_event_io_engine_request *previous;
+    struct parc_event_io_engine_request *next;
+
+    // Requests queued but not yet submitted on the fallback path.
+    struct parc_event_io_engine_request *nextPending;
+
+    PARCEventIOEngine *engine;
+    _PARCEventIOEngineOperation operation;
+    int fd;
+    off_t offset;
+    PARCBuffer *buffer;
+    PARCEventIOEngine_Callback *callback;
+    void *userData;
+
+    // Fallback path: waiting for a socket to become ready after EAGAIN.
+    PARCEvent *readiness;
+
+    // io_uring: Destroy has asked the kernel to cancel the request.
+    bool cancelled;
+} _PARCEventIOEngineRequest;
+
+#ifdef HAVE_LINUX_IO_URING_H
+/**
+ * The mapped submission and completion rings, driven with the raw system calls.
+ */
+typedef struct parc_event_io_engine_ring {
+    int fd;
+
+    void *sqRing;
+    size_t sqRingSize;
+    volatile unsigned *sqHead;
+    volatile unsigned *sqTail;
+    unsigned sqMask;
+    unsigned sqEntries;
+    unsigned *sqArray;
+    struct io_uring_sqe *sqes;
+    size_t sqesSize;
+
+    void *cqRing;
+    size_t cqRingSize;
+    volatile unsigned *cqHead;
+    volatile unsigned *cqTail;
+    unsigned cqMask;
+    struct io_uring_cqe *cqes;
+
+    unsigned localTail;
+    unsigned toSubmit;
+    bool buffersRegistered;
+
+    int eventFd;
+    PARCEvent *completionEvent;
+} _PARCEventIOEngineRing;
+#endif
+
+struct PARCEventIOEngine {
+    PARCEventScheduler *scheduler;
+    PARCBufferPool *pool;
+    size_t depth;
+    size_t outstanding;
+    uint64_t systemCalls;
+    _PARCEventIOEngineRequest *requests;
+
+    size_t registeredCount;
+    size_t nextRegistered;
+    PARCBuffer **registered;
+
+    bool isAsynchronous;
+
+    // Fallback path.
+    _PARCEventIOEngineRequest *pendingHead;
+    _PARCEventIOEngineRequest *pendingTail;
+    size_t pendingCount;
+    PARCEventTimer *deferred;
+    bool deferredArmed;
+
+#ifdef HAVE_LINUX_IO_URING_H
+    _PARCEventIOEngineRing ring;
+#endif
+};
+
+static void *
+_parcEventIOEngine_Address(PARCBuffer *buffer)
+{
+    return parcBuffer_Overlay(buffer, 0);
+}
+
+static void
+_parcEventIOEngine_Unlink(PARCEventIOEngine *engine, _PARCEventIOEngineRequest *request)
+{
+    if (request->previous != NULL) {
+        request->previous->next = request->next;
+    } else {
+        engine->requests = request->next;
+    }
+    if (request->next != NULL) {
+        request->next->previous = request->previous;
+    }
+    engine->outstanding--;
+}
+
+static void
+_parcEventIOEngine_Complete(PARCEventIOEngine *engine, _PARCEventIOEngineRequest *request, ssize_t result)
+{
+    if (result > 0) {
+        parcBuffer_SetPosition(request->buffer, parcBuffer_Position(request->buffer) + result);
+    }
+
+    _parcEventIOEngine_Unlink(engine, request);
+
+    {
+        parcTrace_Scope("PARCEventScheduler", "io.complete");
+        request->callback(engine, request->buffer, result, request->userData);
+    }
+
+    parcBuffer_Release(&request->buffer);
+    parcMemory_Deallocate((void **) &request);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Fallback: ordinary non-blocking system calls issued from the scheduler.
+
+static void _parcEventIOEngine_Perform(PARCEventIOEngine *engine, _PARCEventIOEngineRequest *request);
+static size_t _parcEventIOEngine_SubmitDeferred(PARCEventIOEngine *engine);
+
+static void
+_parcEventIOEngine_Ready(int fd, PARCEventType type, void *userData)
+{
+    _PARCEventIOEngineRequest *request = userData;
+
+    PARCEventIOEngine *engine = request->engine;
+
+    parcEvent_Destroy(&request->readiness);
+    _parcEventIOEngine_Perform(engine, request);
+    _parcEventIOEngine_SubmitDeferred(engine);
+}
+
+static void
+_parcEventIOEngine_Perform(PARCEventIOEngine *engine, _PARCEventIOEngineRequest *request)
+{
+    void *address = _parcEventIOEngine_Address(request->buffer);
+    size_t length = parcBuffer_Remaining(request->buffer);
+
+    ssize_t result = 0;
+    switch (request->operation) {
+        case _PARCEventIOEngineOperation_Receive:
+            result = recv(request->fd, address, length, MSG_DONTWAIT);
+            break;
+        case _PARCEventIOEngineOperation_Send:
+            result = send(request->fd, address, length, MSG_DONTWAIT | MSG_NOSIGNAL);
+            break;
+        case _PARCEventIOEngineOperation_Read:
+            result = (request->offset < 0) ? read(request->fd, address, length)
+                                           : pread(request->fd, address, length, request->offset);
+            break;
+        case _PARCEventIOEngineOperation_Write:
+            result = (request->offset < 0) ? write(request->fd, address, length)
+                                           : pwrite(request->fd, address, length, request->offset);
+            break;
+    }
+    engine->systemCalls++;
+
+    if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        PARCEventType wait = (request->operation == _PARCEventIOEngineOperation_Receive
+                              || request->operation == _PARCEventIOEngineOperation_Read) ? PARCEventType_Read : PARCEventType_Write;
+        request->readiness = parcEvent_Create(engine->scheduler, request->fd, wait, _parcEventIOEngine_Ready, request);
+        parcEvent_Start(request->readiness);
+        return;
+    }
+
+    _parcEventIOEngine_Complete(engine, request, (result < 0) ? -errno : result);
+}
+
+static void
+_parcEventIOEngine_RunDeferred(int fd, PARCEventType type, void *userData)
+{
+    PARCEventIOEngine *engine = userData;
+    engine->deferredArmed = false;
+
+    _PARCEventIOEngineRequest *request = engine->pendingHead;
+    engine->pendingHead = NULL;
+    engine->pendingTail = NULL;
+    engine->pendingCount = 0;
+
+    while (request != NULL) {
+        _PARCEventIOEngineRequest *next = request->nextPending;
+        _parcEventIOEngine_Perform(engine, request);
+        request = next;
+    }
+
+    // Requests queued by the callbacks run on the next pass of the scheduler.
+    _parcEventIOEngine_SubmitDeferred(engine);
+}
+
+static size_t
+_parcEventIOEngine_SubmitDeferred(PARCEventIOEngine *engine)
+{
+    if (engine->pendingCount > 0 && !engine->deferredArmed) {
+        struct timeval now = { 0, 0 };
+        parcEventTimer_Start(engine->deferred, &now);
+        engine->deferredArmed = true;
+    }
+    return engine->pendingCount;
+}
+
+// ------------------------------------------------------------------------------------------------
+// io_uring
+
+#ifdef HAVE_LINUX_IO_URING_H
+static int
+_parcEventIOEngineRing_Enter(_PARCEventIOEngineRing *ring, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return (int) syscall(__NR_io_uring_enter, ring->fd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static size_t
+_parcEventIOEngineRing_Submit(PARCEventIOEngine *engine)
+{
+    _PARCEventIOEngineRing *ring = &engine->ring;
+
+    size_t submitted = 0;
+    while (ring->toSubmit > 0) {
+        int result = _parcEventIOEngineRing_Enter(ring, ring->toSubmit, 0, 0);
+        engine->systemCalls++;
+        if (result <= 0) {
+            // EAGAIN/EBUSY: the kernel is short of resources, the entries stay queued for the next submit.
+            break;
+        }
+        ring->toSubmit -= result;
+        submitted += result;
+    }
+    return submitted;
+}
+
+/*
+ * Return the next free submission queue entry, cleared, or NULL if the queue stays full after a submit.
+ */
+static struct io_uring_sqe *
+_parcEventIOEngineRing_GetSqe(PARCEventIOEngine *engine)
+{
+    _PARCEventIOEngineRing *ring = &engine->ring;
+
+    __sync_synchronize();
+    if (ring->localTail - *ring->sqHead >= ring->sqEntries) {
+        _parcEventIOEngineRing_Submit(engine);
+        __sync_synchronize();
+        if (ring->localTail - *ring->sqHead >= ring->sqEntries) {
+            return NULL;
+        }
+    }
+
+    struct io_uring_sqe *sqe = &ring->sqes[ring->localTail & ring->sqMask];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+/*
+ * Publish the entry returned by the last `_parcEventIOEngineRing_GetSqe` to the kernel.
+ */
+static void
+_parcEventIOEngineRing_PushSqe(_PARCEventIOEngineRing *ring)
+{
+    unsigned index = ring->localTail & ring->sqMask;
+    ring->sqArray[index] = index;
+    ring->localTail++;
+    __sync_synchronize();
+    *ring->sqTail = ring->localTail;
+    ring->toSubmit++;
+}
+
+static bool
+_parcEventIOEngineRing_Queue(PARCEventIOEngine *engine, _PARCEventIOEngineRequest *request, int registeredIndex)
+{
+    struct io_uring_sqe *sqe = _parcEventIOEngineRing_GetSqe(engine);
+    if (sqe == NULL) {
+        return false;
+    }
+
+    sqe->fd = request->fd;
+    sqe->addr = (uint64_t) (uintptr_t) _parcEventIOEngine_Address(request->buffer);
+    sqe->len = (uint32_t) parcBuffer_Remaining(request->buffer);
+    sqe->user_data = (uint64_t) (uintptr_t) request;
+
+    switch (request->operation) {
+        case _PARCEventIOEngineOperation_Receive:
+            sqe->opcode = IORING_OP_RECV;
+            break;
+        case _PARCEventIOEngineOperation_Send:
+            sqe->opcode = IORING_OP_SEND;
+            sqe->msg_flags = MSG_NOSIGNAL;
+            break;
+        case _PARCEventIOEngineOperation_Read:
+        case _PARCEventIOEngineOperation_Write:
+            sqe->off = (request->offset < 0) ? (uint64_t) -1 : (uint64_t) request->offset;
+            if (registeredIndex >= 0) {
+                sqe->opcode = (request->operation == _PARCEventIOEngineOperation_Read) ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                sqe->buf_index = (uint16_t) registeredIndex;
+            } else {
+                sqe->opcode = (request->operation == _PARCEventIOEngineOperation_Read) ? IORING_OP_READ : IORING_OP_WRITE;
+            }
+            break;
+    }
+
+    _parcEventIOEngineRing_PushSqe(&engine->ring);
+    return true;
+}
+
+static void
+_parcEventIOEngineRing_Reap(int fd, PARCEventType type, void *userData)
+{
+    PARCEventIOEngine *engine = userData;
+    _PARCEventIOEngineRing *ring = &engine->ring;
+
+    uint64_t signals;
+    ssize_t nread = read(ring->eventFd, &signals, sizeof(signals));
+    (void) nread;
+    engine->systemCalls++;
+
+    for (;;) {
+        __sync_synchronize();
+        unsigned head = *ring->cqHead;
+        if (head == *ring->cqTail) {
+            break;
+        }
+        struct io_uring_cqe *cqe = &ring->cqes[head & ring->cqMask];
+        _PARCEventIOEngineRequest *request = (_PARCEventIOEngineRequest *) (uintptr_t) cqe->user_data;
+        ssize_t result = cqe->res;
+
+        // Free the slot before the callback, which may queue more requests.
+        __sync_synchronize();
+        *ring->cqHead = head + 1;
+
+        _parcEventIOEngine_Complete(engine, request, result);
+    }
+
+    // Requests queued by the callbacks go to the kernel together.
+    _parcEventIOEngineRing_Submit(engine);
+}
+
+static bool
+_parcEventIOEngineRing_Init(PARCEventIOEngine *engine)
+{
+    _PARCEventIOEngineRing *ring = &engine->ring;
+    memset(ring, 0, sizeof(*ring));
+    ring->fd = -1;
+    ring->eventFd = -1;
+
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int) syscall(__NR_io_uring_setup, (unsigned) engine->depth, &params);
+    if (ring->fd < 0) {
+        return false;
+    }
+
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+    if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        return false;
+    }
+
+    uint8_t *sq = ring->sqRing;
+    ring->sqHead = (volatile unsigned *) (sq + params.sq_off.head);
+    ring->sqTail = (volatile unsigned *) (sq + params.sq_off.tail);
+    ring->sqMask = *(unsigned *) (sq + params.sq_off.ring_mask);
+    ring->sqEntries = *(unsigned *) (sq + params.sq_off.ring_entries);
+    ring->sqArray = (unsigned *) (sq + params.sq_off.array);
+    ring->localTail = *ring->sqTail;
+
+    uint8_t *cq = ring->cqRing;
+    ring->cqHead = (volatile unsigned *) (cq + params.cq_off.head);
+    ring->cqTail = (volatile unsigned *) (cq + params.cq_off.tail);
+    ring->cqMask = *(unsigned *) (cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *) (cq + params.cq_off.cqes);
+
+    ring->eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (ring->eventFd < 0
+        || syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_EVENTFD, &ring->eventFd, 1) != 0) {
+        return false;
+    }
+
+    if (engine->registeredCount > 0) {
+        struct iovec iovecs[engine->registeredCount];
+        for (size_t i = 0; i < engine->registeredCount; i++) {
+            PARCBuffer *buffer = engine->registered[i];
+            iovecs[i].iov_base = parcByteArray_Array(parcBuffer_Array(buffer)) + parcBuffer_ArrayOffset(buffer);
+            iovecs[i].iov_len = parcBuffer_Capacity(buffer);
+        }
+        // Registration pins memory and can fail against RLIMIT_MEMLOCK; the engine then works unregistered.
+        ring->buffersRegistered =
+            syscall(__NR_io_uring_register, ring->fd, IORING_REGISTER_BUFFERS, iovecs, (unsigned) engine->registeredCount) == 0;
+    }
+
+    ring->completionEvent = parcEvent_Create(engine->scheduler, ring->eventFd,
+                                             PARCEventType_Read | PARCEventType_Persist,
+                                             _parcEventIOEngineRing_Reap, engine);
+    parcEvent_Start(ring->completionEvent);
+    return true;
+}
+
+/*
+ * Cancel every outstanding request and wait for the kernel to complete each of them,
+ * so that none of their buffers is released while the kernel may still read or write it.
+ * The callbacks of the cancelled requests are not called.
+ */
+static void
+_parcEventIOEngineRing_Drain(PARCEventIOEngine *engine)
+{
+    _PARCEventIOEngineRing *ring = &engine->ring;
+
+    while (engine->outstanding > 0) {
+        for (_PARCEventIOEngineRequest *request = engine->requests; request != NULL; request = request->next) {
+            if (!request->cancelled) {
+                struct io_uring_sqe *sqe = _parcEventIOEngineRing_GetSqe(engine);
+                if (sqe == NULL) {
+                    break;
+                }
+                // The cancellation itself completes with user_data 0, which is never a request.
+                sqe->opcode = IORING_OP_ASYNC_CANCEL;
+                sqe->fd = -1;
+                sqe->addr = (uint64_t) (uintptr_t) request;
+                _parcEventIOEngineRing_PushSqe(ring);
+                request->cancelled = true;
+            }
+        }
+
+        int result = _parcEventIOEngineRing_Enter(ring, ring->toSubmit, 1, IORING_ENTER_GETEVENTS);
+        engine->systemCalls++;
+        if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            break;
+        }
+        if (result > 0) {
+            ring->toSubmit -= result;
+        }
+
+        for (;;) {
+            __sync_synchronize();
+            unsigned head = *ring->cqHead;
+            if (head == *ring->cqTail) {
+                break;
+            }
+            _PARCEventIOEngineRequest *request = (_PARCEventIOEngineRequest *) (uintptr_t) ring->cqes[head & ring->cqMask].user_data;
+            __sync_synchronize();
+            *ring->cqHead = head + 1;
+
+            if (request != NULL) {
+                _parcEventIOEngine_Unlink(engine, request);
+                parcBuffer_Release(&request->buffer);
+                parcMemory_Deallocate((void **) &request);
+            }
+        }
+    }
+}
+
+static void
+_parcEventIOEngineRing_Fini(_PARCEventIOEngineRing *ring)
+{
+    if (ring->completionEvent != NULL) {
+        parcEvent_Destroy(&ring->completionEvent);
+    }
+    if (ring->sqes != NULL && ring->sqes != MAP_FAILED) {
+        munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqRing != NULL && ring->cqRing != MAP_FAILED) {
+        munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing != NULL && ring->sqRing != MAP_FAILED) {
+        munmap(ring->sqRing, ring->sqRingSize);
+    }
+    if (ring->fd >= 0) {
+        close(ring->fd);
+    }
+    if (ring->eventFd >= 0) {
+        close(ring->eventFd);
+    }
+    memset(ring, 0, sizeof(*ring));
+}
+#endif
+
+// ------------------------------------------------------------------------------------------------
+
+static int
+_parcEventIOEngine_RegisteredIndex(const PARCEventIOEngine *engine, const PARCBuffer *buffer)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+    if (engine->ring.buffersRegistered) {
+        for (size_t i = 0; i < engine->registeredCount; i++) {
+            if (engine->registered[i] == buffer) {
+                return (int) i;
+            }
+        }
+    }
+#endif
+    return -1;
+}
+
+static PARCEventIOEngine *
+_parcEventIOEngine_Create(PARCEventScheduler *scheduler, PARCBufferPool *pool, size_t depth, bool useRing)
+{
+    assertNotNull(scheduler, "Parameter scheduler must be a non-null PARCEventScheduler pointer.");
+    assertNotNull(pool, "Parameter pool must be a non-null PARCBufferPool pointer.");
+    assertTrue(depth > 0, "Parameter depth must be greater than 0");
+
+    PARCEventIOEngine *engine = parcMemory_AllocateAndClear(sizeof(PARCEventIOEngine));
+    assertNotNull(engine, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCEventIOEngine));
+
+    engine->scheduler = scheduler;
+    engine->pool = parcBufferPool_Acquire(pool);
+    engine->depth = depth;
+
+    engine->registeredCount = depth;
+    engine->registered = parcMemory_AllocateAndClear(depth * sizeof(PARCBuffer *));
+    assertNotNull(engine->registered, "parcMemory_AllocateAndClear(%zu) returned NULL", depth * sizeof(PARCBuffer *));
+    for (size_t i = 0; i < depth; i++) {
+        engine->registered[i] = parcBufferPool_GetInstance(pool);
+    }
+
+    engine->deferred = parcEventTimer_Create(scheduler, PARCEventType_None, _parcEventIOEngine_RunDeferred, engine);
+
+#ifdef HAVE_LINUX_IO_URING_H
+    if (useRing) {
+        engine->isAsynchronous = _parcEventIOEngineRing_Init(engine);
+        if (!engine->isAsynchronous) {
+            _parcEventIOEngineRing_Fini(&engine->ring);
+        }
+    }
+#endif
+
+    return engine;
+}
+
+PARCEventIOEngine *
+parcEventIOEngine_Create(PARCEventScheduler *scheduler, PARCBufferPool *pool, size_t depth)
+{
+    return _parcEventIOEngine_Create(scheduler, pool, depth, true);
+}
+
+void
+parcEventIOEngine_Destroy(PARCEventIOEngine **enginePtr)
+{
+    assertNotNull(enginePtr, "Parameter must be a non-null pointer to a PARCEventIOEngine pointer.");
+    PARCEventIOEngine *engine = *enginePtr;
+    assertNotNull(engine, "parcEventIOEngine_Destroy must be passed a valid engine!");
+
+#ifdef HAVE_LINUX_IO_URING_H
+    if (engine->isAsynchronous) {
+        _parcEventIOEngineRing_Drain(engine);
+        _parcEventIOEngineRing_Fini(&engine->ring);
+    }
+#endif
+    parcEventTimer_Destroy(&engine->deferred);
+
+    _PARCEventIOEngineRequest *request = engine->requests;
+    while (request != NULL) {
+        _PARCEventIOEngineRequest *next = request->next;
+        if (request->readiness != NULL) {
+            parcEvent_Destroy(&request->readiness);
+        }
+        parcBuffer_Release(&request->buffer);
+        parcMemory_Deallocate((void **) &request);
+        request = next;
+    }
+
+    for (size_t i = 0; i < engine->registeredCount; i++) {
+        parcBuffer_Release(&engine->registered[i]);
+    }
+    parcMemory_Deallocate((void **) &engine->registered);
+    parcBufferPool_Release(&engine->pool);
+
+    parcMemory_Deallocate((void **) enginePtr);
+}
+
+bool
+parcEventIOEngine_IsAsynchronous(const PARCEventIOEngine *engine)
+{
+    return engine->isAsynchronous;
+}
+
+PARCBuffer *
+parcEventIOEngine_GetBuffer(PARCEventIOEngine *engine)
+{
+    // A registered buffer is free when the engine holds the only reference to it.
+    for (size_t i = 0; i < engine->registeredCount; i++) {
+        size_t index = (engine->nextRegistered + i) % engine->registeredCount;
+        PARCBuffer *buffer = engine->registered[index];
+        if (parcObject_GetReferenceCount(buffer) == 1) {
+            engine->nextRegistered = index + 1;
+            return parcBuffer_Clear(parcBuffer_Acquire(buffer));
+        }
+    }
+    // Pooled buffers come back in whatever state their last user left them.
+    return parcBuffer_Clear(parcBufferPool_GetInstance(engine->pool));
+}
+
+static bool
+_parcEventIOEngine_Request(PARCEventIOEngine *engine, _PARCEventIOEngineOperation operation, int fd, off_t offset,
+                           PARCBuffer *buffer, PARCEventIOEngine_Callback *callback, void *userData)
+{
+    assertNotNull(buffer, "Parameter buffer must be a non-null PARCBuffer pointer.");
+    assertNotNull(callback, "Parameter callback must be a non-null function pointer.");
+
+    if (engine->outstanding >= engine->depth) {
+        return false;
+    }
+
+    _PARCEventIOEngineRequest *request = parcMemory_AllocateAndClear(sizeof(_PARCEventIOEngineRequest));
+    if (request == NULL) {
+        return false;
+    }
+    request->engine = engine;
+    request->operation = operation;
+    request->fd = fd;
+    request->offset = offset;
+    request->buffer = parcBuffer_Acquire(buffer);
+    request->callback = callback;
+    request->userData = userData;
+
+#ifdef HAVE_LINUX_IO_URING_H
+    if (engine->isAsynchronous) {
+        if (!_parcEventIOEngineRing_Queue(engine, request, _parcEventIOEngine_RegisteredIndex(engine, buffer))) {
+            parcBuffer_Release(&request->buffer);
+            parcMemory_Deallocate((void **) &request);
+            return false;
+        }
+    }
+#endif
+    if (!engine->isAsynchronous) {
+        if (engine->pendingTail == NULL) {
+            engine->pendingHead = request;
+        } else {
+            engine->pendingTail->nextPending = request;
+        }
+        engine->pendingTail = request;
+        engine->pendingCount++;
+    }
+
+    request->next = engine->requests;
+    if (engine->requests != NULL) {
+        engine->requests->previous = request;
+    }
+    engine->requests = request;
+    engine->outstanding++;
+    return true;
+}
+
+bool
+parcEventIOEngine_Receive(PARCEventIOEngine *engine, int fd, PARCBuffer *buffer,
+                          PARCEventIOEngine_Callback *callback, void *userData)
+{
+    return _parcEventIOEngine_Request(engine, _PARCEventIOEngineOperation_Receive, fd, 0, buffer, callback, userData);
+}
+
+bool
+parcEventIOEngine_Send(PARCEventIOEngine *engine, int fd, PARCBuffer *buffer,
+                       PARCEventIOEngine_Callback *callback, void *userData)
+{
+    return _parcEventIOEngine_Request(engine, _PARCEventIOEngineOperation_Send, fd, 0, buffer, callback, userData);
+}
+
+bool
+parcEventIOEngine_Read(PARCEventIOEngine *engine, int fd, off_t offset, PARCBuffer *buffer,
+                       PARCEventIOEngine_Callback *callback, void *userData)
+{
+    return _parcEventIOEngine_Request(engine, _PARCEventIOEngineOperation_Read, fd, offset, buffer, callback, userData);
+}
+
+bool
+parcEventIOEngine_Write(PARCEventIOEngine *engine, int fd, off_t offset, PARCBuffer *buffer,
+                        PARCEventIOEngine_Callback *callback, void *userData)
+{
+    return _parcEventIOEngine_Request(engine, _PARCEventIOEngineOperation_Write, fd, offset, buffer, callback, userData);
+}
+
+size_t
+parcEventIOEngine_Submit(PARCEventIOEngine *engine)
+{
+#ifdef HAVE_LINUX_IO_URING_H
+    if (engine->isAsynchronous) {
+        return _parcEventIOEngineRing_Submit(engine);
+    }
+#endif
+    return _parcEventIOEngine_SubmitDeferred(engine);
+}
+
+size_t
+parcEventIOEngine_GetOutstanding(const PARCEventIOEngine *engine)
+{
+    return engine->outstanding;
+}
+
+uint64_t
+parcEventIOEngine_GetSystemCallCount(const PARCEventIOEngine *engine)
+{
+    return engine->systemCalls;
+}
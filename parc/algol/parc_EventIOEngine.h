@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_EventIOEngine.h
+ * @ingroup events
+ * @brief Batched asynchronous socket and file I/O delivered on a PARCEventScheduler
+ *
+ * A `PARCEventIOEngine` queues receive, send, read and write requests against file descriptors and
+ * submits them in batches. Each request names a {@link PARCBuffer}: receives and reads fill it from
+ * its position to its limit, sends and writes drain it from its position to its limit, and in every
+ * case the position is advanced by the number of bytes transferred before the completion callback runs.
+ *
+ * On Linux, when the kernel provides io_uring, a whole batch of requests is handed to the kernel with
+ * one system call and completions are reaped together when the ring signals the scheduler.
+ * Buffers obtained with {@link parcEventIOEngine_GetBuffer} are drawn from a {@link PARCBufferPool}
+ * and registered with the kernel once, so file reads and writes on them skip the per-request page mapping.
+ * Where io_uring is not available the engine falls back to ordinary non-blocking system calls,
+ * issued from the scheduler, with the same API and the same callback semantics.
+ *
+ * An engine belongs to the thread running its scheduler: requests must be made, and are completed, on that thread.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_EventIOEngine_h
+#define libparc_parc_EventIOEngine_h
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_EventScheduler.h>
+#include <parc/memory/parc_BufferPool.h>
+
+typedef struct PARCEventIOEngine PARCEventIOEngine;
+
+/**
+ * Called on the scheduler thread when a request completes.
+ *
+ * @param [in] engine The engine the request was made on.
+ * @param [in] buffer The request's buffer, its position advanced by the bytes transferred.
+ *                    The engine releases its reference when the callback returns.
+ * @param [in] result The number of bytes transferred, 0 at end of file or on an orderly shutdown,
+ *                    or a negative errno value.
+ * @param [in] userData The value given with the request.
+ */
+typedef void (PARCEventIOEngine_Callback)(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData);
+
+/**
+ * Create an I/O engine on the given scheduler.
+ *
+ * Up to @p depth requests may be outstanding at once, and up to @p depth buffers are drawn from @p pool
+ * and registered with the kernel. The pool's limit should be at least @p depth.
+ *
+ * @param [in] scheduler The scheduler on which completions are delivered.
+ * @param [in] pool The pool supplying buffers for {@link parcEventIOEngine_GetBuffer}.
+ * @param [in] depth The maximum number of outstanding requests.
+ * @returns A pointer to a new `PARCEventIOEngine` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferPool *pool = parcBufferPool_Create(64, 2048);
+ *     PARCEventIOEngine *engine = parcEventIOEngine_Create(scheduler, pool, 64);
+ *     parcBufferPool_Release(&pool);
+ *     ...
+ *     parcEventIOEngine_Destroy(&engine);
+ * }
+ * @endcode
+ */
+PARCEventIOEngine *parcEventIOEngine_Create(PARCEventScheduler *scheduler, PARCBufferPool *pool, size_t depth);
+
+/**
+ * Destroy an I/O engine.
+ *
+ * Outstanding requests are cancelled without their callbacks being run, and registered buffers
+ * are returned to the pool.
+ *
+ * @param [in,out] enginePtr The address of the instance to destroy, set to NULL on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventIOEngine_Destroy(&engine);
+ * }
+ * @endcode
+ */
+void parcEventIOEngine_Destroy(PARCEventIOEngine **enginePtr);
+
+/**
+ * Determine if the engine submits requests to the kernel asynchronously (io_uring).
+ *
+ * @param [in] engine The engine to query.
+ * @returns true if requests go through io_uring, false if the engine fell back to ordinary system calls.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (!parcEventIOEngine_IsAsynchronous(engine)) {
+ *         parcLog_Info(log, "io_uring not available, using the fallback I/O path");
+ *     }
+ * }
+ * @endcode
+ */
+bool parcEventIOEngine_IsAsynchronous(const PARCEventIOEngine *engine);
+
+/**
+ * Get an empty buffer suitable for requests on this engine.
+ *
+ * A registered buffer is returned when one is not in use, otherwise an ordinary buffer from the pool.
+ *
+ * @param [in] engine The engine.
+ * @returns A cleared `PARCBuffer` that the caller must release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = parcEventIOEngine_GetBuffer(engine);
+ *     parcEventIOEngine_Receive(engine, fd, buffer, _received, connection);
+ *     parcBuffer_Release(&buffer);
+ * }
+ * @endcode
+ */
+PARCBuffer *parcEventIOEngine_GetBuffer(PARCEventIOEngine *engine);
+
+/**
+ * Queue a receive from a socket into @p buffer.
+ *
+ * @param [in] engine The engine.
+ * @param [in] fd A connected socket.
+ * @param [in] buffer The buffer to fill from its position to its limit. The engine holds a reference until completion.
+ * @param [in] callback Called when the request completes.
+ * @param [in] userData Passed to @p callback.
+ * @returns true if the request was queued, false if the engine already has `depth` requests outstanding.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventIOEngine_Receive(engine, fd, buffer, _received, connection);
+ *     parcEventIOEngine_Submit(engine);
+ * }
+ * @endcode
+ */
+bool parcEventIOEngine_Receive(PARCEventIOEngine *engine, int fd, PARCBuffer *buffer,
+                               PARCEventIOEngine_Callback *callback, void *userData);
+
+/**
+ * Queue a send of @p buffer, from its position to its limit, on a socket.
+ *
+ * A short send completes with the number of bytes sent; the caller may queue the remainder.
+ *
+ * @param [in] engine The engine.
+ * @param [in] fd A connected socket.
+ * @param [in] buffer The buffer to send. The engine holds a reference until completion.
+ * @param [in] callback Called when the request completes.
+ * @param [in] userData Passed to @p callback.
+ * @returns true if the request was queued, false if the engine already has `depth` requests outstanding.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventIOEngine_Send(engine, fd, reply, _sent, connection);
+ * }
+ * @endcode
+ */
+bool parcEventIOEngine_Send(PARCEventIOEngine *engine, int fd, PARCBuffer *buffer,
+                            PARCEventIOEngine_Callback *callback, void *userData);
+
+/**
+ * Queue a read from a file into @p buffer.
+ *
+ * @param [in] engine The engine.
+ * @param [in] fd An open file, such as the descriptor of a `PARCFileInputStream` or `PARCRandomAccessFile`.
+ * @param [in] offset The file offset to read from, or -1 to read from, and advance, the current file position.
+ * @param [in] buffer The buffer to fill from its position to its limit. The engine holds a reference until completion.
+ * @param [in] callback Called when the request completes.
+ * @param [in] userData Passed to @p callback.
+ * @returns true if the request was queued, false if the engine already has `depth` requests outstanding.
+ *
+ * Example:
+ * @code
+ * {
+ *     for (int i = 0; i < 8; i++) {
+ *         PARCBuffer *block = parcEventIOEngine_GetBuffer(engine);
+ *         parcEventIOEngine_Read(engine, fd, i * blockSize, block, _blockRead, NULL);
+ *         parcBuffer_Release(&block);
+ *     }
+ *     parcEventIOEngine_Submit(engine);
+ * }
+ * @endcode
+ */
+bool parcEventIOEngine_Read(PARCEventIOEngine *engine, int fd, off_t offset, PARCBuffer *buffer,
+                            PARCEventIOEngine_Callback *callback, void *userData);
+
+/**
+ * Queue a write of @p buffer, from its position to its limit, to a file.
+ *
+ * @param [in] engine The engine.
+ * @param [in] fd An open file.
+ * @param [in] offset The file offset to write at, or -1 to write at, and advance, the current file position.
+ * @param [in] buffer The buffer to write. The engine holds a reference until completion.
+ * @param [in] callback Called when the request completes.
+ * @param [in] userData Passed to @p callback.
+ * @returns true if the request was queued, false if the engine already has `depth` requests outstanding.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventIOEngine_Write(engine, fd, 0, block, _blockWritten, NULL);
+ * }
+ * @endcode
+ */
+bool parcEventIOEngine_Write(PARCEventIOEngine *engine, int fd, off_t offset, PARCBuffer *buffer,
+                             PARCEventIOEngine_Callback *callback, void *userData);
+
+/**
+ * Submit every queued request.
+ *
+ * With io_uring this is a single system call however many requests are queued.
+ * Requests queued from completion callbacks are submitted automatically once the batch of
+ * completions has been delivered, so a request/response loop need not call this.
+ *
+ * @param [in] engine The engine.
+ * @returns The number of requests submitted.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventIOEngine_Submit(engine);
+ * }
+ * @endcode
+ */
+size_t parcEventIOEngine_Submit(PARCEventIOEngine *engine);
+
+/**
+ * Return the number of requests submitted but not yet completed.
+ *
+ * @param [in] engine The engine to query.
+ * @returns The number of outstanding requests.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t outstanding = parcEventIOEngine_GetOutstanding(engine);
+ * }
+ * @endcode
+ */
+size_t parcEventIOEngine_GetOutstanding(const PARCEventIOEngine *engine);
+
+/**
+ * Return the number of system calls the engine itself has made to submit and complete requests.
+ *
+ * Calls made by the scheduler to wait for events are not included.
+ *
+ * @param [in] engine The engine to query.
+ * @returns The number of system calls.
+ *
+ * Example:
+ * @code
+ * {
+ *     printf("%.2f syscalls per request\n", (double) parcEventIOEngine_GetSystemCallCount(engine) / requests);
+ * }
+ * @endcode
+ */
+uint64_t parcEventIOEngine_GetSystemCallCount(const PARCEventIOEngine *engine);
+#endif // libparc_parc_EventIOEngine_h
@@ -65,6 +65,7 @@
 #include <parc/algol/parc_EventScheduler.h>
 #include <parc/algol/parc_EventQueue.h>
 #include <parc/algol/parc_FileOutputStream.h>
+#include <parc/developer/parc_Trace.h>
 #include <parc/logging/parc_Log.h>
 #include <parc/logging/parc_LogReporterFile.h>
 
@@ -113,6 +114,7 @@ _parc_queue_read_callback(struct bufferevent *bev, void *ptr)
                             bev, parcEventQueue->buffereventBuffer, parcEventQueue);
     assertNotNull(parcEventQueue->readCallback, "parcEvent read callback called when NULL");
 
+    parcTrace_Scope("PARCEventScheduler", "queue.read");
     parcEventQueue->readCallback(parcEventQueue, PARCEventType_Read, parcEventQueue->readUserData);
 }
 
@@ -125,6 +127,7 @@ _parc_queue_write_callback(struct bufferevent *bev, void *ptr)
                             bev, parcEventQueue->buffereventBuffer, parcEventQueue);
     assertNotNull(parcEventQueue->writeCallback, "parcEvent write callback called when NULL");
 
+    parcTrace_Scope("PARCEventScheduler", "queue.write");
     parcEventQueue->writeCallback(parcEventQueue, PARCEventType_Write, parcEventQueue->writeUserData);
 }
 
@@ -138,6 +141,7 @@ _parc_queue_event_callback(struct bufferevent *bev, short events, void *ptr)
                             bev, events, errno, parcEventQueue->buffereventBuffer, parcEventQueue);
     assertNotNull(parcEventQueue->eventCallback, "parcEvent event callback called when NULL");
 
+    parcTrace_Scope("PARCEventScheduler", "queue.event");
     errno = errno_forwarded;
     parcEventQueue->eventCallback(parcEventQueue, internal_bufferevent_type_to_PARCEventQueueEventType(events), parcEventQueue->eventUserData);
 }
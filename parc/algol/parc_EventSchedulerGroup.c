@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Event.h>
+#include <parc/algol/parc_EventSchedulerGroup.h>
+#include <parc/concurrent/parc_Notifier.h>
+#include <parc/developer/parc_Trace.h>
+
+typedef struct parc_event_scheduler_group_task {
+    struct parc_event_scheduler_group_task *next;
+    PARCEventSchedulerGroup_Task *task;
+    PARCEventSchedulerGroup_Discard *discard;
+    void *userData;
+} _PARCEventSchedulerGroupTask;
+
+/**
+ * One loop of the group.
+ *
+ * The task list is the only state shared with other threads; it is guarded by `lock`
+ * and the notifier wakes the loop when the list goes from empty to non-empty.
+ */
+typedef struct parc_event_scheduler_group_loop {
+    size_t index;
+    PARCEventScheduler *scheduler;
+    PARCNotifier *notifier;
+    PARCEvent *notifierEvent;
+
+    pthread_mutex_t lock;
+    _PARCEventSchedulerGroupTask *head;
+    _PARCEventSchedulerGroupTask *tail;
+
+    pthread_t thread;
+} _PARCEventSchedulerGroupLoop;
+
+struct PARCEventSchedulerGroup {
+    size_t count;
+    volatile size_t next;
+    bool running;
+    _PARCEventSchedulerGroupLoop *loops;
+};
+
+static __thread PARCEventScheduler *_parcEventSchedulerGroup_Current = NULL;
+
+static void
+_parcEventSchedulerGroup_RunTasks(int fd, PARCEventType type, void *userData)
+{
+    _PARCEventSchedulerGroupLoop *loop = userData;
+
+    // Tasks queued between here and StartEvents are caught by the notifier's skipped count.
+    parcNotifier_PauseEvents(loop->notifier);
+
+    pthread_mutex_lock(&loop->lock);
+    _PARCEventSchedulerGroupTask *task = loop->head;
+    loop->head = NULL;
+    loop->tail = NULL;
+    pthread_mutex_unlock(&loop->lock);
+
+    while (task != NULL) {
+        _PARCEventSchedulerGroupTask *next = task->next;
+        {
+            parcTrace_Scope("PARCEventScheduler", "group.task");
+            task->task(loop->scheduler, task->userData);
+        }
+        parcMemory_Deallocate((void **) &task);
+        task = next;
+    }
+
+    parcNotifier_StartEvents(loop->notifier);
+}
+
+static void
+_parcEventSchedulerGroup_AbortTask(PARCEventScheduler *scheduler, void *userData)
+{
+    parcEventScheduler_Abort(scheduler);
+}
+
+static void
+_parcEventSchedulerGroup_Pin(size_t index)
+{
+#ifdef __linux__
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors > 1) {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        CPU_SET(index % (size_t) processors, &cpus);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    }
+#endif
+}
+
+static void *
+_parcEventSchedulerGroup_Run(void *arg)
+{
+    _PARCEventSchedulerGroupLoop *loop = arg;
+
+    _parcEventSchedulerGroup_Pin(loop->index);
+
+    _parcEventSchedulerGroup_Current = loop->scheduler;
+    parcEventScheduler_DispatchBlocking(loop->scheduler);
+    _parcEventSchedulerGroup_Current = NULL;
+
+    return NULL;
+}
+
+static void
+_parcEventSchedulerGroupLoop_Init(_PARCEventSchedulerGroupLoop *loop, size_t index)
+{
+    loop->index = index;
+    loop->scheduler = parcEventScheduler_Create();
+    loop->notifier = parcNotifier_Create();
+    assertNotNull(loop->notifier, "parcNotifier_Create returned NULL");
+
+    pthread_mutex_init(&loop->lock, NULL);
+    loop->head = NULL;
+    loop->tail = NULL;
+
+    loop->notifierEvent = parcEvent_Create(loop->scheduler, parcNotifier_Socket(loop->notifier),
+                                           PARCEventType_Read | PARCEventType_Persist,
+                                           _parcEventSchedulerGroup_RunTasks, loop);
+    parcEvent_Start(loop->notifierEvent);
+}
+
+static void
+_parcEventSchedulerGroupLoop_Fini(_PARCEventSchedulerGroupLoop *loop)
+{
+    parcEvent_Destroy(&loop->notifierEvent);
+    parcNotifier_Release(&loop->notifier);
+
+    // Tasks dispatched to a loop after it was stopped never ran.
+    _PARCEventSchedulerGroupTask *task = loop->head;
+    while (task != NULL) {
+        _PARCEventSchedulerGroupTask *next = task->next;
+        if (task->discard != NULL) {
+            task->discard(task->userData);
+        }
+        parcMemory_Deallocate((void **) &task);
+        task = next;
+    }
+    pthread_mutex_destroy(&loop->lock);
+
+    parcEventScheduler_Destroy(&loop->scheduler);
+}
+
+PARCEventSchedulerGroup *
+parcEventSchedulerGroup_Create(size_t count)
+{
+    if (count == 0) {
+        long processors = sysconf(_SC_NPROCESSORS_ONLN);
+        count = (processors > 0) ? (size_t) processors : 1;
+    }
+
+    PARCEventSchedulerGroup *group = parcMemory_AllocateAndClear(sizeof(PARCEventSchedulerGroup));
+    assertNotNull(group, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCEventSchedulerGroup));
+
+    group->loops = parcMemory_AllocateAndClear(count * sizeof(_PARCEventSchedulerGroupLoop));
+    assertNotNull(group->loops, "parcMemory_AllocateAndClear(%zu) returned NULL", count * sizeof(_PARCEventSchedulerGroupLoop));
+
+    group->count = count;
+    group->next = 0;
+    group->running = false;
+    for (size_t i = 0; i < count; i++) {
+        _parcEventSchedulerGroupLoop_Init(&group->loops[i], i);
+    }
+
+    return group;
+}
+
+void
+parcEventSchedulerGroup_Destroy(PARCEventSchedulerGroup **groupPtr)
+{
+    assertNotNull(groupPtr, "Parameter must be a non-null pointer to a PARCEventSchedulerGroup pointer.");
+    PARCEventSchedulerGroup *group = *groupPtr;
+    assertNotNull(group, "parcEventSchedulerGroup_Destroy must be passed a valid group!");
+
+    parcEventSchedulerGroup_Stop(group);
+
+    for (size_t i = 0; i < group->count; i++) {
+        _parcEventSchedulerGroupLoop_Fini(&group->loops[i]);
+    }
+    parcMemory_Deallocate((void **) &group->loops);
+    parcMemory_Deallocate((void **) groupPtr);
+}
+
+bool
+parcEventSchedulerGroup_Start(PARCEventSchedulerGroup *group)
+{
+    if (group->running) {
+        return false;
+    }
+
+    for (size_t i = 0; i < group->count; i++) {
+        int failure = pthread_create(&group->loops[i].thread, NULL, _parcEventSchedulerGroup_Run, &group->loops[i]);
+        assertFalse(failure, "pthread_create failed: %s", strerror(failure));
+    }
+    group->running = true;
+    return true;
+}
+
+void
+parcEventSchedulerGroup_Stop(PARCEventSchedulerGroup *group)
+{
+    if (!group->running) {
+        return;
+    }
+
+    // libevent is not initialised for cross-thread use, so each loop must break itself.
+    for (size_t i = 0; i < group->count; i++) {
+        parcEventSchedulerGroup_Dispatch(group, i, _parcEventSchedulerGroup_AbortTask, NULL);
+    }
+    for (size_t i = 0; i < group->count; i++) {
+        pthread_join(group->loops[i].thread, NULL);
+    }
+    group->running = false;
+}
+
+size_t
+parcEventSchedulerGroup_GetSchedulerCount(const PARCEventSchedulerGroup *group)
+{
+    return group->count;
+}
+
+PARCEventScheduler *
+parcEventSchedulerGroup_GetScheduler(const PARCEventSchedulerGroup *group, size_t index)
+{
+    assertTrue(index < group->count, "Index %zu out of range (%zu schedulers)", index, group->count);
+    return group->loops[index].scheduler;
+}
+
+size_t
+parcEventSchedulerGroup_NextIndex(PARCEventSchedulerGroup *group)
+{
+    return __sync_fetch_and_add(&group->next, 1) % group->count;
+}
+
+bool
+parcEventSchedulerGroup_Dispatch(PARCEventSchedulerGroup *group, size_t index,
+                                 PARCEventSchedulerGroup_Task *task, void *userData)
+{
+    return parcEventSchedulerGroup_DispatchWithDiscard(group, index, task, NULL, userData);
+}
+
+bool
+parcEventSchedulerGroup_DispatchWithDiscard(PARCEventSchedulerGroup *group, size_t index,
+                                            PARCEventSchedulerGroup_Task *task,
+                                            PARCEventSchedulerGroup_Discard *discard, void *userData)
+{
+    assertTrue(index < group->count, "Index %zu out of range (%zu schedulers)", index, group->count);
+
+    _PARCEventSchedulerGroupTask *entry = parcMemory_Allocate(sizeof(_PARCEventSchedulerGroupTask));
+    if (entry == NULL) {
+        return false;
+    }
+    entry->next = NULL;
+    entry->task = task;
+    entry->discard = discard;
+    entry->userData = userData;
+
+    _PARCEventSchedulerGroupLoop *loop = &group->loops[index];
+    pthread_mutex_lock(&loop->lock);
+    if (loop->tail == NULL) {
+        loop->head = entry;
+    } else {
+        loop->tail->next = entry;
+    }
+    loop->tail = entry;
+    pthread_mutex_unlock(&loop->lock);
+
+    parcNotifier_Notify(loop->notifier);
+    return true;
+}
+
+PARCEventScheduler *
+parcEventSchedulerGroup_CurrentScheduler(void)
+{
+    return _parcEventSchedulerGroup_Current;
+}
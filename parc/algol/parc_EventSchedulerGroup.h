@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_EventSchedulerGroup.h
+ * @ingroup events
+ * @brief A group of event schedulers, each dispatched on its own thread
+ *
+ * A single `PARCEventScheduler` runs every callback on one thread, which caps a server at one core.
+ * A `PARCEventSchedulerGroup` owns one scheduler per core (or a caller supplied count),
+ * runs each of them on a dedicated thread pinned to a core where the platform allows it,
+ * and provides a thread safe way to hand work from any thread to a particular loop.
+ *
+ * Each loop owns its scheduler exclusively once the group is started: events must only be
+ * created, started and destroyed on a scheduler from a task or callback running on that loop.
+ * Use {@link parcEventSchedulerGroup_Dispatch} to move work onto a loop.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef libparc_parc_EventSchedulerGroup_h
+#define libparc_parc_EventSchedulerGroup_h
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <parc/algol/parc_EventScheduler.h>
+
+typedef struct PARCEventSchedulerGroup PARCEventSchedulerGroup;
+
+/**
+ * A unit of work handed to a loop with {@link parcEventSchedulerGroup_Dispatch}.
+ *
+ * The task runs on the thread of the loop it was dispatched to and receives that loop's scheduler.
+ */
+typedef void (PARCEventSchedulerGroup_Task)(PARCEventScheduler *scheduler, void *userData);
+
+/**
+ * Releases the user data of a task that was queued but never ran.
+ *
+ * Called by {@link parcEventSchedulerGroup_Destroy} for each task still queued on a loop,
+ * for example one dispatched to a loop that had already been stopped.
+ */
+typedef void (PARCEventSchedulerGroup_Discard)(void *userData);
+
+/**
+ * Create a new group of event schedulers.
+ *
+ * @param [in] count The number of schedulers, or 0 for one per online processor.
+ * @returns A pointer to a new `PARCEventSchedulerGroup` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(0);
+ *     parcEventSchedulerGroup_Start(group);
+ *     ...
+ *     parcEventSchedulerGroup_Stop(group);
+ *     parcEventSchedulerGroup_Destroy(&group);
+ * }
+ * @endcode
+ */
+PARCEventSchedulerGroup *parcEventSchedulerGroup_Create(size_t count);
+
+/**
+ * Destroy a group of event schedulers.
+ *
+ * The group is stopped first if it is running. Tasks dispatched but not yet run are discarded.
+ *
+ * @param [in,out] groupPtr The address of the instance to destroy, set to NULL on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventSchedulerGroup_Destroy(&group);
+ * }
+ * @endcode
+ */
+void parcEventSchedulerGroup_Destroy(PARCEventSchedulerGroup **groupPtr);
+
+/**
+ * Start one dispatch thread per scheduler.
+ *
+ * On Linux each thread is pinned to processor `index % online processors`.
+ *
+ * @param [in] group The group to start.
+ * @returns true if all threads were started, false if the group was already running.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventSchedulerGroup_Start(group);
+ * }
+ * @endcode
+ */
+bool parcEventSchedulerGroup_Start(PARCEventSchedulerGroup *group);
+
+/**
+ * Stop every loop and wait for its thread to exit.
+ *
+ * Each loop finishes the callback it is running and the tasks already queued to it.
+ *
+ * @param [in] group The group to stop.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventSchedulerGroup_Stop(group);
+ * }
+ * @endcode
+ */
+void parcEventSchedulerGroup_Stop(PARCEventSchedulerGroup *group);
+
+/**
+ * Return the number of schedulers in the group.
+ *
+ * @param [in] group The group to query.
+ * @returns The number of schedulers.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t count = parcEventSchedulerGroup_GetSchedulerCount(group);
+ * }
+ * @endcode
+ */
+size_t parcEventSchedulerGroup_GetSchedulerCount(const PARCEventSchedulerGroup *group);
+
+/**
+ * Return the scheduler at the given index.
+ *
+ * @param [in] group The group to query.
+ * @param [in] index An index less than {@link parcEventSchedulerGroup_GetSchedulerCount}.
+ * @returns The scheduler, which remains owned by the group.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEventScheduler *scheduler = parcEventSchedulerGroup_GetScheduler(group, 0);
+ * }
+ * @endcode
+ */
+PARCEventScheduler *parcEventSchedulerGroup_GetScheduler(const PARCEventSchedulerGroup *group, size_t index);
+
+/**
+ * Return the index of the next scheduler in round-robin order.
+ *
+ * Safe to call from any thread.
+ *
+ * @param [in] group The group to query.
+ * @returns An index less than {@link parcEventSchedulerGroup_GetSchedulerCount}.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventSchedulerGroup_Dispatch(group, parcEventSchedulerGroup_NextIndex(group), task, data);
+ * }
+ * @endcode
+ */
+size_t parcEventSchedulerGroup_NextIndex(PARCEventSchedulerGroup *group);
+
+/**
+ * Queue a task to run on the loop at the given index.
+ *
+ * Safe to call from any thread, including from a loop thread (to itself or to another loop).
+ * Tasks dispatched to the same loop run in the order they were dispatched.
+ * Tasks dispatched before the group is started run once it starts.
+ *
+ * @param [in] group The group.
+ * @param [in] index The index of the destination loop.
+ * @param [in] task The function to run.
+ * @param [in] userData Passed to @p task.
+ * @returns true if the task was queued.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventSchedulerGroup_Dispatch(group, 1, _openConnection, connection);
+ * }
+ * @endcode
+ */
+bool parcEventSchedulerGroup_Dispatch(PARCEventSchedulerGroup *group, size_t index,
+                                      PARCEventSchedulerGroup_Task *task, void *userData);
+
+/**
+ * Queue a task to run on the loop at the given index, with a function to release @p userData
+ * if the task never runs.
+ *
+ * Behaves as {@link parcEventSchedulerGroup_Dispatch}. If the group is destroyed while the task
+ * is still queued, @p discard is called with @p userData instead of @p task.
+ *
+ * @param [in] group The group.
+ * @param [in] index The index of the destination loop.
+ * @param [in] task The function to run.
+ * @param [in] discard The function to call if @p task is never run, or NULL.
+ * @param [in] userData Passed to @p task or @p discard.
+ * @returns true if the task was queued.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEventSchedulerGroup_DispatchWithDiscard(group, 1, _openConnection, _closeConnection, connection);
+ * }
+ * @endcode
+ */
+bool parcEventSchedulerGroup_DispatchWithDiscard(PARCEventSchedulerGroup *group, size_t index,
+                                                 PARCEventSchedulerGroup_Task *task,
+                                                 PARCEventSchedulerGroup_Discard *discard, void *userData);
+
+/**
+ * Return the scheduler whose loop is running on the calling thread.
+ *
+ * @returns The scheduler, or NULL if the caller is not a loop thread of any group.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEventQueue *queue = parcEventQueue_Create(parcEventSchedulerGroup_CurrentScheduler(), fd, PARCEventQueueOption_CloseOnFree);
+ * }
+ * @endcode
+ */
+PARCEventScheduler *parcEventSchedulerGroup_CurrentScheduler(void);
+#endif // libparc_parc_EventSchedulerGroup_h
@@ -64,6 +64,7 @@
 #include <parc/algol/parc_EventScheduler.h>
 #include <parc/algol/parc_EventSignal.h>
 #include <parc/algol/parc_FileOutputStream.h>
+#include <parc/developer/parc_Trace.h>
 #include <parc/logging/parc_Log.h>
 #include <parc/logging/parc_LogReporterFile.h>
 
@@ -99,6 +100,7 @@ _parc_event_signal_callback(evutil_socket_t fd, short flags, void *context)
     parcEventSignal_LogDebug(parcEventSignal,
                              "_parc_event_signal_callback(fd=%x,flags=%x,parcEventSignal=%p)\n",
                              fd, flags, parcEventSignal);
+    parcTrace_Scope("PARCEventScheduler", "signal");
     parcEventSignal->callback((int) fd, internal_libevent_type_to_PARCEventType(flags),
                               parcEventSignal->callbackUserData);
 }
@@ -61,8 +61,10 @@
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_EventScheduler.h>
+#include <parc/algol/parc_EventSchedulerGroup.h>
 #include <parc/algol/parc_EventSocket.h>
 #include <parc/algol/parc_FileOutputStream.h>
+#include <parc/developer/parc_Trace.h>
 #include <parc/logging/parc_Log.h>
 #include <parc/logging/parc_LogReporterFile.h>
 
@@ -77,6 +79,8 @@ static int _parc_event_socket_debug_enabled = 0;
  */
 
 #include <sys/errno.h>
+#include <unistd.h>
+#include <netinet/in.h>
 #include <event2/listener.h>
 
 /**
@@ -94,8 +98,24 @@ struct PARCEventSocket {
     void *socketUserData;
     PARCEventSocket_ErrorCallback *socketErrorCallback;
     void *socketErrorUserData;
+
+    // Distributed sockets: the group accepted connections are spread over,
+    // and for ReusePort the listeners bound on loops 1 .. n-1.
+    PARCEventSchedulerGroup *group;
+    struct evconnlistener **loopListeners;
+    size_t loopListenerCount;
 };
 
+/**
+ * An accepted connection in transit from the accepting loop to the loop that will own it.
+ */
+typedef struct parc_event_socket_handoff {
+    PARCEventSocket *parcEventSocket;
+    int fd;
+    int socklen;
+    struct sockaddr_storage address;
+} _PARCEventSocketHandoff;
+
 static void
 _parc_evconn_callback(struct evconnlistener *listener, evutil_socket_t fd,
                       struct sockaddr *address, int socklen, void *ctx)
@@ -103,9 +123,58 @@ _parc_evconn_callback(struct evconnlistener *listener, evutil_socket_t fd,
     PARCEventSocket *parcEventSocket = (PARCEventSocket *) ctx;
     parcEventSocket_LogDebug(parcEventSocket, "_parc_evconn_callback(fd=%d,,parcEventSocket=%p)\n", fd, parcEventSocket);
 
+    parcTrace_Scope("PARCEventScheduler", "socket.accept");
     parcEventSocket->socketCallback((int) fd, address, socklen, parcEventSocket->socketUserData);
 }
 
+static void
+_parc_evconn_handoff_task(PARCEventScheduler *scheduler, void *userData)
+{
+    _PARCEventSocketHandoff *handoff = userData;
+    PARCEventSocket *parcEventSocket = handoff->parcEventSocket;
+
+    {
+        parcTrace_Scope("PARCEventScheduler", "socket.accept");
+        parcEventSocket->socketCallback(handoff->fd, (struct sockaddr *) &handoff->address, handoff->socklen,
+                                        parcEventSocket->socketUserData);
+    }
+    parcMemory_Deallocate((void **) &handoff);
+}
+
+static void
+_parc_evconn_handoff_discard(void *userData)
+{
+    _PARCEventSocketHandoff *handoff = userData;
+
+    close(handoff->fd);
+    parcMemory_Deallocate((void **) &handoff);
+}
+
+static void
+_parc_evconn_handoff_callback(struct evconnlistener *listener, evutil_socket_t fd,
+                              struct sockaddr *address, int socklen, void *ctx)
+{
+    PARCEventSocket *parcEventSocket = (PARCEventSocket *) ctx;
+
+    _PARCEventSocketHandoff *handoff = parcMemory_Allocate(sizeof(_PARCEventSocketHandoff));
+    if (handoff == NULL) {
+        close((int) fd);
+        return;
+    }
+    handoff->parcEventSocket = parcEventSocket;
+    handoff->fd = (int) fd;
+    handoff->socklen = (socklen <= (int) sizeof(handoff->address)) ? socklen : (int) sizeof(handoff->address);
+    memcpy(&handoff->address, address, handoff->socklen);
+
+    size_t index = parcEventSchedulerGroup_NextIndex(parcEventSocket->group);
+    parcEventSocket_LogDebug(parcEventSocket, "_parc_evconn_handoff_callback(fd=%d,loop=%zu,parcEventSocket=%p)\n",
+                             fd, index, parcEventSocket);
+    if (!parcEventSchedulerGroup_DispatchWithDiscard(parcEventSocket->group, index,
+                                                     _parc_evconn_handoff_task, _parc_evconn_handoff_discard, handoff)) {
+        _parc_evconn_handoff_discard(handoff);
+    }
+}
+
 static void
 _parc_evconn_error_callback(struct evconnlistener *listener, void *ctx)
 {
@@ -156,6 +225,122 @@ parcEventSocket_Create(PARCEventScheduler *eventScheduler,
     return parcEventSocket;
 }
 
+/**
+ * Rewrite the port of `sa` (INET or INET6) into `storage`, leaving other families untouched.
+ */
+static void
+_parcEventSocket_SetPort(struct sockaddr_storage *storage, const struct sockaddr *sa, int socklen, in_port_t port)
+{
+    memcpy(storage, sa, socklen);
+    if (sa->sa_family == AF_INET) {
+        ((struct sockaddr_in *) storage)->sin_port = port;
+    } else if (sa->sa_family == AF_INET6) {
+        ((struct sockaddr_in6 *) storage)->sin6_port = port;
+    }
+}
+
+static bool
+_parcEventSocket_BindLoopListeners(PARCEventSocket *parcEventSocket, const struct sockaddr *sa, int socklen)
+{
+#ifdef LEV_OPT_REUSEABLE_PORT
+    // Bind the remaining loops to the port the first listener actually got, so an ephemeral (0) port works.
+    struct sockaddr_storage bound;
+    socklen_t boundLength = sizeof(bound);
+    if (getsockname(parcEventSocket_GetFileDescriptor(parcEventSocket), (struct sockaddr *) &bound, &boundLength) != 0) {
+        return false;
+    }
+    in_port_t port = (bound.ss_family == AF_INET6) ? ((struct sockaddr_in6 *) &bound)->sin6_port
+                                                   : ((struct sockaddr_in *) &bound)->sin_port;
+    struct sockaddr_storage address;
+    _parcEventSocket_SetPort(&address, sa, socklen, port);
+
+    size_t count = parcEventSchedulerGroup_GetSchedulerCount(parcEventSocket->group);
+    parcEventSocket->loopListeners = parcMemory_AllocateAndClear(count * sizeof(struct evconnlistener *));
+    assertNotNull(parcEventSocket->loopListeners, "parcMemory_AllocateAndClear(%zu) returned NULL",
+                  count * sizeof(struct evconnlistener *));
+
+    for (size_t i = 1; i < count; i++) {
+        PARCEventScheduler *scheduler = parcEventSchedulerGroup_GetScheduler(parcEventSocket->group, i);
+        struct evconnlistener *listener =
+            evconnlistener_new_bind(parcEventScheduler_GetEvBase(scheduler),
+                                    _parc_evconn_callback, parcEventSocket,
+                                    LEV_OPT_REUSEABLE | LEV_OPT_REUSEABLE_PORT | LEV_OPT_CLOSE_ON_FREE, -1,
+                                    (struct sockaddr *) &address, socklen);
+        if (listener == NULL) {
+            return false;
+        }
+        if (parcEventSocket->socketErrorCallback) {
+            evconnlistener_set_error_cb(listener, _parc_evconn_error_callback);
+        }
+        parcEventSocket->loopListeners[parcEventSocket->loopListenerCount++] = listener;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+PARCEventSocket *
+parcEventSocket_CreateDistributed(PARCEventSchedulerGroup *group,
+                                  PARCEventSocketDistribution distribution,
+                                  PARCEventSocket_Callback *callback,
+                                  PARCEventSocket_ErrorCallback *errorCallback,
+                                  void *userData, const struct sockaddr *sa, int socklen)
+{
+#ifndef LEV_OPT_REUSEABLE_PORT
+    distribution = PARCEventSocketDistribution_RoundRobin;
+#endif
+    if (parcEventSchedulerGroup_GetSchedulerCount(group) == 1) {
+        distribution = PARCEventSocketDistribution_RoundRobin;
+    }
+
+    PARCEventSocket *parcEventSocket = parcMemory_AllocateAndClear(sizeof(PARCEventSocket));
+    assertNotNull(parcEventSocket, "parcMemory_Allocate(%zu) returned NULL", sizeof(PARCEventSocket));
+
+    parcEventSocket->eventScheduler = parcEventSchedulerGroup_GetScheduler(group, 0);
+    parcEventSocket->group = group;
+    parcEventSocket->socketCallback = callback;
+    parcEventSocket->socketErrorCallback = errorCallback;
+    parcEventSocket->socketUserData = userData;
+    parcEventSocket->socketErrorUserData = userData;
+
+    unsigned flags = LEV_OPT_REUSEABLE | LEV_OPT_CLOSE_ON_FREE;
+    evconnlistener_cb acceptCallback = _parc_evconn_handoff_callback;
+#ifdef LEV_OPT_REUSEABLE_PORT
+    if (distribution == PARCEventSocketDistribution_ReusePort) {
+        flags |= LEV_OPT_REUSEABLE_PORT;
+        acceptCallback = _parc_evconn_callback;
+    }
+#endif
+    parcEventSocket->listener = evconnlistener_new_bind(parcEventScheduler_GetEvBase(parcEventSocket->eventScheduler),
+                                                        acceptCallback, parcEventSocket, flags, -1, sa, socklen);
+    if (parcEventSocket->listener == NULL) {
+        parcLog_Error(parcEventScheduler_GetLogger(parcEventSocket->eventScheduler),
+                      "Libevent evconnlistener_new_bind error (%d): %s",
+                      errno, strerror(errno));
+        parcEventSocket_Destroy(&parcEventSocket);
+        return NULL;
+    }
+    if (errorCallback) {
+        evconnlistener_set_error_cb(parcEventSocket->listener, _parc_evconn_error_callback);
+    }
+
+    if (distribution == PARCEventSocketDistribution_ReusePort) {
+        if (!_parcEventSocket_BindLoopListeners(parcEventSocket, sa, socklen)) {
+            parcLog_Error(parcEventScheduler_GetLogger(parcEventSocket->eventScheduler),
+                          "SO_REUSEPORT listener bind error (%d): %s",
+                          errno, strerror(errno));
+            parcEventSocket_Destroy(&parcEventSocket);
+            return NULL;
+        }
+    }
+
+    parcEventSocket_LogDebug(parcEventSocket,
+                             "parcEventSocket_CreateDistributed(distribution=%d,cb=%p,args=%p) = %p\n",
+                             distribution, callback, userData, parcEventSocket);
+    return parcEventSocket;
+}
+
 void
 parcEventSocket_Destroy(PARCEventSocket **socketEvent)
 {
@@ -164,10 +349,22 @@ parcEventSocket_Destroy(PARCEventSocket **socketEvent)
     if ((*socketEvent)->listener) {
         evconnlistener_free((*socketEvent)->listener);
     }
+    for (size_t i = 0; i < (*socketEvent)->loopListenerCount; i++) {
+        evconnlistener_free((*socketEvent)->loopListeners[i]);
+    }
+    if ((*socketEvent)->loopListeners) {
+        parcMemory_Deallocate((void **) &(*socketEvent)->loopListeners);
+    }
     parcEventSocket_LogDebug((*socketEvent), "parcEventSocket_Destroy(%p)\n", *socketEvent);
     parcMemory_Deallocate((void **) socketEvent);
 }
 
+int
+parcEventSocket_GetFileDescriptor(const PARCEventSocket *parcEventSocket)
+{
+    return (int) evconnlistener_get_fd(parcEventSocket->listener);
+}
+
 void
 parcEventSocket_EnableDebug(void)
 {
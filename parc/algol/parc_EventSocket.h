@@ -76,6 +76,7 @@
  */
 
 #include <parc/algol/parc_EventScheduler.h>
+#include <parc/algol/parc_EventSchedulerGroup.h>
 #include <parc/algol/parc_Event.h>
 
 typedef struct PARCEventSocket PARCEventSocket;
@@ -112,6 +113,58 @@ PARCEventSocket *parcEventSocket_Create(PARCEventScheduler *parcEventScheduler,
                                         void *userData,
                                         const struct sockaddr *sa, int socklen);
 
+/**
+ * @typedef PARCEventSocketDistribution
+ * @brief How a distributed socket spreads accepted connections over the loops of a group
+ */
+typedef enum {
+    /** One listener on loop 0 hands each accepted connection to the next loop in turn. */
+    PARCEventSocketDistribution_RoundRobin = 0,
+    /** One SO_REUSEPORT listener per loop; the kernel balances connections and each loop accepts its own. */
+    PARCEventSocketDistribution_ReusePort = 1
+} PARCEventSocketDistribution;
+
+/**
+ * Create a socket event handler whose accepted connections are spread over a `PARCEventSchedulerGroup`.
+ *
+ * The callback runs on the loop that will own the connection, so it may create events on
+ * {@link parcEventSchedulerGroup_CurrentScheduler}. The error callback receives the scheduler of loop 0.
+ * `ReusePort` falls back to `RoundRobin` if the platform lacks SO_REUSEPORT or the group has one loop.
+ * A port of 0 binds every listener to the same ephemeral port.
+ *
+ * The socket must be created before the group is started and destroyed after it is stopped.
+ *
+ * @param [in] group the group whose loops will own accepted connections
+ * @param [in] distribution how connections are spread over the loops
+ * @param [in] callback the callback function.
+ * @param [in] errorCallback the error callback function.
+ * @param [in] userData pointer to private arguments for instance callback function
+ * @param [in] sa is the socket address to bind to (INET, INET6, LOCAL)
+ * @param [in] socklen is the sizeof the actual sockaddr (e.g. sizeof(sockaddr_un))
+ * @returns A pointer to a new PARCEventSocket instance, or NULL if a listener could not be bound.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(0);
+ *     PARCEventSocket *socket = parcEventSocket_CreateDistributed(group, PARCEventSocketDistribution_ReusePort,
+ *                                                                 _accept, NULL, server, (struct sockaddr *) &addr, sizeof(addr));
+ *     parcEventSchedulerGroup_Start(group);
+ *     ...
+ *     parcEventSchedulerGroup_Stop(group);
+ *     parcEventSocket_Destroy(&socket);
+ *     parcEventSchedulerGroup_Destroy(&group);
+ * }
+ * @endcode
+ *
+ */
+PARCEventSocket *parcEventSocket_CreateDistributed(PARCEventSchedulerGroup *group,
+                                                   PARCEventSocketDistribution distribution,
+                                                   PARCEventSocket_Callback *callback,
+                                                   PARCEventSocket_ErrorCallback *errorCallback,
+                                                   void *userData,
+                                                   const struct sockaddr *sa, int socklen);
+
 /**
  * Destroy a socket event handler instance.
  *
@@ -129,6 +182,27 @@ PARCEventSocket *parcEventSocket_Create(PARCEventScheduler *parcEventScheduler,
  */
 void parcEventSocket_Destroy(PARCEventSocket **parcEventSocket);
 
+/**
+ * Return the file descriptor of the listening socket.
+ *
+ * For a distributed socket this is the listener of loop 0.
+ * Useful with `getsockname` to learn the port chosen when binding to port 0.
+ *
+ * @param [in] parcEventSocket the socket instance
+ * @returns The listening file descriptor
+ *
+ * Example:
+ * @code
+ * {
+ *     struct sockaddr_in bound;
+ *     socklen_t length = sizeof(bound);
+ *     getsockname(parcEventSocket_GetFileDescriptor(socket), (struct sockaddr *) &bound, &length);
+ * }
+ * @endcode
+ *
+ */
+int parcEventSocket_GetFileDescriptor(const PARCEventSocket *parcEventSocket);
+
 /**
  * Turn on debugging flags and messages
  *
@@ -62,6 +62,7 @@
 
 #include "internal_parc_Event.h"
 #include <parc/algol/parc_EventTimer.h>
+#include <parc/developer/parc_Trace.h>
 
 static int _parc_event_timer_debug_enabled = 0;
 
@@ -95,6 +96,7 @@ _parc_event_timer_callback(evutil_socket_t fd, short flags, void *context)
     parcEventTimer_LogDebug(parcEventTimer,
                             "_parc_event_timer_callback(fd=%x,flags=%x,parcEventTimer=%p)\n",
                             fd, flags, parcEventTimer);
+    parcTrace_Scope("PARCEventScheduler", "timer");
     parcEventTimer->callback((int) fd, internal_libevent_type_to_PARCEventType(flags),
                              parcEventTimer->callbackUserData);
 }
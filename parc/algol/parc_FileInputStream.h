@@ -88,7 +88,7 @@ typedef struct parc_file_input_stream PARCFileInputStream;
  * <#example#>
  * @endcode
  */
-PARCInputStreamInterface *PARCFileInputStreamAsPARCInputStream;
+extern PARCInputStreamInterface *PARCFileInputStreamAsPARCInputStream;
 
 /**
  * Create a `PARCFileInputStream` instance.
@@ -53,17 +53,26 @@
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
 /**
- * Implements an open-addressing hash table.  We use linear probing of +1 per step.
+ * Implements an open-addressing hash table using Robin Hood hashing.
  *
- * Table is rehashed when we reach 75% utilization.
- * The table is rehashed if we go more than 10 linear probes without being able to insert.
+ * Each entry records its probe distance, the number of slots it lies past its home slot.
+ * On insert, an entry being placed displaces any resident entry with a shorter probe distance,
+ * which keeps probe distances short and uniform even for clustered hash codes.
+ * A lookup stops as soon as it reaches an empty slot or an entry with a shorter probe distance than its own,
+ * so unsuccessful lookups do not scan the table.  Deletion shifts the following entries of the run back by one slot,
+ * so no tombstones are needed.  Probe lengths are unbounded: a run of colliding hash codes makes probes longer,
+ * it never forces the table to grow.
+ *
+ * Hash codes are mixed before they select a home slot, so hash codes that differ only in their high bits,
+ * or that are multiples of the table size, still spread across the table.
+ *
+ * The table grows when it reaches 75% utilization.  Growing is incremental: a table twice the size is allocated
+ * and each subsequent Add moves a few slots of the old table into it, so no single Add pays for a full rehash.
+ * Until the old table is empty, Get and Del look in both tables.
  *
  * HashCodeTable is a wrapper that holds the key/data management functions.  It also
  * has LinearAddressingHashTable that is the actual hash table.
  *
- * This open-addressing table is inefficient for GET or DEL if the element does not exist.
- * The whole table needs to be
- *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -83,38 +92,41 @@
 // when we expand, use this factor
 #define EXPAND_FACTOR   2
 
-#define MAX_PROBE_LENGTH 20
-
-typedef enum {
-    ADD_OK,     // we added the key
-    ADD_DUP,    // the key is a duplicate
-    ADD_NOSPACE // ran out of space
-} PARCHashCodeTable_AddResult;
+// the number of old-table slots moved to the new table by each Add while expanding
+#define MIGRATE_SLOTS_PER_ADD 8
 
 typedef struct hashtable_entry {
     // A hashtable entry is in use if the key is non-null
     void *key;
     void *data;
     HashCodeType hashcode;
+
+    // The number of slots this entry lies past its home slot.
+    uint32_t probeDistance;
 } HashTableEntry;
 
 typedef struct linear_address_hash_table {
     HashTableEntry  *entries;
 
-    // Number of elements allocated
+    // Number of elements allocated, always a power of 2
     size_t tableLimit;
 
     // Number of elements in use
     size_t tableSize;
 
     // When the tableSize equals or exceeds this
-    // threshold, we should expand and re-hash the table∫
+    // threshold, we should expand and re-hash the table
     size_t expandThreshold;
 } LinearAddressingHashTable;
 
 struct parc_hashcode_table {
     LinearAddressingHashTable hashtable;
 
+    // While expanding, the table whose entries are being moved into `hashtable`,
+    // and the next of its slots to move.  Its entries are NULL otherwise.
+    LinearAddressingHashTable previous;
+    size_t migrateIndex;
+
     PARCHashCodeTable_KeyEqualsFunc keyEqualsFunc;
     PARCHashCodeTable_HashCodeFunc keyHashCodeFunc;
     PARCHashCodeTable_Destroyer keyDestroyer;
@@ -123,117 +135,170 @@ struct parc_hashcode_table {
     unsigned expandCount;
 };
 
-static bool
-_findIndex(PARCHashCodeTable *table, const void *key, size_t *outputIndexPtr)
+static size_t
+_homeIndex(const LinearAddressingHashTable *innerTable, HashCodeType hashcode)
 {
-    size_t index, start;
-    HashCodeType hashcode;
-    LinearAddressingHashTable *innerTable;
-
-    innerTable = &table->hashtable;
-    hashcode = table->keyHashCodeFunc(key);
-    index = hashcode % innerTable->tableLimit;
-    start = index;
-
-
-    // check until we've gone MAX_PROBE_LENGTH
-    unsigned steps = 0;
-    do {
-        if (innerTable->entries[index].key != NULL) {
-            if ((innerTable->entries[index].hashcode == hashcode) && table->keyEqualsFunc(key, innerTable->entries[index].key)) {
-                // the key already exists in the table
-                *outputIndexPtr = index;
-                return true;
-            }
-        }
-        steps++;
-        index = index + 1;
-        if (index == innerTable->tableLimit) {
-            index = 0;
-        }
-    } while (index != start && steps < MAX_PROBE_LENGTH);
+    uint64_t mixed = (uint64_t) hashcode * 0x9E3779B97F4A7C15ULL;
+    return (size_t) (mixed ^ (mixed >> 32)) & (innerTable->tableLimit - 1);
+}
 
-    return false;
+static void
+_innerTableInit(LinearAddressingHashTable *innerTable, size_t tableLimit)
+{
+    innerTable->entries = parcMemory_AllocateAndClear(tableLimit * sizeof(HashTableEntry));
+    assertNotNull(innerTable->entries, "parcMemory_AllocateAndClear(%zu) returned NULL", tableLimit * sizeof(HashTableEntry));
+    innerTable->tableLimit = tableLimit;
+    innerTable->tableSize = 0;
+
+    // expand at 75% utilization
+    innerTable->expandThreshold = tableLimit - tableLimit / 4;
 }
 
-static PARCHashCodeTable_AddResult
-_innerTableAdd(LinearAddressingHashTable *innerTable, PARCHashCodeTable_KeyEqualsFunc keyEqualsFunc,
-               HashCodeType hashcode, void *key, void *data)
+static bool
+_innerTableFind(const LinearAddressingHashTable *innerTable, PARCHashCodeTable_KeyEqualsFunc keyEqualsFunc,
+                HashCodeType hashcode, const void *key, size_t *outputIndexPtr)
 {
-    size_t index = hashcode % innerTable->tableLimit;
+    if (innerTable->entries == NULL || innerTable->tableSize == 0) {
+        return false;
+    }
 
-    unsigned steps = 0;
+    size_t mask = innerTable->tableLimit - 1;
+    size_t index = _homeIndex(innerTable, hashcode);
 
-    // we know the size < limit, so it will fit eventually
-    while (steps < MAX_PROBE_LENGTH) {
-        if (innerTable->entries[index].key == NULL) {
-            innerTable->entries[index].hashcode = hashcode;
-            innerTable->entries[index].key = key;
-            innerTable->entries[index].data = data;
-            innerTable->tableSize++;
-            return ADD_OK;
+    // Every entry of a run is at least as far from home as the entry being sought would be,
+    // so the search ends at the first empty slot or closer-to-home entry.
+    for (uint32_t distance = 0; ; distance++) {
+        const HashTableEntry *entry = &innerTable->entries[index];
+        if (entry->key == NULL || entry->probeDistance < distance) {
+            return false;
         }
-
-        if ((innerTable->entries[index].hashcode == hashcode) && keyEqualsFunc(key, innerTable->entries[index].key)) {
-            // the key already exists in the table
-            return ADD_DUP;
+        if ((entry->hashcode == hashcode) && keyEqualsFunc(key, entry->key)) {
+            *outputIndexPtr = index;
+            return true;
         }
+        index = (index + 1) & mask;
+    }
+}
 
-        steps++;
-        index = index + 1;
-        if (index == innerTable->tableLimit) {
-            index = 0;
+/**
+ * Insert an entry known not to be in the table, which must have a free slot.
+ */
+static void
+_innerTableInsert(LinearAddressingHashTable *innerTable, HashCodeType hashcode, void *key, void *data)
+{
+    size_t mask = innerTable->tableLimit - 1;
+    size_t index = _homeIndex(innerTable, hashcode);
+    HashTableEntry pending = { .key = key, .data = data, .hashcode = hashcode, .probeDistance = 0 };
+
+    for (;;) {
+        HashTableEntry *entry = &innerTable->entries[index];
+        if (entry->key == NULL) {
+            *entry = pending;
+            innerTable->tableSize++;
+            return;
         }
+        // Robin Hood: the entry further from its home slot takes this slot.
+        if (entry->probeDistance < pending.probeDistance) {
+            HashTableEntry displaced = *entry;
+            *entry = pending;
+            pending = displaced;
+        }
+        pending.probeDistance++;
+        index = (index + 1) & mask;
     }
+}
 
-    return ADD_NOSPACE;
+/**
+ * Remove the entry at the given index, shifting the rest of its run back by one slot.
+ */
+static void
+_innerTableRemoveIndex(LinearAddressingHashTable *innerTable, size_t index)
+{
+    size_t mask = innerTable->tableLimit - 1;
+    size_t next = (index + 1) & mask;
+
+    while (innerTable->entries[next].key != NULL && innerTable->entries[next].probeDistance > 0) {
+        innerTable->entries[index] = innerTable->entries[next];
+        innerTable->entries[index].probeDistance--;
+        index = next;
+        next = (next + 1) & mask;
+    }
+    memset(&innerTable->entries[index], 0, sizeof(HashTableEntry));
+    innerTable->tableSize--;
 }
 
-static PARCHashCodeTable_AddResult
-_rehash(LinearAddressingHashTable *old_table, LinearAddressingHashTable *new_table, PARCHashCodeTable_KeyEqualsFunc keyEqualsFunc)
+static bool
+_isExpanding(const PARCHashCodeTable *table)
 {
-    size_t i;
-    for (i = 0; i < old_table->tableLimit; i++) {
-        if (old_table->entries[i].key != NULL) {
-            PARCHashCodeTable_AddResult result = _innerTableAdd(new_table, keyEqualsFunc, old_table->entries[i].hashcode,
-                                                                old_table->entries[i].key, old_table->entries[i].data);
-            if (result != ADD_OK) {
-                return result;
-            }
+    return table->previous.entries != NULL;
+}
+
+/**
+ * Move up to `slots` slots of the previous table into the current table,
+ * releasing the previous table once it is empty.
+ */
+static void
+_migrate(PARCHashCodeTable *table, size_t slots)
+{
+    LinearAddressingHashTable *previous = &table->previous;
+
+    while (slots > 0 && previous->tableSize > 0) {
+        HashTableEntry *entry = &previous->entries[table->migrateIndex];
+        if (entry->key != NULL) {
+            _innerTableInsert(&table->hashtable, entry->hashcode, entry->key, entry->data);
+            // Removing may shift the next entry of the run into this slot, so stay on it.
+            _innerTableRemoveIndex(previous, table->migrateIndex);
+        } else {
+            table->migrateIndex = (table->migrateIndex + 1) & (previous->tableLimit - 1);
         }
+        slots--;
+    }
+
+    if (previous->tableSize == 0) {
+        parcMemory_Deallocate((void **) &previous->entries);
+        memset(previous, 0, sizeof(LinearAddressingHashTable));
+        table->migrateIndex = 0;
     }
-    return ADD_OK;
 }
 
 static void
 _expand(PARCHashCodeTable *hashCodeTable)
 {
-    LinearAddressingHashTable temp_table;
-    LinearAddressingHashTable *old_table = &hashCodeTable->hashtable;
-
-    size_t expandby = EXPAND_FACTOR;
-
-    // start with a copy of the current table
-    PARCHashCodeTable_AddResult result = ADD_OK;
-    do {
-        hashCodeTable->expandCount++;
-
-        temp_table.tableSize = 0;
-        temp_table.tableLimit = old_table->tableLimit * expandby;
-        temp_table.expandThreshold = temp_table.tableLimit - temp_table.tableLimit / 4;
-        temp_table.entries = parcMemory_AllocateAndClear(temp_table.tableLimit * sizeof(HashTableEntry));
-        assertNotNull(temp_table.entries, "parcMemory_AllocateAndClear(%zu) returned NULL", temp_table.tableLimit * sizeof(HashTableEntry));
-
-        result = _rehash(old_table, &temp_table, hashCodeTable->keyEqualsFunc);
-        if (result == ADD_NOSPACE) {
-            // could not rehash, so expand by more and try again
-            parcMemory_Deallocate((void **) &(temp_table.entries));
-            expandby++;
-        }
-    } while (result == ADD_NOSPACE);
+    // An expansion still in progress is finished first, there is only ever one previous table.
+    if (_isExpanding(hashCodeTable)) {
+        _migrate(hashCodeTable, SIZE_MAX);
+    }
+
+    hashCodeTable->expandCount++;
+
+    hashCodeTable->previous = hashCodeTable->hashtable;
+    hashCodeTable->migrateIndex = 0;
+    _innerTableInit(&hashCodeTable->hashtable, hashCodeTable->previous.tableLimit * EXPAND_FACTOR);
+}
+
+/**
+ * Find the key in either the current or, while expanding, the previous table.
+ */
+static LinearAddressingHashTable *
+_find(PARCHashCodeTable *table, HashCodeType hashcode, const void *key, size_t *outputIndexPtr)
+{
+    if (_innerTableFind(&table->hashtable, table->keyEqualsFunc, hashcode, key, outputIndexPtr)) {
+        return &table->hashtable;
+    }
+    if (_innerTableFind(&table->previous, table->keyEqualsFunc, hashcode, key, outputIndexPtr)) {
+        return &table->previous;
+    }
+    return NULL;
+}
 
-    parcMemory_Deallocate((void **) &old_table->entries);
-    hashCodeTable->hashtable = temp_table;
+static size_t
+_roundUpToPowerOf2(size_t size)
+{
+    size_t result = 1;
+    while (result < size) {
+        result <<= 1;
+    }
+    return result;
 }
 
 PARCHashCodeTable *
@@ -255,15 +320,8 @@ parcHashCodeTable_Create_Size(PARCHashCodeTable_KeyEqualsFunc keyEqualsFunc,
     table->keyDestroyer = keyDestroyer;
     table->dataDestroyer = dataDestroyer;
 
-    table->hashtable.entries = parcMemory_AllocateAndClear(minimumSize * sizeof(HashTableEntry));
-    assertNotNull(table->hashtable.entries, "parcMemory_AllocateAndClear(%zu) returned NULL", minimumSize * sizeof(HashTableEntry));
-    table->hashtable.tableLimit = minimumSize;
-    table->hashtable.tableSize = 0;
-
-    memset(table->hashtable.entries, 0, minimumSize * sizeof(HashTableEntry));
-
-    // expand at 75% utilization
-    table->hashtable.expandThreshold = minimumSize - minimumSize / 4;
+    // A table of fewer than 2 slots cannot hold an entry below the 75% expansion threshold.
+    _innerTableInit(&table->hashtable, _roundUpToPowerOf2(minimumSize < 2 ? 2 : minimumSize));
 
     return table;
 }
@@ -277,27 +335,38 @@ parcHashCodeTable_Create(PARCHashCodeTable_KeyEqualsFunc keyEqualsFunc,
     return parcHashCodeTable_Create_Size(keyEqualsFunc, keyHashCodeFunc, keyDestroyer, dataDestroyer, MIN_SIZE);
 }
 
-void
-parcHashCodeTable_Destroy(PARCHashCodeTable **tablePtr)
+static void
+_innerTableDestroy(PARCHashCodeTable *table, LinearAddressingHashTable *innerTable)
 {
-    assertNotNull(tablePtr, "Parameter must be non-null double pointer");
-    assertNotNull(*tablePtr, "Parameter must dereference to non-null pointer");
-    PARCHashCodeTable *table = *tablePtr;
-    size_t i;
+    if (innerTable->entries == NULL) {
+        return;
+    }
 
-    for (i = 0; i < table->hashtable.tableLimit; i++) {
-        if (table->hashtable.entries[i].key != NULL) {
+    for (size_t i = 0; i < innerTable->tableLimit; i++) {
+        if (innerTable->entries[i].key != NULL) {
             if (table->keyDestroyer) {
-                table->keyDestroyer(&table->hashtable.entries[i].key);
+                table->keyDestroyer(&innerTable->entries[i].key);
             }
 
             if (table->dataDestroyer) {
-                table->dataDestroyer(&table->hashtable.entries[i].data);
+                table->dataDestroyer(&innerTable->entries[i].data);
             }
         }
     }
 
-    parcMemory_Deallocate((void **) &(table->hashtable.entries));
+    parcMemory_Deallocate((void **) &(innerTable->entries));
+}
+
+void
+parcHashCodeTable_Destroy(PARCHashCodeTable **tablePtr)
+{
+    assertNotNull(tablePtr, "Parameter must be non-null double pointer");
+    assertNotNull(*tablePtr, "Parameter must dereference to non-null pointer");
+    PARCHashCodeTable *table = *tablePtr;
+
+    _innerTableDestroy(table, &table->hashtable);
+    _innerTableDestroy(table, &table->previous);
+
     parcMemory_Deallocate((void **) &table);
     *tablePtr = NULL;
 }
@@ -309,48 +378,51 @@ parcHashCodeTable_Add(PARCHashCodeTable *table, void *key, void *data)
     assertNotNull(key, "Parameter key must be non-null");
     assertNotNull(data, "Parameter data must be non-null");
 
+    HashCodeType hashcode = table->keyHashCodeFunc(key);
+
+    size_t index;
+    if (_find(table, hashcode, key, &index) != NULL) {
+        // the key already exists in the table
+        return false;
+    }
+
+    if (_isExpanding(table)) {
+        _migrate(table, MIGRATE_SLOTS_PER_ADD);
+    }
     if (table->hashtable.tableSize >= table->hashtable.expandThreshold) {
         _expand(table);
     }
 
-    HashCodeType hashcode = table->keyHashCodeFunc(key);
-
-    PARCHashCodeTable_AddResult result = ADD_OK;
-    do {
-        result = _innerTableAdd(&table->hashtable, table->keyEqualsFunc, hashcode, key, data);
-        if (result == ADD_NOSPACE) {
-            _expand(table);
-        }
-    } while (result == ADD_NOSPACE);
-
-    return (result == ADD_OK);
+    _innerTableInsert(&table->hashtable, hashcode, key, data);
+    return true;
 }
 
 void
 parcHashCodeTable_Del(PARCHashCodeTable *table, const void *key)
 {
     size_t index;
-    bool found;
 
     assertNotNull(table, "Parameter table must be non-null");
     assertNotNull(key, "parameter key must be non-null");
 
-    found = _findIndex(table, key, &index);
+    LinearAddressingHashTable *innerTable = _find(table, table->keyHashCodeFunc(key), key, &index);
 
-    if (found) {
-        assertTrue(table->hashtable.tableSize > 0, "Illegal state: found entry in a hash table with 0 size");
+    if (innerTable != NULL) {
+        assertTrue(innerTable->tableSize > 0, "Illegal state: found entry in a hash table with 0 size");
 
         if (table->keyDestroyer) {
-            table->keyDestroyer(&table->hashtable.entries[index].key);
+            table->keyDestroyer(&innerTable->entries[index].key);
         }
 
         if (table->dataDestroyer) {
-            table->dataDestroyer(&table->hashtable.entries[index].data);
+            table->dataDestroyer(&innerTable->entries[index].data);
         }
 
-        memset(&table->hashtable.entries[index], 0, sizeof(HashTableEntry));
+        _innerTableRemoveIndex(innerTable, index);
 
-        table->hashtable.tableSize--;
+        if (innerTable == &table->previous) {
+            _migrate(table, 0);
+        }
     }
 }
 
@@ -362,10 +434,10 @@ parcHashCodeTable_Get(PARCHashCodeTable *table, const void *key)
     assertNotNull(table, "Parameter table must be non-null");
     assertNotNull(key, "parameter key must be non-null");
 
-    bool found = _findIndex(table, key, &index);
+    LinearAddressingHashTable *innerTable = _find(table, table->keyHashCodeFunc(key), key, &index);
 
-    if (found) {
-        return table->hashtable.entries[index].data;
+    if (innerTable != NULL) {
+        return innerTable->entries[index].data;
     }
 
     return NULL;
@@ -375,5 +447,42 @@ size_t
 parcHashCodeTable_Length(const PARCHashCodeTable *table)
 {
     assertNotNull(table, "Parameter table must be non-null");
-    return table->hashtable.tableSize;
+    return table->hashtable.tableSize + table->previous.tableSize;
+}
+
+static void
+_innerTableAccumulateStatistics(const LinearAddressingHashTable *innerTable, PARCHashCodeTableStatistics *statistics,
+                                uint64_t *totalProbeLength)
+{
+    for (size_t i = 0; i < innerTable->tableLimit; i++) {
+        if (innerTable->entries[i].key != NULL) {
+            size_t probeLength = innerTable->entries[i].probeDistance + 1;
+            *totalProbeLength += probeLength;
+            if (probeLength > statistics->maximumProbeLength) {
+                statistics->maximumProbeLength = probeLength;
+            }
+        }
+    }
+    statistics->capacity += innerTable->tableLimit;
+}
+
+void
+parcHashCodeTable_GetStatistics(const PARCHashCodeTable *table, PARCHashCodeTableStatistics *statistics)
+{
+    assertNotNull(table, "Parameter table must be non-null");
+    assertNotNull(statistics, "Parameter statistics must be non-null");
+
+    memset(statistics, 0, sizeof(PARCHashCodeTableStatistics));
+
+    uint64_t totalProbeLength = 0;
+    _innerTableAccumulateStatistics(&table->hashtable, statistics, &totalProbeLength);
+    _innerTableAccumulateStatistics(&table->previous, statistics, &totalProbeLength);
+
+    statistics->length = parcHashCodeTable_Length(table);
+    statistics->loadFactor = (double) table->hashtable.tableSize / (double) table->hashtable.tableLimit;
+    if (statistics->length > 0) {
+        statistics->meanProbeLength = (double) totalProbeLength / (double) statistics->length;
+    }
+    statistics->expandCount = table->expandCount;
+    statistics->expanding = _isExpanding(table);
 }
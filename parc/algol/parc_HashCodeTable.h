@@ -206,4 +206,39 @@ void *parcHashCodeTable_Get(PARCHashCodeTable *table, const void *key);
  * @endcode
  */
 size_t parcHashCodeTable_Length(const PARCHashCodeTable *table);
+
+/**
+ * @typedef PARCHashCodeTableStatistics
+ * @brief A snapshot of the occupancy and probe lengths of a `PARCHashCodeTable`.
+ *
+ * The probe length of an entry is the number of slots examined to find it, 1 if it is in its home slot.
+ */
+typedef struct parc_hashcode_table_statistics {
+    size_t length;              // The number of entries.
+    size_t capacity;            // The number of slots, including those of a table being drained by an expansion.
+    double loadFactor;          // The fraction of the current table's slots in use.
+    size_t maximumProbeLength;  // The longest probe length of any entry.
+    double meanProbeLength;     // The mean probe length over all entries, 0 if the table is empty.
+    unsigned expandCount;       // The number of times the table has grown.
+    bool expanding;             // True if entries are still being moved out of the previous table.
+} PARCHashCodeTableStatistics;
+
+/**
+ * Fill in a `PARCHashCodeTableStatistics` describing the given table.
+ *
+ * This examines every slot of the table, so it is meant for diagnostics and tuning, not the fast path.
+ *
+ * @param [in] table  The specified `PARCHashCodeTable` instance.
+ * @param [out] statistics  The `PARCHashCodeTableStatistics` to fill in.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashCodeTableStatistics statistics;
+ *     parcHashCodeTable_GetStatistics(table, &statistics);
+ *     printf("%zu entries, longest probe %zu\n", statistics.length, statistics.maximumProbeLength);
+ * }
+ * @endcode
+ */
+void parcHashCodeTable_GetStatistics(const PARCHashCodeTable *table, PARCHashCodeTableStatistics *statistics);
 #endif // libparc_parc_HashCodeTable_h
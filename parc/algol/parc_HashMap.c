@@ -137,16 +137,16 @@ _parcHashMap_GetEntry(const PARCHashMap *hashMap, const PARCObject *key)
     _PARCHashMapEntry *result = NULL;
 
     if (hashMap->buckets[bucket] != NULL) {
-        PARCIterator *iterator = parcLinkedList_CreateIterator(hashMap->buckets[bucket]);
+        PARCLinkedListCursor cursor;
+        parcLinkedListCursor_Init(&cursor, hashMap->buckets[bucket]);
 
-        while (parcIterator_HasNext(iterator)) {
-            _PARCHashMapEntry *entry = parcIterator_Next(iterator);
+        while (parcLinkedListCursor_HasNext(&cursor)) {
+            _PARCHashMapEntry *entry = parcLinkedListCursor_Next(&cursor);
             if (parcObject_Equals(key, entry->key)) {
                 result = entry;
                 break;
             }
         }
-        parcIterator_Release(&iterator);
     }
 
     return result;
@@ -260,18 +260,18 @@ parcHashMap_Display(const PARCHashMap *hashMap, int indentation)
 {
     parcDisplayIndented_PrintLine(indentation, "PARCHashMap@%p {", hashMap);
 
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator((PARCHashMap *) hashMap);
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, (PARCHashMap *) hashMap);
 
-    while (parcIterator_HasNext(iterator)) {
-        PARCObject *keyObject = parcIterator_Next(iterator);
-        const PARCObject *valueObject = parcHashMap_Get(hashMap, keyObject);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        PARCObject *keyObject = parcHashMapCursor_Next(&cursor);
+        const PARCObject *valueObject = parcHashMapCursor_GetValue(&cursor);
         char *key = parcObject_ToString(keyObject);
         char *value = parcObject_ToString(valueObject);
         parcDisplayIndented_PrintLine(indentation + 1, "%s -> %s", key, value);
         parcMemory_Deallocate(&key);
         parcMemory_Deallocate(&value);
     }
-    parcIterator_Release(&iterator);
 
     parcDisplayIndented_PrintLine(indentation, "}");
 }
@@ -353,11 +353,12 @@ parcHashMap_ToJSON(const PARCHashMap *hashMap)
 
     PARCJSON *result = parcJSON_Create();
 
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator((PARCHashMap *) hashMap);
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, (PARCHashMap *) hashMap);
 
-    while (parcIterator_HasNext(iterator)) {
-        PARCObject *keyObject = parcIterator_Next(iterator);
-        const PARCObject *valueObject = parcHashMap_Get(hashMap, keyObject);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        PARCObject *keyObject = parcHashMapCursor_Next(&cursor);
+        const PARCObject *valueObject = parcHashMapCursor_GetValue(&cursor);
         char *key = parcObject_ToString(keyObject);
         PARCJSON *value = parcObject_ToJSON(valueObject);
 
@@ -367,8 +368,6 @@ parcHashMap_ToJSON(const PARCHashMap *hashMap)
         parcJSON_Release(&value);
     }
 
-    parcIterator_Release(&iterator);
-
 
     return result;
 }
@@ -376,11 +375,12 @@ parcHashMap_ToJSON(const PARCHashMap *hashMap)
 PARCBufferComposer *
 parcHashMap_BuildString(const PARCHashMap *hashMap, PARCBufferComposer *composer)
 {
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator((PARCHashMap *) hashMap);
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, (PARCHashMap *) hashMap);
 
-    while (parcIterator_HasNext(iterator)) {
-        PARCObject *keyObject = parcIterator_Next(iterator);
-        const PARCObject *valueObject = parcHashMap_Get(hashMap, keyObject);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        PARCObject *keyObject = parcHashMapCursor_Next(&cursor);
+        const PARCObject *valueObject = parcHashMapCursor_GetValue(&cursor);
         char *key = parcObject_ToString(keyObject);
         char *value = parcObject_ToString(valueObject);
         parcBufferComposer_Format(composer, "%s -> %s\n", key, value);
@@ -388,8 +388,6 @@ parcHashMap_BuildString(const PARCHashMap *hashMap, PARCBufferComposer *composer
         parcMemory_Deallocate(&value);
     }
 
-    parcIterator_Release(&iterator);
-
     return composer;
 }
 
@@ -436,9 +434,10 @@ _parcHashMap_Resize(PARCHashMap *hashMap, size_t newCapacity)
     for (unsigned int i = 0; i < hashMap->capacity; i++) {
         if (hashMap->buckets[i] != NULL) {
             if (!parcLinkedList_IsEmpty(hashMap->buckets[i])) {
-                PARCIterator *elementIt = parcLinkedList_CreateIterator(hashMap->buckets[i]);
-                while (parcIterator_HasNext(elementIt)) {
-                    _PARCHashMapEntry *entry = parcIterator_Next(elementIt);
+                PARCLinkedListCursor cursor;
+                parcLinkedListCursor_Init(&cursor, hashMap->buckets[i]);
+                while (parcLinkedListCursor_HasNext(&cursor)) {
+                    _PARCHashMapEntry *entry = parcLinkedListCursor_Next(&cursor);
                     PARCHashCode keyHash = parcObject_HashCode(entry->key);
                     int newBucket = keyHash % newCapacity;
                     if (newBuckets[newBucket] == NULL) {
@@ -446,7 +445,6 @@ _parcHashMap_Resize(PARCHashMap *hashMap, size_t newCapacity)
                     }
                     parcLinkedList_Append(newBuckets[newBucket], entry);
                 }
-                parcIterator_Release(&elementIt);
             }
             parcLinkedList_Release(&hashMap->buckets[i]);
         }
@@ -468,18 +466,18 @@ parcHashMap_Remove(PARCHashMap *hashMap, const PARCObject *key)
     bool result = false;
 
     if (hashMap->buckets[bucket] != NULL) {
-        PARCIterator *iterator = parcLinkedList_CreateIterator(hashMap->buckets[bucket]);
+        PARCLinkedListCursor cursor;
+        parcLinkedListCursor_Init(&cursor, hashMap->buckets[bucket]);
 
-        while (parcIterator_HasNext(iterator)) {
-            _PARCHashMapEntry *entry = parcIterator_Next(iterator);
+        while (parcLinkedListCursor_HasNext(&cursor)) {
+            _PARCHashMapEntry *entry = parcLinkedListCursor_Next(&cursor);
             if (parcObject_Equals(key, entry->key)) {
-                parcIterator_Remove(iterator);
+                parcLinkedListCursor_Remove(&cursor);
                 hashMap->size--;
                 result = true;
                 break;
             }
         }
-        parcIterator_Release(&iterator);
     }
 
     // When expanded by 2 the load factor goes from .75 (3/4) to .375 (3/8), if
@@ -584,96 +582,114 @@ parcHashMap_GetClusteringNumber(const PARCHashMap *hashMap)
     return standardDeviation * ((double)hashMap->capacity/(double)totalLength);
 }
 
-typedef struct {
-    PARCHashMap *map;
-    int bucket;
-    PARCIterator *listIterator;
-    _PARCHashMapEntry *current;
-} _PARCHashMapIterator;
+static void
+_parcHashMapCursor_SeekBucket(PARCHashMapCursor *cursor, size_t bucket)
+{
+    cursor->bucket = bucket;
+    cursor->bucketCursor.list = NULL;
 
-static _PARCHashMapIterator *
-_parcHashMap_Init(PARCHashMap *map __attribute__((unused)))
+    for (; cursor->bucket < cursor->map->capacity; cursor->bucket++) {
+        if (cursor->map->buckets[cursor->bucket] != NULL) {
+            parcLinkedListCursor_Init(&cursor->bucketCursor, cursor->map->buckets[cursor->bucket]);
+            break;
+        }
+    }
+}
+
+void
+parcHashMapCursor_Init(PARCHashMapCursor *cursor, PARCHashMap *hashMap)
 {
-    _PARCHashMapIterator *state = parcMemory_AllocateAndClear(sizeof(_PARCHashMapIterator));
+    cursor->map = hashMap;
+    cursor->entry = NULL;
+    _parcHashMapCursor_SeekBucket(cursor, 0);
+}
 
-    if (state != NULL) {
-        state->map = map;
-        state->bucket = 0;
-        state->listIterator = NULL;
-        for (size_t i = 0; i < map->capacity; ++i) {
-            if (map->buckets[i] != NULL) {
-                state->bucket = i;
-                state->listIterator = parcLinkedList_CreateIterator(map->buckets[i]);
-                break;
-            }
+bool
+parcHashMapCursor_HasNext(PARCHashMapCursor *cursor)
+{
+    while (cursor->bucketCursor.list != NULL) {
+        if (parcLinkedListCursor_HasNext(&cursor->bucketCursor)) {
+            return true;
         }
+        _parcHashMapCursor_SeekBucket(cursor, cursor->bucket + 1);
+    }
+    return false;
+}
+
+PARCObject *
+parcHashMapCursor_Next(PARCHashMapCursor *cursor)
+{
+    trapOutOfBoundsIf(parcHashMapCursor_HasNext(cursor) == false, "No more elements.");
+
+    _PARCHashMapEntry *entry = parcLinkedListCursor_Next(&cursor->bucketCursor);
+    cursor->entry = entry;
+    return entry->key;
+}
 
-        trapOutOfMemoryIf(state->listIterator == NULL, "Cannot create parcLinkedList_CreateIterator");
+PARCObject *
+parcHashMapCursor_GetValue(const PARCHashMapCursor *cursor)
+{
+    const _PARCHashMapEntry *entry = cursor->entry;
+    return entry->value;
+}
+
+void
+parcHashMapCursor_Remove(PARCHashMapCursor *cursor)
+{
+    parcLinkedListCursor_Remove(&cursor->bucketCursor);
+    cursor->entry = NULL;
+    cursor->map->size--;
+}
+
+static PARCHashMapCursor *
+_parcHashMap_Init(PARCHashMap *map)
+{
+    PARCHashMapCursor *state = parcMemory_Allocate(sizeof(PARCHashMapCursor));
+
+    if (state != NULL) {
+        parcHashMapCursor_Init(state, map);
     }
 
     return state;
 }
 
 static bool
-_parcHashMap_Fini(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator *state __attribute__((unused)))
+_parcHashMap_Fini(PARCHashMap *map __attribute__((unused)), PARCHashMapCursor *state)
 {
-    if (state->listIterator != NULL) {
-        parcIterator_Release(&state->listIterator);
-    }
     parcMemory_Deallocate(&state);
     return true;
 }
 
-static _PARCHashMapIterator *
-_parcHashMap_Next(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator *state)
+static PARCHashMapCursor *
+_parcHashMap_Next(PARCHashMap *map __attribute__((unused)), PARCHashMapCursor *state)
 {
-    _PARCHashMapEntry *result = parcIterator_Next(state->listIterator);
-    state->current = result;
+    parcHashMapCursor_Next(state);
     return state;
 }
 
 static void
-_parcHashMap_Remove(PARCHashMap *map, _PARCHashMapIterator **statePtr __attribute__((unused)))
+_parcHashMap_Remove(PARCHashMap *map __attribute__((unused)), PARCHashMapCursor **statePtr)
 {
-    _PARCHashMapIterator *state = *statePtr;
-
-    if (state->listIterator != NULL) {
-        parcIterator_Remove(state->listIterator);
-        map->size--;
-    }
+    parcHashMapCursor_Remove(*statePtr);
 }
 
 static bool
-_parcHashMap_HasNext(PARCHashMap *map __attribute__((unused)), _PARCHashMapIterator *state)
+_parcHashMap_HasNext(PARCHashMap *map __attribute__((unused)), PARCHashMapCursor *state)
 {
-    bool result = false;
-    if (state->listIterator != NULL) {
-        if (parcIterator_HasNext(state->listIterator)) {
-            result = true;
-        } else {
-            while ((result == false) && (++state->bucket < map->capacity)) {
-                if (map->buckets[state->bucket] != NULL) {
-                    parcIterator_Release(&state->listIterator);
-                    state->listIterator = parcLinkedList_CreateIterator(map->buckets[state->bucket]);
-                    trapOutOfMemoryIf(state->listIterator == NULL, "Cannot create parcLinkedList_CreateIterator");
-                    result = parcIterator_HasNext(state->listIterator);
-                }
-            }
-        }
-    }
-    return result;
+    return parcHashMapCursor_HasNext(state);
 }
 
 static PARCObject *
-_parcHashMapValue_Element(PARCHashMap *map __attribute__((unused)), const _PARCHashMapIterator *state)
+_parcHashMapValue_Element(PARCHashMap *map __attribute__((unused)), const PARCHashMapCursor *state)
 {
-    return state->current->value;
+    return parcHashMapCursor_GetValue(state);
 }
 
 static PARCObject *
-_parcHashMapKey_Element(PARCHashMap *map __attribute__((unused)), const _PARCHashMapIterator *state)
+_parcHashMapKey_Element(PARCHashMap *map __attribute__((unused)), const PARCHashMapCursor *state)
 {
-    return state->current->key;
+    const _PARCHashMapEntry *entry = state->entry;
+    return entry->key;
 }
 
 PARCIterator *
@@ -69,6 +69,7 @@
 #include <parc/algol/parc_JSON.h>
 #include <parc/algol/parc_HashCode.h>
 #include <parc/algol/parc_Iterator.h>
+#include <parc/algol/parc_LinkedList.h>
 
 struct PARCHashMap;
 typedef struct PARCHashMap PARCHashMap;
@@ -660,4 +661,82 @@ PARCIterator *parcHashMap_CreateValueIterator(PARCHashMap *hashMap);
  * @endcode
  */
 PARCIterator *parcHashMap_CreateKeyIterator(PARCHashMap *hashMap);
+
+/**
+ * @typedef PARCHashMapCursor
+ * @brief A position in a `PARCHashMap`, for iterating over its entries without allocating.
+ *
+ * A cursor is an ordinary structure, usually on the stack, initialised by `parcHashMapCursor_Init()`.
+ * It visits the entries in the same order as the iterators returned by `parcHashMap_CreateKeyIterator()`
+ * and `parcHashMap_CreateValueIterator()`, but nothing needs to be released when it is no longer needed.
+ *
+ * The map must not be modified while a cursor is in use, except through `parcHashMapCursor_Remove()`.
+ * The cursor does not acquire a reference to the map.
+ */
+typedef struct parc_hashmap_cursor {
+    PARCHashMap *map;
+    size_t bucket;
+    PARCLinkedListCursor bucketCursor;
+    void *entry;
+} PARCHashMapCursor;
+
+/**
+ * Initialise a `PARCHashMapCursor` to the position before the first entry of the given map.
+ *
+ * @param [out] cursor A pointer to the `PARCHashMapCursor` to initialise.
+ * @param [in] hashMap A pointer to a valid `PARCHashMap`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHashMapCursor cursor;
+ *     parcHashMapCursor_Init(&cursor, hashMap);
+ *
+ *     while (parcHashMapCursor_HasNext(&cursor)) {
+ *         PARCObject *key = parcHashMapCursor_Next(&cursor);
+ *         PARCObject *value = parcHashMapCursor_GetValue(&cursor);
+ *     }
+ * }
+ * @endcode
+ */
+void parcHashMapCursor_Init(PARCHashMapCursor *cursor, PARCHashMap *hashMap);
+
+/**
+ * Determine if there is an entry after the cursor.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCHashMapCursor`.
+ *
+ * @return true There is another entry.
+ * @return false The cursor is at the end of the map.
+ */
+bool parcHashMapCursor_HasNext(PARCHashMapCursor *cursor);
+
+/**
+ * Advance the cursor to the next entry and return its key.
+ *
+ * It is a trap to call this function when `parcHashMapCursor_HasNext()` is false.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCHashMapCursor`.
+ *
+ * @return The key of the next entry.
+ */
+PARCObject *parcHashMapCursor_Next(PARCHashMapCursor *cursor);
+
+/**
+ * Get the value of the entry most recently returned by `parcHashMapCursor_Next()`.
+ *
+ * @param [in] cursor A pointer to an initialised `PARCHashMapCursor`.
+ *
+ * @return The value of the current entry.
+ */
+PARCObject *parcHashMapCursor_GetValue(const PARCHashMapCursor *cursor);
+
+/**
+ * Remove the entry most recently returned by `parcHashMapCursor_Next()` from the map.
+ *
+ * Unlike `parcHashMap_Remove()`, this never shrinks the map, so the cursor remains valid.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCHashMapCursor`.
+ */
+void parcHashMapCursor_Remove(PARCHashMapCursor *cursor);
 #endif
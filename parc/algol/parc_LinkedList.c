@@ -326,6 +326,35 @@ parcLinkedList_CreateIterator(PARCLinkedList *list)
     return iterator;
 }
 
+void
+parcLinkedListCursor_Init(PARCLinkedListCursor *cursor, PARCLinkedList *list)
+{
+    cursor->list = list;
+    cursor->node = _parcLinkedIterator_Init(list);
+}
+
+bool
+parcLinkedListCursor_HasNext(const PARCLinkedListCursor *cursor)
+{
+    return _parcLinkedListNode_HasNext(cursor->list, cursor->node);
+}
+
+PARCObject *
+parcLinkedListCursor_Next(PARCLinkedListCursor *cursor)
+{
+    _PARCLinkedListNode *node = _parcLinkedListNode_Next(cursor->list, cursor->node);
+    cursor->node = node;
+    return node->object;
+}
+
+void
+parcLinkedListCursor_Remove(PARCLinkedListCursor *cursor)
+{
+    _PARCLinkedListNode *node = cursor->node;
+    _parcLinkedListNode_Remove(cursor->list, &node);
+    cursor->node = node;
+}
+
 PARCLinkedList *
 parcLinkedList_Create(void)
 {
@@ -439,12 +468,12 @@ parcLinkedList_Append(PARCLinkedList *list, const PARCObject *element)
 PARCLinkedList *
 parcLinkedList_AppendAll(PARCLinkedList *list, const PARCLinkedList *other)
 {
-    PARCIterator *iterator = parcLinkedList_CreateIterator((PARCLinkedList *) other);
-    while (parcIterator_HasNext(iterator)) {
-        PARCObject *object = parcIterator_Next(iterator);
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, (PARCLinkedList *) other);
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCObject *object = parcLinkedListCursor_Next(&cursor);
         parcLinkedList_Append(list, object);
     }
-    parcIterator_Release(&iterator);
 
     return list;
 }
@@ -735,12 +764,11 @@ parcLinkedList_AsPARCList(PARCLinkedList *list)
 void
 parcLinkedList_ApplyImpl(PARCLinkedList *list, void (*function)(PARCObject *, const void *), const void *parameter)
 {
-    PARCIterator *iterator = parcLinkedList_CreateIterator(list);
-   
-    while (parcIterator_HasNext(iterator)) {
-        PARCObject *object = parcIterator_Next(iterator);
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, list);
+
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCObject *object = parcLinkedListCursor_Next(&cursor);
         function(object, parameter);
     }
-   
-    parcIterator_Release(&iterator);
 }
@@ -126,6 +126,72 @@ void parcLinkedList_AssertValid(const PARCLinkedList *list);
  */
 PARCIterator *parcLinkedList_CreateIterator(PARCLinkedList *list);
 
+/**
+ * @typedef PARCLinkedListCursor
+ * @brief A position in a `PARCLinkedList`, for iterating without allocating.
+ *
+ * A cursor is an ordinary structure, usually on the stack, initialised by `parcLinkedListCursor_Init()`.
+ * It has the same behaviour as the `PARCIterator` returned by `parcLinkedList_CreateIterator()`,
+ * but nothing needs to be released when it is no longer needed.
+ *
+ * The list must not be modified while a cursor is in use, except through `parcLinkedListCursor_Remove()`.
+ * The cursor does not acquire a reference to the list.
+ */
+typedef struct parc_linkedlist_cursor {
+    PARCLinkedList *list;
+    void *node;
+} PARCLinkedListCursor;
+
+/**
+ * Initialise a `PARCLinkedListCursor` to the position before the first element of the given list.
+ *
+ * @param [out] cursor A pointer to the `PARCLinkedListCursor` to initialise.
+ * @param [in] list A pointer to a valid `PARCLinkedList`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLinkedListCursor cursor;
+ *     parcLinkedListCursor_Init(&cursor, list);
+ *
+ *     while (parcLinkedListCursor_HasNext(&cursor)) {
+ *         PARCObject *object = parcLinkedListCursor_Next(&cursor);
+ *     }
+ * }
+ * @endcode
+ */
+void parcLinkedListCursor_Init(PARCLinkedListCursor *cursor, PARCLinkedList *list);
+
+/**
+ * Determine if there is an element after the cursor.
+ *
+ * @param [in] cursor A pointer to an initialised `PARCLinkedListCursor`.
+ *
+ * @return true There is another element.
+ * @return false The cursor is at the end of the list.
+ */
+bool parcLinkedListCursor_HasNext(const PARCLinkedListCursor *cursor);
+
+/**
+ * Advance the cursor and return the next element.
+ *
+ * It is a trap to call this function when `parcLinkedListCursor_HasNext()` is false.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCLinkedListCursor`.
+ *
+ * @return The next element of the list.
+ */
+PARCObject *parcLinkedListCursor_Next(PARCLinkedListCursor *cursor);
+
+/**
+ * Remove and release the element most recently returned by `parcLinkedListCursor_Next()`.
+ *
+ * The cursor is left before the element that followed the removed element.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCLinkedListCursor`.
+ */
+void parcLinkedListCursor_Remove(PARCLinkedListCursor *cursor);
+
 /**
  * Acquire a new reference to an instance of `PARCLinkedList`.
  *
@@ -52,18 +52,26 @@
  * intellectual property used by its contributions to this software. You may
  * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
  */
-
 /**
- * Priority Queue implemented over a Binary Heap.
+ * Priority Queue implemented over a 4-ary Heap.
+ *
+ * A 4-ary heap has the same O(log n) insert and delete as a binary heap, but is half as deep,
+ * and the four children of a node are adjacent in memory, so trickling down touches fewer
+ * cache lines.  The average and worst case FindMin is O(1).
+ *
+ * The heap is implemented as a "0"-based array, so for node index n, the
+ * children are at 4n+1 through 4n+4.  Its parent is at floor((n-1)/4).
  *
- * A Binary Heap will have average insert of O(1) and delete of O(log n).  The worst case
- * is O(log n) for both.  The average and worst case FindMin is O(1).
+ * The Heap property is a[n] <= a[4n+k] for k = 1..4.  We need to move things around
+ * sufficiently for this property to remain true.  Rather than swapping at each step, an element
+ * being moved is held aside while the elements it passes are shifted into the hole it leaves.
  *
- * The binary heap is implemented as a "0"-based array, so for node index n, the
- * children are at 2n+1 and 2n+2.  Its parent is at floor((n-1)/2).
+ * Elements added with a handle record their position in the handle table, which is updated
+ * every time the element moves, so an element can be removed or re-positioned in O(log n)
+ * without searching for it.  Handle 0 is never used, and marks elements that have no handle.
  *
- * The Heap property is a[n] <= a[2n+1] and a[k] <= a[2k+2].  We need to move things around
- * sufficiently for this property to remain true.
+ * A queue created by parcPriorityQueue_CreateUint64Key() has no compare function and orders
+ * the elements by the key stored alongside each element in the heap array.
  *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
@@ -80,8 +88,12 @@
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_PriorityQueue.h>
 
+#define _parcPriorityQueue_Arity 4
+
 typedef struct heap_entry {
+    uint64_t key;
     void *data;
+    PARCPriorityQueueHandle handle;
 } HeapEntry;
 
 struct parc_priority_queue {
@@ -89,169 +101,111 @@ struct parc_priority_queue {
     size_t capacity;        // how many elements are allocated
     size_t size;            // how many elements are used
 
+    // handles[h] is the array index of the element with handle h, or the next free handle if h is free.
+    size_t *handles;
+    size_t handleCapacity;  // how many handles are allocated
+    size_t handleLimit;     // handles at or above this have never been used
+    size_t freeHandle;      // the first free handle, or 0 if there are none
+
     PARCPriorityQueueCompareTo *compare;
     PARCPriorityQueueDestroyer *destroyer;
 };
 
 /**
- * 0-based array indexing, so use 2n+1
+ * 0-based array indexing, so use 4n+1
  */
 static size_t
-_leftChildIndex(size_t elementIndex)
+_firstChildIndex(size_t elementIndex)
 {
-    return 2 * elementIndex + 1;
+    return _parcPriorityQueue_Arity * elementIndex + 1;
 }
 
 /**
- * 0-based array indexing, so use 2n+2
- * IMPORTANT: This must be a larger index than the left child,
- * as the TrickleDown algorithm assumes that if the right child exists so
- * does the left child.
- */
-static size_t
-_rightChildIndex(size_t elementIndex)
-{
-    return 2 * elementIndex + 2;
-}
-
-/**
- * 0-based array indexing, so use (n-1)/2
+ * 0-based array indexing, so use (n-1)/4
  */
 static size_t
 _parentIndex(size_t elementIndex)
 {
-    return (elementIndex - 1) / 2;
+    return (elementIndex - 1) / _parcPriorityQueue_Arity;
 }
 
 /**
- * Exchange the data between two array locations
+ * True if entry a sorts before entry b.
+ *
+ * Keyed queues compare the inline keys directly and never call through the compare function pointer.
  */
-static void
-_swap(PARCPriorityQueue *queue, size_t firstIndex, size_t secondIndex)
+static inline bool
+_lessThan(const PARCPriorityQueue *queue, const HeapEntry *a, const HeapEntry *b)
 {
-    void *firstData = queue->array[firstIndex].data;
-    queue->array[firstIndex].data = queue->array[secondIndex].data;
-    queue->array[secondIndex].data = firstData;
+    if (queue->compare == NULL) {
+        return a->key < b->key;
+    }
+    return queue->compare(a->data, b->data) < 0;
 }
 
 /**
- * See parcPriorityQueue_TrickleDown for full details
- *
- * Case 1: Right child exists and r.value < n.value && r.value < l.value
- *   In this case, swap(n.index, r.index) and set n.index = r.index.
- *       50                6
- *      /  \     ===>     / \
- *     9    6            9   50
- *
- * Case 2: Right child exists and r.value < n.value && l.value <= r.value
- *   In this case swap(n.index, l.index) and set n.index = l.index
- *   This makes sense by transitivity that l <= r < n, so swap(n,l) satisfies the invariant.
- *       50                6
- *      /  \     ===>     / \
- *     6    9            50  9
+ * Store an entry at an array location, keeping its handle (if any) pointing to it.
  */
-static size_t
-_trickleRightChild(PARCPriorityQueue *queue, size_t elementIndex, size_t leftChildIndex, size_t rightChildIndex)
+static inline void
+_setEntry(PARCPriorityQueue *queue, size_t elementIndex, HeapEntry entry)
 {
-    if (queue->compare(queue->array[rightChildIndex].data, queue->array[elementIndex].data) < 0) {
-        if (queue->compare(queue->array[rightChildIndex].data, queue->array[leftChildIndex].data) < 0) {
-            // Case 1
-            _swap(queue, rightChildIndex, elementIndex);
-            elementIndex = rightChildIndex;
-        } else {
-            // Case 2
-            _swap(queue, leftChildIndex, elementIndex);
-            elementIndex = leftChildIndex;
-        }
+    queue->array[elementIndex] = entry;
+    if (entry.handle != 0) {
+        queue->handles[entry.handle] = elementIndex;
     }
-    return elementIndex;
 }
 
 /**
- * See parcPriorityQueue_TrickleDown for full details
- *
- * Case 3: Left child exists (right does not) and l.value < n.value
- *   In this case, swap(n.index, l.index) and set n.index = l.index
- *       50                6
- *      /  \     ===>     / \
- *     6    x            50  x
+ * Find the smallest of the children of a node, starting at firstChildIndex, which must be less than the queue size.
  */
 static size_t
-_trickleLeftChild(PARCPriorityQueue *queue, size_t elementIndex, size_t leftChildIndex)
+_minimumChild(const PARCPriorityQueue *queue, size_t firstChildIndex)
 {
-    if (queue->compare(queue->array[leftChildIndex].data, queue->array[elementIndex].data) < 0) {
-        // Case 3
-        _swap(queue, leftChildIndex, elementIndex);
-        elementIndex = leftChildIndex;
+    size_t lastChildIndex = firstChildIndex + _parcPriorityQueue_Arity;
+    if (lastChildIndex > queue->size) {
+        lastChildIndex = queue->size;
+    }
+
+    size_t minimumIndex = firstChildIndex;
+    for (size_t childIndex = firstChildIndex + 1; childIndex < lastChildIndex; childIndex++) {
+        if (_lessThan(queue, &queue->array[childIndex], &queue->array[minimumIndex])) {
+            minimumIndex = childIndex;
+        }
     }
-    return elementIndex;
+    return minimumIndex;
 }
 
 /**
  * Moves an element down the heap until it satisfies the heap invariant.
  *
- * The value of node n must be less than or equal to both the left child and right child, if
- * they exist.  Here's the algorithm by example.  Let r.value, l.value and n.value be the values
- * of the right, left and node.  Let r.index, l.index, and n.index be their indicies.
- *
- * Case 1: Right child exists and r.value < n.value && r.value < l.value
- *   In this case, swap(n.index, r.index) and set n.index = r.index.
- *       50                6
- *      /  \     ===>     / \
- *     9    6            9   50
- *
- * Case 2: Right child exists and r.value < n.value && l.value <= r.value
- *   In this case swap(n.index, l.index) and set n.index = l.index
- *   This makes sense by transitivity that l <= r < n, so swap(n,l) satisfies the invariant.
- *       50                6
- *      /  \     ===>     / \
- *     6    9            50  9
- *
- * Case 3: Left child exists (right does not) and l.value < n.value
- *   In this case, swap(n.index, l.index) and set n.index = l.index
- *       50                6
- *      /  \     ===>     / \
- *     6    x            50  x
- *
- * Case 4: No child exists or already satisfies invariant
- *    Done
- *       50                50
- *      /  \     ===>     /  \
- *     x    x            x    x
- *                OR
- *       4                 4
- *      / \      ===>     / \
- *     9   6             9   6
+ * The value of node n must be less than or equal to all of its children.  At each level,
+ * if the smallest child is less than n, that child moves up into n's place and n continues
+ * down from the child's old place.  Otherwise, or if n has no children, n is done.
  *
+ *            60                          50
+ *     +----+--+---+----+          +----+--+---+----+
+ *     70   50     71   72  ====>  70   60     71   72
  *
  * @param [in] queue The priority queue to manipulate
  * @param [in] elementIndex The root element (n above) to trickle down
- *
- * Example:
- * @code
- * <#example#>
- * @endcode
  */
 static void
 _trickleDown(PARCPriorityQueue *queue, size_t elementIndex)
 {
-    bool finished = false;
-
-    while (!finished) {
-        size_t rightChildIndex = _rightChildIndex(elementIndex);
-        size_t leftChildIndex = _leftChildIndex(elementIndex);
-
-        if (rightChildIndex < queue->size) {
-            // Case 1 and Case 2
-            elementIndex = _trickleRightChild(queue, elementIndex, leftChildIndex, rightChildIndex);
-        } else if (leftChildIndex < queue->size) {
-            // Case 3
-            elementIndex = _trickleLeftChild(queue, elementIndex, leftChildIndex);
-        } else {
-            // Case 4, we're done
-            finished = true;
+    HeapEntry entry = queue->array[elementIndex];
+
+    size_t firstChildIndex = _firstChildIndex(elementIndex);
+    while (firstChildIndex < queue->size) {
+        size_t minimumIndex = _minimumChild(queue, firstChildIndex);
+        if (!_lessThan(queue, &queue->array[minimumIndex], &entry)) {
+            break;
         }
+        _setEntry(queue, elementIndex, queue->array[minimumIndex]);
+        elementIndex = minimumIndex;
+        firstChildIndex = _firstChildIndex(elementIndex);
     }
+
+    _setEntry(queue, elementIndex, entry);
 }
 
 /**
@@ -267,15 +221,33 @@ _trickleDown(PARCPriorityQueue *queue, size_t elementIndex)
 static void
 _bubbleUp(PARCPriorityQueue *queue, size_t elementIndex)
 {
-    size_t parentIndex = _parentIndex(elementIndex);
-    while (elementIndex > 0 && queue->compare(queue->array[elementIndex].data, queue->array[parentIndex].data) < 0) {
-        _swap(queue, elementIndex, parentIndex);
+    HeapEntry entry = queue->array[elementIndex];
+
+    while (elementIndex > 0) {
+        size_t parentIndex = _parentIndex(elementIndex);
+        if (!_lessThan(queue, &entry, &queue->array[parentIndex])) {
+            break;
+        }
         // now move up the ladder
+        _setEntry(queue, elementIndex, queue->array[parentIndex]);
         elementIndex = parentIndex;
-        parentIndex = _parentIndex(elementIndex);
     }
 
     // At this point, it is either at the top (elementIndex = 0) or statisfies the heap invariant.
+    _setEntry(queue, elementIndex, entry);
+}
+
+/**
+ * Restore the heap invariant after the priority of the element at elementIndex has changed in either direction.
+ */
+static void
+_reposition(PARCPriorityQueue *queue, size_t elementIndex)
+{
+    if (elementIndex > 0 && _lessThan(queue, &queue->array[elementIndex], &queue->array[_parentIndex(elementIndex)])) {
+        _bubbleUp(queue, elementIndex);
+    } else {
+        _trickleDown(queue, elementIndex);
+    }
 }
 
 /**
@@ -298,6 +270,58 @@ _expand(PARCPriorityQueue *queue)
     queue->array = parcMemory_Reallocate(queue->array, sizeof(HeapEntry) * queue->capacity);
 }
 
+static PARCPriorityQueueHandle
+_acquireHandle(PARCPriorityQueue *queue)
+{
+    PARCPriorityQueueHandle handle = queue->freeHandle;
+
+    if (handle != 0) {
+        queue->freeHandle = queue->handles[handle];
+    } else {
+        if (queue->handleLimit >= queue->handleCapacity) {
+            queue->handleCapacity = (queue->handleCapacity == 0) ? queue->capacity : queue->handleCapacity * 2;
+            queue->handles = parcMemory_Reallocate(queue->handles, sizeof(size_t) * queue->handleCapacity);
+            assertNotNull(queue->handles, "parcMemory_Reallocate(%zu) returned NULL", sizeof(size_t) * queue->handleCapacity);
+        }
+        handle = queue->handleLimit++;
+    }
+
+    return handle;
+}
+
+static void
+_releaseHandle(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle)
+{
+    if (handle != 0) {
+        queue->handles[handle] = queue->freeHandle;
+        queue->freeHandle = handle;
+    }
+}
+
+static bool
+_handleIsValid(const PARCPriorityQueue *queue, PARCPriorityQueueHandle handle)
+{
+    return handle != 0 && handle < queue->handleLimit
+           && queue->handles[handle] < queue->size
+           && queue->array[queue->handles[handle]].handle == handle;
+}
+
+static void
+_add(PARCPriorityQueue *queue, HeapEntry entry)
+{
+    if (queue->size + 1 > queue->capacity) {
+        _expand(queue);
+    }
+
+    // insert at the end of the array
+    queue->array[queue->size] = entry;
+
+    // increment the size before calling bubble up so invariants are true (i.e.
+    // the index we're giving to BubbleUp is within the array size.
+    queue->size++;
+    _bubbleUp(queue, queue->size - 1);
+}
+
 // ================================
 // Public API
 
@@ -324,11 +348,9 @@ parcPriorityQueue_Uint64CompareTo(const void *a, const void *b)
     return 0;
 }
 
-PARCPriorityQueue *
-parcPriorityQueue_Create(PARCPriorityQueueCompareTo *compare, PARCPriorityQueueDestroyer *destroyer)
+static PARCPriorityQueue *
+_create(PARCPriorityQueueCompareTo *compare, PARCPriorityQueueDestroyer *destroyer)
 {
-    assertNotNull(compare, "Parameter compare must be non-null");
-
     size_t initialSize = 128;
     PARCPriorityQueue *queue = parcMemory_AllocateAndClear(sizeof(PARCPriorityQueue));
     assertNotNull(queue, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCPriorityQueue));
@@ -336,12 +358,30 @@ parcPriorityQueue_Create(PARCPriorityQueueCompareTo *compare, PARCPriorityQueueD
     assertNotNull(queue->array, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(HeapEntry) * initialSize);
     queue->capacity = initialSize;
     queue->size = 0;
+    queue->handles = NULL;
+    queue->handleCapacity = 0;
+    queue->handleLimit = 1;
+    queue->freeHandle = 0;
     queue->compare = compare;
     queue->destroyer = destroyer;
 
     return queue;
 }
 
+PARCPriorityQueue *
+parcPriorityQueue_Create(PARCPriorityQueueCompareTo *compare, PARCPriorityQueueDestroyer *destroyer)
+{
+    assertNotNull(compare, "Parameter compare must be non-null");
+
+    return _create(compare, destroyer);
+}
+
+PARCPriorityQueue *
+parcPriorityQueue_CreateUint64Key(PARCPriorityQueueDestroyer *destroyer)
+{
+    return _create(NULL, destroyer);
+}
+
 void
 parcPriorityQueue_Destroy(PARCPriorityQueue **queuePtr)
 {
@@ -350,6 +390,9 @@ parcPriorityQueue_Destroy(PARCPriorityQueue **queuePtr)
     PARCPriorityQueue *queue = *queuePtr;
     parcPriorityQueue_Clear(queue);
     parcMemory_Deallocate((void **) &(queue->array));
+    if (queue->handles != NULL) {
+        parcMemory_Deallocate((void **) &(queue->handles));
+    }
     parcMemory_Deallocate((void **) &queue);
     *queuePtr = NULL;
 }
@@ -359,21 +402,79 @@ parcPriorityQueue_Add(PARCPriorityQueue *queue, void *data)
 {
     assertNotNull(queue, "Parameter queue must be non-null");
     assertNotNull(data, "Parameter data must be non-null");
+    assertNotNull(queue->compare, "A queue ordered by key must use parcPriorityQueue_AddWithKey");
 
-    if (queue->size + 1 > queue->capacity) {
-        _expand(queue);
+    _add(queue, (HeapEntry) { .key = 0, .data = data, .handle = 0 });
+
+    // we always allow duplicates, so always return true
+    return true;
+}
+
+PARCPriorityQueueHandle
+parcPriorityQueue_AddWithHandle(PARCPriorityQueue *queue, void *data)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNotNull(data, "Parameter data must be non-null");
+    assertNotNull(queue->compare, "A queue ordered by key must use parcPriorityQueue_AddWithKey");
+
+    PARCPriorityQueueHandle handle = _acquireHandle(queue);
+    _add(queue, (HeapEntry) { .key = 0, .data = data, .handle = handle });
+
+    return handle;
+}
+
+PARCPriorityQueueHandle
+parcPriorityQueue_AddWithKey(PARCPriorityQueue *queue, uint64_t key, void *data)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNotNull(data, "Parameter data must be non-null");
+    assertNull(queue->compare, "Only a queue created by parcPriorityQueue_CreateUint64Key is ordered by key");
+
+    PARCPriorityQueueHandle handle = _acquireHandle(queue);
+    _add(queue, (HeapEntry) { .key = key, .data = data, .handle = handle });
+
+    return handle;
+}
+
+void *
+parcPriorityQueue_Remove(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    trapIllegalValueIf(!_handleIsValid(queue, handle), "Handle %zu is not in the queue", handle);
+
+    size_t elementIndex = queue->handles[handle];
+    void *data = queue->array[elementIndex].data;
+    _releaseHandle(queue, handle);
+
+    queue->size--;
+    if (elementIndex < queue->size) {
+        // Fill the hole with the last element, which may belong either above or below it.
+        _setEntry(queue, elementIndex, queue->array[queue->size]);
+        _reposition(queue, elementIndex);
     }
 
-    // insert at the end of the array
-    queue->array[queue->size].data = data;
+    return data;
+}
 
-    // increment the size before calling bubble up so invariants are true (i.e.
-    // the index we're giving to BubbleUp is within the array size.
-    queue->size++;
-    _bubbleUp(queue, queue->size - 1);
+void
+parcPriorityQueue_UpdatePriority(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    trapIllegalValueIf(!_handleIsValid(queue, handle), "Handle %zu is not in the queue", handle);
 
-    // we always allow duplicates, so always return true
-    return true;
+    _reposition(queue, queue->handles[handle]);
+}
+
+void
+parcPriorityQueue_UpdateKey(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle, uint64_t key)
+{
+    assertNotNull(queue, "Parameter queue must be non-null");
+    assertNull(queue->compare, "Only a queue created by parcPriorityQueue_CreateUint64Key is ordered by key");
+    trapIllegalValueIf(!_handleIsValid(queue, handle), "Handle %zu is not in the queue", handle);
+
+    size_t elementIndex = queue->handles[handle];
+    queue->array[elementIndex].key = key;
+    _reposition(queue, elementIndex);
 }
 
 void
@@ -387,6 +488,8 @@ parcPriorityQueue_Clear(PARCPriorityQueue *queue)
     }
 
     queue->size = 0;
+    queue->handleLimit = 1;
+    queue->freeHandle = 0;
 }
 
 void *
@@ -405,14 +508,15 @@ parcPriorityQueue_Poll(PARCPriorityQueue *queue)
     assertNotNull(queue, "Parameter queue must be non-null");
     if (queue->size > 0) {
         void *data = queue->array[0].data;
+        _releaseHandle(queue, queue->array[0].handle);
 
         queue->size--;
 
-        // if size == 1, then this is a no-op
-        queue->array[0].data = queue->array[queue->size].data;
-
-        // make sure the head satisifies the heap invariant
-        _trickleDown(queue, 0);
+        if (queue->size > 0) {
+            // move the last element to the head and make sure it satisifies the heap invariant
+            queue->array[0] = queue->array[queue->size];
+            _trickleDown(queue, 0);
+        }
 
         return data;
     }
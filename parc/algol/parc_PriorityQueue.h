@@ -59,6 +59,12 @@
  *
  * The user provides a sort function and the top item will be the minimum
  * as per the < relation.
+ * Alternatively, a queue created with {@link parcPriorityQueue_CreateUint64Key} orders its
+ * elements by a `uint64_t` key given when each element is added, such as a timestamp,
+ * without calling a sort function.
+ *
+ * Elements added with {@link parcPriorityQueue_AddWithHandle} or {@link parcPriorityQueue_AddWithKey}
+ * can later be removed, or moved after their priority changes, in O(log n) time.
  *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
@@ -69,10 +75,19 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 struct parc_priority_queue;
 typedef struct parc_priority_queue PARCPriorityQueue;
 
+/**
+ * Identifies an element in a `PARCPriorityQueue` for as long as the element is in the queue.
+ *
+ * A handle is never 0.  Once its element leaves the queue, by Poll, Remove or Clear,
+ * the handle is invalid and may be reused for another element.
+ */
+typedef size_t PARCPriorityQueueHandle;
+
 typedef int (PARCPriorityQueueCompareTo)(const void *a, const void *b);
 typedef void (PARCPriorityQueueDestroyer)(void **elementPtr);
 
@@ -159,6 +174,30 @@ int parcPriorityQueue_Uint64CompareTo(const void *a, const void *b);
  */
 PARCPriorityQueue *parcPriorityQueue_Create(PARCPriorityQueueCompareTo *compare, PARCPriorityQueueDestroyer *destroyer);
 
+/**
+ * Creates a priority queue ordered by a `uint64_t` key stored with each element.
+ *
+ * The minimum key is always the head of the queue.  Elements must be added with
+ * {@link parcPriorityQueue_AddWithKey}.  Because the keys are compared directly, this is faster
+ * than a queue using {@link parcPriorityQueue_Uint64CompareTo}.
+ *
+ * @param [in] destroyer Called for Clear and Destroy operations, may be NULL.
+ *
+ * @return non-null A pointer to a `PARCPriorityQueue`
+ *
+ * Example:
+ * @code
+ * PARCPriorityQueue *timers = parcPriorityQueue_CreateUint64Key(NULL);
+ *
+ * PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithKey(timers, deadline, timer);
+ * ...
+ * parcPriorityQueue_UpdateKey(timers, handle, deadline + delay);
+ * ...
+ * parcPriorityQueue_Destroy(&timers);
+ * @endcode
+ */
+PARCPriorityQueue *parcPriorityQueue_CreateUint64Key(PARCPriorityQueueDestroyer *destroyer);
+
 
 /**
  * Destroy the queue and free remaining elements.
@@ -197,6 +236,104 @@ void parcPriorityQueue_Destroy(PARCPriorityQueue **queuePtr);
  */
 bool parcPriorityQueue_Add(PARCPriorityQueue *queue, void *data);
 
+/**
+ * Add an element to the priority queue, returning a handle for it.
+ *
+ * As {@link parcPriorityQueue_Add}, but the returned handle may be given to
+ * {@link parcPriorityQueue_Remove} and {@link parcPriorityQueue_UpdatePriority}
+ * while the element is in the queue.
+ *
+ * @param [in,out] queue The queue to modify, which must not be ordered by key
+ * @param [in] data The data to add to the queue, which must be comparable and not NULL
+ *
+ * @return The handle of the element
+ *
+ * Example:
+ * @code
+ * PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithHandle(queue, entry);
+ * ...
+ * parcPriorityQueue_Remove(queue, handle);
+ * @endcode
+ */
+PARCPriorityQueueHandle parcPriorityQueue_AddWithHandle(PARCPriorityQueue *queue, void *data);
+
+/**
+ * Add an element with the given key to a priority queue created by {@link parcPriorityQueue_CreateUint64Key}.
+ *
+ * @param [in,out] queue The queue to modify
+ * @param [in] key The priority of the element, lower keys are nearer the head of the queue
+ * @param [in] data The data to add to the queue, which must not be NULL
+ *
+ * @return The handle of the element
+ *
+ * Example:
+ * @code
+ * PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithKey(timers, deadline, timer);
+ * @endcode
+ */
+PARCPriorityQueueHandle parcPriorityQueue_AddWithKey(PARCPriorityQueue *queue, uint64_t key, void *data);
+
+/**
+ * Remove the element with the given handle from the queue and return it.
+ *
+ * The destroyer is not called on the element.  This takes O(log n) time.
+ *
+ * @param [in,out] queue The queue to modify
+ * @param [in] handle The handle of an element in the queue
+ *
+ * @return The removed element
+ *
+ * @throws `trapIllegalValue` if the handle does not identify an element in the queue
+ *
+ * Example:
+ * @code
+ * PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithKey(timers, deadline, timer);
+ * ...
+ * // cancel the timer
+ * parcPriorityQueue_Remove(timers, handle);
+ * @endcode
+ */
+void *parcPriorityQueue_Remove(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle);
+
+/**
+ * Restore the order of the queue after the priority of the element with the given handle has changed.
+ *
+ * The priority may have increased or decreased.  This takes O(log n) time.
+ * Changing the priority of an element without calling this function corrupts the queue.
+ *
+ * @param [in,out] queue The queue to modify
+ * @param [in] handle The handle of an element in the queue
+ *
+ * @throws `trapIllegalValue` if the handle does not identify an element in the queue
+ *
+ * Example:
+ * @code
+ * PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithHandle(queue, entry);
+ * ...
+ * entry->deadline += delay;
+ * parcPriorityQueue_UpdatePriority(queue, handle);
+ * @endcode
+ */
+void parcPriorityQueue_UpdatePriority(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle);
+
+/**
+ * Change the key of the element with the given handle in a queue created by {@link parcPriorityQueue_CreateUint64Key}.
+ *
+ * This takes O(log n) time.
+ *
+ * @param [in,out] queue The queue to modify
+ * @param [in] handle The handle of an element in the queue
+ * @param [in] key The new key of the element
+ *
+ * @throws `trapIllegalValue` if the handle does not identify an element in the queue
+ *
+ * Example:
+ * @code
+ * parcPriorityQueue_UpdateKey(timers, handle, deadline + delay);
+ * @endcode
+ */
+void parcPriorityQueue_UpdateKey(PARCPriorityQueue *queue, PARCPriorityQueueHandle handle, uint64_t key);
+
 /**
  * Removes all elements, calling the data structure's destroyer on each
  *
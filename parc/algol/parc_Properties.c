@@ -137,17 +137,16 @@ parcProperties_Display(const PARCProperties *properties, int indentation)
     parcDisplayIndented_PrintLine(indentation, "PARCProperties@%p {", properties);
     trapCannotObtainLockIf(parcHashMap_Lock(properties->properties) == false, "Cannot lock PARCProperties object.");
 
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator(properties->properties);
-    while (parcIterator_HasNext(iterator)) {
-        char *key = parcBuffer_ToString(parcIterator_Next(iterator));
-        const char *value = parcProperties_GetProperty(properties, key);
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, properties->properties);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        char *key = parcBuffer_ToString(parcHashMapCursor_Next(&cursor));
+        const char *value = parcBuffer_Overlay(parcHashMapCursor_GetValue(&cursor), 0);
         parcDisplayIndented_PrintLine(indentation + 1, "%s=%s", key, value);
 
         parcMemory_Deallocate(&key);
     }
 
-    parcIterator_Release(&iterator);
-
     parcHashMap_Unlock(properties->properties);
 
     parcDisplayIndented_PrintLine(indentation, "}");
@@ -194,16 +193,15 @@ parcProperties_ToJSON(const PARCProperties *properties)
 
     trapCannotObtainLockIf(parcHashMap_Lock(properties->properties) == false, "Cannot lock PARCProperties object.");
 
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator(properties->properties);
-    while (parcIterator_HasNext(iterator)) {
-        char *key = parcBuffer_ToString(parcIterator_Next(iterator));
-        const char *value = parcProperties_GetProperty(properties, key);
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, properties->properties);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        char *key = parcBuffer_ToString(parcHashMapCursor_Next(&cursor));
+        const char *value = parcBuffer_Overlay(parcHashMapCursor_GetValue(&cursor), 0);
         parcJSON_AddString(result, key, value);
         parcMemory_Deallocate(&key);
     }
 
-    parcIterator_Release(&iterator);
-
     parcHashMap_Unlock(properties->properties);
     return result;
 }
@@ -213,16 +211,15 @@ parcProperties_BuildString(const PARCProperties *properties, PARCBufferComposer
 {
     trapCannotObtainLockIf(parcHashMap_Lock(properties->properties) == false, "Cannot lock PARCProperties object.");
 
-    PARCIterator *iterator = parcHashMap_CreateKeyIterator(properties->properties);
-    while (parcIterator_HasNext(iterator)) {
-        char *key = parcBuffer_ToString(parcIterator_Next(iterator));
-        const char *value = parcProperties_GetProperty(properties, key);
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, properties->properties);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        char *key = parcBuffer_ToString(parcHashMapCursor_Next(&cursor));
+        const char *value = parcBuffer_Overlay(parcHashMapCursor_GetValue(&cursor), 0);
         parcBufferComposer_PutStrings(composer, key, "=", value, "\n", NULL);
         parcMemory_Deallocate(&key);
     }
 
-    parcIterator_Release(&iterator);
-
     parcHashMap_Unlock(properties->properties);
     return composer;
 }
@@ -324,34 +321,34 @@ parcProperties_GetAsInteger(const PARCProperties *properties, const char *name,
 
 typedef struct {
     PARCBuffer *element;
-    PARCIterator *hashMapIterator;
+    PARCHashMapCursor cursor;
 } _PARCPropertiesIterator;
 
 static _PARCPropertiesIterator *
 _parcPropertiesIterator_Init(const PARCProperties *object)
 {
     _PARCPropertiesIterator *state = parcMemory_AllocateAndClear(sizeof(_PARCPropertiesIterator));
-    state->hashMapIterator = parcHashMap_CreateKeyIterator(object->properties);
+    parcHashMapCursor_Init(&state->cursor, object->properties);
     return state;
 }
 
 static bool
 _parcPropertiesIterator_HasNext(PARCProperties *properties __attribute__((unused)), _PARCPropertiesIterator *state)
 {
-    return parcIterator_HasNext(state->hashMapIterator);
+    return parcHashMapCursor_HasNext(&state->cursor);
 }
 
 static _PARCPropertiesIterator *
 _parcPropertiesIterator_Next(PARCProperties *properties __attribute__((unused)), _PARCPropertiesIterator *state)
 {
-   state->element = (PARCBuffer *) parcIterator_Next(state->hashMapIterator);
+   state->element = (PARCBuffer *) parcHashMapCursor_Next(&state->cursor);
    return state;
 }
 
 static void
 _parcPropertiesIterator_Remove(PARCProperties *properties __attribute__((unused)), _PARCPropertiesIterator **state)
 {
-    parcIterator_Remove((*state)->hashMapIterator);
+    parcHashMapCursor_Remove(&(*state)->cursor);
 }
 
 static char *
@@ -363,7 +360,6 @@ _parcPropertiesIterator_Element(PARCProperties *properties __attribute__((unused
 static void
 _parcPropertiesIterator_Fini(PARCProperties *properties __attribute__((unused)), _PARCPropertiesIterator *state)
 {
-    parcIterator_Release(&state->hashMapIterator);
     parcMemory_Deallocate(&state);
 }
 
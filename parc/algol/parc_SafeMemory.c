@@ -108,7 +108,6 @@
 #include <string.h>
 #include <stdio.h>
 #include <sys/errno.h>
-#include <sys/queue.h>
 #include <pthread.h>
 
 #include <stdint.h>
@@ -120,9 +119,9 @@
 #include <parc/algol/parc_DisplayIndented.h>
 
 typedef struct memory_backtrace {
-    void **callstack;
     int maximumFrameCount;
     int actualFrameCount;
+    void *callstack[];
 } _MemoryBacktrace;
 
 static const uint32_t _parcSafeMemory_SuffixGuard = 0xcafecafe;
@@ -138,7 +137,7 @@ typedef struct memory_prefix {
     size_t requestedLength;       // The number of bytes the caller requested.
     size_t actualLength;          // The number of bytes >= requestedLength to ensure the right alignment for the suffix.
     size_t alignment;             // The aligment required by the caller.  Must be a power of 2 and >= sizeof(void *).
-    _MemoryBacktrace *backtrace;  // A record of the caller's stack trace at the time of allocation.
+    _MemoryBacktrace *backtrace;  // A record of the caller's stack trace at the time of allocation, or NULL if not sampled.
     uint64_t guard;               // Try to detect underrun of the allocated memory.
 } _MemoryPrefix;
 
@@ -148,7 +147,9 @@ typedef void *PARCSafeMemoryUsable;
 
 static PARCMemoryInterface *_parcMemory = &PARCStdlibMemoryAsPARCMemory;
 
-static pthread_mutex_t _parcSafeMemory_Mutex = PTHREAD_MUTEX_INITIALIZER;
+// Capture a backtrace for one in every this many allocations (0 disables capture).
+static unsigned _parcSafeMemory_BacktraceSamplingPeriod = 1;
+static __thread unsigned _parcSafeMemory_AllocationsSinceBacktrace;
 
 
 /**
@@ -303,47 +304,136 @@ _backtraceReport(const _MemoryBacktrace *backtrace, int outputFd)
     }
 }
 
-// This is a list of all memory allocations that were created by calls to Safe Memory.
-// Each element of the list is the pointer to the result returned to the caller of the memory allocation,
+// This is a record of all memory allocations that were created by calls to Safe Memory.
+// Each element of the record is the pointer to the result returned to the caller of the memory allocation,
 // not a pointer to the base.
-struct safememory_entry {
-    LIST_ENTRY(safememory_entry) entries;      // List
-    void *memory;
-};
-LIST_HEAD(, safememory_entry) head = LIST_HEAD_INITIALIZER(head);
-static pthread_mutex_t head_mutex = PTHREAD_MUTEX_INITIALIZER;
+//
+// The record is split into shards selected by a hash of the pointer, each an open-addressed hash set with its own lock,
+// so adding and removing an allocation is O(1) and threads rarely contend for the same lock.
+#define _parcSafeMemory_ShardCount 64
+#define _parcSafeMemory_ShardMinimumCapacity 64
+
+typedef struct safememory_shard {
+    pthread_mutex_t mutex;
+    size_t capacity;    // A power of 2, or 0 before the first allocation is recorded.
+    size_t count;
+    void **slots;       // NULL marks an empty slot.
+} _SafeMemoryShard;
+
+static _SafeMemoryShard _parcSafeMemory_Shards[_parcSafeMemory_ShardCount];
+static pthread_once_t _parcSafeMemory_ShardsOnce = PTHREAD_ONCE_INIT;
 
 static void
-_parcSafeMemory_AddAllocation(void *memory)
+_parcSafeMemory_InitializeShards(void)
 {
-    if (parcSafeMemory_Outstanding() == 0) {
-        LIST_INIT(&head); // Initialize the list.
+    for (int i = 0; i < _parcSafeMemory_ShardCount; i++) {
+        pthread_mutex_init(&_parcSafeMemory_Shards[i].mutex, NULL);
     }
+}
 
-    struct safememory_entry *e = malloc(sizeof(struct safememory_entry)); // Insert this at the head.
-    e->memory = memory;
+static inline uint64_t
+_parcSafeMemory_Hash(const void *memory)
+{
+    uint64_t hash = (uintptr_t) memory;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    return hash;
+}
 
-    pthread_mutex_lock(&head_mutex);
-    LIST_INSERT_HEAD(&head, e, entries);
-    pthread_mutex_unlock(&head_mutex);
+static inline _SafeMemoryShard *
+_parcSafeMemory_GetShard(const void *memory)
+{
+    pthread_once(&_parcSafeMemory_ShardsOnce, _parcSafeMemory_InitializeShards);
+    return &_parcSafeMemory_Shards[_parcSafeMemory_Hash(memory) & (_parcSafeMemory_ShardCount - 1)];
+}
+
+// The slot at which a search for the given pointer starts, using the hash bits not consumed by the shard selection.
+static inline size_t
+_parcSafeMemory_HomeSlot(const _SafeMemoryShard *shard, const void *memory)
+{
+    return (size_t) (_parcSafeMemory_Hash(memory) >> 6) & (shard->capacity - 1);
 }
 
 static void
-_parcSafeMemory_RemoveAllocation(void *memory)
+_parcSafeMemory_ShardInsert(_SafeMemoryShard *shard, void *memory)
 {
-    struct safememory_entry *e;
-    pthread_mutex_lock(&head_mutex);
-    LIST_FOREACH(e, &head, entries)
-    {
-        if (e->memory == memory) {
-            LIST_REMOVE(e, entries);
-            free(e);
-            pthread_mutex_unlock(&head_mutex);
+    size_t mask = shard->capacity - 1;
+    for (size_t i = _parcSafeMemory_HomeSlot(shard, memory); ; i = (i + 1) & mask) {
+        if (shard->slots[i] == NULL) {
+            shard->slots[i] = memory;
+            shard->count++;
+            return;
+        }
+        if (shard->slots[i] == memory) {
             return;
         }
     }
+}
+
+static void
+_parcSafeMemory_ShardResize(_SafeMemoryShard *shard, size_t capacity)
+{
+    void **slots = shard->slots;
+    size_t oldCapacity = shard->capacity;
 
-    pthread_mutex_unlock(&head_mutex);
+    shard->slots = calloc(capacity, sizeof(void *));
+    trapOutOfMemoryIf(shard->slots == NULL, "Cannot allocate %zu allocation record slots", capacity);
+    shard->capacity = capacity;
+    shard->count = 0;
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+        if (slots[i] != NULL) {
+            _parcSafeMemory_ShardInsert(shard, slots[i]);
+        }
+    }
+    free(slots);
+}
+
+static void
+_parcSafeMemory_AddAllocation(void *memory)
+{
+    _SafeMemoryShard *shard = _parcSafeMemory_GetShard(memory);
+
+    pthread_mutex_lock(&shard->mutex);
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    if ((shard->count + 1) * 2 > shard->capacity) {
+        size_t capacity = shard->capacity == 0 ? _parcSafeMemory_ShardMinimumCapacity : shard->capacity * 2;
+        _parcSafeMemory_ShardResize(shard, capacity);
+    }
+    _parcSafeMemory_ShardInsert(shard, memory);
+    pthread_mutex_unlock(&shard->mutex);
+}
+
+static void
+_parcSafeMemory_RemoveAllocation(void *memory)
+{
+    _SafeMemoryShard *shard = _parcSafeMemory_GetShard(memory);
+
+    pthread_mutex_lock(&shard->mutex);
+    if (shard->capacity > 0) {
+        size_t mask = shard->capacity - 1;
+        for (size_t i = _parcSafeMemory_HomeSlot(shard, memory); shard->slots[i] != NULL; i = (i + 1) & mask) {
+            if (shard->slots[i] == memory) {
+                // Backward-shift deletion: pull later members of the probe sequence into the hole
+                // so no tombstones are needed.
+                for (size_t j = (i + 1) & mask; shard->slots[j] != NULL; j = (j + 1) & mask) {
+                    size_t home = _parcSafeMemory_HomeSlot(shard, shard->slots[j]);
+                    bool homeIsBetween = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+                    if (!homeIsBetween) {
+                        shard->slots[i] = shard->slots[j];
+                        i = j;
+                    }
+                }
+                shard->slots[i] = NULL;
+                shard->count--;
+                pthread_mutex_unlock(&shard->mutex);
+                return;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&shard->mutex);
     fprintf(stderr, "parcSafeMemory_RemoveAllocation: Destroying memory (%p) which is NOT in the allocated memory record. Double free?\n", memory);
 }
 
@@ -383,38 +473,46 @@ _parcSafeMemory_Report(const PARCSafeMemoryUsable *safeMemory, int outputFd)
                                         _parcSafeMemory_StateToString(_parcSafeMemory_GetState(safeMemory)));
         trapUnexpectedStateIf(charactersPrinted < 0, "Cannot write to file descriptor %d", outputFd);
     }
-    _backtraceReport(prefix->backtrace, outputFd);
+    if (prefix->backtrace != NULL) {
+        _backtraceReport(prefix->backtrace, outputFd);
+    }
 }
 
 uint32_t
 parcSafeMemory_ReportAllocation(int outputFd)
 {
     uint32_t index = 0;
-    struct safememory_entry *e;
-
-    pthread_mutex_lock(&head_mutex);
-    LIST_FOREACH(e, &head, entries)
-    {
-        _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(e->memory);
-        if (outputFd != -1) {
-            int charactersPrinted = dprintf(outputFd,
-                                            "\n%u SafeMemory@%p: %p={ .requestedLength=%zd, .actualLength=%zd, .alignment=%zd }\n",
-                                            index, e->memory, (void *) prefix, prefix->requestedLength, prefix->actualLength, prefix->alignment);
-            trapUnexpectedStateIf(charactersPrinted < 0, "Cannot write to file descriptor %d", outputFd) {
-                pthread_mutex_unlock(&head_mutex);
+
+    pthread_once(&_parcSafeMemory_ShardsOnce, _parcSafeMemory_InitializeShards);
+    for (int shardIndex = 0; shardIndex < _parcSafeMemory_ShardCount; shardIndex++) {
+        _SafeMemoryShard *shard = &_parcSafeMemory_Shards[shardIndex];
+
+        pthread_mutex_lock(&shard->mutex);
+        for (size_t i = 0; i < shard->capacity; i++) {
+            void *memory = shard->slots[i];
+            if (memory == NULL) {
+                continue;
             }
+            _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
+            if (outputFd != -1) {
+                int charactersPrinted = dprintf(outputFd,
+                                                "\n%u SafeMemory@%p: %p={ .requestedLength=%zd, .actualLength=%zd, .alignment=%zd }\n",
+                                                index, memory, (void *) prefix, prefix->requestedLength, prefix->actualLength, prefix->alignment);
+                trapUnexpectedStateIf(charactersPrinted < 0, "Cannot write to file descriptor %d", outputFd) {
+                    pthread_mutex_unlock(&shard->mutex);
+                }
+            }
+            _parcSafeMemory_Report(memory, outputFd);
+            index++;
         }
-        _parcSafeMemory_Report(e->memory, outputFd);
-        index++;
+        pthread_mutex_unlock(&shard->mutex);
     }
-    pthread_mutex_unlock(&head_mutex);
     return parcSafeMemory_Outstanding();
 }
 
 static void
 _backtraceDestroy(_MemoryBacktrace **backtrace)
 {
-    free((*backtrace)->callstack);
     free(*backtrace);
     *backtrace = 0;
 }
@@ -422,10 +520,7 @@ _backtraceDestroy(_MemoryBacktrace **backtrace)
 static PARCSafeMemoryState
 _parcSafeMemory_Destroy(void **memoryPointer)
 {
-    pthread_mutex_lock(&_parcSafeMemory_Mutex);
-
     if (parcSafeMemory_Outstanding() == 0) {
-        pthread_mutex_unlock(&_parcSafeMemory_Mutex);
         return PARCSafeMemoryState_NOTHINGALLOCATED;
     }
 
@@ -436,13 +531,12 @@ _parcSafeMemory_Destroy(void **memoryPointer)
     PARCSafeMemoryState state = _parcSafeMemory_GetState(memory);
     trapUnexpectedStateIf(state != PARCSafeMemoryState_OK,
                           "Expected PARCSafeMemoryState_OK, actual %s (see parc_SafeMemory.h)",
-                          _parcSafeMemory_StateToString(state)) {
-
-        pthread_mutex_unlock(&_parcSafeMemory_Mutex);
-    }
+                          _parcSafeMemory_StateToString(state));
 
     _MemoryPrefix *prefix = _parcSafeMemory_GetPrefix(memory);
-    _backtraceDestroy(&prefix->backtrace);
+    if (prefix->backtrace != NULL) {
+        _backtraceDestroy(&prefix->backtrace);
+    }
 
     PARCSafeMemoryOrigin *base = _parcSafeMemory_GetOrigin(memory);
 
@@ -453,7 +547,6 @@ _parcSafeMemory_Destroy(void **memoryPointer)
 
     *memoryPointer = 0;
 
-    pthread_mutex_unlock(&_parcSafeMemory_Mutex);
     return PARCSafeMemoryState_OK;
 }
 
@@ -461,28 +554,65 @@ __attribute__((unused))
 static void
 _parcSafeMemory_DeallocateAll(void)
 {
-    struct safememory_entry *e;
-
-    pthread_mutex_lock(&head_mutex);
-    LIST_FOREACH(e, &head, entries)
-    {
-        _parcSafeMemory_Destroy(&e->memory);
+    pthread_once(&_parcSafeMemory_ShardsOnce, _parcSafeMemory_InitializeShards);
+    for (int shardIndex = 0; shardIndex < _parcSafeMemory_ShardCount; shardIndex++) {
+        _SafeMemoryShard *shard = &_parcSafeMemory_Shards[shardIndex];
+
+        pthread_mutex_lock(&shard->mutex);
+        for (size_t i = 0; i < shard->capacity; i++) {
+            void *memory = shard->slots[i];
+            if (memory != NULL) {
+                // Destroying the memory removes it from this shard, which may shift another entry into this slot.
+                pthread_mutex_unlock(&shard->mutex);
+                _parcSafeMemory_Destroy(&memory);
+                pthread_mutex_lock(&shard->mutex);
+                i--;
+            }
+        }
+        pthread_mutex_unlock(&shard->mutex);
     }
-    pthread_mutex_unlock(&head_mutex);
 }
 
 static _MemoryBacktrace *
 _backtraceCreate(int maximumFrameCount)
 {
-    _MemoryBacktrace *result = malloc(sizeof(_MemoryBacktrace));
+    _MemoryBacktrace *result = malloc(sizeof(_MemoryBacktrace) + maximumFrameCount * sizeof(void *));
     result->maximumFrameCount = maximumFrameCount;
-    result->callstack = calloc(result->maximumFrameCount, sizeof(void *));
 
     result->actualFrameCount = backtrace(result->callstack, result->maximumFrameCount);
 
     return result;
 }
 
+/**
+ * Return true if a backtrace should be captured for the allocation being made by the calling thread.
+ */
+static bool
+_parcSafeMemory_SampleBacktrace(void)
+{
+    unsigned period = _parcSafeMemory_BacktraceSamplingPeriod;
+    if (period == 0) {
+        return false;
+    }
+    if (++_parcSafeMemory_AllocationsSinceBacktrace >= period) {
+        _parcSafeMemory_AllocationsSinceBacktrace = 0;
+        return true;
+    }
+    return false;
+}
+
+void
+parcSafeMemory_SetBacktraceSamplingPeriod(unsigned period)
+{
+    _parcSafeMemory_BacktraceSamplingPeriod = period;
+}
+
+unsigned
+parcSafeMemory_GetBacktraceSamplingPeriod(void)
+{
+    return _parcSafeMemory_BacktraceSamplingPeriod;
+}
+
 /**
  * Format memory with a MemoryPrefix structure.
  *
@@ -509,7 +639,7 @@ _parcSafeMemory_FormatPrefix(PARCSafeMemoryOrigin *origin, size_t requestedLengt
     prefix->requestedLength = requestedLength;
     prefix->actualLength = _computeUsableMemoryLength(requestedLength, sizeof(void*));
     prefix->alignment = alignment;
-    prefix->backtrace = _backtraceCreate(backTraceDepth);
+    prefix->backtrace = _parcSafeMemory_SampleBacktrace() ? _backtraceCreate(backTraceDepth) : NULL;
     prefix->guard = _parcSafeMemory_Guard;
 
     PARCSafeMemoryUsable *result = _pointerAdd(origin, prefixSize);
@@ -549,20 +679,16 @@ parcSafeMemory_MemAlign(void **memptr, size_t alignment, size_t requestedSize)
         return ERANGE;
     }
 
-    pthread_mutex_lock(&_parcSafeMemory_Mutex);
-
     void *base;
     int failure = ((PARCMemoryMemAlign *) _parcMemory->MemAlign)(&base, alignment, totalSize);
 
     if (failure != 0 || base == NULL) {
-        pthread_mutex_unlock(&_parcSafeMemory_Mutex);
         return ENOMEM;
     }
 
     *memptr = _parcSafeMemory_FormatMemory(base, requestedSize, alignment);
 
     _parcSafeMemory_AddAllocation(*memptr);
-    pthread_mutex_unlock(&_parcSafeMemory_Mutex);
 
     return 0;
 }
@@ -576,15 +702,12 @@ parcSafeMemory_Allocate(size_t requestedSize)
         size_t totalSize = _computeMemoryTotalLength(requestedSize, sizeof(void *));
 
         if (totalSize >= requestedSize) {
-            pthread_mutex_lock(&_parcSafeMemory_Mutex);
-
             void *base = ((PARCMemoryAllocate *) _parcMemory->Allocate)(totalSize);
             if (base != NULL) {
                 result = _parcSafeMemory_FormatMemory(base, requestedSize, sizeof(void *));
 
                 _parcSafeMemory_AddAllocation(result);
             }
-            pthread_mutex_unlock(&_parcSafeMemory_Mutex);
         }
     }
     return result;
@@ -318,6 +318,44 @@ uint32_t parcSafeMemory_Outstanding(void);
  */
 uint32_t parcSafeMemory_ReportAllocation(int outputFd);
 
+/**
+ * Set how often Safe Memory records a stack backtrace for an allocation.
+ *
+ * Capturing a backtrace is the most expensive part of a Safe Memory allocation.
+ * Under production-like load, sampling keeps the allocator usable while still reporting where
+ * a representative subset of outstanding allocations came from.
+ * Allocations without a backtrace are still tracked, checked for underrun and overrun, and reported.
+ *
+ * The default period is 1, which records a backtrace for every allocation.
+ *
+ * @param [in] period Record a backtrace for one in every @p period allocations made by each thread; 0 disables backtraces.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+ *     parcSafeMemory_SetBacktraceSamplingPeriod(1000);
+ * }
+ * @endcode
+ *
+ * @see parcSafeMemory_GetBacktraceSamplingPeriod
+ */
+void parcSafeMemory_SetBacktraceSamplingPeriod(unsigned period);
+
+/**
+ * Get how often Safe Memory records a stack backtrace for an allocation.
+ *
+ * @return The period set by {@link parcSafeMemory_SetBacktraceSamplingPeriod}, 1 by default.
+ *
+ * Example:
+ * @code
+ * {
+ *     unsigned period = parcSafeMemory_GetBacktraceSamplingPeriod();
+ * }
+ * @endcode
+ */
+unsigned parcSafeMemory_GetBacktraceSamplingPeriod(void);
+
 /**
  * Determine if a pointer to Safe Memory is valid.
  *
@@ -69,6 +69,7 @@
 #include <LongBow/runtime.h>
 
 #include <parc/algol/parc_StdlibMemory.h>
+#include <parc/statistics/parc_Metrics.h>
 
 static uint32_t _parcStdlibMemory_OutstandingAllocations;
 
@@ -210,6 +211,20 @@ parcStdlibMemory_Outstanding(void)
     return _parcStdlibMemory_OutstandingAllocations;
 }
 
+static int64_t
+_parcStdlibMemory_OutstandingGauge(const PARCObject *unused)
+{
+    return parcStdlibMemory_Outstanding();
+}
+
+void
+parcStdlibMemory_RegisterMetrics(PARCMetrics *metrics, const char *prefix)
+{
+    char *name = parcMemory_Format("%s.outstanding", prefix);
+    parcMetrics_AddGauge(metrics, name, _parcStdlibMemory_OutstandingGauge, NULL);
+    parcMemory_Deallocate((void **) &name);
+}
+
 PARCMemoryInterface PARCStdlibMemoryAsPARCMemory = {
     .Allocate         = (uintptr_t) parcStdlibMemory_Allocate,
     .AllocateAndClear = (uintptr_t) parcStdlibMemory_AllocateAndClear,
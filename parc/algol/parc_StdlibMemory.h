@@ -66,6 +66,8 @@
 
 #include <parc/algol/parc_Memory.h>
 
+struct PARCMetrics;
+
 extern PARCMemoryInterface PARCStdlibMemoryAsPARCMemory;
 
 /**
@@ -208,6 +210,22 @@ char *parcStdlibMemory_StringDuplicate(const char *string, size_t length);
  */
 uint32_t parcStdlibMemory_Outstanding(void);
 
+/**
+ * Register a gauge of the number of outstanding allocations, named by appending ".outstanding" to @p prefix,
+ * in a `PARCMetrics` registry.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] prefix The prefix of the name of the gauge.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcStdlibMemory_RegisterMetrics(metrics, "memory");
+ * }
+ * @endcode
+ */
+void parcStdlibMemory_RegisterMetrics(struct PARCMetrics *metrics, const char *prefix);
+
 
 /**
  * Replacement function for realloc(3).
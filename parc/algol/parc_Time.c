@@ -58,6 +58,7 @@
  */
 #include <config.h>
 
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
@@ -80,15 +81,32 @@ parcTime_TimevalAsString(struct timeval timeval)
     return result;
 }
 
+/*
+ * Log formatters produce an RFC3339 time stamp for every line,
+ * so each thread keeps the date and time of the most recent second it formatted.
+ */
+static __thread struct {
+    bool isValid;
+    time_t seconds;
+    size_t length;
+    char prefix[48];
+} _parcTime_RFC3339Prefix;
+
 char *
 parcTime_TimevalAsRFC3339(const struct timeval *utcTime, char result[64])
 {
-    char tmbuf[64];
-    struct tm theTime;
+    if (!_parcTime_RFC3339Prefix.isValid || _parcTime_RFC3339Prefix.seconds != utcTime->tv_sec) {
+        struct tm theTime;
+
+        struct tm *nowtm = gmtime_r(&utcTime->tv_sec, &theTime);
+        _parcTime_RFC3339Prefix.length = strftime(_parcTime_RFC3339Prefix.prefix, sizeof(_parcTime_RFC3339Prefix.prefix),
+                                                  "%Y-%m-%dT%H:%M:%S", nowtm);
+        _parcTime_RFC3339Prefix.seconds = utcTime->tv_sec;
+        _parcTime_RFC3339Prefix.isValid = true;
+    }
 
-    struct tm *nowtm = gmtime_r(&utcTime->tv_sec, &theTime);
-    strftime(tmbuf, sizeof tmbuf, "%Y-%m-%dT%H:%M:%S", nowtm);
-    snprintf(result, 64, "%s.%06ldZ", tmbuf, (long) utcTime->tv_usec);
+    memcpy(result, _parcTime_RFC3339Prefix.prefix, _parcTime_RFC3339Prefix.length);
+    snprintf(&result[_parcTime_RFC3339Prefix.length], 64 - _parcTime_RFC3339Prefix.length, ".%06ldZ", (long) utcTime->tv_usec);
     return result;
 }
 
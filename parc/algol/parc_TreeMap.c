@@ -899,12 +899,6 @@ _rbAddalueToList(_RBNode *node, PARCList *list)
     parcList_Add(list, parcObject_Acquire(parcKeyValue_GetValue(node->element)));
 }
 
-static void
-_rbAddElementToList(_RBNode *node, PARCList *list)
-{
-    parcList_Add(list, parcObject_Acquire(node->element));
-}
-
 PARCList *
 parcTreeMap_AcquireKeys(const PARCTreeMap *tree)
 {
@@ -937,22 +931,6 @@ parcTreeMap_AcquireValues(const PARCTreeMap *tree)
     return values;
 }
 
-static PARCList *
-_parcTreeMap_Elements(const PARCTreeMap *tree)
-{
-    assertNotNull(tree, "Tree can't be NULL");
-    _rbNodeAssertTreeInvariants(tree);
-
-    PARCList *elements = parcList(parcArrayList_Create_Capacity((bool (*)(void *x, void *y))parcObject_Equals,
-                                                                (void (*)(void **))parcObject_Release, tree->size),
-                                  PARCArrayListAsPARCList);
-
-    if (tree->size > 0) {
-        _rbNodeRecursiveRun((PARCTreeMap *) tree, tree->root, (rbRecursiveFunc *) _rbAddElementToList, elements);
-    }
-    return elements;
-}
-
 bool
 parcTreeMap_Equals(const PARCTreeMap *tree1, const PARCTreeMap *tree2)
 {
@@ -963,47 +941,28 @@ parcTreeMap_Equals(const PARCTreeMap *tree1, const PARCTreeMap *tree2)
 
     bool result = false;
 
-    PARCList *keys1 = parcTreeMap_AcquireKeys(tree1);
-    PARCList *keys2 = parcTreeMap_AcquireKeys(tree2);
-    size_t length1 = parcList_Size(keys1);
-    size_t length2 = parcList_Size(keys2);
-
-    if (length1 == length2) {
+    if (tree1->size == tree2->size) {
         result = true;
-        for (size_t i = 0; i < length1; i++) {
-            if (!parcObject_Equals(parcList_GetAtIndex(keys1, i), parcList_GetAtIndex(keys2, i))) {
-                result = false;
-                break;
-            }
-        }
-        if (result) {
-            PARCList *values1 = parcTreeMap_AcquireValues(tree1);
-            PARCList *values2 = parcTreeMap_AcquireValues(tree2);
-            size_t s1 = parcList_Size(values1);
-            size_t s2 = parcList_Size(values2);
-            if (s1 == s2) {
-                for (size_t i = 0; i < s1; i++) {
-                    PARCObject *value1 = parcList_GetAtIndex(values1, i);
-                    PARCObject *value2 = parcList_GetAtIndex(values2, i);
-                    if (!parcObject_Equals(value1, value2)) {
-                        result = false;
-                        break;
-                    }
-                }
-            }
-            parcList_Release(&values1);
-            parcList_Release(&values2);
+
+        PARCTreeMapCursor cursor1;
+        PARCTreeMapCursor cursor2;
+        parcTreeMapCursor_Init(&cursor1, (PARCTreeMap *) tree1);
+        parcTreeMapCursor_Init(&cursor2, (PARCTreeMap *) tree2);
+
+        while (result && parcTreeMapCursor_HasNext(&cursor1)) {
+            PARCObject *key1 = parcTreeMapCursor_Next(&cursor1);
+            PARCObject *key2 = parcTreeMapCursor_Next(&cursor2);
+            result = parcObject_Equals(key1, key2)
+                     && parcObject_Equals(parcTreeMapCursor_GetValue(&cursor1), parcTreeMapCursor_GetValue(&cursor2));
         }
     }
 
-    parcList_Release(&keys1);
-    parcList_Release(&keys2);
     return result;
 }
 
 
 /*
- * This is a simple implementation of Copy that goes through the list of keys and values.
+ * This is a simple implementation of Copy that goes through the keys and values in order.
  */
 PARCTreeMap *
 parcTreeMap_Copy(const PARCTreeMap *sourceTree)
@@ -1011,107 +970,131 @@ parcTreeMap_Copy(const PARCTreeMap *sourceTree)
     _rbNodeAssertTreeInvariants(sourceTree);
     assertNotNull(sourceTree, "Tree can't be NULL");
 
-    PARCObject *keySource;
-    PARCObject *keyCopy;
-    PARCObject *valueSource;
-    PARCObject *valueCopy;
-
     PARCTreeMap *treeCopy = parcTreeMap_CreateCustom(sourceTree->customCompare);
 
-    PARCList *keys = parcTreeMap_AcquireKeys(sourceTree);
-    PARCList *values = parcTreeMap_AcquireValues(sourceTree);
-
-    size_t total_keys = parcList_Size(keys);
-
-    for (size_t i = 0; i < total_keys; i++) {
-        keySource = parcList_GetAtIndex(keys, i);
-        valueSource = parcList_GetAtIndex(values, i);
+    PARCTreeMapCursor cursor;
+    parcTreeMapCursor_Init(&cursor, (PARCTreeMap *) sourceTree);
 
-        keyCopy = parcObject_Copy(keySource);
-        valueCopy = parcObject_Copy(valueSource);
+    while (parcTreeMapCursor_HasNext(&cursor)) {
+        PARCObject *keyCopy = parcObject_Copy(parcTreeMapCursor_Next(&cursor));
+        PARCObject *valueCopy = parcObject_Copy(parcTreeMapCursor_GetValue(&cursor));
 
         parcTreeMap_Put(treeCopy, keyCopy, valueCopy);
         parcObject_Release(&keyCopy);
         parcObject_Release(&valueCopy);
     }
 
-    parcList_Release(&keys);
-    parcList_Release(&values);
-
     return treeCopy;
 }
 
 ////// Iterator Support //////
 
-typedef struct {
-    PARCTreeMap *map;
-    PARCList *list;
-    size_t currentIndex;
-    PARCKeyValue *currentElement;
-} _PARCTreeMapIterator;
+void
+parcTreeMapCursor_Init(PARCTreeMapCursor *cursor, PARCTreeMap *tree)
+{
+    cursor->tree = tree;
+    cursor->current = NULL;
+    cursor->next = (tree->root != tree->nil) ? _rbMinRelativeNode(tree, tree->root) : NULL;
+}
+
+bool
+parcTreeMapCursor_HasNext(const PARCTreeMapCursor *cursor)
+{
+    return cursor->next != NULL;
+}
+
+PARCObject *
+parcTreeMapCursor_Next(PARCTreeMapCursor *cursor)
+{
+    trapOutOfBoundsIf(cursor->next == NULL, "No more elements.");
+
+    _RBNode *node = cursor->next;
+    _RBNode *next = _rbNextNode(cursor->tree, node);
 
-static _PARCTreeMapIterator *
+    cursor->current = node;
+    cursor->next = (next != cursor->tree->nil) ? next : NULL;
+
+    return parcKeyValue_GetKey(node->element);
+}
+
+PARCObject *
+parcTreeMapCursor_GetValue(const PARCTreeMapCursor *cursor)
+{
+    const _RBNode *node = cursor->current;
+    return parcKeyValue_GetValue(node->element);
+}
+
+PARCKeyValue *
+parcTreeMapCursor_GetEntry(const PARCTreeMapCursor *cursor)
+{
+    const _RBNode *node = cursor->current;
+    return node->element;
+}
+
+void
+parcTreeMapCursor_Remove(PARCTreeMapCursor *cursor)
+{
+    // Removal relinks nodes rather than moving elements between them, so the next node is still valid.
+    _RBNode *node = cursor->current;
+    _rbNodeRemove(cursor->tree, node);
+    _rbNodeFree(node);
+    cursor->current = NULL;
+}
+
+static PARCTreeMapCursor *
 _parcTreeMapIterator_Init(PARCTreeMap *map)
 {
-    _PARCTreeMapIterator *state = parcMemory_AllocateAndClear(sizeof(_PARCTreeMapIterator));
+    PARCTreeMapCursor *state = parcMemory_Allocate(sizeof(PARCTreeMapCursor));
 
     if (state != NULL) {
-        state->map = map;
-        state->list = _parcTreeMap_Elements(map);
-        state->currentIndex = 0;
-        state->currentElement = parcList_GetAtIndex(state->list, 0);
-        trapOutOfMemoryIf(state->list == NULL, "Cannot create parcList");
+        parcTreeMapCursor_Init(state, map);
     }
 
     return state;
 }
 
 static bool
-_parcTreeMapIterator_Fini(PARCTreeMap *map __attribute__((unused)), _PARCTreeMapIterator *state __attribute__((unused)))
+_parcTreeMapIterator_Fini(PARCTreeMap *map __attribute__((unused)), PARCTreeMapCursor *state)
 {
-    parcList_Release(&state->list);
     parcMemory_Deallocate(&state);
     return true;
 }
 
-static _PARCTreeMapIterator *
-_parcTreeMapIterator_Next(PARCTreeMap *map __attribute__((unused)), _PARCTreeMapIterator *state)
+static PARCTreeMapCursor *
+_parcTreeMapIterator_Next(PARCTreeMap *map __attribute__((unused)), PARCTreeMapCursor *state)
 {
-    state->currentElement = parcList_GetAtIndex(state->list, state->currentIndex);
-    ++state->currentIndex;
+    parcTreeMapCursor_Next(state);
     return state;
 }
 
 static void
-_parcTreeMapIterator_Remove(PARCTreeMap *map, _PARCTreeMapIterator **statePtr)
+_parcTreeMapIterator_Remove(PARCTreeMap *map __attribute__((unused)), PARCTreeMapCursor **statePtr)
 {
-    _PARCTreeMapIterator *state = *statePtr;
-
-    parcTreeMap_RemoveAndRelease(map, parcKeyValue_GetKey(state->currentElement));
+    parcTreeMapCursor_Remove(*statePtr);
 }
 
 static bool
-_parcTreeMapIterator_HasNext(PARCTreeMap *map __attribute__((unused)), _PARCTreeMapIterator *state)
+_parcTreeMapIterator_HasNext(PARCTreeMap *map __attribute__((unused)), PARCTreeMapCursor *state)
 {
-    return (parcList_Size(state->list) > state->currentIndex);
+    return parcTreeMapCursor_HasNext(state);
 }
 
 static PARCObject *
-_parcTreeMapIterator_Element(PARCTreeMap *map __attribute__((unused)), const _PARCTreeMapIterator *state)
+_parcTreeMapIterator_Element(PARCTreeMap *map __attribute__((unused)), const PARCTreeMapCursor *state)
 {
-    return state->currentElement;
+    return parcTreeMapCursor_GetEntry(state);
 }
 
 static PARCObject *
-_parcTreeMapIterator_ElementValue(PARCTreeMap *map __attribute__((unused)), const _PARCTreeMapIterator *state)
+_parcTreeMapIterator_ElementValue(PARCTreeMap *map __attribute__((unused)), const PARCTreeMapCursor *state)
 {
-    return parcKeyValue_GetValue(state->currentElement);
+    return parcTreeMapCursor_GetValue(state);
 }
 
 static PARCObject *
-_parcTreeMapIterator_ElementKey(PARCTreeMap *map __attribute__((unused)), const _PARCTreeMapIterator *state)
+_parcTreeMapIterator_ElementKey(PARCTreeMap *map __attribute__((unused)), const PARCTreeMapCursor *state)
 {
-    return parcKeyValue_GetKey(state->currentElement);
+    return parcKeyValue_GetKey(parcTreeMapCursor_GetEntry(state));
 }
 
 PARCIterator *
@@ -752,4 +752,89 @@ PARCIterator *parcTreeMap_CreateValueIterator(PARCTreeMap *tree);
  * @endcode
  */
 PARCIterator *parcTreeMap_CreateKeyValueIterator(PARCTreeMap *tree);
+
+/**
+ * @typedef PARCTreeMapCursor
+ * @brief A position in a `PARCTreeMap`, for iterating over its entries in key order without allocating.
+ *
+ * A cursor is an ordinary structure, usually on the stack, initialised by `parcTreeMapCursor_Init()`.
+ * It walks the tree from each node to its successor, so it does not copy the entries as
+ * the iterators returned by `parcTreeMap_CreateKeyIterator()` and its siblings do,
+ * and nothing needs to be released when it is no longer needed.
+ *
+ * The tree must not be modified while a cursor is in use, except through `parcTreeMapCursor_Remove()`.
+ * The cursor does not acquire a reference to the tree.
+ */
+typedef struct parc_treemap_cursor {
+    PARCTreeMap *tree;
+    void *current;
+    void *next;
+} PARCTreeMapCursor;
+
+/**
+ * Initialise a `PARCTreeMapCursor` to the position before the entry with the lowest key.
+ *
+ * @param [out] cursor A pointer to the `PARCTreeMapCursor` to initialise.
+ * @param [in] tree A pointer to a valid `PARCTreeMap`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCTreeMapCursor cursor;
+ *     parcTreeMapCursor_Init(&cursor, tree);
+ *
+ *     while (parcTreeMapCursor_HasNext(&cursor)) {
+ *         PARCObject *key = parcTreeMapCursor_Next(&cursor);
+ *         PARCObject *value = parcTreeMapCursor_GetValue(&cursor);
+ *     }
+ * }
+ * @endcode
+ */
+void parcTreeMapCursor_Init(PARCTreeMapCursor *cursor, PARCTreeMap *tree);
+
+/**
+ * Determine if there is an entry after the cursor.
+ *
+ * @param [in] cursor A pointer to an initialised `PARCTreeMapCursor`.
+ *
+ * @return true There is another entry.
+ * @return false The cursor is after the entry with the highest key.
+ */
+bool parcTreeMapCursor_HasNext(const PARCTreeMapCursor *cursor);
+
+/**
+ * Advance the cursor to the next entry in key order and return its key.
+ *
+ * It is a trap to call this function when `parcTreeMapCursor_HasNext()` is false.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCTreeMapCursor`.
+ *
+ * @return The key of the next entry.
+ */
+PARCObject *parcTreeMapCursor_Next(PARCTreeMapCursor *cursor);
+
+/**
+ * Get the value of the entry most recently returned by `parcTreeMapCursor_Next()`.
+ *
+ * @param [in] cursor A pointer to an initialised `PARCTreeMapCursor`.
+ *
+ * @return The value of the current entry.
+ */
+PARCObject *parcTreeMapCursor_GetValue(const PARCTreeMapCursor *cursor);
+
+/**
+ * Get the `PARCKeyValue` of the entry most recently returned by `parcTreeMapCursor_Next()`.
+ *
+ * @param [in] cursor A pointer to an initialised `PARCTreeMapCursor`.
+ *
+ * @return The current entry.
+ */
+PARCKeyValue *parcTreeMapCursor_GetEntry(const PARCTreeMapCursor *cursor);
+
+/**
+ * Remove and release the entry most recently returned by `parcTreeMapCursor_Next()`.
+ *
+ * @param [in,out] cursor A pointer to an initialised `PARCTreeMapCursor`.
+ */
+void parcTreeMapCursor_Remove(PARCTreeMapCursor *cursor);
 #endif // libparc_parc_TreeMap_h
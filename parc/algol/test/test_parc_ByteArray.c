@@ -100,6 +100,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Wrap_ZeroLength);
 
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Wrap);
+    LONGBOW_RUN_TEST_CASE(Global, parcByteArray_WrapOwned);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Array);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_AddressOfIndex);
     LONGBOW_RUN_TEST_CASE(Global, parcByteArray_Capacity);
@@ -157,6 +158,21 @@ LONGBOW_TEST_CASE(Global, parcByteArray_Wrap)
     parcByteArray_Release(&actual);
 }
 
+LONGBOW_TEST_CASE(Global, parcByteArray_WrapOwned)
+{
+    PARCByteArray *owner = parcByteArray_Allocate(10);
+    parcByteArray_PutByte(owner, 9, 123);
+
+    PARCByteArray *actual = parcByteArray_WrapOwned(10, parcByteArray_Array(owner), owner);
+    assertTrue(parcByteArray_Array(actual) == parcByteArray_Array(owner), "Expected the array to be the owner's array.");
+    assertTrue(parcObject_GetReferenceCount(owner) == 2, "Expected the owner to be acquired.");
+
+    parcByteArray_Release(&owner);
+    assertTrue(parcByteArray_GetByte(actual, 9) == 123, "Expected the wrapped memory to outlive the released owner.");
+
+    parcByteArray_Release(&actual);
+}
+
 LONGBOW_TEST_CASE(Global, parcByteArray_Wrap_NULL)
 {
     PARCByteArray *actual = parcByteArray_Wrap(10, NULL);
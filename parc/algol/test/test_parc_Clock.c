@@ -60,12 +60,14 @@
 // This permits internal static functions to be visible to this Test Framework.
 #include "../parc_Clock.c"
 #include <stdio.h>
+#include <unistd.h>
 #include <LongBow/unit-test.h>
 #include <parc/algol/parc_SafeMemory.h>
 
 LONGBOW_TEST_RUNNER(parc_Clock)
 {
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -99,6 +101,14 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, counterClock_GetTime_Twice);
     LONGBOW_RUN_TEST_CASE(Global, counterClock_GetTimeval);
 
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_TSC);
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_TSC_Acquire);
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_TSC_GetTime);
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_TSC_GetTimeval);
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_TSC_Elapsed);
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_TSC_BeforeBase);
+    LONGBOW_RUN_TEST_CASE(Global, parcClock_IsTSC);
+
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -226,9 +236,152 @@ LONGBOW_TEST_CASE(Global, counterClock_GetTimeval)
     assertTrue(tv.tv_usec == 1, "On first call should have gotten 1 usec");
 }
 
+// -----
+
+LONGBOW_TEST_CASE(Global, parcClock_TSC)
+{
+    PARCClock *clock = parcClock_TSC();
+    assertNotNull(clock, "Got null TSC clock");
+    parcClock_Release(&clock);
+}
+
+LONGBOW_TEST_CASE(Global, parcClock_TSC_Acquire)
+{
+    PARCClock *clock = parcClock_TSC();
+    PARCClock *copy = parcClock_Acquire(clock);
+    assertNotNull(copy, "Got null TSC clock");
+    parcClock_Release(&copy);
+    parcClock_Release(&clock);
+}
+
+LONGBOW_TEST_CASE(Global, parcClock_TSC_GetTime)
+{
+    PARCClock *clock = parcClock_TSC();
+
+    uint64_t system = _tscclock_SystemNanoseconds();
+    uint64_t t = parcClock_GetTime(clock);
+
+    // On the CLOCK_MONOTONIC time line, within the calibration error.
+    uint64_t difference = t > system ? t - system : system - t;
+    assertTrue(difference < 1000000, "Expected the clock within 1 ms of CLOCK_MONOTONIC, off by %" PRIu64 " ns", difference);
+
+    uint64_t previous = t;
+    for (int i = 0; i < 100000; i++) {
+        uint64_t now = parcClock_GetTime(clock);
+        assertTrue(now >= previous, "Expected a monotonic clock, %" PRIu64 " followed %" PRIu64, now, previous);
+        previous = now;
+    }
+
+    parcClock_Release(&clock);
+}
+
+LONGBOW_TEST_CASE(Global, parcClock_TSC_GetTimeval)
+{
+    PARCClock *clock = parcClock_TSC();
+    struct timeval tv = { 0, 0};
+    parcClock_GetTimeval(clock, &tv);
+    parcClock_Release(&clock);
+    assertTrue(tv.tv_sec > 0, "Got 0 seconds");
+    assertTrue(tv.tv_usec < 1000000, "Got more than a second of micro-seconds: %ld", (long) tv.tv_usec);
+}
+
+LONGBOW_TEST_CASE(Global, parcClock_TSC_Elapsed)
+{
+    PARCClock *clock = parcClock_TSC();
+
+    uint64_t system = _tscclock_SystemNanoseconds();
+    uint64_t start = parcClock_GetTime(clock);
+    usleep(20000);
+    uint64_t elapsed = parcClock_GetTime(clock) - start;
+    uint64_t systemElapsed = _tscclock_SystemNanoseconds() - system;
+
+    assertTrue(elapsed >= 20000000, "Expected at least 20 ms, actual %" PRIu64 " ns", elapsed);
+    // The reads are bracketed by the system clock reads; allow for the calibration error.
+    assertTrue(elapsed <= systemElapsed + systemElapsed / 1000, "Expected about the system clock's %" PRIu64 " ns, actual %" PRIu64 " ns",
+               systemElapsed, elapsed);
+
+    parcClock_Release(&clock);
+}
+
+LONGBOW_TEST_CASE(Global, parcClock_TSC_BeforeBase)
+{
+    PARCClock *clock = parcClock_TSC();
+#ifdef _PARC_CLOCK_TSC
+    if (parcClock_IsTSC(clock)) {
+        // Another core's counter may read slightly behind the one that calibrated.
+        uint64_t base = _tscclock_Calibration.baseNanoseconds;
+        uint64_t before = _tscclock_ToNanoseconds(_tscclock_Calibration.baseCycles - 1000);
+        uint64_t after = _tscclock_ToNanoseconds(_tscclock_Calibration.baseCycles + 1000);
+
+        assertTrue(before < base && base - before < 1000000,
+                   "Expected a reading before the base just before %" PRIu64 " ns, got %" PRIu64 " ns", base, before);
+        assertTrue(after > base && after - base < 1000000,
+                   "Expected a reading after the base just after %" PRIu64 " ns, got %" PRIu64 " ns", base, after);
+    }
+#endif
+    parcClock_Release(&clock);
+}
+
+LONGBOW_TEST_CASE(Global, parcClock_IsTSC)
+{
+    PARCClock *clock = parcClock_TSC();
+#ifndef _PARC_CLOCK_TSC
+    assertFalse(parcClock_IsTSC(clock), "Expected the system clock fallback off x86-64");
+#endif
+    printf("TSC clock %s the time stamp counter\n", parcClock_IsTSC(clock) ? "reads" : "does not read");
+    parcClock_Release(&clock);
+
+    clock = parcClock_Monotonic();
+    assertFalse(parcClock_IsTSC(clock), "Expected the monotonic clock to not be the TSC clock");
+    parcClock_Release(&clock);
+}
 
 // ==========================================================
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcClock_GetTime);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_nanosecondsPerRead(PARCClock *clock, int reads)
+{
+    uint64_t sum = 0;
+    uint64_t start = _tscclock_SystemNanoseconds();
+    for (int i = 0; i < reads; i++) {
+        sum += parcClock_GetTime(clock);
+    }
+    uint64_t elapsed = _tscclock_SystemNanoseconds() - start;
+
+    // Keep the reads from being optimised away.
+    assertTrue(sum != 0, "Expected a non-zero sum of times");
+
+    return (double) elapsed / reads;
+}
+
+LONGBOW_TEST_CASE(Performance, parcClock_GetTime)
+{
+    const int reads = 10000000;
+
+    PARCClock *clock = parcClock_TSC();
+    printf("TSC (%s) %.1f ns per read\n", parcClock_IsTSC(clock) ? "counter" : "fallback", _nanosecondsPerRead(clock, reads));
+    parcClock_Release(&clock);
+
+    clock = parcClock_Monotonic();
+    printf("Monotonic %.1f ns per read\n", _nanosecondsPerRead(clock, reads));
+    parcClock_Release(&clock);
+}
+
 int
 main(int argc, char *argv[])
 {
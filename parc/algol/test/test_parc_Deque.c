@@ -173,6 +173,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcDeque_Display_NULL);
 
     LONGBOW_RUN_TEST_CASE(Global, parcDeque_Iterator);
+    LONGBOW_RUN_TEST_CASE(Global, parcDeque_Append_ManyBlocks);
+    LONGBOW_RUN_TEST_CASE(Global, parcDeque_Prepend_ManyBlocks);
+    LONGBOW_RUN_TEST_CASE(Global, parcDeque_RemoveLast_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcDeque_Mixed);
+    LONGBOW_RUN_TEST_CASE(Global, parcDeque_Queue_ReusesBlocks);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -257,8 +262,8 @@ LONGBOW_TEST_CASE(Global, parcDeque_Prepend_One)
 
     assertTrue(deque == actual, "Expected parcDeque_Append to return its argument.");
     assertTrue(parcDeque_Size(deque) == 1, "Expected size of 1, actual %zd", parcDeque_Size(deque));
-    assertTrue(deque->head != NULL, "Expected head to be not null.");
-    assertTrue(deque->head == deque->tail, "Expected head to be equal to the tail.");
+    assertTrue(deque->blockCount == 1, "Expected one block, actual %zd", deque->blockCount);
+    assertTrue(parcDeque_PeekFirst(deque) == parcDeque_PeekLast(deque), "Expected the first element to be the last.");
 
     parcDeque_Release(&deque);
 }
@@ -510,9 +515,149 @@ LONGBOW_TEST_CASE(Global, parcDeque_Iterator)
     parcDeque_Release(&x);
 }
 
+LONGBOW_TEST_CASE(Global, parcDeque_Append_ManyBlocks)
+{
+    PARCDeque *deque = parcDeque_Create();
+    size_t count = 10 * _parcDeque_BlockSize + 7;
+
+    for (size_t i = 0; i < count; i++) {
+        parcDeque_Append(deque, (void *) i);
+    }
+    assertTrue(parcDeque_Size(deque) == count, "Expected size %zd, actual %zd", count, parcDeque_Size(deque));
+
+    for (size_t i = 0; i < count; i++) {
+        size_t actual = (size_t) parcDeque_GetAtIndex(deque, i);
+        assertTrue(actual == i, "Expected %zd, actual %zd", i, actual);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t actual = (size_t) parcDeque_RemoveFirst(deque);
+        assertTrue(actual == i, "Expected %zd, actual %zd", i, actual);
+    }
+    assertTrue(parcDeque_IsEmpty(deque), "Expected the deque to be empty.");
+
+    parcDeque_Release(&deque);
+}
+
+LONGBOW_TEST_CASE(Global, parcDeque_Prepend_ManyBlocks)
+{
+    PARCDeque *deque = parcDeque_Create();
+    size_t count = 10 * _parcDeque_BlockSize + 7;
+
+    for (size_t i = 0; i < count; i++) {
+        parcDeque_Prepend(deque, (void *) i);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t actual = (size_t) parcDeque_GetAtIndex(deque, i);
+        assertTrue(actual == count - 1 - i, "Expected %zd, actual %zd", count - 1 - i, actual);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        size_t actual = (size_t) parcDeque_RemoveLast(deque);
+        assertTrue(actual == i, "Expected %zd, actual %zd", i, actual);
+    }
+    assertTrue(parcDeque_IsEmpty(deque), "Expected the deque to be empty.");
+
+    parcDeque_Release(&deque);
+}
+
+LONGBOW_TEST_CASE(Global, parcDeque_RemoveLast_Empty)
+{
+    PARCDeque *deque = parcDeque_Create();
+    parcDeque_Append(deque, "element 1");
+
+    char *actual = parcDeque_RemoveLast(deque);
+    assertTrue(strcmp(actual, "element 1") == 0, "Expected 'element 1', actual '%s'", actual);
+    assertTrue(parcDeque_IsEmpty(deque), "Expected the deque to be empty.");
+    assertNull(parcDeque_RemoveLast(deque), "Expected NULL from an empty deque.");
+    assertNull(parcDeque_RemoveFirst(deque), "Expected NULL from an empty deque.");
+    assertNull(parcDeque_PeekFirst(deque), "Expected NULL from an empty deque.");
+    assertNull(parcDeque_PeekLast(deque), "Expected NULL from an empty deque.");
+
+    parcDeque_Release(&deque);
+}
+
+LONGBOW_TEST_CASE(Global, parcDeque_Mixed)
+{
+    // Compare against a simple array model while adding and removing at both ends.
+    size_t modelCapacity = 8192;
+    size_t *model = parcMemory_Allocate(modelCapacity * sizeof(size_t));
+    size_t first = modelCapacity / 2;
+    size_t last = first;
+
+    PARCDeque *deque = parcDeque_Create();
+    unsigned int seed = 1;
+
+    for (size_t i = 0; i < 5000; i++) {
+        switch (rand_r(&seed) % 5) {
+            case 0:
+            case 1:
+                parcDeque_Append(deque, (void *) i);
+                model[last++] = i;
+                break;
+            case 2:
+                parcDeque_Prepend(deque, (void *) i);
+                model[--first] = i;
+                break;
+            case 3:
+                if (last > first) {
+                    size_t actual = (size_t) parcDeque_RemoveFirst(deque);
+                    assertTrue(actual == model[first], "Expected %zd, actual %zd", model[first], actual);
+                    first++;
+                }
+                break;
+            default:
+                if (last > first) {
+                    size_t actual = (size_t) parcDeque_RemoveLast(deque);
+                    last--;
+                    assertTrue(actual == model[last], "Expected %zd, actual %zd", model[last], actual);
+                }
+                break;
+        }
+        assertTrue(parcDeque_Size(deque) == last - first, "Expected size %zd, actual %zd", last - first, parcDeque_Size(deque));
+    }
+
+    for (size_t i = first; i < last; i++) {
+        size_t actual = (size_t) parcDeque_GetAtIndex(deque, i - first);
+        assertTrue(actual == model[i], "Expected %zd, actual %zd", model[i], actual);
+    }
+
+    PARCDeque *copy = parcDeque_Copy(deque);
+    assertTrue(parcDeque_Equals(deque, copy), "Expected the copy to be equal to the original.");
+    parcDeque_Release(&copy);
+
+    parcDeque_Release(&deque);
+    parcMemory_Deallocate(&model);
+}
+
+LONGBOW_TEST_CASE(Global, parcDeque_Queue_ReusesBlocks)
+{
+    PARCDeque *deque = parcDeque_Create();
+
+    for (size_t i = 0; i < 100; i++) {
+        parcDeque_Append(deque, (void *) i);
+    }
+    for (size_t i = 0; i < 3 * _parcDeque_BlockSize; i++) {
+        parcDeque_Append(deque, (void *) i);
+        parcDeque_RemoveFirst(deque);
+    }
+
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    for (size_t i = 0; i < 100 * _parcDeque_BlockSize; i++) {
+        parcDeque_Append(deque, (void *) i);
+        parcDeque_RemoveFirst(deque);
+        assertTrue(parcMemory_Outstanding() == outstanding, "Expected no allocations in the steady state.");
+    }
+    assertTrue(parcDeque_Size(deque) == 100, "Expected size 100, actual %zd", parcDeque_Size(deque));
+
+    parcDeque_Release(&deque);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
-    LONGBOW_RUN_TEST_CASE(Local, _parcDequeNode_Create);
+    LONGBOW_RUN_TEST_CASE(Local, _parcDeque_GrowRing);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -530,14 +675,32 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
-LONGBOW_TEST_CASE(Local, _parcDequeNode_Create)
+LONGBOW_TEST_CASE(Local, _parcDeque_GrowRing)
 {
-    void *element = "element";
-    struct parc_deque_node *previous = NULL;
-    struct parc_deque_node *next = NULL;
+    PARCDeque *deque = parcDeque_Create();
 
-    struct parc_deque_node *actual = _parcDequeNode_Create(element, previous, next);
-    _parcDequeNode_Destroy(NULL, &actual);
+    // Wrap the blocks around the end of the ring before it has to grow.
+    for (size_t i = 0; i < 2 * _parcDeque_BlockSize; i++) {
+        parcDeque_Append(deque, (void *) i);
+    }
+    for (size_t i = 0; i < 2 * _parcDeque_BlockSize; i++) {
+        parcDeque_Prepend(deque, (void *) (1000 + i));
+    }
+    size_t blockCapacity = deque->blockCapacity;
+
+    _parcDeque_GrowRing(deque);
+
+    assertTrue(deque->blockCapacity == 2 * blockCapacity,
+               "Expected the ring to double to %zd, actual %zd", 2 * blockCapacity, deque->blockCapacity);
+    assertTrue(deque->firstBlock == 0, "Expected the first block to be at the start of the ring, actual %zd", deque->firstBlock);
+    for (size_t i = 0; i < 2 * _parcDeque_BlockSize; i++) {
+        size_t actual = (size_t) parcDeque_GetAtIndex(deque, i);
+        assertTrue(actual == 1000 + 2 * _parcDeque_BlockSize - 1 - i, "Expected %zd, actual %zd", 1000 + 2 * _parcDeque_BlockSize - 1 - i, actual);
+        actual = (size_t) parcDeque_GetAtIndex(deque, 2 * _parcDeque_BlockSize + i);
+        assertTrue(actual == i, "Expected %zd, actual %zd", i, actual);
+    }
+
+    parcDeque_Release(&deque);
 }
 
 LONGBOW_TEST_FIXTURE(Errors)
@@ -585,6 +748,7 @@ LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
     LONGBOW_RUN_TEST_CASE(Performance, parcQueue_Append);
     LONGBOW_RUN_TEST_CASE(Performance, parcQueue_N2);
     LONGBOW_RUN_TEST_CASE(Performance, parcQueue_Iterator);
+    LONGBOW_RUN_TEST_CASE(Performance, parcQueue_AppendRemoveFirst);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -649,6 +813,22 @@ LONGBOW_TEST_CASE(Performance, parcQueue_Iterator)
     parcDeque_Release(&x);
 }
 
+LONGBOW_TEST_CASE(Performance, parcQueue_AppendRemoveFirst)
+{
+    PARCDeque *x = parcDeque_Create();
+    for (size_t i = 0; i < 1000; i++) {
+        parcDeque_Append(x, (void *) i);
+    }
+
+    for (size_t i = 1000; i < 10000000; i++) {
+        parcDeque_Append(x, (void *) i);
+        size_t actual = (size_t) parcDeque_RemoveFirst(x);
+        assertTrue(actual == i - 1000, "Expected %zd, actual %zd", i - 1000, actual);
+    }
+
+    parcDeque_Release(&x);
+}
+
 int
 main(int argc, char *argv[])
 {
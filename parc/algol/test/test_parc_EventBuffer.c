@@ -62,6 +62,7 @@
 
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_EventBuffer.h>
+#include <parc/algol/parc_Time.h>
 
 // Include the file(s) containing the functions to be tested.
 // This permits internal static functions to be visible to this Test Framework.
@@ -73,6 +74,7 @@ LONGBOW_TEST_RUNNER(parc_EventBuffer)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -99,6 +101,13 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadFromFileDescriptor);
     LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadLine_FreeLine);
     LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_GetQueueBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_AppendPARCBuffer_Reference);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_AppendPARCBuffer_Copy);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_View);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_WholeSegment);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_Spanning);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_Clamped);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_ConnectedPair);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -374,6 +383,286 @@ LONGBOW_TEST_CASE(Global, parc_EventBuffer_GetQueueBuffer)
     close(fds[1]);
 }
 
+static PARCBuffer *
+_sequence(size_t length, uint8_t first)
+{
+    PARCBuffer *result = parcBuffer_Allocate(length);
+    for (size_t i = 0; i < length; i++) {
+        parcBuffer_PutUint8(result, (uint8_t) (first + i));
+    }
+    return parcBuffer_Flip(result);
+}
+
+static void
+_assertSequence(PARCBuffer *buffer, size_t length, uint8_t first)
+{
+    assertTrue(parcBuffer_Remaining(buffer) == length,
+               "Expected %zu bytes, actual %zu", length, parcBuffer_Remaining(buffer));
+    for (size_t i = 0; i < length; i++) {
+        uint8_t actual = parcBuffer_GetAtIndex(buffer, parcBuffer_Position(buffer) + i);
+        assertTrue(actual == (uint8_t) (first + i), "Expected %u at %zu, actual %u", (uint8_t) (first + i), i, actual);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_AppendPARCBuffer_Reference)
+{
+    PARCEventBuffer *parcEventBuffer = parcEventBuffer_Create();
+    PARCBuffer *buffer = _sequence(PARCEventBuffer_ReferenceThreshold * 4, 0);
+
+    int result = parcEventBuffer_AppendPARCBuffer(parcEventBuffer, buffer);
+    assertTrue(result == 0, "parcEventBuffer_AppendPARCBuffer failed");
+    assertTrue(parcEventBuffer_GetLength(parcEventBuffer) == parcBuffer_Remaining(buffer), "Expected all remaining bytes to be appended");
+    assertTrue(parcObject_GetReferenceCount(buffer) == 2, "Expected the event buffer to hold a reference to the PARCBuffer");
+    assertTrue(parcEventBuffer_Pullup(parcEventBuffer, -1) == parcBuffer_Overlay(buffer, 0), "Expected the bytes to be referenced, not copied");
+
+    parcEventBuffer_Read(parcEventBuffer, NULL, parcBuffer_Remaining(buffer) - 1);
+    assertTrue(parcObject_GetReferenceCount(buffer) == 2, "Expected the reference to be held until all bytes are drained");
+    parcEventBuffer_Read(parcEventBuffer, NULL, 1);
+    assertTrue(parcObject_GetReferenceCount(buffer) == 1, "Expected the reference to be released once drained");
+
+    parcBuffer_Release(&buffer);
+    parcEventBuffer_Destroy(&parcEventBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_AppendPARCBuffer_Copy)
+{
+    PARCEventBuffer *parcEventBuffer = parcEventBuffer_Create();
+    PARCBuffer *buffer = _sequence(PARCEventBuffer_ReferenceThreshold - 1, 0);
+    parcBuffer_SetPosition(buffer, 10);
+
+    int result = parcEventBuffer_AppendPARCBuffer(parcEventBuffer, buffer);
+    assertTrue(result == 0, "parcEventBuffer_AppendPARCBuffer failed");
+    assertTrue(parcObject_GetReferenceCount(buffer) == 1, "Expected a short PARCBuffer to be copied");
+    assertTrue(parcBuffer_Position(buffer) == 10, "Expected the position to be unchanged");
+
+    PARCBuffer *actual = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, PARCEventBuffer_ReferenceThreshold);
+    _assertSequence(actual, PARCEventBuffer_ReferenceThreshold - 11, 10);
+
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&buffer);
+    parcEventBuffer_Destroy(&parcEventBuffer);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_View)
+{
+    const size_t length = PARCEventBuffer_ReferenceThreshold * 3;
+    const size_t head = PARCEventBuffer_ReferenceThreshold;
+
+    PARCEventBuffer *parcEventBuffer = parcEventBuffer_Create();
+    PARCBuffer *buffer = _sequence(length, 0);
+    parcEventBuffer_Append(parcEventBuffer, parcBuffer_Overlay(buffer, 0), length);
+    parcBuffer_Release(&buffer);
+
+    uint8_t *segment = parcEventBuffer_Pullup(parcEventBuffer, -1);
+    assertTrue(parcEventBuffer_GetContiguousLength(parcEventBuffer) == length, "Expected a single segment");
+
+    PARCBuffer *first = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, head);
+    assertTrue(parcBuffer_Overlay(first, 0) == segment, "Expected a view of the segment, not a copy");
+    _assertSequence(first, head, 0);
+    assertTrue(parcEventBuffer_GetLength(parcEventBuffer) == length - head, "Expected the bytes read to be removed");
+
+    // Appending and reading must not disturb the bytes under an outstanding view.
+    parcEventBuffer_Append(parcEventBuffer, (uint8_t[4]) { 0xFF, 0xFF, 0xFF, 0xFF }, 4);
+    PARCBuffer *second = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, length - head);
+    assertTrue(parcBuffer_Overlay(second, 0) == segment + head, "Expected a view of the rest of the segment");
+    _assertSequence(second, length - head, (uint8_t) head);
+
+    parcEventBuffer_Destroy(&parcEventBuffer);
+    _assertSequence(first, head, 0);
+    _assertSequence(second, length - head, (uint8_t) head);
+
+    parcBuffer_Release(&first);
+    parcBuffer_Release(&second);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_WholeSegment)
+{
+    PARCEventBuffer *parcEventBuffer = parcEventBuffer_Create();
+    PARCBuffer *buffer = _sequence(PARCEventBuffer_ReferenceThreshold * 2, 0);
+    parcEventBuffer_AppendPARCBuffer(parcEventBuffer, buffer);
+
+    PARCBuffer *actual = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, parcBuffer_Remaining(buffer));
+    assertTrue(parcBuffer_Overlay(actual, 0) == parcBuffer_Overlay(buffer, 0), "Expected a view of the appended PARCBuffer");
+    assertTrue(parcObject_GetReferenceCount(buffer) == 2, "Expected the view to keep the appended PARCBuffer alive");
+
+    parcEventBuffer_Destroy(&parcEventBuffer);
+    parcBuffer_Release(&actual);
+    assertTrue(parcObject_GetReferenceCount(buffer) == 1, "Expected releasing the view to release the appended PARCBuffer");
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_Spanning)
+{
+    PARCEventBuffer *parcEventBuffer = parcEventBuffer_Create();
+    PARCBuffer *a = _sequence(PARCEventBuffer_ReferenceThreshold, 0);
+    PARCBuffer *b = _sequence(PARCEventBuffer_ReferenceThreshold, (uint8_t) PARCEventBuffer_ReferenceThreshold);
+    parcEventBuffer_AppendPARCBuffer(parcEventBuffer, a);
+    parcEventBuffer_AppendPARCBuffer(parcEventBuffer, b);
+    assertTrue(parcEventBuffer_GetContiguousLength(parcEventBuffer) == PARCEventBuffer_ReferenceThreshold,
+               "Expected each PARCBuffer to be its own segment");
+
+    PARCBuffer *actual = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, PARCEventBuffer_ReferenceThreshold + 10);
+    _assertSequence(actual, PARCEventBuffer_ReferenceThreshold + 10, 0);
+    assertTrue(parcObject_GetReferenceCount(a) == 1, "Expected the bytes spanning segments to be copied");
+    assertTrue(parcEventBuffer_GetLength(parcEventBuffer) == PARCEventBuffer_ReferenceThreshold - 10, "Expected the bytes read to be removed");
+
+    parcBuffer_Release(&actual);
+    parcEventBuffer_Destroy(&parcEventBuffer);
+    parcBuffer_Release(&a);
+    parcBuffer_Release(&b);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_Clamped)
+{
+    PARCEventBuffer *parcEventBuffer = parcEventBuffer_Create();
+
+    PARCBuffer *empty = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, 10);
+    assertTrue(parcBuffer_Remaining(empty) == 0, "Expected an empty PARCBuffer from an empty event buffer");
+    assertTrue(parcEventBuffer_GetContiguousLength(parcEventBuffer) == 0, "Expected no contiguous bytes");
+
+    parcEventBuffer_Append(parcEventBuffer, "abc", 3);
+    PARCBuffer *actual = parcEventBuffer_ReadPARCBuffer(parcEventBuffer, 10);
+    assertTrue(parcBuffer_Remaining(actual) == 3, "Expected the length to be clamped");
+    assertTrue(parcEventBuffer_GetLength(parcEventBuffer) == 0, "Expected the event buffer to be empty");
+
+    parcBuffer_Release(&empty);
+    parcBuffer_Release(&actual);
+    parcEventBuffer_Destroy(&parcEventBuffer);
+}
+
+typedef struct {
+    bool zeroCopy;
+    size_t messageSize;
+    size_t received;
+    size_t views;
+} _PairReceiver;
+
+/*
+ * Read whole messages of `messageSize` bytes from the input, as a parser with framed messages would,
+ * either through a view of the input or by copying into an allocated PARCBuffer.
+ */
+static void
+_pairReceive(PARCEventQueue *queue, PARCEventType type, void *userData)
+{
+    _PairReceiver *receiver = userData;
+    PARCEventBuffer *input = parcEventBuffer_GetQueueBufferInput(queue);
+
+    while (parcEventBuffer_GetLength(input) >= receiver->messageSize) {
+        PARCBuffer *message;
+        if (receiver->zeroCopy) {
+            message = parcEventBuffer_ReadPARCBuffer(input, receiver->messageSize);
+            receiver->views += (parcByteArray_Capacity(parcBuffer_Array(message)) == receiver->messageSize);
+        } else {
+            message = parcBuffer_Allocate(receiver->messageSize);
+            parcEventBuffer_Read(input, parcBuffer_Overlay(message, 0), receiver->messageSize);
+        }
+        receiver->received += parcBuffer_Remaining(message);
+        parcBuffer_Release(&message);
+    }
+
+    parcEventBuffer_Destroy(&input);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventBuffer_ReadPARCBuffer_ConnectedPair)
+{
+    PARCEventScheduler *parcEventScheduler = parcEventScheduler_Create();
+    PARCEventQueuePair *pair = parcEventQueue_CreateConnectedPair(parcEventScheduler);
+
+    _PairReceiver receiver = { .zeroCopy = true, .messageSize = _dataLength };
+    PARCEventQueue *down = parcEventQueue_GetConnectedDownQueue(pair);
+    parcEventQueue_SetCallbacks(down, _pairReceive, NULL, NULL, &receiver);
+    parcEventQueue_Enable(down, PARCEventType_Read);
+
+    PARCEventBuffer *output = parcEventBuffer_GetQueueBufferOutput(parcEventQueue_GetConnectedUpQueue(pair));
+    PARCBuffer *message = _sequence(_dataLength, 0);
+    for (int i = 0; i < 4; i++) {
+        parcEventBuffer_AppendPARCBuffer(output, message);
+    }
+    parcEventScheduler_Start(parcEventScheduler, PARCEventSchedulerDispatchType_NonBlocking);
+
+    assertTrue(receiver.received == 4 * (size_t) _dataLength, "Expected %d bytes, received %zu", 4 * _dataLength, receiver.received);
+    assertTrue(receiver.views > 0, "Expected the receiver to get views of the sent PARCBuffers");
+
+    parcEventBuffer_Destroy(&output);
+    parcEventQueue_DestroyConnectedPair(&pair);
+    parcEventScheduler_Destroy(&parcEventScheduler);
+    assertTrue(parcObject_GetReferenceCount(message) == 1, "Expected every reference to the sent PARCBuffer to be released");
+    parcBuffer_Release(&message);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parc_EventBuffer_ConnectedPairThroughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _ThroughputBytes (1024UL * 1024 * 1024)
+
+/*
+ * Send _ThroughputBytes through a connected PARCEventQueue pair in messages of the given size,
+ * either copying the bytes in and out of the event buffers, or passing them as PARCBuffers by reference.
+ */
+static double
+_pairThroughput(size_t messageSize, bool zeroCopy)
+{
+    PARCEventScheduler *parcEventScheduler = parcEventScheduler_Create();
+    PARCEventQueuePair *pair = parcEventQueue_CreateConnectedPair(parcEventScheduler);
+
+    _PairReceiver receiver = { .zeroCopy = zeroCopy, .messageSize = messageSize };
+    PARCEventQueue *down = parcEventQueue_GetConnectedDownQueue(pair);
+    parcEventQueue_SetCallbacks(down, _pairReceive, NULL, NULL, &receiver);
+    parcEventQueue_Enable(down, PARCEventType_Read);
+
+    PARCEventBuffer *output = parcEventBuffer_GetQueueBufferOutput(parcEventQueue_GetConnectedUpQueue(pair));
+    PARCBuffer *message = _sequence(messageSize, 0);
+    size_t messages = _ThroughputBytes / messageSize;
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (size_t i = 0; i < messages; i++) {
+        if (zeroCopy) {
+            parcEventBuffer_AppendPARCBuffer(output, message);
+        } else {
+            parcEventBuffer_Append(output, parcBuffer_Overlay(message, 0), messageSize);
+        }
+        if ((i & 63) == 63) {
+            parcEventScheduler_Start(parcEventScheduler, PARCEventSchedulerDispatchType_NonBlocking);
+        }
+    }
+    while (receiver.received < messages * messageSize) {
+        parcEventScheduler_Start(parcEventScheduler, PARCEventSchedulerDispatchType_NonBlocking);
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    parcBuffer_Release(&message);
+    parcEventBuffer_Destroy(&output);
+    parcEventQueue_DestroyConnectedPair(&pair);
+    parcEventScheduler_Destroy(&parcEventScheduler);
+
+    return ((double) receiver.received / (1024.0 * 1024.0)) / ((double) elapsed / 1e9);
+}
+
+LONGBOW_TEST_CASE(Performance, parc_EventBuffer_ConnectedPairThroughput)
+{
+    size_t sizes[] = { 64, 256, 512, 1024, 4096, 16384, 65536 };
+
+    printf("connected pair throughput, %lu MiB per run\n", _ThroughputBytes / (1024 * 1024));
+    printf("  %8s %12s %12s\n", "message", "copy MiB/s", "ref MiB/s");
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        double copy = _pairThroughput(sizes[i], false);
+        double reference = _pairThroughput(sizes[i], true);
+        printf("  %8zu %12.0f %12.0f\n", sizes[i], copy, reference);
+    }
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -0,0 +1,653 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+
+#include <LongBow/unit-test.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../parc_EventIOEngine.c"
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_EventIOEngine)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_EventIOEngine)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_EventIOEngine)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_GetBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Send_Receive);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Receive_BeforeSend);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Receive_Shutdown);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Write_Read);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Read_BadFileDescriptor);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Depth);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventIOEngine_Destroy_Outstanding);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Each test runs against the io_uring engine (where the platform has one) and the fallback engine.
+ */
+typedef struct {
+    PARCEventScheduler *scheduler;
+    PARCBufferPool *pool;
+    PARCEventIOEngine *engine;
+    PARCEventTimer *timeout;
+
+    unsigned completions;
+    unsigned expected;
+    ssize_t results[8];
+    char data[8][64];
+} _TestEngine;
+
+static void
+_testTimeout(int fd, PARCEventType type, void *userData)
+{
+    _TestEngine *test = userData;
+    parcEventScheduler_Abort(test->scheduler);
+}
+
+static void
+_testEngine_Init(_TestEngine *test, bool useRing, size_t depth)
+{
+    memset(test, 0, sizeof(*test));
+    test->scheduler = parcEventScheduler_Create();
+    test->pool = parcBufferPool_Create(depth, 64);
+    test->engine = _parcEventIOEngine_Create(test->scheduler, test->pool, depth, useRing);
+    test->timeout = parcEventTimer_Create(test->scheduler, PARCEventType_None, _testTimeout, test);
+}
+
+static void
+_testEngine_Fini(_TestEngine *test)
+{
+    parcEventTimer_Destroy(&test->timeout);
+    parcEventIOEngine_Destroy(&test->engine);
+    parcBufferPool_Release(&test->pool);
+    parcEventScheduler_Destroy(&test->scheduler);
+}
+
+/**
+ * Submit and dispatch until `expected` completions have been delivered or a second has passed.
+ */
+static void
+_testEngine_Run(_TestEngine *test, unsigned expected)
+{
+    test->expected = expected;
+    parcEventIOEngine_Submit(test->engine);
+
+    struct timeval second = { 1, 0 };
+    parcEventTimer_Start(test->timeout, &second);
+    if (test->completions < test->expected) {
+        parcEventScheduler_Start(test->scheduler, PARCEventSchedulerDispatchType_Blocking);
+    }
+    parcEventTimer_Stop(test->timeout);
+}
+
+static void
+_testCompleted(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData)
+{
+    _TestEngine *test = userData;
+
+    unsigned index = test->completions++;
+    test->results[index] = result;
+    parcBuffer_Flip(buffer);
+    size_t length = parcBuffer_Remaining(buffer) < sizeof(test->data[index]) - 1 ? parcBuffer_Remaining(buffer) : sizeof(test->data[index]) - 1;
+    parcBuffer_GetBytes(buffer, length, (uint8_t *) test->data[index]);
+
+    if (test->completions == test->expected) {
+        parcEventScheduler_Abort(test->scheduler);
+    }
+}
+
+static PARCBuffer *
+_testEngine_Message(_TestEngine *test, const char *message)
+{
+    PARCBuffer *buffer = parcEventIOEngine_GetBuffer(test->engine);
+    parcBuffer_PutArray(buffer, strlen(message), (const uint8_t *) message);
+    return parcBuffer_Flip(buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Create_Destroy)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        assertTrue(parcEventIOEngine_IsAsynchronous(test.engine) == (useRing && test.engine->isAsynchronous),
+                   "Expected the fallback engine never to be asynchronous");
+        if (!useRing) {
+            assertFalse(parcEventIOEngine_IsAsynchronous(test.engine), "Expected a fallback engine");
+        }
+        assertTrue(parcEventIOEngine_GetOutstanding(test.engine) == 0, "Expected no outstanding requests");
+
+        _testEngine_Fini(&test);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_GetBuffer)
+{
+    _TestEngine test;
+    _testEngine_Init(&test, true, 2);
+
+    PARCBuffer *first = parcEventIOEngine_GetBuffer(test.engine);
+    PARCBuffer *second = parcEventIOEngine_GetBuffer(test.engine);
+    PARCBuffer *third = parcEventIOEngine_GetBuffer(test.engine);
+
+    assertTrue(first == test.engine->registered[0] || first == test.engine->registered[1], "Expected a registered buffer");
+    assertTrue(second == test.engine->registered[0] || second == test.engine->registered[1], "Expected a registered buffer");
+    assertFalse(first == second, "Expected a registered buffer not to be handed out twice");
+    assertFalse(third == test.engine->registered[0] || third == test.engine->registered[1],
+                "Expected a pool buffer once the registered buffers are in use");
+    assertTrue(parcBuffer_Remaining(first) == 64, "Expected a cleared buffer");
+
+    parcBuffer_Release(&first);
+    PARCBuffer *again = parcEventIOEngine_GetBuffer(test.engine);
+    assertTrue(again == test.engine->registered[0] || again == test.engine->registered[1],
+               "Expected a released registered buffer to be reused");
+
+    // A pooled buffer is cleared however its last user left it.
+    parcBuffer_SetPosition(third, 10);
+    parcBuffer_Release(&third);
+    PARCBuffer *pooled = parcEventIOEngine_GetBuffer(test.engine);
+    assertTrue(parcBuffer_Remaining(pooled) == 64, "Expected a cleared pool buffer, got %zu remaining", parcBuffer_Remaining(pooled));
+
+    parcBuffer_Release(&pooled);
+    parcBuffer_Release(&again);
+    parcBuffer_Release(&second);
+    _testEngine_Fini(&test);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Send_Receive)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+
+        PARCBuffer *message = _testEngine_Message(&test, "hello");
+        PARCBuffer *input = parcEventIOEngine_GetBuffer(test.engine);
+
+        assertTrue(parcEventIOEngine_Send(test.engine, fds[0], message, _testCompleted, &test), "Expected the send to be queued");
+        _testEngine_Run(&test, 1);
+        assertTrue(test.results[0] == 5, "Expected 5 bytes sent, got %zd", test.results[0]);
+
+        assertTrue(parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test), "Expected the receive to be queued");
+        _testEngine_Run(&test, 2);
+        assertTrue(test.results[1] == 5, "Expected 5 bytes received, got %zd", test.results[1]);
+        assertTrue(strcmp(test.data[1], "hello") == 0, "Expected 'hello', got '%s'", test.data[1]);
+        assertTrue(parcEventIOEngine_GetOutstanding(test.engine) == 0, "Expected no outstanding requests");
+
+        parcBuffer_Release(&message);
+        parcBuffer_Release(&input);
+        close(fds[0]);
+        close(fds[1]);
+        _testEngine_Fini(&test);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Receive_BeforeSend)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+        // The receive waits for data; the send queued behind it supplies it.
+        PARCBuffer *input = parcEventIOEngine_GetBuffer(test.engine);
+        PARCBuffer *message = _testEngine_Message(&test, "later");
+        parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test);
+        parcEventIOEngine_Send(test.engine, fds[0], message, _testCompleted, &test);
+        _testEngine_Run(&test, 2);
+
+        assertTrue(test.completions == 2, "Expected 2 completions, got %u", test.completions);
+        bool received = strcmp(test.data[0], "later") == 0 || strcmp(test.data[1], "later") == 0;
+        assertTrue(received, "Expected 'later' to be received");
+
+        parcBuffer_Release(&message);
+        parcBuffer_Release(&input);
+        close(fds[0]);
+        close(fds[1]);
+        _testEngine_Fini(&test);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Receive_Shutdown)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        close(fds[0]);
+
+        PARCBuffer *input = parcEventIOEngine_GetBuffer(test.engine);
+        parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test);
+        _testEngine_Run(&test, 1);
+        assertTrue(test.results[0] == 0, "Expected 0 at end of stream, got %zd", test.results[0]);
+
+        parcBuffer_Release(&input);
+        close(fds[1]);
+        _testEngine_Fini(&test);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Write_Read)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        char path[] = "/tmp/test_parc_EventIOEngine_XXXXXX";
+        int fd = mkstemp(path);
+        unlink(path);
+
+        PARCBuffer *first = _testEngine_Message(&test, "first");
+        PARCBuffer *second = _testEngine_Message(&test, "second");
+        parcEventIOEngine_Write(test.engine, fd, 0, first, _testCompleted, &test);
+        parcEventIOEngine_Write(test.engine, fd, 5, second, _testCompleted, &test);
+        _testEngine_Run(&test, 2);
+        assertTrue(test.results[0] + test.results[1] == 11, "Expected 11 bytes written");
+        parcBuffer_Release(&first);
+        parcBuffer_Release(&second);
+
+        PARCBuffer *block = parcEventIOEngine_GetBuffer(test.engine);
+        PARCBuffer *tail = parcEventIOEngine_GetBuffer(test.engine);
+        parcEventIOEngine_Read(test.engine, fd, 0, block, _testCompleted, &test);
+        parcEventIOEngine_Read(test.engine, fd, 5, tail, _testCompleted, &test);
+        _testEngine_Run(&test, 4);
+        bool whole = strcmp(test.data[2], "firstsecond") == 0 || strcmp(test.data[3], "firstsecond") == 0;
+        bool part = strcmp(test.data[2], "second") == 0 || strcmp(test.data[3], "second") == 0;
+        assertTrue(whole && part, "Expected 'firstsecond' and 'second', got '%s' and '%s'", test.data[2], test.data[3]);
+
+        parcBuffer_Release(&block);
+        parcBuffer_Release(&tail);
+        close(fd);
+        _testEngine_Fini(&test);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Read_BadFileDescriptor)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        PARCBuffer *block = parcEventIOEngine_GetBuffer(test.engine);
+        parcEventIOEngine_Read(test.engine, 10000, 0, block, _testCompleted, &test);
+        _testEngine_Run(&test, 1);
+        assertTrue(test.results[0] == -EBADF, "Expected -EBADF, got %zd", test.results[0]);
+
+        parcBuffer_Release(&block);
+        _testEngine_Fini(&test);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Depth)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 2);
+
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+
+        PARCBuffer *input = parcEventIOEngine_GetBuffer(test.engine);
+        assertTrue(parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test), "Expected request 1 to be queued");
+        assertTrue(parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test), "Expected request 2 to be queued");
+        assertFalse(parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test), "Expected request 3 to be refused");
+        assertTrue(parcEventIOEngine_GetOutstanding(test.engine) == 2, "Expected 2 outstanding requests");
+
+        parcBuffer_Release(&input);
+        _testEngine_Fini(&test);
+        close(fds[0]);
+        close(fds[1]);
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcEventIOEngine_Destroy_Outstanding)
+{
+    for (int useRing = 0; useRing < 2; useRing++) {
+        _TestEngine test;
+        _testEngine_Init(&test, useRing, 4);
+
+        int fds[2];
+        socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        fcntl(fds[1], F_SETFL, O_NONBLOCK);
+
+        PARCBuffer *input = parcEventIOEngine_GetBuffer(test.engine);
+        parcEventIOEngine_Receive(test.engine, fds[1], input, _testCompleted, &test);
+        parcBuffer_Release(&input);
+
+        // Nothing is ever sent, so the receive is still outstanding when the engine goes away.
+        parcEventIOEngine_Submit(test.engine);
+        parcEventScheduler_Start(test.scheduler, PARCEventSchedulerDispatchType_NonBlocking);
+        assertTrue(test.completions == 0, "Expected the receive not to complete");
+
+        _testEngine_Fini(&test);
+        close(fds[0]);
+        close(fds[1]);
+    }
+}
+
+// ===============================================================
+
+/*
+ * Loopback: a stream socket pair carries small messages, with `depth / 2` sends and receives kept in flight.
+ * File: a file is written and read back in blocks, with `depth` requests kept in flight.
+ * Both run on the io_uring engine and on the fallback engine and report system calls per request.
+ */
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcEventIOEngine_Loopback);
+    LONGBOW_RUN_TEST_CASE(Performance, parcEventIOEngine_File);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _BenchmarkDepth 32
+#define _LoopbackMessages 500000
+#define _LoopbackMessageLength 64
+#define _FileBlocks 4096
+#define _FileBlockLength 65536
+
+typedef struct {
+    PARCEventScheduler *scheduler;
+    PARCEventIOEngine *engine;
+    int fds[2];
+    int fd;
+    uint64_t requests;
+    uint64_t sent;
+    uint64_t received;
+    uint64_t next;
+    uint64_t done;
+    uint64_t total;
+} _Benchmark;
+
+static void _loopbackSent(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData);
+
+static void
+_loopbackSend(_Benchmark *benchmark)
+{
+    PARCBuffer *message = parcEventIOEngine_GetBuffer(benchmark->engine);
+    parcBuffer_SetLimit(message, _LoopbackMessageLength);
+    parcEventIOEngine_Send(benchmark->engine, benchmark->fds[0], message, _loopbackSent, benchmark);
+    parcBuffer_Release(&message);
+    benchmark->sent++;
+    benchmark->requests++;
+}
+
+static void
+_loopbackSent(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData)
+{
+    _Benchmark *benchmark = userData;
+    if (benchmark->sent < _LoopbackMessages) {
+        _loopbackSend(benchmark);
+    }
+}
+
+static void
+_loopbackReceived(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData)
+{
+    _Benchmark *benchmark = userData;
+    benchmark->received += (result > 0) ? result : 0;
+    if (benchmark->received >= (uint64_t) _LoopbackMessages * _LoopbackMessageLength) {
+        parcEventScheduler_Abort(benchmark->scheduler);
+        return;
+    }
+    PARCBuffer *input = parcEventIOEngine_GetBuffer(engine);
+    parcEventIOEngine_Receive(engine, benchmark->fds[1], input, _loopbackReceived, benchmark);
+    parcBuffer_Release(&input);
+    benchmark->requests++;
+}
+
+static void
+_loopback(bool useRing)
+{
+    _Benchmark benchmark;
+    memset(&benchmark, 0, sizeof(benchmark));
+    benchmark.scheduler = parcEventScheduler_Create();
+    PARCBufferPool *pool = parcBufferPool_Create(4 * _BenchmarkDepth, 2048);
+    benchmark.engine = _parcEventIOEngine_Create(benchmark.scheduler, pool, _BenchmarkDepth, useRing);
+    socketpair(AF_UNIX, SOCK_STREAM, 0, benchmark.fds);
+    fcntl(benchmark.fds[0], F_SETFL, O_NONBLOCK);
+    fcntl(benchmark.fds[1], F_SETFL, O_NONBLOCK);
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < _BenchmarkDepth / 2; i++) {
+        _loopbackSend(&benchmark);
+        PARCBuffer *input = parcEventIOEngine_GetBuffer(benchmark.engine);
+        parcEventIOEngine_Receive(benchmark.engine, benchmark.fds[1], input, _loopbackReceived, &benchmark);
+        parcBuffer_Release(&input);
+        benchmark.requests++;
+    }
+    parcEventIOEngine_Submit(benchmark.engine);
+    parcEventScheduler_Start(benchmark.scheduler, PARCEventSchedulerDispatchType_Blocking);
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    printf("  %-9s %10.0f messages/s  %5.2f engine syscalls per request\n",
+           parcEventIOEngine_IsAsynchronous(benchmark.engine) ? "io_uring" : "fallback",
+           (double) _LoopbackMessages / ((double) elapsed / 1e9),
+           (double) parcEventIOEngine_GetSystemCallCount(benchmark.engine) / benchmark.requests);
+
+    parcEventIOEngine_Destroy(&benchmark.engine);
+    parcBufferPool_Release(&pool);
+    close(benchmark.fds[0]);
+    close(benchmark.fds[1]);
+    parcEventScheduler_Destroy(&benchmark.scheduler);
+}
+
+static void _fileBlockDone(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData);
+
+static void
+_fileNext(_Benchmark *benchmark, bool write)
+{
+    if (benchmark->next >= _FileBlocks) {
+        return;
+    }
+    PARCBuffer *block = parcEventIOEngine_GetBuffer(benchmark->engine);
+    if (write) {
+        parcBuffer_SetPosition(block, 0);
+        parcEventIOEngine_Write(benchmark->engine, benchmark->fd, (off_t) benchmark->next * _FileBlockLength, block,
+                                _fileBlockDone, benchmark);
+    } else {
+        parcEventIOEngine_Read(benchmark->engine, benchmark->fd, (off_t) benchmark->next * _FileBlockLength, block,
+                               _fileBlockDone, benchmark);
+    }
+    parcBuffer_Release(&block);
+    benchmark->next++;
+    benchmark->requests++;
+}
+
+static bool _fileWriting;
+
+static void
+_fileBlockDone(PARCEventIOEngine *engine, PARCBuffer *buffer, ssize_t result, void *userData)
+{
+    _Benchmark *benchmark = userData;
+    assertTrue(result == _FileBlockLength, "Expected a whole block, got %zd", result);
+    if (++benchmark->done == _FileBlocks) {
+        parcEventScheduler_Abort(benchmark->scheduler);
+        return;
+    }
+    _fileNext(benchmark, _fileWriting);
+}
+
+static void
+_filePass(_Benchmark *benchmark, bool write)
+{
+    _fileWriting = write;
+    benchmark->next = 0;
+    benchmark->done = 0;
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < _BenchmarkDepth; i++) {
+        _fileNext(benchmark, write);
+    }
+    parcEventIOEngine_Submit(benchmark->engine);
+    parcEventScheduler_Start(benchmark->scheduler, PARCEventSchedulerDispatchType_Blocking);
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    printf("  %-9s %-5s %8.0f MB/s\n",
+           parcEventIOEngine_IsAsynchronous(benchmark->engine) ? "io_uring" : "fallback", write ? "write" : "read",
+           ((double) _FileBlocks * _FileBlockLength / (1024 * 1024)) / ((double) elapsed / 1e9));
+}
+
+static void
+_file(bool useRing)
+{
+    _Benchmark benchmark;
+    memset(&benchmark, 0, sizeof(benchmark));
+    benchmark.scheduler = parcEventScheduler_Create();
+    PARCBufferPool *pool = parcBufferPool_Create(2 * _BenchmarkDepth, _FileBlockLength);
+    benchmark.engine = _parcEventIOEngine_Create(benchmark.scheduler, pool, _BenchmarkDepth, useRing);
+
+    char path[] = "/tmp/test_parc_EventIOEngine_XXXXXX";
+    benchmark.fd = mkstemp(path);
+    unlink(path);
+
+    _filePass(&benchmark, true);
+    _filePass(&benchmark, false);
+    printf("  %-9s %5.2f engine syscalls per block\n",
+           parcEventIOEngine_IsAsynchronous(benchmark.engine) ? "io_uring" : "fallback",
+           (double) parcEventIOEngine_GetSystemCallCount(benchmark.engine) / benchmark.requests);
+
+    close(benchmark.fd);
+    parcEventIOEngine_Destroy(&benchmark.engine);
+    parcBufferPool_Release(&pool);
+    parcEventScheduler_Destroy(&benchmark.scheduler);
+}
+
+LONGBOW_TEST_CASE(Performance, parcEventIOEngine_Loopback)
+{
+    printf("loopback, %d messages of %d bytes, %d in flight\n", _LoopbackMessages, _LoopbackMessageLength, _BenchmarkDepth);
+    _loopback(false);
+    _loopback(true);
+}
+
+LONGBOW_TEST_CASE(Performance, parcEventIOEngine_File)
+{
+    printf("file, %d blocks of %d bytes, %d in flight\n", _FileBlocks, _FileBlockLength, _BenchmarkDepth);
+    _file(false);
+    _file(true);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_EventIOEngine);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,529 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <errno.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <unistd.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <LongBow/unit-test.h>
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../parc_EventSchedulerGroup.c"
+
+#include <parc/algol/parc_EventQueue.h>
+#include <parc/algol/parc_EventSocket.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_EventSchedulerGroup)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_EventSchedulerGroup)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_EventSchedulerGroup)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Create_Default);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_NextIndex);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Start_Stop);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch_BeforeStart);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch_Ordered);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch_FromLoop);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_DispatchWithDiscard);
+    LONGBOW_RUN_TEST_CASE(Global, parcEventSchedulerGroup_CurrentScheduler);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * Records the scheduler each task ran on, and lets the test thread wait for a number of tasks.
+ */
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+    unsigned count;
+    PARCEventScheduler *ranOn[1024];
+    unsigned sequence[1024];
+    PARCEventSchedulerGroup *group;
+} _TestTasks;
+
+static void
+_testTasks_Init(_TestTasks *tasks, PARCEventSchedulerGroup *group)
+{
+    memset(tasks, 0, sizeof(*tasks));
+    pthread_mutex_init(&tasks->lock, NULL);
+    pthread_cond_init(&tasks->done, NULL);
+    tasks->group = group;
+}
+
+static void
+_testTasks_Fini(_TestTasks *tasks)
+{
+    pthread_cond_destroy(&tasks->done);
+    pthread_mutex_destroy(&tasks->lock);
+}
+
+static void
+_testTasks_Record(_TestTasks *tasks, unsigned sequence)
+{
+    pthread_mutex_lock(&tasks->lock);
+    tasks->ranOn[tasks->count] = parcEventSchedulerGroup_CurrentScheduler();
+    tasks->sequence[tasks->count] = sequence;
+    tasks->count++;
+    pthread_cond_broadcast(&tasks->done);
+    pthread_mutex_unlock(&tasks->lock);
+}
+
+static bool
+_testTasks_WaitFor(_TestTasks *tasks, unsigned count)
+{
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += 5;
+
+    pthread_mutex_lock(&tasks->lock);
+    int result = 0;
+    while (tasks->count < count && result == 0) {
+        result = pthread_cond_timedwait(&tasks->done, &tasks->lock, &deadline);
+    }
+    bool reached = tasks->count >= count;
+    pthread_mutex_unlock(&tasks->lock);
+    return reached;
+}
+
+static _TestTasks _testTasks;
+
+static void
+_testTask(PARCEventScheduler *scheduler, void *userData)
+{
+    assertTrue(scheduler == parcEventSchedulerGroup_CurrentScheduler(),
+               "Expected the task to receive the scheduler of the loop it runs on");
+    _testTasks_Record(&_testTasks, (unsigned) (uintptr_t) userData);
+}
+
+static void
+_testForwardTask(PARCEventScheduler *scheduler, void *userData)
+{
+    size_t target = (size_t) (uintptr_t) userData;
+    parcEventSchedulerGroup_Dispatch(_testTasks.group, target, _testTask, userData);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Create_Destroy)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(3);
+    assertNotNull(group, "Expected a non-null group");
+    assertTrue(parcEventSchedulerGroup_GetSchedulerCount(group) == 3,
+               "Expected 3 schedulers, got %zu", parcEventSchedulerGroup_GetSchedulerCount(group));
+
+    for (size_t i = 0; i < 3; i++) {
+        PARCEventScheduler *scheduler = parcEventSchedulerGroup_GetScheduler(group, i);
+        assertNotNull(scheduler, "Expected a scheduler at index %zu", i);
+        for (size_t j = 0; j < i; j++) {
+            assertFalse(scheduler == parcEventSchedulerGroup_GetScheduler(group, j),
+                        "Expected distinct schedulers at %zu and %zu", i, j);
+        }
+    }
+
+    parcEventSchedulerGroup_Destroy(&group);
+    assertNull(group, "Expected the pointer to be NULL after destroy");
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Create_Default)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(0);
+
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t expected = (processors > 0) ? (size_t) processors : 1;
+    assertTrue(parcEventSchedulerGroup_GetSchedulerCount(group) == expected,
+               "Expected one scheduler per processor (%zu), got %zu",
+               expected, parcEventSchedulerGroup_GetSchedulerCount(group));
+
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_NextIndex)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(3);
+
+    for (size_t i = 0; i < 9; i++) {
+        size_t index = parcEventSchedulerGroup_NextIndex(group);
+        assertTrue(index == i % 3, "Expected index %zu, got %zu", i % 3, index);
+    }
+
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Start_Stop)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+
+    assertTrue(parcEventSchedulerGroup_Start(group), "Expected the first start to succeed");
+    assertFalse(parcEventSchedulerGroup_Start(group), "Expected a second start to fail");
+    parcEventSchedulerGroup_Stop(group);
+    parcEventSchedulerGroup_Stop(group);
+
+    assertTrue(parcEventSchedulerGroup_Start(group), "Expected a stopped group to restart");
+
+    // Destroy stops a running group.
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(3);
+    _testTasks_Init(&_testTasks, group);
+    parcEventSchedulerGroup_Start(group);
+
+    for (size_t i = 0; i < 3; i++) {
+        assertTrue(parcEventSchedulerGroup_Dispatch(group, i, _testTask, (void *) (uintptr_t) i),
+                   "Expected the task to be queued");
+    }
+    assertTrue(_testTasks_WaitFor(&_testTasks, 3), "Expected 3 tasks to run, got %u", _testTasks.count);
+
+    for (unsigned i = 0; i < 3; i++) {
+        size_t index = _testTasks.sequence[i];
+        assertTrue(_testTasks.ranOn[i] == parcEventSchedulerGroup_GetScheduler(group, index),
+                   "Expected the task for loop %zu to run on that loop", index);
+    }
+
+    parcEventSchedulerGroup_Stop(group);
+    _testTasks_Fini(&_testTasks);
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch_BeforeStart)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+    _testTasks_Init(&_testTasks, group);
+
+    parcEventSchedulerGroup_Dispatch(group, 1, _testTask, (void *) 1);
+    usleep(10000);
+    assertTrue(_testTasks.count == 0, "Expected no task to run before the group starts");
+
+    parcEventSchedulerGroup_Start(group);
+    assertTrue(_testTasks_WaitFor(&_testTasks, 1), "Expected the queued task to run once started");
+    assertTrue(_testTasks.ranOn[0] == parcEventSchedulerGroup_GetScheduler(group, 1),
+               "Expected the task to run on loop 1");
+
+    parcEventSchedulerGroup_Stop(group);
+    _testTasks_Fini(&_testTasks);
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch_Ordered)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+    _testTasks_Init(&_testTasks, group);
+    parcEventSchedulerGroup_Start(group);
+
+    for (unsigned i = 0; i < 1000; i++) {
+        parcEventSchedulerGroup_Dispatch(group, 1, _testTask, (void *) (uintptr_t) i);
+    }
+    assertTrue(_testTasks_WaitFor(&_testTasks, 1000), "Expected 1000 tasks to run, got %u", _testTasks.count);
+
+    for (unsigned i = 0; i < 1000; i++) {
+        assertTrue(_testTasks.sequence[i] == i, "Expected task %u at position %u, got %u", i, i, _testTasks.sequence[i]);
+    }
+
+    parcEventSchedulerGroup_Stop(group);
+    _testTasks_Fini(&_testTasks);
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_Dispatch_FromLoop)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+    _testTasks_Init(&_testTasks, group);
+    parcEventSchedulerGroup_Start(group);
+
+    // Loop 0 hands the task to loop 1, and loop 1 to itself.
+    parcEventSchedulerGroup_Dispatch(group, 0, _testForwardTask, (void *) 1);
+    parcEventSchedulerGroup_Dispatch(group, 1, _testForwardTask, (void *) 1);
+    assertTrue(_testTasks_WaitFor(&_testTasks, 2), "Expected 2 forwarded tasks to run, got %u", _testTasks.count);
+
+    for (unsigned i = 0; i < 2; i++) {
+        assertTrue(_testTasks.ranOn[i] == parcEventSchedulerGroup_GetScheduler(group, 1),
+                   "Expected forwarded task %u to run on loop 1", i);
+    }
+
+    parcEventSchedulerGroup_Stop(group);
+    _testTasks_Fini(&_testTasks);
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+static void
+_testDiscard(void *userData)
+{
+    unsigned *discarded = userData;
+    (*discarded)++;
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_DispatchWithDiscard)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+    _testTasks_Init(&_testTasks, group);
+    unsigned discarded = 0;
+
+    parcEventSchedulerGroup_Start(group);
+    assertTrue(parcEventSchedulerGroup_DispatchWithDiscard(group, 1, _testTask, _testDiscard, (void *) 1),
+               "Expected the task to be queued");
+    assertTrue(_testTasks_WaitFor(&_testTasks, 1), "Expected the task to run");
+    parcEventSchedulerGroup_Stop(group);
+
+    // Queued on a stopped loop: the group is destroyed before it can run.
+    assertTrue(parcEventSchedulerGroup_DispatchWithDiscard(group, 0, _testTask, _testDiscard, &discarded),
+               "Expected the task to be queued");
+    parcEventSchedulerGroup_Dispatch(group, 1, _testTask, (void *) 1);
+
+    _testTasks_Fini(&_testTasks);
+    parcEventSchedulerGroup_Destroy(&group);
+    assertTrue(discarded == 1, "Expected the queued task to be discarded once, got %u", discarded);
+}
+
+LONGBOW_TEST_CASE(Global, parcEventSchedulerGroup_CurrentScheduler)
+{
+    assertNull(parcEventSchedulerGroup_CurrentScheduler(), "Expected NULL outside of a loop thread");
+}
+
+/*
+ * Loopback echo benchmark.
+ *
+ * Each client thread opens its own connection and runs request/response round trips of a small message.
+ * The server side accepts through a distributed PARCEventSocket and echoes from a PARCEventQueue
+ * on whichever loop owns the connection.
+ */
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcEventSchedulerGroup_Echo);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _EchoClients 8
+#define _EchoRoundTrips 20000
+#define _EchoMessageLength 64
+
+static volatile unsigned _echoOpen;
+
+static void
+_echoRead(PARCEventQueue *queue, PARCEventType type, void *userData)
+{
+    uint8_t buffer[4096];
+    int length;
+    while ((length = parcEventQueue_Read(queue, buffer, sizeof(buffer))) > 0) {
+        parcEventQueue_Write(queue, buffer, length);
+    }
+}
+
+static void
+_echoEvent(PARCEventQueue *queue, PARCEventQueueEventType type, void *userData)
+{
+    if (type & (PARCEventQueueEventType_EOF | PARCEventQueueEventType_Error)) {
+        parcEventQueue_Destroy(&queue);
+        __sync_sub_and_fetch(&_echoOpen, 1);
+    }
+}
+
+static void
+_echoAccept(int fd, struct sockaddr *address, int socklen, void *userData)
+{
+    PARCEventQueue *queue = parcEventQueue_Create(parcEventSchedulerGroup_CurrentScheduler(), fd,
+                                                  PARCEventQueueOption_CloseOnFree);
+    parcEventQueue_SetCallbacks(queue, _echoRead, NULL, _echoEvent, NULL);
+    parcEventQueue_Enable(queue, PARCEventType_Read);
+    __sync_add_and_fetch(&_echoOpen, 1);
+}
+
+static void *
+_echoClient(void *arg)
+{
+    struct sockaddr_in *server = arg;
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    int failure = connect(fd, (struct sockaddr *) server, sizeof(*server));
+    assertFalse(failure, "connect failed: %s", strerror(errno));
+
+    uint8_t message[_EchoMessageLength];
+    memset(message, 'e', sizeof(message));
+    for (unsigned i = 0; i < _EchoRoundTrips; i++) {
+        ssize_t written = write(fd, message, sizeof(message));
+        assertTrue(written == sizeof(message), "short write");
+        size_t received = 0;
+        while (received < sizeof(message)) {
+            ssize_t n = read(fd, message + received, sizeof(message) - received);
+            assertTrue(n > 0, "read failed: %s", strerror(errno));
+            received += n;
+        }
+    }
+    close(fd);
+    return NULL;
+}
+
+static double
+_echoRun(size_t loops, PARCEventSocketDistribution distribution)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(loops);
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+
+    PARCEventSocket *listener = parcEventSocket_CreateDistributed(group, distribution, _echoAccept, NULL, NULL,
+                                                                  (struct sockaddr *) &addr, sizeof(addr));
+    assertNotNull(listener, "parcEventSocket_CreateDistributed failed");
+
+    socklen_t addrLength = sizeof(addr);
+    getsockname(parcEventSocket_GetFileDescriptor(listener), (struct sockaddr *) &addr, &addrLength);
+
+    parcEventSchedulerGroup_Start(group);
+
+    pthread_t clients[_EchoClients];
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < _EchoClients; i++) {
+        pthread_create(&clients[i], NULL, _echoClient, &addr);
+    }
+    for (int i = 0; i < _EchoClients; i++) {
+        pthread_join(clients[i], NULL);
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    while (_echoOpen > 0) {
+        usleep(1000);
+    }
+    parcEventSchedulerGroup_Stop(group);
+    parcEventSocket_Destroy(&listener);
+    parcEventSchedulerGroup_Destroy(&group);
+
+    return (double) (_EchoClients * _EchoRoundTrips) / ((double) elapsed / 1e9);
+}
+
+LONGBOW_TEST_CASE(Performance, parcEventSchedulerGroup_Echo)
+{
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+
+    printf("%d clients x %d round trips of %d bytes, %ld processors\n",
+           _EchoClients, _EchoRoundTrips, _EchoMessageLength, processors);
+    printf("  1 loop                  %10.0f round trips/s\n",
+           _echoRun(1, PARCEventSocketDistribution_RoundRobin));
+    printf("  %2ld loops, round-robin   %10.0f round trips/s\n", processors,
+           _echoRun((size_t) processors, PARCEventSocketDistribution_RoundRobin));
+    printf("  %2ld loops, SO_REUSEPORT  %10.0f round trips/s\n", processors,
+           _echoRun((size_t) processors, PARCEventSocketDistribution_ReusePort));
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_EventSchedulerGroup);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
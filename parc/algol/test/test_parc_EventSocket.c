@@ -55,6 +55,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <pthread.h>
+#include <unistd.h>
 
 #include <arpa/inet.h>
 
@@ -92,6 +93,8 @@ LONGBOW_TEST_RUNNER_TEARDOWN(parc_EventSocket)
 LONGBOW_TEST_FIXTURE(Global)
 {
     LONGBOW_RUN_TEST_CASE(Global, parc_EventSocket_Create_Destroy);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventSocket_CreateDistributed_RoundRobin);
+    LONGBOW_RUN_TEST_CASE(Global, parc_EventSocket_CreateDistributed_ReusePort);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -157,6 +160,101 @@ LONGBOW_TEST_CASE(Global, parc_EventSocket_Create_Destroy)
     parcEventScheduler_Destroy(&parcEventScheduler);
 }
 
+/*
+ * Accept callback for distributed sockets: records the loop each connection was accepted on.
+ */
+#define _DistributedConnections 4
+
+static volatile unsigned _distributedAccepted;
+static PARCEventScheduler *_distributedAcceptedOn[_DistributedConnections];
+
+static void
+_distributed_callback(int fd, struct sockaddr *sa, int socklen, void *user_data)
+{
+    unsigned index = __sync_fetch_and_add(&_distributedAccepted, 1);
+    if (index < _DistributedConnections) {
+        _distributedAcceptedOn[index] = parcEventSchedulerGroup_CurrentScheduler();
+    }
+    close(fd);
+}
+
+static void
+_connectDistributed(PARCEventSchedulerGroup *group, PARCEventSocketDistribution distribution)
+{
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    inet_pton(AF_INET, "127.0.0.1", &(addr.sin_addr));
+
+    PARCEventSocket *parcEventSocket = parcEventSocket_CreateDistributed(group, distribution,
+                                                                         _distributed_callback, listener_error_callback,
+                                                                         NULL, (struct sockaddr *) &addr, sizeof(addr));
+    assertNotNull(parcEventSocket, "parcEventSocket_CreateDistributed returned a null reference");
+
+    socklen_t addrLength = sizeof(addr);
+    getsockname(parcEventSocket_GetFileDescriptor(parcEventSocket), (struct sockaddr *) &addr, &addrLength);
+    assertTrue(addr.sin_port != 0, "Expected an ephemeral port to be bound");
+
+    _distributedAccepted = 0;
+    memset(_distributedAcceptedOn, 0, sizeof(_distributedAcceptedOn));
+    parcEventSchedulerGroup_Start(group);
+
+    for (int i = 0; i < _DistributedConnections; i++) {
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        int failure = connect(fd, (struct sockaddr *) &addr, sizeof(addr));
+        assertFalse(failure, "connect failed: %s", strerror(errno));
+        close(fd);
+    }
+    for (int wait = 0; wait < 500 && _distributedAccepted < _DistributedConnections; wait++) {
+        usleep(10000);
+    }
+
+    parcEventSchedulerGroup_Stop(group);
+    parcEventSocket_Destroy(&parcEventSocket);
+
+    assertTrue(_distributedAccepted == _DistributedConnections,
+               "Expected %d connections to be accepted, got %u", _DistributedConnections, _distributedAccepted);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventSocket_CreateDistributed_RoundRobin)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+
+    _connectDistributed(group, PARCEventSocketDistribution_RoundRobin);
+
+    // Connections are handed to loops 0, 1, 0, 1 in accept order, so each loop owns half of them.
+    int onFirstLoop = 0;
+    for (int i = 0; i < _DistributedConnections; i++) {
+        if (_distributedAcceptedOn[i] == parcEventSchedulerGroup_GetScheduler(group, 0)) {
+            onFirstLoop++;
+        } else {
+            assertTrue(_distributedAcceptedOn[i] == parcEventSchedulerGroup_GetScheduler(group, 1),
+                       "Expected connection %d to be handed to a loop of the group", i);
+        }
+    }
+    assertTrue(onFirstLoop == _DistributedConnections / 2,
+               "Expected %d connections on loop 0, got %d", _DistributedConnections / 2, onFirstLoop);
+
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
+LONGBOW_TEST_CASE(Global, parc_EventSocket_CreateDistributed_ReusePort)
+{
+    PARCEventSchedulerGroup *group = parcEventSchedulerGroup_Create(2);
+
+    _connectDistributed(group, PARCEventSocketDistribution_ReusePort);
+
+    // The kernel picks the listener, so only check that every connection was accepted on a loop of the group.
+    for (int i = 0; i < _DistributedConnections; i++) {
+        assertTrue(_distributedAcceptedOn[i] == parcEventSchedulerGroup_GetScheduler(group, 0)
+                   || _distributedAcceptedOn[i] == parcEventSchedulerGroup_GetScheduler(group, 1),
+                   "Expected connection %d to be accepted on a loop of the group", i);
+    }
+
+    parcEventSchedulerGroup_Destroy(&group);
+}
+
 int
 main(int argc, char *argv[])
 {
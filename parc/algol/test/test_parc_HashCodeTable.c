@@ -68,6 +68,7 @@
 #include "../parc_HashCodeTable.c"
 
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Time.h>
 
 // ==============================
 // The objects to put in the hash table.  We have a separate key class and data class
@@ -123,6 +124,7 @@ LONGBOW_TEST_RUNNER(parc_HashCodeTable)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -148,6 +150,11 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcHashCodeTable_Add_DuplicateValues);
 
     LONGBOW_RUN_TEST_CASE(Global, parcHashCodeTable_BigTable);
+
+    LONGBOW_RUN_TEST_CASE(Global, parcHashCodeTable_Add_ManyIdenticalHashes);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashCodeTable_Del_MiddleOfRun);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashCodeTable_Add_WhileExpanding);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashCodeTable_GetStatistics);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -406,9 +413,144 @@ LONGBOW_TEST_CASE(Global, parcHashCodeTable_BigTable)
     printf("destroy sec = %.3f, sec/add = %.9f\n", sec, sec / loops);
 }
 
+LONGBOW_TEST_CASE(Global, parcHashCodeTable_Add_ManyIdenticalHashes)
+{
+    // More entries with the same hash code than the old probe limit allowed, in a table too small to hold them.
+    const unsigned count = 100;
+    PARCHashCodeTable *table = parcHashCodeTable_Create_Size(TestKeyClass_Equals, TestKeyClass_Hash, NULL, NULL, 16);
+
+    TestKeyClass keys[count];
+    for (unsigned i = 0; i < count; i++) {
+        keys[i] = (TestKeyClass) { .key_value = i, .hash_value = 42 };
+        bool success = parcHashCodeTable_Add(table, &keys[i], &keys[i]);
+        assertTrue(success, "Failed to add key %u", i);
+    }
+    assertTrue(parcHashCodeTable_Length(table) == count, "Expected %u entries, got %zu", count, parcHashCodeTable_Length(table));
+
+    for (unsigned i = 0; i < count; i++) {
+        assertTrue(parcHashCodeTable_Get(table, &keys[i]) == &keys[i], "Wrong value for key %u", i);
+    }
+
+    TestKeyClass missing = { .key_value = count, .hash_value = 42 };
+    assertNull(parcHashCodeTable_Get(table, &missing), "Expected a missing key to return NULL");
+
+    parcHashCodeTable_Destroy(&table);
+}
+
+LONGBOW_TEST_CASE(Global, parcHashCodeTable_Del_MiddleOfRun)
+{
+    PARCHashCodeTable *table = parcHashCodeTable_Create(TestKeyClass_Equals, TestKeyClass_Hash, NULL, NULL);
+
+    // Two interleaved runs of colliding hash codes, so deletion has to shift entries of both back.
+    const unsigned count = 20;
+    TestKeyClass keys[count];
+    for (unsigned i = 0; i < count; i++) {
+        keys[i] = (TestKeyClass) { .key_value = i, .hash_value = 7 + (i % 2) };
+        parcHashCodeTable_Add(table, &keys[i], &keys[i]);
+    }
+
+    for (unsigned i = 0; i < count; i += 3) {
+        parcHashCodeTable_Del(table, &keys[i]);
+    }
+
+    for (unsigned i = 0; i < count; i++) {
+        void *expected = (i % 3 == 0) ? NULL : &keys[i];
+        assertTrue(parcHashCodeTable_Get(table, &keys[i]) == expected, "Wrong value for key %u after deletion", i);
+    }
+
+    PARCHashCodeTableStatistics statistics;
+    parcHashCodeTable_GetStatistics(table, &statistics);
+    assertTrue(statistics.length == count - 7, "Expected %u entries, got %zu", count - 7, statistics.length);
+    assertTrue(statistics.maximumProbeLength <= statistics.length,
+               "Expected the runs to have been compacted, longest probe %zu", statistics.maximumProbeLength);
+
+    parcHashCodeTable_Destroy(&table);
+}
+
+LONGBOW_TEST_CASE(Global, parcHashCodeTable_Add_WhileExpanding)
+{
+    PARCHashCodeTable *table = parcHashCodeTable_Create_Size(TestKeyClass_Equals, TestKeyClass_Hash, TestKeyClassDestroy, TestDataClassDestroy, 16);
+
+    const unsigned count = 2000;
+    bool sawExpanding = false;
+    for (unsigned i = 0; i < count; i++) {
+        TestKeyClass *key = parcMemory_AllocateAndClear(sizeof(TestKeyClass));
+        TestDataClass *data = parcMemory_AllocateAndClear(sizeof(TestDataClass));
+        *key = (TestKeyClass) { .key_value = i, .hash_value = i * 31 };
+        data->data_value = i;
+        assertTrue(parcHashCodeTable_Add(table, key, data), "Failed to add key %u", i);
+
+        // Deleting from the draining table must work as well.
+        if (i % 5 == 4) {
+            TestKeyClass lookupkey = { .key_value = i - 4, .hash_value = (i - 4) * 31 };
+            parcHashCodeTable_Del(table, &lookupkey);
+        }
+
+        // Every key added and not deleted so far must be reachable, wherever it currently lives.
+        if (_isExpanding(table)) {
+            sawExpanding = true;
+            for (unsigned j = 0; j <= i; j++) {
+                TestKeyClass lookupkey = { .key_value = j, .hash_value = j * 31 };
+                TestDataClass *found = parcHashCodeTable_Get(table, &lookupkey);
+                if (j % 5 == 0 && j + 4 <= i) {
+                    assertNull(found, "Key %u present after deletion", j);
+                } else {
+                    assertNotNull(found, "Key %u missing while expanding after adding %u", j, i);
+                    assertTrue(found->data_value == j, "Wrong value for key %u", j);
+                }
+            }
+        }
+    }
+    assertTrue(sawExpanding, "Expected the table to have been observed part way through an expansion");
+    assertTrue(parcHashCodeTable_Length(table) == count - count / 5,
+               "Expected %u entries, got %zu", count - count / 5, parcHashCodeTable_Length(table));
+
+    for (unsigned i = 0; i < count; i++) {
+        TestKeyClass lookupkey = { .key_value = i, .hash_value = i * 31 };
+        TestDataClass *found = parcHashCodeTable_Get(table, &lookupkey);
+        if (i % 5 == 0) {
+            assertNull(found, "Expected key %u to have been deleted", i);
+        } else {
+            assertNotNull(found, "Key %u missing", i);
+        }
+    }
+
+    // Destroy must release the entries of both tables.
+    parcHashCodeTable_Destroy(&table);
+}
+
+LONGBOW_TEST_CASE(Global, parcHashCodeTable_GetStatistics)
+{
+    PARCHashCodeTable *table = parcHashCodeTable_Create_Size(TestKeyClass_Equals, TestKeyClass_Hash, NULL, NULL, 16);
+
+    PARCHashCodeTableStatistics statistics;
+    parcHashCodeTable_GetStatistics(table, &statistics);
+    assertTrue(statistics.length == 0, "Expected 0 entries, got %zu", statistics.length);
+    assertTrue(statistics.capacity == 16, "Expected 16 slots, got %zu", statistics.capacity);
+    assertTrue(statistics.maximumProbeLength == 0, "Expected no probes, got %zu", statistics.maximumProbeLength);
+    assertTrue(statistics.meanProbeLength == 0.0, "Expected no probes, got %f", statistics.meanProbeLength);
+
+    TestKeyClass keys[4];
+    for (unsigned i = 0; i < 4; i++) {
+        keys[i] = (TestKeyClass) { .key_value = i, .hash_value = 99 };
+        parcHashCodeTable_Add(table, &keys[i], &keys[i]);
+    }
+
+    // Four colliding entries occupy consecutive slots with probe lengths 1, 2, 3 and 4.
+    parcHashCodeTable_GetStatistics(table, &statistics);
+    assertTrue(statistics.length == 4, "Expected 4 entries, got %zu", statistics.length);
+    assertTrue(statistics.loadFactor == 0.25, "Expected a load factor of 0.25, got %f", statistics.loadFactor);
+    assertTrue(statistics.maximumProbeLength == 4, "Expected a longest probe of 4, got %zu", statistics.maximumProbeLength);
+    assertTrue(statistics.meanProbeLength == 2.5, "Expected a mean probe of 2.5, got %f", statistics.meanProbeLength);
+    assertTrue(statistics.expandCount == 0, "Expected no expansions, got %u", statistics.expandCount);
+    assertFalse(statistics.expanding, "Expected no expansion in progress");
+
+    parcHashCodeTable_Destroy(&table);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
-    LONGBOW_RUN_TEST_CASE(Local, _findIndex);
+    LONGBOW_RUN_TEST_CASE(Local, _find);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -425,7 +567,7 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
-LONGBOW_TEST_CASE(Local, _findIndex)
+LONGBOW_TEST_CASE(Local, _find)
 {
     PARCHashCodeTable *table = parcHashCodeTable_Create(TestKeyClass_Equals, TestKeyClass_Hash, TestKeyClassDestroy, TestDataClassDestroy);
 
@@ -439,19 +581,124 @@ LONGBOW_TEST_CASE(Local, _findIndex)
     key->hash_value = 37;
     data->data_value = 7;
 
-    table->hashtable.entries[37].key = key;
-    table->hashtable.entries[37].hashcode = key->hash_value;
-    table->hashtable.entries[37].data = data;
+    size_t home = _homeIndex(&table->hashtable, key->hash_value);
+    table->hashtable.entries[home].key = key;
+    table->hashtable.entries[home].hashcode = key->hash_value;
+    table->hashtable.entries[home].data = data;
+    table->hashtable.tableSize = 1;
 
     size_t index;
-    bool success = _findIndex(table, key, &index);
-    assertTrue(success, "FindIndex did not find known value");
-    assertTrue(index == 37, "FindIndex returned wrong value");
+    bool success = _find(table, key->hash_value, key, &index) == &table->hashtable;
+    assertTrue(success, "_find did not find known value");
+    assertTrue(index == home, "_find returned wrong value");
+
+
+    parcHashCodeTable_Destroy(&table);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcHashCodeTable_HashCodePatterns);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _PatternKeys 65536
+
+typedef enum {
+    _Pattern_Random,
+    _Pattern_Sequential,
+    _Pattern_Clustered,
+    _Pattern_Strided
+} _Pattern;
+
+static const char *_patternNames[] = { "random", "sequential", "runs of 8", "stride 4096" };
 
+static unsigned
+_patternHashCode(_Pattern pattern, unsigned i, uint64_t *random)
+{
+    switch (pattern) {
+        case _Pattern_Random:
+            *random ^= *random << 13;
+            *random ^= *random >> 7;
+            *random ^= *random << 17;
+            return (unsigned) *random;
+        case _Pattern_Sequential:
+            return i;
+        case _Pattern_Clustered:
+            return i / 8;
+        case _Pattern_Strided:
+            return i << 12;
+    }
+    return 0;
+}
+
+static void
+_measurePattern(_Pattern pattern)
+{
+    static TestKeyClass keys[_PatternKeys];
+    uint64_t random = 88172645463325252ULL;
+    for (unsigned i = 0; i < _PatternKeys; i++) {
+        keys[i] = (TestKeyClass) { .key_value = i, .hash_value = _patternHashCode(pattern, i, &random) };
+    }
+
+    PARCHashCodeTable *table = parcHashCodeTable_Create(TestKeyClass_Equals, TestKeyClass_Hash, NULL, NULL);
+
+    uint64_t worstAdd = 0;
+    uint64_t start = parcTime_NowNanoseconds();
+    for (unsigned i = 0; i < _PatternKeys; i++) {
+        uint64_t addStart = parcTime_NowNanoseconds();
+        parcHashCodeTable_Add(table, &keys[i], &keys[i]);
+        uint64_t addTime = parcTime_NowNanoseconds() - addStart;
+        if (addTime > worstAdd) {
+            worstAdd = addTime;
+        }
+    }
+    uint64_t addNanoseconds = parcTime_NowNanoseconds() - start;
+
+    start = parcTime_NowNanoseconds();
+    for (unsigned i = 0; i < _PatternKeys; i++) {
+        assertTrue(parcHashCodeTable_Get(table, &keys[i]) == &keys[i], "Expected to find key %u", i);
+    }
+    uint64_t getNanoseconds = parcTime_NowNanoseconds() - start;
+
+    PARCHashCodeTableStatistics statistics;
+    parcHashCodeTable_GetStatistics(table, &statistics);
+
+    start = parcTime_NowNanoseconds();
+    for (unsigned i = 0; i < _PatternKeys; i++) {
+        parcHashCodeTable_Del(table, &keys[i]);
+    }
+    uint64_t delNanoseconds = parcTime_NowNanoseconds() - start;
+    assertTrue(parcHashCodeTable_Length(table) == 0, "Expected an empty table");
+
+    printf(" %8.0f %8.0f %8.0f %10.1f %10zu %6u %8.2f %8zu\n",
+           (double) addNanoseconds / _PatternKeys, (double) getNanoseconds / _PatternKeys, (double) delNanoseconds / _PatternKeys,
+           worstAdd / 1000.0, statistics.capacity, statistics.expandCount, statistics.meanProbeLength, statistics.maximumProbeLength);
+    fflush(stdout);
 
     parcHashCodeTable_Destroy(&table);
 }
 
+LONGBOW_TEST_CASE(Performance, parcHashCodeTable_HashCodePatterns)
+{
+    printf("%d keys per pattern, nanoseconds per operation\n", _PatternKeys);
+    printf("  %-12s %8s %8s %8s %10s %10s %6s %8s %8s\n", "pattern", "add", "get", "del", "worst add us", "slots", "grows", "mean probe", "max probe");
+    for (_Pattern pattern = _Pattern_Random; pattern <= _Pattern_Strided; pattern++) {
+        printf("  %-12s", _patternNames[pattern]);
+        fflush(stdout);
+        _measurePattern(pattern);
+    }
+}
+
 int
 main(int argc, char *argv[])
 {
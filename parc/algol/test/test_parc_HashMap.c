@@ -339,6 +339,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcHashMap_KeyIterator_HasNext);
     LONGBOW_RUN_TEST_CASE(Global, parcHashMap_KeyIterator_Next);
     LONGBOW_RUN_TEST_CASE(Global, parcHashMap_KeyIterator_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashMapCursor);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashMapCursor_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcHashMapCursor_Remove);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -915,6 +918,85 @@ LONGBOW_TEST_CASE(Global, parcHashMap_KeyIterator_Remove)
     parcHashMap_Release(&instance);
 }
 
+LONGBOW_TEST_CASE(Global, parcHashMapCursor)
+{
+    PARCHashMap *instance = parcHashMap_Create();
+
+    for (int i = 0; i < 100; i++) {
+        PARCBuffer *key = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(sizeof(uint32_t)), i));
+        PARCBuffer *value = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(sizeof(uint32_t)), i + 1000));
+        parcHashMap_Put(instance, key, value);
+        parcBuffer_Release(&key);
+        parcBuffer_Release(&value);
+    }
+
+    uint32_t outstanding = parcMemory_Outstanding();
+    bool seen[100] = { false };
+    size_t count = 0;
+
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, instance);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        PARCBuffer *key = parcHashMapCursor_Next(&cursor);
+        PARCBuffer *value = parcHashMapCursor_GetValue(&cursor);
+        uint32_t k = parcBuffer_GetAtIndex(key, 0) << 24 | parcBuffer_GetAtIndex(key, 1) << 16 | parcBuffer_GetAtIndex(key, 2) << 8 | parcBuffer_GetAtIndex(key, 3);
+        uint32_t v = parcBuffer_GetAtIndex(value, 0) << 24 | parcBuffer_GetAtIndex(value, 1) << 16 | parcBuffer_GetAtIndex(value, 2) << 8 | parcBuffer_GetAtIndex(value, 3);
+
+        assertTrue(k < 100, "Unexpected key %u", k);
+        assertFalse(seen[k], "Key %u returned more than once", k);
+        assertTrue(v == k + 1000, "Expected value %u for key %u, actual %u", k + 1000, k, v);
+        assertTrue(parcMemory_Outstanding() == outstanding, "Expected iterating with a cursor to allocate nothing.");
+        seen[k] = true;
+        count++;
+    }
+
+    assertTrue(count == 100, "Expected 100 entries, actual %zd", count);
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcHashMapCursor_Empty)
+{
+    PARCHashMap *instance = parcHashMap_Create();
+
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, instance);
+    assertFalse(parcHashMapCursor_HasNext(&cursor), "Expected a cursor on an empty map to not HaveNext");
+
+    parcHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Global, parcHashMapCursor_Remove)
+{
+    PARCHashMap *instance = parcHashMap_Create();
+
+    for (int i = 0; i < 100; i++) {
+        PARCBuffer *key = parcBuffer_Flip(parcBuffer_PutUint32(parcBuffer_Allocate(sizeof(uint32_t)), i));
+        parcHashMap_Put(instance, key, key);
+        parcBuffer_Release(&key);
+    }
+
+    PARCHashMapCursor cursor;
+    parcHashMapCursor_Init(&cursor, instance);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        PARCBuffer *key = parcHashMapCursor_Next(&cursor);
+        if (parcBuffer_GetAtIndex(key, 3) % 2 == 0) {
+            parcHashMapCursor_Remove(&cursor);
+        }
+    }
+
+    assertTrue(parcHashMap_Size(instance) == 50, "Expected 50 entries to remain, actual %zd", parcHashMap_Size(instance));
+
+    parcHashMapCursor_Init(&cursor, instance);
+    while (parcHashMapCursor_HasNext(&cursor)) {
+        PARCBuffer *key = parcHashMapCursor_Next(&cursor);
+        assertTrue(parcBuffer_GetAtIndex(key, 3) % 2 == 1, "Expected only odd keys to remain");
+        assertTrue(parcHashMap_Contains(instance, key), "Expected the remaining key to be found");
+    }
+
+    parcHashMap_Release(&instance);
+}
+
 LONGBOW_TEST_FIXTURE(Static)
 {
     LONGBOW_RUN_TEST_CASE(Static, parcHashMapEntry);
@@ -191,6 +191,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcLinkedList_CreateIterator_RemoveHead);
     LONGBOW_RUN_TEST_CASE(Global, parcLinkedList_CreateIterator_RemoveMiddle);
     LONGBOW_RUN_TEST_CASE(Global, parcLinkedList_CreateIterator_RemoveTail);
+    LONGBOW_RUN_TEST_CASE(Global, parcLinkedListCursor);
+    LONGBOW_RUN_TEST_CASE(Global, parcLinkedListCursor_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcLinkedListCursor_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, parcLinkedListCursor_RemoveMiddle);
 
     LONGBOW_RUN_TEST_CASE(Global, parcLinkedList_SetEquals_True);
     LONGBOW_RUN_TEST_CASE(Global, parcLinkedList_SetEquals_False);
@@ -1129,6 +1133,104 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+static PARCLinkedList *
+_createUint64List(size_t listSize)
+{
+    PARCLinkedList *list = parcLinkedList_Create();
+    for (size_t i = 0; i < listSize; i++) {
+        PARCBuffer *buffer = parcBuffer_Allocate(sizeof(uint64_t));
+        parcBuffer_PutUint64(buffer, i);
+        parcBuffer_Flip(buffer);
+        parcLinkedList_Append(list, buffer);
+        parcBuffer_Release(&buffer);
+    }
+    return list;
+}
+
+LONGBOW_TEST_CASE(Global, parcLinkedListCursor)
+{
+    PARCLinkedList *x = _createUint64List(10);
+
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, x);
+    uint64_t expected = 0;
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCBuffer *buffer = parcLinkedListCursor_Next(&cursor);
+        uint64_t actual = parcBuffer_GetUint64(buffer);
+        parcBuffer_Rewind(buffer);
+        assertTrue(expected == actual, "Expected %" PRIu64 ", actual %" PRIu64, expected, actual);
+        assertTrue(parcMemory_Outstanding() == outstanding, "Expected iterating with a cursor to allocate nothing.");
+        expected++;
+    }
+    assertTrue(expected == 10, "Expected 10 elements, actual %" PRIu64, expected);
+
+    parcLinkedList_Release(&x);
+}
+
+LONGBOW_TEST_CASE(Global, parcLinkedListCursor_Empty)
+{
+    PARCLinkedList *x = parcLinkedList_Create();
+
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, x);
+    assertFalse(parcLinkedListCursor_HasNext(&cursor), "Expected a cursor on an empty list to not HaveNext");
+
+    parcLinkedList_Release(&x);
+}
+
+LONGBOW_TEST_CASE(Global, parcLinkedListCursor_Remove)
+{
+    PARCLinkedList *x = _createUint64List(5);
+
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, x);
+    uint64_t expected = 0;
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        uint64_t actual = parcBuffer_GetUint64(parcLinkedListCursor_Next(&cursor));
+        assertTrue(expected == actual, "Expected %" PRIu64 ", actual %" PRIu64, expected, actual);
+        parcLinkedListCursor_Remove(&cursor);
+        expected++;
+    }
+
+    assertTrue(expected == 5, "Expected 5 elements, actual %" PRIu64, expected);
+    assertTrue(parcLinkedList_Size(x) == 0, "List is not empty.");
+    assertTrue(parcLinkedList_IsValid(x), "PARCLinkedList is invalid.");
+
+    parcLinkedList_Release(&x);
+}
+
+LONGBOW_TEST_CASE(Global, parcLinkedListCursor_RemoveMiddle)
+{
+    PARCLinkedList *x = _createUint64List(5);
+
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, x);
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCBuffer *buffer = parcLinkedListCursor_Next(&cursor);
+        if (parcBuffer_GetUint64(buffer) == 2) {
+            parcLinkedListCursor_Remove(&cursor);
+        } else {
+            parcBuffer_Rewind(buffer);
+        }
+    }
+
+    assertTrue(parcLinkedList_Size(x) == 4, "Expected the list to be 4, actual %zd", parcLinkedList_Size(x));
+
+    uint64_t expected[] = { 0, 1, 3, 4 };
+    parcLinkedListCursor_Init(&cursor, x);
+    for (size_t i = 0; i < 4; i++) {
+        assertTrue(parcLinkedListCursor_HasNext(&cursor), "Expected the cursor to HaveNext at %zd", i);
+        uint64_t actual = parcBuffer_GetUint64(parcLinkedListCursor_Next(&cursor));
+        assertTrue(expected[i] == actual, "Expected %" PRIu64 ", actual %" PRIu64, expected[i], actual);
+    }
+    assertFalse(parcLinkedListCursor_HasNext(&cursor), "Expected the cursor to be at the end of the list");
+    assertTrue(parcLinkedList_IsValid(x), "PARCLinkedList is invalid.");
+
+    parcLinkedList_Release(&x);
+}
+
 LONGBOW_TEST_CASE(Local, _parcLinkedListNode_Create)
 {
     PARCBuffer *object = parcBuffer_Allocate(10);
@@ -1145,6 +1247,7 @@ LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
     LONGBOW_RUN_TEST_CASE(Performance, parcLinkedList_Append);
     LONGBOW_RUN_TEST_CASE(Performance, parcLinkedList_N2);
     LONGBOW_RUN_TEST_CASE(Performance, parcLinkedList_CreateIterator);
+    LONGBOW_RUN_TEST_CASE(Performance, parcLinkedListCursor);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -1222,6 +1325,31 @@ LONGBOW_TEST_CASE(Performance, parcLinkedList_CreateIterator)
     parcLinkedList_Release(&x);
 }
 
+LONGBOW_TEST_CASE(Performance, parcLinkedListCursor)
+{
+    PARCLinkedList *x = parcLinkedList_Create();
+
+    uint32_t expectedCount = 100000;
+    for (uint32_t i = 0; i < expectedCount; i++) {
+        PARCBuffer *object = parcBuffer_Allocate(sizeof(int));
+        parcBuffer_PutUint32(object, i);
+        parcBuffer_Flip(object);
+        parcLinkedList_Append(x, object);
+        parcBuffer_Release(&object);
+    }
+
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, x);
+    uint32_t expected = 0;
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCBuffer *buffer = (PARCBuffer *) parcLinkedListCursor_Next(&cursor);
+        uint32_t actual = parcBuffer_GetUint32(buffer);
+        assertTrue(expected == actual, "Expected %d, actual %d", expected, actual);
+        expected++;
+    }
+
+    parcLinkedList_Release(&x);
+}
 
 int
 main(int argc, char *argv[])
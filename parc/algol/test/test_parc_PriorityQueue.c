@@ -69,6 +69,7 @@ LONGBOW_TEST_RUNNER(parc_PriorityQueue)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Errors);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -95,8 +96,17 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Poll);
     LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Peek_Empty);
     LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Poll_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Poll_Ordered);
     LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Size);
     LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Uint64CompareTo);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_AddWithHandle);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Remove_Last);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_UpdatePriority);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_CreateUint64Key);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_UpdateKey);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Handle_Reuse);
+    LONGBOW_RUN_TEST_CASE(Global, parcPriorityQueue_Uint64Key_Random);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -239,6 +249,27 @@ LONGBOW_TEST_CASE(Global, parcPriorityQueue_Poll_Empty)
     parcPriorityQueue_Destroy(&queue);
 }
 
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_Poll_Ordered)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    uint64_t data[1000];
+    unsigned int seed = 1;
+
+    for (int i = 0; i < 1000; i++) {
+        data[i] = rand_r(&seed) % 500;
+        parcPriorityQueue_Add(queue, &data[i]);
+    }
+
+    uint64_t previous = 0;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t *test = parcPriorityQueue_Poll(queue);
+        assertTrue(*test >= previous, "Polled %"PRIu64" after %"PRIu64"", *test, previous);
+        previous = *test;
+    }
+    assertTrue(parcPriorityQueue_Size(queue) == 0, "Wrong size got %zu expected 0", parcPriorityQueue_Size(queue));
+    parcPriorityQueue_Destroy(&queue);
+}
+
 LONGBOW_TEST_CASE(Global, parcPriorityQueue_Size)
 {
     testUnimplemented("");
@@ -249,21 +280,219 @@ LONGBOW_TEST_CASE(Global, parcPriorityQueue_Uint64CompareTo)
     testUnimplemented("");
 }
 
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_AddWithHandle)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    uint64_t data[] = { 60, 70, 50, 71, 72, 55 };
+    PARCPriorityQueueHandle handles[6];
+
+    for (int i = 0; i < 6; i++) {
+        handles[i] = parcPriorityQueue_AddWithHandle(queue, &data[i]);
+        assertTrue(handles[i] != 0, "Expected a non-zero handle");
+        for (int j = 0; j < i; j++) {
+            assertTrue(handles[i] != handles[j], "Expected distinct handles");
+        }
+    }
+
+    uint64_t *test = parcPriorityQueue_Peek(queue);
+    assertTrue(*test == 50, "Wrong head element, expected 50 got %"PRIu64"", *test);
+    parcPriorityQueue_Destroy(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_Remove)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    uint64_t data[] = { 60, 70, 50, 71, 72, 55, 80, 40, 65, 90 };
+    PARCPriorityQueueHandle handles[10];
+
+    for (int i = 0; i < 10; i++) {
+        handles[i] = parcPriorityQueue_AddWithHandle(queue, &data[i]);
+    }
+
+    // Remove the head (40), an interior element (60) and a leaf (90).
+    assertTrue(parcPriorityQueue_Remove(queue, handles[7]) == &data[7], "Remove did not return the element for its handle");
+    assertTrue(parcPriorityQueue_Remove(queue, handles[0]) == &data[0], "Remove did not return the element for its handle");
+    assertTrue(parcPriorityQueue_Remove(queue, handles[9]) == &data[9], "Remove did not return the element for its handle");
+    assertTrue(parcPriorityQueue_Size(queue) == 7, "Wrong size got %zu expected 7", parcPriorityQueue_Size(queue));
+
+    uint64_t expected[] = { 50, 55, 65, 70, 71, 72, 80 };
+    for (int i = 0; i < 7; i++) {
+        uint64_t *test = parcPriorityQueue_Poll(queue);
+        assertTrue(*test == expected[i], "Wrong element, expected %"PRIu64" got %"PRIu64"", expected[i], *test);
+    }
+    parcPriorityQueue_Destroy(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_Remove_Last)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    uint64_t data = 1;
+
+    PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithHandle(queue, &data);
+    assertTrue(parcPriorityQueue_Remove(queue, handle) == &data, "Remove did not return the element for its handle");
+    assertTrue(parcPriorityQueue_Size(queue) == 0, "Wrong size got %zu expected 0", parcPriorityQueue_Size(queue));
+    assertNull(parcPriorityQueue_Peek(queue), "Expected an empty queue");
+
+    parcPriorityQueue_Destroy(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_UpdatePriority)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    uint64_t data[] = { 60, 70, 50, 71, 72, 55 };
+    PARCPriorityQueueHandle handles[6];
+
+    for (int i = 0; i < 6; i++) {
+        handles[i] = parcPriorityQueue_AddWithHandle(queue, &data[i]);
+    }
+
+    // decrease
+    data[4] = 10;
+    parcPriorityQueue_UpdatePriority(queue, handles[4]);
+    uint64_t *test = parcPriorityQueue_Peek(queue);
+    assertTrue(test == &data[4], "Wrong head element, expected 10 got %"PRIu64"", *test);
+
+    // increase
+    data[4] = 100;
+    parcPriorityQueue_UpdatePriority(queue, handles[4]);
+
+    uint64_t expected[] = { 50, 55, 60, 70, 71, 100 };
+    for (int i = 0; i < 6; i++) {
+        test = parcPriorityQueue_Poll(queue);
+        assertTrue(*test == expected[i], "Wrong element, expected %"PRIu64" got %"PRIu64"", expected[i], *test);
+    }
+    parcPriorityQueue_Destroy(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_CreateUint64Key)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_CreateUint64Key(NULL);
+    uint64_t keys[] = { 60, 70, 50, 71, 72, 55 };
+    char *names[] = { "60", "70", "50", "71", "72", "55" };
+
+    for (int i = 0; i < 6; i++) {
+        parcPriorityQueue_AddWithKey(queue, keys[i], names[i]);
+    }
+
+    char *expected[] = { "50", "55", "60", "70", "71", "72" };
+    for (int i = 0; i < 6; i++) {
+        char *test = parcPriorityQueue_Poll(queue);
+        assertTrue(strcmp(test, expected[i]) == 0, "Wrong element, expected %s got %s", expected[i], test);
+    }
+    parcPriorityQueue_Destroy(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_UpdateKey)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_CreateUint64Key(NULL);
+    char *names[] = { "a", "b", "c", "d", "e" };
+    PARCPriorityQueueHandle handles[5];
+
+    for (int i = 0; i < 5; i++) {
+        handles[i] = parcPriorityQueue_AddWithKey(queue, 10 * (i + 1), names[i]);
+    }
+
+    parcPriorityQueue_UpdateKey(queue, handles[3], 5);
+    parcPriorityQueue_UpdateKey(queue, handles[0], 45);
+
+    char *expected[] = { "d", "b", "c", "a", "e" };
+    for (int i = 0; i < 5; i++) {
+        char *test = parcPriorityQueue_Poll(queue);
+        assertTrue(strcmp(test, expected[i]) == 0, "Wrong element, expected %s got %s", expected[i], test);
+    }
+    parcPriorityQueue_Destroy(&queue);
+}
+
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_Handle_Reuse)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_CreateUint64Key(NULL);
+    char *name = "name";
+
+    PARCPriorityQueueHandle first = parcPriorityQueue_AddWithKey(queue, 1, name);
+    parcPriorityQueue_Poll(queue);
+    assertFalse(_handleIsValid(queue, first), "Expected the handle to be invalid once its element has left the queue");
+
+    PARCPriorityQueueHandle second = parcPriorityQueue_AddWithKey(queue, 2, name);
+    assertTrue(first == second, "Expected the free handle to be reused");
+    assertTrue(_handleIsValid(queue, second), "Expected the reused handle to be valid");
+
+    parcPriorityQueue_Destroy(&queue);
+}
+
+/**
+ * Compares a keyed queue against a simple array of the keys in it while adding, polling,
+ * removing and updating elements.
+ */
+LONGBOW_TEST_CASE(Global, parcPriorityQueue_Uint64Key_Random)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_CreateUint64Key(NULL);
+
+    // Each element's data points to its key in a fixed slot, so slots are marked free rather than compacted.
+    const size_t maximum = 500;
+    uint64_t keys[maximum];
+    PARCPriorityQueueHandle handles[maximum];
+    bool inQueue[maximum];
+    size_t count = 0;
+    unsigned int seed = 1;
+
+    memset(inQueue, 0, sizeof(inQueue));
+
+    for (int i = 0; i < 20000; i++) {
+        int operation = (count == 0) ? 0 : rand_r(&seed) % 4;
+        if (operation == 0 && count == maximum) {
+            operation = 1;
+        }
+
+        // Choose a random slot in use, or a free slot if adding.
+        size_t slot = rand_r(&seed) % maximum;
+        while (inQueue[slot] != (operation != 0)) {
+            slot = (slot + 1) % maximum;
+        }
+
+        if (operation == 0) {
+            keys[slot] = rand_r(&seed) % 1000;
+            handles[slot] = parcPriorityQueue_AddWithKey(queue, keys[slot], &keys[slot]);
+            inQueue[slot] = true;
+            count++;
+        } else if (operation == 1) {
+            uint64_t minimum = UINT64_MAX;
+            for (size_t j = 0; j < maximum; j++) {
+                if (inQueue[j] && keys[j] < minimum) {
+                    minimum = keys[j];
+                }
+            }
+            uint64_t *test = parcPriorityQueue_Poll(queue);
+            assertTrue(*test == minimum, "Wrong head element, expected %"PRIu64" got %"PRIu64"", minimum, *test);
+            inQueue[test - keys] = false;
+            count--;
+        } else if (operation == 2) {
+            uint64_t *test = parcPriorityQueue_Remove(queue, handles[slot]);
+            assertTrue(test == &keys[slot], "Remove did not return the element for its handle");
+            inQueue[slot] = false;
+            count--;
+        } else {
+            keys[slot] = rand_r(&seed) % 1000;
+            parcPriorityQueue_UpdateKey(queue, handles[slot], keys[slot]);
+        }
+
+        assertTrue(parcPriorityQueue_Size(queue) == count, "Wrong size got %zu expected %zu", parcPriorityQueue_Size(queue), count);
+    }
+
+    parcPriorityQueue_Destroy(&queue);
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_BubbleUp_True);
     LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_BubbleUp_False);
     LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_Expand);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_LeftChildIndex);
+    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_FirstChildIndex);
     LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_ParentIndex);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_RightChildIndex);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_Swap);
+    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_SetEntry);
     LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleDown);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleLeftChild_True);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleLeftChild_False);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleRightChild_Case1_True);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleRightChild_Case2_True);
-    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleRightChild_Case1_False);
+    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_TrickleDown_Leaf);
+    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_MinimumChild);
+    LONGBOW_RUN_TEST_CASE(Local, parcPriorityQueue_MinimumChild_Partial);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -322,53 +551,52 @@ LONGBOW_TEST_CASE(Local, parcPriorityQueue_Expand)
     parcPriorityQueue_Destroy(&queue);
 }
 
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_LeftChildIndex)
+LONGBOW_TEST_CASE(Local, parcPriorityQueue_FirstChildIndex)
 {
-    testUnimplemented("");
+    assertTrue(_firstChildIndex(0) == 1, "Expected 1, got %zu", _firstChildIndex(0));
+    assertTrue(_firstChildIndex(1) == 5, "Expected 5, got %zu", _firstChildIndex(1));
+    assertTrue(_firstChildIndex(4) == 17, "Expected 17, got %zu", _firstChildIndex(4));
 }
 
 LONGBOW_TEST_CASE(Local, parcPriorityQueue_ParentIndex)
 {
-    testUnimplemented("");
-}
-
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_RightChildIndex)
-{
-    testUnimplemented("");
+    for (size_t i = 1; i <= 4; i++) {
+        assertTrue(_parentIndex(i) == 0, "Expected the parent of %zu to be 0, got %zu", i, _parentIndex(i));
+    }
+    for (size_t i = 5; i <= 8; i++) {
+        assertTrue(_parentIndex(i) == 1, "Expected the parent of %zu to be 1, got %zu", i, _parentIndex(i));
+    }
+    assertTrue(_parentIndex(_firstChildIndex(7) + 3) == 7, "Expected the parent of the last child of 7 to be 7");
 }
 
 /**
- * Swaps two elements
+ * Moving an entry updates its handle.
  */
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_Swap)
+LONGBOW_TEST_CASE(Local, parcPriorityQueue_SetEntry)
 {
-    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    PARCPriorityQueue *queue = parcPriorityQueue_CreateUint64Key(NULL);
     uint64_t data[] = { 50, 6 };
 
-    queue->array[0].data = &data[0];
-    queue->array[1].data = &data[1];
-    queue->size = 2;
+    PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithKey(queue, data[0], &data[0]);
+    parcPriorityQueue_AddWithKey(queue, data[1], &data[1]);
 
-    _swap(queue, 0, 1);
-    assertTrue(queue->array[0].data == &data[1], "array[0] does not equal data[1]: %p != %p",
-               (void *)queue->array[0].data, (void *)&data[1]);
-    assertTrue(queue->array[1].data == &data[0], "array[1] does not equal data[0]: %p != %p",
-               (void *)queue->array[1].data, (void *)&data[0]);
+    assertTrue(queue->array[1].handle == handle, "Expected element 50 to be a child");
+    assertTrue(queue->handles[handle] == 1, "Expected the handle to refer to index 1, got %zu", queue->handles[handle]);
+
+    _setEntry(queue, 0, queue->array[1]);
+    assertTrue(queue->handles[handle] == 0, "Expected the handle to refer to index 0, got %zu", queue->handles[handle]);
 
     parcPriorityQueue_Destroy(&queue);
 }
 
 /**
- * Tests each case in TrickleDown:
- * - right child exists, then
- * - no right child, only left child, then
- * - no child
+ * Tests TrickleDown moving the root past a smaller child, to a node with no children.
  *
- *        60                      50
- *      /    \                  /    \
- *     70      50    ====>    70      55
- *    /  \    /  \           /  \    /  \
- *   71 72  55   x          71  72  60   x
+ *            60                          50
+ *     +----+--+---+----+          +----+--+---+----+
+ *     70   50     71   72  ====>  70   60     71   72
+ *     |                           |
+ *     55                          55
  */
 LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleDown)
 {
@@ -384,141 +612,126 @@ LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleDown)
     assertTrue(*((uint64_t *) queue->array[0].data) == 50,
                "Root not 50, got %"PRIu64"\n",
                (uint64_t) *((uint64_t *) queue->array[0].data));
-    assertTrue(*((uint64_t *) queue->array[2].data) == 55,
-               "Right not 55, got %"PRIu64"\n",
+    assertTrue(*((uint64_t *) queue->array[2].data) == 60,
+               "Second child not 60, got %"PRIu64"\n",
                (uint64_t) *((uint64_t *) queue->array[2].data));
-    assertTrue(*((uint64_t *) queue->array[5].data) == 60,
-               "Last not 60, got %"PRIu64"\n",
+    assertTrue(*((uint64_t *) queue->array[5].data) == 55,
+               "Last not 55, got %"PRIu64"\n",
                (uint64_t) *((uint64_t *) queue->array[5].data));
 
     parcPriorityQueue_Destroy(&queue);
 }
 
 /**
- * Tests the TRUE case of this condition
+ * Tests TrickleDown through two levels.
  *
- * Case 3: Left child exists (right does not) and l.value < n.value
- *   In this case, swap(n.index, l.index) and set n.index = l.index
- *       50                6
- *      /  \     ===>     / \
- *     6    x            50  x
+ *            90                          5
+ *     +----+--+---+----+          +----+--+---+----+
+ *     5    20     30   40  ====>  10   20     30   40
+ *     |                           |
+ *  +--+--+                     +--+--+
+ *  15    10                    15    90
  */
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleLeftChild_True)
+LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleDown_Leaf)
 {
     PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
-    uint64_t data[] = { 50, 6 };
+    uint64_t data[] = { 90, 5, 20, 30, 40, 15, 10 };
 
-    queue->array[0].data = &data[0];
-    queue->array[1].data = &data[1];
-    queue->size = 2;
+    queue->size = 7;
+    for (int i = 0; i < queue->size; i++) {
+        queue->array[i].data = &data[i];
+    }
+
+    _trickleDown(queue, 0);
 
-    size_t nextElementIndex = _trickleLeftChild(queue, 0, 1);
-    assertTrue(nextElementIndex == 1, "nextElementIndex should have been left child 1, got %zu\n", nextElementIndex);
+    uint64_t expected[] = { 5, 10, 20, 30, 40, 15, 90 };
+    for (int i = 0; i < queue->size; i++) {
+        assertTrue(*((uint64_t *) queue->array[i].data) == expected[i],
+                   "Index %d not %"PRIu64", got %"PRIu64"\n", i, expected[i],
+                   (uint64_t) *((uint64_t *) queue->array[i].data));
+    }
 
     parcPriorityQueue_Destroy(&queue);
 }
 
-/**
- * Tests the FALSE case of this condition
- *
- * Case 3: Left child exists (right does not) and l.value < n.value
- *   In this case, swap(n.index, l.index) and set n.index = l.index
- *       50                6
- *      /  \     ===>     / \
- *     6    x            50  x
- */
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleLeftChild_False)
+LONGBOW_TEST_CASE(Local, parcPriorityQueue_MinimumChild)
 {
     PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
-    uint64_t data[] = { 6, 50 };
+    uint64_t data[] = { 50, 9, 8, 6, 7 };
 
-    queue->array[0].data = &data[0];
-    queue->array[1].data = &data[1];
-    queue->size = 2;
+    queue->size = 5;
+    for (int i = 0; i < queue->size; i++) {
+        queue->array[i].data = &data[i];
+    }
 
-    size_t nextElementIndex = _trickleLeftChild(queue, 0, 1);
-    assertTrue(nextElementIndex == 0, "nextElementIndex should have been root 0, got %zu\n", nextElementIndex);
+    size_t minimumIndex = _minimumChild(queue, 1);
+    assertTrue(minimumIndex == 3, "minimumIndex should have been 3, got %zu\n", minimumIndex);
 
     parcPriorityQueue_Destroy(&queue);
 }
 
-
 /**
- * Tests the TRUE case
- *
- * Case 1: Right child exists and r.value < n.value && r.value < l.value
- *   In this case, swap(n.index, r.index) and set n.index = r.index.
- *       50                6
- *      /  \     ===>     / \
- *     9    6            9   50
+ * A node may have fewer than four children, and the children after the last must not be examined.
  */
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleRightChild_Case1_True)
+LONGBOW_TEST_CASE(Local, parcPriorityQueue_MinimumChild_Partial)
 {
     PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
-    uint64_t data[] = { 50, 9, 6 };
+    uint64_t data[] = { 50, 9, 8, 1 };
 
     queue->array[0].data = &data[0];
     queue->array[1].data = &data[1];
     queue->array[2].data = &data[2];
+    queue->array[3].data = &data[3];
     queue->size = 3;
 
-    size_t nextElementIndex = _trickleRightChild(queue, 0, 1, 2);
-    assertTrue(nextElementIndex == 2, "nextElementIndex should have been right 2, got %zu\n", nextElementIndex);
+    size_t minimumIndex = _minimumChild(queue, 1);
+    assertTrue(minimumIndex == 2, "minimumIndex should have been 2, got %zu\n", minimumIndex);
 
     parcPriorityQueue_Destroy(&queue);
 }
 
-/**
- * Tests the FALSE case
- *
- * Case 1: Right child exists and r.value < n.value && r.value < l.value
- *   In this case, swap(n.index, r.index) and set n.index = r.index.
- *       50                6
- *      /  \     ===>     / \
- *     9    6            9   50
- */
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleRightChild_Case1_False)
+LONGBOW_TEST_FIXTURE(Errors)
 {
-    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
-
-    // r.value not < n.value
-    uint64_t data[] = { 6, 9, 50 };
+    LONGBOW_RUN_TEST_CASE(Errors, parcPriorityQueue_Remove_InvalidHandle);
+    LONGBOW_RUN_TEST_CASE(Errors, parcPriorityQueue_UpdateKey_RemovedHandle);
+}
 
-    queue->array[0].data = &data[0];
-    queue->array[1].data = &data[1];
-    queue->array[2].data = &data[2];
-    queue->size = 3;
+LONGBOW_TEST_FIXTURE_SETUP(Errors)
+{
+    PARCPriorityQueue *queue = parcPriorityQueue_CreateUint64Key(NULL);
+    longBowTestCase_SetClipBoardData(testCase, queue);
 
-    size_t nextElementIndex = _trickleRightChild(queue, 0, 1, 2);
-    assertTrue(nextElementIndex == 0, "nextElementIndex should have been root 0, got %zu\n", nextElementIndex);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
 
+LONGBOW_TEST_FIXTURE_TEARDOWN(Errors)
+{
+    PARCPriorityQueue *queue = longBowTestCase_GetClipBoardData(testCase);
     parcPriorityQueue_Destroy(&queue);
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
 }
 
-/**
- * Tests the TRUE case
- *
- * Case 2: Right child exists and r.value < n.value && l.value <= r.value
- *   In this case swap(n.index, l.index) and set n.index = l.index
- *   This makes sense by transitivity that l <= r < n, so swap(n,l) satisfies the invariant.
- *       50                6
- *      /  \     ===>     / \
- *     6    9            50  9
- */
-LONGBOW_TEST_CASE(Local, parcPriorityQueue_TrickleRightChild_Case2_True)
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcPriorityQueue_Remove_InvalidHandle, .event = &LongBowTrapIllegalValue)
 {
-    PARCPriorityQueue *queue = parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
-    uint64_t data[] = { 50, 6, 9 };
+    PARCPriorityQueue *queue = longBowTestCase_GetClipBoardData(testCase);
+    parcPriorityQueue_AddWithKey(queue, 1, "element");
 
-    queue->array[0].data = &data[0];
-    queue->array[1].data = &data[1];
-    queue->array[2].data = &data[2];
-    queue->size = 3;
+    parcPriorityQueue_Remove(queue, 0);
+}
 
-    size_t nextElementIndex = _trickleRightChild(queue, 0, 1, 2);
-    assertTrue(nextElementIndex == 1, "nextElementIndex should have been left 1, got %zu\n", nextElementIndex);
+LONGBOW_TEST_CASE_EXPECTS(Errors, parcPriorityQueue_UpdateKey_RemovedHandle, .event = &LongBowTrapIllegalValue)
+{
+    PARCPriorityQueue *queue = longBowTestCase_GetClipBoardData(testCase);
+    PARCPriorityQueueHandle handle = parcPriorityQueue_AddWithKey(queue, 1, "element");
+    parcPriorityQueue_AddWithKey(queue, 2, "element");
+    parcPriorityQueue_Remove(queue, handle);
 
-    parcPriorityQueue_Destroy(&queue);
+    parcPriorityQueue_UpdateKey(queue, handle, 3);
 }
 
 int
@@ -62,6 +62,8 @@
 
 #include <fcntl.h>
 
+#include <parc/algol/parc_Time.h>
+
 LONGBOW_TEST_RUNNER(safetyMemory)
 {
     LONGBOW_RUN_TEST_FIXTURE(Static);
@@ -269,6 +271,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_Display);
     LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_Display_NULL);
 
+    LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_AllocationRecord);
+    LONGBOW_RUN_TEST_CASE(Global, parcSafeMemory_SetBacktraceSamplingPeriod);
+
     LONGBOW_RUN_TEST_CASE(Global, compute_prefix_length);
     LONGBOW_RUN_TEST_CASE(Global, _parcSafeMemory_FormatMemory);
     LONGBOW_RUN_TEST_CASE(Global, memory_prefix_format);
@@ -711,6 +716,89 @@ LONGBOW_TEST_CASE(Global, parcSafeMemory_Display_NULL)
     parcSafeMemory_Display(NULL, 0);
 }
 
+static bool
+_recordContains(const void *memory)
+{
+    _SafeMemoryShard *shard = _parcSafeMemory_GetShard(memory);
+    bool result = false;
+
+    pthread_mutex_lock(&shard->mutex);
+    for (size_t i = 0; i < shard->capacity; i++) {
+        if (shard->slots[i] == memory) {
+            result = true;
+        }
+    }
+    pthread_mutex_unlock(&shard->mutex);
+    return result;
+}
+
+static size_t
+_recordCount(void)
+{
+    size_t result = 0;
+    for (int i = 0; i < _parcSafeMemory_ShardCount; i++) {
+        pthread_mutex_lock(&_parcSafeMemory_Shards[i].mutex);
+        result += _parcSafeMemory_Shards[i].count;
+        pthread_mutex_unlock(&_parcSafeMemory_Shards[i].mutex);
+    }
+    return result;
+}
+
+LONGBOW_TEST_CASE(Global, parcSafeMemory_AllocationRecord)
+{
+    void *allocations[5000];
+    size_t count = sizeof(allocations) / sizeof(allocations[0]);
+    size_t initialCount = _recordCount();
+
+    for (size_t i = 0; i < count; i++) {
+        allocations[i] = parcSafeMemory_Allocate(16);
+    }
+    assertTrue(_recordCount() == initialCount + count, "Expected %zu records, actual %zu", initialCount + count, _recordCount());
+
+    // Removing every other allocation exercises the deletion of entries in the middle of probe sequences.
+    for (size_t i = 0; i < count; i += 2) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+    for (size_t i = 1; i < count; i += 2) {
+        assertTrue(_recordContains(allocations[i]), "Expected allocation %zu to still be recorded", i);
+    }
+    for (size_t i = 1; i < count; i += 2) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+    assertTrue(_recordCount() == initialCount, "Expected %zu records, actual %zu", initialCount, _recordCount());
+}
+
+LONGBOW_TEST_CASE(Global, parcSafeMemory_SetBacktraceSamplingPeriod)
+{
+    assertTrue(parcSafeMemory_GetBacktraceSamplingPeriod() == 1, "Expected every allocation to record a backtrace by default");
+
+    void *allocations[6];
+    size_t count = sizeof(allocations) / sizeof(allocations[0]);
+
+    parcSafeMemory_SetBacktraceSamplingPeriod(3);
+    _parcSafeMemory_AllocationsSinceBacktrace = 0;
+    int sampled = 0;
+    for (size_t i = 0; i < count; i++) {
+        allocations[i] = parcSafeMemory_Allocate(16);
+        sampled += (_parcSafeMemory_GetPrefix(allocations[i])->backtrace != NULL);
+    }
+    assertTrue(sampled == 2, "Expected 2 of 6 allocations to record a backtrace, actual %d", sampled);
+
+    parcSafeMemory_SetBacktraceSamplingPeriod(0);
+    void *unsampled = parcSafeMemory_Allocate(16);
+    assertNull(_parcSafeMemory_GetPrefix(unsampled)->backtrace, "Expected no backtrace when sampling is disabled");
+
+    int fd = open("/dev/null", O_WRONLY);
+    parcSafeMemory_ReportAllocation(fd);
+    close(fd);
+
+    parcSafeMemory_SetBacktraceSamplingPeriod(1);
+    parcSafeMemory_Deallocate(&unsampled);
+    for (size_t i = 0; i < count; i++) {
+        parcSafeMemory_Deallocate(&allocations[i]);
+    }
+}
+
 LONGBOW_TEST_FIXTURE(Errors)
 {
     LONGBOW_RUN_TEST_CASE(Errors, parcSafeMemory_Reallocate_NULL);
@@ -791,6 +879,7 @@ LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
 {
     LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_WorstCase);
     LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_BestCase);
+    LONGBOW_RUN_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_Outstanding);
 
     LONGBOW_RUN_TEST_CASE(Performance, _computeUsableMemoryLength);
 }
@@ -834,6 +923,54 @@ LONGBOW_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_1000000_BestCas
     } while (i > 0);
 }
 
+/*
+ * Time replacing the oldest of `outstanding` live allocations with a new one,
+ * the steady state of a long-running process with a working set of that size.
+ */
+static double
+_allocateDeallocateNanoseconds(size_t outstanding, int steps)
+{
+    for (size_t i = 0; i < outstanding; i++) {
+        memory[i] = parcSafeMemory_Allocate(100);
+    }
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < steps; i++) {
+        if (outstanding == 0) {
+            void *transient = parcSafeMemory_Allocate(100);
+            parcSafeMemory_Deallocate(&transient);
+        } else {
+            size_t oldest = i % outstanding;
+            parcSafeMemory_Deallocate(&memory[oldest]);
+            memory[oldest] = parcSafeMemory_Allocate(100);
+        }
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    for (size_t i = outstanding; i > 0; i--) {
+        parcSafeMemory_Deallocate(&memory[i - 1]);
+    }
+    return (double) elapsed / steps;
+}
+
+LONGBOW_TEST_CASE(Performance, parcSafeMemory_AllocateDeallocate_Outstanding)
+{
+    size_t outstanding[] = { 0, 100, 1000, 10000, 100000, 1000000 };
+
+    printf("deallocate oldest + allocate versus outstanding allocations\n");
+    printf("  %8s %14s %14s %14s\n", "live", "backtrace/1", "backtrace/64", "no backtrace");
+    for (size_t i = 0; i < sizeof(outstanding) / sizeof(outstanding[0]); i++) {
+        parcSafeMemory_SetBacktraceSamplingPeriod(1);
+        double every = _allocateDeallocateNanoseconds(outstanding[i], 20000);
+        parcSafeMemory_SetBacktraceSamplingPeriod(64);
+        double sampled = _allocateDeallocateNanoseconds(outstanding[i], 20000);
+        parcSafeMemory_SetBacktraceSamplingPeriod(0);
+        double none = _allocateDeallocateNanoseconds(outstanding[i], 20000);
+        printf("  %8zu %11.0f ns %11.0f ns %11.0f ns\n", outstanding[i], every, sampled, none);
+    }
+    parcSafeMemory_SetBacktraceSamplingPeriod(1);
+}
+
 LONGBOW_TEST_CASE(Performance, _computeUsableMemoryLength)
 {
     for (int i = 0; i < 100000000; i++) {
@@ -58,6 +58,8 @@
  */
 #include "../parc_StdlibMemory.c"
 
+#include <inttypes.h>
+
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
 
@@ -95,6 +97,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_Reallocate);
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_Reallocate_NULL);
     LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_StringDuplicate);
+    LONGBOW_RUN_TEST_CASE(Global, parcStdlibMemory_RegisterMetrics);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -251,6 +254,27 @@ LONGBOW_TEST_CASE(Global, parcStdlibMemory_StringDuplicate)
                "Expected 0 outstanding allocations, actual %d", parcStdlibMemory_Outstanding());
 }
 
+LONGBOW_TEST_CASE(Global, parcStdlibMemory_RegisterMetrics)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+    parcStdlibMemory_RegisterMetrics(metrics, "memory");
+
+    PARCJSON *json = parcMetrics_ToJSON(metrics);
+    int64_t before = parcJSONValue_GetInteger(parcJSON_GetValueByName(json, "memory.outstanding"));
+    parcJSON_Release(&json);
+
+    void *memory = parcStdlibMemory_Allocate(10);
+
+    json = parcMetrics_ToJSON(metrics);
+    int64_t after = parcJSONValue_GetInteger(parcJSON_GetValueByName(json, "memory.outstanding"));
+    parcJSON_Release(&json);
+
+    assertTrue(after == before + 1, "Expected %" PRId64 " outstanding allocations, actual %" PRId64, before + 1, after);
+
+    parcStdlibMemory_Deallocate(&memory);
+    parcMetrics_Release(&metrics);
+}
+
 LONGBOW_TEST_FIXTURE(Threads)
 {
     LONGBOW_RUN_TEST_CASE(Threads, Threads1000);
@@ -93,6 +93,7 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcTime_TimevalAsString);
     LONGBOW_RUN_TEST_CASE(Global, parcTime_TimevalAsISO8601);
     LONGBOW_RUN_TEST_CASE(Global, parcTime_TimevalAsRFC3339);
+    LONGBOW_RUN_TEST_CASE(Global, parcTime_TimevalAsRFC3339_NextSecond);
     LONGBOW_RUN_TEST_CASE(Global, parcTime_RFC3339_Now);
     LONGBOW_RUN_TEST_CASE(Global, parcTime_NowTimeval);
     LONGBOW_RUN_TEST_CASE(Global, parcTime_NowMicroseconds);
@@ -153,6 +154,24 @@ LONGBOW_TEST_CASE(Global, parcTime_TimevalAsRFC3339)
     assertTrue(strcmp(expected, actual) == 0, "Expected %s, actual %s", expected, actual);
 }
 
+LONGBOW_TEST_CASE(Global, parcTime_TimevalAsRFC3339_NextSecond)
+{
+    struct timeval timeval = { .tv_sec = 59, .tv_usec = 999999 };
+
+    char actual[64];
+    parcTime_TimevalAsRFC3339(&timeval, actual);
+    assertTrue(strcmp("1970-01-01T00:00:59.999999Z", actual) == 0, "Expected 1970-01-01T00:00:59.999999Z, actual %s", actual);
+
+    timeval.tv_sec = 60;
+    timeval.tv_usec = 0;
+    parcTime_TimevalAsRFC3339(&timeval, actual);
+    assertTrue(strcmp("1970-01-01T00:01:00.000000Z", actual) == 0, "Expected 1970-01-01T00:01:00.000000Z, actual %s", actual);
+
+    timeval.tv_usec = 5;
+    parcTime_TimevalAsRFC3339(&timeval, actual);
+    assertTrue(strcmp("1970-01-01T00:01:00.000005Z", actual) == 0, "Expected 1970-01-01T00:01:00.000005Z, actual %s", actual);
+}
+
 LONGBOW_TEST_CASE(Global, parcTime_RFC3339_Now)
 {
 
@@ -208,6 +208,10 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, PARC_TreeMap_KeyIterator);
     LONGBOW_RUN_TEST_CASE(Global, PARC_TreeMap_Remove_Using_Iterator);
     LONGBOW_RUN_TEST_CASE(Global, PARC_TreeMap_Remove_Element_Using_Iterator);
+
+    LONGBOW_RUN_TEST_CASE(Global, PARC_TreeMap_Cursor);
+    LONGBOW_RUN_TEST_CASE(Global, PARC_TreeMap_Cursor_Empty);
+    LONGBOW_RUN_TEST_CASE(Global, PARC_TreeMap_Remove_Using_Cursor);
 }
 
 #define N_TEST_ELEMENTS 42
@@ -1482,6 +1486,77 @@ LONGBOW_TEST_CASE(Global, PARC_TreeMap_Remove_Element_Using_Iterator)
     assertTrue(parcTreeMap_Equals(tree1, tree2), "Expect the trees to be equal after remove.");
 }
 
+LONGBOW_TEST_CASE(Global, PARC_TreeMap_Cursor)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCTreeMap *tree1 = data->testMap1;
+
+    int idx1[15] = { 8, 4, 12, 2, 6, 10, 14, 1, 3, 5, 7, 9, 11, 13, 15 };
+
+    for (int i = 0; i < 15; i++) {
+        // Add some elements to the tree
+        parcTreeMap_Put(tree1, data->k[idx1[i]], data->v[idx1[i]]);
+    }
+
+    uint32_t outstanding = parcMemory_Outstanding();
+
+    PARCTreeMapCursor cursor;
+    parcTreeMapCursor_Init(&cursor, tree1);
+
+    int idx = 1;
+    for (; parcTreeMapCursor_HasNext(&cursor); ++idx) {
+        _Int *key = (_Int *) parcTreeMapCursor_Next(&cursor);
+        assertTrue(_int_Equals(key, data->k[idx]),
+                   "Expected key %d got %d",
+                   data->k[idx]->value,
+                   key->value);
+        assertTrue(_int_Equals((_Int *) parcTreeMapCursor_GetValue(&cursor), data->v[idx]),
+                   "Expected value %d", data->v[idx]->value);
+        assertTrue(parcKeyValue_GetKey(parcTreeMapCursor_GetEntry(&cursor)) == (PARCObject *) key,
+                   "Expected the entry to hold the returned key");
+        assertTrue(parcMemory_Outstanding() == outstanding, "Expected iterating with a cursor to allocate nothing.");
+    }
+    assertTrue(idx == 16, "Expected 15 elements, actual %d", idx - 1);
+}
+
+LONGBOW_TEST_CASE(Global, PARC_TreeMap_Cursor_Empty)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+
+    PARCTreeMapCursor cursor;
+    parcTreeMapCursor_Init(&cursor, data->testMap1);
+    assertFalse(parcTreeMapCursor_HasNext(&cursor), "Expected a cursor on an empty tree to not HaveNext");
+}
+
+LONGBOW_TEST_CASE(Global, PARC_TreeMap_Remove_Using_Cursor)
+{
+    TestData *data = longBowTestCase_GetClipBoardData(testCase);
+    PARCTreeMap *tree1 = data->testMap1;
+    PARCTreeMap *tree2 = data->testMap2;
+
+    int idx1[15] = { 8, 4, 12, 2, 6, 10, 14, 1, 3, 5, 7, 9, 11, 13, 15 };
+
+    for (int i = 0; i < 15; i++) {
+        // Add some elements to the tree
+        parcTreeMap_Put(tree1, data->k[idx1[i]], data->v[idx1[i]]);
+        if (idx1[i] % 2 == 1) {
+            parcTreeMap_Put(tree2, data->k[idx1[i]], data->v[idx1[i]]);
+        }
+    }
+
+    PARCTreeMapCursor cursor;
+    parcTreeMapCursor_Init(&cursor, tree1);
+    while (parcTreeMapCursor_HasNext(&cursor)) {
+        _Int *key = (_Int *) parcTreeMapCursor_Next(&cursor);
+        if (key->value % 2 == 0) {
+            parcTreeMapCursor_Remove(&cursor);
+        }
+    }
+
+    assertTrue(parcTreeMap_Size(tree1) == 8, "Expected 8 elements to remain, actual %zd", parcTreeMap_Size(tree1));
+    assertTrue(parcTreeMap_Equals(tree1, tree2), "Expect the trees to be equal after removes.");
+}
+
 LONGBOW_TEST_FIXTURE(Local)
 {
     //LONGBOW_RUN_TEST_CASE(Local, PARC_TreeMap_EnsureRemaining_NonEmpty);
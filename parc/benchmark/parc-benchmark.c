@@ -0,0 +1,323 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Clock.h>
+#include <parc/algol/parc_FileInputStream.h>
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_JSONArray.h>
+#include <parc/algol/parc_JSONValue.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/security/parc_Security.h>
+
+#include <parc/benchmark/parc_Benchmark.h>
+#include <parc/benchmark/parc_BenchmarkSuites.h>
+
+static const PARCBenchmark *_suites[] = {
+    parcBenchmarkAlgol_Suite,
+    parcBenchmarkConcurrent_Suite,
+    parcBenchmarkSecurity_Suite,
+    NULL
+};
+
+static void
+printUsage(char *progName)
+{
+    printf("usage: %s [-h] [-l] [-f filter] [-w ms] [-t ms] [-s samples] [-c cpu] [-q] [-j file] [-b file [-r percent]]\n", progName);
+    printf("\n");
+    printf("Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).\n");
+    printf("\n");
+    printf("All Rights Reserved. Use is subject to license terms.\n");
+    printf("\n");
+    printf("Run the PARC Library microbenchmarks.\n");
+    printf("\n");
+    printf("optional arguments:\n");
+    printf("\t-h, --help\t\tShow this help message and exit\n");
+    printf("\t-l, --list\t\tList the benchmarks and exit\n");
+    printf("\t-f, --filter text\tRun only the benchmarks whose name contains the text\n");
+    printf("\t-w, --warmup ms\t\tWarm up each benchmark for the given milliseconds (default %u)\n", PARCBenchmarkOptions_Default.warmupMilliseconds);
+    printf("\t-t, --time ms\t\tTake samples of about the given milliseconds (default %u)\n", PARCBenchmarkOptions_Default.sampleMilliseconds);
+    printf("\t-s, --samples n\t\tTake n samples of each benchmark (default %u)\n", PARCBenchmarkOptions_Default.samples);
+    printf("\t-c, --cpu n\t\tPin the benchmarks to CPU n.  Threads started by a benchmark are pinned to the same CPU.\n");
+    printf("\t-q, --quick\t\tRun each benchmark for about a millisecond, to check that it works\n");
+    printf("\t-j, --json file\t\tWrite the results as JSON to the file, or to standard output if the file is -\n");
+    printf("\t-b, --baseline file\tCompare the results with a JSON file written by --json\n");
+    printf("\t-r, --threshold percent\tExit with status 2 if a benchmark is slower than the baseline by more than percent (default 10)\n");
+    printf("\n");
+    printf("\t\t\texample: ./parc-benchmark -f PARCHashMap -j hashmap.json\n");
+    printf("\n");
+}
+
+static PARCJSON *
+readBaseline(const char *fileName)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    PARCFileInputStream *stream = parcFileInputStream_Create(fd);
+
+    PARCBuffer *buffer = parcBuffer_Flip(parcFileInputStream_ReadFile(stream));
+    parcFileInputStream_Release(&stream);
+
+    PARCJSON *result = parcJSON_ParseBuffer(buffer);
+    parcBuffer_Release(&buffer);
+
+    return result;
+}
+
+static bool
+writeJSON(const char *fileName, const PARCJSON *json)
+{
+    char *string = parcJSON_ToString(json);
+
+    bool result = false;
+    if (strcmp(fileName, "-") == 0) {
+        result = (fprintf(stdout, "%s\n", string) >= 0);
+    } else {
+        FILE *output = fopen(fileName, "w");
+        if (output != NULL) {
+            result = (fprintf(output, "%s\n", string) >= 0);
+            result = (fclose(output) == 0) && result;
+        }
+    }
+    parcMemory_Deallocate(&string);
+
+    return result;
+}
+
+int
+main(int argc, char *argv[])
+{
+    char *programName = "parc-benchmark";
+
+    static struct option longOptions[] = {
+        { "help",      no_argument,       NULL, 'h' },
+        { "list",      no_argument,       NULL, 'l' },
+        { "filter",    required_argument, NULL, 'f' },
+        { "warmup",    required_argument, NULL, 'w' },
+        { "time",      required_argument, NULL, 't' },
+        { "samples",   required_argument, NULL, 's' },
+        { "cpu",       required_argument, NULL, 'c' },
+        { "quick",     no_argument,       NULL, 'q' },
+        { "json",      required_argument, NULL, 'j' },
+        { "baseline",  required_argument, NULL, 'b' },
+        { "threshold", required_argument, NULL, 'r' },
+        { NULL,        0,                 NULL, 0   }
+    };
+
+    PARCBenchmarkOptions options = PARCBenchmarkOptions_Default;
+    bool list = false;
+    const char *filter = NULL;
+    const char *jsonFileName = NULL;
+    const char *baselineFileName = NULL;
+    double threshold = 10.0;
+    int cpu = -1;
+
+    int option;
+    while ((option = getopt_long(argc, argv, "hlf:w:t:s:c:qj:b:r:", longOptions, NULL)) != -1) {
+        switch (option) {
+            case 'h':
+                printUsage(programName);
+                return 0;
+            case 'l':
+                list = true;
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            case 'w':
+                options.warmupMilliseconds = (unsigned int) strtoul(optarg, NULL, 10);
+                break;
+            case 't':
+                options.sampleMilliseconds = (unsigned int) strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                options.samples = (unsigned int) strtoul(optarg, NULL, 10);
+                break;
+            case 'c':
+                cpu = (int) strtol(optarg, NULL, 10);
+                break;
+            case 'q':
+                options.warmupMilliseconds = 1;
+                options.sampleMilliseconds = 1;
+                options.samples = 1;
+                break;
+            case 'j':
+                jsonFileName = optarg;
+                break;
+            case 'b':
+                baselineFileName = optarg;
+                break;
+            case 'r':
+                threshold = strtod(optarg, NULL);
+                break;
+            default:
+                printUsage(programName);
+                exit(1);
+        }
+    }
+
+    if (options.samples == 0 || options.samples > PARCBenchmark_MaximumSamples) {
+        printf("Error: the number of samples must be between 1 and %d\n", PARCBenchmark_MaximumSamples);
+        exit(1);
+    }
+
+    if (list) {
+        for (size_t s = 0; _suites[s] != NULL; s++) {
+            for (const PARCBenchmark *benchmark = _suites[s]; benchmark->name != NULL; benchmark++) {
+                printf("%s\n", benchmark->name);
+            }
+        }
+        return 0;
+    }
+
+    if (cpu >= 0 && !parcBenchmark_PinToCPU(cpu)) {
+        printf("Error: cannot pin to CPU %d\n", cpu);
+        exit(1);
+    }
+
+    PARCJSON *baseline = NULL;
+    if (baselineFileName != NULL) {
+        baseline = readBaseline(baselineFileName);
+        if (baseline == NULL) {
+            printf("Error: cannot read the baseline %s %s\n", baselineFileName, strerror(errno));
+            exit(1);
+        }
+    }
+
+    parcSecurity_Init();
+
+    // With JSON on standard output the table goes to standard error.
+    FILE *table = (jsonFileName != NULL && strcmp(jsonFileName, "-") == 0) ? stderr : stdout;
+    fprintf(table, "%-32s %14s %14s %12s %12s %10s\n", "benchmark", "ns/op", "ops/sec", "allocs/op", "bytes/op", "change");
+
+    PARCJSONArray *results = parcJSONArray_Create();
+    int regressions = 0;
+
+    for (size_t s = 0; _suites[s] != NULL; s++) {
+        for (const PARCBenchmark *benchmark = _suites[s]; benchmark->name != NULL; benchmark++) {
+            if (filter != NULL && strstr(benchmark->name, filter) == NULL) {
+                continue;
+            }
+
+            PARCBenchmarkResult result;
+            parcBenchmark_Run(benchmark, &options, &result);
+
+            char change[16] = "";
+            double percent;
+            if (baseline != NULL && parcBenchmarkResult_CompareToBaseline(&result, baseline, &percent)) {
+                snprintf(change, sizeof(change), "%+.1f%%", percent);
+                if (percent > threshold) {
+                    regressions++;
+                }
+            }
+
+            fprintf(table, "%-32s %14.1f %14.0f %12.2f %12.1f %10s\n", result.name, result.nanosecondsPerOp,
+                    result.opsPerSecond, result.allocationsPerOp, result.bytesPerOp, change);
+            fflush(table);
+
+            PARCJSON *json = parcBenchmarkResult_ToJSON(&result);
+            PARCJSONValue *value = parcJSONValue_CreateFromJSON(json);
+            parcJSONArray_AddValue(results, value);
+            parcJSONValue_Release(&value);
+            parcJSON_Release(&json);
+        }
+    }
+
+    int exitStatus = 0;
+
+    if (jsonFileName != NULL) {
+        PARCJSON *document = parcJSON_Create();
+        parcJSON_AddString(document, "clock", parcClock_IsTSC(parcClock_TSC()) ? "tsc" : "monotonic");
+        parcJSON_AddInteger(document, "warmupMilliseconds", options.warmupMilliseconds);
+        parcJSON_AddInteger(document, "sampleMilliseconds", options.sampleMilliseconds);
+        parcJSON_AddInteger(document, "samples", options.samples);
+        parcJSON_AddInteger(document, "cpu", cpu);
+        parcJSON_AddArray(document, "benchmarks", results);
+
+        if (!writeJSON(jsonFileName, document)) {
+            printf("Error: %s %s\n", jsonFileName, strerror(errno));
+            exitStatus = 1;
+        }
+        parcJSON_Release(&document);
+    }
+
+    parcJSONArray_Release(&results);
+    if (baseline != NULL) {
+        parcJSON_Release(&baseline);
+    }
+
+    parcSecurity_Fini();
+
+    if (exitStatus == 0 && regressions > 0) {
+        fprintf(table, "%d benchmark(s) slower than the baseline by more than %.1f%%\n", regressions, threshold);
+        exitStatus = 2;
+    }
+
+    return exitStatus;
+}
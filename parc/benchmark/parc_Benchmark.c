@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Clock.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_JSONArray.h>
+#include <parc/algol/parc_JSONValue.h>
+
+#include <parc/benchmark/parc_Benchmark.h>
+
+const PARCBenchmarkOptions PARCBenchmarkOptions_Default = {
+    .warmupMilliseconds = 100,
+    .sampleMilliseconds = 100,
+    .samples            = 5
+};
+
+/*
+ * The allocation counting memory interface.
+ * It forwards every call to the interface that was installed before it.
+ */
+static const PARCMemoryInterface *_parcBenchmark_Memory;
+static uint64_t _parcBenchmark_Allocations;
+static uint64_t _parcBenchmark_Bytes;
+
+static inline void
+_parcBenchmark_Count(size_t size)
+{
+    __sync_fetch_and_add(&_parcBenchmark_Allocations, 1);
+    __sync_fetch_and_add(&_parcBenchmark_Bytes, (uint64_t) size);
+}
+
+static void *
+_parcBenchmark_Allocate(size_t size)
+{
+    _parcBenchmark_Count(size);
+    return ((PARCMemoryAllocate *) _parcBenchmark_Memory->Allocate)(size);
+}
+
+static void *
+_parcBenchmark_AllocateAndClear(size_t size)
+{
+    _parcBenchmark_Count(size);
+    return ((PARCMemoryAllocateAndClear *) _parcBenchmark_Memory->AllocateAndClear)(size);
+}
+
+static int
+_parcBenchmark_MemAlign(void **pointer, size_t alignment, size_t size)
+{
+    _parcBenchmark_Count(size);
+    return ((PARCMemoryMemAlign *) _parcBenchmark_Memory->MemAlign)(pointer, alignment, size);
+}
+
+static void
+_parcBenchmark_Deallocate(void **pointer)
+{
+    ((PARCMemoryDeallocate *) _parcBenchmark_Memory->Deallocate)(pointer);
+}
+
+static void *
+_parcBenchmark_Reallocate(void *pointer, size_t newSize)
+{
+    _parcBenchmark_Count(newSize);
+    return ((PARCMemoryReallocate *) _parcBenchmark_Memory->Reallocate)(pointer, newSize);
+}
+
+static char *
+_parcBenchmark_StringDuplicate(const char *string, size_t length)
+{
+    _parcBenchmark_Count(length + 1);
+    return ((PARCMemoryStringDuplicate *) _parcBenchmark_Memory->StringDuplicate)(string, length);
+}
+
+static uint32_t
+_parcBenchmark_Outstanding(void)
+{
+    return ((PARCMemoryOutstanding *) _parcBenchmark_Memory->Outstanding)();
+}
+
+static const PARCMemoryInterface _parcBenchmark_CountingMemory = {
+    .Allocate         = (uintptr_t) _parcBenchmark_Allocate,
+    .AllocateAndClear = (uintptr_t) _parcBenchmark_AllocateAndClear,
+    .MemAlign         = (uintptr_t) _parcBenchmark_MemAlign,
+    .Deallocate       = (uintptr_t) _parcBenchmark_Deallocate,
+    .Reallocate       = (uintptr_t) _parcBenchmark_Reallocate,
+    .StringDuplicate  = (uintptr_t) _parcBenchmark_StringDuplicate,
+    .Outstanding      = (uintptr_t) _parcBenchmark_Outstanding
+};
+
+static void
+_parcBenchmark_StartCounting(void)
+{
+    _parcBenchmark_Allocations = 0;
+    _parcBenchmark_Bytes = 0;
+    _parcBenchmark_Memory = parcMemory_SetInterface(&_parcBenchmark_CountingMemory);
+}
+
+static void
+_parcBenchmark_StopCounting(void)
+{
+    parcMemory_SetInterface(_parcBenchmark_Memory);
+}
+
+bool
+parcBenchmark_PinToCPU(int cpu)
+{
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    return false;
+#endif
+}
+
+static uint64_t
+_parcBenchmark_Time(const PARCBenchmark *benchmark, void *context, uint64_t iterations)
+{
+    PARCClock *clock = parcClock_TSC();
+
+    uint64_t start = parcClock_GetTime(clock);
+    benchmark->run(context, iterations);
+    uint64_t elapsed = parcClock_GetTime(clock) - start;
+
+    return (elapsed == 0) ? 1 : elapsed;
+}
+
+/*
+ * Run the benchmark, doubling the number of iterations until one run takes at least a tenth of a sample,
+ * until the warmup time has passed.  Return the number of iterations that takes about one sample time.
+ */
+static uint64_t
+_parcBenchmark_Calibrate(const PARCBenchmark *benchmark, void *context, const PARCBenchmarkOptions *options)
+{
+    uint64_t warmupNanoseconds = options->warmupMilliseconds * 1000000ULL;
+    uint64_t sampleNanoseconds = options->sampleMilliseconds * 1000000ULL;
+
+    uint64_t iterations = 1;
+    uint64_t elapsed = 0;
+    uint64_t total = 0;
+
+    for (;;) {
+        elapsed = _parcBenchmark_Time(benchmark, context, iterations);
+        total += elapsed;
+
+        bool measurable = (elapsed >= sampleNanoseconds / 10);
+        if (measurable && total >= warmupNanoseconds) {
+            break;
+        }
+        if (!measurable) {
+            iterations *= 2;
+        }
+    }
+
+    double perOp = (double) elapsed / (double) iterations;
+    uint64_t result = (uint64_t) ((double) sampleNanoseconds / perOp);
+
+    return (result == 0) ? 1 : result;
+}
+
+static int
+_parcBenchmark_CompareDouble(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x < y) ? -1 : (x > y);
+}
+
+void
+parcBenchmark_Run(const PARCBenchmark *benchmark, const PARCBenchmarkOptions *options, PARCBenchmarkResult *result)
+{
+    assertNotNull(benchmark, "Parameter benchmark must be a non-null PARCBenchmark pointer.");
+    assertNotNull(benchmark->run, "The benchmark %s must have a run function.", benchmark->name);
+    assertNotNull(options, "Parameter options must be a non-null PARCBenchmarkOptions pointer.");
+    assertTrue(options->samples > 0 && options->samples <= PARCBenchmark_MaximumSamples,
+               "The number of samples must be between 1 and %d, actual %u", PARCBenchmark_MaximumSamples, options->samples);
+    assertNotNull(result, "Parameter result must be a non-null PARCBenchmarkResult pointer.");
+
+    void *context = (benchmark->setup != NULL) ? benchmark->setup() : NULL;
+
+    uint64_t iterations = _parcBenchmark_Calibrate(benchmark, context, options);
+
+    double samples[options->samples];
+
+    _parcBenchmark_StartCounting();
+    for (unsigned int i = 0; i < options->samples; i++) {
+        samples[i] = (double) _parcBenchmark_Time(benchmark, context, iterations) / (double) iterations;
+    }
+    _parcBenchmark_StopCounting();
+
+    if (benchmark->teardown != NULL) {
+        benchmark->teardown(context);
+    }
+
+    qsort(samples, options->samples, sizeof(samples[0]), _parcBenchmark_CompareDouble);
+
+    double median = samples[options->samples / 2];
+    if (options->samples % 2 == 0) {
+        median = (median + samples[options->samples / 2 - 1]) / 2.0;
+    }
+
+    double operations = (double) iterations * (double) options->samples;
+
+    result->name = benchmark->name;
+    result->iterations = iterations;
+    result->samples = options->samples;
+    result->nanosecondsPerOp = median;
+    result->minimumNanosecondsPerOp = samples[0];
+    result->maximumNanosecondsPerOp = samples[options->samples - 1];
+    result->opsPerSecond = 1.0e9 / median;
+    result->allocationsPerOp = (double) _parcBenchmark_Allocations / operations;
+    result->bytesPerOp = (double) _parcBenchmark_Bytes / operations;
+}
+
+static void
+_parcBenchmarkResult_AddFloat(PARCJSON *json, const char *name, double value)
+{
+    PARCJSONValue *jsonValue = parcJSONValue_CreateFromFloat(value);
+    parcJSON_AddValue(json, name, jsonValue);
+    parcJSONValue_Release(&jsonValue);
+}
+
+PARCJSON *
+parcBenchmarkResult_ToJSON(const PARCBenchmarkResult *result)
+{
+    PARCJSON *json = parcJSON_Create();
+
+    parcJSON_AddString(json, "name", result->name);
+    parcJSON_AddInteger(json, "iterations", (int64_t) result->iterations);
+    parcJSON_AddInteger(json, "samples", result->samples);
+    _parcBenchmarkResult_AddFloat(json, "nsPerOp", result->nanosecondsPerOp);
+    _parcBenchmarkResult_AddFloat(json, "minimumNsPerOp", result->minimumNanosecondsPerOp);
+    _parcBenchmarkResult_AddFloat(json, "maximumNsPerOp", result->maximumNanosecondsPerOp);
+    _parcBenchmarkResult_AddFloat(json, "opsPerSecond", result->opsPerSecond);
+    _parcBenchmarkResult_AddFloat(json, "allocationsPerOp", result->allocationsPerOp);
+    _parcBenchmarkResult_AddFloat(json, "bytesPerOp", result->bytesPerOp);
+
+    return json;
+}
+
+static bool
+_parcBenchmarkResult_NameEquals(const PARCJSON *entry, const char *name)
+{
+    bool result = false;
+
+    const PARCJSONValue *value = parcJSON_GetValueByName(entry, "name");
+    if (value != NULL && parcJSONValue_IsString(value)) {
+        char *string = parcBuffer_ToString(parcJSONValue_GetString(value));
+        result = (strcmp(string, name) == 0);
+        parcMemory_Deallocate(&string);
+    }
+
+    return result;
+}
+
+bool
+parcBenchmarkResult_CompareToBaseline(const PARCBenchmarkResult *result, const PARCJSON *baseline, double *change)
+{
+    const PARCJSONValue *benchmarks = parcJSON_GetValueByName(baseline, "benchmarks");
+    if (benchmarks == NULL || !parcJSONValue_IsArray(benchmarks)) {
+        return false;
+    }
+
+    PARCJSONArray *array = parcJSONValue_GetArray(benchmarks);
+    for (size_t i = 0; i < parcJSONArray_GetLength(array); i++) {
+        const PARCJSONValue *element = parcJSONArray_GetValue(array, i);
+        if (!parcJSONValue_IsJSON(element)) {
+            continue;
+        }
+        const PARCJSON *entry = parcJSONValue_GetJSON(element);
+        if (_parcBenchmarkResult_NameEquals(entry, result->name)) {
+            const PARCJSONValue *nsPerOp = parcJSON_GetValueByName(entry, "nsPerOp");
+            if (nsPerOp == NULL || !parcJSONValue_IsNumber(nsPerOp)) {
+                return false;
+            }
+            double previous = (double) parcJSONValue_GetFloat(nsPerOp);
+            if (previous <= 0.0) {
+                return false;
+            }
+            *change = (result->nanosecondsPerOp - previous) * 100.0 / previous;
+            return true;
+        }
+    }
+
+    return false;
+}
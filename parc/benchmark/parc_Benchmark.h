@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_Benchmark.h
+ * @brief A microbenchmark harness
+ *
+ * A benchmark is a function that performs an operation a given number of times.
+ * The harness runs it for a warmup period, chooses an iteration count so that one sample takes
+ * about the requested sample time, and then times a number of samples with `parcClock_TSC()`.
+ * The result is the median time of one operation over the samples, the operations per second that implies,
+ * and the number of allocations and bytes allocated per operation.
+ *
+ * Allocations are counted by installing a `PARCMemoryInterface` that counts and forwards each
+ * call to the interface that was previously installed.  Only allocations made through `parcMemory`
+ * are counted, and only while the samples are being taken, not during setup, teardown or warmup.
+ *
+ * The calling thread may be pinned to one CPU with `parcBenchmark_PinToCPU()`.
+ * Threads created by a pinned thread inherit its affinity, so benchmarks that start threads
+ * should be run unpinned.
+ *
+ * @code
+ * {
+ *     static void
+ *     _hashCode(void *context, uint64_t iterations)
+ *     {
+ *         for (uint64_t i = 0; i < iterations; i++) {
+ *             parcBenchmark_Consume(parcBuffer_HashCode(context));
+ *         }
+ *     }
+ *
+ *     PARCBenchmark benchmark = { .name = "PARCBuffer/HashCode", .setup = _setup, .run = _hashCode, .teardown = _teardown };
+ *
+ *     PARCBenchmarkResult result;
+ *     parcBenchmark_Run(&benchmark, &PARCBenchmarkOptions_Default, &result);
+ * }
+ * @endcode
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_Benchmark
+#define PARCLibrary_parc_Benchmark
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_JSON.h>
+
+/**
+ * @typedef PARCBenchmark
+ * @brief A named operation to be timed, with optional setup and teardown of its context.
+ */
+typedef struct parc_benchmark {
+    /**
+     * The name of the benchmark, conventionally "Type/Operation".
+     */
+    const char *name;
+
+    /**
+     * Create the context passed to `run` and `teardown`, or NULL if there is none.
+     * This is called once, before warmup, and is not timed.
+     */
+    void *(*setup)(void);
+
+    /**
+     * Perform the operation `iterations` times.
+     */
+    void (*run)(void *context, uint64_t iterations);
+
+    /**
+     * Release the context created by `setup`, or NULL if there is nothing to release.
+     */
+    void (*teardown)(void *context);
+} PARCBenchmark;
+
+/**
+ * @typedef PARCBenchmarkOptions
+ * @brief How long to warm up and sample a benchmark.
+ */
+typedef struct parc_benchmark_options {
+    unsigned int warmupMilliseconds;
+    unsigned int sampleMilliseconds;
+    unsigned int samples;
+} PARCBenchmarkOptions;
+
+/**
+ * A warmup of 100 milliseconds followed by 5 samples of 100 milliseconds.
+ */
+extern const PARCBenchmarkOptions PARCBenchmarkOptions_Default;
+
+/**
+ * The largest number of samples a `PARCBenchmarkOptions` may specify.
+ */
+#define PARCBenchmark_MaximumSamples 1000
+
+/**
+ * @typedef PARCBenchmarkResult
+ * @brief The measurements of one benchmark.
+ */
+typedef struct parc_benchmark_result {
+    const char *name;
+    uint64_t iterations;
+    unsigned int samples;
+    double nanosecondsPerOp;
+    double minimumNanosecondsPerOp;
+    double maximumNanosecondsPerOp;
+    double opsPerSecond;
+    double allocationsPerOp;
+    double bytesPerOp;
+} PARCBenchmarkResult;
+
+/**
+ * Keep a value live so the compiler cannot discard the computation that produced it.
+ *
+ * @param [in] value Any value.
+ */
+static inline void
+parcBenchmark_Consume(uint64_t value)
+{
+    __asm__ __volatile__ ("" : : "r" (value) : "memory");
+}
+
+/**
+ * Pin the calling thread to the given CPU.
+ *
+ * @param [in] cpu The index of the CPU.
+ *
+ * @return true The thread was pinned.
+ * @return false The thread could not be pinned, or the platform does not support pinning.
+ */
+bool parcBenchmark_PinToCPU(int cpu);
+
+/**
+ * Warm up, calibrate and sample the given benchmark.
+ *
+ * @param [in] benchmark A pointer to a valid `PARCBenchmark`.
+ * @param [in] options A pointer to a valid `PARCBenchmarkOptions`.
+ * @param [out] result A pointer to a `PARCBenchmarkResult` to fill in.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBenchmarkResult result;
+ *     parcBenchmark_Run(&benchmark, &PARCBenchmarkOptions_Default, &result);
+ *     printf("%s %.1f ns/op\n", result.name, result.nanosecondsPerOp);
+ * }
+ * @endcode
+ */
+void parcBenchmark_Run(const PARCBenchmark *benchmark, const PARCBenchmarkOptions *options, PARCBenchmarkResult *result);
+
+/**
+ * Create a JSON representation of the given result.
+ *
+ * @param [in] result A pointer to a `PARCBenchmarkResult`.
+ *
+ * @return A pointer to a `PARCJSON` instance which must be released via `parcJSON_Release()`.
+ */
+PARCJSON *parcBenchmarkResult_ToJSON(const PARCBenchmarkResult *result);
+
+/**
+ * Compare a result with the result of the same benchmark in a baseline.
+ *
+ * The baseline is a JSON object in the form written by the `parc-benchmark` program,
+ * with an array named "benchmarks" of objects produced by `parcBenchmarkResult_ToJSON()`.
+ *
+ * @param [in] result A pointer to a `PARCBenchmarkResult`.
+ * @param [in] baseline A pointer to a `PARCJSON` instance.
+ * @param [out] change Set to the change in nanoseconds per operation relative to the baseline, in percent.
+ *
+ * @return true The baseline has a result for the benchmark, and `change` was set.
+ * @return false The baseline has no result for the benchmark.
+ */
+bool parcBenchmarkResult_CompareToBaseline(const PARCBenchmarkResult *result, const PARCJSON *baseline, double *change);
+#endif // PARCLibrary_parc_Benchmark
@@ -0,0 +1,616 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <string.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_Deque.h>
+#include <parc/algol/parc_HashMap.h>
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_LinkedList.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_PriorityQueue.h>
+#include <parc/algol/parc_TreeMap.h>
+
+#include <parc/benchmark/parc_BenchmarkSuites.h>
+
+#define _parcBenchmarkAlgol_Keys 1024
+
+static void *
+_parcBenchmarkAlgol_Buffer1KSetup(void)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(1024);
+    for (size_t i = 0; i < 1024; i++) {
+        parcBuffer_PutUint8(buffer, (uint8_t) i);
+    }
+    return parcBuffer_Flip(buffer);
+}
+
+static void
+_parcBenchmarkAlgol_BufferTeardown(void *context)
+{
+    PARCBuffer *buffer = context;
+    parcBuffer_Release(&buffer);
+}
+
+static void
+_parcBenchmarkAlgol_BufferAllocate(void *context, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCBuffer *buffer = parcBuffer_Allocate(64);
+        parcBenchmark_Consume((uintptr_t) buffer);
+        parcBuffer_Release(&buffer);
+    }
+}
+
+static void *
+_parcBenchmarkAlgol_Buffer64Setup(void)
+{
+    return parcBuffer_Allocate(64);
+}
+
+static void
+_parcBenchmarkAlgol_BufferPutGetUint64(void *context, uint64_t iterations)
+{
+    PARCBuffer *buffer = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBuffer_SetPosition(buffer, 0);
+        parcBuffer_PutUint64(buffer, i);
+        parcBuffer_Flip(buffer);
+        parcBenchmark_Consume(parcBuffer_GetUint64(buffer));
+        parcBuffer_SetLimit(buffer, parcBuffer_Capacity(buffer));
+    }
+}
+
+static void
+_parcBenchmarkAlgol_BufferHashCode(void *context, uint64_t iterations)
+{
+    PARCBuffer *buffer = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume(parcBuffer_HashCode(buffer));
+    }
+}
+
+static void *
+_parcBenchmarkAlgol_PairSetup(void)
+{
+    PARCBuffer **pair = parcMemory_Allocate(2 * sizeof(PARCBuffer *));
+    pair[0] = _parcBenchmarkAlgol_Buffer1KSetup();
+    pair[1] = parcBuffer_Copy(pair[0]);
+    return pair;
+}
+
+static void
+_parcBenchmarkAlgol_PairTeardown(void *context)
+{
+    PARCBuffer **pair = context;
+    parcBuffer_Release(&pair[0]);
+    parcBuffer_Release(&pair[1]);
+    parcMemory_Deallocate(&pair);
+}
+
+static void
+_parcBenchmarkAlgol_BufferEquals(void *context, uint64_t iterations)
+{
+    PARCBuffer **pair = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume(parcBuffer_Equals(pair[0], pair[1]));
+    }
+}
+
+/*
+ * A map of _parcBenchmarkAlgol_Keys keys, and the same number of keys that are not in the map.
+ * The list and deque hold the same keys, for the iteration and queue benchmarks.
+ */
+typedef struct {
+    PARCHashMap *hashMap;
+    PARCTreeMap *treeMap;
+    PARCLinkedList *list;
+    PARCDeque *deque;
+    PARCBuffer *keys[_parcBenchmarkAlgol_Keys];
+    PARCBuffer *absentKeys[_parcBenchmarkAlgol_Keys];
+} _PARCBenchmarkAlgolMap;
+
+static PARCBuffer *
+_parcBenchmarkAlgol_CreateKey(uint64_t value)
+{
+    PARCBuffer *key = parcBuffer_Allocate(sizeof(uint64_t));
+    parcBuffer_PutUint64(key, value * 0x9E3779B97F4A7C15ULL);
+    return parcBuffer_Flip(key);
+}
+
+static void *
+_parcBenchmarkAlgol_MapSetup(void)
+{
+    _PARCBenchmarkAlgolMap *map = parcMemory_AllocateAndClear(sizeof(_PARCBenchmarkAlgolMap));
+    map->hashMap = parcHashMap_Create();
+    map->treeMap = parcTreeMap_Create();
+    map->list = parcLinkedList_Create();
+    map->deque = parcDeque_Create();
+
+    for (size_t i = 0; i < _parcBenchmarkAlgol_Keys; i++) {
+        map->keys[i] = _parcBenchmarkAlgol_CreateKey(i);
+        map->absentKeys[i] = _parcBenchmarkAlgol_CreateKey(i + _parcBenchmarkAlgol_Keys);
+        parcHashMap_Put(map->hashMap, map->keys[i], map->keys[i]);
+        parcTreeMap_Put(map->treeMap, map->keys[i], map->keys[i]);
+        parcLinkedList_Append(map->list, map->keys[i]);
+        parcDeque_Append(map->deque, map->keys[i]);
+    }
+
+    return map;
+}
+
+static void
+_parcBenchmarkAlgol_MapTeardown(void *context)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    parcHashMap_Release(&map->hashMap);
+    parcTreeMap_Release(&map->treeMap);
+    parcLinkedList_Release(&map->list);
+    parcDeque_Release(&map->deque);
+    for (size_t i = 0; i < _parcBenchmarkAlgol_Keys; i++) {
+        parcBuffer_Release(&map->keys[i]);
+        parcBuffer_Release(&map->absentKeys[i]);
+    }
+    parcMemory_Deallocate(&map);
+}
+
+static void
+_parcBenchmarkAlgol_HashMapGet(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume((uintptr_t) parcHashMap_Get(map->hashMap, map->keys[i % _parcBenchmarkAlgol_Keys]));
+    }
+}
+
+static void
+_parcBenchmarkAlgol_HashMapPutRemove(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCBuffer *key = map->absentKeys[i % _parcBenchmarkAlgol_Keys];
+        parcHashMap_Put(map->hashMap, key, key);
+        parcHashMap_Remove(map->hashMap, key);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_TreeMapGet(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume((uintptr_t) parcTreeMap_Get(map->treeMap, map->keys[i % _parcBenchmarkAlgol_Keys]));
+    }
+}
+
+static void
+_parcBenchmarkAlgol_TreeMapPutRemove(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCBuffer *key = map->absentKeys[i % _parcBenchmarkAlgol_Keys];
+        parcTreeMap_Put(map->treeMap, key, key);
+        PARCObject *value = parcTreeMap_Remove(map->treeMap, key);
+        parcObject_Release(&value);
+    }
+}
+
+/*
+ * The iteration benchmarks count one operation per element visited,
+ * starting a new traversal of the collection whenever the previous one is exhausted.
+ */
+static void
+_parcBenchmarkAlgol_LinkedListCursor(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCLinkedListCursor cursor;
+        parcLinkedListCursor_Init(&cursor, map->list);
+        for (; iterations > 0 && parcLinkedListCursor_HasNext(&cursor); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcLinkedListCursor_Next(&cursor));
+        }
+    }
+}
+
+static void
+_parcBenchmarkAlgol_LinkedListIterator(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCIterator *iterator = parcLinkedList_CreateIterator(map->list);
+        for (; iterations > 0 && parcIterator_HasNext(iterator); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcIterator_Next(iterator));
+        }
+        parcIterator_Release(&iterator);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_HashMapCursor(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCHashMapCursor cursor;
+        parcHashMapCursor_Init(&cursor, map->hashMap);
+        for (; iterations > 0 && parcHashMapCursor_HasNext(&cursor); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcHashMapCursor_Next(&cursor));
+        }
+    }
+}
+
+static void
+_parcBenchmarkAlgol_HashMapIterator(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCIterator *iterator = parcHashMap_CreateKeyIterator(map->hashMap);
+        for (; iterations > 0 && parcIterator_HasNext(iterator); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcIterator_Next(iterator));
+        }
+        parcIterator_Release(&iterator);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_TreeMapCursor(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCTreeMapCursor cursor;
+        parcTreeMapCursor_Init(&cursor, map->treeMap);
+        for (; iterations > 0 && parcTreeMapCursor_HasNext(&cursor); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcTreeMapCursor_Next(&cursor));
+        }
+    }
+}
+
+static void
+_parcBenchmarkAlgol_TreeMapIterator(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCIterator *iterator = parcTreeMap_CreateKeyIterator(map->treeMap);
+        for (; iterations > 0 && parcIterator_HasNext(iterator); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcIterator_Next(iterator));
+        }
+        parcIterator_Release(&iterator);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_DequeIterator(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    while (iterations > 0) {
+        PARCIterator *iterator = parcDeque_Iterator(map->deque);
+        for (; iterations > 0 && parcIterator_HasNext(iterator); iterations--) {
+            parcBenchmark_Consume((uintptr_t) parcIterator_Next(iterator));
+        }
+        parcIterator_Release(&iterator);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_DequeGetAtIndex(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume((uintptr_t) parcDeque_GetAtIndex(map->deque, i % _parcBenchmarkAlgol_Keys));
+    }
+}
+
+/*
+ * The queue benchmarks keep _parcBenchmarkAlgol_Keys elements queued,
+ * and count one operation for each element added and then removed.
+ */
+static void
+_parcBenchmarkAlgol_DequeAppendRemoveFirst(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcDeque_Append(map->deque, parcDeque_RemoveFirst(map->deque));
+    }
+}
+
+static void
+_parcBenchmarkAlgol_DequeAppendRemoveLast(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcDeque_Append(map->deque, map->absentKeys[i % _parcBenchmarkAlgol_Keys]);
+        parcBenchmark_Consume((uintptr_t) parcDeque_RemoveLast(map->deque));
+    }
+}
+
+static void
+_parcBenchmarkAlgol_LinkedListAppendRemoveFirst(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolMap *map = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCObject *object = parcLinkedList_RemoveFirst(map->list);
+        parcLinkedList_Append(map->list, object);
+        parcObject_Release(&object);
+    }
+}
+
+/*
+ * A scheduler of _parcBenchmarkAlgol_Keys timers, each due at a pseudo-random delay after the current time.
+ * The deadline is the first member of a timer, so a timer is also a pointer to its deadline
+ * for parcPriorityQueue_Uint64CompareTo.
+ */
+typedef struct {
+    uint64_t deadline;
+    PARCPriorityQueueHandle handle;
+} _PARCBenchmarkAlgolTimer;
+
+typedef struct {
+    PARCPriorityQueue *queue;
+    uint64_t now;
+    uint64_t random;
+    _PARCBenchmarkAlgolTimer timers[_parcBenchmarkAlgol_Keys];
+} _PARCBenchmarkAlgolScheduler;
+
+static uint64_t
+_parcBenchmarkAlgol_NextDeadline(_PARCBenchmarkAlgolScheduler *scheduler)
+{
+    scheduler->random = scheduler->random * 6364136223846793005ULL + 1442695040888963407ULL;
+    return scheduler->now + 1 + (scheduler->random >> 33) % 1000000;
+}
+
+static void *
+_parcBenchmarkAlgol_SchedulerSetup(bool keyed)
+{
+    _PARCBenchmarkAlgolScheduler *scheduler = parcMemory_AllocateAndClear(sizeof(_PARCBenchmarkAlgolScheduler));
+    scheduler->queue = keyed ? parcPriorityQueue_CreateUint64Key(NULL) : parcPriorityQueue_Create(parcPriorityQueue_Uint64CompareTo, NULL);
+    scheduler->random = 1;
+
+    for (size_t i = 0; i < _parcBenchmarkAlgol_Keys; i++) {
+        _PARCBenchmarkAlgolTimer *timer = &scheduler->timers[i];
+        timer->deadline = _parcBenchmarkAlgol_NextDeadline(scheduler);
+        if (keyed) {
+            timer->handle = parcPriorityQueue_AddWithKey(scheduler->queue, timer->deadline, timer);
+        } else {
+            timer->handle = parcPriorityQueue_AddWithHandle(scheduler->queue, timer);
+        }
+    }
+
+    return scheduler;
+}
+
+static void *
+_parcBenchmarkAlgol_SchedulerCompareSetup(void)
+{
+    return _parcBenchmarkAlgol_SchedulerSetup(false);
+}
+
+static void *
+_parcBenchmarkAlgol_SchedulerKeyedSetup(void)
+{
+    return _parcBenchmarkAlgol_SchedulerSetup(true);
+}
+
+static void
+_parcBenchmarkAlgol_SchedulerTeardown(void *context)
+{
+    _PARCBenchmarkAlgolScheduler *scheduler = context;
+
+    parcPriorityQueue_Destroy(&scheduler->queue);
+    parcMemory_Deallocate(&scheduler);
+}
+
+/*
+ * Run the earliest timer, and schedule it again.
+ */
+static void
+_parcBenchmarkAlgol_SchedulerExpire(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolScheduler *scheduler = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        _PARCBenchmarkAlgolTimer *timer = parcPriorityQueue_Poll(scheduler->queue);
+        scheduler->now = timer->deadline;
+        timer->deadline = _parcBenchmarkAlgol_NextDeadline(scheduler);
+        timer->handle = parcPriorityQueue_AddWithHandle(scheduler->queue, timer);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_SchedulerExpireKeyed(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolScheduler *scheduler = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        _PARCBenchmarkAlgolTimer *timer = parcPriorityQueue_Poll(scheduler->queue);
+        scheduler->now = timer->deadline;
+        timer->deadline = _parcBenchmarkAlgol_NextDeadline(scheduler);
+        timer->handle = parcPriorityQueue_AddWithKey(scheduler->queue, timer->deadline, timer);
+    }
+}
+
+/*
+ * Push back the deadline of an arbitrary timer, as when an idle timeout is reset.
+ */
+static void
+_parcBenchmarkAlgol_SchedulerRescheduleKeyed(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolScheduler *scheduler = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        _PARCBenchmarkAlgolTimer *timer = &scheduler->timers[(i * 7) % _parcBenchmarkAlgol_Keys];
+        timer->deadline = _parcBenchmarkAlgol_NextDeadline(scheduler);
+        parcPriorityQueue_UpdateKey(scheduler->queue, timer->handle, timer->deadline);
+    }
+}
+
+/*
+ * Cancel an arbitrary timer, and start it again.
+ */
+static void
+_parcBenchmarkAlgol_SchedulerCancelKeyed(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkAlgolScheduler *scheduler = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        _PARCBenchmarkAlgolTimer *timer = &scheduler->timers[(i * 7) % _parcBenchmarkAlgol_Keys];
+        parcPriorityQueue_Remove(scheduler->queue, timer->handle);
+        timer->deadline = _parcBenchmarkAlgol_NextDeadline(scheduler);
+        timer->handle = parcPriorityQueue_AddWithKey(scheduler->queue, timer->deadline, timer);
+    }
+}
+
+static const char *_parcBenchmarkAlgol_JSONDocument =
+    "{ \"name\" : \"lci:/parc/benchmark\", \"version\" : 3, \"ratio\" : 0.75, \"enabled\" : true, "
+    "\"tags\" : [ \"a\", \"b\", \"c\" ], "
+    "\"owner\" : { \"organization\" : \"PARC\", \"address\" : \"3333 Coyote Hill Road\", \"id\" : 1234567 } }";
+
+static void
+_parcBenchmarkAlgol_JSONParse(void *context, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCJSON *json = parcJSON_ParseString(_parcBenchmarkAlgol_JSONDocument);
+        parcBenchmark_Consume((uintptr_t) json);
+        parcJSON_Release(&json);
+    }
+}
+
+static void *
+_parcBenchmarkAlgol_JSONSetup(void)
+{
+    return parcJSON_ParseString(_parcBenchmarkAlgol_JSONDocument);
+}
+
+static void
+_parcBenchmarkAlgol_JSONTeardown(void *context)
+{
+    PARCJSON *json = context;
+    parcJSON_Release(&json);
+}
+
+static void
+_parcBenchmarkAlgol_JSONToCompactString(void *context, uint64_t iterations)
+{
+    PARCJSON *json = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        char *string = parcJSON_ToCompactString(json);
+        parcBenchmark_Consume((uintptr_t) string);
+        parcMemory_Deallocate(&string);
+    }
+}
+
+static void
+_parcBenchmarkAlgol_JSONGetByPath(void *context, uint64_t iterations)
+{
+    PARCJSON *json = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume((uintptr_t) parcJSON_GetByPath(json, "/owner/id"));
+    }
+}
+
+const PARCBenchmark parcBenchmarkAlgol_Suite[] = {
+    { .name = "PARCBuffer/Allocate64",      .run = _parcBenchmarkAlgol_BufferAllocate                                                                                                  },
+    { .name = "PARCBuffer/PutGetUint64",    .run = _parcBenchmarkAlgol_BufferPutGetUint64,    .setup = _parcBenchmarkAlgol_Buffer64Setup, .teardown = _parcBenchmarkAlgol_BufferTeardown },
+    { .name = "PARCBuffer/HashCode1K",      .run = _parcBenchmarkAlgol_BufferHashCode,        .setup = _parcBenchmarkAlgol_Buffer1KSetup, .teardown = _parcBenchmarkAlgol_BufferTeardown },
+    { .name = "PARCBuffer/Equals1K",        .run = _parcBenchmarkAlgol_BufferEquals,          .setup = _parcBenchmarkAlgol_PairSetup,     .teardown = _parcBenchmarkAlgol_PairTeardown   },
+    { .name = "PARCHashMap/Get1K",          .run = _parcBenchmarkAlgol_HashMapGet,            .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCHashMap/PutRemove1K",    .run = _parcBenchmarkAlgol_HashMapPutRemove,      .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCTreeMap/Get1K",          .run = _parcBenchmarkAlgol_TreeMapGet,            .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCTreeMap/PutRemove1K",    .run = _parcBenchmarkAlgol_TreeMapPutRemove,      .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCLinkedList/Cursor1K",    .run = _parcBenchmarkAlgol_LinkedListCursor,      .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCLinkedList/Iterator1K",  .run = _parcBenchmarkAlgol_LinkedListIterator,    .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCLinkedList/AppendRemoveFirst1K", .run = _parcBenchmarkAlgol_LinkedListAppendRemoveFirst, .setup = _parcBenchmarkAlgol_MapSetup, .teardown = _parcBenchmarkAlgol_MapTeardown },
+    { .name = "PARCDeque/AppendRemoveFirst1K", .run = _parcBenchmarkAlgol_DequeAppendRemoveFirst, .setup = _parcBenchmarkAlgol_MapSetup,   .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCDeque/AppendRemoveLast1K", .run = _parcBenchmarkAlgol_DequeAppendRemoveLast,  .setup = _parcBenchmarkAlgol_MapSetup,    .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCDeque/Iterator1K",       .run = _parcBenchmarkAlgol_DequeIterator,         .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCDeque/GetAtIndex1K",     .run = _parcBenchmarkAlgol_DequeGetAtIndex,       .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCHashMap/Cursor1K",       .run = _parcBenchmarkAlgol_HashMapCursor,         .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCHashMap/Iterator1K",     .run = _parcBenchmarkAlgol_HashMapIterator,       .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCTreeMap/Cursor1K",       .run = _parcBenchmarkAlgol_TreeMapCursor,         .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCTreeMap/Iterator1K",     .run = _parcBenchmarkAlgol_TreeMapIterator,       .setup = _parcBenchmarkAlgol_MapSetup,      .teardown = _parcBenchmarkAlgol_MapTeardown    },
+    { .name = "PARCPriorityQueue/Expire1K", .run = _parcBenchmarkAlgol_SchedulerExpire,       .setup = _parcBenchmarkAlgol_SchedulerCompareSetup, .teardown = _parcBenchmarkAlgol_SchedulerTeardown },
+    { .name = "PARCPriorityQueue/ExpireKeyed1K", .run = _parcBenchmarkAlgol_SchedulerExpireKeyed, .setup = _parcBenchmarkAlgol_SchedulerKeyedSetup, .teardown = _parcBenchmarkAlgol_SchedulerTeardown },
+    { .name = "PARCPriorityQueue/RescheduleKeyed1K", .run = _parcBenchmarkAlgol_SchedulerRescheduleKeyed, .setup = _parcBenchmarkAlgol_SchedulerKeyedSetup, .teardown = _parcBenchmarkAlgol_SchedulerTeardown },
+    { .name = "PARCPriorityQueue/CancelKeyed1K", .run = _parcBenchmarkAlgol_SchedulerCancelKeyed, .setup = _parcBenchmarkAlgol_SchedulerKeyedSetup, .teardown = _parcBenchmarkAlgol_SchedulerTeardown },
+    { .name = "PARCJSON/ParseString",       .run = _parcBenchmarkAlgol_JSONParse                                                                                                       },
+    { .name = "PARCJSON/ToCompactString",   .run = _parcBenchmarkAlgol_JSONToCompactString,   .setup = _parcBenchmarkAlgol_JSONSetup,     .teardown = _parcBenchmarkAlgol_JSONTeardown   },
+    { .name = "PARCJSON/GetByPath",         .run = _parcBenchmarkAlgol_JSONGetByPath,         .setup = _parcBenchmarkAlgol_JSONSetup,     .teardown = _parcBenchmarkAlgol_JSONTeardown   },
+    { .name = NULL }
+};
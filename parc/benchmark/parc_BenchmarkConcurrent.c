@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/concurrent/parc_FutureTask.h>
+#include <parc/concurrent/parc_RingBuffer_1x1.h>
+#include <parc/concurrent/parc_RingBuffer_NxM.h>
+#include <parc/concurrent/parc_ThreadPool.h>
+
+#include <parc/benchmark/parc_BenchmarkSuites.h>
+
+#define _parcBenchmarkConcurrent_RingSize 1024
+#define _parcBenchmarkConcurrent_PoolSize 2
+#define _parcBenchmarkConcurrent_TaskBatch 64
+
+static void *
+_parcBenchmarkConcurrent_RingBuffer1x1Setup(void)
+{
+    return parcRingBuffer1x1_Create(_parcBenchmarkConcurrent_RingSize, NULL);
+}
+
+static void
+_parcBenchmarkConcurrent_RingBuffer1x1Teardown(void *context)
+{
+    PARCRingBuffer1x1 *ring = context;
+    parcRingBuffer1x1_Release(&ring);
+}
+
+static void
+_parcBenchmarkConcurrent_RingBuffer1x1PutGet(void *context, uint64_t iterations)
+{
+    PARCRingBuffer1x1 *ring = context;
+    void *data;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcRingBuffer1x1_Put(ring, (void *) (uintptr_t) (i + 1));
+        parcRingBuffer1x1_Get(ring, &data);
+        parcBenchmark_Consume((uintptr_t) data);
+    }
+}
+
+/*
+ * Move a number of entries from a producer thread to the benchmark's thread.
+ */
+typedef struct {
+    PARCRingBuffer1x1 *ring;
+    uint64_t count;
+} _PARCBenchmarkConcurrentHandoff;
+
+static void *
+_parcBenchmarkConcurrent_Producer(void *arg)
+{
+    _PARCBenchmarkConcurrentHandoff *handoff = arg;
+
+    for (uint64_t i = 0; i < handoff->count; i++) {
+        while (!parcRingBuffer1x1_Put(handoff->ring, (void *) (uintptr_t) (i + 1))) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void
+_parcBenchmarkConcurrent_RingBuffer1x1Handoff(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkConcurrentHandoff handoff = { .ring = context, .count = iterations };
+
+    pthread_t producer;
+    pthread_create(&producer, NULL, _parcBenchmarkConcurrent_Producer, &handoff);
+
+    void *data;
+    for (uint64_t i = 0; i < iterations; i++) {
+        while (!parcRingBuffer1x1_Get(handoff.ring, &data)) {
+            sched_yield();
+        }
+        parcBenchmark_Consume((uintptr_t) data);
+    }
+
+    pthread_join(producer, NULL);
+}
+
+static void *
+_parcBenchmarkConcurrent_RingBufferNxMSetup(void)
+{
+    return parcRingBufferNxM_Create(_parcBenchmarkConcurrent_RingSize, NULL);
+}
+
+static void
+_parcBenchmarkConcurrent_RingBufferNxMTeardown(void *context)
+{
+    PARCRingBufferNxM *ring = context;
+    parcRingBufferNxM_Release(&ring);
+}
+
+static void
+_parcBenchmarkConcurrent_RingBufferNxMPutGet(void *context, uint64_t iterations)
+{
+    PARCRingBufferNxM *ring = context;
+    void *data;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcRingBufferNxM_Put(ring, (void *) (uintptr_t) (i + 1));
+        parcRingBufferNxM_Get(ring, &data);
+        parcBenchmark_Consume((uintptr_t) data);
+    }
+}
+
+static void *
+_parcBenchmarkConcurrent_ThreadPoolSetup(void)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(_parcBenchmarkConcurrent_PoolSize);
+    return pool;
+}
+
+static void
+_parcBenchmarkConcurrent_ThreadPoolTeardown(void *context)
+{
+    PARCThreadPool *pool = context;
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+}
+
+static void *
+_parcBenchmarkConcurrent_Task(PARCFutureTask *task, void *parameter)
+{
+    return parameter;
+}
+
+/*
+ * Submit tasks in batches and wait for each batch, so one operation is the submission,
+ * execution and completion of one task.
+ */
+static void
+_parcBenchmarkConcurrent_ThreadPoolExecute(void *context, uint64_t iterations)
+{
+    PARCThreadPool *pool = context;
+    PARCFutureTask *tasks[_parcBenchmarkConcurrent_TaskBatch];
+
+    uint64_t remaining = iterations;
+    while (remaining > 0) {
+        size_t batch = (remaining < _parcBenchmarkConcurrent_TaskBatch) ? (size_t) remaining : _parcBenchmarkConcurrent_TaskBatch;
+
+        for (size_t i = 0; i < batch; i++) {
+            tasks[i] = parcFutureTask_Create(_parcBenchmarkConcurrent_Task, NULL);
+            parcThreadPool_Execute(pool, tasks[i]);
+        }
+        for (size_t i = 0; i < batch; i++) {
+            parcFutureTask_Get(tasks[i], PARCTimeout_Never);
+            parcFutureTask_Release(&tasks[i]);
+        }
+        remaining -= batch;
+    }
+}
+
+const PARCBenchmark parcBenchmarkConcurrent_Suite[] = {
+    { .name     = "PARCRingBuffer1x1/PutGet",  .run = _parcBenchmarkConcurrent_RingBuffer1x1PutGet,
+      .setup    = _parcBenchmarkConcurrent_RingBuffer1x1Setup,
+      .teardown = _parcBenchmarkConcurrent_RingBuffer1x1Teardown },
+    { .name     = "PARCRingBuffer1x1/Handoff", .run = _parcBenchmarkConcurrent_RingBuffer1x1Handoff,
+      .setup    = _parcBenchmarkConcurrent_RingBuffer1x1Setup,
+      .teardown = _parcBenchmarkConcurrent_RingBuffer1x1Teardown },
+    { .name     = "PARCRingBufferNxM/PutGet",  .run = _parcBenchmarkConcurrent_RingBufferNxMPutGet,
+      .setup    = _parcBenchmarkConcurrent_RingBufferNxMSetup,
+      .teardown = _parcBenchmarkConcurrent_RingBufferNxMTeardown },
+    { .name     = "PARCThreadPool/Execute",    .run = _parcBenchmarkConcurrent_ThreadPoolExecute,
+      .setup    = _parcBenchmarkConcurrent_ThreadPoolSetup,
+      .teardown = _parcBenchmarkConcurrent_ThreadPoolTeardown },
+    { .name     = NULL }
+};
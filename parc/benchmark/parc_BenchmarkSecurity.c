@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_InMemoryVerifier.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_PublicKeySigner.h>
+#include <parc/security/parc_Signer.h>
+#include <parc/security/parc_Verifier.h>
+
+#include <parc/benchmark/parc_BenchmarkSuites.h>
+
+static void *
+_parcBenchmarkSecurity_Buffer64Setup(void)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(64);
+    for (size_t i = 0; i < 64; i++) {
+        parcBuffer_PutUint8(buffer, (uint8_t) i);
+    }
+    return parcBuffer_Flip(buffer);
+}
+
+static void *
+_parcBenchmarkSecurity_Buffer4KSetup(void)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(4096);
+    for (size_t i = 0; i < 4096; i++) {
+        parcBuffer_PutUint8(buffer, (uint8_t) i);
+    }
+    return parcBuffer_Flip(buffer);
+}
+
+static void
+_parcBenchmarkSecurity_BufferTeardown(void *context)
+{
+    PARCBuffer *buffer = context;
+    parcBuffer_Release(&buffer);
+}
+
+static void
+_parcBenchmarkSecurity_Hash(const PARCBuffer *buffer, PARCCryptoHashType type, uint64_t iterations)
+{
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCCryptoHash *hash = parcCryptoHasher_HashBuffer(type, buffer);
+        parcBenchmark_Consume((uintptr_t) hash);
+        parcCryptoHash_Release(&hash);
+    }
+}
+
+static void
+_parcBenchmarkSecurity_SHA256(void *context, uint64_t iterations)
+{
+    _parcBenchmarkSecurity_Hash(context, PARCCryptoHashType_SHA256, iterations);
+}
+
+static void
+_parcBenchmarkSecurity_SHA512(void *context, uint64_t iterations)
+{
+    _parcBenchmarkSecurity_Hash(context, PARCCryptoHashType_SHA512, iterations);
+}
+
+static void
+_parcBenchmarkSecurity_CRC32C(void *context, uint64_t iterations)
+{
+    _parcBenchmarkSecurity_Hash(context, PARCCryptoHashType_CRC32C, iterations);
+}
+
+/*
+ * An RSA signer with a freshly generated key, a verifier that knows its public key,
+ * a digest and its signature.
+ */
+typedef struct {
+    PARCSigner *signer;
+    PARCVerifier *verifier;
+    PARCKeyId *keyId;
+    PARCCryptoHash *digest;
+    PARCSignature *signature;
+} _PARCBenchmarkSecurityRSA;
+
+static void *
+_parcBenchmarkSecurity_RSASetup(void)
+{
+    const char *directory = getenv("TMPDIR");
+    char *fileName = parcMemory_Format("%s/parc-benchmark-XXXXXX", (directory != NULL) ? directory : "/tmp");
+    int fd = mkstemp(fileName);
+    assertTrue(fd >= 0, "Cannot create a temporary key store file %s", fileName);
+    close(fd);
+
+    bool created = parcPkcs12KeyStore_CreateFile(fileName, "benchmark", "parc-benchmark", 1024, 1);
+    assertTrue(created, "Cannot create the key store %s", fileName);
+
+    PARCPkcs12KeyStore *pkcs12KeyStore = parcPkcs12KeyStore_Open(fileName, "benchmark", PARCCryptoHashType_SHA256);
+    PARCKeyStore *keyStore = parcKeyStore_Create(pkcs12KeyStore, PARCPkcs12KeyStoreAsKeyStore);
+    parcPkcs12KeyStore_Release(&pkcs12KeyStore);
+    unlink(fileName);
+    parcMemory_Deallocate(&fileName);
+
+    PARCPublicKeySigner *publicKeySigner = parcPublicKeySigner_Create(keyStore, PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256);
+    parcKeyStore_Release(&keyStore);
+
+    _PARCBenchmarkSecurityRSA *rsa = parcMemory_AllocateAndClear(sizeof(_PARCBenchmarkSecurityRSA));
+    rsa->signer = parcSigner_Create(publicKeySigner, PARCPublicKeySignerAsSigner);
+    parcPublicKeySigner_Release(&publicKeySigner);
+
+    PARCInMemoryVerifier *inMemoryVerifier = parcInMemoryVerifier_Create();
+    rsa->verifier = parcVerifier_Create(inMemoryVerifier, PARCInMemoryVerifierAsVerifier);
+    parcInMemoryVerifier_Release(&inMemoryVerifier);
+
+    PARCKey *key = parcSigner_CreatePublicKey(rsa->signer);
+    parcVerifier_AddKey(rsa->verifier, key);
+    rsa->keyId = parcKeyId_Acquire(parcKey_GetKeyId(key));
+    parcKey_Release(&key);
+
+    PARCBuffer *content = _parcBenchmarkSecurity_Buffer64Setup();
+    rsa->digest = parcCryptoHasher_HashBuffer(PARCCryptoHashType_SHA256, content);
+    parcBuffer_Release(&content);
+
+    rsa->signature = parcSigner_SignDigest(rsa->signer, rsa->digest);
+
+    return rsa;
+}
+
+static void
+_parcBenchmarkSecurity_RSATeardown(void *context)
+{
+    _PARCBenchmarkSecurityRSA *rsa = context;
+
+    parcSignature_Release(&rsa->signature);
+    parcCryptoHash_Release(&rsa->digest);
+    parcKeyId_Release(&rsa->keyId);
+    parcVerifier_Release(&rsa->verifier);
+    parcSigner_Release(&rsa->signer);
+    parcMemory_Deallocate(&rsa);
+}
+
+static void
+_parcBenchmarkSecurity_RSASign(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkSecurityRSA *rsa = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        PARCSignature *signature = parcSigner_SignDigest(rsa->signer, rsa->digest);
+        parcBenchmark_Consume((uintptr_t) signature);
+        parcSignature_Release(&signature);
+    }
+}
+
+static void
+_parcBenchmarkSecurity_RSAVerify(void *context, uint64_t iterations)
+{
+    _PARCBenchmarkSecurityRSA *rsa = context;
+
+    for (uint64_t i = 0; i < iterations; i++) {
+        parcBenchmark_Consume(parcVerifier_VerifyDigestSignature(rsa->verifier, rsa->keyId, rsa->digest,
+                                                                 PARCCryptoSuite_RSA_SHA256, rsa->signature));
+    }
+}
+
+const PARCBenchmark parcBenchmarkSecurity_Suite[] = {
+    { .name = "PARCCryptoHasher/SHA256-64", .run = _parcBenchmarkSecurity_SHA256,    .setup = _parcBenchmarkSecurity_Buffer64Setup, .teardown = _parcBenchmarkSecurity_BufferTeardown },
+    { .name = "PARCCryptoHasher/SHA256-4K", .run = _parcBenchmarkSecurity_SHA256,    .setup = _parcBenchmarkSecurity_Buffer4KSetup, .teardown = _parcBenchmarkSecurity_BufferTeardown },
+    { .name = "PARCCryptoHasher/SHA512-4K", .run = _parcBenchmarkSecurity_SHA512,    .setup = _parcBenchmarkSecurity_Buffer4KSetup, .teardown = _parcBenchmarkSecurity_BufferTeardown },
+    { .name = "PARCCryptoHasher/CRC32C-4K", .run = _parcBenchmarkSecurity_CRC32C,    .setup = _parcBenchmarkSecurity_Buffer4KSetup, .teardown = _parcBenchmarkSecurity_BufferTeardown },
+    { .name = "PARCSigner/RSA1024-SHA256",  .run = _parcBenchmarkSecurity_RSASign,   .setup = _parcBenchmarkSecurity_RSASetup,      .teardown = _parcBenchmarkSecurity_RSATeardown    },
+    { .name = "PARCVerifier/RSA1024-SHA256", .run = _parcBenchmarkSecurity_RSAVerify, .setup = _parcBenchmarkSecurity_RSASetup,      .teardown = _parcBenchmarkSecurity_RSATeardown    },
+    { .name = NULL }
+};
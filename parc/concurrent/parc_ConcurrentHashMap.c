@@ -0,0 +1,463 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Lookups run inside a PARCEpoch critical section rather than under a lock.
+ * Writers unlink entries under a stripe lock and hand them to PARCEpoch,
+ * which releases them once no lookup that could have seen them is still running.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <pthread.h>
+#include <stdint.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_DisplayIndented.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/concurrent/parc_ConcurrentHashMap.h>
+#include <parc/concurrent/parc_Epoch.h>
+
+// The number of independently locked stripes, a power of 2.
+#define _STRIPES 64
+
+// The default number of buckets, and never fewer than one bucket per stripe.
+#define _DEFAULT_CAPACITY 256
+
+#define _CACHE_LINE 64
+
+typedef struct parc_concurrent_hashmap_entry {
+    struct parc_concurrent_hashmap_entry *next;
+    PARCHashCode hashCode;
+    PARCObject *key;
+    PARCObject *value;
+} _PARCConcurrentHashMapEntry;
+
+typedef struct parc_concurrent_hashmap_table {
+    size_t capacity;
+    _PARCConcurrentHashMapEntry *buckets[];
+} _PARCConcurrentHashMapTable;
+
+typedef union {
+    struct {
+        pthread_mutex_t mutex;
+        size_t size;
+    };
+    char pad[((sizeof(pthread_mutex_t) + sizeof(size_t) + _CACHE_LINE - 1) / _CACHE_LINE) * _CACHE_LINE];
+} _PARCConcurrentHashMapStripe;
+
+struct PARCConcurrentHashMap {
+    _PARCConcurrentHashMapTable *volatile table;
+    _PARCConcurrentHashMapStripe stripes[_STRIPES];
+};
+
+static size_t
+_parcConcurrentHashMap_Bucket(const _PARCConcurrentHashMapTable *table, PARCHashCode hashCode)
+{
+    uint64_t mixed = (uint64_t) hashCode * 0x9E3779B97F4A7C15ULL;
+    return (size_t) (mixed ^ (mixed >> 32)) & (table->capacity - 1);
+}
+
+static _PARCConcurrentHashMapStripe *
+_parcConcurrentHashMap_Stripe(PARCConcurrentHashMap *map, PARCHashCode hashCode)
+{
+    // Buckets are at least as many as stripes and both are powers of 2,
+    // so every bucket of a stripe stays in the same stripe as the table grows.
+    uint64_t mixed = (uint64_t) hashCode * 0x9E3779B97F4A7C15ULL;
+    return &map->stripes[(mixed ^ (mixed >> 32)) & (_STRIPES - 1)];
+}
+
+static _PARCConcurrentHashMapTable *
+_parcConcurrentHashMapTable_Create(size_t capacity)
+{
+    size_t bytes = sizeof(_PARCConcurrentHashMapTable) + capacity * sizeof(_PARCConcurrentHashMapEntry *);
+    _PARCConcurrentHashMapTable *result = parcMemory_AllocateAndClear(bytes);
+    trapOutOfMemoryIf(result == NULL, "parcMemory_AllocateAndClear(%zu) returned NULL", bytes);
+    result->capacity = capacity;
+    return result;
+}
+
+static _PARCConcurrentHashMapEntry *
+_parcConcurrentHashMapEntry_Create(PARCHashCode hashCode, const PARCObject *key, const PARCObject *value)
+{
+    _PARCConcurrentHashMapEntry *result = parcMemory_Allocate(sizeof(_PARCConcurrentHashMapEntry));
+    trapOutOfMemoryIf(result == NULL, "parcMemory_Allocate(%zu) returned NULL", sizeof(_PARCConcurrentHashMapEntry));
+    result->next = NULL;
+    result->hashCode = hashCode;
+    result->key = parcObject_Acquire(key);
+    result->value = parcObject_Acquire(value);
+    return result;
+}
+
+static void
+_parcConcurrentHashMapEntry_Destroy(_PARCConcurrentHashMapEntry **entryPtr)
+{
+    _PARCConcurrentHashMapEntry *entry = *entryPtr;
+    parcObject_Release(&entry->key);
+    parcObject_Release(&entry->value);
+    parcMemory_Deallocate((void **) entryPtr);
+}
+
+static void
+_parcConcurrentHashMap_DestroyEntry(void *entry)
+{
+    _parcConcurrentHashMapEntry_Destroy((_PARCConcurrentHashMapEntry **) &entry);
+}
+
+static void
+_parcConcurrentHashMap_DestroyTable(void *table)
+{
+    parcMemory_Deallocate(&table);
+}
+
+/**
+ * Defer the destruction of a table that readers may still be walking, and all of its entries.
+ */
+static void
+_parcConcurrentHashMap_DeferTable(_PARCConcurrentHashMapTable *table)
+{
+    for (size_t b = 0; b < table->capacity; b++) {
+        for (_PARCConcurrentHashMapEntry *entry = table->buckets[b]; entry != NULL; entry = entry->next) {
+            parcEpoch_Defer(_parcConcurrentHashMap_DestroyEntry, entry);
+        }
+    }
+    parcEpoch_Defer(_parcConcurrentHashMap_DestroyTable, table);
+}
+
+static void
+_parcConcurrentHashMap_Publish(_PARCConcurrentHashMapEntry **link, _PARCConcurrentHashMapEntry *entry)
+{
+    // The entry must be fully initialised before a reader can reach it.
+    __sync_synchronize();
+    *(_PARCConcurrentHashMapEntry *volatile *) link = entry;
+}
+
+static _PARCConcurrentHashMapEntry *
+_parcConcurrentHashMap_Find(const _PARCConcurrentHashMapTable *table, PARCHashCode hashCode, const PARCObject *key)
+{
+    _PARCConcurrentHashMapEntry *entry = *(_PARCConcurrentHashMapEntry *volatile *) &table->buckets[_parcConcurrentHashMap_Bucket(table, hashCode)];
+    while (entry != NULL) {
+        if (entry->hashCode == hashCode && parcObject_Equals(entry->key, key)) {
+            return entry;
+        }
+        entry = *(_PARCConcurrentHashMapEntry *volatile *) &entry->next;
+    }
+    return NULL;
+}
+
+/**
+ * Double the number of buckets of a table that has the given capacity.  The caller holds no stripe lock.
+ *
+ * The new table is populated with copies of the entries, so readers still walking the old table
+ * see its chains unchanged, and the old table and entries are deferred to PARCEpoch.
+ */
+static void
+_parcConcurrentHashMap_Expand(PARCConcurrentHashMap *map, size_t capacity)
+{
+    // Stripes are always locked in index order, so concurrent expansions cannot deadlock.
+    for (int i = 0; i < _STRIPES; i++) {
+        pthread_mutex_lock(&map->stripes[i].mutex);
+    }
+
+    _PARCConcurrentHashMapTable *oldTable = map->table;
+
+    // Another writer may have expanded the table while this one waited for the stripes.
+    if (oldTable->capacity == capacity) {
+        _PARCConcurrentHashMapTable *newTable = _parcConcurrentHashMapTable_Create(oldTable->capacity * 2);
+
+        for (size_t b = 0; b < oldTable->capacity; b++) {
+            for (_PARCConcurrentHashMapEntry *entry = oldTable->buckets[b]; entry != NULL; entry = entry->next) {
+                _PARCConcurrentHashMapEntry *copy = _parcConcurrentHashMapEntry_Create(entry->hashCode, entry->key, entry->value);
+                size_t bucket = _parcConcurrentHashMap_Bucket(newTable, entry->hashCode);
+                copy->next = newTable->buckets[bucket];
+                newTable->buckets[bucket] = copy;
+            }
+        }
+
+        __sync_synchronize();
+        map->table = newTable;
+    } else {
+        oldTable = NULL;
+    }
+
+    for (int i = 0; i < _STRIPES; i++) {
+        pthread_mutex_unlock(&map->stripes[i].mutex);
+    }
+
+    // No writer uses the old table any more, so its chains can be walked without the stripe locks.
+    // Deferring may run other deferred releases, which must not happen while every stripe is locked.
+    if (oldTable != NULL) {
+        _parcConcurrentHashMap_DeferTable(oldTable);
+    }
+}
+
+static void
+_parcConcurrentHashMap_Finalize(PARCConcurrentHashMap **instancePtr)
+{
+    assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCConcurrentHashMap pointer.");
+    PARCConcurrentHashMap *map = *instancePtr;
+
+    _PARCConcurrentHashMapTable *table = map->table;
+    for (size_t b = 0; b < table->capacity; b++) {
+        _PARCConcurrentHashMapEntry *entry = table->buckets[b];
+        while (entry != NULL) {
+            _PARCConcurrentHashMapEntry *next = entry->next;
+            _parcConcurrentHashMapEntry_Destroy(&entry);
+            entry = next;
+        }
+    }
+    parcMemory_Deallocate((void **) &table);
+
+    for (int i = 0; i < _STRIPES; i++) {
+        pthread_mutex_destroy(&map->stripes[i].mutex);
+    }
+}
+
+parcObject_ImplementAcquire(parcConcurrentHashMap, PARCConcurrentHashMap);
+
+parcObject_ImplementRelease(parcConcurrentHashMap, PARCConcurrentHashMap);
+
+parcObject_ExtendPARCObject(PARCConcurrentHashMap, _parcConcurrentHashMap_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
+
+void
+parcConcurrentHashMap_AssertValid(const PARCConcurrentHashMap *instance)
+{
+    assertTrue(parcConcurrentHashMap_IsValid(instance),
+               "PARCConcurrentHashMap is not valid.");
+}
+
+bool
+parcConcurrentHashMap_IsValid(const PARCConcurrentHashMap *instance)
+{
+    bool result = false;
+
+    if (instance != NULL) {
+        result = (instance->table != NULL);
+    }
+
+    return result;
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_CreateCapacity(size_t capacity)
+{
+    PARCConcurrentHashMap *result = parcObject_CreateAndClearInstance(PARCConcurrentHashMap);
+
+    if (result != NULL) {
+        // Size the table so the requested number of entries stays under the 75% load factor.
+        size_t buckets = _STRIPES;
+        while (buckets * 3 / 4 < capacity) {
+            buckets *= 2;
+        }
+        result->table = _parcConcurrentHashMapTable_Create(buckets);
+
+        for (int i = 0; i < _STRIPES; i++) {
+            pthread_mutex_init(&result->stripes[i].mutex, NULL);
+        }
+    }
+
+    return result;
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_Create(void)
+{
+    return parcConcurrentHashMap_CreateCapacity(_DEFAULT_CAPACITY * 3 / 4);
+}
+
+PARCConcurrentHashMap *
+parcConcurrentHashMap_Put(PARCConcurrentHashMap *map, const PARCObject *key, const PARCObject *value)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+    assertNotNull(key, "Parameter key must be non-null");
+    assertNotNull(value, "Parameter value must be non-null");
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+    _PARCConcurrentHashMapStripe *stripe = _parcConcurrentHashMap_Stripe(map, hashCode);
+    _PARCConcurrentHashMapEntry *entry = _parcConcurrentHashMapEntry_Create(hashCode, key, value);
+    _PARCConcurrentHashMapEntry *replaced = NULL;
+    size_t expandCapacity = 0;
+
+    pthread_mutex_lock(&stripe->mutex);
+
+    _PARCConcurrentHashMapTable *table = map->table;
+    _PARCConcurrentHashMapEntry **link = &table->buckets[_parcConcurrentHashMap_Bucket(table, hashCode)];
+    while (*link != NULL && !((*link)->hashCode == hashCode && parcObject_Equals((*link)->key, key))) {
+        link = &(*link)->next;
+    }
+
+    if (*link != NULL) {
+        // Replace the existing entry rather than modify it, a reader may be looking at it.
+        replaced = *link;
+        entry->next = replaced->next;
+        _parcConcurrentHashMap_Publish(link, entry);
+    } else {
+        entry->next = table->buckets[_parcConcurrentHashMap_Bucket(table, hashCode)];
+        _parcConcurrentHashMap_Publish(&table->buckets[_parcConcurrentHashMap_Bucket(table, hashCode)], entry);
+        stripe->size++;
+
+        // The stripe's share of the 75% load factor, at least one entry so a small table does not grow on its first put.
+        size_t threshold = table->capacity * 3 / (4 * _STRIPES);
+        if (stripe->size > ((threshold > 0) ? threshold : 1)) {
+            expandCapacity = table->capacity;
+        }
+    }
+
+    pthread_mutex_unlock(&stripe->mutex);
+
+    if (replaced != NULL) {
+        parcEpoch_Defer(_parcConcurrentHashMap_DestroyEntry, replaced);
+    }
+
+    if (expandCapacity > 0) {
+        _parcConcurrentHashMap_Expand(map, expandCapacity);
+    }
+
+    return map;
+}
+
+PARCObject *
+parcConcurrentHashMap_Get(const PARCConcurrentHashMap *map, const PARCObject *key)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+    assertNotNull(key, "Parameter key must be non-null");
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+    PARCObject *result = NULL;
+
+    parcEpoch_Enter();
+    _PARCConcurrentHashMapEntry *entry = _parcConcurrentHashMap_Find(map->table, hashCode, key);
+    if (entry != NULL) {
+        // The entry holds a reference to the value until it is reclaimed, which cannot happen before parcEpoch_Exit.
+        result = parcObject_Acquire(entry->value);
+    }
+    parcEpoch_Exit();
+
+    return result;
+}
+
+bool
+parcConcurrentHashMap_Contains(const PARCConcurrentHashMap *map, const PARCObject *key)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+    assertNotNull(key, "Parameter key must be non-null");
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+
+    parcEpoch_Enter();
+    bool result = _parcConcurrentHashMap_Find(map->table, hashCode, key) != NULL;
+    parcEpoch_Exit();
+
+    return result;
+}
+
+bool
+parcConcurrentHashMap_Remove(PARCConcurrentHashMap *map, const PARCObject *key)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+    assertNotNull(key, "Parameter key must be non-null");
+
+    PARCHashCode hashCode = parcObject_HashCode(key);
+    _PARCConcurrentHashMapStripe *stripe = _parcConcurrentHashMap_Stripe(map, hashCode);
+    _PARCConcurrentHashMapEntry *removed = NULL;
+
+    pthread_mutex_lock(&stripe->mutex);
+
+    _PARCConcurrentHashMapTable *table = map->table;
+    _PARCConcurrentHashMapEntry **link = &table->buckets[_parcConcurrentHashMap_Bucket(table, hashCode)];
+    while (*link != NULL && !((*link)->hashCode == hashCode && parcObject_Equals((*link)->key, key))) {
+        link = &(*link)->next;
+    }
+
+    if (*link != NULL) {
+        // The removed entry keeps its next pointer, so a reader standing on it can still finish its walk.
+        removed = *link;
+        _parcConcurrentHashMap_Publish(link, removed->next);
+        stripe->size--;
+    }
+
+    pthread_mutex_unlock(&stripe->mutex);
+
+    if (removed != NULL) {
+        parcEpoch_Defer(_parcConcurrentHashMap_DestroyEntry, removed);
+    }
+
+    return removed != NULL;
+}
+
+size_t
+parcConcurrentHashMap_Size(const PARCConcurrentHashMap *map)
+{
+    parcConcurrentHashMap_OptionalAssertValid(map);
+
+    size_t result = 0;
+    for (int i = 0; i < _STRIPES; i++) {
+        result += *(volatile size_t *) &map->stripes[i].size;
+    }
+    return result;
+}
+
+void
+parcConcurrentHashMap_Display(const PARCConcurrentHashMap *map, int indentation)
+{
+    parcDisplayIndented_PrintLine(indentation, "PARCConcurrentHashMap@%p {", map);
+    parcDisplayIndented_PrintLine(indentation + 1, ".size=%zu, .capacity=%zu",
+                                  parcConcurrentHashMap_Size(map), map->table->capacity);
+    parcDisplayIndented_PrintLine(indentation, "}");
+}
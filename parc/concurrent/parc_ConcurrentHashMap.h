@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_ConcurrentHashMap.h
+ * @ingroup threading
+ * @brief A hash map of PARCObject keys and values for many reader and few writer threads
+ *
+ * A `PARCConcurrentHashMap` has the key and value semantics of {@link PARCHashMap}:
+ * keys and values are PARC Objects, compared with `parcObject_Equals` and hashed with `parcObject_HashCode`,
+ * and the map holds a reference to each key and value it contains.
+ *
+ * Lookups take no locks.  Modifications lock one of a fixed set of stripes, chosen by the key's hash code,
+ * so writers of different keys rarely contend, and the table grows by locking every stripe.
+ * Entries are never modified once they are visible to readers: replacing a value links a new entry in place of the old one.
+ * Lookups run inside a {@link parcEpoch_Enter} critical section, and unlinked entries are handed to
+ * {@link parcEpoch_Defer}, so they are released only after every lookup that could still be reading them has finished.
+ * Call {@link parcEpoch_Barrier} to wait for the release of everything a thread has removed.
+ *
+ * Because another thread may remove a key at any time, {@link parcConcurrentHashMap_Get} returns a new reference
+ * to the value, which the caller must release.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_ConcurrentHashMap
+#define PARCLibrary_parc_ConcurrentHashMap
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_Object.h>
+
+struct PARCConcurrentHashMap;
+typedef struct PARCConcurrentHashMap PARCConcurrentHashMap;
+
+/**
+ * Increase the number of references to a `PARCConcurrentHashMap` instance.
+ *
+ * Note that new `PARCConcurrentHashMap` is not created,
+ * only that the given `PARCConcurrentHashMap` reference count is incremented.
+ * Discard the reference by invoking `parcConcurrentHashMap_Release`.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * @return The same value as @p instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     PARCConcurrentHashMap *b = parcConcurrentHashMap_Acquire(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ *     parcConcurrentHashMap_Release(&b);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Acquire(const PARCConcurrentHashMap *instance);
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcConcurrentHashMap_OptionalAssertValid(_instance_)
+#else
+#  define parcConcurrentHashMap_OptionalAssertValid(_instance_) parcConcurrentHashMap_AssertValid(_instance_)
+#endif
+
+/**
+ * Assert that the given `PARCConcurrentHashMap` instance is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCConcurrentHashMap instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *a = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_AssertValid(a);
+ *
+ *     parcConcurrentHashMap_Release(&a);
+ * }
+ * @endcode
+ */
+void parcConcurrentHashMap_AssertValid(const PARCConcurrentHashMap *instance);
+
+/**
+ * Determine if an instance of `PARCConcurrentHashMap` is valid.
+ *
+ * @param [in] instance A pointer to a `PARCConcurrentHashMap` instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ */
+bool parcConcurrentHashMap_IsValid(const PARCConcurrentHashMap *instance);
+
+/**
+ * Create an instance of `PARCConcurrentHashMap` with a default initial capacity.
+ *
+ * @return non-NULL A pointer to a valid `PARCConcurrentHashMap` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_Release(&map);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Create(void);
+
+/**
+ * Create an instance of `PARCConcurrentHashMap` with room for at least the given number of entries before it grows.
+ *
+ * @param [in] capacity The number of entries to size the map for.
+ *
+ * @return non-NULL A pointer to a valid `PARCConcurrentHashMap` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *map = parcConcurrentHashMap_CreateCapacity(100000);
+ *
+ *     parcConcurrentHashMap_Release(&map);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_CreateCapacity(size_t capacity);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and the instance's implementation will perform
+ * additional cleanup and release other privately held references.
+ *
+ * No other thread may be using the map when the last reference is released.
+ * Entries the map has already unlinked are still released through PARCEpoch.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+ *
+ *     parcConcurrentHashMap_Release(&map);
+ * }
+ * @endcode
+ */
+void parcConcurrentHashMap_Release(PARCConcurrentHashMap **instancePtr);
+
+/**
+ * Associate the given value with the given key, replacing any value previously associated with the key.
+ *
+ * The map acquires a reference to both @p key and @p value, and releases the reference to a replaced value
+ * through {@link parcEpoch_Defer}, once no concurrent lookup can still be using it.
+ *
+ * @param [in] map A pointer to a valid `PARCConcurrentHashMap` instance.
+ * @param [in] key A pointer to a valid PARC Object.
+ * @param [in] value A pointer to a valid PARC Object.
+ *
+ * @return The value of @p map.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+ *     PARCBuffer *key = parcBuffer_WrapCString("key");
+ *     PARCBuffer *value = parcBuffer_WrapCString("value");
+ *
+ *     parcConcurrentHashMap_Put(map, key, value);
+ *
+ *     parcBuffer_Release(&key);
+ *     parcBuffer_Release(&value);
+ *     parcConcurrentHashMap_Release(&map);
+ * }
+ * @endcode
+ */
+PARCConcurrentHashMap *parcConcurrentHashMap_Put(PARCConcurrentHashMap *map, const PARCObject *key, const PARCObject *value);
+
+/**
+ * Get a new reference to the value associated with the given key.
+ *
+ * This takes no locks and may run concurrently with any other operation on the map.
+ * The caller must release the returned reference.
+ *
+ * @param [in] map A pointer to a valid `PARCConcurrentHashMap` instance.
+ * @param [in] key A pointer to a valid PARC Object.
+ *
+ * @return NULL The key is not in the map.
+ * @return non-NULL A new reference to the value associated with @p key.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *value = parcConcurrentHashMap_Get(map, key);
+ *     if (value != NULL) {
+ *         ...
+ *         parcBuffer_Release(&value);
+ *     }
+ * }
+ * @endcode
+ */
+PARCObject *parcConcurrentHashMap_Get(const PARCConcurrentHashMap *map, const PARCObject *key);
+
+/**
+ * Determine if the given key is in the map.
+ *
+ * This takes no locks.
+ *
+ * @param [in] map A pointer to a valid `PARCConcurrentHashMap` instance.
+ * @param [in] key A pointer to a valid PARC Object.
+ *
+ * @return true The key was in the map.
+ * @return false The key was not in the map.
+ */
+bool parcConcurrentHashMap_Contains(const PARCConcurrentHashMap *map, const PARCObject *key);
+
+/**
+ * Remove the given key and its value from the map.
+ *
+ * @param [in] map A pointer to a valid `PARCConcurrentHashMap` instance.
+ * @param [in] key A pointer to a valid PARC Object.
+ *
+ * @return true The key was in the map and has been removed.
+ * @return false The key was not in the map.
+ */
+bool parcConcurrentHashMap_Remove(PARCConcurrentHashMap *map, const PARCObject *key);
+
+/**
+ * Get the number of entries in the map.
+ *
+ * While other threads are modifying the map the result is only an estimate.
+ *
+ * @param [in] map A pointer to a valid `PARCConcurrentHashMap` instance.
+ *
+ * @return The number of entries in the map.
+ */
+size_t parcConcurrentHashMap_Size(const PARCConcurrentHashMap *map);
+
+/**
+ * Print a human readable representation of the given `PARCConcurrentHashMap`.
+ *
+ * @param [in] map A pointer to a valid `PARCConcurrentHashMap` instance.
+ * @param [in] indentation The indentation level to use for printing.
+ */
+void parcConcurrentHashMap_Display(const PARCConcurrentHashMap *map, int indentation);
+#endif // PARCLibrary_parc_ConcurrentHashMap
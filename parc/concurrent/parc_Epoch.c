@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * Each thread that uses PARCEpoch owns a record on a global registry.
+ * The record announces whether the thread is inside a critical section and, if so, the epoch it observed on entry.
+ * The global epoch may advance from e to e + 1 only when every active record announces e.
+ * An element deferred while the global epoch is e is therefore safe to reclaim once the epoch reaches e + 2:
+ * every thread that was active when it was deferred has left its critical section since.
+ *
+ * Records are never freed.  A thread's record is returned to the registry when the thread exits
+ * and is reused by the next thread to start, so the registry is as long as the largest number of threads
+ * that have used PARCEpoch at the same time.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/concurrent/parc_Epoch.h>
+
+// A thread collects once it has this many more elements pending than after its last collection.
+#define _COLLECT_THRESHOLD 64
+
+typedef struct parc_epoch_deferred {
+    struct parc_epoch_deferred *next;
+    uint64_t epoch;
+    void (*function)(void *pointer);
+    void *pointer;
+} _PARCEpochDeferred;
+
+typedef struct {
+    _PARCEpochDeferred *head;
+    _PARCEpochDeferred *tail;
+    size_t length;
+} _PARCEpochLimbo;
+
+typedef struct parc_epoch_record {
+    // The observed epoch shifted left one bit, with the low bit set while the thread is in a critical section.
+    volatile uint64_t state;
+
+    // Set while a thread owns this record.
+    volatile int inUse;
+
+    // The rest is private to the owning thread.
+    unsigned nesting;
+    _PARCEpochLimbo limbo;
+    size_t collectAt;
+
+    struct parc_epoch_record *next;
+} _PARCEpochRecord;
+
+static volatile uint64_t _parcEpoch_GlobalEpoch = 1;
+static _PARCEpochRecord *volatile _parcEpoch_Registry;
+
+// Elements left behind by threads that have exited.
+static pthread_mutex_t _parcEpoch_OrphanMutex = PTHREAD_MUTEX_INITIALIZER;
+static _PARCEpochLimbo _parcEpoch_Orphans;
+
+static pthread_once_t _parcEpoch_KeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcEpoch_ThreadKey;
+
+static __thread _PARCEpochRecord *_parcEpoch_ThreadRecord;
+
+static void
+_parcEpochLimbo_Append(_PARCEpochLimbo *limbo, _PARCEpochDeferred *deferred)
+{
+    deferred->next = NULL;
+    if (limbo->tail == NULL) {
+        limbo->head = deferred;
+    } else {
+        limbo->tail->next = deferred;
+    }
+    limbo->tail = deferred;
+    limbo->length++;
+}
+
+static void
+_parcEpochLimbo_AppendAll(_PARCEpochLimbo *limbo, _PARCEpochLimbo *other)
+{
+    if (other->head != NULL) {
+        if (limbo->tail == NULL) {
+            limbo->head = other->head;
+        } else {
+            limbo->tail->next = other->head;
+        }
+        limbo->tail = other->tail;
+        limbo->length += other->length;
+        *other = (_PARCEpochLimbo) { NULL, NULL, 0 };
+    }
+}
+
+/**
+ * Detach the leading elements of the limbo list that were deferred before `safeEpoch`.
+ * Elements are appended in epoch order, so they form a prefix.
+ */
+static _PARCEpochDeferred *
+_parcEpochLimbo_TakeExpired(_PARCEpochLimbo *limbo, uint64_t safeEpoch, size_t *countPtr)
+{
+    _PARCEpochDeferred *result = limbo->head;
+    _PARCEpochDeferred *last = NULL;
+    size_t count = 0;
+
+    for (_PARCEpochDeferred *deferred = limbo->head; deferred != NULL && deferred->epoch < safeEpoch; deferred = deferred->next) {
+        last = deferred;
+        count++;
+    }
+
+    if (last == NULL) {
+        result = NULL;
+    } else {
+        limbo->head = last->next;
+        if (limbo->head == NULL) {
+            limbo->tail = NULL;
+        }
+        last->next = NULL;
+        limbo->length -= count;
+    }
+
+    *countPtr = count;
+    return result;
+}
+
+/**
+ * Run the reclamation functions of a detached list.
+ * They may defer more elements, which is why the list is detached from the limbo list first.
+ */
+static void
+_parcEpoch_Reclaim(_PARCEpochDeferred *deferred)
+{
+    while (deferred != NULL) {
+        _PARCEpochDeferred *next = deferred->next;
+        deferred->function(deferred->pointer);
+        parcMemory_Deallocate((void **) &deferred);
+        deferred = next;
+    }
+}
+
+static void
+_parcEpoch_ThreadExit(void *value)
+{
+    _PARCEpochRecord *record = value;
+
+    record->state = 0;
+    record->nesting = 0;
+
+    pthread_mutex_lock(&_parcEpoch_OrphanMutex);
+    _parcEpochLimbo_AppendAll(&_parcEpoch_Orphans, &record->limbo);
+    pthread_mutex_unlock(&_parcEpoch_OrphanMutex);
+
+    record->collectAt = _COLLECT_THRESHOLD;
+    _parcEpoch_ThreadRecord = NULL;
+    __sync_lock_release(&record->inUse);
+}
+
+static void
+_parcEpoch_CreateKey(void)
+{
+    pthread_key_create(&_parcEpoch_ThreadKey, _parcEpoch_ThreadExit);
+}
+
+static _PARCEpochRecord *
+_parcEpoch_Record(void)
+{
+    _PARCEpochRecord *result = _parcEpoch_ThreadRecord;
+
+    if (result == NULL) {
+        pthread_once(&_parcEpoch_KeyOnce, _parcEpoch_CreateKey);
+
+        for (_PARCEpochRecord *record = _parcEpoch_Registry; record != NULL && result == NULL; record = record->next) {
+            if (record->inUse == 0 && __sync_lock_test_and_set(&record->inUse, 1) == 0) {
+                result = record;
+            }
+        }
+
+        if (result == NULL) {
+            // Records outlive every thread and are never freed, so they do not come from parcMemory.
+            result = calloc(1, sizeof(_PARCEpochRecord));
+            trapOutOfMemoryIf(result == NULL, "calloc(1, %zu) returned NULL", sizeof(_PARCEpochRecord));
+            result->inUse = 1;
+            result->collectAt = _COLLECT_THRESHOLD;
+            do {
+                result->next = _parcEpoch_Registry;
+            } while (!__sync_bool_compare_and_swap(&_parcEpoch_Registry, result->next, result));
+        }
+
+        pthread_setspecific(_parcEpoch_ThreadKey, result);
+        _parcEpoch_ThreadRecord = result;
+    }
+
+    return result;
+}
+
+/**
+ * Advance the global epoch if every thread in a critical section has observed the current one.
+ *
+ * @return The global epoch after the attempt.
+ */
+static uint64_t
+_parcEpoch_TryAdvance(void)
+{
+    uint64_t epoch = _parcEpoch_GlobalEpoch;
+    __sync_synchronize();
+
+    for (_PARCEpochRecord *record = _parcEpoch_Registry; record != NULL; record = record->next) {
+        uint64_t state = record->state;
+        if ((state & 1) && (state >> 1) != epoch) {
+            return epoch;
+        }
+    }
+
+    __sync_bool_compare_and_swap(&_parcEpoch_GlobalEpoch, epoch, epoch + 1);
+    return _parcEpoch_GlobalEpoch;
+}
+
+static size_t
+_parcEpoch_CollectOrphans(uint64_t safeEpoch, bool wait)
+{
+    size_t count = 0;
+
+    if (wait) {
+        pthread_mutex_lock(&_parcEpoch_OrphanMutex);
+    } else if (_parcEpoch_Orphans.head == NULL || pthread_mutex_trylock(&_parcEpoch_OrphanMutex) != 0) {
+        return 0;
+    }
+    _PARCEpochDeferred *expired = _parcEpochLimbo_TakeExpired(&_parcEpoch_Orphans, safeEpoch, &count);
+    pthread_mutex_unlock(&_parcEpoch_OrphanMutex);
+
+    _parcEpoch_Reclaim(expired);
+    return count;
+}
+
+void
+parcEpoch_Enter(void)
+{
+    _PARCEpochRecord *record = _parcEpoch_Record();
+
+    if (record->nesting++ == 0) {
+        record->state = (_parcEpoch_GlobalEpoch << 1) | 1;
+        // The announcement must be visible before any shared pointer is read.
+        __sync_synchronize();
+    }
+}
+
+void
+parcEpoch_Exit(void)
+{
+    _PARCEpochRecord *record = _parcEpoch_ThreadRecord;
+    assertTrue(record != NULL && record->nesting > 0, "parcEpoch_Exit called outside a critical section");
+
+    if (--record->nesting == 0) {
+        // Every read of the critical section must complete before the thread is seen to have left,
+        // which a release store guarantees without a full fence.
+        __atomic_store_n(&record->state, 0, __ATOMIC_RELEASE);
+    }
+}
+
+bool
+parcEpoch_IsActive(void)
+{
+    return _parcEpoch_ThreadRecord != NULL && _parcEpoch_ThreadRecord->nesting > 0;
+}
+
+size_t
+parcEpoch_Collect(void)
+{
+    _PARCEpochRecord *record = _parcEpoch_Record();
+
+    uint64_t epoch = _parcEpoch_TryAdvance();
+    uint64_t safeEpoch = epoch - 1;
+
+    size_t count;
+    _PARCEpochDeferred *expired = _parcEpochLimbo_TakeExpired(&record->limbo, safeEpoch, &count);
+    record->collectAt = record->limbo.length + _COLLECT_THRESHOLD;
+    _parcEpoch_Reclaim(expired);
+
+    return count + _parcEpoch_CollectOrphans(safeEpoch, false);
+}
+
+void
+parcEpoch_Defer(void (*function)(void *pointer), void *pointer)
+{
+    assertNotNull(function, "Parameter function must be non-null");
+
+    _PARCEpochRecord *record = _parcEpoch_Record();
+
+    _PARCEpochDeferred *deferred = parcMemory_Allocate(sizeof(_PARCEpochDeferred));
+    trapOutOfMemoryIf(deferred == NULL, "parcMemory_Allocate(%zu) returned NULL", sizeof(_PARCEpochDeferred));
+    deferred->function = function;
+    deferred->pointer = pointer;
+
+    // The element was unlinked before this point, so tagging it with the epoch read afterwards is conservative.
+    __sync_synchronize();
+    deferred->epoch = _parcEpoch_GlobalEpoch;
+
+    _parcEpochLimbo_Append(&record->limbo, deferred);
+
+    if (record->limbo.length >= record->collectAt) {
+        parcEpoch_Collect();
+    }
+}
+
+static void
+_parcEpoch_Release(void *object)
+{
+    parcObject_Release(&object);
+}
+
+void
+parcEpoch_DeferRelease(PARCObject **objectPtr)
+{
+    assertNotNull(objectPtr, "Parameter objectPtr must be a non-null pointer to a PARCObject pointer");
+    assertNotNull(*objectPtr, "Parameter objectPtr must dereference to a non-null PARCObject pointer");
+
+    parcEpoch_Defer(_parcEpoch_Release, *objectPtr);
+    *objectPtr = NULL;
+}
+
+void
+parcEpoch_Barrier(void)
+{
+    _PARCEpochRecord *record = _parcEpoch_Record();
+    trapUnexpectedStateIf(record->nesting > 0, "parcEpoch_Barrier must not be called inside a critical section");
+
+    // Reclaiming may defer more elements, such as the contents of a released container, so repeat until none are left.
+    do {
+        __sync_synchronize();
+        uint64_t target = _parcEpoch_GlobalEpoch + 2;
+        while (_parcEpoch_TryAdvance() < target) {
+            sched_yield();
+        }
+
+        size_t count;
+        _parcEpoch_Reclaim(_parcEpochLimbo_TakeExpired(&record->limbo, target - 1, &count));
+        _parcEpoch_CollectOrphans(target - 1, true);
+    } while (record->limbo.head != NULL);
+
+    record->collectAt = record->limbo.length + _COLLECT_THRESHOLD;
+}
+
+size_t
+parcEpoch_GetPendingCount(void)
+{
+    return (_parcEpoch_ThreadRecord == NULL) ? 0 : _parcEpoch_ThreadRecord->limbo.length;
+}
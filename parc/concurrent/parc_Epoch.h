@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_Epoch.h
+ * @ingroup threading
+ * @brief Epoch-based deferred reclamation for lock-free readers
+ *
+ * A data structure that lets readers traverse it without locks cannot release an element
+ * as soon as a writer unlinks it, because a reader may still be looking at it.
+ * `PARCEpoch` defers the release until every reader that could have seen the element has finished.
+ *
+ * Readers bracket each traversal with {@link parcEpoch_Enter} and {@link parcEpoch_Exit}.
+ * A writer that unlinks an element hands it to {@link parcEpoch_DeferRelease} (or {@link parcEpoch_Defer} for plain memory)
+ * instead of releasing it.  The element is released once the global epoch has advanced twice past the epoch in which
+ * it was deferred, which can only happen after every thread inside a critical section at the time has left it.
+ *
+ * Each thread keeps its own limbo list of deferred elements, so deferring takes no locks.
+ * Once a thread has deferred enough elements it collects them in a batch: it tries to advance the epoch and releases
+ * the elements whose grace period has passed.  A thread's remaining elements are handed to the next collector when it exits.
+ *
+ * Critical sections should be short and must not block: a thread that stays inside one holds back reclamation for every thread.
+ * They nest, and the functions of this module may be called from within them, except {@link parcEpoch_Barrier}.
+ *
+ * Example:
+ * @code
+ * {
+ *     // reader
+ *     parcEpoch_Enter();
+ *     Config *config = sharedConfig;
+ *     use(config);
+ *     parcEpoch_Exit();
+ *
+ *     // writer
+ *     Config *old = __sync_lock_test_and_set(&sharedConfig, newConfig);
+ *     parcEpoch_DeferRelease((PARCObject **) &old);
+ * }
+ * @endcode
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_Epoch
+#define PARCLibrary_parc_Epoch
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_Object.h>
+
+/**
+ * Enter a read-side critical section.
+ *
+ * Until the matching call to {@link parcEpoch_Exit}, nothing deferred by any thread after this call
+ * begins will be released.  Critical sections nest.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEpoch_Enter();
+ *     // read the shared structure
+ *     parcEpoch_Exit();
+ * }
+ * @endcode
+ */
+void parcEpoch_Enter(void);
+
+/**
+ * Leave a read-side critical section entered by {@link parcEpoch_Enter}.
+ *
+ * Pointers obtained from shared structures inside the critical section must not be used after it is left,
+ * unless a reference was acquired inside it.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEpoch_Enter();
+ *     // read the shared structure
+ *     parcEpoch_Exit();
+ * }
+ * @endcode
+ */
+void parcEpoch_Exit(void);
+
+/**
+ * Determine if the calling thread is inside a read-side critical section.
+ *
+ * @return true The calling thread has entered more critical sections than it has left.
+ * @return false Otherwise.
+ */
+bool parcEpoch_IsActive(void);
+
+/**
+ * Call `function(pointer)` once no thread can still be reading @p pointer.
+ *
+ * The caller must already have made @p pointer unreachable to readers that start from now on.
+ *
+ * @param [in] function The function that reclaims @p pointer.
+ * @param [in] pointer The element to reclaim.
+ *
+ * Example:
+ * @code
+ * {
+ *     Node *node = list->head;
+ *     list->head = node->next;
+ *     parcEpoch_Defer(free, node);
+ * }
+ * @endcode
+ */
+void parcEpoch_Defer(void (*function)(void *pointer), void *pointer);
+
+/**
+ * Release a reference to a PARC Object once no thread can still be reading it.
+ *
+ * The caller must already have made the object unreachable to readers that start from now on.
+ * The pointer is set to NULL as a side-effect of this function.
+ *
+ * @param [in,out] objectPtr A pointer to a pointer to the object to release.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *old = __sync_lock_test_and_set(&shared, replacement);
+ *     parcEpoch_DeferRelease((PARCObject **) &old);
+ * }
+ * @endcode
+ */
+void parcEpoch_DeferRelease(PARCObject **objectPtr);
+
+/**
+ * Try to advance the epoch and reclaim the calling thread's deferred elements whose grace period has passed.
+ *
+ * This never waits for other threads.  Deferring calls it automatically once enough elements are pending.
+ *
+ * @return The number of elements reclaimed.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcEpoch_Collect();
+ * }
+ * @endcode
+ */
+size_t parcEpoch_Collect(void);
+
+/**
+ * Wait until everything deferred by the calling thread, and by threads that have exited, has been reclaimed.
+ *
+ * This waits for every thread currently inside a critical section to leave it,
+ * so it must not be called from within one.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcConcurrentHashMap_Release(&map);
+ *     parcEpoch_Barrier();
+ * }
+ * @endcode
+ */
+void parcEpoch_Barrier(void);
+
+/**
+ * Get the number of elements the calling thread has deferred and that have not yet been reclaimed.
+ *
+ * @return The number of elements pending reclamation on the calling thread.
+ */
+size_t parcEpoch_GetPendingCount(void);
+#endif // PARCLibrary_parc_Epoch
@@ -264,17 +264,17 @@ parcFutureTask_Get(const PARCFutureTask *futureTask, const PARCTimeout *timeout)
         while (!futureTask->isDone) {
             if (parcTimeout_IsNever(timeout)) {
                 parcObject_Wait(futureTask);
-                result.execution = PARCExecution_OK;
-                result.value = futureTask->result;
-                break;
             } else {
-                if (parcObject_WaitFor(futureTask, parcTimeout_InNanoSeconds(timeout))) {
-                    result.execution = PARCExecution_OK;
-                    result.value = futureTask->result;
+                if (!parcObject_WaitFor(futureTask, parcTimeout_InNanoSeconds(timeout))) {
+                    result.execution = PARCExecution_Timeout;
                     break;
                 }
             }
         }
+        if (futureTask->isDone) {
+            result.execution = PARCExecution_OK;
+            result.value = futureTask->result;
+        }
         parcObject_Unlock(futureTask);
     }
 
@@ -64,6 +64,13 @@
 #include <errno.h>
 #include <fcntl.h>
 
+#ifdef __linux__
+#include <sys/eventfd.h>
+#define PARCNotifierHaveEventfd true
+#else
+#define PARCNotifierHaveEventfd false
+#endif
+
 #include <LongBow/runtime.h>
 
 #include <parc/concurrent/parc_Notifier.h>
@@ -85,6 +92,10 @@ struct parc_notifier {
     // we indicate that we skipped a notify
     volatile int skippedNotify;
 
+    // With an eventfd both ends are the same descriptor and the kernel keeps a counter,
+    // so any number of writes is consumed by a single read.
+    bool isEventfd;
+
 #define PARCNotifierWriteFd 1
 #define PARCNotifierReadFd 0
     int fds[2];
@@ -95,8 +106,10 @@ _parcNotifier_Finalize(PARCNotifier **notifierPtr)
 {
     PARCNotifier *notifier = *notifierPtr;
 
-    close(notifier->fds[0]);
-    close(notifier->fds[1]);
+    close(notifier->fds[PARCNotifierReadFd]);
+    if (!notifier->isEventfd) {
+        close(notifier->fds[PARCNotifierWriteFd]);
+    }
 }
 
 parcObject_ExtendPARCObject(PARCNotifier, _parcNotifier_Finalize, NULL, NULL, NULL, NULL, NULL, NULL);
@@ -115,13 +128,66 @@ _parcNotifier_MakeNonblocking(PARCNotifier *notifier)
     return false;
 }
 
-PARCNotifier *
-parcNotifier_Create(void)
+/**
+ * Make the read side readable: one 8 byte counter increment for an eventfd, one byte for a pipe.
+ */
+static void
+_parcNotifier_Signal(PARCNotifier *notifier)
+{
+    if (notifier->isEventfd) {
+        uint64_t one = 1;
+        ssize_t written = write(notifier->fds[PARCNotifierWriteFd], &one, sizeof(one));
+        assertTrue(written == sizeof(one), "Error writing to eventfd %d: %s", notifier->fds[PARCNotifierWriteFd], strerror(errno));
+    } else {
+        uint8_t one = 1;
+        ssize_t written;
+        do {
+            written = write(notifier->fds[PARCNotifierWriteFd], &one, 1);
+            assertTrue(written >= 0, "Error writing to socket %d: %s", notifier->fds[PARCNotifierWriteFd], strerror(errno));
+        } while (written == 0);
+    }
+}
+
+/**
+ * Clear the read side without blocking.
+ *
+ * An eventfd is reset to zero by one read however many signals it holds; a pipe is read until empty.
+ */
+static void
+_parcNotifier_Drain(PARCNotifier *notifier)
+{
+    if (notifier->isEventfd) {
+        uint64_t count;
+        ssize_t nread = read(notifier->fds[PARCNotifierReadFd], &count, sizeof(count));
+        (void) nread;
+    } else {
+        uint8_t buffer[16];
+        while (read(notifier->fds[PARCNotifierReadFd], &buffer, 16) > 0) {
+            ;
+        }
+    }
+}
+
+static PARCNotifier *
+_parcNotifier_Create(bool useEventfd)
 {
     PARCNotifier *notifier = parcObject_CreateInstance(PARCNotifier);
     if (notifier) {
         notifier->paused = false;
         notifier->skippedNotify = false;
+        notifier->isEventfd = false;
+
+#ifdef __linux__
+        if (useEventfd) {
+            int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fd >= 0) {
+                notifier->isEventfd = true;
+                notifier->fds[PARCNotifierReadFd] = fd;
+                notifier->fds[PARCNotifierWriteFd] = fd;
+                return notifier;
+            }
+        }
+#endif
 
         int failure = pipe(notifier->fds);
         assertFalse(failure, "Error on pipe: %s", strerror(errno));
@@ -134,6 +200,12 @@ parcNotifier_Create(void)
     return notifier;
 }
 
+PARCNotifier *
+parcNotifier_Create(void)
+{
+    return _parcNotifier_Create(PARCNotifierHaveEventfd);
+}
+
 parcObject_ImplementAcquire(parcNotifier, PARCNotifier);
 
 parcObject_ImplementRelease(parcNotifier, PARCNotifier);
@@ -150,12 +222,7 @@ parcNotifier_Notify(PARCNotifier *notifier)
 {
     if (ATOMIC_BOOL_CAS(&notifier->paused, 0, 1)) {
         // old value was "0" so we need to send a notification
-        uint8_t one = 1;
-        ssize_t written;
-        do {
-            written = write(notifier->fds[PARCNotifierWriteFd], &one, 1);
-            assertTrue(written >= 0, "Error writing to socket %d: %s", notifier->fds[PARCNotifierWriteFd], strerror(errno));
-        } while (written == 0);
+        _parcNotifier_Signal(notifier);
 
         return true;
     } else {
@@ -173,10 +240,7 @@ parcNotifier_PauseEvents(PARCNotifier *notifier)
     ATOMIC_BOOL_CAS(&notifier->paused, 0, 1);
 
     // now clear out the socket
-    uint8_t buffer[16];
-    while (read(notifier->fds[PARCNotifierReadFd], &buffer, 16) > 0) {
-        ;
-    }
+    _parcNotifier_Drain(notifier);
 }
 
 void
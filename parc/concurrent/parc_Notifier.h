@@ -90,6 +90,11 @@
  * parcNotifier_PauseEvents() and parcRingBuffer1x1_Get() calls, then on parcNotifier_StartEvents()
  * an extra event will be triggered, even though the ring buffer is empty.
  *
+ * On Linux the notifier is an eventfd, so parcNotifier_Socket() and the write side are one descriptor
+ * and parcNotifier_PauseEvents() clears it with a single read.  Together with the paused flag this
+ * makes a producer/consumer handoff cost one write and one read per batch of notifications, however
+ * many notifications the batch holds.  Elsewhere a pipe is used.
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -71,6 +71,7 @@ struct PARCThread {
     PARCObject *argument;
     bool isCancelled;
     bool isRunning;
+    bool isJoinable;
     pthread_t thread;
 };
 
@@ -124,6 +125,7 @@ parcThread_Create(void *(*runFunction)(PARCThread *, PARCObject *), PARCObject *
         result->argument = parcObject_Acquire(parameter);
         result->isCancelled = false;
         result->isRunning = false;
+        result->isJoinable = false;
     }
 
     return result;
@@ -228,6 +230,7 @@ void
 parcThread_Start(PARCThread *thread)
 {
     PARCThread *parameter = parcThread_Acquire(thread);
+    thread->isJoinable = true;
     pthread_create(&thread->thread, NULL, (void *(*)(void *)) _parcThread_Run, parameter);
 }
 
@@ -269,5 +272,9 @@ parcThread_IsCancelled(const PARCThread *thread)
 void
 parcThread_Join(PARCThread *thread)
 {
-    pthread_join(thread->thread, NULL);
+    // A pthread may be joined only once, and never if it was not started.
+    if (thread->isJoinable) {
+        thread->isJoinable = false;
+        pthread_join(thread->thread, NULL);
+    }
 }
@@ -70,6 +70,10 @@
 #include <parc/concurrent/parc_ThreadPool.h>
 #include <parc/concurrent/parc_Thread.h>
 
+#include <parc/developer/parc_Trace.h>
+
+#include <parc/statistics/parc_Metrics.h>
+
 struct PARCThreadPool {
     bool continueExistingPeriodicTasksAfterShutdown;
     bool executeExistingDelayedTasksAfterShutdown;
@@ -95,11 +99,16 @@ _parcThreadPool_Worker(const PARCThread *thread, const PARCThreadPool *pool)
             if (task != NULL) {
                 parcAtomicUint64_Increment(pool->completedTaskCount);
                 parcLinkedList_Unlock(pool->workQueue);
-                parcFutureTask_Run(task);
+                {
+                    parcTrace_Scope("PARCThreadPool", "task");
+                    parcFutureTask_Run(task);
+                }
                 parcFutureTask_Release(&task);
                 parcLinkedList_Lock(pool->workQueue);
 
-                parcLinkedList_Notify(pool->workQueue);
+                // Idle workers and parcThreadPool_AwaitTermination wait on the same condition,
+                // so a single notification may wake an idle worker and leave the waiter asleep.
+                parcLinkedList_NotifyAll(pool->workQueue);
             } else {
                 parcLinkedList_WaitFor(pool->workQueue, 1000000000);
             }
@@ -113,25 +122,25 @@ _parcThreadPool_Worker(const PARCThread *thread, const PARCThreadPool *pool)
 static void
 _parcThreadPool_CancelAll(const PARCThreadPool *pool)
 {
-    PARCIterator *iterator = parcLinkedList_CreateIterator(pool->threads);
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, pool->threads);
 
-    while (parcIterator_HasNext(iterator)) {
-        PARCThread *thread = parcIterator_Next(iterator);
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCThread *thread = parcLinkedListCursor_Next(&cursor);
         parcThread_Cancel(thread);
     }
-    parcIterator_Release(&iterator);
 }
 
 static void
 _parcThreadPool_JoinAll(const PARCThreadPool *pool)
 {
-    PARCIterator *iterator = parcLinkedList_CreateIterator(pool->threads);
+    PARCLinkedListCursor cursor;
+    parcLinkedListCursor_Init(&cursor, pool->threads);
 
-    while (parcIterator_HasNext(iterator)) {
-        PARCThread *thread = parcIterator_Next(iterator);
+    while (parcLinkedListCursor_HasNext(&cursor)) {
+        PARCThread *thread = parcLinkedListCursor_Next(&cursor);
         parcThread_Join(thread);
     }
-    parcIterator_Release(&iterator);
 }
 
 static bool
@@ -406,6 +415,76 @@ parcThreadPool_GetTaskCount(const PARCThreadPool *pool)
     return pool->taskCount;
 }
 
+static int64_t
+_parcThreadPool_CompletedTaskCountGauge(const PARCObject *pool)
+{
+    return (int64_t) parcThreadPool_GetCompletedTaskCount(pool);
+}
+
+static int64_t
+_parcThreadPool_TaskCountGauge(const PARCObject *pool)
+{
+    return parcThreadPool_GetTaskCount(pool);
+}
+
+static int64_t
+_parcThreadPool_PoolSizeGauge(const PARCObject *pool)
+{
+    return parcThreadPool_GetPoolSize(pool);
+}
+
+static int64_t
+_parcThreadPool_QueueSizeGauge(const PARCObject *pool)
+{
+    PARCLinkedList *workQueue = parcThreadPool_GetQueue(pool);
+
+    size_t size = 0;
+    if (parcLinkedList_Lock(workQueue)) {
+        size = parcLinkedList_Size(workQueue);
+        parcLinkedList_Unlock(workQueue);
+    }
+    return (int64_t) size;
+}
+
+// Below this many items per share, handing work to the pool costs more than it saves.
+#define _parcThreadPool_MinimumBatchShare 4
+
+size_t
+parcThreadPool_GetBatchShareCount(const PARCThreadPool *pool, size_t count)
+{
+    size_t result = 1;
+    if (pool != NULL) {
+        result += (size_t) parcThreadPool_GetPoolSize(pool);
+    }
+    if (result > count / _parcThreadPool_MinimumBatchShare) {
+        result = count / _parcThreadPool_MinimumBatchShare;
+    }
+    if (result == 0) {
+        result = 1;
+    }
+    return result;
+}
+
+void
+parcThreadPool_RegisterMetrics(PARCThreadPool *pool, PARCMetrics *metrics, const char *prefix)
+{
+    static const struct {
+        const char *suffix;
+        PARCMetricsGaugeFunction *function;
+    } gauges[] = {
+        { ".completedTaskCount", _parcThreadPool_CompletedTaskCountGauge },
+        { ".taskCount",          _parcThreadPool_TaskCountGauge          },
+        { ".poolSize",           _parcThreadPool_PoolSizeGauge           },
+        { ".queueSize",          _parcThreadPool_QueueSizeGauge          },
+    };
+
+    for (size_t i = 0; i < sizeof(gauges) / sizeof(gauges[0]); i++) {
+        char *name = parcMemory_Format("%s%s", prefix, gauges[i].suffix);
+        parcMetrics_AddGauge(metrics, name, gauges[i].function, pool);
+        parcMemory_Deallocate((void **) &name);
+    }
+}
+
 bool
 parcThreadPool_IsShutdown(const PARCThreadPool *pool)
 {
@@ -73,6 +73,7 @@
 #include <parc/concurrent/parc_FutureTask.h>
 
 struct PARCThreadPool;
+struct PARCMetrics;
 typedef struct PARCThreadPool PARCThreadPool;
 
 /**
@@ -663,4 +664,24 @@ void parcThreadPool_Shutdown(PARCThreadPool *pool);
  * Attempts to stop all actively executing tasks, halts the processing of waiting tasks, and returns a list of the tasks that were awaiting execution.
  */
 PARCLinkedList *parcThreadPool_ShutdownNow(PARCThreadPool *pool);
+
+/**
+ * Returns how many shares a batch of @p count items should be divided into:
+ * one for the calling thread and one for each thread of @p pool,
+ * but never so many that a share is too small to be worth handing to another thread.
+ *
+ * @param [in] pool A pointer to a valid PARCThreadPool instance, or NULL to do all the work on the calling thread.
+ * @param [in] count The number of items in the batch.
+ *
+ * @return The number of shares, at least 1.
+ */
+size_t parcThreadPool_GetBatchShareCount(const PARCThreadPool *pool, size_t count);
+
+/**
+ * Registers gauges for the completed task count, task count, pool size and work queue depth of the pool,
+ * named by appending ".completedTaskCount", ".taskCount", ".poolSize" and ".queueSize" to the given prefix.
+ *
+ * The registry holds a reference to the pool until the gauges are removed or the registry is released.
+ */
+void parcThreadPool_RegisterMetrics(PARCThreadPool *pool, struct PARCMetrics *metrics, const char *prefix);
 #endif
@@ -0,0 +1,591 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../parc_ConcurrentHashMap.c"
+
+#include <pthread.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_HashMap.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Time.h>
+#include <LongBow/unit-test.h>
+
+static PARCBuffer *
+_key(uint64_t value)
+{
+    PARCBuffer *result = parcBuffer_Allocate(sizeof(uint64_t));
+    parcBuffer_PutUint64(result, value);
+    return parcBuffer_Flip(result);
+}
+
+LONGBOW_TEST_RUNNER(parc_ConcurrentHashMap)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ConcurrentHashMap)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ConcurrentHashMap)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(CreateAcquireRelease)
+{
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateRelease);
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateCapacity);
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, Acquire);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(CreateAcquireRelease)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(CreateAcquireRelease)
+{
+    parcEpoch_Barrier();
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateRelease)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    assertNotNull(instance, "Expected non-null result from parcConcurrentHashMap_Create()");
+    parcConcurrentHashMap_AssertValid(instance);
+    assertTrue(parcConcurrentHashMap_Size(instance) == 0, "Expected an empty map");
+
+    parcConcurrentHashMap_Release(&instance);
+    assertNull(instance, "Expected null result from parcConcurrentHashMap_Release()");
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateCapacity)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_CreateCapacity(10000);
+    assertTrue(instance->table->capacity * 3 / 4 >= 10000,
+               "Expected room for 10000 entries, got %zu buckets", instance->table->capacity);
+    assertTrue(instance->table->capacity >= _STRIPES, "Expected at least one bucket per stripe");
+
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, Acquire)
+{
+    PARCConcurrentHashMap *instance = parcConcurrentHashMap_Create();
+    PARCConcurrentHashMap *reference = parcConcurrentHashMap_Acquire(instance);
+    assertTrue(reference == instance, "Expected the acquired reference to be the same instance");
+
+    parcConcurrentHashMap_Release(&reference);
+    parcConcurrentHashMap_Release(&instance);
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Put_Get);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Get_Missing);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Put_Replace);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Remove);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Contains);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Expand);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Expand_NotOnFirstPut);
+    LONGBOW_RUN_TEST_CASE(Global, parcConcurrentHashMap_Display);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    // Entries removed from a map are released through PARCEpoch.
+    parcEpoch_Barrier();
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Put_Get)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value = parcBuffer_WrapCString("value1");
+
+    parcConcurrentHashMap_Put(map, key, value);
+    assertTrue(parcConcurrentHashMap_Size(map) == 1, "Expected 1 entry, got %zu", parcConcurrentHashMap_Size(map));
+
+    PARCBuffer *lookup = parcBuffer_WrapCString("key1");
+    PARCBuffer *actual = parcConcurrentHashMap_Get(map, lookup);
+    assertTrue(actual == value, "Expected the value that was put");
+    assertTrue(parcObject_GetReferenceCount(actual) == 3,
+               "Expected Get to return a new reference, count is %" PRIu64, parcObject_GetReferenceCount(actual));
+
+    parcBuffer_Release(&actual);
+    parcBuffer_Release(&lookup);
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value);
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Get_Missing)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+
+    assertNull(parcConcurrentHashMap_Get(map, key), "Expected NULL for a key that is not in the map");
+
+    parcBuffer_Release(&key);
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Put_Replace)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    PARCBuffer *value1 = parcBuffer_WrapCString("value1");
+    PARCBuffer *value2 = parcBuffer_WrapCString("value2");
+
+    parcConcurrentHashMap_Put(map, key, value1);
+    parcConcurrentHashMap_Put(map, key, value2);
+    assertTrue(parcConcurrentHashMap_Size(map) == 1, "Expected 1 entry, got %zu", parcConcurrentHashMap_Size(map));
+
+    PARCBuffer *actual = parcConcurrentHashMap_Get(map, key);
+    assertTrue(actual == value2, "Expected the replacing value");
+    parcBuffer_Release(&actual);
+
+    // The replaced value is released once it has been reclaimed.
+    parcEpoch_Barrier();
+    assertTrue(parcObject_GetReferenceCount(value1) == 1,
+               "Expected the map to have released the replaced value, count is %" PRIu64, parcObject_GetReferenceCount(value1));
+
+    parcBuffer_Release(&key);
+    parcBuffer_Release(&value1);
+    parcBuffer_Release(&value2);
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Remove)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+
+    for (uint64_t i = 0; i < 10; i++) {
+        PARCBuffer *key = _key(i);
+        parcConcurrentHashMap_Put(map, key, key);
+        parcBuffer_Release(&key);
+    }
+
+    PARCBuffer *key = _key(3);
+    assertTrue(parcConcurrentHashMap_Remove(map, key), "Expected to remove a key in the map");
+    assertFalse(parcConcurrentHashMap_Remove(map, key), "Expected not to remove a key no longer in the map");
+    assertNull(parcConcurrentHashMap_Get(map, key), "Expected the removed key to be gone");
+    assertTrue(parcConcurrentHashMap_Size(map) == 9, "Expected 9 entries, got %zu", parcConcurrentHashMap_Size(map));
+    parcBuffer_Release(&key);
+
+    for (uint64_t i = 0; i < 10; i++) {
+        if (i != 3) {
+            key = _key(i);
+            PARCBuffer *value = parcConcurrentHashMap_Get(map, key);
+            assertTrue(parcBuffer_Equals(key, value), "Wrong value for key %" PRIu64, i);
+            parcBuffer_Release(&value);
+            parcBuffer_Release(&key);
+        }
+    }
+
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Contains)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    PARCBuffer *key1 = parcBuffer_WrapCString("key1");
+    PARCBuffer *key2 = parcBuffer_WrapCString("key2");
+
+    parcConcurrentHashMap_Put(map, key1, key1);
+    assertTrue(parcConcurrentHashMap_Contains(map, key1), "Expected the map to contain key1");
+    assertFalse(parcConcurrentHashMap_Contains(map, key2), "Expected the map not to contain key2");
+
+    parcBuffer_Release(&key1);
+    parcBuffer_Release(&key2);
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Expand)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    size_t initialCapacity = map->table->capacity;
+
+    const uint64_t count = 5000;
+    for (uint64_t i = 0; i < count; i++) {
+        PARCBuffer *key = _key(i);
+        parcConcurrentHashMap_Put(map, key, key);
+        parcBuffer_Release(&key);
+    }
+    assertTrue(map->table->capacity > initialCapacity, "Expected the table to have grown");
+    assertTrue(parcConcurrentHashMap_Size(map) == count, "Expected %" PRIu64 " entries, got %zu", count, parcConcurrentHashMap_Size(map));
+
+    for (uint64_t i = 0; i < count; i++) {
+        PARCBuffer *key = _key(i);
+        PARCBuffer *value = parcConcurrentHashMap_Get(map, key);
+        assertNotNull(value, "Key %" PRIu64 " missing after expansion", i);
+        parcBuffer_Release(&value);
+        parcBuffer_Release(&key);
+    }
+
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Expand_NotOnFirstPut)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_CreateCapacity(1);
+    size_t initialCapacity = map->table->capacity;
+
+    PARCBuffer *key = _key(1);
+    parcConcurrentHashMap_Put(map, key, key);
+    parcBuffer_Release(&key);
+    assertTrue(map->table->capacity == initialCapacity,
+               "Expected one entry to fit in %zu buckets, grew to %zu", initialCapacity, map->table->capacity);
+
+    parcConcurrentHashMap_Release(&map);
+}
+
+LONGBOW_TEST_CASE(Global, parcConcurrentHashMap_Display)
+{
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+    PARCBuffer *key = parcBuffer_WrapCString("key1");
+    parcConcurrentHashMap_Put(map, key, key);
+
+    parcConcurrentHashMap_Display(map, 0);
+
+    parcBuffer_Release(&key);
+    parcConcurrentHashMap_Release(&map);
+}
+
+// ==============================
+// Many threads reading and writing the same map.
+
+#define _SharedKeys 4096
+
+typedef struct {
+    PARCConcurrentHashMap *concurrentMap;
+    PARCHashMap *lockedMap;
+    PARCBuffer **keys;
+    unsigned seed;
+    unsigned writePercent;
+    uint64_t operations;
+    uint64_t errors;
+} _Worker;
+
+static PARCBuffer **
+_createKeys(size_t count)
+{
+    PARCBuffer **keys = parcMemory_Allocate(count * sizeof(PARCBuffer *));
+    for (size_t i = 0; i < count; i++) {
+        keys[i] = _key(i);
+    }
+    return keys;
+}
+
+static void
+_releaseKeys(PARCBuffer ***keysPtr, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        parcBuffer_Release(&(*keysPtr)[i]);
+    }
+    parcMemory_Deallocate((void **) keysPtr);
+}
+
+static unsigned
+_nextRandom(unsigned *seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return *seed >> 8;
+}
+
+static void *
+_concurrentWorker(void *arg)
+{
+    _Worker *worker = arg;
+
+    for (uint64_t i = 0; i < worker->operations; i++) {
+        unsigned random = _nextRandom(&worker->seed);
+        PARCBuffer *key = worker->keys[random % _SharedKeys];
+        if ((random >> 16) % 100 < worker->writePercent) {
+            if (random & 0x8000) {
+                parcConcurrentHashMap_Put(worker->concurrentMap, key, key);
+            } else {
+                parcConcurrentHashMap_Remove(worker->concurrentMap, key);
+            }
+        } else {
+            PARCBuffer *value = parcConcurrentHashMap_Get(worker->concurrentMap, key);
+            if (value != NULL) {
+                // Every value is its own key, so a torn or reclaimed entry shows up as a mismatch.
+                if (value != key) {
+                    worker->errors++;
+                }
+                parcBuffer_Release(&value);
+            }
+        }
+    }
+    return NULL;
+}
+
+static void *
+_lockedWorker(void *arg)
+{
+    _Worker *worker = arg;
+
+    for (uint64_t i = 0; i < worker->operations; i++) {
+        unsigned random = _nextRandom(&worker->seed);
+        PARCBuffer *key = worker->keys[random % _SharedKeys];
+        parcHashMap_Lock(worker->lockedMap);
+        if ((random >> 16) % 100 < worker->writePercent) {
+            if (random & 0x8000) {
+                parcHashMap_Put(worker->lockedMap, key, key);
+            } else {
+                parcHashMap_Remove(worker->lockedMap, key);
+            }
+        } else {
+            PARCBuffer *value = (PARCBuffer *) parcHashMap_Get(worker->lockedMap, key);
+            if (value != NULL) {
+                // Acquire under the lock, as a caller must to keep the value past the Unlock.
+                value = parcBuffer_Acquire(value);
+                parcBuffer_Release(&value);
+            }
+        }
+        parcHashMap_Unlock(worker->lockedMap);
+    }
+    return NULL;
+}
+
+/**
+ * Run `threads` workers for `operations` operations each, returning the elapsed nanoseconds.
+ */
+static uint64_t
+_runWorkers(void *(*function)(void *), PARCConcurrentHashMap *concurrentMap, PARCHashMap *lockedMap, PARCBuffer **keys,
+            int threads, unsigned writePercent, uint64_t operations, uint64_t *errors)
+{
+    pthread_t thread[threads];
+    _Worker worker[threads];
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < threads; i++) {
+        worker[i] = (_Worker) {
+            .concurrentMap = concurrentMap, .lockedMap = lockedMap, .keys = keys,
+            .seed = 7919 * (i + 1), .writePercent = writePercent, .operations = operations, .errors = 0
+        };
+        pthread_create(&thread[i], NULL, function, &worker[i]);
+    }
+    *errors = 0;
+    for (int i = 0; i < threads; i++) {
+        pthread_join(thread[i], NULL);
+        *errors += worker[i].errors;
+    }
+    return parcTime_NowNanoseconds() - start;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcConcurrentHashMap_ReadersAndWriters);
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcConcurrentHashMap_ExpandWhileReading);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    parcEpoch_Barrier();
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcConcurrentHashMap_ReadersAndWriters)
+{
+    PARCBuffer **keys = _createKeys(_SharedKeys);
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_Create();
+
+    uint64_t errors;
+    _runWorkers(_concurrentWorker, map, NULL, keys, 4, 20, 50000, &errors);
+    assertTrue(errors == 0, "Expected every Get to return the value put, %" PRIu64 " did not", errors);
+
+    size_t size = parcConcurrentHashMap_Size(map);
+    size_t found = 0;
+    for (size_t i = 0; i < _SharedKeys; i++) {
+        if (parcConcurrentHashMap_Contains(map, keys[i])) {
+            found++;
+        }
+    }
+    assertTrue(found == size, "Expected Size %zu to match the number of keys present %zu", size, found);
+
+    parcConcurrentHashMap_Release(&map);
+    parcEpoch_Barrier();
+
+    // Once the map is released, it must hold no references to the keys.
+    for (size_t i = 0; i < _SharedKeys; i++) {
+        assertTrue(parcObject_GetReferenceCount(keys[i]) == 1, "Key %zu still referenced after the map was released", i);
+    }
+    _releaseKeys(&keys, _SharedKeys);
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcConcurrentHashMap_ExpandWhileReading)
+{
+    PARCBuffer **keys = _createKeys(_SharedKeys);
+    PARCConcurrentHashMap *map = parcConcurrentHashMap_CreateCapacity(1);
+
+    // Half the operations are writes, starting from the smallest table, so the readers race with every expansion.
+    uint64_t errors;
+    _runWorkers(_concurrentWorker, map, NULL, keys, 4, 50, 20000, &errors);
+    assertTrue(errors == 0, "Expected every Get to return the value put, %" PRIu64 " did not", errors);
+    assertTrue(map->table->capacity > _STRIPES, "Expected the table to have grown");
+
+    parcConcurrentHashMap_Release(&map);
+    _releaseKeys(&keys, _SharedKeys);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcConcurrentHashMap_MixedReadWrite);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Performance, parcConcurrentHashMap_MixedReadWrite)
+{
+    const uint64_t operations = 500000;
+    PARCBuffer **keys = _createKeys(_SharedKeys);
+
+    printf("%d keys, %" PRIu64 " operations per thread, million operations per second\n", _SharedKeys, operations);
+    printf("  %-8s %8s %16s %16s\n", "writes", "threads", "PARCHashMap+lock", "ConcurrentHashMap");
+
+    unsigned writePercents[] = { 1, 10, 50 };
+    int threadCounts[] = { 1, 2, 4, 8 };
+    for (size_t w = 0; w < sizeof(writePercents) / sizeof(writePercents[0]); w++) {
+        for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++) {
+            int threads = threadCounts[t];
+            uint64_t errors;
+
+            PARCHashMap *lockedMap = parcHashMap_CreateCapacity(_SharedKeys);
+            PARCConcurrentHashMap *concurrentMap = parcConcurrentHashMap_CreateCapacity(_SharedKeys);
+            for (size_t i = 0; i < _SharedKeys; i += 2) {
+                parcHashMap_Put(lockedMap, keys[i], keys[i]);
+                parcConcurrentHashMap_Put(concurrentMap, keys[i], keys[i]);
+            }
+
+            uint64_t lockedNanoseconds =
+                _runWorkers(_lockedWorker, NULL, lockedMap, keys, threads, writePercents[w], operations, &errors);
+            uint64_t concurrentNanoseconds =
+                _runWorkers(_concurrentWorker, concurrentMap, NULL, keys, threads, writePercents[w], operations, &errors);
+
+            double total = (double) operations * threads * 1000.0;
+            printf("  %7u%% %8d %16.2f %16.2f\n", writePercents[w], threads,
+                   total / lockedNanoseconds, total / concurrentNanoseconds);
+            fflush(stdout);
+
+            parcHashMap_Release(&lockedMap);
+            parcConcurrentHashMap_Release(&concurrentMap);
+        }
+    }
+
+    _releaseKeys(&keys, _SharedKeys);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ConcurrentHashMap);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
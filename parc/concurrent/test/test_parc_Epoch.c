@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../parc_Epoch.c"
+
+#include <pthread.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Time.h>
+#include <LongBow/unit-test.h>
+
+static void
+_countCall(void *pointer)
+{
+    __sync_fetch_and_add((unsigned *) pointer, 1);
+}
+
+typedef struct {
+    volatile bool entered;
+    volatile bool leave;
+} _Reader;
+
+static void *
+_holdCriticalSection(void *arg)
+{
+    _Reader *reader = arg;
+
+    parcEpoch_Enter();
+    reader->entered = true;
+    while (!reader->leave) {
+        sched_yield();
+    }
+    parcEpoch_Exit();
+    return NULL;
+}
+
+LONGBOW_TEST_RUNNER(parc_Epoch)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_Epoch)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_Epoch)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_Enter_Exit);
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_Enter_Nested);
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_Defer_Barrier);
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_DeferRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_Defer_CollectsInBatches);
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_Defer_WaitsForReader);
+    LONGBOW_RUN_TEST_CASE(Global, parcEpoch_Defer_ThreadExit);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcEpoch_Barrier();
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_Enter_Exit)
+{
+    assertFalse(parcEpoch_IsActive(), "Expected the thread not to start in a critical section");
+    parcEpoch_Enter();
+    assertTrue(parcEpoch_IsActive(), "Expected the thread to be in a critical section");
+    assertTrue(_parcEpoch_ThreadRecord->state & 1, "Expected the record to announce the critical section");
+    parcEpoch_Exit();
+    assertFalse(parcEpoch_IsActive(), "Expected the thread to have left the critical section");
+    assertTrue(_parcEpoch_ThreadRecord->state == 0, "Expected the record to announce it is not reading");
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_Enter_Nested)
+{
+    parcEpoch_Enter();
+    parcEpoch_Enter();
+    parcEpoch_Exit();
+    assertTrue(parcEpoch_IsActive(), "Expected the outer critical section to continue");
+    parcEpoch_Exit();
+    assertFalse(parcEpoch_IsActive(), "Expected the thread to have left the critical section");
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_Defer_Barrier)
+{
+    unsigned calls = 0;
+
+    parcEpoch_Defer(_countCall, &calls);
+    assertTrue(calls == 0, "Expected the call to be deferred");
+    assertTrue(parcEpoch_GetPendingCount() == 1, "Expected 1 pending, got %zu", parcEpoch_GetPendingCount());
+
+    parcEpoch_Barrier();
+    assertTrue(calls == 1, "Expected the call to have been made by the barrier, got %u", calls);
+    assertTrue(parcEpoch_GetPendingCount() == 0, "Expected nothing pending, got %zu", parcEpoch_GetPendingCount());
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_DeferRelease)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(10);
+    PARCBuffer *reference = parcBuffer_Acquire(buffer);
+
+    parcEpoch_DeferRelease((PARCObject **) &reference);
+    assertNull(reference, "Expected the pointer to be set to NULL");
+    assertTrue(parcObject_GetReferenceCount(buffer) == 2, "Expected the release to be deferred");
+
+    parcEpoch_Barrier();
+    assertTrue(parcObject_GetReferenceCount(buffer) == 1, "Expected the deferred release to have happened");
+
+    parcBuffer_Release(&buffer);
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_Defer_CollectsInBatches)
+{
+    unsigned calls = 0;
+
+    // With no reader holding it back, each batch collection advances the epoch once,
+    // reclaiming what was deferred two epochs ago.
+    for (int i = 0; i < _COLLECT_THRESHOLD * 4; i++) {
+        parcEpoch_Defer(_countCall, &calls);
+    }
+    assertTrue(calls > 0, "Expected some deferred calls to have been made without a barrier");
+    assertTrue(parcEpoch_GetPendingCount() < _COLLECT_THRESHOLD * 4,
+               "Expected the pending count to have been reduced, got %zu", parcEpoch_GetPendingCount());
+    assertTrue(calls + parcEpoch_GetPendingCount() == _COLLECT_THRESHOLD * 4,
+               "Expected every deferred call to be either made or pending");
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_Defer_WaitsForReader)
+{
+    unsigned calls = 0;
+    _Reader reader = { .entered = false, .leave = false };
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _holdCriticalSection, &reader);
+    while (!reader.entered) {
+        sched_yield();
+    }
+
+    parcEpoch_Defer(_countCall, &calls);
+    for (int i = 0; i < 10; i++) {
+        parcEpoch_Collect();
+    }
+    assertTrue(calls == 0, "Expected the call to wait for the reader to leave its critical section");
+
+    reader.leave = true;
+    pthread_join(thread, NULL);
+
+    parcEpoch_Collect();
+    parcEpoch_Collect();
+    assertTrue(calls == 1, "Expected the call once the reader had left, got %u", calls);
+}
+
+static void *
+_deferAndExit(void *arg)
+{
+    parcEpoch_Defer(_countCall, arg);
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcEpoch_Defer_ThreadExit)
+{
+    unsigned calls = 0;
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _deferAndExit, &calls);
+    pthread_join(thread, NULL);
+    assertTrue(calls == 0, "Expected the exiting thread to leave its deferred call pending");
+
+    parcEpoch_Barrier();
+    assertTrue(calls == 1, "Expected the barrier to reclaim what the exited thread left, got %u", calls);
+
+    // The exited thread's record is free for the next thread.
+    pthread_create(&thread, NULL, _deferAndExit, &calls);
+    pthread_join(thread, NULL);
+    parcEpoch_Barrier();
+    assertTrue(calls == 2, "Expected the second thread's call to have been made, got %u", calls);
+}
+
+// ==============================
+// Readers dereference a shared object while a writer replaces it, as an RCU-style configuration swap would.
+
+typedef struct {
+    PARCBuffer *volatile *shared;
+    volatile bool *stop;
+    uint64_t reads;
+    uint64_t errors;
+} _SwapReader;
+
+static void *
+_swapReader(void *arg)
+{
+    _SwapReader *reader = arg;
+
+    while (!*reader->stop) {
+        parcEpoch_Enter();
+        PARCBuffer *buffer = *reader->shared;
+        // A released buffer would fail validation or read back garbage.
+        if (parcObject_GetReferenceCount(buffer) == 0 || parcBuffer_GetAtIndex(buffer, 0) != parcBuffer_GetAtIndex(buffer, 1)) {
+            reader->errors++;
+        }
+        parcEpoch_Exit();
+        reader->reads++;
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcEpoch_DeferRelease_Swap);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    parcEpoch_Barrier();
+
+    if (parcSafeMemory_ReportAllocation(STDOUT_FILENO) != 0) {
+        printf("('%s' leaks memory by %d (allocs - frees)) ", longBowTestCase_GetName(testCase), parcMemory_Outstanding());
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCBuffer *
+_swapValue(uint8_t value)
+{
+    PARCBuffer *result = parcBuffer_Allocate(2);
+    parcBuffer_PutUint8(result, value);
+    parcBuffer_PutUint8(result, value);
+    return parcBuffer_Flip(result);
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcEpoch_DeferRelease_Swap)
+{
+    const int readerCount = 3;
+    PARCBuffer *volatile shared = _swapValue(0);
+    volatile bool stop = false;
+
+    pthread_t thread[readerCount];
+    _SwapReader reader[readerCount];
+    for (int i = 0; i < readerCount; i++) {
+        reader[i] = (_SwapReader) { .shared = &shared, .stop = &stop, .reads = 0, .errors = 0 };
+        pthread_create(&thread[i], NULL, _swapReader, &reader[i]);
+    }
+
+    for (int i = 1; i <= 20000; i++) {
+        PARCBuffer *old = __sync_lock_test_and_set(&shared, _swapValue((uint8_t) i));
+        parcEpoch_DeferRelease((PARCObject **) &old);
+    }
+
+    stop = true;
+    for (int i = 0; i < readerCount; i++) {
+        pthread_join(thread[i], NULL);
+        assertTrue(reader[i].errors == 0, "Reader %d saw %" PRIu64 " released buffers", i, reader[i].errors);
+    }
+
+    PARCBuffer *last = shared;
+    parcBuffer_Release(&last);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcEpoch_Enter_Exit);
+    LONGBOW_RUN_TEST_CASE(Performance, parcEpoch_Defer);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcEpoch_Barrier();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Performance, parcEpoch_Enter_Exit)
+{
+    const int loops = 10000000;
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < loops; i++) {
+        parcEpoch_Enter();
+        parcEpoch_Exit();
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    printf("Enter/Exit: %.1f ns\n", (double) elapsed / loops);
+}
+
+static void
+_nothing(void *pointer)
+{
+}
+
+LONGBOW_TEST_CASE(Performance, parcEpoch_Defer)
+{
+    const int loops = 1000000;
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < loops; i++) {
+        parcEpoch_Defer(_nothing, NULL);
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    printf("Defer and batch collection: %.1f ns per element, %zu still pending\n", (double) elapsed / loops, parcEpoch_GetPendingCount());
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_Epoch);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
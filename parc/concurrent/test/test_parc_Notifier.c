@@ -66,6 +66,7 @@
 #include <poll.h>
 
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Time.h>
 #include <LongBow/unit-test.h>
 
 LONGBOW_TEST_RUNNER(parc_Notifier)
@@ -74,6 +75,7 @@ LONGBOW_TEST_RUNNER(parc_Notifier)
     // Test Fixtures are run in the order specified, but all tests should be idempotent.
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -282,6 +284,12 @@ LONGBOW_TEST_CASE(Global, parcNotifier_Notify_Twice)
 
 LONGBOW_TEST_FIXTURE(Local)
 {
+    LONGBOW_RUN_TEST_CASE(Local, _parcNotifier_Create_Pipe);
+    LONGBOW_RUN_TEST_CASE(Local, _parcNotifier_Signal_Drain_Pipe);
+    LONGBOW_RUN_TEST_CASE(Local, _parcNotifier_Signal_Drain_Eventfd);
+    LONGBOW_RUN_TEST_CASE(Local, _parcNotifier_Drain_Empty);
+    LONGBOW_RUN_TEST_CASE(Local, parcNotifier_Create_Default);
+    LONGBOW_RUN_TEST_CASE(Local, parcNotifier_Notify_Coalesced);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -298,6 +306,237 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+static bool
+_isReadable(PARCNotifier *notifier)
+{
+    struct pollfd pfd = { .fd = parcNotifier_Socket(notifier), .events = POLLIN };
+    return poll(&pfd, 1, 0) == 1;
+}
+
+static void
+_assertSignalDrain(PARCNotifier *notifier)
+{
+    assertFalse(_isReadable(notifier), "Expected a new notifier not to be readable");
+
+    for (int i = 0; i < 5; i++) {
+        _parcNotifier_Signal(notifier);
+    }
+    assertTrue(_isReadable(notifier), "Expected the notifier to be readable after a signal");
+
+    _parcNotifier_Drain(notifier);
+    assertFalse(_isReadable(notifier), "Expected a single drain to clear every signal");
+}
+
+LONGBOW_TEST_CASE(Local, _parcNotifier_Create_Pipe)
+{
+    PARCNotifier *notifier = _parcNotifier_Create(false);
+
+    assertFalse(notifier->isEventfd, "Expected a pipe notifier");
+    assertFalse(notifier->fds[PARCNotifierReadFd] == notifier->fds[PARCNotifierWriteFd],
+                "Expected distinct read and write descriptors for a pipe");
+
+    parcNotifier_Release(&notifier);
+}
+
+LONGBOW_TEST_CASE(Local, _parcNotifier_Signal_Drain_Pipe)
+{
+    PARCNotifier *notifier = _parcNotifier_Create(false);
+    _assertSignalDrain(notifier);
+    parcNotifier_Release(&notifier);
+}
+
+LONGBOW_TEST_CASE(Local, _parcNotifier_Signal_Drain_Eventfd)
+{
+    PARCNotifier *notifier = _parcNotifier_Create(true);
+    assertTrue(notifier->isEventfd == PARCNotifierHaveEventfd,
+               "Expected an eventfd notifier where the platform has one");
+    _assertSignalDrain(notifier);
+    parcNotifier_Release(&notifier);
+}
+
+LONGBOW_TEST_CASE(Local, _parcNotifier_Drain_Empty)
+{
+    PARCNotifier *notifiers[] = { _parcNotifier_Create(false), _parcNotifier_Create(true) };
+
+    for (int i = 0; i < 2; i++) {
+        // Must return at once rather than block.
+        _parcNotifier_Drain(notifiers[i]);
+        assertFalse(_isReadable(notifiers[i]), "Expected the notifier to stay empty");
+        parcNotifier_Release(&notifiers[i]);
+    }
+}
+
+LONGBOW_TEST_CASE(Local, parcNotifier_Create_Default)
+{
+    PARCNotifier *notifier = parcNotifier_Create();
+
+    assertTrue(notifier->isEventfd == PARCNotifierHaveEventfd,
+               "Expected parcNotifier_Create to use an eventfd where the platform has one");
+    if (notifier->isEventfd) {
+        assertTrue(notifier->fds[PARCNotifierReadFd] == notifier->fds[PARCNotifierWriteFd],
+                   "Expected one descriptor for an eventfd");
+    }
+
+    parcNotifier_Release(&notifier);
+}
+
+LONGBOW_TEST_CASE(Local, parcNotifier_Notify_Coalesced)
+{
+    PARCNotifier *notifier = parcNotifier_Create();
+
+    assertTrue(parcNotifier_Notify(notifier), "Expected the first notify to signal");
+    for (int i = 0; i < 10; i++) {
+        assertFalse(parcNotifier_Notify(notifier), "Expected notify %d to coalesce", i);
+    }
+    assertTrue(_isReadable(notifier), "Expected the notifier to be readable");
+
+    parcNotifier_PauseEvents(notifier);
+    assertFalse(_isReadable(notifier), "Expected pause to clear the notifier");
+
+    // A notify while paused is remembered and re-signalled by StartEvents.
+    parcNotifier_Notify(notifier);
+    assertFalse(_isReadable(notifier), "Expected a notify while paused not to signal");
+    parcNotifier_StartEvents(notifier);
+    assertTrue(_isReadable(notifier), "Expected StartEvents to re-signal a skipped notify");
+
+    parcNotifier_Release(&notifier);
+}
+
+// ===============================================================
+
+/*
+ * Ping-pong latency: two threads bounce one notification back and forth over two notifiers.
+ * Cross-thread throughput: one thread notifies as fast as it can while the consumer takes
+ * batches with the PauseEvents / StartEvents protocol.
+ */
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcNotifier_PingPong);
+    LONGBOW_RUN_TEST_CASE(Performance, parcNotifier_Throughput);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _PingPongRounds 100000
+#define _ThroughputNotifications 2000000
+
+typedef struct {
+    PARCNotifier *in;
+    PARCNotifier *out;
+    volatile unsigned produced;
+    unsigned consumed;
+    unsigned wakeups;
+} _BenchmarkPair;
+
+static void
+_waitFor(PARCNotifier *notifier)
+{
+    struct pollfd pfd = { .fd = parcNotifier_Socket(notifier), .events = POLLIN };
+    while (poll(&pfd, 1, -1) != 1) {
+        ;
+    }
+}
+
+static void *
+_pong(void *arg)
+{
+    _BenchmarkPair *pair = arg;
+    for (unsigned i = 0; i < _PingPongRounds; i++) {
+        _waitFor(pair->in);
+        parcNotifier_PauseEvents(pair->in);
+        parcNotifier_StartEvents(pair->in);
+        parcNotifier_Notify(pair->out);
+    }
+    return NULL;
+}
+
+static double
+_pingPong(bool useEventfd)
+{
+    _BenchmarkPair ping = { .in = _parcNotifier_Create(useEventfd), .out = _parcNotifier_Create(useEventfd) };
+    _BenchmarkPair pong = { .in = ping.out, .out = ping.in };
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, _pong, &pong);
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (unsigned i = 0; i < _PingPongRounds; i++) {
+        parcNotifier_Notify(ping.out);
+        _waitFor(ping.in);
+        parcNotifier_PauseEvents(ping.in);
+        parcNotifier_StartEvents(ping.in);
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    pthread_join(thread, NULL);
+    parcNotifier_Release(&ping.in);
+    parcNotifier_Release(&ping.out);
+
+    return (double) elapsed / _PingPongRounds;
+}
+
+static void *
+_produce(void *arg)
+{
+    _BenchmarkPair *pair = arg;
+    for (unsigned i = 0; i < _ThroughputNotifications; i++) {
+        __sync_add_and_fetch(&pair->produced, 1);
+        parcNotifier_Notify(pair->in);
+    }
+    return NULL;
+}
+
+static double
+_throughput(bool useEventfd, unsigned *wakeups)
+{
+    _BenchmarkPair pair = { .in = _parcNotifier_Create(useEventfd) };
+
+    pthread_t thread;
+    uint64_t start = parcTime_NowNanoseconds();
+    pthread_create(&thread, NULL, _produce, &pair);
+
+    while (pair.consumed < _ThroughputNotifications) {
+        _waitFor(pair.in);
+        parcNotifier_PauseEvents(pair.in);
+        pair.consumed = pair.produced;
+        pair.wakeups++;
+        parcNotifier_StartEvents(pair.in);
+    }
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+    pthread_join(thread, NULL);
+    parcNotifier_Release(&pair.in);
+
+    *wakeups = pair.wakeups;
+    return (double) _ThroughputNotifications / ((double) elapsed / 1e9);
+}
+
+LONGBOW_TEST_CASE(Performance, parcNotifier_PingPong)
+{
+    printf("ping-pong round trip, %d rounds\n", _PingPongRounds);
+    printf("  pipe     %8.0f ns\n", _pingPong(false));
+    printf("  eventfd  %8.0f ns\n", _pingPong(true));
+}
+
+LONGBOW_TEST_CASE(Performance, parcNotifier_Throughput)
+{
+    unsigned wakeups;
+
+    printf("cross-thread notifications, %d sent\n", _ThroughputNotifications);
+    double rate = _throughput(false, &wakeups);
+    printf("  pipe     %12.0f notifications/s in %u wakeups\n", rate, wakeups);
+    rate = _throughput(true, &wakeups);
+    printf("  eventfd  %12.0f notifications/s in %u wakeups\n", rate, wakeups);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -60,6 +60,7 @@
 #include "../parc_ThreadPool.c"
 
 #include <stdio.h>
+#include <inttypes.h>
 
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
@@ -254,6 +255,8 @@ LONGBOW_TEST_FIXTURE(Specialization)
 {
     parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
     LONGBOW_RUN_TEST_CASE(Object, parcThreadPool_Execute);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcThreadPool_GetBatchShareCount);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcThreadPool_RegisterMetrics);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -303,6 +306,49 @@ LONGBOW_TEST_CASE(Object, parcThreadPool_Execute)
     parcThreadPool_Release(&pool);
 }
 
+LONGBOW_TEST_CASE(Specialization, parcThreadPool_GetBatchShareCount)
+{
+    assertTrue(parcThreadPool_GetBatchShareCount(NULL, 1000) == 1, "Expected a single share without a pool");
+
+    PARCThreadPool *pool = parcThreadPool_Create(3);
+
+    assertTrue(parcThreadPool_GetBatchShareCount(pool, 0) == 1, "Expected a single share for an empty batch");
+    assertTrue(parcThreadPool_GetBatchShareCount(pool, 2) == 1, "Expected a single share for a small batch");
+    size_t shares = parcThreadPool_GetBatchShareCount(pool, 1000);
+    assertTrue(shares == 4, "Expected a share for the caller and each of 3 threads, actual %zu", shares);
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcThreadPool_RegisterMetrics)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+    PARCMetrics *metrics = parcMetrics_Create();
+
+    parcThreadPool_RegisterMetrics(pool, metrics, "pool");
+    assertTrue(parcMetrics_Size(metrics) == 4, "Expected 4 metrics, actual %zu", parcMetrics_Size(metrics));
+
+    PARCFutureTask *task = parcFutureTask_Create(_function, _function);
+    parcThreadPool_Execute(pool, task);
+    parcFutureTask_Release(&task);
+
+    parcThreadPool_Shutdown(pool);
+    parcThreadPool_AwaitTermination(pool, PARCTimeout_Never);
+
+    PARCJSON *json = parcMetrics_ToJSON(metrics);
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "pool.completedTaskCount");
+    assertTrue(parcJSONValue_GetInteger(value) == 1, "Expected 1 completed task, actual %" PRId64, parcJSONValue_GetInteger(value));
+    value = parcJSON_GetValueByName(json, "pool.queueSize");
+    assertTrue(parcJSONValue_GetInteger(value) == 0, "Expected an empty queue, actual %" PRId64, parcJSONValue_GetInteger(value));
+    assertNotNull(parcJSON_GetValueByName(json, "pool.taskCount"), "Expected pool.taskCount");
+    assertNotNull(parcJSON_GetValueByName(json, "pool.poolSize"), "Expected pool.poolSize");
+    parcJSON_Release(&json);
+
+    parcMetrics_Release(&metrics);
+    parcThreadPool_Release(&pool);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -60,13 +60,9 @@
 
 #include <sys/time.h>
 #include <inttypes.h>
+#include <stdarg.h>
 
-#if __APPLE__
-#include <mach/mach.h>
-#include <mach/clock.h>
-#include <mach/mach_time.h>
-#endif
-
+#include <parc/algol/parc_Clock.h>
 #include <parc/algol/parc_Object.h>
 #include <parc/algol/parc_DisplayIndented.h>
 #include <parc/algol/parc_Memory.h>
@@ -197,90 +193,26 @@ parcStopwatch_ToString(const PARCStopwatch *instance)
     return result;
 }
 
-#if __linux__
 void
 parcStopwatch_StartImpl(PARCStopwatch *timer, ...)
 {
-    struct timespec theTime;
-    clock_gettime(CLOCK_REALTIME_COARSE, &theTime);
-   
-    timer->start = (uint64_t) (theTime.tv_sec * 1000000000) + theTime.tv_nsec;
-   
-    va_list ap;
-    va_start(ap, timer);
-    PARCStopwatch *t;
-   
-    while ((t = va_arg(ap, PARCStopwatch *)) != NULL) {
-        t->start = timer->start;
-    }
-}
-
-static inline uint64_t
-_parcStopwatch_Stop(PARCStopwatch *timer)
-{
-    struct timespec theTime;
-    clock_gettime(CLOCK_REALTIME_COARSE, &theTime);
-   
-    uint64_t result = (uint64_t) (theTime.tv_sec * 1000000000) + theTime.tv_nsec;
-    return result;
-}
-#elif __APPLE__
+    timer->start = parcClock_GetTime(parcClock_TSC());
 
-static mach_timebase_info_data_t _parcStopWatch_TimeBaseInfo;
-
-void
-parcStopwatch_StartImpl(PARCStopwatch *timer, ...)
-{
-    if (_parcStopWatch_TimeBaseInfo.denom == 0) {
-        mach_timebase_info(&_parcStopWatch_TimeBaseInfo);
-    }
-   
-    timer->start = mach_absolute_time() * _parcStopWatch_TimeBaseInfo.numer / _parcStopWatch_TimeBaseInfo.denom;
-   
     va_list ap;
     va_start(ap, timer);
     PARCStopwatch *t;
-   
-    while ((t = va_arg(ap, PARCStopwatch *)) != NULL) {
-        t->start = timer->start;
-    }
-}
 
-static inline uint64_t
-_parcStopwatch_Stop(PARCStopwatch *timer)
-{
-    uint64_t result = mach_absolute_time() * _parcStopWatch_TimeBaseInfo.numer / _parcStopWatch_TimeBaseInfo.denom;
-   
-    return result;
-}
-#else
-void
-parcStopwatch_StartImpl(PARCStopwatch *timer, ...)
-{
-    struct timeval theTime;
-    gettimeofday(&theTime, NULL);
-   
-    timer->start = (uint64_t) (theTime.tv_sec * 1000000000) + theTime.tv_usec * 1000;
-    va_list ap;
-    va_start(ap, timer);
-    PARCStopwatch *t;
-   
     while ((t = va_arg(ap, PARCStopwatch *)) != NULL) {
         t->start = timer->start;
     }
+    va_end(ap);
 }
 
 static inline uint64_t
 _parcStopwatch_Stop(PARCStopwatch *timer)
 {
-    struct timeval theTime;
-    gettimeofday(&theTime, NULL);
-   
-    uint64_t result = theTime.tv_sec * 1000000000 + theTime.tv_usec * 1000;
-   
-    return result;
+    return parcClock_GetTime(parcClock_TSC());
 }
-#endif
 
 static inline uint64_t
 _parcStopWatch_ElapsedTimeNanos(PARCStopwatch *timer)
@@ -61,6 +61,9 @@
  * and a subsequent invocation of one of the `parcStopwatch_ElapsedTime` functions.
  * The `parcStopwatch_Start()` function may be called for a stopwatch effectively resetting the stopwatch to a new starting time.
  *
+ * Time is read from `parcClock_TSC()`, so starting and reading a stopwatch costs nanoseconds
+ * rather than a system call where the processor has an invariant time stamp counter.
+ *
  * @author Glenn Scott, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -435,6 +438,7 @@ void parcStopwatch_StartImpl(PARCStopwatch *stopwatch, ...);
  * Get the number of nanoseconds between the time the PARCStopwatch was started and the time of this function call.
  *
  * The accuracy is dependant upon the operating environment's time resolution.
+ * See `parcClock_TSC()`.
  *
  * @param [in] stopwatch A pointer to a valid PARCStopwatch instance.
  *
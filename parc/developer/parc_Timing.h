@@ -63,6 +63,10 @@
  *    On Darwin, it will use the nano-second SYSTEM_CLOCK.
  *    Otherwise, uses gettimeofday(), which will be micro-second timing.
  *
+ * If the user also defines PARCTIMING_NANOSECONDS, the timing is done on every platform with
+ * parcClock_TSC(), so it will be measured in nano-seconds at the cost of a TSC read where the
+ * processor has an invariant time stamp counter.
+ *
  * This set of headers will define several macros for timing:
  *    parcTiming_Init(prefix)
  *    parcTiming_Fini(prefix)
@@ -103,7 +107,10 @@
 
 #if defined(PARCTIMING_ENABLE)
 // begin platform detection
-#if defined(__i386__) || defined(__x86_64__)
+#if defined(PARCTIMING_NANOSECONDS)
+#define PARCTIMING_CLOCK
+#include <parc/developer/parc_TimingClock.h>
+#elif defined(__i386__) || defined(__x86_64__)
 #define PARCTIMING_INTEL
 #include <parc/developer/parc_TimingIntel.h>
 #elif defined(__APPLE__)
@@ -0,0 +1,376 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Clock.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/developer/parc_Trace.h>
+
+bool _parcTrace_Enabled = false;
+
+/*
+ * One end of a span.
+ */
+typedef struct {
+    uint64_t timestamp;
+    const char *category;
+    const char *name;
+    char phase;
+} _PARCTraceRecord;
+
+/*
+ * The records of one thread.
+ * Only the owning thread writes to the ring.  `head` counts every record ever written and is
+ * masked to find a slot, so once the ring is full each record overwrites the oldest.
+ *
+ * Only the owning thread, or any thread once the owner has exited, may free a ring.
+ * parcTrace_Clear retires the rings of other live threads instead,
+ * and each is freed when its owner next records or exits.
+ */
+typedef struct parc_trace_ring {
+    struct parc_trace_ring *next;
+    uint32_t threadNumber;
+    uint32_t mask;
+    uint64_t head;
+    bool isRetired;
+    bool isOrphaned;
+    _PARCTraceRecord records[];
+} _PARCTraceRing;
+
+// Held to add a ring, to read the rings, and to free them.  Never held while recording.
+static pthread_mutex_t _parcTrace_RingsLock = PTHREAD_MUTEX_INITIALIZER;
+static _PARCTraceRing *_parcTrace_Rings = NULL;
+static _PARCTraceRing *_parcTrace_Retired = NULL;
+static uint32_t _parcTrace_ThreadCount = 0;
+static size_t _parcTrace_Capacity = PARCTrace_DefaultCapacity;
+
+static PARCClock *_parcTrace_Clock = NULL;
+
+// parcTrace_Clear frees the rings and starts a new generation, so each thread knows to allocate another.
+static unsigned _parcTrace_Generation = 1;
+static __thread _PARCTraceRing *_parcTrace_Ring = NULL;
+static __thread unsigned _parcTrace_RingGeneration = 0;
+
+// Tells the rings lock holders when the owner of a ring exits.
+static pthread_once_t _parcTrace_RingKeyOnce = PTHREAD_ONCE_INIT;
+static pthread_key_t _parcTrace_RingKey;
+
+// The size of the text accumulated by parcTrace_WriteChromeJSON before it is written to the output stream.
+#define _PARCTrace_WriteChunk 8192
+
+/*
+ * Remove the given retired ring from the retired list and free it.
+ * The caller must hold the rings lock.
+ */
+static void
+_parcTrace_FreeRetired(_PARCTraceRing *ring)
+{
+    _PARCTraceRing **previous = &_parcTrace_Retired;
+    while (*previous != ring) {
+        previous = &(*previous)->next;
+    }
+    *previous = ring->next;
+    parcMemory_Deallocate((void **) &ring);
+}
+
+static void
+_parcTrace_ThreadExit(void *value)
+{
+    _PARCTraceRing *ring = value;
+
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+    if (ring->isRetired) {
+        _parcTrace_FreeRetired(ring);
+    } else {
+        // Keep the records for parcTrace_WriteChromeJSON; parcTrace_Clear frees the ring.
+        ring->isOrphaned = true;
+    }
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+}
+
+static void
+_parcTrace_CreateRingKey(void)
+{
+    pthread_key_create(&_parcTrace_RingKey, _parcTrace_ThreadExit);
+}
+
+static _PARCTraceRing *
+_parcTrace_CreateRing(void)
+{
+    pthread_once(&_parcTrace_RingKeyOnce, _parcTrace_CreateRingKey);
+
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+
+    // A ring retired by parcTrace_Clear is only freed by the thread that was writing it.
+    if (_parcTrace_Ring != NULL && _parcTrace_Ring->isRetired) {
+        _parcTrace_FreeRetired(_parcTrace_Ring);
+    }
+
+    if (_parcTrace_Clock == NULL) {
+        _parcTrace_Clock = parcClock_TSC();
+    }
+
+    size_t size = sizeof(_PARCTraceRing) + _parcTrace_Capacity * sizeof(_PARCTraceRecord);
+    _PARCTraceRing *result = parcMemory_AllocateAndClear(size);
+    assertNotNull(result, "parcMemory_AllocateAndClear(%zu) returned NULL", size);
+
+    result->mask = (uint32_t) (_parcTrace_Capacity - 1);
+    result->threadNumber = ++_parcTrace_ThreadCount;
+    result->next = _parcTrace_Rings;
+    _parcTrace_Rings = result;
+
+    _parcTrace_Ring = result;
+    _parcTrace_RingGeneration = _parcTrace_Generation;
+    pthread_setspecific(_parcTrace_RingKey, result);
+
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+
+    return result;
+}
+
+static inline void
+_parcTrace_Record(char phase, const char *category, const char *name)
+{
+    _PARCTraceRing *ring = _parcTrace_Ring;
+    if (ring == NULL || _parcTrace_RingGeneration != __atomic_load_n(&_parcTrace_Generation, __ATOMIC_ACQUIRE)) {
+        ring = _parcTrace_CreateRing();
+    }
+
+    uint64_t head = ring->head;
+    _PARCTraceRecord *record = &ring->records[head & ring->mask];
+    record->timestamp = parcClock_GetTime(_parcTrace_Clock);
+    record->category = category;
+    record->name = name;
+    record->phase = phase;
+
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void
+parcTrace_RecordBegin(const char *category, const char *name)
+{
+    _parcTrace_Record('B', category, name);
+}
+
+void
+parcTrace_RecordEnd(const char *category, const char *name)
+{
+    _parcTrace_Record('E', category, name);
+}
+
+void
+parcTrace_Enable(void)
+{
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+    if (_parcTrace_Clock == NULL) {
+        _parcTrace_Clock = parcClock_TSC();
+    }
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+
+    __atomic_store_n(&_parcTrace_Enabled, true, __ATOMIC_RELEASE);
+}
+
+void
+parcTrace_Disable(void)
+{
+    __atomic_store_n(&_parcTrace_Enabled, false, __ATOMIC_RELEASE);
+}
+
+void
+parcTrace_SetCapacity(size_t capacity)
+{
+    size_t result = 2;
+    while (result < capacity) {
+        result <<= 1;
+    }
+
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+    _parcTrace_Capacity = result;
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+}
+
+static inline uint64_t
+_parcTrace_FirstRecord(const _PARCTraceRing *ring, uint64_t head)
+{
+    uint64_t capacity = (uint64_t) ring->mask + 1;
+    return head > capacity ? head - capacity : 0;
+}
+
+size_t
+parcTrace_Count(void)
+{
+    size_t result = 0;
+
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+    for (_PARCTraceRing *ring = _parcTrace_Rings; ring != NULL; ring = ring->next) {
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+        result += head - _parcTrace_FirstRecord(ring, head);
+    }
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+
+    return result;
+}
+
+/*
+ * Copy the string into a JSON string body, escaping as needed and truncating to fit.
+ */
+static void
+_parcTrace_EscapeJSON(char *output, size_t size, const char *string)
+{
+    size_t length = 0;
+
+    for (const char *c = (string != NULL) ? string : "(null)"; *c != 0 && length + 3 < size; c++) {
+        if (*c == '"' || *c == '\\') {
+            output[length++] = '\\';
+            output[length++] = *c;
+        } else if ((unsigned char) *c < 0x20) {
+            output[length++] = ' ';
+        } else {
+            output[length++] = *c;
+        }
+    }
+    output[length] = 0;
+}
+
+bool
+parcTrace_WriteChromeJSON(PARCOutputStream *output)
+{
+    char chunk[_PARCTrace_WriteChunk];
+    size_t length = 0;
+    bool result = true;
+    const char *separator = "\n";
+    int pid = (int) getpid();
+
+    length += snprintf(chunk, sizeof(chunk), "{\"traceEvents\":[");
+
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+    for (_PARCTraceRing *ring = _parcTrace_Rings; result && ring != NULL; ring = ring->next) {
+        uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+        for (uint64_t i = _parcTrace_FirstRecord(ring, head); result && i < head; i++) {
+            const _PARCTraceRecord *record = &ring->records[i & ring->mask];
+
+            char category[128];
+            char name[128];
+            _parcTrace_EscapeJSON(category, sizeof(category), record->category);
+            _parcTrace_EscapeJSON(name, sizeof(name), record->name);
+
+            char event[512];
+            int eventLength = snprintf(event, sizeof(event),
+                                       "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"ts\":%" PRIu64 ".%03u,\"pid\":%d,\"tid\":%u}",
+                                       separator, name, category, record->phase,
+                                       record->timestamp / 1000, (unsigned) (record->timestamp % 1000),
+                                       pid, ring->threadNumber);
+            separator = ",\n";
+
+            if (length + eventLength >= sizeof(chunk)) {
+                chunk[length] = 0;
+                result = parcOutputStream_WriteCString(output, chunk) > 0;
+                length = 0;
+            }
+            memcpy(&chunk[length], event, eventLength);
+            length += eventLength;
+        }
+    }
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+
+    if (result) {
+        chunk[length] = 0;
+        result = parcOutputStream_WriteCString(output, chunk) > 0
+                 && parcOutputStream_WriteCString(output, "\n],\"displayTimeUnit\":\"ns\"}\n") > 0;
+    }
+
+    return result;
+}
+
+void
+parcTrace_Clear(void)
+{
+    pthread_mutex_lock(&_parcTrace_RingsLock);
+
+    while (_parcTrace_Rings != NULL) {
+        _PARCTraceRing *ring = _parcTrace_Rings;
+        _parcTrace_Rings = ring->next;
+        if (ring == _parcTrace_Ring) {
+            _parcTrace_Ring = NULL;
+            pthread_setspecific(_parcTrace_RingKey, NULL);
+            parcMemory_Deallocate((void **) &ring);
+        } else if (ring->isOrphaned) {
+            parcMemory_Deallocate((void **) &ring);
+        } else {
+            // Another thread may be writing the ring right now.
+            ring->isRetired = true;
+            ring->next = _parcTrace_Retired;
+            _parcTrace_Retired = ring;
+        }
+    }
+    _parcTrace_ThreadCount = 0;
+    __atomic_add_fetch(&_parcTrace_Generation, 1, __ATOMIC_RELEASE);
+
+    pthread_mutex_unlock(&_parcTrace_RingsLock);
+}
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_Trace.h
+ * @ingroup developer
+ * @brief Scoped tracing spans recorded into per-thread rings
+ *
+ * A span is a named interval of a thread's time, marked by `parcTrace_Begin()` and `parcTrace_End()`
+ * or by `parcTrace_Scope()`, which ends the span when the enclosing block is left.
+ * Spans nest.
+ *
+ * Tracing is off until `parcTrace_Enable()` is called.  While it is off a span costs one
+ * predictable branch.  While it is on, each end of a span writes a timestamp, taken from
+ * `parcClock_TSC()`, and the span's category and name into a ring owned by the calling thread,
+ * with no lock and no allocation.  A thread's ring is allocated the first time it records,
+ * and once full it overwrites its oldest records.
+ *
+ * The category and name must be string constants, or otherwise outlive the trace, because only
+ * the pointers are recorded.
+ *
+ * The recorded spans are written by `parcTrace_WriteChromeJSON()` in the Chrome trace-event
+ * format, which chrome://tracing and Perfetto display as a timeline per thread.
+ *
+ * The library traces the tasks run by `PARCThreadPool`, the callbacks dispatched by
+ * `PARCEventScheduler`, and hashing, signing and verification.
+ *
+ * If `PARCLibrary_DISABLE_TRACING` is defined, the macros compile to nothing.
+ *
+ * @code
+ * {
+ *     parcTrace_Enable();
+ *
+ *     parcTrace_Begin("example", "outer");
+ *     {
+ *         parcTrace_Scope("example", "inner");
+ *         // ... work ...
+ *     }
+ *     parcTrace_End("example", "outer");
+ *
+ *     parcTrace_Disable();
+ *     parcTrace_WriteChromeJSON(output);
+ *     parcTrace_Clear();
+ * }
+ * @endcode
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_Trace
+#define PARCLibrary_parc_Trace
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <parc/algol/parc_OutputStream.h>
+
+/**
+ * The number of records in a thread's ring, unless changed by `parcTrace_SetCapacity()`.
+ */
+#define PARCTrace_DefaultCapacity 4096
+
+extern bool _parcTrace_Enabled;
+
+/**
+ * Determine if tracing is enabled.
+ *
+ * @return true Spans are being recorded.
+ * @return false Spans are ignored.
+ *
+ * Example:
+ * @code
+ * {
+ *     if (parcTrace_IsEnabled()) {
+ *         printf("Tracing\n");
+ *     }
+ * }
+ * @endcode
+ */
+static inline bool
+parcTrace_IsEnabled(void)
+{
+    return __builtin_expect(__atomic_load_n(&_parcTrace_Enabled, __ATOMIC_RELAXED), false);
+}
+
+/**
+ * Start recording spans, in every thread.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_Enable();
+ * }
+ * @endcode
+ */
+void parcTrace_Enable(void);
+
+/**
+ * Stop recording spans, in every thread.
+ *
+ * The records already made are kept until `parcTrace_Clear()`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_Disable();
+ * }
+ * @endcode
+ */
+void parcTrace_Disable(void);
+
+/**
+ * Set the number of records in the ring of each thread that starts recording after this call.
+ *
+ * @param [in] capacity The number of records, rounded up to a power of 2.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_SetCapacity(65536);
+ *     parcTrace_Enable();
+ * }
+ * @endcode
+ */
+void parcTrace_SetCapacity(size_t capacity);
+
+/**
+ * Record the beginning of a span in the calling thread's ring.
+ *
+ * Use `parcTrace_Begin()`, which only calls this while tracing is enabled.
+ *
+ * @param [in] category A string constant grouping related spans.
+ * @param [in] name A string constant naming the span.
+ */
+void parcTrace_RecordBegin(const char *category, const char *name);
+
+/**
+ * Record the end of a span in the calling thread's ring.
+ *
+ * Use `parcTrace_End()`, which only calls this while tracing is enabled.
+ *
+ * @param [in] category A string constant grouping related spans.
+ * @param [in] name A string constant naming the span.
+ */
+void parcTrace_RecordEnd(const char *category, const char *name);
+
+/**
+ * Get the number of records held in all rings.
+ *
+ * @return The number of records `parcTrace_WriteChromeJSON()` would write.
+ *
+ * Example:
+ * @code
+ * {
+ *     size_t records = parcTrace_Count();
+ * }
+ * @endcode
+ */
+size_t parcTrace_Count(void);
+
+/**
+ * Write the recorded spans to the given output stream as a Chrome trace-event JSON document.
+ *
+ * Each record becomes a "B" or "E" event, with the thread that recorded it as its "tid".
+ * Timestamps are micro-seconds on the `parcClock_TSC()` time line.
+ *
+ * Call this while no thread is recording, for example after `parcTrace_Disable()`.
+ * Records overwritten while they are being written may appear torn.
+ *
+ * @param [in] output A pointer to a valid PARCOutputStream instance.
+ *
+ * @return true The document was written.
+ * @return false The output stream failed.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCFileOutputStream *file = parcFileOutputStream_Create(open("trace.json", O_CREAT | O_WRONLY | O_TRUNC, 0600));
+ *     PARCOutputStream *output = parcFileOutputStream_AsOutputStream(file);
+ *     parcFileOutputStream_Release(&file);
+ *
+ *     parcTrace_Disable();
+ *     parcTrace_WriteChromeJSON(output);
+ *     parcOutputStream_Release(&output);
+ * }
+ * @endcode
+ */
+bool parcTrace_WriteChromeJSON(PARCOutputStream *output);
+
+/**
+ * Discard every record.
+ *
+ * Other threads may go on recording.  The rings of the calling thread and of exited threads are freed now,
+ * the ring of every other thread when that thread next records or exits.
+ * Each thread allocates a new ring the next time it records, so a span open across the call loses its beginning.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_Disable();
+ *     parcTrace_Clear();
+ * }
+ * @endcode
+ */
+void parcTrace_Clear(void);
+
+/*
+ * The state of a span started by parcTrace_Scope().
+ */
+typedef struct {
+    const char *category;
+    const char *name;
+    bool isRecording;
+} _PARCTraceScope;
+
+static inline _PARCTraceScope
+_parcTrace_ScopeBegin(const char *category, const char *name)
+{
+    _PARCTraceScope result = { category, name, parcTrace_IsEnabled() };
+    if (result.isRecording) {
+        parcTrace_RecordBegin(category, name);
+    }
+    return result;
+}
+
+static inline void
+_parcTrace_ScopeEnd(_PARCTraceScope *scope)
+{
+    if (scope->isRecording) {
+        parcTrace_RecordEnd(scope->category, scope->name);
+    }
+}
+
+#define _parcTrace_ScopeVariable(line) _parcTrace_ScopeVariable2(line)
+#define _parcTrace_ScopeVariable2(line) _parcTrace_Scope ## line
+
+#ifdef PARCLibrary_DISABLE_TRACING
+#  define parcTrace_Begin(category, name)
+#  define parcTrace_End(category, name)
+#  define parcTrace_Scope(category, name)
+#else
+/**
+ * Begin a span in the calling thread.
+ *
+ * @param [in] category A string constant grouping related spans.
+ * @param [in] name A string constant naming the span.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_Begin("PARCSigner", "SignDigest");
+ *     PARCSignature *signature = parcSigner_SignDigest(signer, digest);
+ *     parcTrace_End("PARCSigner", "SignDigest");
+ * }
+ * @endcode
+ */
+#  define parcTrace_Begin(category, name) \
+    do { if (parcTrace_IsEnabled()) { parcTrace_RecordBegin((category), (name)); } } while (0)
+
+/**
+ * End the span most recently begun in the calling thread.
+ *
+ * @param [in] category The category given to `parcTrace_Begin()`.
+ * @param [in] name The name given to `parcTrace_Begin()`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_Begin("PARCSigner", "SignDigest");
+ *     PARCSignature *signature = parcSigner_SignDigest(signer, digest);
+ *     parcTrace_End("PARCSigner", "SignDigest");
+ * }
+ * @endcode
+ */
+#  define parcTrace_End(category, name) \
+    do { if (parcTrace_IsEnabled()) { parcTrace_RecordEnd((category), (name)); } } while (0)
+
+/**
+ * Begin a span that ends when the enclosing block is left, however it is left.
+ *
+ * The end is recorded if the beginning was, even if tracing has since been disabled.
+ *
+ * @param [in] category A string constant grouping related spans.
+ * @param [in] name A string constant naming the span.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcTrace_Scope("example", "parse");
+ *     if (length == 0) {
+ *         return NULL;
+ *     }
+ *     // ...
+ * }
+ * @endcode
+ */
+#  define parcTrace_Scope(category, name) \
+    _PARCTraceScope _parcTrace_ScopeVariable(__LINE__) __attribute__((cleanup(_parcTrace_ScopeEnd))) = \
+        _parcTrace_ScopeBegin((category), (name))
+#endif // PARCLibrary_DISABLE_TRACING
+
+#endif // PARCLibrary_parc_Trace
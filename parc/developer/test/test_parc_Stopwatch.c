@@ -231,6 +231,7 @@ LONGBOW_TEST_FIXTURE(Specialization)
 {
     LONGBOW_RUN_TEST_CASE(Specialization, parcStopwatch_Multi);
     LONGBOW_RUN_TEST_CASE(Specialization, parcStopwatch_ElapsedTimeNanos);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcStopwatch_ElapsedTimeNanos_Short);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -281,6 +282,21 @@ LONGBOW_TEST_CASE(Specialization, parcStopwatch_ElapsedTimeNanos)
     parcStopwatch_Release(&instance);
 }
 
+LONGBOW_TEST_CASE(Specialization, parcStopwatch_ElapsedTimeNanos_Short)
+{
+    PARCStopwatch *instance = parcStopwatch_Create();
+
+    parcStopwatch_Start(instance);
+    usleep(1000);
+    uint64_t nanos = parcStopwatch_ElapsedTimeNanos(instance);
+
+    // A coarse clock would report 0 or a whole tick for an interval this short.
+    assertTrue(nanos >= 1000000, "Expected at least 1 ms, actual %" PRIu64 " ns", nanos);
+    assertTrue(nanos < 1000000000, "Expected well under a second, actual %" PRIu64 " ns", nanos);
+
+    parcStopwatch_Release(&instance);
+}
+
 int
 main(int argc, char *argv[argc])
 {
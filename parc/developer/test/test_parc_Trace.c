@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_Trace.c"
+
+#include <fcntl.h>
+#include <inttypes.h>
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/algol/parc_JSON.h>
+#include <parc/concurrent/parc_ThreadPool.h>
+#include <parc/concurrent/parc_FutureTask.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_Trace)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_Trace)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_Trace)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_Disabled);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_BeginEnd);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_Scope);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_Scope_Return);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_Scope_DisabledWithin);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_SetCapacity);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_Clear);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_WriteChromeJSON);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_WriteChromeJSON_Escape);
+    LONGBOW_RUN_TEST_CASE(Global, parcTrace_ThreadPool);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcTrace_Disable();
+    parcTrace_Clear();
+    parcTrace_SetCapacity(PARCTrace_DefaultCapacity);
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/**
+ * Write the trace to a temporary file and parse it back.
+ */
+static PARCJSON *
+_writeAndParse(void)
+{
+    const char *path = "/tmp/test_parc_Trace.json";
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open(path, O_CREAT | O_WRONLY | O_TRUNC, 0600));
+    PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+
+    assertTrue(parcTrace_WriteChromeJSON(output), "Expected the trace to be written");
+    parcOutputStream_Release(&output);
+
+    static char contents[1024 * 1024];
+    int fd = open(path, O_RDONLY);
+    ssize_t length = read(fd, contents, sizeof(contents) - 1);
+    close(fd);
+    unlink(path);
+    contents[length < 0 ? 0 : length] = 0;
+
+    PARCJSON *result = parcJSON_ParseString(contents);
+    assertNotNull(result, "Expected the trace to be valid JSON: %s", contents);
+
+    return result;
+}
+
+static PARCJSONArray *
+_traceEvents(const PARCJSON *trace)
+{
+    const PARCJSONValue *value = parcJSON_GetValueByName(trace, "traceEvents");
+    assertNotNull(value, "Expected a traceEvents member");
+    return parcJSONValue_GetArray(value);
+}
+
+static const char *
+_eventString(const PARCJSONArray *events, size_t index, const char *member)
+{
+    PARCJSON *event = parcJSONValue_GetJSON(parcJSONArray_GetValue(events, index));
+    PARCBuffer *string = parcJSONValue_GetString(parcJSON_GetValueByName(event, member));
+    return parcBuffer_Overlay(string, 0);
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_Disabled)
+{
+    assertFalse(parcTrace_IsEnabled(), "Expected tracing to be off by default");
+
+    parcTrace_Begin("test", "span");
+    parcTrace_End("test", "span");
+    {
+        parcTrace_Scope("test", "scope");
+    }
+
+    assertTrue(parcTrace_Count() == 0, "Expected no records, actual %zu", parcTrace_Count());
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_BeginEnd)
+{
+    parcTrace_Enable();
+    assertTrue(parcTrace_IsEnabled(), "Expected tracing to be on");
+
+    parcTrace_Begin("test", "outer");
+    parcTrace_Begin("test", "inner");
+    parcTrace_End("test", "inner");
+    parcTrace_End("test", "outer");
+
+    assertTrue(parcTrace_Count() == 4, "Expected 4 records, actual %zu", parcTrace_Count());
+
+    _PARCTraceRing *ring = _parcTrace_Ring;
+    const char *expected[] = { "B", "B", "E", "E" };
+    for (int i = 0; i < 4; i++) {
+        assertTrue(ring->records[i].phase == expected[i][0], "Expected phase %s at %d", expected[i], i);
+        assertTrue(i == 0 || ring->records[i].timestamp >= ring->records[i - 1].timestamp, "Expected ordered timestamps");
+    }
+    assertTrue(strcmp(ring->records[1].name, "inner") == 0, "Expected the inner span second");
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_Scope)
+{
+    parcTrace_Enable();
+
+    {
+        parcTrace_Scope("test", "first");
+        parcTrace_Scope("test", "second");
+        assertTrue(parcTrace_Count() == 2, "Expected 2 records within the block, actual %zu", parcTrace_Count());
+    }
+
+    assertTrue(parcTrace_Count() == 4, "Expected 4 records, actual %zu", parcTrace_Count());
+
+    // Scopes end in the reverse of the order they began.
+    _PARCTraceRing *ring = _parcTrace_Ring;
+    assertTrue(ring->records[2].phase == 'E' && strcmp(ring->records[2].name, "second") == 0, "Expected second to end first");
+    assertTrue(ring->records[3].phase == 'E' && strcmp(ring->records[3].name, "first") == 0, "Expected first to end last");
+}
+
+static int
+_scopedFunction(int value)
+{
+    parcTrace_Scope("test", "function");
+    if (value == 0) {
+        return -1;
+    }
+    return value * 2;
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_Scope_Return)
+{
+    parcTrace_Enable();
+
+    _scopedFunction(0);
+    _scopedFunction(1);
+
+    assertTrue(parcTrace_Count() == 4, "Expected every return to end the span, actual %zu records", parcTrace_Count());
+}
+
+static void
+_disableWithinScope(void)
+{
+    parcTrace_Scope("test", "span");
+    parcTrace_Disable();
+}
+
+static void
+_enableWithinScope(void)
+{
+    parcTrace_Scope("test", "unrecorded");
+    parcTrace_Enable();
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_Scope_DisabledWithin)
+{
+    parcTrace_Enable();
+
+    _disableWithinScope();
+    assertTrue(parcTrace_Count() == 2, "Expected the end of a recorded span, actual %zu records", parcTrace_Count());
+
+    _enableWithinScope();
+    assertTrue(parcTrace_Count() == 2, "Expected no end for an unrecorded span, actual %zu records", parcTrace_Count());
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_SetCapacity)
+{
+    parcTrace_SetCapacity(5);
+    parcTrace_Enable();
+
+    for (int i = 0; i < 10; i++) {
+        parcTrace_Begin("test", "span");
+        parcTrace_End("test", "span");
+    }
+
+    // Rounded up to 8, holding the most recent records.
+    assertTrue(parcTrace_Count() == 8, "Expected 8 records, actual %zu", parcTrace_Count());
+    assertTrue(_parcTrace_Ring->head == 20, "Expected 20 records written, actual %" PRIu64, _parcTrace_Ring->head);
+
+    PARCJSON *trace = _writeAndParse();
+    assertTrue(parcJSONArray_GetLength(_traceEvents(trace)) == 8, "Expected 8 events");
+    parcJSON_Release(&trace);
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_Clear)
+{
+    parcTrace_Enable();
+    parcTrace_Begin("test", "span");
+    parcTrace_End("test", "span");
+
+    parcTrace_Disable();
+    parcTrace_Clear();
+    assertTrue(parcTrace_Count() == 0, "Expected no records, actual %zu", parcTrace_Count());
+
+    // The thread gets a new ring.
+    parcTrace_Enable();
+    parcTrace_Begin("test", "span");
+    assertTrue(parcTrace_Count() == 1, "Expected 1 record, actual %zu", parcTrace_Count());
+    assertTrue(_parcTrace_Ring == _parcTrace_Rings, "Expected the thread to use the new ring");
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_WriteChromeJSON)
+{
+    parcTrace_Enable();
+    parcTrace_Begin("test", "outer");
+    {
+        parcTrace_Scope("test", "inner");
+    }
+    parcTrace_End("test", "outer");
+    parcTrace_Disable();
+
+    PARCJSON *trace = _writeAndParse();
+    PARCJSONArray *events = _traceEvents(trace);
+
+    assertTrue(parcJSONArray_GetLength(events) == 4, "Expected 4 events, actual %zu", parcJSONArray_GetLength(events));
+    assertTrue(strcmp(_eventString(events, 0, "ph"), "B") == 0, "Expected a begin event first");
+    assertTrue(strcmp(_eventString(events, 1, "name"), "inner") == 0, "Expected the inner span second");
+    assertTrue(strcmp(_eventString(events, 3, "ph"), "E") == 0, "Expected an end event last");
+    assertTrue(strcmp(_eventString(events, 3, "cat"), "test") == 0, "Expected the category test");
+
+    PARCJSON *event = parcJSONValue_GetJSON(parcJSONArray_GetValue(events, 0));
+    assertTrue(parcJSONValue_GetInteger(parcJSON_GetValueByName(event, "pid")) == getpid(), "Expected this process's pid");
+    assertTrue(parcJSONValue_GetInteger(parcJSON_GetValueByName(event, "tid")) == _parcTrace_Ring->threadNumber,
+               "Expected this thread's number");
+
+    parcJSON_Release(&trace);
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_WriteChromeJSON_Escape)
+{
+    parcTrace_Enable();
+    parcTrace_Begin("test", "a \"quoted\\name\"");
+    parcTrace_End("test", "a \"quoted\\name\"");
+    parcTrace_Disable();
+
+    PARCJSON *trace = _writeAndParse();
+    PARCJSONArray *events = _traceEvents(trace);
+
+    const char *name = _eventString(events, 0, "name");
+    assertTrue(strcmp(name, "a \"quoted\\name\"") == 0, "Expected the name to survive escaping, actual '%s'", name);
+
+    parcJSON_Release(&trace);
+}
+
+static void *
+_task(PARCFutureTask *task, void *parameter)
+{
+    return parameter;
+}
+
+LONGBOW_TEST_CASE(Global, parcTrace_ThreadPool)
+{
+    parcTrace_Enable();
+
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+    PARCFutureTask *task = parcFutureTask_Create(_task, _task);
+    parcThreadPool_Execute(pool, task);
+    parcThreadPool_Execute(pool, task);
+    parcFutureTask_Release(&task);
+
+    parcThreadPool_Shutdown(pool);
+    parcThreadPool_AwaitTermination(pool, PARCTimeout_Never);
+    parcThreadPool_Release(&pool);
+
+    parcTrace_Disable();
+
+    // The workers have exited, but their rings remain.
+    PARCJSON *trace = _writeAndParse();
+    PARCJSONArray *events = _traceEvents(trace);
+
+    size_t tasks = 0;
+    for (size_t i = 0; i < parcJSONArray_GetLength(events); i++) {
+        if (strcmp(_eventString(events, i, "cat"), "PARCThreadPool") == 0 && strcmp(_eventString(events, i, "ph"), "B") == 0) {
+            tasks++;
+        }
+    }
+    assertTrue(tasks == 2, "Expected 2 task spans, actual %zu", tasks);
+
+    parcJSON_Release(&trace);
+}
+
+#define _THREAD_COUNT 4
+#define _SPANS_PER_THREAD 1000
+
+static void *
+_tracer(void *arg)
+{
+    for (int i = 0; i < _SPANS_PER_THREAD; i++) {
+        parcTrace_Scope("test", "thread");
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcTrace_Threads);
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcTrace_Clear_WhileRecording);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    parcTrace_Disable();
+    parcTrace_Clear();
+
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcTrace_Threads)
+{
+    parcTrace_Enable();
+
+    pthread_t threads[_THREAD_COUNT];
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, _tracer, NULL);
+    }
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    size_t expected = _THREAD_COUNT * _SPANS_PER_THREAD * 2;
+    assertTrue(parcTrace_Count() == expected, "Expected %zu records, actual %zu", expected, parcTrace_Count());
+
+    size_t rings = 0;
+    for (_PARCTraceRing *ring = _parcTrace_Rings; ring != NULL; ring = ring->next) {
+        assertTrue(ring->head == _SPANS_PER_THREAD * 2, "Expected each thread to fill its own ring");
+        rings++;
+    }
+    assertTrue(rings == _THREAD_COUNT, "Expected a ring per thread, actual %zu", rings);
+}
+
+static volatile bool _recordersStop;
+
+static void *
+_recorder(void *parameter)
+{
+    while (_recordersStop == false) {
+        parcTrace_Scope("test", "recorder");
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcTrace_Clear_WhileRecording)
+{
+    parcTrace_SetCapacity(64);
+    parcTrace_Enable();
+
+    _recordersStop = false;
+    pthread_t threads[_THREAD_COUNT];
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, _recorder, NULL);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        parcTrace_Clear();
+    }
+
+    _recordersStop = true;
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    assertNull(_parcTrace_Retired, "Expected each thread to free its retired ring when it exited");
+
+    parcTrace_SetCapacity(PARCTrace_DefaultCapacity);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcTrace_Scope);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcTrace_Disable();
+    parcTrace_Clear();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_nanosecondsPerSpan(int spans)
+{
+    PARCClock *clock = parcClock_Monotonic();
+    struct timeval start, stop;
+
+    parcClock_GetTimeval(clock, &start);
+    for (int i = 0; i < spans; i++) {
+        parcTrace_Scope("test", "performance");
+    }
+    parcClock_GetTimeval(clock, &stop);
+
+    return ((stop.tv_sec - start.tv_sec) * 1e9 + (stop.tv_usec - start.tv_usec) * 1e3) / spans;
+}
+
+LONGBOW_TEST_CASE(Performance, parcTrace_Scope)
+{
+    const int spans = 10000000;
+
+    printf("Disabled %.1f ns per span\n", _nanosecondsPerSpan(spans));
+
+    parcTrace_Enable();
+    printf("Enabled %.1f ns per span\n", _nanosecondsPerSpan(spans));
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_Trace);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_FileInputStream.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/logging/parc_LogReporterBinary.h>
+#include <parc/logging/parc_LogReporterFile.h>
+#include <parc/logging/parc_LogReporterTextStdout.h>
+
+static int
+parcLogDecode_File(const char *fileName, bool syslog)
+{
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) {
+        fprintf(stderr, "Error: %s %s\n", fileName, strerror(errno));
+        return 1;
+    }
+
+    PARCFileInputStream *inputStream = parcFileInputStream_Create(fd);
+    PARCBuffer *input = parcFileInputStream_ReadFile(inputStream);
+    parcFileInputStream_Release(&inputStream);
+    if (input == NULL) {
+        fprintf(stderr, "Error: %s %s\n", fileName, strerror(errno));
+        return 1;
+    }
+    parcBuffer_Flip(input);
+
+    PARCLogReporter *reporter;
+    if (syslog) {
+        PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(dup(STDOUT_FILENO));
+        PARCOutputStream *output = parcFileOutputStream_AsOutputStream(fileOutput);
+        parcFileOutputStream_Release(&fileOutput);
+        reporter = parcLogReporterFile_Create(output);
+        parcOutputStream_Release(&output);
+    } else {
+        reporter = parcLogReporterTextStdout_Create();
+    }
+
+    parcLogReporterBinary_Decode(input, reporter);
+    parcLogReporter_Release(&reporter);
+
+    int result = 0;
+    if (parcBuffer_Remaining(input) > 0) {
+        fprintf(stderr, "Error: %s is malformed or truncated after %zu bytes\n", fileName, parcBuffer_Position(input));
+        result = 1;
+    }
+    parcBuffer_Release(&input);
+
+    return result;
+}
+
+void
+printUsage(char *progName)
+{
+    printf("usage: %s [-h | --help] [-s | --syslog] fileName\n", progName);
+    printf("\n");
+    printf("Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).\n");
+    printf("\n");
+    printf("All Rights Reserved. Use is subject to license terms.\n");
+    printf("\n");
+    printf("Print the entries of a binary log written by parcLogReporterBinary as text.\n");
+    printf("\n");
+    printf("optional arguments:\n");
+    printf("\t-h, --help\tShow this help message and exit\n");
+    printf("\t-s, --syslog\tPrint the entries in the RFC 5424 format of parcLogReporterFile\n");
+    printf("\n");
+    printf("\t\t\texample: ./parc-logdecode -s app.plog\n");
+    printf("\n");
+}
+
+int
+main(int argc, char *argv[])
+{
+    char *programName = "parc-logdecode";
+    if (argc < 2) {
+        printUsage(programName);
+        exit(1);
+    }
+
+    bool syslog = false;
+    char *arg = argv[1];
+    if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) {
+        printUsage(programName);
+        return 0;
+    } else if (strcmp(arg, "-s") == 0 || strcmp(arg, "--syslog") == 0) {
+        syslog = true;
+        if (argc < 3) {
+            printUsage(programName);
+            exit(1);
+        }
+        arg = argv[2];
+    }
+
+    return parcLogDecode_File(arg, syslog);
+}
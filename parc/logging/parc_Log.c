@@ -68,6 +68,7 @@
 
 #include <parc/logging/parc_Log.h>
 #include <parc/logging/parc_LogReporter.h>
+#include <parc/logging/parc_LogRecord.h>
 
 struct PARCLog {
     char *hostName;
@@ -75,6 +76,7 @@ struct PARCLog {
     char *processId;
     uint64_t messageId;
     PARCLogLevel level;
+    bool isDeferred;
     PARCLogReporter *reporter;
 };
 
@@ -116,6 +118,7 @@ parcLog_Create(const char *hostName, const char *applicationName, const char *pr
     result->processId = parcMemory_StringDuplicate(processId, strlen(processId));
     result->messageId = 0;
     result->level = PARCLogLevel_Off;
+    result->isDeferred = false;
     result->reporter = parcLogReporter_Acquire(reporter);
     return result;
 }
@@ -139,6 +142,14 @@ parcLog_SetLevel(PARCLog *logger, const PARCLogLevel level)
     return oldLevel;
 }
 
+bool
+parcLog_SetDeferredFormatting(PARCLog *log, bool deferred)
+{
+    bool result = log->isDeferred;
+    log->isDeferred = deferred;
+    return result;
+}
+
 static PARCLogEntry *
 _parcLog_CreateEntry(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap)
 {
@@ -163,13 +174,36 @@ _parcLog_CreateEntry(PARCLog *log, PARCLogLevel level, uint64_t messageId, const
     return result;
 }
 
+static PARCLogEntry *
+_parcLog_CreateDeferredEntry(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap)
+{
+    PARCLogEntry *result = NULL;
+
+    // The caller formats the message from its own va_list if this one cannot be captured.
+    va_list copy;
+    va_copy(copy, ap);
+    PARCLogRecord record;
+    if (parcLogRecord_Capture(&record, level, messageId, format, copy)) {
+        result = parcLogEntry_CreateDeferred(log->hostName, log->applicationName, log->processId, &record);
+    }
+    va_end(copy);
+
+    return result;
+}
+
 bool
 parcLog_MessageVaList(PARCLog *log, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap)
 {
     bool result = false;
 
     if (parcLog_IsLoggable(log, level)) {
-        PARCLogEntry *entry = _parcLog_CreateEntry(log, level, messageId, format, ap);
+        PARCLogEntry *entry = NULL;
+        if (log->isDeferred) {
+            entry = _parcLog_CreateDeferredEntry(log, level, messageId, format, ap);
+        }
+        if (entry == NULL) {
+            entry = _parcLog_CreateEntry(log, level, messageId, format, ap);
+        }
 
         parcLogReporter_Report(log->reporter, entry);
         parcLogEntry_Release(&entry);
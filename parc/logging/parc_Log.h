@@ -247,6 +247,38 @@ PARCLogLevel parcLog_SetLevel(PARCLog *log, const PARCLogLevel level);
  */
 PARCLogLevel parcLog_GetLevel(const PARCLog *log);
 
+/**
+ * Set whether the given PARCLog defers formatting its messages.
+ *
+ * When formatting is deferred, a message is captured as a `PARCLogRecord`
+ * holding the format string pointer and the raw argument values,
+ * and the text is produced only when a `PARCLogReporter` asks for the entry's payload,
+ * or never, if the reporter writes the record in binary form.
+ * Format strings given to a deferring PARCLog must therefore outlive the entries it reports,
+ * as string literals do.
+ * Messages whose format cannot be captured are formatted immediately as usual.
+ *
+ * @param [in] log A pointer to valid instance of PARCLog.
+ * @param [in] deferred true to defer formatting, false to format messages when they are logged.
+ *
+ * @return The previous setting.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLog *log = parcLog_Create("localhost", "myApp", "daemon", reporter);
+ *     parcLog_SetDeferredFormatting(log, true);
+ *
+ *     parcLog_Info(log, "Received %zu bytes from %s", length, peerName);
+ *
+ *     parcLog_Release(&log);
+ * }
+ * @endcode
+ *
+ * @see parcLogReporterBinary_Create
+ */
+bool parcLog_SetDeferredFormatting(PARCLog *log, bool deferred);
+
 /**
  * Test if a PARCLogLevel would be logged by the current state of the given PARCLog instance.
  *
@@ -83,6 +83,9 @@ struct PARCLogEntry {
     uint64_t messageId;
 
     PARCBuffer *payload;
+
+    bool isDeferred;
+    PARCLogRecord record;
 };
 
 static void
@@ -93,7 +96,9 @@ _parcLogEntry_Destroy(PARCLogEntry **entryPtr)
     parcMemory_Deallocate((void **) &entry->hostName);
     parcMemory_Deallocate((void **) &entry->applicationName);
     parcMemory_Deallocate((void **) &entry->processName);
-    parcBuffer_Release(&entry->payload);
+    if (entry->payload != NULL) {
+        parcBuffer_Release(&entry->payload);
+    }
 }
 
 static char *
@@ -104,9 +109,10 @@ _toString(const PARCLogEntry *entry)
     parcBufferComposer_Format(composer, "%ld.%06d %d ",
                               (long) entry->timeStamp.tv_sec, (int) entry->timeStamp.tv_usec, entry->level);
 
-    size_t position = parcBuffer_Position(entry->payload);
-    parcBufferComposer_PutBuffer(composer, entry->payload);
-    parcBuffer_SetPosition(entry->payload, position);
+    PARCBuffer *payload = parcLogEntry_GetPayload(entry);
+    size_t position = parcBuffer_Position(payload);
+    parcBufferComposer_PutBuffer(composer, payload);
+    parcBuffer_SetPosition(payload, position);
 
     PARCBuffer *buffer = parcBufferComposer_GetBuffer(composer);
     parcBuffer_Rewind(buffer);
@@ -140,6 +146,31 @@ parcLogEntry_Create(PARCLogLevel level,
     result->messageId = messageId;
     result->level = level;
     result->payload = parcBuffer_Acquire(payload);
+    result->isDeferred = false;
+
+    return result;
+}
+
+PARCLogEntry *
+parcLogEntry_CreateDeferred(const char *hostName,
+                            const char *applicationName,
+                            const char *processName,
+                            const PARCLogRecord *record)
+{
+    PARCLogEntry *result = parcObject_CreateInstance(PARCLogEntry);
+    if (result == NULL) {
+        trapOutOfMemory("Creating an instance of PARCLogEntry.");
+    }
+    result->version = _parcLog_Version;
+    result->timeStamp = record->timeStamp;
+    result->hostName = parcMemory_StringDuplicate(hostName, strlen(hostName));
+    result->applicationName = parcMemory_StringDuplicate(applicationName, strlen(applicationName));
+    result->processName = parcMemory_StringDuplicate(processName, strlen(processName));
+    result->messageId = record->messageId;
+    result->level = record->level;
+    result->payload = NULL;
+    result->isDeferred = true;
+    result->record = *record;
 
     return result;
 }
@@ -151,7 +182,29 @@ parcObject_ImplementRelease(parcLogEntry, PARCLogEntry);
 PARCBuffer *
 parcLogEntry_GetPayload(const PARCLogEntry *instance)
 {
-    return instance->payload;
+    PARCBuffer *result = __atomic_load_n(&instance->payload, __ATOMIC_ACQUIRE);
+
+    if (result == NULL) {
+        // Reporters on several threads may format a deferred entry at once; the first to publish its payload wins.
+        PARCBufferComposer *composer = parcBufferComposer_Allocate(128);
+        parcLogRecord_Format(&instance->record, composer);
+        PARCBuffer *payload = parcBufferComposer_ProduceBuffer(composer);
+        parcBufferComposer_Release(&composer);
+
+        if (__sync_bool_compare_and_swap(&((PARCLogEntry *) instance)->payload, NULL, payload)) {
+            result = payload;
+        } else {
+            parcBuffer_Release(&payload);
+            result = __atomic_load_n(&instance->payload, __ATOMIC_ACQUIRE);
+        }
+    }
+    return result;
+}
+
+const PARCLogRecord *
+parcLogEntry_GetRecord(const PARCLogEntry *instance)
+{
+    return instance->isDeferred ? &instance->record : NULL;
 }
 
 const struct timeval *
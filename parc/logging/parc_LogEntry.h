@@ -84,6 +84,7 @@ struct PARCLogEntry;
 typedef struct PARCLogEntry PARCLogEntry;
 
 #include <parc/logging/parc_LogLevel.h>
+#include <parc/logging/parc_LogRecord.h>
 
 /**
  * Create a PARCLogEntry instance.
@@ -114,6 +115,41 @@ PARCLogEntry *parcLogEntry_Create(PARCLogLevel level,
                                   const struct timeval timeStamp,
                                   PARCBuffer *payload);
 
+/**
+ * Create a PARCLogEntry instance whose payload is formatted from a `PARCLogRecord` only when it is needed.
+ *
+ * The level, message identifier and time stamp of the entry are those of the record.
+ * The record is copied into the entry, but the format string it refers to must outlive the entry.
+ * The payload is rendered the first time `parcLogEntry_GetPayload` is called,
+ * which may happen on several threads at once.
+ *
+ * @param [in] hostName The hostname identifing the machine that originally sent the message.
+ * @param [in] applicationName The application name identifing the device or application that originated the message.
+ * @param [in] processId An identifier having no specific meaning,
+ *    except that a change in the value indicates there has been a discontinuity in a series of
+ *    otherwise linear PARCLogEntry instances.
+ * @param [in] record A pointer to a captured `PARCLogRecord`.
+ *
+ * @return non-NULL A valid instance of PARCLogEntry.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogRecord record;
+ *     parcLogRecord_Capture(&record, PARCLogLevel_Info, 0, format, ap);
+ *
+ *     PARCLogEntry *entry = parcLogEntry_CreateDeferred("localhost", "myApp", "daemon", &record);
+ *     parcLogEntry_Release(&entry);
+ * }
+ * @endcode
+ *
+ * @see parcLogRecord_Capture
+ */
+PARCLogEntry *parcLogEntry_CreateDeferred(const char *hostName,
+                                          const char *applicationName,
+                                          const char *processId,
+                                          const PARCLogRecord *record);
+
 /**
  * Increase the number of references to a `PARCLogEntry` instance.
  *
@@ -191,6 +227,9 @@ char *parcLogEntry_ToString(const PARCLogEntry *entry);
 /**
  * Get the payload of the specified PARCLogEntry.
  *
+ * The payload of an entry created by `parcLogEntry_CreateDeferred` is formatted by the first call.
+ * Concurrent first calls all return the same payload.
+ *
  * @param [in] instance A pointer to a valid instance of PARCLogEntry.
  *
  * @return A pointer to the payload of the PARCLogEntry.
@@ -312,4 +351,24 @@ const char *parcLogEntry_GetProcessName(const PARCLogEntry *instance);
  */
 uint64_t parcLogEntry_GetMessageId(const PARCLogEntry *instance);
 
+
+/**
+ * Get the `PARCLogRecord` of a PARCLogEntry created by `parcLogEntry_CreateDeferred`.
+ *
+ * @param [in] instance A pointer to a valid instance of PARCLogEntry.
+ *
+ * @return NULL The entry was created with a formatted payload.
+ * @return non-NULL A pointer to the record of the entry.
+ *
+ * Example:
+ * @code
+ * {
+ *     const PARCLogRecord *record = parcLogEntry_GetRecord(entry);
+ *     if (record != NULL) {
+ *         parcLogRecord_Encode(record, composer);
+ *     }
+ * }
+ * @endcode
+ */
+const PARCLogRecord *parcLogEntry_GetRecord(const PARCLogEntry *instance);
 #endif
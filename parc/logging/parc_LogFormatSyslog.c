@@ -59,6 +59,7 @@
 #include <config.h>
 
 #include <inttypes.h>
+#include <stdio.h>
 
 #include <parc/logging/parc_LogFormatSyslog.h>
 #include <parc/algol/parc_BufferComposer.h>
@@ -144,15 +145,19 @@ parcLogFormatSyslog_FormatEntry(const PARCLogEntry *entry)
 
     PARCBufferComposer *composer = parcBufferComposer_Allocate(128);
 
-    parcBufferComposer_Format(composer, "<%s> %d ",
-                              parcLogLevel_ToString(parcLogEntry_GetLevel(entry)), parcLogEntry_GetVersion(entry));
+    char version[16];
+    snprintf(version, sizeof(version), "%d", parcLogEntry_GetVersion(entry));
+
     parcBufferComposer_PutStrings(composer,
+                                  "<", parcLogLevel_ToString(parcLogEntry_GetLevel(entry)), "> ", version, " ",
                                   theTime, " ",
                                   parcLogEntry_GetHostName(entry), " ",
                                   parcLogEntry_GetApplicationName(entry), " ",
                                   parcLogEntry_GetProcessName(entry), " ", NULL);
 
-    parcBufferComposer_Format(composer, "%" PRId64 " [ ", parcLogEntry_GetMessageId(entry));
+    char messageId[24];
+    snprintf(messageId, sizeof(messageId), "%" PRId64, parcLogEntry_GetMessageId(entry));
+    parcBufferComposer_PutStrings(composer, messageId, " [ ", NULL);
     parcBufferComposer_PutBuffer(composer, payload);
     parcBufferComposer_PutStrings(composer, " ]\n", NULL);
     PARCBuffer *result = parcBuffer_Flip(parcBuffer_Acquire(parcBufferComposer_GetBuffer(composer)));
@@ -59,6 +59,7 @@
 #include <config.h>
 
 #include <inttypes.h>
+#include <stdio.h>
 
 #include <parc/logging/parc_LogFormatText.h>
 #include <parc/algol/parc_BufferComposer.h>
@@ -81,7 +82,9 @@ parcLogFormatText_FormatEntry(const PARCLogEntry *entry)
                                   parcLogEntry_GetApplicationName(entry), " ",
                                   parcLogEntry_GetProcessName(entry), " ", NULL);
 
-    parcBufferComposer_Format(composer, "%" PRId64 " [ ", parcLogEntry_GetMessageId(entry));
+    char messageId[24];
+    snprintf(messageId, sizeof(messageId), "%" PRId64, parcLogEntry_GetMessageId(entry));
+    parcBufferComposer_PutStrings(composer, messageId, " [ ", NULL);
     parcBufferComposer_PutBuffer(composer, payload);
     parcBufferComposer_PutStrings(composer, " ]\n", NULL);
     PARCBuffer *result = parcBuffer_Flip(parcBuffer_Acquire(parcBufferComposer_GetBuffer(composer)));
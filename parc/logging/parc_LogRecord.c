@@ -0,0 +1,622 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Memory.h>
+#include <parc/logging/parc_LogRecord.h>
+
+/*
+ * The C type of a captured argument, which determines how it is passed back to snprintf when rendered.
+ */
+typedef enum {
+    _PARCLogRecordType_Int,
+    _PARCLogRecordType_Long,
+    _PARCLogRecordType_LongLong,
+    _PARCLogRecordType_IntMax,
+    _PARCLogRecordType_Size,
+    _PARCLogRecordType_PtrDiff,
+    _PARCLogRecordType_Double,
+    _PARCLogRecordType_String,
+    _PARCLogRecordType_Pointer,
+    _PARCLogRecordType_Count
+} _PARCLogRecordType;
+
+// A string argument that was NULL when captured.
+#define _PARCLogRecord_NullString -1
+
+// The longest conversion specification accepted, including the '%'.
+#define _PARCLogRecord_MaximumSpecification 32
+
+/*
+ * A single conversion specification parsed from a format string.
+ */
+typedef struct {
+    size_t length;
+    int starCount;
+    bool hasPrecision;
+    int precision;
+    _PARCLogRecordType type;
+} _PARCLogRecordConversion;
+
+/*
+ * Parse the conversion specification starting at the '%' in @p specification.
+ * Returns false for a conversion this implementation cannot capture.
+ * A literal "%%" is reported with a type of _PARCLogRecordType_Count and no arguments.
+ */
+static bool
+_parcLogRecord_ParseConversion(const char *specification, _PARCLogRecordConversion *conversion)
+{
+    const char *p = specification + 1;
+
+    conversion->starCount = 0;
+    conversion->hasPrecision = false;
+    conversion->precision = 0;
+
+    if (*p == '%') {
+        conversion->length = 2;
+        conversion->type = _PARCLogRecordType_Count;
+        return true;
+    }
+
+    while (*p != 0 && strchr("-+ #0'", *p) != NULL) {
+        p++;
+    }
+
+    if (*p == '*') {
+        conversion->starCount++;
+        p++;
+    } else {
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+
+    if (*p == '.') {
+        conversion->hasPrecision = true;
+        p++;
+        if (*p == '*') {
+            conversion->starCount++;
+            conversion->precision = -1;
+            p++;
+        } else {
+            while (*p >= '0' && *p <= '9') {
+                conversion->precision = conversion->precision * 10 + (*p - '0');
+                p++;
+            }
+        }
+    }
+
+    _PARCLogRecordType integerType = _PARCLogRecordType_Int;
+    bool isWide = false;
+    switch (*p) {
+        case 'h':
+            p += (p[1] == 'h') ? 2 : 1;
+            break;
+        case 'l':
+            if (p[1] == 'l') {
+                integerType = _PARCLogRecordType_LongLong;
+                p += 2;
+            } else {
+                integerType = _PARCLogRecordType_Long;
+                isWide = true;
+                p++;
+            }
+            break;
+        case 'q':
+            integerType = _PARCLogRecordType_LongLong;
+            p++;
+            break;
+        case 'j':
+            integerType = _PARCLogRecordType_IntMax;
+            p++;
+            break;
+        case 'z':
+            integerType = _PARCLogRecordType_Size;
+            p++;
+            break;
+        case 't':
+            integerType = _PARCLogRecordType_PtrDiff;
+            p++;
+            break;
+        default:
+            break;
+    }
+
+    switch (*p) {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+            conversion->type = integerType;
+            break;
+        case 'c':
+            conversion->type = _PARCLogRecordType_Int;
+            break;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': case 'a': case 'A':
+            conversion->type = _PARCLogRecordType_Double;
+            break;
+        case 's':
+            if (isWide) {
+                return false;
+            }
+            conversion->type = _PARCLogRecordType_String;
+            break;
+        case 'p':
+            conversion->type = _PARCLogRecordType_Pointer;
+            break;
+        default:
+            // %n, the L modifier, and anything unrecognised.
+            return false;
+    }
+
+    conversion->length = (size_t) (p - specification) + 1;
+    return conversion->length < _PARCLogRecord_MaximumSpecification;
+}
+
+static bool
+_parcLogRecord_AddArgument(PARCLogRecord *record, _PARCLogRecordType type)
+{
+    if (record->argumentCount >= PARCLogRecord_MaximumArguments) {
+        return false;
+    }
+    record->types[record->argumentCount++] = (uint8_t) type;
+    return true;
+}
+
+static bool
+_parcLogRecord_CaptureString(PARCLogRecord *record, const char *string, const _PARCLogRecordConversion *conversion, int precision)
+{
+    if (!_parcLogRecord_AddArgument(record, _PARCLogRecordType_String)) {
+        return false;
+    }
+
+    if (string == NULL) {
+        record->arguments[record->argumentCount - 1].integer = _PARCLogRecord_NullString;
+        return true;
+    }
+
+    // A precision allows the argument to be an array that is not nul-terminated.
+    size_t length = (conversion->hasPrecision && precision >= 0) ? strnlen(string, (size_t) precision) : strlen(string);
+    if (record->dataLength + length + 1 > PARCLogRecord_DataCapacity) {
+        return false;
+    }
+
+    record->arguments[record->argumentCount - 1].integer = record->dataLength;
+    memcpy(&record->data[record->dataLength], string, length);
+    record->data[record->dataLength + length] = 0;
+    record->dataLength += length + 1;
+    return true;
+}
+
+bool
+parcLogRecord_Capture(PARCLogRecord *record, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap)
+{
+    record->format = format;
+    gettimeofday(&record->timeStamp, NULL);
+    record->messageId = messageId;
+    record->level = level;
+    record->argumentCount = 0;
+    record->dataLength = 0;
+
+    for (const char *p = strchr(format, '%'); p != NULL; p = strchr(p, '%')) {
+        _PARCLogRecordConversion conversion;
+        if (!_parcLogRecord_ParseConversion(p, &conversion)) {
+            return false;
+        }
+        p += conversion.length;
+
+        if (conversion.type == _PARCLogRecordType_Count) {
+            continue;
+        }
+
+        int precision = conversion.precision;
+        for (int i = 0; i < conversion.starCount; i++) {
+            if (!_parcLogRecord_AddArgument(record, _PARCLogRecordType_Int)) {
+                return false;
+            }
+            precision = va_arg(ap, int);
+            record->arguments[record->argumentCount - 1].integer = precision;
+        }
+
+        if (conversion.type == _PARCLogRecordType_String) {
+            if (!_parcLogRecord_CaptureString(record, va_arg(ap, const char *), &conversion, precision)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (!_parcLogRecord_AddArgument(record, conversion.type)) {
+            return false;
+        }
+        int64_t *integer = &record->arguments[record->argumentCount - 1].integer;
+
+        switch (conversion.type) {
+            case _PARCLogRecordType_Int:
+                *integer = va_arg(ap, int);
+                break;
+            case _PARCLogRecordType_Long:
+                *integer = va_arg(ap, long);
+                break;
+            case _PARCLogRecordType_LongLong:
+                *integer = va_arg(ap, long long);
+                break;
+            case _PARCLogRecordType_IntMax:
+                *integer = va_arg(ap, intmax_t);
+                break;
+            case _PARCLogRecordType_Size:
+                *integer = (int64_t) va_arg(ap, size_t);
+                break;
+            case _PARCLogRecordType_PtrDiff:
+                *integer = va_arg(ap, ptrdiff_t);
+                break;
+            case _PARCLogRecordType_Double:
+                record->arguments[record->argumentCount - 1].real = va_arg(ap, double);
+                break;
+            case _PARCLogRecordType_Pointer:
+                record->arguments[record->argumentCount - 1].pointer = va_arg(ap, void *);
+                break;
+            default:
+                trapIllegalValue(conversion.type, "Unexpected argument type %d", conversion.type);
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Check that the argument types of a record agree with its format string,
+ * so that a record decoded from an untrusted source can be rendered safely.
+ */
+static bool
+_parcLogRecord_IsConsistent(const PARCLogRecord *record)
+{
+    unsigned argument = 0;
+
+    for (const char *p = strchr(record->format, '%'); p != NULL; p = strchr(p, '%')) {
+        _PARCLogRecordConversion conversion;
+        if (!_parcLogRecord_ParseConversion(p, &conversion)) {
+            return false;
+        }
+        p += conversion.length;
+
+        if (conversion.type == _PARCLogRecordType_Count) {
+            continue;
+        }
+
+        for (int i = 0; i < conversion.starCount; i++) {
+            if (argument >= record->argumentCount || record->types[argument++] != _PARCLogRecordType_Int) {
+                return false;
+            }
+        }
+        if (argument >= record->argumentCount || record->types[argument] != conversion.type) {
+            return false;
+        }
+        if (conversion.type == _PARCLogRecordType_String) {
+            int64_t offset = record->arguments[argument].integer;
+            if (offset != _PARCLogRecord_NullString && (offset < 0 || offset >= record->dataLength)) {
+                return false;
+            }
+        }
+        argument++;
+    }
+
+    return argument == record->argumentCount;
+}
+
+/*
+ * Rendered text is staged here and given to the PARCBufferComposer in large pieces.
+ */
+typedef struct {
+    PARCBufferComposer *composer;
+    size_t length;
+    char text[256];
+} _PARCLogRecordOutput;
+
+static void
+_parcLogRecordOutput_Flush(_PARCLogRecordOutput *output)
+{
+    parcBufferComposer_PutArray(output->composer, (const unsigned char *) output->text, output->length);
+    output->length = 0;
+}
+
+static void
+_parcLogRecordOutput_PutArray(_PARCLogRecordOutput *output, const char *array, size_t length)
+{
+    if (output->length + length > sizeof(output->text)) {
+        _parcLogRecordOutput_Flush(output);
+    }
+    if (length > sizeof(output->text)) {
+        parcBufferComposer_PutArray(output->composer, (const unsigned char *) array, length);
+    } else {
+        memcpy(&output->text[output->length], array, length);
+        output->length += length;
+    }
+}
+
+static void
+_parcLogRecordOutput_Format(_PARCLogRecordOutput *output, const char *specification, ...)
+{
+    va_list ap;
+    va_start(ap, specification);
+    size_t available = sizeof(output->text) - output->length;
+    int length = vsnprintf(&output->text[output->length], available, specification, ap);
+    va_end(ap);
+
+    if (length < (int) available) {
+        output->length += (size_t) length;
+        return;
+    }
+
+    _parcLogRecordOutput_Flush(output);
+    if (length < (int) sizeof(output->text)) {
+        va_start(ap, specification);
+        vsnprintf(output->text, sizeof(output->text), specification, ap);
+        va_end(ap);
+        output->length = (size_t) length;
+    } else {
+        char *longText = parcMemory_Allocate((size_t) length + 1);
+        assertNotNull(longText, "parcMemory_Allocate(%d) returned NULL", length + 1);
+        va_start(ap, specification);
+        vsnprintf(longText, (size_t) length + 1, specification, ap);
+        va_end(ap);
+
+        parcBufferComposer_PutArray(output->composer, (const unsigned char *) longText, (size_t) length);
+        parcMemory_Deallocate(&longText);
+    }
+}
+
+// Pass the value, preceded by any '*' field width and precision, to _parcLogRecordOutput_Format.
+#define _parcLogRecord_FormatValue(_output_, _specification_, _stars_, _starCount_, _value_) \
+    do { \
+        switch (_starCount_) { \
+            case 0: _parcLogRecordOutput_Format(_output_, _specification_, _value_); break; \
+            case 1: _parcLogRecordOutput_Format(_output_, _specification_, _stars_[0], _value_); break; \
+            default: _parcLogRecordOutput_Format(_output_, _specification_, _stars_[0], _stars_[1], _value_); break; \
+        } \
+    } while (0)
+
+PARCBufferComposer *
+parcLogRecord_Format(const PARCLogRecord *record, PARCBufferComposer *composer)
+{
+    _PARCLogRecordOutput output = { .composer = composer, .length = 0 };
+
+    unsigned argument = 0;
+    const char *literal = record->format;
+
+    for (const char *p = strchr(literal, '%'); p != NULL; p = strchr(p, '%')) {
+        _parcLogRecordOutput_PutArray(&output, literal, (size_t) (p - literal));
+
+        _PARCLogRecordConversion conversion;
+        bool parsed = _parcLogRecord_ParseConversion(p, &conversion);
+        assertTrue(parsed, "The format string of a PARCLogRecord cannot be parsed: %s", record->format);
+
+        if (conversion.type == _PARCLogRecordType_Count) {
+            _parcLogRecordOutput_PutArray(&output, "%", 1);
+            literal = p += conversion.length;
+            continue;
+        }
+
+        char specification[_PARCLogRecord_MaximumSpecification];
+        memcpy(specification, p, conversion.length);
+        specification[conversion.length] = 0;
+        literal = p += conversion.length;
+
+        int stars[2];
+        for (int i = 0; i < conversion.starCount; i++) {
+            stars[i] = (int) record->arguments[argument++].integer;
+        }
+
+        int64_t integer = record->arguments[argument].integer;
+        switch (conversion.type) {
+            case _PARCLogRecordType_Int:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, (int) integer);
+                break;
+            case _PARCLogRecordType_Long:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, (long) integer);
+                break;
+            case _PARCLogRecordType_LongLong:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, (long long) integer);
+                break;
+            case _PARCLogRecordType_IntMax:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, (intmax_t) integer);
+                break;
+            case _PARCLogRecordType_Size:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, (size_t) integer);
+                break;
+            case _PARCLogRecordType_PtrDiff:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, (ptrdiff_t) integer);
+                break;
+            case _PARCLogRecordType_Double:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, record->arguments[argument].real);
+                break;
+            case _PARCLogRecordType_String: {
+                const char *string = (integer == _PARCLogRecord_NullString) ? NULL : &record->data[integer];
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, string);
+                break;
+            }
+            case _PARCLogRecordType_Pointer:
+                _parcLogRecord_FormatValue(&output, specification, stars, conversion.starCount, record->arguments[argument].pointer);
+                break;
+            default:
+                trapIllegalValue(conversion.type, "Unexpected argument type %d", conversion.type);
+        }
+        argument++;
+    }
+    _parcLogRecordOutput_PutArray(&output, literal, strlen(literal));
+    _parcLogRecordOutput_Flush(&output);
+
+    return composer;
+}
+
+char *
+parcLogRecord_ToString(const PARCLogRecord *record)
+{
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcLogRecord_Format(record, composer);
+
+    char *result = parcBufferComposer_ToString(composer);
+    parcBufferComposer_Release(&composer);
+
+    return result;
+}
+
+/*
+ * The encoding is:
+ *   level (1) messageId (8) seconds (8) microseconds (4)
+ *   format length (2) format, including its nul terminator
+ *   argument count (1) types (1 each) values (8 each)
+ *   data length (1) data
+ * with all integers in network byte order.
+ */
+PARCBufferComposer *
+parcLogRecord_Encode(const PARCLogRecord *record, PARCBufferComposer *composer)
+{
+    size_t formatLength = strlen(record->format) + 1;
+    assertTrue(formatLength <= UINT16_MAX, "The format string is too long to encode: %zu", formatLength);
+
+    parcBufferComposer_PutUint8(composer, record->level);
+    parcBufferComposer_PutUint64(composer, record->messageId);
+    parcBufferComposer_PutUint64(composer, (uint64_t) record->timeStamp.tv_sec);
+    parcBufferComposer_PutUint32(composer, (uint32_t) record->timeStamp.tv_usec);
+
+    parcBufferComposer_PutUint16(composer, (uint16_t) formatLength);
+    parcBufferComposer_PutArray(composer, (const unsigned char *) record->format, formatLength);
+
+    parcBufferComposer_PutUint8(composer, record->argumentCount);
+    parcBufferComposer_PutArray(composer, record->types, record->argumentCount);
+    for (unsigned i = 0; i < record->argumentCount; i++) {
+        uint64_t value;
+        if (record->types[i] == _PARCLogRecordType_Pointer) {
+            value = (uint64_t) (uintptr_t) record->arguments[i].pointer;
+        } else {
+            memcpy(&value, &record->arguments[i], sizeof(value));
+        }
+        parcBufferComposer_PutUint64(composer, value);
+    }
+
+    parcBufferComposer_PutUint8(composer, record->dataLength);
+    parcBufferComposer_PutArray(composer, (const unsigned char *) record->data, record->dataLength);
+
+    return composer;
+}
+
+static bool
+_parcLogRecord_DecodeFields(PARCLogRecord *record, PARCBuffer *buffer)
+{
+    if (parcBuffer_Remaining(buffer) < 1 + 8 + 8 + 4 + 2) {
+        return false;
+    }
+    record->level = parcBuffer_GetUint8(buffer);
+    record->messageId = parcBuffer_GetUint64(buffer);
+    record->timeStamp.tv_sec = (time_t) parcBuffer_GetUint64(buffer);
+    record->timeStamp.tv_usec = (suseconds_t) parcBuffer_GetUint32(buffer);
+
+    size_t formatLength = parcBuffer_GetUint16(buffer);
+    if (formatLength == 0 || parcBuffer_Remaining(buffer) < formatLength + 1) {
+        return false;
+    }
+    record->format = parcBuffer_Overlay(buffer, formatLength);
+    if (record->format[formatLength - 1] != 0) {
+        return false;
+    }
+
+    record->argumentCount = parcBuffer_GetUint8(buffer);
+    if (record->argumentCount > PARCLogRecord_MaximumArguments
+        || parcBuffer_Remaining(buffer) < record->argumentCount * 9 + 1) {
+        return false;
+    }
+    parcBuffer_GetBytes(buffer, record->argumentCount, record->types);
+    for (unsigned i = 0; i < record->argumentCount; i++) {
+        uint64_t value = parcBuffer_GetUint64(buffer);
+        if (record->types[i] == _PARCLogRecordType_Pointer) {
+            record->arguments[i].pointer = (const void *) (uintptr_t) value;
+        } else {
+            memcpy(&record->arguments[i], &value, sizeof(value));
+        }
+    }
+
+    record->dataLength = parcBuffer_GetUint8(buffer);
+    if (record->dataLength > PARCLogRecord_DataCapacity || parcBuffer_Remaining(buffer) < record->dataLength) {
+        return false;
+    }
+    parcBuffer_GetBytes(buffer, record->dataLength, (uint8_t *) record->data);
+    if (record->dataLength > 0 && record->data[record->dataLength - 1] != 0) {
+        return false;
+    }
+
+    return _parcLogRecord_IsConsistent(record);
+}
+
+bool
+parcLogRecord_Decode(PARCLogRecord *record, PARCBuffer *buffer)
+{
+    size_t start = parcBuffer_Position(buffer);
+
+    bool result = _parcLogRecord_DecodeFields(record, buffer);
+    if (!result) {
+        parcBuffer_SetPosition(buffer, start);
+    }
+    return result;
+}
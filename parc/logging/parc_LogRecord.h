@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogRecord.h
+ * @brief A compact, fixed-size capture of a log message whose formatting is deferred.
+ *
+ * A `PARCLogRecord` holds the pointer to a printf-style format string and the raw values of its arguments,
+ * instead of the formatted text.
+ * Capturing a record costs a scan of the format string and a copy of any string arguments,
+ * and the text is only produced when the record is rendered,
+ * typically by a `PARCLogReporter` or offline by a decoder reading a binary log.
+ *
+ * Because only the pointer to the format string is kept,
+ * the format string must outlive the record (a string literal is the usual case).
+ *
+ * Formats that cannot be captured (the `%n` and `L` conversions,
+ * more than `PARCLogRecord_MaximumArguments` arguments,
+ * or string arguments that together exceed `PARCLogRecord_DataCapacity` bytes)
+ * are rejected by `parcLogRecord_Capture` so that the caller can format the message eagerly instead.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogRecord_h
+#define PARC_Library_parc_LogRecord_h
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/time.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_BufferComposer.h>
+#include <parc/logging/parc_LogLevel.h>
+
+/**
+ * The maximum number of arguments, including `*` field widths and precisions, a record can capture.
+ */
+#define PARCLogRecord_MaximumArguments 12
+
+/**
+ * The number of bytes available in a record for copies of string arguments.
+ */
+#define PARCLogRecord_DataCapacity 192
+
+/**
+ * A captured log message.
+ *
+ * The fields are exposed so that records can be embedded in other structures without allocation;
+ * they are otherwise private to the implementation.
+ */
+typedef struct parc_log_record {
+    const char *format;
+    struct timeval timeStamp;
+    uint64_t messageId;
+    PARCLogLevel level;
+    uint8_t argumentCount;
+    uint8_t dataLength;
+    uint8_t types[PARCLogRecord_MaximumArguments];
+    union {
+        int64_t integer;
+        double real;
+        const void *pointer;
+    } arguments[PARCLogRecord_MaximumArguments];
+    char data[PARCLogRecord_DataCapacity];
+} PARCLogRecord;
+
+/**
+ * Capture the given log message into a `PARCLogRecord` without formatting it.
+ *
+ * The record's time stamp is set to the current time.
+ * Arguments are consumed from @p ap as the format string directs.
+ * If the format cannot be captured the record is invalid, @p ap is left in an unspecified state,
+ * and the caller should format the message from a copy of the original `va_list` instead.
+ *
+ * @param [out] record A pointer to the `PARCLogRecord` to fill in.
+ * @param [in] level The log level of the message.
+ * @param [in] messageId The message identifier.
+ * @param [in] format A printf-style format string that outlives the record.
+ * @param [in] ap The arguments for @p format.
+ *
+ * @return true The message was captured.
+ * @return false The message cannot be captured.
+ *
+ * Example:
+ * @code
+ * {
+ *     va_list copy;
+ *     va_copy(copy, ap);
+ *
+ *     PARCLogRecord record;
+ *     if (parcLogRecord_Capture(&record, PARCLogLevel_Info, 0, format, ap)) {
+ *         ...
+ *     } else {
+ *         vasprintf(&text, format, copy);
+ *     }
+ *     va_end(copy);
+ * }
+ * @endcode
+ */
+bool parcLogRecord_Capture(PARCLogRecord *record, PARCLogLevel level, uint64_t messageId, const char *format, va_list ap);
+
+/**
+ * Append the text of the captured message to the given `PARCBufferComposer`.
+ *
+ * The text is identical to what `vsprintf` would have produced from the original arguments,
+ * except that string arguments are the values they had when the record was captured.
+ *
+ * @param [in] record A pointer to a valid `PARCLogRecord`.
+ * @param [in,out] composer A pointer to a valid `PARCBufferComposer`.
+ *
+ * @return The given composer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_Create();
+ *     parcLogRecord_Format(&record, composer);
+ * }
+ * @endcode
+ */
+PARCBufferComposer *parcLogRecord_Format(const PARCLogRecord *record, PARCBufferComposer *composer);
+
+/**
+ * Produce a nul-terminated C string containing the text of the captured message.
+ *
+ * The result must be freed by the caller via {@link parcMemory_Deallocate}.
+ *
+ * @param [in] record A pointer to a valid `PARCLogRecord`.
+ *
+ * @return A pointer to an allocated C string that must be deallocated via {@link parcMemory_Deallocate}.
+ *
+ * Example:
+ * @code
+ * {
+ *     char *text = parcLogRecord_ToString(&record);
+ *     printf("%s\n", text);
+ *     parcMemory_Deallocate(&text);
+ * }
+ * @endcode
+ */
+char *parcLogRecord_ToString(const PARCLogRecord *record);
+
+/**
+ * Append the binary encoding of a `PARCLogRecord` to the given `PARCBufferComposer`.
+ *
+ * The encoding carries the text of the format string, rather than its pointer,
+ * so that it can be decoded by another process.
+ *
+ * @param [in] record A pointer to a valid `PARCLogRecord`.
+ * @param [in,out] composer A pointer to a valid `PARCBufferComposer`.
+ *
+ * @return The given composer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferComposer *composer = parcBufferComposer_Create();
+ *     parcLogRecord_Encode(&record, composer);
+ * }
+ * @endcode
+ *
+ * @see parcLogRecord_Decode
+ */
+PARCBufferComposer *parcLogRecord_Encode(const PARCLogRecord *record, PARCBufferComposer *composer);
+
+/**
+ * Decode a `PARCLogRecord` encoded by `parcLogRecord_Encode` from the current position of the given `PARCBuffer`.
+ *
+ * On success the position of @p buffer is advanced past the encoding.
+ * The decoded record's format string points into the memory of @p buffer,
+ * which must therefore outlive the record.
+ *
+ * @param [out] record A pointer to the `PARCLogRecord` to fill in.
+ * @param [in,out] buffer A pointer to a valid `PARCBuffer`.
+ *
+ * @return true A record was decoded.
+ * @return false The buffer does not contain a valid encoding.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogRecord record;
+ *     while (parcLogRecord_Decode(&record, buffer)) {
+ *         ...
+ *     }
+ * }
+ * @endcode
+ *
+ * @see parcLogRecord_Encode
+ */
+bool parcLogRecord_Decode(PARCLogRecord *record, PARCBuffer *buffer);
+#endif // PARC_Library_parc_LogRecord_h
@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/concurrent/parc_Thread.h>
+
+#include <parc/logging/parc_LogReporterAsync.h>
+
+// How long the background thread sleeps when every ring is empty, unless a logging thread wakes it.
+#define _parcLogReporterAsync_IdleNanoseconds (10 * 1000 * 1000)
+
+/*
+ * The fixed-size record a logging thread puts into its ring.
+ */
+typedef struct {
+    PARCLogEntry *entry;
+} _PARCLogReporterAsyncRecord;
+
+/*
+ * A single-producer, single-consumer ring of records, in the manner of PARCRingBuffer1x1.
+ * The indexes count up without bound and are masked to find a slot.
+ * Only the logging thread writes `head`, and only the background thread writes `tail`,
+ * which it advances after the record has been reported so that a flush can wait for it.
+ */
+typedef struct parc_log_reporter_async_ring {
+    struct parc_log_reporter_async_ring *next;
+    uint32_t mask;
+    volatile uint32_t head;
+    volatile uint32_t tail;
+
+    // Set when the logging thread exits, so the background thread frees the ring once it is empty.
+    volatile bool isOrphaned;
+
+    _PARCLogReporterAsyncRecord records[];
+} _PARCLogReporterAsyncRing;
+
+/*
+ * The state shared by the logging threads and the background thread.
+ */
+typedef struct {
+    PARCLogReporter *reporter;
+    PARCLogReporterAsyncPolicy policy;
+    uint32_t ringCapacity;
+
+    pthread_key_t ringKey;
+
+    // New rings are published at the head of the list, so the background thread reads the list without a lock.
+    // The lock is held to add a ring, to free the rings of exited threads, and to count the flushes in progress,
+    // which keep the rings they wait on from being freed.
+    pthread_mutex_t ringsLock;
+    _PARCLogReporterAsyncRing *volatile rings;
+    unsigned flushCount;
+
+    // Serialises the wrapped reporter between the background thread and logging threads applying back pressure.
+    pthread_mutex_t reporterLock;
+
+    volatile bool isIdle;
+    uint64_t droppedCount;
+    uint64_t reportedCount;
+} _PARCLogReporterAsyncQueue;
+
+/*
+ * How far a ring had been written when a flush began.
+ */
+typedef struct {
+    _PARCLogReporterAsyncRing *ring;
+    uint32_t head;
+} _PARCLogReporterAsyncFlushMark;
+
+/*
+ * The private object of the PARCLogReporter.
+ * The background thread holds a reference to the queue but not to this,
+ * so releasing the last reference to the reporter stops the thread.
+ */
+typedef struct {
+    _PARCLogReporterAsyncQueue *queue;
+    PARCThread *thread;
+} _PARCLogReporterAsync;
+
+static void
+_parcLogReporterAsyncRing_Orphan(void *ring)
+{
+    ((_PARCLogReporterAsyncRing *) ring)->isOrphaned = true;
+}
+
+static bool
+_parcLogReporterAsyncRing_Put(_PARCLogReporterAsyncRing *ring, const PARCLogEntry *entry)
+{
+    uint32_t head = ring->head;
+    if (head - ring->tail > ring->mask) {
+        return false;
+    }
+
+    ring->records[head & ring->mask].entry = parcLogEntry_Acquire(entry);
+    __sync_synchronize();
+    ring->head = head + 1;
+
+    return true;
+}
+
+static bool
+_parcLogReporterAsyncQueue_Destructor(_PARCLogReporterAsyncQueue **queuePtr)
+{
+    _PARCLogReporterAsyncQueue *queue = *queuePtr;
+
+    // The background thread has reported every record before it released the queue.
+    pthread_key_delete(queue->ringKey);
+    while (queue->rings != NULL) {
+        _PARCLogReporterAsyncRing *ring = queue->rings;
+        queue->rings = ring->next;
+        parcMemory_Deallocate((void **) &ring);
+    }
+
+    pthread_mutex_destroy(&queue->ringsLock);
+    pthread_mutex_destroy(&queue->reporterLock);
+    parcLogReporter_Release(&queue->reporter);
+
+    return true;
+}
+
+parcObject_Override(_PARCLogReporterAsyncQueue, PARCObject,
+                    .isLockable = true,
+                    .destructor = (PARCObjectDestructor *) _parcLogReporterAsyncQueue_Destructor);
+
+static parcObject_ImplementRelease(_parcLogReporterAsyncQueue, _PARCLogReporterAsyncQueue);
+
+static _PARCLogReporterAsyncRing *
+_parcLogReporterAsyncQueue_GetRing(_PARCLogReporterAsyncQueue *queue)
+{
+    _PARCLogReporterAsyncRing *result = pthread_getspecific(queue->ringKey);
+
+    if (result == NULL) {
+        size_t size = sizeof(_PARCLogReporterAsyncRing) + queue->ringCapacity * sizeof(_PARCLogReporterAsyncRecord);
+        result = parcMemory_AllocateAndClear(size);
+        assertNotNull(result, "parcMemory_AllocateAndClear(%zu) returned NULL", size);
+        result->mask = queue->ringCapacity - 1;
+
+        pthread_mutex_lock(&queue->ringsLock);
+        result->next = queue->rings;
+        __sync_synchronize();
+        queue->rings = result;
+        pthread_mutex_unlock(&queue->ringsLock);
+
+        pthread_setspecific(queue->ringKey, result);
+    }
+
+    return result;
+}
+
+static void
+_parcLogReporterAsyncQueue_Wake(_PARCLogReporterAsyncQueue *queue)
+{
+    if (queue->isIdle) {
+        parcObject_Lock(queue);
+        parcObject_Notify(queue);
+        parcObject_Unlock(queue);
+    }
+}
+
+static void
+_parcLogReporterAsyncQueue_ReportEntry(_PARCLogReporterAsyncQueue *queue, const PARCLogEntry *entry)
+{
+    pthread_mutex_lock(&queue->reporterLock);
+    parcLogReporter_Report(queue->reporter, entry);
+    pthread_mutex_unlock(&queue->reporterLock);
+    __sync_add_and_fetch(&queue->reportedCount, 1);
+}
+
+/*
+ * Report every record in the given ring, in order.
+ */
+static size_t
+_parcLogReporterAsyncQueue_DrainRing(_PARCLogReporterAsyncQueue *queue, _PARCLogReporterAsyncRing *ring)
+{
+    uint32_t tail = ring->tail;
+    uint32_t head = ring->head;
+    __sync_synchronize();
+
+    size_t result = head - tail;
+    if (result > 0) {
+        pthread_mutex_lock(&queue->reporterLock);
+        for (; tail != head; tail++) {
+            _PARCLogReporterAsyncRecord *record = &ring->records[tail & ring->mask];
+            parcLogReporter_Report(queue->reporter, record->entry);
+            parcLogEntry_Release(&record->entry);
+            __sync_synchronize();
+            ring->tail = tail + 1;
+        }
+        pthread_mutex_unlock(&queue->reporterLock);
+        __sync_add_and_fetch(&queue->reportedCount, result);
+    }
+
+    return result;
+}
+
+/*
+ * Report the records in every ring, and free the rings of threads that have exited.
+ * Return the number of records reported.
+ */
+static size_t
+_parcLogReporterAsyncQueue_Drain(_PARCLogReporterAsyncQueue *queue)
+{
+    size_t result = 0;
+
+    _PARCLogReporterAsyncRing *ring = queue->rings;
+    __sync_synchronize();
+
+    bool hasOrphans = false;
+    for (; ring != NULL; ring = ring->next) {
+        result += _parcLogReporterAsyncQueue_DrainRing(queue, ring);
+        hasOrphans |= ring->isOrphaned;
+    }
+
+    // Leave the rings of exited threads for the next pass if a flush may be waiting on them.
+    if (hasOrphans && pthread_mutex_trylock(&queue->ringsLock) == 0) {
+        _PARCLogReporterAsyncRing **previous = (_PARCLogReporterAsyncRing **) &queue->rings;
+        while (queue->flushCount == 0 && *previous != NULL) {
+            _PARCLogReporterAsyncRing *candidate = *previous;
+            if (candidate->isOrphaned && candidate->head == candidate->tail) {
+                *previous = candidate->next;
+                parcMemory_Deallocate((void **) &candidate);
+            } else {
+                previous = &candidate->next;
+            }
+        }
+        pthread_mutex_unlock(&queue->ringsLock);
+    }
+
+    return result;
+}
+
+static void *
+_parcLogReporterAsyncQueue_Run(PARCThread *thread, PARCObject *parameter)
+{
+    _PARCLogReporterAsyncQueue *queue = parameter;
+
+    while (parcThread_IsCancelled(thread) == false) {
+        size_t reported = _parcLogReporterAsyncQueue_Drain(queue);
+        if (reported > 0 && __atomic_load_n(&queue->flushCount, __ATOMIC_RELAXED) > 0) {
+            parcObject_Lock(queue);
+            parcObject_NotifyAll(queue);
+            parcObject_Unlock(queue);
+        } else if (reported == 0) {
+            parcObject_Lock(queue);
+            queue->isIdle = true;
+            __sync_synchronize();
+            if (parcThread_IsCancelled(thread) == false) {
+                parcObject_WaitFor(queue, _parcLogReporterAsync_IdleNanoseconds);
+            }
+            queue->isIdle = false;
+            parcObject_Unlock(queue);
+        }
+    }
+
+    // Report whatever was logged before the reporter was released.
+    _parcLogReporterAsyncQueue_Drain(queue);
+
+    return NULL;
+}
+
+static bool
+_parcLogReporterAsync_Destructor(_PARCLogReporterAsync **asyncPtr)
+{
+    _PARCLogReporterAsync *async = *asyncPtr;
+
+    parcThread_Cancel(async->thread);
+    parcObject_Lock(async->queue);
+    parcObject_Notify(async->queue);
+    parcObject_Unlock(async->queue);
+    parcThread_Join(async->thread);
+    parcThread_Release(&async->thread);
+
+    _parcLogReporterAsyncQueue_Release(&async->queue);
+
+    return true;
+}
+
+parcObject_Override(_PARCLogReporterAsync, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcLogReporterAsync_Destructor);
+
+PARCLogReporter *
+parcLogReporterAsync_Create(PARCLogReporter *reporter, PARCLogReporterAsyncPolicy policy, size_t ringCapacity)
+{
+    assertNotNull(reporter, "Parameter reporter must be non-null");
+    assertTrue(ringCapacity > 0 && ringCapacity <= (1U << 31), "Parameter ringCapacity must be between 1 and 2^31");
+
+    _PARCLogReporterAsyncQueue *queue = parcObject_CreateAndClearInstance(_PARCLogReporterAsyncQueue);
+    if (queue == NULL) {
+        return NULL;
+    }
+    queue->reporter = parcLogReporter_Acquire(reporter);
+    queue->policy = policy;
+    queue->ringCapacity = 1;
+    while (queue->ringCapacity < ringCapacity) {
+        queue->ringCapacity <<= 1;
+    }
+    pthread_key_create(&queue->ringKey, _parcLogReporterAsyncRing_Orphan);
+    pthread_mutex_init(&queue->ringsLock, NULL);
+    pthread_mutex_init(&queue->reporterLock, NULL);
+
+    _PARCLogReporterAsync *async = parcObject_CreateInstance(_PARCLogReporterAsync);
+    async->queue = queue;
+    async->thread = parcThread_Create(_parcLogReporterAsyncQueue_Run, (PARCObject *) queue);
+    parcThread_Start(async->thread);
+
+    PARCLogReporter *result = parcLogReporter_Create(parcLogReporterAsync_Acquire,
+                                                     parcLogReporterAsync_Release,
+                                                     parcLogReporterAsync_Report,
+                                                     async);
+    return result;
+}
+
+PARCLogReporter *
+parcLogReporterAsync_Acquire(const PARCLogReporter *reporter)
+{
+    return parcObject_Acquire(reporter);
+}
+
+void
+parcLogReporterAsync_Release(PARCLogReporter **reporterP)
+{
+    parcObject_Release((void **) reporterP);
+}
+
+void
+parcLogReporterAsync_Report(PARCLogReporter *reporter, const PARCLogEntry *entry)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    _PARCLogReporterAsyncQueue *queue = async->queue;
+
+    _PARCLogReporterAsyncRing *ring = _parcLogReporterAsyncQueue_GetRing(queue);
+
+    if (_parcLogReporterAsyncRing_Put(ring, entry) == false) {
+        switch (queue->policy) {
+            case PARCLogReporterAsyncPolicy_Drop:
+                __sync_add_and_fetch(&queue->droppedCount, 1);
+                return;
+
+            case PARCLogReporterAsyncPolicy_Block:
+                do {
+                    _parcLogReporterAsyncQueue_Wake(queue);
+                    sched_yield();
+                } while (_parcLogReporterAsyncRing_Put(ring, entry) == false);
+                break;
+
+            case PARCLogReporterAsyncPolicy_Backpressure:
+                _parcLogReporterAsyncQueue_ReportEntry(queue, entry);
+                break;
+
+            default:
+                trapIllegalValue(queue->policy, "Unknown PARCLogReporterAsyncPolicy: %d", queue->policy);
+        }
+    }
+
+    __sync_synchronize();
+    _parcLogReporterAsyncQueue_Wake(queue);
+}
+
+void
+parcLogReporterAsync_Flush(PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    _PARCLogReporterAsyncQueue *queue = async->queue;
+
+    // Note how far each ring has been written, and keep the rings from being freed until the wait is over.
+    pthread_mutex_lock(&queue->ringsLock);
+    size_t count = 0;
+    for (_PARCLogReporterAsyncRing *ring = queue->rings; ring != NULL; ring = ring->next) {
+        count++;
+    }
+    _PARCLogReporterAsyncFlushMark *marks = NULL;
+    if (count > 0) {
+        marks = parcMemory_Allocate(count * sizeof(_PARCLogReporterAsyncFlushMark));
+        assertNotNull(marks, "parcMemory_Allocate(%zu) returned NULL", count * sizeof(_PARCLogReporterAsyncFlushMark));
+        size_t i = 0;
+        for (_PARCLogReporterAsyncRing *ring = queue->rings; ring != NULL; ring = ring->next) {
+            marks[i].ring = ring;
+            marks[i].head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+            i++;
+        }
+        __atomic_add_fetch(&queue->flushCount, 1, __ATOMIC_RELAXED);
+    }
+    pthread_mutex_unlock(&queue->ringsLock);
+
+    if (count > 0) {
+        // The background thread notifies the queue after each pass that reported records while a flush is in progress.
+        parcObject_Lock(queue);
+        for (size_t i = 0; i < count; i++) {
+            while ((int32_t) (__atomic_load_n(&marks[i].ring->tail, __ATOMIC_ACQUIRE) - marks[i].head) < 0) {
+                parcObject_NotifyAll(queue);
+                parcObject_WaitFor(queue, _parcLogReporterAsync_IdleNanoseconds);
+            }
+        }
+        parcObject_Unlock(queue);
+
+        pthread_mutex_lock(&queue->ringsLock);
+        __atomic_sub_fetch(&queue->flushCount, 1, __ATOMIC_RELAXED);
+        pthread_mutex_unlock(&queue->ringsLock);
+
+        parcMemory_Deallocate((void **) &marks);
+    }
+}
+
+uint64_t
+parcLogReporterAsync_GetDroppedCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    return __sync_add_and_fetch(&async->queue->droppedCount, 0);
+}
+
+uint64_t
+parcLogReporterAsync_GetReportedCount(const PARCLogReporter *reporter)
+{
+    _PARCLogReporterAsync *async = parcLogReporter_GetPrivateObject(reporter);
+    return __sync_add_and_fetch(&async->queue->reportedCount, 0);
+}
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogReporterAsync.h
+ * @brief A PARCLogReporter that hands entries to a background thread.
+ *
+ * An asynchronous reporter wraps another `PARCLogReporter`.
+ * The thread that logs an entry only puts a reference to the entry into a ring of fixed-size records;
+ * a background thread takes the records from the rings and reports them to the wrapped reporter,
+ * which formats and writes them.
+ * The logging thread therefore never waits for formatting or I/O.
+ *
+ * Each logging thread has its own ring, created the first time it reports to the reporter,
+ * so logging threads do not contend with each other, and a ring needs no lock:
+ * it has a single producer, the logging thread, and a single consumer, the background thread.
+ * Entries logged by one thread are reported in the order they were logged.
+ *
+ * What happens when a thread's ring is full is set by the `PARCLogReporterAsyncPolicy` given when the reporter is created.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogReporterAsync_h
+#define PARC_Library_parc_LogReporterAsync_h
+
+#include <parc/logging/parc_LogReporter.h>
+
+/**
+ * @typedef PARCLogReporterAsyncPolicy
+ * @brief What a logging thread does when its ring is full.
+ */
+typedef enum {
+    /** The entry is discarded and counted by `parcLogReporterAsync_GetDroppedCount`. */
+    PARCLogReporterAsyncPolicy_Drop,
+
+    /** The logging thread waits until the background thread has made room in the ring. */
+    PARCLogReporterAsyncPolicy_Block,
+
+    /**
+     * The logging thread reports the entry to the wrapped reporter itself,
+     * so it is slowed to the speed of the wrapped reporter and no entry is lost.
+     * An entry reported this way may be written before entries the same thread logged earlier that are still in its ring.
+     */
+    PARCLogReporterAsyncPolicy_Backpressure
+} PARCLogReporterAsyncPolicy;
+
+/**
+ * Create a new `PARCLogReporter` that reports entries to the given `PARCLogReporter` from a background thread.
+ *
+ * The background thread runs until the last reference to the new reporter is released,
+ * and reports every entry still in a ring before it stops.
+ *
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` instance, which is used only by one thread at a time.
+ * @param [in] policy What a logging thread does when its ring is full.
+ * @param [in] ringCapacity The number of entries each logging thread's ring holds. It is rounded up to a power of 2.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL A pointer to a valid `PARCLogReporter` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *stdoutReporter = parcLogReporterTextStdout_Create();
+ *     PARCLogReporter *reporter = parcLogReporterAsync_Create(stdoutReporter, PARCLogReporterAsyncPolicy_Drop, 1024);
+ *     parcLogReporter_Release(&stdoutReporter);
+ *
+ *     PARCLog *log = parcLog_Create("localhost", "myApp", "daemon", reporter);
+ *     parcLogReporter_Release(&reporter);
+ *
+ *     parcLog_Warning(log, "This is a warning message.");
+ *
+ *     parcLog_Release(&log);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterAsync_Create(PARCLogReporter *reporter, PARCLogReporterAsyncPolicy policy, size_t ringCapacity);
+
+/**
+ * Increase the number of references to a `PARCLogReporter` instance.
+ *
+ * Note that new `PARCLogReporter` is not created,
+ * only that the given `PARCLogReporter` reference count is incremented.
+ * Discard the reference by invoking `parcLogReporterAsync_Release`.
+ *
+ * @param [in] instance A pointer to a `PARCLogReporter` instance.
+ *
+ * @return The input `PARCLogReporter` pointer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *x = parcLogReporterAsync_Create(...);
+ *
+ *     PARCLogReporter *x_2 = parcLogReporterAsync_Acquire(x);
+ *
+ *     parcLogReporterAsync_Release(&x);
+ *     parcLogReporterAsync_Release(&x_2);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterAsync_Acquire(const PARCLogReporter *instance);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the background thread reports the entries remaining in the rings and stops,
+ * and the wrapped reporter is released.
+ *
+ * @param [in,out] reporterP A pointer to a PARCLogReporter instance pointer, which will be set to zero on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *x = parcLogReporterAsync_Create(...);
+ *
+ *     parcLogReporterAsync_Release(&x);
+ * }
+ * @endcode
+ */
+void parcLogReporterAsync_Release(PARCLogReporter **reporterP);
+
+/**
+ * Queue the given PARCLogEntry to be reported by the background thread.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ * @param [in] entry A pointer to a valid PARCLogEntry instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLogReporter_Report(reporter, entry);
+ * }
+ * @endcode
+ */
+void parcLogReporterAsync_Report(PARCLogReporter *reporter, const PARCLogEntry *entry);
+
+/**
+ * Wait until the background thread has reported every entry queued before this call.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcLog_Critical(log, "Shutting down.");
+ *     parcLogReporterAsync_Flush(reporter);
+ * }
+ * @endcode
+ */
+void parcLogReporterAsync_Flush(PARCLogReporter *reporter);
+
+/**
+ * Return the number of entries discarded because a logging thread's ring was full.
+ *
+ * Only the `PARCLogReporterAsyncPolicy_Drop` policy discards entries.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * @return The number of entries discarded since the reporter was created.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t dropped = parcLogReporterAsync_GetDroppedCount(reporter);
+ * }
+ * @endcode
+ */
+uint64_t parcLogReporterAsync_GetDroppedCount(const PARCLogReporter *reporter);
+
+/**
+ * Return the number of entries reported to the wrapped reporter.
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance created by `parcLogReporterAsync_Create`.
+ *
+ * @return The number of entries reported since the reporter was created.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t reported = parcLogReporterAsync_GetReportedCount(reporter);
+ * }
+ * @endcode
+ */
+uint64_t parcLogReporterAsync_GetReportedCount(const PARCLogReporter *reporter);
+#endif // PARC_Library_parc_LogReporterAsync_h
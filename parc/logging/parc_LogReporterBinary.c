@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <string.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_BufferComposer.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Object.h>
+
+#include <parc/logging/parc_LogReporterBinary.h>
+#include <parc/logging/parc_LogRecord.h>
+
+/*
+ * A binary log is a sequence of frames, each a kind (1 byte) and the length of the body (4 bytes) followed by the body.
+ * Integers are in network byte order.
+ */
+typedef enum {
+    // The host name, application name and process identifier of the entries that follow,
+    // each as a length (2 bytes) and the nul-terminated string.
+    _PARCLogReporterBinaryFrame_Header = 'H',
+
+    // An entry with deferred formatting, as encoded by parcLogRecord_Encode.
+    _PARCLogReporterBinaryFrame_Record = 'R',
+
+    // An entry with a formatted payload: level (1) messageId (8) seconds (8) microseconds (4) and the payload.
+    _PARCLogReporterBinaryFrame_Text = 'T'
+} _PARCLogReporterBinaryFrame;
+
+#define _PARCLogReporterBinaryFrame_Overhead 5
+
+static const char *_nilvalue = "-";
+
+typedef struct {
+    PARCOutputStream *output;
+    PARCBufferComposer *composer;
+
+    // The header fields most recently written.
+    char *hostName;
+    char *applicationName;
+    char *processName;
+} _PARCLogReporterBinary;
+
+static bool
+_parcLogReporterBinary_Destructor(_PARCLogReporterBinary **binaryPtr)
+{
+    _PARCLogReporterBinary *binary = *binaryPtr;
+
+    parcOutputStream_Release(&binary->output);
+    parcBufferComposer_Release(&binary->composer);
+    if (binary->hostName != NULL) {
+        parcMemory_Deallocate(&binary->hostName);
+        parcMemory_Deallocate(&binary->applicationName);
+        parcMemory_Deallocate(&binary->processName);
+    }
+
+    return true;
+}
+
+parcObject_Override(_PARCLogReporterBinary, PARCObject,
+                    .isLockable = true,
+                    .destructor = (PARCObjectDestructor *) _parcLogReporterBinary_Destructor);
+
+PARCLogReporter *
+parcLogReporterBinary_Create(PARCOutputStream *output)
+{
+    _PARCLogReporterBinary *binary = parcObject_CreateAndClearInstance(_PARCLogReporterBinary);
+    if (binary == NULL) {
+        return NULL;
+    }
+    binary->output = parcOutputStream_Acquire(output);
+    binary->composer = parcBufferComposer_Allocate(512);
+
+    PARCLogReporter *result = parcLogReporter_Create(&parcLogReporterBinary_Acquire,
+                                                     parcLogReporterBinary_Release,
+                                                     parcLogReporterBinary_Report,
+                                                     binary);
+    return result;
+}
+
+PARCLogReporter *
+parcLogReporterBinary_Acquire(const PARCLogReporter *reporter)
+{
+    return parcObject_Acquire(reporter);
+}
+
+void
+parcLogReporterBinary_Release(PARCLogReporter **reporterP)
+{
+    parcObject_Release((void **) reporterP);
+}
+
+static void
+_parcLogReporterBinary_PutString(PARCBufferComposer *composer, const char *string)
+{
+    size_t length = strlen(string) + 1;
+    parcBufferComposer_PutUint16(composer, (uint16_t) length);
+    parcBufferComposer_PutArray(composer, (const unsigned char *) string, length);
+}
+
+static size_t
+_parcLogReporterBinary_BeginFrame(PARCBufferComposer *composer, _PARCLogReporterBinaryFrame kind)
+{
+    size_t result = parcBuffer_Position(parcBufferComposer_GetBuffer(composer));
+    parcBufferComposer_PutUint8(composer, (uint8_t) kind);
+    parcBufferComposer_PutUint32(composer, 0);
+    return result;
+}
+
+static void
+_parcLogReporterBinary_EndFrame(PARCBufferComposer *composer, size_t start)
+{
+    PARCBuffer *buffer = parcBufferComposer_GetBuffer(composer);
+    size_t end = parcBuffer_Position(buffer);
+
+    parcBuffer_SetPosition(buffer, start + 1);
+    parcBuffer_PutUint32(buffer, (uint32_t) (end - start - _PARCLogReporterBinaryFrame_Overhead));
+    parcBuffer_SetPosition(buffer, end);
+}
+
+static bool
+_parcLogReporterBinary_HeaderChanged(const _PARCLogReporterBinary *binary, const PARCLogEntry *entry)
+{
+    return binary->hostName == NULL
+           || strcmp(binary->hostName, parcLogEntry_GetHostName(entry)) != 0
+           || strcmp(binary->applicationName, parcLogEntry_GetApplicationName(entry)) != 0
+           || strcmp(binary->processName, parcLogEntry_GetProcessName(entry)) != 0;
+}
+
+static void
+_parcLogReporterBinary_PutHeader(_PARCLogReporterBinary *binary, const PARCLogEntry *entry)
+{
+    if (binary->hostName != NULL) {
+        parcMemory_Deallocate(&binary->hostName);
+        parcMemory_Deallocate(&binary->applicationName);
+        parcMemory_Deallocate(&binary->processName);
+    }
+    const char *hostName = parcLogEntry_GetHostName(entry);
+    const char *applicationName = parcLogEntry_GetApplicationName(entry);
+    const char *processName = parcLogEntry_GetProcessName(entry);
+    binary->hostName = parcMemory_StringDuplicate(hostName, strlen(hostName));
+    binary->applicationName = parcMemory_StringDuplicate(applicationName, strlen(applicationName));
+    binary->processName = parcMemory_StringDuplicate(processName, strlen(processName));
+
+    size_t frame = _parcLogReporterBinary_BeginFrame(binary->composer, _PARCLogReporterBinaryFrame_Header);
+    _parcLogReporterBinary_PutString(binary->composer, hostName);
+    _parcLogReporterBinary_PutString(binary->composer, applicationName);
+    _parcLogReporterBinary_PutString(binary->composer, processName);
+    _parcLogReporterBinary_EndFrame(binary->composer, frame);
+}
+
+static void
+_parcLogReporterBinary_PutEntry(_PARCLogReporterBinary *binary, const PARCLogEntry *entry)
+{
+    const PARCLogRecord *record = parcLogEntry_GetRecord(entry);
+
+    if (record != NULL) {
+        size_t frame = _parcLogReporterBinary_BeginFrame(binary->composer, _PARCLogReporterBinaryFrame_Record);
+        parcLogRecord_Encode(record, binary->composer);
+        _parcLogReporterBinary_EndFrame(binary->composer, frame);
+    } else {
+        const struct timeval *timeStamp = parcLogEntry_GetTimeStamp(entry);
+
+        size_t frame = _parcLogReporterBinary_BeginFrame(binary->composer, _PARCLogReporterBinaryFrame_Text);
+        parcBufferComposer_PutUint8(binary->composer, parcLogEntry_GetLevel(entry));
+        parcBufferComposer_PutUint64(binary->composer, parcLogEntry_GetMessageId(entry));
+        parcBufferComposer_PutUint64(binary->composer, (uint64_t) timeStamp->tv_sec);
+        parcBufferComposer_PutUint32(binary->composer, (uint32_t) timeStamp->tv_usec);
+
+        PARCBuffer *payload = parcLogEntry_GetPayload(entry);
+        size_t position = parcBuffer_Position(payload);
+        parcBufferComposer_PutBuffer(binary->composer, payload);
+        parcBuffer_SetPosition(payload, position);
+        _parcLogReporterBinary_EndFrame(binary->composer, frame);
+    }
+}
+
+void
+parcLogReporterBinary_Report(PARCLogReporter *reporter, const PARCLogEntry *entry)
+{
+    _PARCLogReporterBinary *binary = parcLogReporter_GetPrivateObject(reporter);
+
+    parcObject_Lock(binary);
+
+    if (_parcLogReporterBinary_HeaderChanged(binary, entry)) {
+        _parcLogReporterBinary_PutHeader(binary, entry);
+    }
+    _parcLogReporterBinary_PutEntry(binary, entry);
+
+    PARCBuffer *buffer = parcBuffer_Flip(parcBufferComposer_GetBuffer(binary->composer));
+    parcOutputStream_Write(binary->output, buffer);
+    parcBuffer_Clear(buffer);
+
+    parcObject_Unlock(binary);
+}
+
+static const char *
+_parcLogReporterBinary_GetString(PARCBuffer *input)
+{
+    if (parcBuffer_Remaining(input) < 2) {
+        return NULL;
+    }
+    size_t length = parcBuffer_GetUint16(input);
+    if (length == 0 || parcBuffer_Remaining(input) < length) {
+        return NULL;
+    }
+    const char *result = parcBuffer_Overlay(input, length);
+    return (result[length - 1] == 0) ? result : NULL;
+}
+
+static PARCLogEntry *
+_parcLogReporterBinary_GetTextEntry(PARCBuffer *input, size_t length, const char *header[3])
+{
+    if (length < 1 + 8 + 8 + 4) {
+        return NULL;
+    }
+    PARCLogLevel level = parcBuffer_GetUint8(input);
+    uint64_t messageId = parcBuffer_GetUint64(input);
+    struct timeval timeStamp;
+    timeStamp.tv_sec = (time_t) parcBuffer_GetUint64(input);
+    timeStamp.tv_usec = (suseconds_t) parcBuffer_GetUint32(input);
+
+    size_t payloadLength = length - (1 + 8 + 8 + 4);
+    PARCBuffer *payload = parcBuffer_Allocate(payloadLength);
+    parcBuffer_PutArray(payload, payloadLength, parcBuffer_Overlay(input, payloadLength));
+    parcBuffer_Flip(payload);
+
+    PARCLogEntry *result = parcLogEntry_Create(level, header[0], header[1], header[2], messageId, timeStamp, payload);
+    parcBuffer_Release(&payload);
+
+    return result;
+}
+
+size_t
+parcLogReporterBinary_Decode(PARCBuffer *input, PARCLogReporter *reporter)
+{
+    size_t result = 0;
+    const char *header[3] = { _nilvalue, _nilvalue, _nilvalue };
+
+    while (parcBuffer_Remaining(input) >= _PARCLogReporterBinaryFrame_Overhead) {
+        size_t start = parcBuffer_Position(input);
+        uint8_t kind = parcBuffer_GetUint8(input);
+        size_t length = parcBuffer_GetUint32(input);
+        if (parcBuffer_Remaining(input) < length) {
+            parcBuffer_SetPosition(input, start);
+            break;
+        }
+        size_t end = parcBuffer_Position(input) + length;
+
+        PARCLogEntry *entry = NULL;
+        bool isValid = true;
+        switch (kind) {
+            case _PARCLogReporterBinaryFrame_Header:
+                for (int i = 0; i < 3 && isValid; i++) {
+                    header[i] = _parcLogReporterBinary_GetString(input);
+                    isValid = (header[i] != NULL);
+                }
+                break;
+
+            case _PARCLogReporterBinaryFrame_Record: {
+                PARCLogRecord record;
+                isValid = parcLogRecord_Decode(&record, input);
+                if (isValid) {
+                    entry = parcLogEntry_CreateDeferred(header[0], header[1], header[2], &record);
+                }
+                break;
+            }
+
+            case _PARCLogReporterBinaryFrame_Text:
+                entry = _parcLogReporterBinary_GetTextEntry(input, length, header);
+                isValid = (entry != NULL);
+                break;
+
+            default:
+                // Frames of an unknown kind are skipped.
+                break;
+        }
+
+        if (!isValid || parcBuffer_Position(input) > end) {
+            if (entry != NULL) {
+                parcLogEntry_Release(&entry);
+            }
+            parcBuffer_SetPosition(input, start);
+            break;
+        }
+
+        if (entry != NULL) {
+            parcLogReporter_Report(reporter, entry);
+            parcLogEntry_Release(&entry);
+            result++;
+        }
+        parcBuffer_SetPosition(input, end);
+    }
+
+    return result;
+}
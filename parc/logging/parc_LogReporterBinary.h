@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_LogReporterBinary.h
+ * @brief A PARCLogReporter that writes entries to a PARCOutputStream in a compact binary form.
+ *
+ * Entries created with deferred formatting (see `parcLog_SetDeferredFormatting`) are written as
+ * their `PARCLogRecord`, so their text is never produced by the logging process.
+ * Other entries are written with their formatted payload.
+ * The host name, application name and process identifier are written only when they change.
+ *
+ * The text of a binary log is recovered by `parcLogReporterBinary_Decode`,
+ * which reconstructs the entries and gives them to another `PARCLogReporter`,
+ * as the `parc-logdecode` command does.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARC_Library_parc_LogReporterBinary_h
+#define PARC_Library_parc_LogReporterBinary_h
+
+#include <parc/logging/parc_LogReporter.h>
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_OutputStream.h>
+
+/**
+ * Create a new instance of `PARCLogReporter` that writes binary log entries to the given {@link PARCOutputStream}.
+ *
+ * @param [in] output A pointer to a valid `PARCOutputStream` instance.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL A pointer to a valid `PARCLogReporter` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open("app.plog", O_WRONLY | O_CREAT | O_APPEND, 0644));
+ *     PARCOutputStream *out = parcFileOutputStream_AsOutputStream(fileOutput);
+ *     parcFileOutputStream_Release(&fileOutput);
+ *
+ *     PARCLogReporter *reporter = parcLogReporterBinary_Create(out);
+ *     parcOutputStream_Release(&out);
+ *
+ *     PARCLog *log = parcLog_Create("localhost", "myApp", "daemon", reporter);
+ *     parcLog_SetDeferredFormatting(log, true);
+ *     parcLogReporter_Release(&reporter);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterBinary_Create(PARCOutputStream *output);
+
+/**
+ * Increase the number of references to a `PARCLogReporter` instance.
+ *
+ * Note that new `PARCLogReporter` is not created,
+ * only that the given `PARCLogReporter` reference count is incremented.
+ * Discard the reference by invoking `parcLogReporterBinary_Release`.
+ *
+ * @param [in] instance A pointer to a `PARCLogReporter` instance.
+ *
+ * @return The input `PARCLogReporter` pointer.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *x = parcLogReporterBinary_Create(...);
+ *
+ *     PARCLogReporter *x_2 = parcLogReporterBinary_Acquire(x);
+ *
+ *     parcLogReporterBinary_Release(&x);
+ *     parcLogReporterBinary_Release(&x_2);
+ * }
+ * @endcode
+ */
+PARCLogReporter *parcLogReporterBinary_Acquire(const PARCLogReporter *instance);
+
+/**
+ * Release a previously acquired reference to the specified instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and the instance's implementation will perform
+ * additional cleanup and release other privately held references.
+ *
+ * @param [in,out] reporterP A pointer to a PARCLogReporter instance pointer, which will be set to zero on return.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *x = parcLogReporterBinary_Create(...);
+ *
+ *     parcLogReporterBinary_Release(&x);
+ * }
+ * @endcode
+ */
+void parcLogReporterBinary_Release(PARCLogReporter **reporterP);
+
+/**
+ * Report the given PARCLogEntry
+ *
+ * @param [in] reporter A pointer to a valid PARCLogReporter instance.
+ * @param [in] entry A pointer to a valid PARCLogEntry instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCLogReporter *reporter = parcLogReporterBinary_Create(output);
+ *
+ *     parcLogReporterBinary_Report(reporter, entry);
+ *
+ *     parcLogReporterBinary_Release(&reporter);
+ * }
+ * @endcode
+ */
+void parcLogReporterBinary_Report(PARCLogReporter *reporter, const PARCLogEntry *entry);
+
+/**
+ * Decode the binary log entries from the position of the given `PARCBuffer` to its limit,
+ * giving each to the given `PARCLogReporter`.
+ *
+ * The entries given to @p reporter refer to the memory of @p input,
+ * so a reporter that keeps entries must be finished with them before @p input is released.
+ * Decoding stops at the first malformed or incomplete entry,
+ * leaving the position of @p input at the start of that entry.
+ *
+ * @param [in,out] input A pointer to a valid `PARCBuffer` containing a binary log.
+ * @param [in] reporter A pointer to a valid `PARCLogReporter` to receive the decoded entries.
+ *
+ * @return The number of entries given to @p reporter.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *input = parcBuffer_Flip(parcFileInputStream_ReadFile(inputStream));
+ *
+ *     PARCLogReporter *reporter = parcLogReporterTextStdout_Create();
+ *     parcLogReporterBinary_Decode(input, reporter);
+ *     parcLogReporter_Release(&reporter);
+ *
+ *     parcBuffer_Release(&input);
+ * }
+ * @endcode
+ */
+size_t parcLogReporterBinary_Decode(PARCBuffer *input, PARCLogReporter *reporter);
+#endif // PARC_Library_parc_LogReporterBinary_h
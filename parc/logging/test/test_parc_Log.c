@@ -162,6 +162,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcLog_Debug);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_Info);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_Message);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_SetDeferredFormatting);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_Message_Deferred);
+    LONGBOW_RUN_TEST_CASE(Global, parcLog_Message_DeferredUncapturable);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_IsLoggable_True);
     LONGBOW_RUN_TEST_CASE(Global, parcLog_IsLoggable_False);
 
@@ -376,6 +379,32 @@ LONGBOW_TEST_CASE(Global, parcLog_Message)
                 "Expected message to be logged");
 }
 
+LONGBOW_TEST_CASE(Global, parcLog_SetDeferredFormatting)
+{
+    PARCLog *log = (PARCLog *) longBowTestCase_GetClipBoardData(testCase);
+
+    assertFalse(parcLog_SetDeferredFormatting(log, true), "Expected formatting not to be deferred by default");
+    assertTrue(parcLog_SetDeferredFormatting(log, false), "Expected the previous setting to be returned");
+}
+
+LONGBOW_TEST_CASE(Global, parcLog_Message_Deferred)
+{
+    PARCLog *log = (PARCLog *) longBowTestCase_GetClipBoardData(testCase);
+    parcLog_SetDeferredFormatting(log, true);
+
+    assertTrue(parcLog_Message(log, PARCLogLevel_Alert, 0, "This is a deferred %s message %d", "alert", 1),
+               "Expected message to be logged");
+}
+
+LONGBOW_TEST_CASE(Global, parcLog_Message_DeferredUncapturable)
+{
+    PARCLog *log = (PARCLog *) longBowTestCase_GetClipBoardData(testCase);
+    parcLog_SetDeferredFormatting(log, true);
+
+    assertTrue(parcLog_Message(log, PARCLogLevel_Alert, 0, "This alert is formatted immediately %Lf", (long double) 1.0),
+               "Expected message to be logged");
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -147,6 +147,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcLogEntry_GetLevel);
     LONGBOW_RUN_TEST_CASE(Global, parcLogEntry_GetProcessName);
     LONGBOW_RUN_TEST_CASE(Global, parcLogEntry_GetVersion);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogEntry_CreateDeferred);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogEntry_CreateDeferred_ConcurrentGetPayload);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogEntry_GetRecord);
 }
 
 uint32_t GlobalInitialMemoryOutstanding = 0;
@@ -198,6 +201,79 @@ LONGBOW_TEST_CASE(Global, parcLogEntry_GetBuffer)
     parcLogEntry_Release(&entry);
 }
 
+static PARCLogEntry *
+_createDeferredEntry(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    PARCLogRecord record;
+    parcLogRecord_Capture(&record, PARCLogLevel_Warning, 1234, format, ap);
+    va_end(ap);
+
+    return parcLogEntry_CreateDeferred("hostname", "applicationname", "processid", &record);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogEntry_CreateDeferred)
+{
+    PARCLogEntry *entry = _createDeferredEntry("%s %d", "hello", 42);
+
+    assertTrue(parcLogEntry_GetLevel(entry) == PARCLogLevel_Warning, "Expected the level of the record");
+    assertTrue(parcLogEntry_GetMessageId(entry) == 1234, "Expected the message id of the record");
+    assertTrue(strcmp(parcLogEntry_GetHostName(entry), "hostname") == 0, "Expected the host name");
+
+    PARCBuffer *payload = parcLogEntry_GetPayload(entry);
+    char *actual = parcBuffer_ToString(payload);
+    assertTrue(strcmp("hello 42", actual) == 0, "Expected hello 42, actual %s", actual);
+    parcMemory_Deallocate(&actual);
+
+    assertTrue(parcLogEntry_GetPayload(entry) == payload, "Expected the payload to be formatted once");
+
+    parcLogEntry_Release(&entry);
+}
+
+static void *
+_getPayload(void *entry)
+{
+    return parcLogEntry_GetPayload(entry);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogEntry_CreateDeferred_ConcurrentGetPayload)
+{
+    PARCLogEntry *entry = _createDeferredEntry("%s %d", "hello", 42);
+
+    pthread_t threads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_create(&threads[i], NULL, _getPayload, entry);
+    }
+    void *payloads[4];
+    for (int i = 0; i < 4; i++) {
+        pthread_join(threads[i], &payloads[i]);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        assertTrue(payloads[i] == parcLogEntry_GetPayload(entry), "Expected every thread to get the published payload");
+    }
+
+    parcLogEntry_Release(&entry);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogEntry_GetRecord)
+{
+    PARCLogEntry *entry = _createDeferredEntry("%s", "hello");
+    const PARCLogRecord *record = parcLogEntry_GetRecord(entry);
+    assertNotNull(record, "Expected a deferred entry to have a record");
+    assertTrue(strcmp(record->format, "%s") == 0, "Expected the format of the record");
+    parcLogEntry_Release(&entry);
+
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+    struct timeval timeStamp;
+    gettimeofday(&timeStamp, NULL);
+    entry = parcLogEntry_Create(PARCLogLevel_Info, "hostname", "applicationname", "processid", 1234, timeStamp, payload);
+    parcBuffer_Release(&payload);
+    assertNull(parcLogEntry_GetRecord(entry), "Expected an entry with a payload to have no record");
+    parcLogEntry_Release(&entry);
+}
+
 LONGBOW_TEST_CASE(Global, parcLogEntry_GetTimeStamp)
 {
     PARCBuffer *payload = parcBuffer_AllocateCString("hello");
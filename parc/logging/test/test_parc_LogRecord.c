@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogRecord.c"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogRecord)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogRecord)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogRecord)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static bool
+_capture(PARCLogRecord *record, const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    bool result = parcLogRecord_Capture(record, PARCLogLevel_Info, 42, format, ap);
+    va_end(ap);
+
+    return result;
+}
+
+/*
+ * Assert that capturing and then rendering a message produces the same text as vsnprintf.
+ */
+static void
+_assertFormatsLikePrintf(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    va_list copy;
+    va_copy(copy, ap);
+
+    char expected[512];
+    vsnprintf(expected, sizeof(expected), format, copy);
+    va_end(copy);
+
+    PARCLogRecord record;
+    bool captured = parcLogRecord_Capture(&record, PARCLogLevel_Info, 0, format, ap);
+    va_end(ap);
+    assertTrue(captured, "Expected \"%s\" to be captured", format);
+
+    char *actual = parcLogRecord_ToString(&record);
+    assertTrue(strcmp(expected, actual) == 0, "Expected \"%s\", actual \"%s\"", expected, actual);
+    parcMemory_Deallocate(&actual);
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Capture);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Capture_StringIsCopied);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Capture_Unsupported);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Capture_TooManyArguments);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Capture_TooMuchData);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Format_Conversions);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Format_Long);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_EncodeDecode);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Decode_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogRecord_Decode_Inconsistent);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Capture)
+{
+    const char *format = "%d %s";
+
+    PARCLogRecord record;
+    assertTrue(_capture(&record, format, 7, "seven"), "Expected the message to be captured");
+
+    assertTrue(record.format == format, "Expected the format pointer to be kept");
+    assertTrue(record.level == PARCLogLevel_Info, "Expected level %d, actual %d", PARCLogLevel_Info, record.level);
+    assertTrue(record.messageId == 42, "Expected message id 42, actual %" PRIu64, record.messageId);
+    assertTrue(record.argumentCount == 2, "Expected 2 arguments, actual %d", record.argumentCount);
+    assertTrue(record.dataLength == 6, "Expected 6 bytes of data, actual %d", record.dataLength);
+    assertTrue(record.timeStamp.tv_sec > 0, "Expected the time stamp to be set");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Capture_StringIsCopied)
+{
+    char name[] = "before";
+
+    PARCLogRecord record;
+    _capture(&record, "name=%s", name);
+    strcpy(name, "after!");
+
+    char *actual = parcLogRecord_ToString(&record);
+    assertTrue(strcmp("name=before", actual) == 0, "Expected the string as it was when captured, actual \"%s\"", actual);
+    parcMemory_Deallocate(&actual);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Capture_Unsupported)
+{
+    PARCLogRecord record;
+    int count;
+
+    assertFalse(_capture(&record, "%d%n", 1, &count), "Expected %%n to be rejected");
+    assertFalse(_capture(&record, "%Lf", (long double) 1.0), "Expected %%Lf to be rejected");
+    assertFalse(_capture(&record, "%ls", L"wide"), "Expected %%ls to be rejected");
+    assertFalse(_capture(&record, "%y"), "Expected an unknown conversion to be rejected");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Capture_TooManyArguments)
+{
+    PARCLogRecord record;
+
+    assertTrue(_capture(&record, "%d %d %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12),
+               "Expected %d arguments to be captured", PARCLogRecord_MaximumArguments);
+    assertFalse(_capture(&record, "%d %d %d %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13),
+                "Expected more than %d arguments to be rejected", PARCLogRecord_MaximumArguments);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Capture_TooMuchData)
+{
+    char string[PARCLogRecord_DataCapacity + 1];
+    memset(string, 'x', sizeof(string) - 1);
+    string[sizeof(string) - 1] = 0;
+
+    PARCLogRecord record;
+    assertFalse(_capture(&record, "%s", string), "Expected a string longer than the data capacity to be rejected");
+    assertTrue(_capture(&record, "%.10s", string), "Expected the precision to limit the copied string");
+    assertTrue(record.dataLength == 11, "Expected 11 bytes of data, actual %d", record.dataLength);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Format_Conversions)
+{
+    char unterminated[4] = { 'a', 'b', 'c', 'd' };
+
+    _assertFormatsLikePrintf("no conversions");
+    _assertFormatsLikePrintf("100%% sure");
+    _assertFormatsLikePrintf("%d %i %u %x %X %o %c", -1, 2, 3u, 0xbeef, 0xBEEF, 8, 'z');
+    _assertFormatsLikePrintf("%hhd %hd %ld %lld %qd", (char) -3, (short) -300, -70000L, -5000000000LL, 12LL);
+    _assertFormatsLikePrintf("%lu %llu %jd %zu %zd %td", ULONG_MAX, ULLONG_MAX, INTMAX_MIN, SIZE_MAX, (ssize_t) -1, (ptrdiff_t) -9);
+    _assertFormatsLikePrintf("%" PRIu64 " %" PRId32 " %" PRIx16, UINT64_MAX, INT32_MIN, (uint16_t) 0xffff);
+    _assertFormatsLikePrintf("%f %e %g %a %.3f %10.2E", 3.25, 1e-10, 0.5, 2.0, 3.14159, 12345.678);
+    _assertFormatsLikePrintf("[%-8s] [%8s] [%.2s] [%s]", "left", "right", "truncated", (char *) NULL);
+    _assertFormatsLikePrintf("[%*d] [%-*d] [%.*f] [%*.*s]", 6, 42, 6, 42, 2, 1.0 / 3.0, 8, 3, "precision");
+    _assertFormatsLikePrintf("[%.*s]", 4, unterminated);
+    _assertFormatsLikePrintf("%p %p", (void *) &unterminated, NULL);
+    _assertFormatsLikePrintf("%+05d % d %#x %#o %'d", 42, 42, 255, 8, 1000000);
+    _assertFormatsLikePrintf("trailing %d text", 1);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Format_Long)
+{
+    _assertFormatsLikePrintf("[%400d]", 1);
+    _assertFormatsLikePrintf("%200d%200d%s", 1, 2, "text");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_EncodeDecode)
+{
+    int local;
+    PARCLogRecord record;
+    _capture(&record, "%s %d %.2f %p %s %lld", "alpha", -7, 2.5, (void *) &local, (char *) NULL, 1LL << 40);
+    char *expected = parcLogRecord_ToString(&record);
+
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcLogRecord_Encode(&record, composer);
+    parcLogRecord_Encode(&record, composer);
+    PARCBuffer *buffer = parcBufferComposer_ProduceBuffer(composer);
+    parcBufferComposer_Release(&composer);
+
+    for (int i = 0; i < 2; i++) {
+        PARCLogRecord decoded;
+        assertTrue(parcLogRecord_Decode(&decoded, buffer), "Expected record %d to be decoded", i);
+        assertTrue(decoded.format != record.format, "Expected the decoded format to refer to the buffer");
+        assertTrue(decoded.level == record.level, "Expected level %d, actual %d", record.level, decoded.level);
+        assertTrue(decoded.messageId == record.messageId, "Expected the message id to be decoded");
+        assertTrue(decoded.timeStamp.tv_sec == record.timeStamp.tv_sec
+                   && decoded.timeStamp.tv_usec == record.timeStamp.tv_usec, "Expected the time stamp to be decoded");
+
+        char *actual = parcLogRecord_ToString(&decoded);
+        assertTrue(strcmp(expected, actual) == 0, "Expected \"%s\", actual \"%s\"", expected, actual);
+        parcMemory_Deallocate(&actual);
+    }
+    assertTrue(parcBuffer_Remaining(buffer) == 0, "Expected the whole buffer to be consumed");
+
+    parcBuffer_Release(&buffer);
+    parcMemory_Deallocate(&expected);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Decode_Truncated)
+{
+    PARCLogRecord record;
+    _capture(&record, "%s=%d", "count", 3);
+
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcLogRecord_Encode(&record, composer);
+    PARCBuffer *encoded = parcBufferComposer_ProduceBuffer(composer);
+    parcBufferComposer_Release(&composer);
+
+    size_t length = parcBuffer_Remaining(encoded);
+    for (size_t i = 0; i < length; i++) {
+        PARCBuffer *truncated = parcBuffer_Slice(encoded);
+        parcBuffer_SetLimit(truncated, i);
+
+        PARCLogRecord decoded;
+        assertFalse(parcLogRecord_Decode(&decoded, truncated), "Expected a record truncated to %zu bytes to be rejected", i);
+        assertTrue(parcBuffer_Position(truncated) == 0, "Expected the position to be restored");
+        parcBuffer_Release(&truncated);
+    }
+
+    parcBuffer_Release(&encoded);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogRecord_Decode_Inconsistent)
+{
+    PARCLogRecord record;
+    _capture(&record, "%d", 3);
+
+    // A record claiming a string argument where the format has an integer.
+    record.types[0] = _PARCLogRecordType_String;
+
+    PARCBufferComposer *composer = parcBufferComposer_Create();
+    parcLogRecord_Encode(&record, composer);
+    PARCBuffer *encoded = parcBufferComposer_ProduceBuffer(composer);
+    parcBufferComposer_Release(&composer);
+
+    PARCLogRecord decoded;
+    assertFalse(parcLogRecord_Decode(&decoded, encoded), "Expected argument types that disagree with the format to be rejected");
+
+    parcBuffer_Release(&encoded);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcLogRecord_Capture_Rate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_vasprintfMessage(const char *format, ...)
+{
+    va_list ap;
+    va_start(ap, format);
+    char *text;
+    int length = vasprintf(&text, format, ap);
+    va_end(ap);
+    assertTrue(length > 0, "vasprintf failed");
+    free(text);
+}
+
+LONGBOW_TEST_CASE(Performance, parcLogRecord_Capture_Rate)
+{
+    const int iterations = 1000000;
+    const char *format = "Received %zu bytes from %s on interface %d after %.3f ms";
+
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < iterations; i++) {
+        _vasprintfMessage(format, (size_t) i, "peer.example.com", 3, 1.25);
+    }
+    uint64_t eager = parcTime_NowNanoseconds() - start;
+
+    PARCLogRecord record;
+    start = parcTime_NowNanoseconds();
+    for (int i = 0; i < iterations; i++) {
+        _capture(&record, format, (size_t) i, "peer.example.com", 3, 1.25);
+    }
+    uint64_t deferred = parcTime_NowNanoseconds() - start;
+
+    PARCBufferComposer *composer = parcBufferComposer_Allocate(128);
+    start = parcTime_NowNanoseconds();
+    for (int i = 0; i < iterations; i++) {
+        parcLogRecord_Format(&record, composer);
+        parcBuffer_Clear(parcBufferComposer_GetBuffer(composer));
+    }
+    uint64_t rendered = parcTime_NowNanoseconds() - start;
+    parcBufferComposer_Release(&composer);
+
+    printf("vasprintf %" PRIu64 " ns, parcLogRecord_Capture %" PRIu64 " ns, parcLogRecord_Format %" PRIu64 " ns per message\n",
+           eager / iterations, deferred / iterations, rendered / iterations);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogRecord);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,493 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogReporterAsync.c"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <parc/logging/parc_Log.h>
+#include <parc/logging/parc_LogReporterFile.h>
+
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogReporterAsync)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogReporterAsync)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogReporterAsync)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * A reporter that counts the entries it is given, optionally slowly,
+ * and checks that the entries of each application arrive in the order of their message ids.
+ */
+#define _TestThreads 4
+
+static uint64_t _testReported;
+static uint64_t _testNextMessageId[_TestThreads];
+static bool _testOutOfOrder;
+static useconds_t _testReportDelay;
+
+static void
+_testReport(PARCLogReporter *reporter, const PARCLogEntry *entry)
+{
+    int application = atoi(parcLogEntry_GetApplicationName(entry));
+    if (parcLogEntry_GetMessageId(entry) < _testNextMessageId[application]) {
+        _testOutOfOrder = true;
+    }
+    _testNextMessageId[application] = parcLogEntry_GetMessageId(entry) + 1;
+
+    if (_testReportDelay > 0) {
+        usleep(_testReportDelay);
+    }
+    __sync_add_and_fetch(&_testReported, 1);
+}
+
+static PARCLogReporter *
+_createTestReporter(useconds_t delay)
+{
+    _testReported = 0;
+    memset(_testNextMessageId, 0, sizeof(_testNextMessageId));
+    _testOutOfOrder = false;
+    _testReportDelay = delay;
+
+    return parcLogReporter_Create(parcLogReporterAsync_Acquire, parcLogReporterAsync_Release, _testReport, NULL);
+}
+
+static PARCLogEntry *
+_createEntry(int application, uint64_t messageId)
+{
+    char applicationName[16];
+    sprintf(applicationName, "%d", application);
+
+    struct timeval timeStamp;
+    gettimeofday(&timeStamp, NULL);
+    PARCBuffer *payload = parcBuffer_AllocateCString("hello");
+    PARCLogEntry *result = parcLogEntry_Create(PARCLogLevel_Info, "hostname", applicationName, "processid", messageId, timeStamp, payload);
+    parcBuffer_Release(&payload);
+
+    return result;
+}
+
+typedef struct {
+    PARCLogReporter *reporter;
+    int application;
+    unsigned count;
+} _Producer;
+
+static void *
+_produce(void *parameter)
+{
+    _Producer *producer = parameter;
+    for (unsigned i = 0; i < producer->count; i++) {
+        PARCLogEntry *entry = _createEntry(producer->application, i);
+        parcLogReporter_Report(producer->reporter, entry);
+        parcLogEntry_Release(&entry);
+    }
+    return NULL;
+}
+
+static void
+_produceConcurrently(PARCLogReporter *reporter, int threads, unsigned count)
+{
+    _Producer producers[threads];
+    pthread_t ids[threads];
+    for (int i = 0; i < threads; i++) {
+        producers[i].reporter = reporter;
+        producers[i].application = i;
+        producers[i].count = count;
+        pthread_create(&ids[i], NULL, _produce, &producers[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Report);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Report_Log);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Release_Drains);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Block);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Drop);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Backpressure);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterAsync_Flush_NewThread);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_AcquireRelease)
+{
+    PARCLogReporter *sink = _createTestReporter(0);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Drop, 16);
+    parcLogReporter_Release(&sink);
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcLogReporterAsync_Acquire, reporter);
+
+    parcLogReporterAsync_Release(&reporter);
+    assertNull(reporter, "Expected null value.");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Report)
+{
+    PARCLogReporter *sink = _createTestReporter(0);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Block, 16);
+    parcLogReporter_Release(&sink);
+
+    for (unsigned i = 0; i < 100; i++) {
+        PARCLogEntry *entry = _createEntry(0, i);
+        parcLogReporter_Report(reporter, entry);
+        parcLogEntry_Release(&entry);
+    }
+    parcLogReporterAsync_Flush(reporter);
+
+    assertTrue(_testReported == 100, "Expected 100 entries reported, actual %" PRIu64, _testReported);
+    assertTrue(parcLogReporterAsync_GetReportedCount(reporter) == 100,
+               "Expected a reported count of 100, actual %" PRIu64, parcLogReporterAsync_GetReportedCount(reporter));
+    assertFalse(_testOutOfOrder, "Expected the entries in the order they were reported");
+
+    parcLogReporter_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Report_Log)
+{
+    int fd = open("/dev/null", O_WRONLY);
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(fd);
+    PARCOutputStream *out = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *sink = parcLogReporterFile_Create(out);
+    parcOutputStream_Release(&out);
+
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Block, 64);
+    parcLogReporter_Release(&sink);
+
+    PARCLog *log = parcLog_Create("localhost", "test_parc_LogReporterAsync", NULL, reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+
+    assertTrue(parcLog_Warning(log, "This is a warning %d", 1), "Expected the message to be logged");
+    parcLogReporterAsync_Flush(reporter);
+    assertTrue(parcLogReporterAsync_GetReportedCount(reporter) == 1,
+               "Expected a reported count of 1, actual %" PRIu64, parcLogReporterAsync_GetReportedCount(reporter));
+
+    parcLog_Release(&log);
+    parcLogReporter_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Release_Drains)
+{
+    PARCLogReporter *sink = _createTestReporter(0);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Block, 1024);
+    parcLogReporter_Release(&sink);
+
+    _produceConcurrently(reporter, _TestThreads, 200);
+    parcLogReporter_Release(&reporter);
+
+    assertTrue(_testReported == _TestThreads * 200, "Expected every entry reported before the reporter stopped, actual %" PRIu64, _testReported);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Block)
+{
+    PARCLogReporter *sink = _createTestReporter(0);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Block, 8);
+    parcLogReporter_Release(&sink);
+
+    _produceConcurrently(reporter, _TestThreads, 2000);
+    parcLogReporterAsync_Flush(reporter);
+
+    assertTrue(_testReported == _TestThreads * 2000, "Expected %d entries, actual %" PRIu64, _TestThreads * 2000, _testReported);
+    assertTrue(parcLogReporterAsync_GetDroppedCount(reporter) == 0, "Expected nothing dropped");
+    assertFalse(_testOutOfOrder, "Expected the entries of each thread in the order they were reported");
+
+    parcLogReporter_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Drop)
+{
+    PARCLogReporter *sink = _createTestReporter(100);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Drop, 4);
+    parcLogReporter_Release(&sink);
+
+    _produceConcurrently(reporter, _TestThreads, 100);
+    parcLogReporterAsync_Flush(reporter);
+
+    uint64_t dropped = parcLogReporterAsync_GetDroppedCount(reporter);
+    assertTrue(dropped > 0, "Expected a slow reporter to cause entries to be dropped");
+    assertTrue(_testReported + dropped == _TestThreads * 100,
+               "Expected every entry to be reported or dropped, reported %" PRIu64 " dropped %" PRIu64, _testReported, dropped);
+    assertFalse(_testOutOfOrder, "Expected the entries of each thread in the order they were reported");
+
+    parcLogReporter_Release(&reporter);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Backpressure)
+{
+    PARCLogReporter *sink = _createTestReporter(100);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Backpressure, 4);
+    parcLogReporter_Release(&sink);
+
+    _produceConcurrently(reporter, 1, 100);
+    parcLogReporterAsync_Flush(reporter);
+
+    assertTrue(_testReported == 100, "Expected every entry reported, actual %" PRIu64, _testReported);
+    assertTrue(parcLogReporterAsync_GetDroppedCount(reporter) == 0, "Expected nothing dropped");
+
+    parcLogReporter_Release(&reporter);
+}
+
+static volatile bool _testFlushed;
+
+static void *
+_flush(void *reporter)
+{
+    parcLogReporterAsync_Flush(reporter);
+    _testFlushed = true;
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterAsync_Flush_NewThread)
+{
+    PARCLogReporter *sink = _createTestReporter(20000);
+    PARCLogReporter *reporter = parcLogReporterAsync_Create(sink, PARCLogReporterAsyncPolicy_Block, 16);
+    parcLogReporter_Release(&sink);
+
+    _produceConcurrently(reporter, 1, 10);
+
+    _testFlushed = false;
+    pthread_t flusher;
+    pthread_create(&flusher, NULL, _flush, reporter);
+    usleep(10000);
+
+    // A thread logging for the first time adds a ring, which must not wait for the flush to finish.
+    _Producer producer = { .reporter = reporter, .application = 1, .count = 1 };
+    pthread_t id;
+    pthread_create(&id, NULL, _produce, &producer);
+    pthread_join(id, NULL);
+    assertFalse(_testFlushed, "Expected a new thread to log while a flush is waiting");
+
+    pthread_join(flusher, NULL);
+    parcLogReporterAsync_Flush(reporter);
+    assertTrue(_testReported == 11, "Expected 11 entries reported, actual %" PRIu64, _testReported);
+
+    parcLogReporter_Release(&reporter);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcLogReporterAsync_Latency);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _LatencyMessages 20000
+
+typedef struct {
+    PARCLog *log;
+    uint64_t latency[_LatencyMessages];
+} _LatencyProducer;
+
+static void *
+_measureLatency(void *parameter)
+{
+    _LatencyProducer *producer = parameter;
+    for (unsigned i = 0; i < _LatencyMessages; i++) {
+        uint64_t start = parcTime_NowNanoseconds();
+        parcLog_Warning(producer->log, "Message %u from the data path: %s", i, "something happened");
+        producer->latency[i] = parcTime_NowNanoseconds() - start;
+    }
+    return NULL;
+}
+
+static int
+_compareLatency(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+static void
+_reportLatency(const char *name, PARCLogReporter *reporter, int threads)
+{
+    PARCLog *log = parcLog_Create("localhost", "test_parc_LogReporterAsync", NULL, reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+
+    _LatencyProducer *producers = malloc(threads * sizeof(_LatencyProducer));
+    pthread_t ids[threads];
+    for (int i = 0; i < threads; i++) {
+        producers[i].log = log;
+        pthread_create(&ids[i], NULL, _measureLatency, &producers[i]);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+
+    size_t count = (size_t) threads * _LatencyMessages;
+    uint64_t *all = malloc(count * sizeof(uint64_t));
+    for (int i = 0; i < threads; i++) {
+        memcpy(&all[i * _LatencyMessages], producers[i].latency, sizeof(producers[i].latency));
+    }
+    qsort(all, count, sizeof(uint64_t), _compareLatency);
+
+    printf("%-28s %d threads: p50 %6" PRIu64 " ns  p99 %8" PRIu64 " ns  max %10" PRIu64 " ns\n",
+           name, threads, all[count / 2], all[count * 99 / 100], all[count - 1]);
+
+    free(all);
+    free(producers);
+    parcLog_Release(&log);
+}
+
+static PARCLogReporter *
+_createFileReporter(void)
+{
+    char filename[] = "/tmp/parc_LogReporterAsync_XXXXXX";
+    int fd = mkstemp(filename);
+    unlink(filename);
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(fd);
+    PARCOutputStream *out = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *result = parcLogReporterFile_Create(out);
+    parcOutputStream_Release(&out);
+
+    return result;
+}
+
+LONGBOW_TEST_CASE(Performance, parcLogReporterAsync_Latency)
+{
+    int threadCounts[] = { 1, 4 };
+
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++) {
+        PARCLogReporter *file = _createFileReporter();
+        _reportLatency("parcLogReporterFile", file, threadCounts[i]);
+        parcLogReporter_Release(&file);
+
+        PARCLogReporterAsyncPolicy policies[] = {
+            PARCLogReporterAsyncPolicy_Drop, PARCLogReporterAsyncPolicy_Block, PARCLogReporterAsyncPolicy_Backpressure
+        };
+        const char *names[] = { "parcLogReporterAsync Drop", "parcLogReporterAsync Block", "parcLogReporterAsync Backpressure" };
+
+        for (size_t p = 0; p < sizeof(policies) / sizeof(policies[0]); p++) {
+            file = _createFileReporter();
+            PARCLogReporter *reporter = parcLogReporterAsync_Create(file, policies[p], 4096);
+            parcLogReporter_Release(&file);
+
+            _reportLatency(names[p], reporter, threadCounts[i]);
+            printf("%-28s dropped %" PRIu64 "\n", "", parcLogReporterAsync_GetDroppedCount(reporter));
+            parcLogReporter_Release(&reporter);
+        }
+    }
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogReporterAsync);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,335 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+// Include the file(s) containing the functions to be tested.
+// This permits internal static functions to be visible to this Test Runner.
+#include "../parc_LogReporterBinary.c"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <parc/logging/parc_Log.h>
+
+#include <parc/algol/parc_FileInputStream.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+#include <LongBow/unit-test.h>
+
+LONGBOW_TEST_RUNNER(parc_LogReporterBinary)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified here, but every test must be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_LogReporterBinary)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_LogReporterBinary)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/*
+ * A reporter that keeps the text of the entries it is given.
+ */
+#define _TestMaximumEntries 8
+
+static int _testEntryCount;
+static char *_testText[_TestMaximumEntries];
+static char *_testApplicationName[_TestMaximumEntries];
+static PARCLogLevel _testLevel[_TestMaximumEntries];
+
+static void
+_testReport(PARCLogReporter *reporter, const PARCLogEntry *entry)
+{
+    assertTrue(_testEntryCount < _TestMaximumEntries, "Too many entries reported");
+
+    PARCBuffer *payload = parcLogEntry_GetPayload(entry);
+    _testText[_testEntryCount] = parcBuffer_ToString(payload);
+    const char *applicationName = parcLogEntry_GetApplicationName(entry);
+    _testApplicationName[_testEntryCount] = parcMemory_StringDuplicate(applicationName, strlen(applicationName));
+    _testLevel[_testEntryCount] = parcLogEntry_GetLevel(entry);
+    _testEntryCount++;
+}
+
+static PARCLogReporter *
+_createTestReporter(void)
+{
+    _testEntryCount = 0;
+    return parcLogReporter_Create(&parcLogReporterBinary_Acquire, parcLogReporterBinary_Release, _testReport, NULL);
+}
+
+static void
+_releaseTestEntries(void)
+{
+    for (int i = 0; i < _testEntryCount; i++) {
+        parcMemory_Deallocate(&_testText[i]);
+        parcMemory_Deallocate(&_testApplicationName[i]);
+    }
+    _testEntryCount = 0;
+}
+
+/*
+ * Create a binary reporter writing to an unlinked temporary file, and return the file's descriptor for reading.
+ */
+static PARCLogReporter *
+_createBinaryReporter(int *readFd)
+{
+    char filename[] = "/tmp/test_parc_LogReporterBinary_XXXXXX";
+    int fd = mkstemp(filename);
+    assertTrue(fd >= 0, "mkstemp failed");
+    *readFd = open(filename, O_RDONLY);
+    unlink(filename);
+
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(fd);
+    PARCOutputStream *out = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+    PARCLogReporter *result = parcLogReporterBinary_Create(out);
+    parcOutputStream_Release(&out);
+
+    return result;
+}
+
+static PARCBuffer *
+_readAll(int fd)
+{
+    PARCFileInputStream *input = parcFileInputStream_Create(fd);
+    PARCBuffer *result = parcBuffer_Flip(parcFileInputStream_ReadFile(input));
+    parcFileInputStream_Release(&input);
+
+    return result;
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterBinary_AcquireRelease);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterBinary_Report_Decode);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterBinary_Report_HeaderOnChange);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterBinary_Decode_Truncated);
+    LONGBOW_RUN_TEST_CASE(Global, parcLogReporterBinary_Decode_Empty);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        parcSafeMemory_ReportAllocation(STDOUT_FILENO);
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterBinary_AcquireRelease)
+{
+    int fd;
+    PARCLogReporter *reporter = _createBinaryReporter(&fd);
+    close(fd);
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcLogReporterBinary_Acquire, reporter);
+
+    parcLogReporterBinary_Release(&reporter);
+    assertNull(reporter, "Expected null value.");
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterBinary_Report_Decode)
+{
+    int fd;
+    PARCLogReporter *reporter = _createBinaryReporter(&fd);
+
+    PARCLog *log = parcLog_Create("localhost", "binary", "1234", reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+
+    parcLog_SetDeferredFormatting(log, true);
+    parcLog_Warning(log, "deferred %d %s", 1, "one");
+    parcLog_Info(log, "formatted %Lf", (long double) 2.5);
+    parcLog_SetDeferredFormatting(log, false);
+    parcLog_Error(log, "eager %d", 3);
+
+    parcLog_Release(&log);
+    parcLogReporter_Release(&reporter);
+
+    PARCBuffer *input = _readAll(fd);
+    PARCLogReporter *testReporter = _createTestReporter();
+    size_t count = parcLogReporterBinary_Decode(input, testReporter);
+    parcLogReporter_Release(&testReporter);
+
+    assertTrue(count == 3, "Expected 3 entries decoded, actual %zu", count);
+    assertTrue(parcBuffer_Remaining(input) == 0, "Expected the whole log to be decoded");
+    assertTrue(strcmp(_testText[0], "deferred 1 one") == 0, "Unexpected text \"%s\"", _testText[0]);
+    assertTrue(strcmp(_testText[1], "formatted 2.500000") == 0, "Unexpected text \"%s\"", _testText[1]);
+    assertTrue(strcmp(_testText[2], "eager 3") == 0, "Unexpected text \"%s\"", _testText[2]);
+    assertTrue(_testLevel[0] == PARCLogLevel_Warning, "Expected the level to be decoded");
+    assertTrue(_testLevel[2] == PARCLogLevel_Error, "Expected the level to be decoded");
+    assertTrue(strcmp(_testApplicationName[2], "binary") == 0, "Unexpected application name \"%s\"", _testApplicationName[2]);
+
+    _releaseTestEntries();
+    parcBuffer_Release(&input);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterBinary_Report_HeaderOnChange)
+{
+    int fd;
+    PARCLogReporter *reporter = _createBinaryReporter(&fd);
+
+    PARCLog *first = parcLog_Create("localhost", "first", NULL, reporter);
+    PARCLog *second = parcLog_Create("localhost", "second", NULL, reporter);
+    parcLog_SetLevel(first, PARCLogLevel_All);
+    parcLog_SetLevel(second, PARCLogLevel_All);
+    parcLog_SetDeferredFormatting(first, true);
+    parcLog_SetDeferredFormatting(second, true);
+
+    parcLog_Info(first, "a");
+    parcLog_Info(first, "b");
+    parcLog_Info(second, "c");
+    parcLog_Info(first, "d");
+
+    parcLog_Release(&first);
+    parcLog_Release(&second);
+    parcLogReporter_Release(&reporter);
+
+    PARCBuffer *input = _readAll(fd);
+
+    size_t headers = 0;
+    while (parcBuffer_Remaining(input) > 0) {
+        if (parcBuffer_GetUint8(input) == _PARCLogReporterBinaryFrame_Header) {
+            headers++;
+        }
+        size_t length = parcBuffer_GetUint32(input);
+        parcBuffer_SetPosition(input, parcBuffer_Position(input) + length);
+    }
+    assertTrue(headers == 3, "Expected a header each time the application changed, actual %zu", headers);
+
+    parcBuffer_Rewind(input);
+    PARCLogReporter *testReporter = _createTestReporter();
+    parcLogReporterBinary_Decode(input, testReporter);
+    parcLogReporter_Release(&testReporter);
+
+    const char *expected[] = { "first", "first", "second", "first" };
+    for (int i = 0; i < 4; i++) {
+        assertTrue(strcmp(_testApplicationName[i], expected[i]) == 0,
+                   "Expected %s, actual %s", expected[i], _testApplicationName[i]);
+    }
+
+    _releaseTestEntries();
+    parcBuffer_Release(&input);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterBinary_Decode_Truncated)
+{
+    int fd;
+    PARCLogReporter *reporter = _createBinaryReporter(&fd);
+
+    PARCLog *log = parcLog_Create("localhost", "binary", NULL, reporter);
+    parcLog_SetLevel(log, PARCLogLevel_All);
+    parcLog_SetDeferredFormatting(log, true);
+    parcLog_Info(log, "complete %d", 1);
+    parcLog_Info(log, "incomplete %d", 2);
+    parcLog_Release(&log);
+    parcLogReporter_Release(&reporter);
+
+    PARCBuffer *input = _readAll(fd);
+    parcBuffer_SetLimit(input, parcBuffer_Limit(input) - 3);
+
+    PARCLogReporter *testReporter = _createTestReporter();
+    size_t count = parcLogReporterBinary_Decode(input, testReporter);
+    parcLogReporter_Release(&testReporter);
+
+    assertTrue(count == 1, "Expected only the complete entry, actual %zu", count);
+    assertTrue(parcBuffer_Remaining(input) > 0, "Expected the position to be left at the incomplete entry");
+
+    _releaseTestEntries();
+    parcBuffer_Release(&input);
+}
+
+LONGBOW_TEST_CASE(Global, parcLogReporterBinary_Decode_Empty)
+{
+    PARCBuffer *input = parcBuffer_Allocate(0);
+
+    PARCLogReporter *testReporter = _createTestReporter();
+    size_t count = parcLogReporterBinary_Decode(input, testReporter);
+    parcLogReporter_Release(&testReporter);
+
+    assertTrue(count == 0, "Expected no entries, actual %zu", count);
+
+    parcBuffer_Release(&input);
+}
+
+int
+main(int argc, char *argv[])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_LogReporterBinary);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -64,6 +64,8 @@
 
 #include <parc/algol/parc_LinkedList.h>
 
+#include <parc/statistics/parc_Metrics.h>
+
 #include "parc_BufferPool.h"
 
 struct PARCBufferPool {
@@ -272,3 +274,47 @@ parcBufferPool_GetCacheHits(const PARCBufferPool *bufferPool)
 {
     return bufferPool->cacheHits;
 }
+
+static int64_t
+_parcBufferPool_CacheHitsGauge(const PARCObject *bufferPool)
+{
+    return (int64_t) parcBufferPool_GetCacheHits(bufferPool);
+}
+
+static int64_t
+_parcBufferPool_TotalInstancesGauge(const PARCObject *bufferPool)
+{
+    return (int64_t) parcBufferPool_GetTotalInstances(bufferPool);
+}
+
+static int64_t
+_parcBufferPool_CurrentPoolSizeGauge(const PARCObject *bufferPool)
+{
+    return (int64_t) parcBufferPool_GetCurrentPoolSize(bufferPool);
+}
+
+static int64_t
+_parcBufferPool_LargestPoolSizeGauge(const PARCObject *bufferPool)
+{
+    return (int64_t) parcBufferPool_GetLargestPoolSize(bufferPool);
+}
+
+void
+parcBufferPool_RegisterMetrics(PARCBufferPool *bufferPool, PARCMetrics *metrics, const char *prefix)
+{
+    static const struct {
+        const char *suffix;
+        PARCMetricsGaugeFunction *function;
+    } gauges[] = {
+        { ".cacheHits",       _parcBufferPool_CacheHitsGauge       },
+        { ".totalInstances",  _parcBufferPool_TotalInstancesGauge  },
+        { ".currentPoolSize", _parcBufferPool_CurrentPoolSizeGauge },
+        { ".largestPoolSize", _parcBufferPool_LargestPoolSizeGauge },
+    };
+
+    for (size_t i = 0; i < sizeof(gauges) / sizeof(gauges[0]); i++) {
+        char *name = parcMemory_Format("%s%s", prefix, gauges[i].suffix);
+        parcMetrics_AddGauge(metrics, name, gauges[i].function, bufferPool);
+        parcMemory_Deallocate((void **) &name);
+    }
+}
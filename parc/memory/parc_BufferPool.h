@@ -70,6 +70,8 @@
 
 #include <parc/algol/parc_Object.h>
 
+struct PARCMetrics;
+
 parcObject_Declare(PARCBufferPool);
 
 /**
@@ -382,4 +384,48 @@ size_t parcBufferPool_GetLargestPoolSize(const PARCBufferPool *bufferPool);
  * @endcode
  */
 size_t parcBufferPool_Drain(PARCBufferPool *bufferPool);
+
+/**
+ * Get the number of buffers obtained from the pool by `parcBufferPool_GetInstance`.
+ *
+ * @param [in] bufferPool A pointer to a valid PARCBufferPool instance.
+ *
+ * @return The number of buffers obtained from the pool.
+ */
+size_t parcBufferPool_GetTotalInstances(const PARCBufferPool *bufferPool);
+
+/**
+ * Get the number of buffers obtained from the pool that were reused from its cache rather than allocated.
+ *
+ * @param [in] bufferPool A pointer to a valid PARCBufferPool instance.
+ *
+ * @return The number of buffers reused from the cache.
+ *
+ * Example:
+ * @code
+ * {
+ *     double hitRate = (double) parcBufferPool_GetCacheHits(pool) / parcBufferPool_GetTotalInstances(pool);
+ * }
+ * @endcode
+ */
+size_t parcBufferPool_GetCacheHits(const PARCBufferPool *bufferPool);
+
+/**
+ * Register gauges for the statistics of the given pool in a `PARCMetrics` registry.
+ *
+ * The gauges are named by appending ".cacheHits", ".totalInstances", ".currentPoolSize" and ".largestPoolSize" to @p prefix.
+ * The registry holds a reference to the pool until the gauges are removed or the registry is released.
+ *
+ * @param [in] bufferPool A pointer to a valid PARCBufferPool instance.
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] prefix The prefix of the names of the gauges.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcBufferPool_RegisterMetrics(pool, metrics, "forwarder.contentObjectPool");
+ * }
+ * @endcode
+ */
+void parcBufferPool_RegisterMetrics(PARCBufferPool *bufferPool, struct PARCMetrics *metrics, const char *prefix);
 #endif
@@ -58,6 +58,8 @@
  */
 #include "../parc_BufferPool.c"
 
+#include <inttypes.h>
+
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
 #include <parc/algol/parc_Memory.h>
@@ -178,6 +180,7 @@ LONGBOW_TEST_FIXTURE(Specialization)
     LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_SetLimit_Increasing);
     LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_SetLimit_Decreasing);
     LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_Drain);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBufferPool_RegisterMetrics);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -401,6 +404,34 @@ LONGBOW_TEST_CASE(Specialization, parcBufferPool_Drain)
     parcBufferPool_Release(&pool);
 }
 
+LONGBOW_TEST_CASE(Specialization, parcBufferPool_RegisterMetrics)
+{
+    PARCBufferPool *pool = parcBufferPool_Create(3, 10);
+    PARCMetrics *metrics = parcMetrics_Create();
+
+    parcBufferPool_RegisterMetrics(pool, metrics, "buffers");
+    assertTrue(parcMetrics_Size(metrics) == 4, "Expected 4 metrics, actual %zu", parcMetrics_Size(metrics));
+
+    PARCBuffer *buffer = parcBufferPool_GetInstance(pool);
+    parcBuffer_Release(&buffer);
+    buffer = parcBufferPool_GetInstance(pool);
+    parcBuffer_Release(&buffer);
+
+    PARCJSON *json = parcMetrics_ToJSON(metrics);
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "buffers.cacheHits");
+    assertTrue(parcJSONValue_GetInteger(value) == 1, "Expected 1 cache hit, actual %" PRId64, parcJSONValue_GetInteger(value));
+    value = parcJSON_GetValueByName(json, "buffers.totalInstances");
+    assertTrue(parcJSONValue_GetInteger(value) == 2, "Expected 2 instances, actual %" PRId64, parcJSONValue_GetInteger(value));
+    value = parcJSON_GetValueByName(json, "buffers.currentPoolSize");
+    assertTrue(parcJSONValue_GetInteger(value) == 1, "Expected a pool size of 1, actual %" PRId64, parcJSONValue_GetInteger(value));
+    value = parcJSON_GetValueByName(json, "buffers.largestPoolSize");
+    assertTrue(parcJSONValue_GetInteger(value) == 1, "Expected a largest pool size of 1, actual %" PRId64, parcJSONValue_GetInteger(value));
+    parcJSON_Release(&json);
+
+    parcMetrics_Release(&metrics);
+    parcBufferPool_Release(&pool);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -0,0 +1,448 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The pipeline is composed of three parts.
+ * A read-ahead thread iterates the chunker and, for each chunk, submits a `PARCFutureTask` to the thread pool
+ * and appends the same task to the tail of the pending list.
+ * The pool's workers compute the digest and signature of each chunk independently of one another.
+ * The consumer removes tasks from the head of the pending list and waits for each to complete,
+ * which delivers the results in chunk order no matter the order in which the workers finish them.
+ *
+ * The pending list is bounded by the depth of the pipeline: the read-ahead thread waits while it is full.
+ * The lock of the pending list guards the read-ahead state shared by the reader and the consumer.
+ *
+ * The read-ahead thread holds a reference to the shared state, not to the PARCChunkPipeline,
+ * so that releasing the pipeline can stop and join the reader.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <LongBow/runtime.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_LinkedList.h>
+#include <parc/algol/parc_Iterator.h>
+
+#include <parc/concurrent/parc_FutureTask.h>
+#include <parc/concurrent/parc_Thread.h>
+
+#include <parc/security/parc_CryptoHasher.h>
+#include <parc/security/parc_ChunkPipeline.h>
+
+struct PARCChunkPipelineResult {
+    size_t chunkNumber;
+    PARCBuffer *chunk;
+    PARCCryptoHashType hashType;
+    PARCSigner *signer;
+    PARCCryptoHash *digest;
+    PARCSignature *signature;
+};
+
+static bool
+_parcChunkPipelineResult_Destructor(PARCChunkPipelineResult **resultPtr)
+{
+    PARCChunkPipelineResult *result = *resultPtr;
+
+    parcBuffer_Release(&result->chunk);
+    if (result->signer != NULL) {
+        parcSigner_Release(&result->signer);
+    }
+    if (result->digest != NULL) {
+        parcCryptoHash_Release(&result->digest);
+    }
+    if (result->signature != NULL) {
+        parcSignature_Release(&result->signature);
+    }
+    return true;
+}
+
+parcObject_Override(PARCChunkPipelineResult, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcChunkPipelineResult_Destructor);
+
+parcObject_ImplementAcquire(parcChunkPipelineResult, PARCChunkPipelineResult);
+
+parcObject_ImplementRelease(parcChunkPipelineResult, PARCChunkPipelineResult);
+
+static PARCChunkPipelineResult *
+_parcChunkPipelineResult_Create(size_t chunkNumber, PARCBuffer *chunk, PARCCryptoHashType hashType, const PARCSigner *signer)
+{
+    PARCChunkPipelineResult *result = parcObject_CreateInstance(PARCChunkPipelineResult);
+
+    if (result != NULL) {
+        result->chunkNumber = chunkNumber;
+        result->chunk = parcBuffer_Acquire(chunk);
+        result->hashType = hashType;
+        result->signer = (signer == NULL) ? NULL : parcSigner_Acquire(signer);
+        result->digest = NULL;
+        result->signature = NULL;
+    }
+
+    return result;
+}
+
+size_t
+parcChunkPipelineResult_GetChunkNumber(const PARCChunkPipelineResult *result)
+{
+    return result->chunkNumber;
+}
+
+PARCBuffer *
+parcChunkPipelineResult_GetChunk(const PARCChunkPipelineResult *result)
+{
+    return result->chunk;
+}
+
+PARCCryptoHash *
+parcChunkPipelineResult_GetDigest(const PARCChunkPipelineResult *result)
+{
+    return result->digest;
+}
+
+PARCSignature *
+parcChunkPipelineResult_GetSignature(const PARCChunkPipelineResult *result)
+{
+    return result->signature;
+}
+
+/*
+ * Runs on a worker thread of the pool.
+ * Each result carries everything needed to process it, so workers share no state.
+ */
+static void *
+_parcChunkPipeline_ProcessChunk(PARCFutureTask *task, void *parameter)
+{
+    PARCChunkPipelineResult *result = parameter;
+
+    result->digest = parcCryptoHasher_HashBuffer(result->hashType, result->chunk);
+
+    if (result->signer != NULL) {
+        result->signature = parcSigner_SignDigest(result->signer, result->digest);
+    }
+
+    return result;
+}
+
+typedef struct {
+    PARCChunker *chunker;
+    PARCSigner *signer;
+    PARCCryptoHashType hashType;
+    PARCThreadPool *pool;
+    size_t depth;
+
+    PARCLinkedList *pending;
+    bool readerDone;
+    bool cancelled;
+    size_t deliveredCount;
+} _PARCChunkPipelineState;
+
+static bool
+_parcChunkPipelineState_Destructor(_PARCChunkPipelineState **statePtr)
+{
+    _PARCChunkPipelineState *state = *statePtr;
+
+    parcChunker_Release(&state->chunker);
+    if (state->signer != NULL) {
+        parcSigner_Release(&state->signer);
+    }
+    parcThreadPool_Release(&state->pool);
+    parcLinkedList_Release(&state->pending);
+
+    return true;
+}
+
+parcObject_Override(_PARCChunkPipelineState, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcChunkPipelineState_Destructor);
+
+static parcObject_ImplementRelease(_parcChunkPipelineState, _PARCChunkPipelineState);
+
+/*
+ * Append the task to the pending list, waiting while the list is full.
+ * Return false if the pipeline was cancelled instead.
+ */
+static bool
+_parcChunkPipelineState_PutPending(_PARCChunkPipelineState *state, PARCFutureTask *task)
+{
+    bool result = false;
+
+    if (parcLinkedList_Lock(state->pending)) {
+        while (state->cancelled == false && parcLinkedList_Size(state->pending) >= state->depth) {
+            parcLinkedList_Wait(state->pending);
+        }
+        if (state->cancelled == false) {
+            parcLinkedList_Append(state->pending, task);
+            parcLinkedList_NotifyAll(state->pending);
+            result = true;
+        }
+        parcLinkedList_Unlock(state->pending);
+    }
+
+    return result;
+}
+
+static void *
+_parcChunkPipeline_Reader(PARCThread *thread, _PARCChunkPipelineState *state)
+{
+    PARCIterator *iterator = parcChunker_ForwardIterator(state->chunker);
+
+    size_t chunkNumber = 0;
+    bool running = true;
+    while (running && parcIterator_HasNext(iterator)) {
+        PARCBuffer *chunk = parcIterator_Next(iterator);
+
+        PARCChunkPipelineResult *result = _parcChunkPipelineResult_Create(chunkNumber++, chunk, state->hashType, state->signer);
+        parcBuffer_Release(&chunk);
+        PARCFutureTask *task = parcFutureTask_Create(_parcChunkPipeline_ProcessChunk, result);
+        parcChunkPipelineResult_Release(&result);
+
+        running = _parcChunkPipelineState_PutPending(state, task);
+        if (running) {
+            parcThreadPool_Execute(state->pool, task);
+        }
+        parcFutureTask_Release(&task);
+    }
+    parcIterator_Release(&iterator);
+
+    if (parcLinkedList_Lock(state->pending)) {
+        state->readerDone = true;
+        parcLinkedList_NotifyAll(state->pending);
+        parcLinkedList_Unlock(state->pending);
+    }
+
+    return NULL;
+}
+
+struct PARCChunkPipeline {
+    _PARCChunkPipelineState *state;
+    PARCThread *reader;
+    bool ownsPool;
+};
+
+static void
+_parcChunkPipeline_DiscardPending(_PARCChunkPipelineState *state)
+{
+    if (parcLinkedList_Lock(state->pending)) {
+        state->cancelled = true;
+        parcLinkedList_NotifyAll(state->pending);
+        parcLinkedList_Unlock(state->pending);
+    }
+
+    // Tasks still in the pool's work queue are skipped once cancelled.
+    // Cancelling a task that a worker is running waits for the worker to finish it.
+    PARCFutureTask *task;
+    do {
+        task = NULL;
+        if (parcLinkedList_Lock(state->pending)) {
+            task = parcLinkedList_RemoveFirst(state->pending);
+            parcLinkedList_Unlock(state->pending);
+        }
+        if (task != NULL) {
+            parcFutureTask_Cancel(task, false);
+            parcFutureTask_Release(&task);
+        }
+    } while (task != NULL);
+}
+
+static bool
+_parcChunkPipeline_Destructor(PARCChunkPipeline **instancePtr)
+{
+    assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCChunkPipeline pointer.");
+    PARCChunkPipeline *pipeline = *instancePtr;
+
+    _parcChunkPipeline_DiscardPending(pipeline->state);
+    parcThread_Join(pipeline->reader);
+    parcThread_Release(&pipeline->reader);
+
+    if (pipeline->ownsPool) {
+        parcThreadPool_ShutdownNow(pipeline->state->pool);
+    }
+
+    _parcChunkPipelineState_Release(&pipeline->state);
+
+    return true;
+}
+
+parcObject_ImplementAcquire(parcChunkPipeline, PARCChunkPipeline);
+
+parcObject_ImplementRelease(parcChunkPipeline, PARCChunkPipeline);
+
+parcObject_Override(PARCChunkPipeline, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcChunkPipeline_Destructor);
+
+void
+parcChunkPipeline_AssertValid(const PARCChunkPipeline *instance)
+{
+    assertTrue(parcChunkPipeline_IsValid(instance),
+               "PARCChunkPipeline is not valid.");
+}
+
+bool
+parcChunkPipeline_IsValid(const PARCChunkPipeline *instance)
+{
+    bool result = false;
+
+    if (instance != NULL) {
+        if (instance->state != NULL && instance->reader != NULL) {
+            result = true;
+        }
+    }
+
+    return result;
+}
+
+static PARCChunkPipeline *
+_parcChunkPipeline_Create(PARCChunker *chunker, PARCCryptoHashType hashType, PARCSigner *signer,
+                          PARCThreadPool *pool, bool ownsPool, size_t depth)
+{
+    assertNotNull(chunker, "The chunker must be non-null");
+    assertTrue(depth > 0, "The depth of the pipeline must be greater than 0");
+    if (signer != NULL) {
+        assertTrue(parcSigner_GetCryptoHashType(signer) == hashType,
+                   "The hash type %s does not match the hash type of the signer %s",
+                   parcCryptoHashType_ToString(hashType), parcCryptoHashType_ToString(parcSigner_GetCryptoHashType(signer)));
+    }
+
+    PARCChunkPipeline *result = parcObject_CreateInstance(PARCChunkPipeline);
+
+    if (result != NULL) {
+        _PARCChunkPipelineState *state = parcObject_CreateInstance(_PARCChunkPipelineState);
+        state->chunker = parcChunker_Acquire(chunker);
+        state->signer = (signer == NULL) ? NULL : parcSigner_Acquire(signer);
+        state->hashType = hashType;
+        state->pool = parcThreadPool_Acquire(pool);
+        state->depth = depth;
+        state->pending = parcLinkedList_Create();
+        state->readerDone = false;
+        state->cancelled = false;
+        state->deliveredCount = 0;
+
+        result->state = state;
+        result->ownsPool = ownsPool;
+        result->reader = parcThread_Create((void *(*)(PARCThread *, PARCObject *)) _parcChunkPipeline_Reader, (PARCObject *) state);
+        parcThread_Start(result->reader);
+    }
+
+    return result;
+}
+
+PARCChunkPipeline *
+parcChunkPipeline_Create(PARCChunker *chunker, PARCCryptoHashType hashType, PARCSigner *signer, size_t workers, size_t depth)
+{
+    assertTrue(workers > 0, "The number of workers must be greater than 0");
+
+    PARCThreadPool *pool = parcThreadPool_Create((int) workers);
+    PARCChunkPipeline *result = _parcChunkPipeline_Create(chunker, hashType, signer, pool, true, depth);
+    parcThreadPool_Release(&pool);
+
+    return result;
+}
+
+PARCChunkPipeline *
+parcChunkPipeline_CreateWithThreadPool(PARCChunker *chunker, PARCCryptoHashType hashType, PARCSigner *signer,
+                                       PARCThreadPool *pool, size_t depth)
+{
+    assertNotNull(pool, "The thread pool must be non-null");
+
+    return _parcChunkPipeline_Create(chunker, hashType, signer, pool, false, depth);
+}
+
+PARCChunkPipelineResult *
+parcChunkPipeline_Next(PARCChunkPipeline *pipeline)
+{
+    parcChunkPipeline_OptionalAssertValid(pipeline);
+
+    _PARCChunkPipelineState *state = pipeline->state;
+
+    PARCFutureTask *task = NULL;
+    if (parcLinkedList_Lock(state->pending)) {
+        while (state->cancelled == false && state->readerDone == false && parcLinkedList_IsEmpty(state->pending)) {
+            parcLinkedList_Wait(state->pending);
+        }
+        if (state->cancelled == false) {
+            task = parcLinkedList_RemoveFirst(state->pending);
+            // Wake the reader which may be waiting for room in the pending list.
+            parcLinkedList_NotifyAll(state->pending);
+        }
+        parcLinkedList_Unlock(state->pending);
+    }
+
+    PARCChunkPipelineResult *result = NULL;
+    if (task != NULL) {
+        PARCFutureTaskResult taskResult = parcFutureTask_Get(task, PARCTimeout_Never);
+        if (taskResult.value != NULL) {
+            result = parcChunkPipelineResult_Acquire(taskResult.value);
+            state->deliveredCount++;
+        }
+        parcFutureTask_Release(&task);
+    }
+
+    return result;
+}
+
+void
+parcChunkPipeline_Cancel(PARCChunkPipeline *pipeline)
+{
+    parcChunkPipeline_OptionalAssertValid(pipeline);
+
+    _parcChunkPipeline_DiscardPending(pipeline->state);
+}
+
+size_t
+parcChunkPipeline_GetDeliveredCount(const PARCChunkPipeline *pipeline)
+{
+    return pipeline->state->deliveredCount;
+}
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_ChunkPipeline.h
+ * @ingroup security
+ * @brief Hash, and optionally sign, the chunks produced by a `PARCChunker` on multiple threads.
+ *
+ * A `PARCChunkPipeline` reads chunks from a `PARCChunker` on a dedicated read-ahead thread,
+ * while a `PARCThreadPool` computes the digest (and the signature, if a `PARCSigner` is given)
+ * of each chunk.
+ * Completed chunks are delivered by `parcChunkPipeline_Next` in the order the chunker produced them.
+ *
+ * The number of chunks that may be read ahead of the consumer is bounded by the depth of the pipeline,
+ * so memory use is proportional to `depth * chunkSize` regardless of the size of the underlying data.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_ChunkPipeline
+#define PARCLibrary_parc_ChunkPipeline
+#include <stdbool.h>
+
+#include <parc/algol/parc_Buffer.h>
+#include <parc/algol/parc_Chunker.h>
+#include <parc/concurrent/parc_ThreadPool.h>
+#include <parc/security/parc_CryptoHash.h>
+#include <parc/security/parc_CryptoHashType.h>
+#include <parc/security/parc_Signature.h>
+#include <parc/security/parc_Signer.h>
+
+struct PARCChunkPipeline;
+typedef struct PARCChunkPipeline PARCChunkPipeline;
+
+struct PARCChunkPipelineResult;
+typedef struct PARCChunkPipelineResult PARCChunkPipelineResult;
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcChunkPipeline_OptionalAssertValid(_instance_)
+#else
+#  define parcChunkPipeline_OptionalAssertValid(_instance_) parcChunkPipeline_AssertValid(_instance_)
+#endif
+
+/**
+ * Create a `PARCChunkPipeline` that processes the chunks of @p chunker with its own pool of worker threads.
+ *
+ * Reading from the chunker begins immediately.
+ * If @p signer is non-NULL each chunk is signed, and @p hashType must be the hash type of the signer.
+ *
+ * @param [in] chunker A pointer to a valid `PARCChunker` whose forward iterator has not been used.
+ * @param [in] hashType The `PARCCryptoHashType` used to compute the digest of each chunk.
+ * @param [in] signer A pointer to a valid `PARCSigner`, or NULL to only compute digests.
+ * @param [in] workers The number of worker threads to hash and sign chunks.
+ * @param [in] depth The maximum number of chunks read ahead of the consumer.
+ *
+ * @return non-NULL A pointer to a valid `PARCChunkPipeline` instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBufferChunker *bufferChunker = parcBufferChunker_Create(data, 4096);
+ *     PARCChunker *chunker = parcChunker_Create(bufferChunker, PARCBufferChunkerAsChunker);
+ *
+ *     PARCChunkPipeline *pipeline = parcChunkPipeline_Create(chunker, PARCCryptoHashType_SHA256, NULL, 4, 16);
+ *
+ *     PARCChunkPipelineResult *result;
+ *     while ((result = parcChunkPipeline_Next(pipeline)) != NULL) {
+ *         PARCCryptoHash *digest = parcChunkPipelineResult_GetDigest(result);
+ *         ...
+ *         parcChunkPipelineResult_Release(&result);
+ *     }
+ *
+ *     parcChunkPipeline_Release(&pipeline);
+ *     parcChunker_Release(&chunker);
+ *     parcBufferChunker_Release(&bufferChunker);
+ * }
+ * @endcode
+ */
+PARCChunkPipeline *parcChunkPipeline_Create(PARCChunker *chunker, PARCCryptoHashType hashType, PARCSigner *signer, size_t workers, size_t depth);
+
+/**
+ * Create a `PARCChunkPipeline` that processes the chunks of @p chunker on the given `PARCThreadPool`.
+ *
+ * The pool may be shared with other pipelines or other work.
+ * The pipeline does not shut the pool down when it is released.
+ *
+ * @param [in] chunker A pointer to a valid `PARCChunker` whose forward iterator has not been used.
+ * @param [in] hashType The `PARCCryptoHashType` used to compute the digest of each chunk.
+ * @param [in] signer A pointer to a valid `PARCSigner`, or NULL to only compute digests.
+ * @param [in] pool A pointer to a valid, running `PARCThreadPool`.
+ * @param [in] depth The maximum number of chunks read ahead of the consumer.
+ *
+ * @return non-NULL A pointer to a valid `PARCChunkPipeline` instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCThreadPool *pool = parcThreadPool_Create(4);
+ *
+ *     PARCChunkPipeline *pipeline = parcChunkPipeline_CreateWithThreadPool(chunker, PARCCryptoHashType_SHA256, signer, pool, 16);
+ *     ...
+ *     parcChunkPipeline_Release(&pipeline);
+ *
+ *     parcThreadPool_ShutdownNow(pool);
+ *     parcThreadPool_Release(&pool);
+ * }
+ * @endcode
+ */
+PARCChunkPipeline *parcChunkPipeline_CreateWithThreadPool(PARCChunker *chunker, PARCCryptoHashType hashType, PARCSigner *signer,
+                                                          PARCThreadPool *pool, size_t depth);
+
+/**
+ * Increase the number of references to a `PARCChunkPipeline` instance.
+ *
+ * @param [in] instance A pointer to a valid `PARCChunkPipeline` instance.
+ *
+ * @return The same value as @p instance.
+ */
+PARCChunkPipeline *parcChunkPipeline_Acquire(const PARCChunkPipeline *instance);
+
+/**
+ * Release a previously acquired reference to the given `PARCChunkPipeline` instance,
+ * decrementing the reference count for the instance.
+ *
+ * When the last reference is released the read-ahead thread is stopped,
+ * any chunks not yet delivered are discarded,
+ * and a pool created by `parcChunkPipeline_Create` is shut down.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ */
+void parcChunkPipeline_Release(PARCChunkPipeline **instancePtr);
+
+/**
+ * Assert that the given `PARCChunkPipeline` instance is valid.
+ *
+ * @param [in] instance A pointer to a valid `PARCChunkPipeline` instance.
+ */
+void parcChunkPipeline_AssertValid(const PARCChunkPipeline *instance);
+
+/**
+ * Determine if an instance of `PARCChunkPipeline` is valid.
+ *
+ * @param [in] instance A pointer to a `PARCChunkPipeline` instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ */
+bool parcChunkPipeline_IsValid(const PARCChunkPipeline *instance);
+
+/**
+ * Get the next processed chunk, in chunk order.
+ *
+ * The caller blocks until the digest (and signature) of the next chunk is available.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ *
+ * @return non-NULL A `PARCChunkPipelineResult` that must be released via `parcChunkPipelineResult_Release`.
+ * @return NULL All of the chunks have been delivered, or the pipeline was cancelled.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCChunkPipelineResult *result;
+ *     while ((result = parcChunkPipeline_Next(pipeline)) != NULL) {
+ *         parcChunkPipelineResult_Release(&result);
+ *     }
+ * }
+ * @endcode
+ */
+PARCChunkPipelineResult *parcChunkPipeline_Next(PARCChunkPipeline *pipeline);
+
+/**
+ * Stop reading chunks and discard any chunks that have not been delivered.
+ *
+ * Subsequent calls to `parcChunkPipeline_Next` return NULL.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ */
+void parcChunkPipeline_Cancel(PARCChunkPipeline *pipeline);
+
+/**
+ * Get the number of chunks delivered by `parcChunkPipeline_Next` so far.
+ *
+ * @param [in] pipeline A pointer to a valid `PARCChunkPipeline` instance.
+ *
+ * @return The number of chunks delivered.
+ */
+size_t parcChunkPipeline_GetDeliveredCount(const PARCChunkPipeline *pipeline);
+
+/**
+ * Increase the number of references to a `PARCChunkPipelineResult` instance.
+ *
+ * @param [in] result A pointer to a valid `PARCChunkPipelineResult` instance.
+ *
+ * @return The same value as @p result.
+ */
+PARCChunkPipelineResult *parcChunkPipelineResult_Acquire(const PARCChunkPipelineResult *result);
+
+/**
+ * Release a previously acquired reference to the given `PARCChunkPipelineResult` instance.
+ *
+ * @param [in,out] resultPtr A pointer to a pointer to the instance to release.
+ */
+void parcChunkPipelineResult_Release(PARCChunkPipelineResult **resultPtr);
+
+/**
+ * Get the zero-based index of the chunk in the order produced by the chunker.
+ *
+ * @param [in] result A pointer to a valid `PARCChunkPipelineResult` instance.
+ *
+ * @return The index of the chunk.
+ */
+size_t parcChunkPipelineResult_GetChunkNumber(const PARCChunkPipelineResult *result);
+
+/**
+ * Get the chunk itself.
+ *
+ * The returned value is not acquired; acquire it to keep it beyond the lifetime of @p result.
+ *
+ * @param [in] result A pointer to a valid `PARCChunkPipelineResult` instance.
+ *
+ * @return A pointer to the `PARCBuffer` containing the chunk.
+ */
+PARCBuffer *parcChunkPipelineResult_GetChunk(const PARCChunkPipelineResult *result);
+
+/**
+ * Get the digest of the chunk.
+ *
+ * The returned value is not acquired; acquire it to keep it beyond the lifetime of @p result.
+ *
+ * @param [in] result A pointer to a valid `PARCChunkPipelineResult` instance.
+ *
+ * @return A pointer to the `PARCCryptoHash` of the chunk.
+ */
+PARCCryptoHash *parcChunkPipelineResult_GetDigest(const PARCChunkPipelineResult *result);
+
+/**
+ * Get the signature of the chunk.
+ *
+ * The returned value is not acquired; acquire it to keep it beyond the lifetime of @p result.
+ *
+ * @param [in] result A pointer to a valid `PARCChunkPipelineResult` instance.
+ *
+ * @return non-NULL A pointer to the `PARCSignature` of the chunk's digest.
+ * @return NULL The pipeline was created without a `PARCSigner`.
+ */
+PARCSignature *parcChunkPipelineResult_GetSignature(const PARCChunkPipelineResult *result);
+#endif
@@ -76,6 +76,7 @@
 #include <config.h>
 #include <stdio.h>
 #include <string.h>
+#include <pthread.h>
 
 #include <LongBow/runtime.h>
 
@@ -83,8 +84,68 @@
 #include <parc/security/parc_CryptoCache.h>
 #include <parc/algol/parc_HashCodeTable.h>
 
+#include <openssl/x509.h>
+
+#define _CACHE_LINE 64
+#define _COUNTER_CELLS 16
+
+#if OPENSSL_VERSION_NUMBER < 0x10100000L
+#  define EVP_PKEY_up_ref(_pkey_) CRYPTO_add(&(_pkey_)->references, 1, CRYPTO_LOCK_EVP_PKEY)
+#endif
+
+/*
+ * Each key is stored with its public key decoded from DER,
+ * so verifying a signature does not decode the key again.
+ * The decoded key is only read after it is added, so it may be used by several threads at once.
+ */
+typedef struct parc_crypto_cache_entry {
+    PARCKey *key;
+    EVP_PKEY *decodedPublicKey;
+
+    // The entry's slot in its shard's clock, and whether it was used since the clock hand last passed it.
+    // Lookups under the shared lock set referenced concurrently, so it is only accessed atomically.
+    size_t slot;
+    bool referenced;
+} _PARCCryptoCacheEntry;
+
+/*
+ * The keys whose hash selects this shard.
+ * Lookups take the lock shared, so they only wait for a concurrent add or remove to the same shard.
+ * A lookup marks its entry as referenced, which needs no exclusive lock,
+ * and the CLOCK sweep run by an add to a full shard evicts the first entry that is not referenced.
+ */
+typedef struct parc_crypto_cache_shard {
+    pthread_rwlock_t lock;
+    PARCHashCodeTable *table;
+
+    _PARCCryptoCacheEntry **clock;
+    size_t capacity;
+    size_t count;
+    size_t hand;
+
+    uint64_t evictionCount;
+} _PARCCryptoCacheShard;
+
+/*
+ * Lookup counts, one cell per thread so that concurrent lookups do not share a cache line.
+ * Threads beyond the number of cells share them.
+ */
+typedef union {
+    struct {
+        uint64_t hitCount;
+        uint64_t missCount;
+    };
+    char pad[_CACHE_LINE];
+} _PARCCryptoCacheCounterCell;
+
 struct parc_crypto_cache {
-    PARCHashCodeTable *keyid_table;
+    size_t shardCount;
+    _PARCCryptoCacheShard *shards;
+
+    _PARCCryptoCacheCounterCell counters[_COUNTER_CELLS];
+
+    PARCCryptoCacheEvictionCallback *evictionCallback;
+    void *evictionContext;
 };
 
 // =====================================================================
@@ -99,25 +160,177 @@ _keyidEquals(const void *ptrA, const void *ptrB)
 static void
 _dataDestroy(void **voidPtr)
 {
-    PARCKey **keyPtr = (PARCKey **) voidPtr;
-    parcKey_Release(keyPtr);
+    _PARCCryptoCacheEntry *entry = *voidPtr;
+    parcKey_Release(&entry->key);
+    if (entry->decodedPublicKey != NULL) {
+        EVP_PKEY_free(entry->decodedPublicKey);
+    }
+    parcMemory_Deallocate(voidPtr);
+}
+
+static EVP_PKEY *
+_decodePublicKey(const PARCKey *key)
+{
+    EVP_PKEY *result = NULL;
+
+    switch (parcKey_GetSigningAlgorithm(key)) {
+        case PARCSigningAlgorithm_RSA:
+        case PARCSigningAlgorithm_DSA: {
+            PARCBuffer *derEncodedKey = parcKey_GetKey(key);
+            long length = (long) parcBuffer_Remaining(derEncodedKey);
+            if (length > 0) {
+                const uint8_t *bytes = parcByteArray_Array(parcBuffer_Array(derEncodedKey)) + parcBuffer_ArrayOffset(derEncodedKey) + parcBuffer_Position(derEncodedKey);
+                result = d2i_PUBKEY(NULL, &bytes, length);
+            }
+            break;
+        }
+
+        default:
+            // Symmetric keys have nothing to decode.
+            break;
+    }
+
+    return result;
 }
 
+static unsigned _parcCryptoCache_NextThreadIndex;
+
+static __thread unsigned _parcCryptoCache_ThreadIndex;
+
 // =====================================================================
 
+static _PARCCryptoCacheShard *
+_parcCryptoCache_GetShard(const PARCCryptoCache *cache, const PARCKeyId *keyid)
+{
+    // The shard is chosen from the high bits of the hash, the bucket within the shard's table from the low bits.
+    uint64_t hash = (uint64_t) parcKeyId_HashCode(keyid);
+    hash = (hash ^ (hash >> 31)) * 0x9E3779B97F4A7C15ULL;
+
+    return &cache->shards[(hash >> 32) % cache->shardCount];
+}
+
+/*
+ * Find the entry for the given keyid, counting the lookup as a hit or a miss.
+ * The caller must hold the shard's lock.
+ */
+static _PARCCryptoCacheEntry *
+_parcCryptoCache_Lookup(PARCCryptoCache *cache, _PARCCryptoCacheShard *shard, const PARCKeyId *keyid)
+{
+    _PARCCryptoCacheEntry *entry = parcHashCodeTable_Get(shard->table, keyid);
+
+    if (_parcCryptoCache_ThreadIndex == 0) {
+        _parcCryptoCache_ThreadIndex = __sync_add_and_fetch(&_parcCryptoCache_NextThreadIndex, 1);
+    }
+    _PARCCryptoCacheCounterCell *cell = &cache->counters[_parcCryptoCache_ThreadIndex % _COUNTER_CELLS];
+
+    if (entry != NULL) {
+        if (__atomic_load_n(&entry->referenced, __ATOMIC_RELAXED) == false) {
+            __atomic_store_n(&entry->referenced, true, __ATOMIC_RELAXED);
+        }
+        __atomic_fetch_add(&cell->hitCount, 1, __ATOMIC_RELAXED);
+    } else {
+        __atomic_fetch_add(&cell->missCount, 1, __ATOMIC_RELAXED);
+    }
+
+    return entry;
+}
+
+/*
+ * Advance the clock hand to the first entry not referenced since the hand last passed it,
+ * clearing the reference of each entry it passes, and evict that entry.
+ * The caller must hold the shard's lock exclusively.
+ *
+ * If the cache has an eviction callback, return a new reference to the evicted key
+ * so the caller can call it once the lock is released, otherwise return NULL.
+ */
+static PARCKey *
+_parcCryptoCacheShard_Evict(PARCCryptoCache *cache, _PARCCryptoCacheShard *shard)
+{
+    for (;;) {
+        _PARCCryptoCacheEntry *entry = shard->clock[shard->hand];
+        if (entry != NULL) {
+            if (__atomic_load_n(&entry->referenced, __ATOMIC_RELAXED)) {
+                __atomic_store_n(&entry->referenced, false, __ATOMIC_RELAXED);
+            } else {
+                PARCKey *result = NULL;
+                if (cache->evictionCallback != NULL) {
+                    result = parcKey_Acquire(entry->key);
+                }
+                shard->clock[shard->hand] = NULL;
+                shard->count--;
+                shard->evictionCount++;
+                parcHashCodeTable_Del(shard->table, parcKey_GetKeyId(entry->key));
+                return result;
+            }
+        }
+        shard->hand = (shard->hand + 1) % shard->capacity;
+    }
+}
+
+/*
+ * Returns the key evicted to make room for the entry, as for `_parcCryptoCacheShard_Evict`.
+ */
+static PARCKey *
+_parcCryptoCacheShard_Insert(PARCCryptoCache *cache, _PARCCryptoCacheShard *shard, _PARCCryptoCacheEntry *entry)
+{
+    PARCKey *evicted = NULL;
+    if (shard->capacity > 0) {
+        if (shard->count == shard->capacity) {
+            evicted = _parcCryptoCacheShard_Evict(cache, shard);
+        }
+        while (shard->clock[shard->hand] != NULL) {
+            shard->hand = (shard->hand + 1) % shard->capacity;
+        }
+        entry->slot = shard->hand;
+        shard->clock[shard->hand] = entry;
+        shard->hand = (shard->hand + 1) % shard->capacity;
+    }
+    shard->count++;
+
+    return evicted;
+}
+
 PARCCryptoCache *
-parcCryptoCache_Create()
+parcCryptoCache_CreateSharded(size_t shardCount, size_t capacity, PARCCryptoCacheEvictionCallback *evictionCallback, void *context)
 {
+    assertTrue(shardCount > 0, "Parameter shardCount must be greater than 0");
+
     PARCCryptoCache *cache = parcMemory_AllocateAndClear(sizeof(PARCCryptoCache));
     assertNotNull(cache, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(PARCCryptoCache));
 
-    // KeyIdDestroyer is NULL because we get the keyid out of the key, and it will be destroyed
-    // when the key is destroyed.
-    cache->keyid_table = parcHashCodeTable_Create(_keyidEquals, parcKeyId_HashCodeFromVoid, NULL, _dataDestroy);
+    cache->shardCount = shardCount;
+    cache->shards = parcMemory_AllocateAndClear(shardCount * sizeof(_PARCCryptoCacheShard));
+    assertNotNull(cache->shards, "parcMemory_AllocateAndClear(%zu) returned NULL", shardCount * sizeof(_PARCCryptoCacheShard));
+    cache->evictionCallback = evictionCallback;
+    cache->evictionContext = context;
+
+    // The capacity is shared evenly, so a bounded cache may hold up to shardCount - 1 more keys than asked for.
+    size_t shardCapacity = (capacity + shardCount - 1) / shardCount;
+
+    for (size_t i = 0; i < shardCount; i++) {
+        _PARCCryptoCacheShard *shard = &cache->shards[i];
+        pthread_rwlock_init(&shard->lock, NULL);
+
+        // KeyIdDestroyer is NULL because we get the keyid out of the key, and it will be destroyed
+        // when the key is destroyed.
+        shard->table = parcHashCodeTable_Create(_keyidEquals, parcKeyId_HashCodeFromVoid, NULL, _dataDestroy);
+
+        shard->capacity = shardCapacity;
+        if (shardCapacity > 0) {
+            shard->clock = parcMemory_AllocateAndClear(shardCapacity * sizeof(_PARCCryptoCacheEntry *));
+            assertNotNull(shard->clock, "parcMemory_AllocateAndClear(%zu) returned NULL", shardCapacity * sizeof(_PARCCryptoCacheEntry *));
+        }
+    }
 
     return cache;
 }
 
+PARCCryptoCache *
+parcCryptoCache_Create()
+{
+    return parcCryptoCache_CreateSharded(1, 0, NULL, NULL);
+}
+
 /**
  * Destroys the cache and all internal buffers.
  *
@@ -133,7 +346,15 @@ parcCryptoCache_Destroy(PARCCryptoCache **cryptoCachePtr)
     assertNotNull(*cryptoCachePtr, "Parameter must dereference to non-null pointer");
 
     PARCCryptoCache *cache = *cryptoCachePtr;
-    parcHashCodeTable_Destroy(&cache->keyid_table);
+    for (size_t i = 0; i < cache->shardCount; i++) {
+        _PARCCryptoCacheShard *shard = &cache->shards[i];
+        parcHashCodeTable_Destroy(&shard->table);
+        if (shard->clock != NULL) {
+            parcMemory_Deallocate((void **) &shard->clock);
+        }
+        pthread_rwlock_destroy(&shard->lock);
+    }
+    parcMemory_Deallocate((void **) &cache->shards);
     parcMemory_Deallocate((void **) cryptoCachePtr);
     *cryptoCachePtr = NULL;
 }
@@ -155,10 +376,37 @@ parcCryptoCache_AddKey(PARCCryptoCache *cache, PARCKey *original_key)
     assertNotNull(cache, "Parameter cache must be non-null");
     assertNotNull(original_key, "Parameter key must be non-null");
 
-    PARCKey *key = parcKey_Copy(original_key);
-    PARCKeyId *keyid = parcKey_GetKeyId(key);
+    _PARCCryptoCacheEntry *entry = parcMemory_AllocateAndClear(sizeof(_PARCCryptoCacheEntry));
+    assertNotNull(entry, "parcMemory_AllocateAndClear(%zu) returned NULL", sizeof(_PARCCryptoCacheEntry));
+
+    // Copy and decode outside the lock.
+    entry->key = parcKey_Copy(original_key);
+    entry->decodedPublicKey = _decodePublicKey(entry->key);
+    PARCKeyId *keyid = parcKey_GetKeyId(entry->key);
+
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    PARCKey *evicted = NULL;
+    pthread_rwlock_wrlock(&shard->lock);
+    bool result = false;
+    if (parcHashCodeTable_Get(shard->table, keyid) == NULL) {
+        result = parcHashCodeTable_Add(shard->table, keyid, entry);
+        if (result) {
+            evicted = _parcCryptoCacheShard_Insert(cache, shard, entry);
+        }
+    }
+    pthread_rwlock_unlock(&shard->lock);
 
-    return parcHashCodeTable_Add(cache->keyid_table, keyid, key);
+    if (evicted != NULL) {
+        cache->evictionCallback(evicted, cache->evictionContext);
+        parcKey_Release(&evicted);
+    }
+
+    if (result == false) {
+        _dataDestroy((void **) &entry);
+    }
+
+    return result;
 }
 
 /**
@@ -177,7 +425,104 @@ parcCryptoCache_GetKey(PARCCryptoCache *cache, const PARCKeyId *keyid)
     assertNotNull(cache, "Parameter cache must be non-null");
     assertNotNull(keyid, "Parameter keyid must be non-null");
 
-    return parcHashCodeTable_Get(cache->keyid_table, keyid);
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    pthread_rwlock_rdlock(&shard->lock);
+    const _PARCCryptoCacheEntry *entry = _parcCryptoCache_Lookup(cache, shard, keyid);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return (entry == NULL) ? NULL : entry->key;
+}
+
+PARCKey *
+parcCryptoCache_AcquireKey(PARCCryptoCache *cache, const PARCKeyId *keyid)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+    assertNotNull(keyid, "Parameter keyid must be non-null");
+
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    PARCKey *result = NULL;
+    pthread_rwlock_rdlock(&shard->lock);
+    const _PARCCryptoCacheEntry *entry = _parcCryptoCache_Lookup(cache, shard, keyid);
+    if (entry != NULL) {
+        result = parcKey_Acquire(entry->key);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return result;
+}
+
+void *
+parcCryptoCache_GetDecodedPublicKey(PARCCryptoCache *cache, const PARCKeyId *keyid)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+    assertNotNull(keyid, "Parameter keyid must be non-null");
+
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    pthread_rwlock_rdlock(&shard->lock);
+    const _PARCCryptoCacheEntry *entry = _parcCryptoCache_Lookup(cache, shard, keyid);
+    pthread_rwlock_unlock(&shard->lock);
+
+    return (entry == NULL) ? NULL : entry->decodedPublicKey;
+}
+
+void *
+parcCryptoCache_AcquireDecodedPublicKey(PARCCryptoCache *cache, const PARCKeyId *keyid)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+    assertNotNull(keyid, "Parameter keyid must be non-null");
+
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    EVP_PKEY *result = NULL;
+    pthread_rwlock_rdlock(&shard->lock);
+    const _PARCCryptoCacheEntry *entry = _parcCryptoCache_Lookup(cache, shard, keyid);
+    if (entry != NULL && entry->decodedPublicKey != NULL) {
+        result = entry->decodedPublicKey;
+        EVP_PKEY_up_ref(result);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    return result;
+}
+
+PARCKey *
+parcCryptoCache_AcquireKeyAndDecodedPublicKey(PARCCryptoCache *cache, const PARCKeyId *keyid, void **decodedPublicKeyPtr)
+{
+    assertNotNull(cache, "Parameter cache must be non-null");
+    assertNotNull(keyid, "Parameter keyid must be non-null");
+    assertNotNull(decodedPublicKeyPtr, "Parameter decodedPublicKeyPtr must be non-null");
+
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    PARCKey *result = NULL;
+    EVP_PKEY *decodedPublicKey = NULL;
+    pthread_rwlock_rdlock(&shard->lock);
+    const _PARCCryptoCacheEntry *entry = _parcCryptoCache_Lookup(cache, shard, keyid);
+    if (entry != NULL) {
+        result = parcKey_Acquire(entry->key);
+        if (entry->decodedPublicKey != NULL) {
+            decodedPublicKey = entry->decodedPublicKey;
+            EVP_PKEY_up_ref(decodedPublicKey);
+        }
+    }
+    pthread_rwlock_unlock(&shard->lock);
+
+    *decodedPublicKeyPtr = decodedPublicKey;
+    return result;
+}
+
+void
+parcCryptoCache_ReleaseDecodedPublicKey(void **decodedPublicKeyPtr)
+{
+    assertNotNull(decodedPublicKeyPtr, "Parameter must be non-null double pointer");
+
+    if (*decodedPublicKeyPtr != NULL) {
+        EVP_PKEY_free(*decodedPublicKeyPtr);
+        *decodedPublicKeyPtr = NULL;
+    }
 }
 
 /**
@@ -194,5 +539,56 @@ parcCryptoCache_RemoveKey(PARCCryptoCache *cache, const PARCKeyId *keyid)
     assertNotNull(cache, "Parameter cache must be non-null");
     assertNotNull(keyid, "Parameter keyid must be non-null");
 
-    parcHashCodeTable_Del(cache->keyid_table, keyid);
+    _PARCCryptoCacheShard *shard = _parcCryptoCache_GetShard(cache, keyid);
+
+    pthread_rwlock_wrlock(&shard->lock);
+    _PARCCryptoCacheEntry *entry = parcHashCodeTable_Get(shard->table, keyid);
+    if (entry != NULL) {
+        if (shard->capacity > 0) {
+            shard->clock[entry->slot] = NULL;
+        }
+        shard->count--;
+        parcHashCodeTable_Del(shard->table, keyid);
+    }
+    pthread_rwlock_unlock(&shard->lock);
+}
+
+size_t
+parcCryptoCache_Size(const PARCCryptoCache *cache)
+{
+    size_t result = 0;
+    for (size_t i = 0; i < cache->shardCount; i++) {
+        result += __atomic_load_n(&cache->shards[i].count, __ATOMIC_RELAXED);
+    }
+    return result;
+}
+
+uint64_t
+parcCryptoCache_GetHitCount(const PARCCryptoCache *cache)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < _COUNTER_CELLS; i++) {
+        result += __atomic_load_n(&cache->counters[i].hitCount, __ATOMIC_RELAXED);
+    }
+    return result;
+}
+
+uint64_t
+parcCryptoCache_GetMissCount(const PARCCryptoCache *cache)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < _COUNTER_CELLS; i++) {
+        result += __atomic_load_n(&cache->counters[i].missCount, __ATOMIC_RELAXED);
+    }
+    return result;
+}
+
+uint64_t
+parcCryptoCache_GetEvictionCount(const PARCCryptoCache *cache)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < cache->shardCount; i++) {
+        result += __atomic_load_n(&cache->shards[i].evictionCount, __ATOMIC_RELAXED);
+    }
+    return result;
 }
@@ -60,6 +60,12 @@
  * Not sure how to differentiate between keys and certs at the moment.  The current API
  * is thus built around keys.
  *
+ * The cache may be shared by several threads.
+ * Keys are spread over a number of shards, each with its own read-write lock,
+ * so lookups only wait for an add or remove of a key in the same shard.
+ * A cache may be bounded, in which case adding a key to a full shard evicts a key
+ * that has not been looked up recently (the CLOCK approximation of least-recently-used).
+ *
  * @author Marc Mosko, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2014, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
  */
@@ -71,8 +77,50 @@
 struct parc_crypto_cache;
 typedef struct parc_crypto_cache PARCCryptoCache;
 
+/**
+ * A function called with each key evicted from a bounded `PARCCryptoCache`, before the cache releases it.
+ *
+ * The function is called by the thread whose add caused the eviction, after the key has left the cache
+ * and the cache's lock has been released, so it may use the cache.
+ *
+ * @param [in] key The evicted key. Acquire it to keep it.
+ * @param [in] context The context given to `parcCryptoCache_CreateSharded`.
+ */
+typedef void (PARCCryptoCacheEvictionCallback)(const PARCKey *key, void *context);
+
+/**
+ * Create an unbounded `PARCCryptoCache` with a single shard.
+ *
+ * @return A pointer to a `PARCCryptoCache` that must be destroyed via `parcCryptoCache_Destroy`.
+ */
 PARCCryptoCache *parcCryptoCache_Create(void);
 
+/**
+ * Create a `PARCCryptoCache` that spreads its keys over @p shardCount shards
+ * and holds at most about @p capacity keys.
+ *
+ * Threads that look up keys in different shards never contend.
+ * The capacity is divided evenly between the shards, rounding up.
+ *
+ * @param [in] shardCount The number of shards, greater than zero.
+ * @param [in] capacity The maximum number of keys, or 0 for no limit.
+ * @param [in] evictionCallback A function called with each evicted key, or NULL.
+ * @param [in] context A value passed to @p evictionCallback.
+ *
+ * @return A pointer to a `PARCCryptoCache` that must be destroyed via `parcCryptoCache_Destroy`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCCryptoCache *cache = parcCryptoCache_CreateSharded(16, 4096, NULL, NULL);
+ *     // share the cache with verifier threads
+ *     parcCryptoCache_Destroy(&cache);
+ * }
+ * @endcode
+ */
+PARCCryptoCache *parcCryptoCache_CreateSharded(size_t shardCount, size_t capacity,
+                                               PARCCryptoCacheEvictionCallback *evictionCallback, void *context);
+
 /**
  * Destroys the cache and all internal buffers.
  *
@@ -112,6 +160,8 @@ bool parcCryptoCache_AddKey(PARCCryptoCache *cache, PARCKey *key);
  * Fetches the Key.  The user must not modify or destroy the key.
  *
  * Returns NULL if the keyid is not found.
+ * The key is only valid until it is removed or evicted from the cache.
+ * Use `parcCryptoCache_AcquireKey` when other threads may do either.
  *
  * @param [in] cache A pointer to a PARCCryptoCache instance.
  * Example:
@@ -121,6 +171,110 @@ bool parcCryptoCache_AddKey(PARCCryptoCache *cache, PARCKey *key);
  */
 const PARCKey *parcCryptoCache_GetKey(PARCCryptoCache *cache, const PARCKeyId *keyid);
 
+/**
+ * Fetches a new reference to the Key.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ * @param [in] keyid A pointer to the `PARCKeyId` of the key.
+ *
+ * @return NULL The keyid is not found.
+ * @return non-NULL A `PARCKey` that must be released via `parcKey_Release`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCKey *key = parcCryptoCache_AcquireKey(cache, keyid);
+ *     if (key != NULL) {
+ *         ...
+ *         parcKey_Release(&key);
+ *     }
+ * }
+ * @endcode
+ */
+PARCKey *parcCryptoCache_AcquireKey(PARCCryptoCache *cache, const PARCKeyId *keyid);
+
+/**
+ * Fetches the public key of the given keyid, decoded for use by the crypto library (an OpenSSL `EVP_PKEY`).
+ *
+ * The key is decoded once, when it is added to the cache.
+ * The user must not modify or free the decoded key,
+ * but it may be used concurrently by several threads while the key remains in the cache.
+ *
+ * Returns NULL if the keyid is not found, or the key is not a public key that could be decoded.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ * @param [in] keyid A pointer to the `PARCKeyId` of the key.
+ *
+ * Example:
+ * @code
+ * {
+ *     EVP_PKEY *publicKey = parcCryptoCache_GetDecodedPublicKey(cache, keyid);
+ *     if (publicKey != NULL) {
+ *         EVP_PKEY_CTX *context = EVP_PKEY_CTX_new(publicKey, NULL);
+ *         ...
+ *     }
+ * }
+ * @endcode
+ */
+void *parcCryptoCache_GetDecodedPublicKey(PARCCryptoCache *cache, const PARCKeyId *keyid);
+
+/**
+ * Fetches a new reference to the decoded public key of the given keyid.
+ *
+ * Unlike `parcCryptoCache_GetDecodedPublicKey`, the key remains valid if it is removed or evicted from the cache.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ * @param [in] keyid A pointer to the `PARCKeyId` of the key.
+ *
+ * @return NULL The keyid is not found, or the key is not a public key that could be decoded.
+ * @return non-NULL An OpenSSL `EVP_PKEY` that must be released via `parcCryptoCache_ReleaseDecodedPublicKey`.
+ *
+ * Example:
+ * @code
+ * {
+ *     EVP_PKEY *publicKey = parcCryptoCache_AcquireDecodedPublicKey(cache, keyid);
+ *     if (publicKey != NULL) {
+ *         ...
+ *         parcCryptoCache_ReleaseDecodedPublicKey((void **) &publicKey);
+ *     }
+ * }
+ * @endcode
+ */
+void *parcCryptoCache_AcquireDecodedPublicKey(PARCCryptoCache *cache, const PARCKeyId *keyid);
+
+/**
+ * Fetches new references to both the Key and its decoded public key with a single lookup.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ * @param [in] keyid A pointer to the `PARCKeyId` of the key.
+ * @param [out] decodedPublicKeyPtr Set to the decoded public key, which must be released via
+ *              `parcCryptoCache_ReleaseDecodedPublicKey`, or to NULL if there is none.
+ *
+ * @return NULL The keyid is not found.
+ * @return non-NULL A `PARCKey` that must be released via `parcKey_Release`.
+ *
+ * Example:
+ * @code
+ * {
+ *     EVP_PKEY *publicKey;
+ *     PARCKey *key = parcCryptoCache_AcquireKeyAndDecodedPublicKey(cache, keyid, (void **) &publicKey);
+ *     if (key != NULL) {
+ *         ...
+ *         parcCryptoCache_ReleaseDecodedPublicKey((void **) &publicKey);
+ *         parcKey_Release(&key);
+ *     }
+ * }
+ * @endcode
+ */
+PARCKey *parcCryptoCache_AcquireKeyAndDecodedPublicKey(PARCCryptoCache *cache, const PARCKeyId *keyid, void **decodedPublicKeyPtr);
+
+/**
+ * Release a decoded public key returned by `parcCryptoCache_AcquireDecodedPublicKey`, and set the pointer to NULL.
+ *
+ * @param [in,out] decodedPublicKeyPtr A pointer to the decoded key, which may be NULL.
+ */
+void parcCryptoCache_ReleaseDecodedPublicKey(void **decodedPublicKeyPtr);
+
 /**
  * Removes the keyid and key.  The internal buffers are destroyed.
  *
@@ -132,4 +286,42 @@ const PARCKey *parcCryptoCache_GetKey(PARCCryptoCache *cache, const PARCKeyId *k
  * @endcode
  */
 void parcCryptoCache_RemoveKey(PARCCryptoCache *cache, const PARCKeyId *keyid);
+
+/**
+ * Return the number of keys in the cache.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ *
+ * @return The number of keys in the cache.
+ */
+size_t parcCryptoCache_Size(const PARCCryptoCache *cache);
+
+/**
+ * Return the number of lookups that found their key.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ *
+ * @return The number of lookups that found their key since the cache was created.
+ */
+uint64_t parcCryptoCache_GetHitCount(const PARCCryptoCache *cache);
+
+/**
+ * Return the number of lookups that did not find their key.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ *
+ * @return The number of lookups that did not find their key since the cache was created.
+ */
+uint64_t parcCryptoCache_GetMissCount(const PARCCryptoCache *cache);
+
+/**
+ * Return the number of keys evicted to keep a bounded cache within its capacity.
+ *
+ * Keys removed with `parcCryptoCache_RemoveKey` are not counted.
+ *
+ * @param [in] cache A pointer to a PARCCryptoCache instance.
+ *
+ * @return The number of keys evicted since the cache was created.
+ */
+uint64_t parcCryptoCache_GetEvictionCount(const PARCCryptoCache *cache);
 #endif // libparc_parc_CryptoCache_h
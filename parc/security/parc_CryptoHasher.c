@@ -67,12 +67,14 @@
 
 #include <config.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <parc/security/parc_CryptoHasher.h>
 #include <parc/algol/parc_Buffer.h>
 #include <parc/algol/parc_Memory.h>
 #include <LongBow/runtime.h>
 #include <parc/algol/parc_Object.h>
+#include <parc/developer/parc_Trace.h>
 
 #ifdef __APPLE__
 #include <CommonCrypto/CommonDigest.h>
@@ -569,3 +571,315 @@ _crc32_destroy(void **ctxPtr)
     parcMemory_Deallocate((void **) &state);
     *ctxPtr = NULL;
 }
+
+// ==================================================
+// SHA256 multi-buffer implementation
+//
+// Computes the SHA256 digests of up to eight independent messages at once,
+// one message per 32-bit lane of an AVX2 register.
+// Each lane is padded independently and lanes whose message has no more blocks are masked off,
+// so the messages need not be the same length.
+// It is only used on CPUs that have AVX2 but not the SHA extensions (SHA-NI),
+// because OpenSSL's single-buffer SHA-NI code is faster than eight AVX2 lanes.
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+
+#define PARCCryptoHasher_SHA256_LANES 8
+
+typedef uint32_t _SHA256Lanes __attribute__((vector_size(PARCCryptoHasher_SHA256_LANES * sizeof(uint32_t))));
+
+static const uint32_t _sha256_K[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static const uint32_t _sha256_H0[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+#define _SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+/*
+ * One SHA256 compression of a block in every lane.
+ * Lanes whose element of `active` is zero keep their previous state.
+ */
+__attribute__((target("avx2"), always_inline))
+static inline void
+_sha256_CompressLanes(_SHA256Lanes state[8], _SHA256Lanes w[16], _SHA256Lanes active)
+{
+    _SHA256Lanes a = state[0];
+    _SHA256Lanes b = state[1];
+    _SHA256Lanes c = state[2];
+    _SHA256Lanes d = state[3];
+    _SHA256Lanes e = state[4];
+    _SHA256Lanes f = state[5];
+    _SHA256Lanes g = state[6];
+    _SHA256Lanes h = state[7];
+
+    for (int t = 0; t < 64; t++) {
+        _SHA256Lanes wt;
+        if (t < 16) {
+            wt = w[t];
+        } else {
+            _SHA256Lanes w15 = w[(t - 15) & 15];
+            _SHA256Lanes w2 = w[(t - 2) & 15];
+            _SHA256Lanes s0 = _SHA256_ROTR(w15, 7) ^ _SHA256_ROTR(w15, 18) ^ (w15 >> 3);
+            _SHA256Lanes s1 = _SHA256_ROTR(w2, 17) ^ _SHA256_ROTR(w2, 19) ^ (w2 >> 10);
+            wt = w[t & 15] + s0 + w[(t - 7) & 15] + s1;
+            w[t & 15] = wt;
+        }
+
+        _SHA256Lanes S1 = _SHA256_ROTR(e, 6) ^ _SHA256_ROTR(e, 11) ^ _SHA256_ROTR(e, 25);
+        _SHA256Lanes ch = (e & f) ^ (~e & g);
+        _SHA256Lanes temp1 = h + S1 + ch + _sha256_K[t] + wt;
+        _SHA256Lanes S0 = _SHA256_ROTR(a, 2) ^ _SHA256_ROTR(a, 13) ^ _SHA256_ROTR(a, 22);
+        _SHA256Lanes maj = (a & b) ^ (a & c) ^ (b & c);
+        _SHA256Lanes temp2 = S0 + maj;
+
+        h = g;
+        g = f;
+        f = e;
+        e = d + temp1;
+        d = c;
+        c = b;
+        b = a;
+        a = temp1 + temp2;
+    }
+
+    _SHA256Lanes result[8] = { a, b, c, d, e, f, g, h };
+    for (int i = 0; i < 8; i++) {
+        state[i] = ((state[i] + result[i]) & active) | (state[i] & ~active);
+    }
+}
+
+/*
+ * Compute the SHA256 digests of `count` (at most PARCCryptoHasher_SHA256_LANES) messages.
+ *
+ * The caller must ensure the CPU supports AVX2.
+ */
+__attribute__((target("avx2")))
+static void
+_sha256_HashLanes(size_t count, const uint8_t *messages[count], const size_t lengths[count], uint8_t digests[count][LENGTH_SHA256])
+{
+    // The last one or two blocks of each message, holding the end of the message and the padding.
+    uint8_t tails[PARCCryptoHasher_SHA256_LANES][128];
+    size_t tailStart[PARCCryptoHasher_SHA256_LANES];
+    size_t blocks[PARCCryptoHasher_SHA256_LANES];
+    static const uint8_t zeroBlock[64] = { 0 };
+
+    size_t maxBlocks = 0;
+    for (size_t lane = 0; lane < count; lane++) {
+        size_t length = lengths[lane];
+        blocks[lane] = (length + 9 + 63) / 64;
+        tailStart[lane] = length & ~((size_t) 63);
+
+        size_t tailLength = blocks[lane] * 64 - tailStart[lane];
+        size_t partial = length - tailStart[lane];
+        memset(tails[lane], 0, tailLength);
+        if (partial > 0) {
+            memcpy(tails[lane], messages[lane] + tailStart[lane], partial);
+        }
+        tails[lane][partial] = 0x80;
+        uint64_t bits = (uint64_t) length * 8;
+        for (int i = 0; i < 8; i++) {
+            tails[lane][tailLength - 1 - i] = (uint8_t) (bits >> (8 * i));
+        }
+
+        if (blocks[lane] > maxBlocks) {
+            maxBlocks = blocks[lane];
+        }
+    }
+
+    _SHA256Lanes state[8];
+    for (int i = 0; i < 8; i++) {
+        for (int lane = 0; lane < PARCCryptoHasher_SHA256_LANES; lane++) {
+            state[i][lane] = _sha256_H0[i];
+        }
+    }
+
+    for (size_t block = 0; block < maxBlocks; block++) {
+        const uint8_t *input[PARCCryptoHasher_SHA256_LANES];
+        _SHA256Lanes active;
+        for (size_t lane = 0; lane < PARCCryptoHasher_SHA256_LANES; lane++) {
+            if (lane < count && block < blocks[lane]) {
+                size_t offset = block * 64;
+                input[lane] = (offset < tailStart[lane]) ? messages[lane] + offset : tails[lane] + (offset - tailStart[lane]);
+                active[lane] = 0xFFFFFFFF;
+            } else {
+                input[lane] = zeroBlock;
+                active[lane] = 0;
+            }
+        }
+
+        _SHA256Lanes w[16];
+        for (int i = 0; i < 16; i++) {
+            for (int lane = 0; lane < PARCCryptoHasher_SHA256_LANES; lane++) {
+                const uint8_t *p = input[lane] + i * 4;
+                w[i][lane] = ((uint32_t) p[0] << 24) | ((uint32_t) p[1] << 16) | ((uint32_t) p[2] << 8) | (uint32_t) p[3];
+            }
+        }
+
+        _sha256_CompressLanes(state, w, active);
+    }
+
+    for (size_t lane = 0; lane < count; lane++) {
+        for (int i = 0; i < 8; i++) {
+            uint32_t word = state[i][lane];
+            digests[lane][i * 4 + 0] = (uint8_t) (word >> 24);
+            digests[lane][i * 4 + 1] = (uint8_t) (word >> 16);
+            digests[lane][i * 4 + 2] = (uint8_t) (word >> 8);
+            digests[lane][i * 4 + 3] = (uint8_t) word;
+        }
+    }
+}
+
+/*
+ * Use the multi-buffer implementation if the CPU has AVX2 but not the SHA extensions.
+ */
+static bool
+_sha256_UseLanes(void)
+{
+    static int useLanes = -1;
+
+    if (useLanes < 0) {
+        bool hasSHA = false;
+        unsigned int eax, ebx, ecx, edx;
+        if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+            hasSHA = (ebx & (1 << 29)) != 0;
+        }
+        useLanes = (__builtin_cpu_supports("avx2") && !hasSHA) ? 1 : 0;
+    }
+
+    return useLanes == 1;
+}
+#else
+#define PARCCryptoHasher_SHA256_LANES 1
+
+static bool
+_sha256_UseLanes(void)
+{
+    return false;
+}
+#endif
+
+// ==================================================
+// Context-reusing one-shot hashing
+
+// Each thread keeps one context per algorithm for the one-shot functions,
+// so computing a digest allocates nothing but the resulting PARCCryptoHash.
+static __thread CTX_SHA256 _sha256ThreadContext;
+static __thread CTX_SHA512 _sha512ThreadContext;
+
+static const uint8_t *
+_parcCryptoHasher_RemainingBytes(const PARCBuffer *buffer, size_t *length)
+{
+    const uint8_t *result = NULL;
+
+    *length = parcBuffer_Remaining(buffer);
+    if (*length > 0) {
+        result = parcByteArray_AddressOfIndex(parcBuffer_Array(buffer), parcBuffer_ArrayOffset(buffer) + parcBuffer_Position(buffer));
+    }
+
+    return result;
+}
+
+static PARCCryptoHash *
+_parcCryptoHasher_HashBytes(PARCCryptoHashType type, const uint8_t *bytes, size_t length)
+{
+    PARCCryptoHash *result = NULL;
+
+    switch (type) {
+        case PARCCryptoHashType_SHA256: {
+            uint8_t digest[LENGTH_SHA256];
+            INIT_SHA256(&_sha256ThreadContext);
+            UPDATE_SHA256(&_sha256ThreadContext, bytes, (unsigned) length);
+            FINAL_SHA256(digest, &_sha256ThreadContext);
+            result = parcCryptoHash_CreateFromArray(type, digest, sizeof(digest));
+            break;
+        }
+
+        case PARCCryptoHashType_SHA512: {
+            uint8_t digest[LENGTH_SHA512];
+            INIT_SHA512(&_sha512ThreadContext);
+            UPDATE_SHA512(&_sha512ThreadContext, bytes, (unsigned) length);
+            FINAL_SHA512(digest, &_sha512ThreadContext);
+            result = parcCryptoHash_CreateFromArray(type, digest, sizeof(digest));
+            break;
+        }
+
+        case PARCCryptoHashType_CRC32C: {
+            uint32_t crc = _crc32c_Finalize(_crc32c_Update(_crc32c_Init(), length, (uint8_t *) bytes));
+            uint8_t digest[sizeof(uint32_t)] = {
+                (uint8_t) (crc >> 24), (uint8_t) (crc >> 16), (uint8_t) (crc >> 8), (uint8_t) crc
+            };
+            result = parcCryptoHash_CreateFromArray(type, digest, sizeof(digest));
+            break;
+        }
+
+        default:
+            trapIllegalValue(type, "Unknown hasher type: %d", type);
+    }
+
+    return result;
+}
+
+PARCCryptoHash *
+parcCryptoHasher_HashBuffer(PARCCryptoHashType type, const PARCBuffer *buffer)
+{
+    assertNotNull(buffer, "Parameter buffer must be non-null");
+
+    size_t length;
+    const uint8_t *bytes = _parcCryptoHasher_RemainingBytes(buffer, &length);
+
+    parcTrace_Scope("PARCCryptoHasher", "HashBuffer");
+    PARCCryptoHash *result = _parcCryptoHasher_HashBytes(type, bytes, length);
+
+    return result;
+}
+
+void
+parcCryptoHasher_HashMany(PARCCryptoHashType type, size_t count, const PARCBuffer *buffers[count], PARCCryptoHash *digests[count])
+{
+    assertTrue(count == 0 || buffers != NULL, "Parameter buffers must be non-null");
+    assertTrue(count == 0 || digests != NULL, "Parameter digests must be non-null");
+
+    size_t index = 0;
+
+    parcTrace_Scope("PARCCryptoHasher", "HashMany");
+#if PARCCryptoHasher_SHA256_LANES > 1
+    if (type == PARCCryptoHashType_SHA256 && _sha256_UseLanes()) {
+        while (count - index > 1) {
+            size_t lanes = count - index;
+            if (lanes > PARCCryptoHasher_SHA256_LANES) {
+                lanes = PARCCryptoHasher_SHA256_LANES;
+            }
+
+            const uint8_t *messages[PARCCryptoHasher_SHA256_LANES];
+            size_t lengths[PARCCryptoHasher_SHA256_LANES];
+            uint8_t laneDigests[PARCCryptoHasher_SHA256_LANES][LENGTH_SHA256];
+            for (size_t lane = 0; lane < lanes; lane++) {
+                assertNotNull(buffers[index + lane], "Buffer %zu must be non-null", index + lane);
+                messages[lane] = _parcCryptoHasher_RemainingBytes(buffers[index + lane], &lengths[lane]);
+            }
+
+            _sha256_HashLanes(lanes, messages, lengths, laneDigests);
+
+            for (size_t lane = 0; lane < lanes; lane++) {
+                digests[index + lane] = parcCryptoHash_CreateFromArray(type, laneDigests[lane], LENGTH_SHA256);
+            }
+            index += lanes;
+        }
+    }
+#endif
+
+    for (; index < count; index++) {
+        digests[index] = parcCryptoHasher_HashBuffer(type, buffers[index]);
+    }
+}
@@ -344,4 +344,59 @@ PARCCryptoHash *parcCryptoHasher_Finalize(PARCCryptoHasher *hasher);
  * @endcode
  */
 void parcCryptoHasher_Release(PARCCryptoHasher **hasherPtr);
+/**
+ * Compute the digest of the remaining bytes of a `PARCBuffer` in one call.
+ *
+ * The digest is computed with a context kept by the calling thread for each hash type,
+ * so no `PARCCryptoHasher` is created and nothing is allocated apart from the result.
+ * The position of @p buffer is not changed.
+ *
+ * @param [in] type The `PARCCryptoHashType` of the digest.
+ * @param [in] buffer A `PARCBuffer` instance containing the bytes to digest.
+ *
+ * @return A `PARCCryptoHash` that must be released via `parcCryptoHash_Release`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBuffer *buffer = ...
+ *     PARCCryptoHash *hash = parcCryptoHasher_HashBuffer(PARCCryptoHashType_SHA256, buffer);
+ *     ...
+ *     parcCryptoHash_Release(&hash);
+ * }
+ * @endcode
+ */
+PARCCryptoHash *parcCryptoHasher_HashBuffer(PARCCryptoHashType type, const PARCBuffer *buffer);
+
+/**
+ * Compute the digests of many independent `PARCBuffer` instances.
+ *
+ * The digest of `buffers[i]` is stored in `digests[i]`.
+ * For SHA256 on a CPU with AVX2 but without the SHA extensions,
+ * up to eight buffers are hashed at once, one per vector lane.
+ * Otherwise each buffer is hashed in turn as by `parcCryptoHasher_HashBuffer`,
+ * which uses the SHA extensions through OpenSSL when the CPU has them.
+ * The buffers may have different lengths; batches of buffers of similar length are hashed most efficiently.
+ *
+ * @param [in] type The `PARCCryptoHashType` of the digests.
+ * @param [in] count The number of buffers.
+ * @param [in] buffers An array of @p count `PARCBuffer` instances.
+ * @param [out] digests An array of @p count pointers that receive the resulting `PARCCryptoHash` instances,
+ *                      each of which must be released via `parcCryptoHash_Release`.
+ *
+ * Example:
+ * @code
+ * {
+ *     const PARCBuffer *buffers[16] = { ... };
+ *     PARCCryptoHash *digests[16];
+ *
+ *     parcCryptoHasher_HashMany(PARCCryptoHashType_SHA256, 16, buffers, digests);
+ *     ...
+ *     for (size_t i = 0; i < 16; i++) {
+ *         parcCryptoHash_Release(&digests[i]);
+ *     }
+ * }
+ * @endcode
+ */
+void parcCryptoHasher_HashMany(PARCCryptoHashType type, size_t count, const PARCBuffer *buffers[count], PARCCryptoHash *digests[count]);
 #endif // libparc_parc_CryptoHasher_h
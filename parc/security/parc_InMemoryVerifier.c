@@ -76,6 +76,8 @@
 #include <parc/algol/parc_Memory.h>
 
 #include <openssl/x509v3.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
 
 struct parc_inmemory_verifier {
     PARCCryptoHasher *hasher_sha256;
@@ -101,6 +103,9 @@ parcObject_ImplementRelease(parcInMemoryVerifier, PARCInMemoryVerifier);
 parcObject_Override(PARCInMemoryVerifier, PARCObject,
     .destructor = (PARCObjectDestructor *) _parcInMemoryVerifier_Destructor);
 
+// Enough shards that verifier threads rarely look up keys in the same shard as a thread adding a key.
+#define _parcInMemoryVerifier_CacheShards 16
+
 PARCInMemoryVerifier *
 parcInMemoryVerifier_Create()
 {
@@ -109,7 +114,7 @@ parcInMemoryVerifier_Create()
         // right now only support sha-256.  need to figure out how to make this flexible
         verifier->hasher_sha256 = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
         verifier->hasher_sha512 = parcCryptoHasher_Create(PARCCryptoHashType_SHA512);
-        verifier->key_cache = parcCryptoCache_Create();
+        verifier->key_cache = parcCryptoCache_CreateSharded(_parcInMemoryVerifier_CacheShards, 0, NULL, NULL);
     }
 
     return verifier;
@@ -123,12 +128,14 @@ _parcInMemoryVerifier_GetCryptoHasher(void *interfaceContext, PARCKeyId *keyid,
 {
     PARCInMemoryVerifier *verifier = (PARCInMemoryVerifier *) interfaceContext;
 
-    const PARCKey *key = parcCryptoCache_GetKey(verifier->key_cache, keyid);
+    PARCKey *key = parcCryptoCache_AcquireKey(verifier->key_cache, keyid);
     if (key == NULL) {
         return false;
     }
 
-    assertFalse(parcKey_GetSigningAlgorithm(key) == PARCSigningAlgorithm_HMAC, "HMAC not supported yet");
+    PARCSigningAlgorithm signingAlgorithm = parcKey_GetSigningAlgorithm(key);
+    parcKey_Release(&key);
+    assertFalse(signingAlgorithm == PARCSigningAlgorithm_HMAC, "HMAC not supported yet");
 
     switch (hashType) {
         case PARCCryptoHashType_SHA256:
@@ -143,15 +150,8 @@ _parcInMemoryVerifier_GetCryptoHasher(void *interfaceContext, PARCKeyId *keyid,
 }
 
 static bool
-_parcInMemoryVerifier_AllowedCryptoSuite(void *interfaceContext, PARCKeyId *keyid, PARCCryptoSuite suite)
+_parcInMemoryVerifier_KeyAllowsCryptoSuite(const PARCKey *key, PARCCryptoSuite suite)
 {
-    PARCInMemoryVerifier *verifier = (PARCInMemoryVerifier *) interfaceContext;
-
-    const PARCKey *key = parcCryptoCache_GetKey(verifier->key_cache, keyid);
-    if (key == NULL) {
-        return false;
-    }
-
     switch (parcKey_GetSigningAlgorithm(key)) {
         case PARCSigningAlgorithm_RSA:
             switch (suite) {
@@ -191,8 +191,24 @@ _parcInMemoryVerifier_AllowedCryptoSuite(void *interfaceContext, PARCKeyId *keyi
     return false;
 }
 
+static bool
+_parcInMemoryVerifier_AllowedCryptoSuite(void *interfaceContext, PARCKeyId *keyid, PARCCryptoSuite suite)
+{
+    PARCInMemoryVerifier *verifier = (PARCInMemoryVerifier *) interfaceContext;
+
+    PARCKey *key = parcCryptoCache_AcquireKey(verifier->key_cache, keyid);
+    if (key == NULL) {
+        return false;
+    }
+
+    bool result = _parcInMemoryVerifier_KeyAllowsCryptoSuite(key, suite);
+    parcKey_Release(&key);
+
+    return result;
+}
+
 static bool _parcInMemoryVerifier_RSAKey_Verify(PARCInMemoryVerifier *verifier, PARCCryptoHash *localHash,
-                                                PARCSignature *signatureToVerify, PARCBuffer *derEncodedKey);
+                                                PARCSignature *signatureToVerify, EVP_PKEY *publicKey);
 
 /**
  * The signature verifies if:
@@ -212,17 +228,23 @@ _parcInMemoryVerifier_VerifyDigest(void *interfaceContext, PARCKeyId *keyid, PAR
 {
     PARCInMemoryVerifier *verifier = (PARCInMemoryVerifier *) interfaceContext;
 
-    const PARCKey *key = parcCryptoCache_GetKey(verifier->key_cache, keyid);
+    // Acquire the key, since another thread may remove it from the cache while it is in use.
+    EVP_PKEY *publicKey;
+    PARCKey *key = parcCryptoCache_AcquireKeyAndDecodedPublicKey(verifier->key_cache, keyid, (void **) &publicKey);
     if (key == NULL) {
         return false;
     }
 
-    assertTrue(_parcInMemoryVerifier_AllowedCryptoSuite(interfaceContext, keyid, suite), "Invalid crypto suite for keyid");
+    assertTrue(_parcInMemoryVerifier_KeyAllowsCryptoSuite(key, suite), "Invalid crypto suite for keyid");
+
+    PARCSigningAlgorithm keySigningAlgorithm = parcKey_GetSigningAlgorithm(key);
+    parcKey_Release(&key);
 
-    if (parcKey_GetSigningAlgorithm(key) != parcSignature_GetSigningAlgorithm(objectSignature)) {
+    if (keySigningAlgorithm != parcSignature_GetSigningAlgorithm(objectSignature)) {
         fprintf(stdout, "Signatured failed, signing algorithms do not match: key %s sig %s\n",
-                parcSigningAlgorithm_ToString(parcKey_GetSigningAlgorithm(key)),
+                parcSigningAlgorithm_ToString(keySigningAlgorithm),
                 parcSigningAlgorithm_ToString(parcSignature_GetSigningAlgorithm(objectSignature)));
+        parcCryptoCache_ReleaseDecodedPublicKey((void **) &publicKey);
         return false;
     }
 
@@ -230,12 +252,16 @@ _parcInMemoryVerifier_VerifyDigest(void *interfaceContext, PARCKeyId *keyid, PAR
         fprintf(stdout, "Signatured failed, digest algorithms do not match: digest %s suite %s\n",
                 parcCryptoHashType_ToString(parcCryptoHash_GetDigestType(locallyComputedHash)),
                 parcCryptoHashType_ToString(parcCryptoSuite_GetCryptoHash(suite)));
+        parcCryptoCache_ReleaseDecodedPublicKey((void **) &publicKey);
         return false;
     }
 
     switch (parcSignature_GetSigningAlgorithm(objectSignature)) {
-        case PARCSigningAlgorithm_RSA:
-            return _parcInMemoryVerifier_RSAKey_Verify(verifier, locallyComputedHash, objectSignature, parcKey_GetKey(key));
+        case PARCSigningAlgorithm_RSA: {
+            bool result = _parcInMemoryVerifier_RSAKey_Verify(verifier, locallyComputedHash, objectSignature, publicKey);
+            parcCryptoCache_ReleaseDecodedPublicKey((void **) &publicKey);
+            return result;
+        }
 
         case PARCSigningAlgorithm_DSA:
             trapNotImplemented("DSA not supported");
@@ -249,7 +275,7 @@ _parcInMemoryVerifier_VerifyDigest(void *interfaceContext, PARCKeyId *keyid, PAR
             trapUnexpectedState("Unknown signing algorithm: %d", parcSignature_GetSigningAlgorithm(objectSignature));
     }
 
-
+    parcCryptoCache_ReleaseDecodedPublicKey((void **) &publicKey);
     return false;
 }
 
@@ -285,6 +311,10 @@ _parcInMemoryVerifier_RemoveKeyId(void *interfaceContext, PARCKeyId *keyid)
 /**
  * Return if the signature and key verify with the local hash.
  *
+ * The public key is the one decoded by the key cache when the key was added,
+ * so it is not decoded again for each signature.
+ * Only a per-call `EVP_PKEY_CTX` is created, so several threads may verify with the same key at once.
+ *
  * PRECONDITION:
  *  - You know the signature and key are RSA.
  *
@@ -295,53 +325,47 @@ _parcInMemoryVerifier_RemoveKeyId(void *interfaceContext, PARCKeyId *keyid)
  */
 static bool
 _parcInMemoryVerifier_RSAKey_Verify(PARCInMemoryVerifier *verifier, PARCCryptoHash *localHash,
-                                    PARCSignature *signatureToVerify, PARCBuffer *derEncodedKey)
+                                    PARCSignature *signatureToVerify, EVP_PKEY *publicKey)
 {
-    const uint8_t *der_bytes = parcByteArray_Array(parcBuffer_Array(derEncodedKey));
+    if (publicKey == NULL) {
+        return false;
+    }
 
-    long der_length = parcBuffer_Remaining(derEncodedKey);
-    EVP_PKEY *unwrapped_key = d2i_PUBKEY(NULL, &der_bytes, der_length);
+    const EVP_MD *openssl_digest_type;
 
-    if (unwrapped_key != NULL) {
-        int success = 0;
-        RSA *rsa = EVP_PKEY_get1_RSA(unwrapped_key);
+    switch (parcCryptoHash_GetDigestType(localHash)) {
+        case PARCCryptoHashType_SHA256:
+            openssl_digest_type = EVP_sha256();
+            break;
+        case PARCCryptoHashType_SHA512:
+            openssl_digest_type = EVP_sha512();
+            break;
+        default:
+            trapUnexpectedState("Unknown digest type: %s",
+                                parcCryptoHashType_ToString(parcCryptoHash_GetDigestType(localHash)));
+    }
 
-        if (rsa != NULL) {
-            int openssl_digest_type;
+    PARCBuffer *sigbits = parcSignature_GetSignature(signatureToVerify);
+    size_t signatureLength = parcBuffer_Remaining(sigbits);
+    uint8_t *sigbuffer = parcByteArray_Array(parcBuffer_Array(sigbits)) + parcBuffer_ArrayOffset(sigbits) + parcBuffer_Position(sigbits);
 
-            switch (parcCryptoHash_GetDigestType(localHash)) {
-                case PARCCryptoHashType_SHA256:
-                    openssl_digest_type = NID_sha256;
-                    break;
-                case PARCCryptoHashType_SHA512:
-                    openssl_digest_type = NID_sha512;
-                    break;
-                default:
-                    trapUnexpectedState("Unknown digest type: %s",
-                                        parcCryptoHashType_ToString(parcCryptoHash_GetDigestType(localHash)));
-            }
+    PARCBuffer *digest = parcCryptoHash_GetDigest(localHash);
+    size_t digestLength = parcBuffer_Remaining(digest);
+    uint8_t *digestBuffer = parcByteArray_Array(parcBuffer_Array(digest)) + parcBuffer_ArrayOffset(digest) + parcBuffer_Position(digest);
 
-            PARCBuffer *sigbits = parcSignature_GetSignature(signatureToVerify);
-            PARCByteArray *bytearray = parcBuffer_Array(sigbits);
-            unsigned signatureLength = (unsigned) parcBuffer_Remaining(sigbits);
-            uint8_t *sigbuffer = parcByteArray_Array(bytearray);
-            size_t signatureOffset = parcBuffer_ArrayOffset(sigbits);
-
-            success = RSA_verify(openssl_digest_type,
-                                 (unsigned char *) parcByteArray_Array(parcBuffer_Array(parcCryptoHash_GetDigest(localHash))),
-                                 (unsigned) parcBuffer_Remaining(parcCryptoHash_GetDigest(localHash)),
-                                 sigbuffer + signatureOffset,
-                                 signatureLength,
-                                 rsa);
-            RSA_free(rsa);
-        }
-        EVP_PKEY_free(unwrapped_key);
+    int success = 0;
 
-        if (success) {
-            return true;
+    EVP_PKEY_CTX *context = EVP_PKEY_CTX_new(publicKey, NULL);
+    if (context != NULL) {
+        if (EVP_PKEY_verify_init(context) == 1
+            && EVP_PKEY_CTX_set_rsa_padding(context, RSA_PKCS1_PADDING) == 1
+            && EVP_PKEY_CTX_set_signature_md(context, openssl_digest_type) == 1) {
+            success = EVP_PKEY_verify(context, sigbuffer, signatureLength, digestBuffer, digestLength);
         }
+        EVP_PKEY_CTX_free(context);
     }
-    return false;
+
+    return success == 1;
 }
 
 PARCVerifierInterface *PARCInMemoryVerifierAsVerifier = &(PARCVerifierInterface) {
@@ -70,12 +70,17 @@
 #include <openssl/pkcs12.h>
 #include <openssl/x509v3.h>
 #include <openssl/err.h>
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
 
 struct PARCPublicKeySigner {
     PARCKeyStore *keyStore;
     PARCSigningAlgorithm signingAlgorithm;
     PARCCryptoHashType hashType;
     PARCCryptoHasher *hasher;
+
+    // Decoded once from the key store, then only read, so that concurrent signing needs no lock.
+    EVP_PKEY *privateKey;
 };
 
 static bool
@@ -91,6 +96,9 @@ _parcPublicKeySigner_Finalize(PARCPublicKeySigner **instancePtr)
     if (instance->hasher != NULL) {
         parcCryptoHasher_Release(&(instance->hasher));
     }
+    if (instance->privateKey != NULL) {
+        EVP_PKEY_free(instance->privateKey);
+    }
 
     return true;
 }
@@ -158,6 +166,32 @@ parcObject_Override(PARCPublicKeySigner, PARCObject,
     .equals = (PARCObjectEquals *) parcPublicKeySigner_Equals,
     .hashCode = (PARCObjectHashCode *) parcPublicKeySigner_HashCode);
 
+static EVP_PKEY *
+_parcPublicKeySigner_DecodePrivateKey(PARCKeyStore *keyStore)
+{
+    PARCBuffer *privateKeyBuffer = parcKeyStore_GetDEREncodedPrivateKey(keyStore);
+    if (privateKeyBuffer == NULL) {
+        return NULL;
+    }
+
+    size_t keySize = parcBuffer_Remaining(privateKeyBuffer);
+    const unsigned char *bytes = parcBuffer_Overlay(privateKeyBuffer, keySize);
+    EVP_PKEY *result = d2i_PrivateKey(EVP_PKEY_RSA, NULL, &bytes, (long) keySize);
+    parcBuffer_Release(&privateKeyBuffer);
+
+#if OPENSSL_VERSION_NUMBER < 0x30000000L
+    // Precompute the blinding factor now rather than on the first signature.
+    // OpenSSL 3 providers always blind and manage this themselves.
+    if (result != NULL) {
+        RSA *rsa = EVP_PKEY_get1_RSA(result);
+        RSA_blinding_on(rsa, NULL);
+        RSA_free(rsa);
+    }
+#endif
+
+    return result;
+}
+
 PARCPublicKeySigner *
 parcPublicKeySigner_Create(PARCKeyStore *keyStore, PARCSigningAlgorithm signingAlgorithm, PARCCryptoHashType hashType)
 {
@@ -168,6 +202,7 @@ parcPublicKeySigner_Create(PARCKeyStore *keyStore, PARCSigningAlgorithm signingA
         result->signingAlgorithm = signingAlgorithm;
         result->hashType = hashType;
         result->hasher = parcCryptoHasher_Create(hashType);
+        result->privateKey = _parcPublicKeySigner_DecodePrivateKey(keyStore);
     }
 
     return result;
@@ -208,44 +243,43 @@ _SignDigest(PARCPublicKeySigner *signer, const PARCCryptoHash *digestToSign)
     assertNotNull(signer, "Parameter must be non-null CCNxFileKeystore");
     assertNotNull(digestToSign, "Buffer to sign must not be null");
 
-    // TODO: what is the best way to expose this?
-    PARCKeyStore *keyStore = signer->keyStore;
-    PARCBuffer *privateKeyBuffer = parcKeyStore_GetDEREncodedPrivateKey(keyStore);
-    EVP_PKEY *privateKey = NULL;
-    size_t keySize = parcBuffer_Remaining(privateKeyBuffer);
-    uint8_t *bytes = parcBuffer_Overlay(privateKeyBuffer, keySize);
-    privateKey = d2i_PrivateKey(EVP_PKEY_RSA, &privateKey, (const unsigned char **) &bytes, keySize);
-    parcBuffer_Release(&privateKeyBuffer);
-
-    RSA *rsa = EVP_PKEY_get1_RSA(privateKey);
+    assertNotNull(signer->privateKey, "The key store does not hold a usable RSA private key");
 
-    int opensslDigestType;
+    const EVP_MD *opensslDigestType;
 
     switch (parcCryptoHash_GetDigestType(digestToSign)) {
         case PARCCryptoHashType_SHA256:
-            opensslDigestType = NID_sha256;
+            opensslDigestType = EVP_sha256();
             break;
         case PARCCryptoHashType_SHA512:
-            opensslDigestType = NID_sha512;
+            opensslDigestType = EVP_sha512();
             break;
         default:
             trapUnexpectedState("Unknown digest type: %s",
                                 parcCryptoHashType_ToString(parcCryptoHash_GetDigestType(digestToSign)));
     }
 
-    uint8_t *sig = parcMemory_Allocate(RSA_size(rsa));
-    assertNotNull(sig, "parcMemory_Allocate(%u) returned NULL", RSA_size(rsa));
+    // A context per signature keeps concurrent calls on the shared key independent.
+    EVP_PKEY_CTX *context = EVP_PKEY_CTX_new(signer->privateKey, NULL);
+    assertNotNull(context, "EVP_PKEY_CTX_new returned NULL");
+
+    int result = EVP_PKEY_sign_init(context);
+    assertTrue(result == 1, "Got error from EVP_PKEY_sign_init: %d", result);
+    EVP_PKEY_CTX_set_rsa_padding(context, RSA_PKCS1_PADDING);
+    EVP_PKEY_CTX_set_signature_md(context, opensslDigestType);
+
+    size_t sigLength = (size_t) EVP_PKEY_size(signer->privateKey);
+    uint8_t *sig = parcMemory_Allocate(sigLength);
+    assertNotNull(sig, "parcMemory_Allocate(%zu) returned NULL", sigLength);
 
-    unsigned sigLength = 0;
     PARCBuffer *bb_digest = parcCryptoHash_GetDigest(digestToSign);
-    int result = RSA_sign(opensslDigestType,
-                          (unsigned char *) parcByteArray_Array(parcBuffer_Array(bb_digest)),
-                          (int) parcBuffer_Remaining(bb_digest),
-                          sig,
-                          &sigLength,
-                          rsa);
-    assertTrue(result == 1, "Got error from RSA_sign: %d", result);
-    RSA_free(rsa);
+    result = EVP_PKEY_sign(context,
+                           sig,
+                           &sigLength,
+                           parcByteArray_Array(parcBuffer_Array(bb_digest)) + parcBuffer_ArrayOffset(bb_digest) + parcBuffer_Position(bb_digest),
+                           parcBuffer_Remaining(bb_digest));
+    assertTrue(result == 1, "Got error from EVP_PKEY_sign: %d", result);
+    EVP_PKEY_CTX_free(context);
 
     PARCBuffer *bbSign = parcBuffer_Allocate(sigLength);
     parcBuffer_Flip(parcBuffer_PutArray(bbSign, sigLength, sig));
@@ -67,6 +67,10 @@
 #include <parc/security/parc_Signer.h>
 #include <parc/security/parc_KeyStore.h>
 
+#include <parc/concurrent/parc_FutureTask.h>
+
+#include <parc/developer/parc_Trace.h>
+
 struct parc_signer {
     PARCObject *instance;
     PARCSigningInterface *interface;
@@ -154,7 +158,11 @@ parcSigner_SignDigest(const PARCSigner *signer, const PARCCryptoHash *parcDigest
     parcSigner_OptionalAssertValid(signer);
 
     assertNotNull(parcDigest, "parcDigest to sign must not be null");
-    return signer->interface->SignDigest(signer->instance, parcDigest);
+
+    parcTrace_Scope("PARCSigner", "SignDigest");
+    PARCSignature *result = signer->interface->SignDigest(signer->instance, parcDigest);
+
+    return result;
 }
 
 PARCSignature *
@@ -164,11 +172,7 @@ parcSigner_SignBuffer(const PARCSigner *signer, const PARCBuffer *buffer)
     assertNotNull(buffer, "buffer to sign must not be null");
 
     PARCCryptoHashType hashType = parcSigner_GetCryptoHashType(signer);
-    PARCCryptoHasher *hasher = parcCryptoHasher_Create(hashType);
-    parcCryptoHasher_Init(hasher);
-    parcCryptoHasher_UpdateBuffer(hasher, buffer);
-    PARCCryptoHash *hash = parcCryptoHasher_Finalize(hasher);
-    parcCryptoHasher_Release(&hasher);
+    PARCCryptoHash *hash = parcCryptoHasher_HashBuffer(hashType, buffer);
 
     PARCSignature *signature = parcSigner_SignDigest(signer, hash);
     parcCryptoHash_Release(&hash);
@@ -176,6 +180,134 @@ parcSigner_SignBuffer(const PARCSigner *signer, const PARCBuffer *buffer)
     return signature;
 }
 
+/*
+ * A run of digests signed by one thread.
+ * A single asynchronous signature is a run of one, whose signature is kept here until the run is released.
+ */
+typedef struct {
+    PARCSigner *signer;
+    PARCCryptoHash *const *hashes;
+    PARCSignature **signatures;
+    size_t count;
+
+    PARCCryptoHash *hash;
+    PARCSignature *signature;
+} _PARCSignerRun;
+
+static bool
+_parcSignerRun_Destructor(_PARCSignerRun **runPtr)
+{
+    _PARCSignerRun *run = *runPtr;
+
+    parcSigner_Release(&run->signer);
+    if (run->hash != NULL) {
+        parcCryptoHash_Release(&run->hash);
+    }
+    if (run->signature != NULL) {
+        parcSignature_Release(&run->signature);
+    }
+    return true;
+}
+
+parcObject_Override(_PARCSignerRun, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcSignerRun_Destructor);
+
+static parcObject_ImplementRelease(_parcSignerRun, _PARCSignerRun);
+
+static _PARCSignerRun *
+_parcSignerRun_Create(const PARCSigner *signer, size_t count, PARCCryptoHash *const *hashes, PARCSignature **signatures)
+{
+    _PARCSignerRun *result = parcObject_CreateAndClearInstance(_PARCSignerRun);
+    assertNotNull(result, "parcObject_CreateAndClearInstance returned NULL");
+
+    result->signer = parcSigner_Acquire(signer);
+    result->hashes = hashes;
+    result->signatures = signatures;
+    result->count = count;
+
+    return result;
+}
+
+static void *
+_parcSignerRun_Sign(PARCFutureTask *task, void *parameter)
+{
+    _PARCSignerRun *run = parameter;
+
+    for (size_t i = 0; i < run->count; i++) {
+        run->signatures[i] = parcSigner_SignDigest(run->signer, run->hashes[i]);
+    }
+
+    return run->signatures[0];
+}
+
+static void
+_parcSigner_Submit(PARCThreadPool *pool, PARCFutureTask *task)
+{
+    if (pool == NULL || parcThreadPool_Execute(pool, task) == false) {
+        parcFutureTask_Run(task);
+    }
+}
+
+PARCFutureTask *
+parcSigner_SignDigestAsync(const PARCSigner *signer, PARCThreadPool *pool, const PARCCryptoHash *hashToSign)
+{
+    parcSigner_OptionalAssertValid(signer);
+    assertNotNull(hashToSign, "hashToSign to sign must not be null");
+
+    _PARCSignerRun *run = _parcSignerRun_Create(signer, 1, NULL, NULL);
+    run->hash = parcCryptoHash_Acquire(hashToSign);
+    run->hashes = &run->hash;
+    run->signatures = &run->signature;
+
+    PARCFutureTask *result = parcFutureTask_Create(_parcSignerRun_Sign, run);
+    _parcSignerRun_Release(&run);
+
+    _parcSigner_Submit(pool, result);
+
+    return result;
+}
+
+size_t
+parcSigner_SignBatch(const PARCSigner *signer, PARCThreadPool *pool, size_t count,
+                     PARCCryptoHash *const hashes[count], PARCSignature *signatures[count])
+{
+    parcSigner_OptionalAssertValid(signer);
+    assertTrue(count == 0 || (hashes != NULL && signatures != NULL), "Parameters hashes and signatures must be non-null");
+
+    // The calling thread takes one run, the pool's threads take the rest.
+    size_t runs = parcThreadPool_GetBatchShareCount(pool, count);
+    size_t runLength = (count + runs - 1) / runs;
+
+    PARCFutureTask *tasks[runs];
+    size_t taskCount = 0;
+
+    size_t start = runLength;
+    while (start < count) {
+        size_t length = (count - start < runLength) ? count - start : runLength;
+
+        _PARCSignerRun *run = _parcSignerRun_Create(signer, length, &hashes[start], &signatures[start]);
+        tasks[taskCount] = parcFutureTask_Create(_parcSignerRun_Sign, run);
+        _parcSignerRun_Release(&run);
+
+        _parcSigner_Submit(pool, tasks[taskCount]);
+        taskCount++;
+        start += length;
+    }
+
+    if (count > 0) {
+        _PARCSignerRun *first = _parcSignerRun_Create(signer, (count < runLength) ? count : runLength, hashes, signatures);
+        _parcSignerRun_Sign(NULL, first);
+        _parcSignerRun_Release(&first);
+    }
+
+    for (size_t i = 0; i < taskCount; i++) {
+        parcFutureTask_Get(tasks[i], PARCTimeout_Never);
+        parcFutureTask_Release(&tasks[i]);
+    }
+
+    return count;
+}
+
 PARCSigningAlgorithm
 parcSigner_GetSigningAlgorithm(PARCSigner *signer)
 {
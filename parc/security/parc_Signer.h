@@ -57,7 +57,9 @@
  * @ingroup security
  * @brief The API a crytography provider must interfaceement.
  *
- * A signer IS NOT THREAD-SAFE.
+ * A signer IS NOT THREAD-SAFE, with one exception: the `SignDigest` function of the signers
+ * provided here may be called concurrently, which is what `parcSigner_SignDigestAsync`
+ * and `parcSigner_SignBatch` rely on.
  *
  * @author Marc Mosko, Christopher A. Wood, Palo Alto Research Center (Xerox PARC)
  * @copyright (c) 2013-2015, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
@@ -73,6 +75,9 @@
 #include <parc/security/parc_Key.h>
 #include <parc/security/parc_KeyStore.h>
 
+#include <parc/concurrent/parc_ThreadPool.h>
+#include <parc/concurrent/parc_FutureTask.h>
+
 struct parc_signer;
 /**
  * @typedef PARCSigner
@@ -353,6 +358,64 @@ PARCSignature *parcSigner_SignDigest(const PARCSigner *signer, const PARCCryptoH
  */
 PARCSignature *parcSigner_SignBuffer(const PARCSigner *signer, const PARCBuffer *buffer);
 
+/**
+ * Start computing the signature of the given `PARCCryptoHash` on a thread of the given `PARCThreadPool`.
+ *
+ * The value of the returned `PARCFutureTask` is the `PARCSignature`.
+ * The signature belongs to the task:
+ * acquire it with `parcSignature_Acquire` to keep it after the task is released.
+ *
+ * If @p pool is NULL, or has been shut down, the signature is computed by the calling thread
+ * and the returned task is already done.
+ *
+ * @param [in] signer A pointer to a PARCSigner instance.
+ * @param [in] pool A pointer to a PARCThreadPool instance, or NULL.
+ * @param [in] hashToSign The digest to sign.
+ *
+ * @return A `PARCFutureTask` that must be released via `parcFutureTask_Release`.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCFutureTask *task = parcSigner_SignDigestAsync(signer, pool, hashToSign);
+ *
+ *     // ...
+ *
+ *     PARCFutureTaskResult taskResult = parcFutureTask_Get(task, PARCTimeout_Never);
+ *     PARCSignature *signature = parcSignature_Acquire(taskResult.value);
+ *     parcFutureTask_Release(&task);
+ * }
+ * @endcode
+ */
+PARCFutureTask *parcSigner_SignDigestAsync(const PARCSigner *signer, PARCThreadPool *pool, const PARCCryptoHash *hashToSign);
+
+/**
+ * Sign each of the given `PARCCryptoHash` instances, sharing the work between the calling thread
+ * and the threads of the given `PARCThreadPool`.
+ *
+ * The function returns when every digest has been signed.
+ * If @p pool is NULL, or has been shut down, the calling thread signs every digest.
+ *
+ * @param [in] signer A pointer to a PARCSigner instance.
+ * @param [in] pool A pointer to a PARCThreadPool instance, or NULL.
+ * @param [in] count The number of digests.
+ * @param [in] hashes The digests to sign.
+ * @param [out] signatures Set to the signature of the corresponding digest. Each must be released via `parcSignature_Release`.
+ *
+ * @return The number of signatures computed, which is @p count.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCSignature *signatures[count];
+ *
+ *     parcSigner_SignBatch(signer, pool, count, hashes, signatures);
+ * }
+ * @endcode
+ */
+size_t parcSigner_SignBatch(const PARCSigner *signer, PARCThreadPool *pool, size_t count,
+                            PARCCryptoHash *const hashes[count], PARCSignature *signatures[count]);
+
 /**
  * Return the PARSigningAlgorithm used for signing with the given `PARCSigner`
  *
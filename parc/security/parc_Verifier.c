@@ -63,6 +63,8 @@
 
 #include <parc/security/parc_Verifier.h>
 #include <parc/algol/parc_Memory.h>
+#include <parc/concurrent/parc_FutureTask.h>
+#include <parc/developer/parc_Trace.h>
 
 struct parc_verifier {
     PARCObject *instance;
@@ -116,7 +118,10 @@ parcVerifier_VerifyDigestSignature(PARCVerifier *verifier, PARCKeyId *keyid, PAR
 
     // null keyid is allowed now that we support CRCs, etc.
 
-    return verifier->interface->VerifyDigest(verifier->instance, keyid, locallyComputedHash, suite, signatureToVerify);
+    parcTrace_Scope("PARCVerifier", "VerifyDigestSignature");
+    bool result = verifier->interface->VerifyDigest(verifier->instance, keyid, locallyComputedHash, suite, signatureToVerify);
+
+    return result;
 }
 
 bool
@@ -146,3 +151,99 @@ parcVerifier_RemoveKeyId(PARCVerifier *verifier, PARCKeyId *keyid)
     assertNotNull(verifier, "Parameter must be non-null PARCVerifier");
     verifier->interface->RemoveKeyId(verifier->instance, keyid);
 }
+
+/*
+ * A contiguous share of the entries of a batch, verified by one thread.
+ */
+typedef struct {
+    PARCVerifier *verifier;
+    PARCVerifierBatchEntry *entries;
+    size_t count;
+    size_t verifiedCount;
+} _PARCVerifierBatchSlice;
+
+static bool
+_parcVerifierBatchSlice_Destructor(_PARCVerifierBatchSlice **slicePtr)
+{
+    parcVerifier_Release(&(*slicePtr)->verifier);
+    return true;
+}
+
+parcObject_Override(_PARCVerifierBatchSlice, PARCObject,
+                    .destructor = (PARCObjectDestructor *) _parcVerifierBatchSlice_Destructor);
+
+static parcObject_ImplementRelease(_parcVerifierBatchSlice, _PARCVerifierBatchSlice);
+
+static _PARCVerifierBatchSlice *
+_parcVerifierBatchSlice_Create(PARCVerifier *verifier, PARCVerifierBatchEntry *entries, size_t count)
+{
+    _PARCVerifierBatchSlice *result = parcObject_CreateInstance(_PARCVerifierBatchSlice);
+    assertNotNull(result, "parcObject_CreateInstance returned NULL");
+
+    result->verifier = parcVerifier_Acquire(verifier);
+    result->entries = entries;
+    result->count = count;
+    result->verifiedCount = 0;
+
+    return result;
+}
+
+static void *
+_parcVerifierBatchSlice_Verify(PARCFutureTask *task, void *parameter)
+{
+    _PARCVerifierBatchSlice *slice = parameter;
+
+    for (size_t i = 0; i < slice->count; i++) {
+        PARCVerifierBatchEntry *entry = &slice->entries[i];
+        entry->verified = parcVerifier_VerifyDigestSignature(slice->verifier, entry->keyId, entry->digest, entry->suite, entry->signature);
+        if (entry->verified) {
+            slice->verifiedCount++;
+        }
+    }
+
+    return slice;
+}
+
+size_t
+parcVerifier_VerifyBatch(PARCVerifier *verifier, PARCThreadPool *pool, size_t count, PARCVerifierBatchEntry entries[count])
+{
+    assertNotNull(verifier, "Parameter must be non-null PARCVerifier");
+    assertTrue(count == 0 || entries != NULL, "Parameter entries must be non-null");
+
+    // The calling thread takes one share, the pool's threads take the rest.
+    size_t slices = parcThreadPool_GetBatchShareCount(pool, count);
+    size_t sliceSize = (count + slices - 1) / slices;
+
+    PARCFutureTask *tasks[slices];
+    size_t taskCount = 0;
+
+    size_t start = sliceSize;
+    while (start < count) {
+        size_t length = (count - start < sliceSize) ? count - start : sliceSize;
+
+        _PARCVerifierBatchSlice *slice = _parcVerifierBatchSlice_Create(verifier, &entries[start], length);
+        tasks[taskCount] = parcFutureTask_Create(_parcVerifierBatchSlice_Verify, slice);
+        _parcVerifierBatchSlice_Release(&slice);
+
+        if (parcThreadPool_Execute(pool, tasks[taskCount]) == false) {
+            // The pool is shut down.
+            parcFutureTask_Run(tasks[taskCount]);
+        }
+        taskCount++;
+        start += length;
+    }
+
+    _PARCVerifierBatchSlice *first = _parcVerifierBatchSlice_Create(verifier, entries, (count < sliceSize) ? count : sliceSize);
+    _parcVerifierBatchSlice_Verify(NULL, first);
+    size_t result = first->verifiedCount;
+    _parcVerifierBatchSlice_Release(&first);
+
+    for (size_t i = 0; i < taskCount; i++) {
+        PARCFutureTaskResult taskResult = parcFutureTask_Get(tasks[i], PARCTimeout_Never);
+        _PARCVerifierBatchSlice *slice = taskResult.value;
+        result += slice->verifiedCount;
+        parcFutureTask_Release(&tasks[i]);
+    }
+
+    return result;
+}
@@ -70,6 +70,8 @@
 #include <parc/security/parc_CryptoHashType.h>
 #include <parc/security/parc_Key.h>
 
+#include <parc/concurrent/parc_ThreadPool.h>
+
 struct parc_verifier;
 typedef struct parc_verifier PARCVerifier;
 
@@ -95,6 +97,27 @@ typedef struct parc_verifier_interface {
     bool (*AllowedCryptoSuite)(PARCObject *interfaceContext, PARCKeyId *keyid, PARCCryptoSuite suite);
 } PARCVerifierInterface;
 
+/**
+ * @typedef PARCVerifierBatchEntry
+ * @brief One signature to verify with `parcVerifier_VerifyBatch`.
+ */
+typedef struct parc_verifier_batch_entry {
+    /** The `PARCKeyId` of the verification key. */
+    PARCKeyId *keyId;
+
+    /** The locally computed digest of the signed content. */
+    PARCCryptoHash *digest;
+
+    /** The `PARCCryptoSuite` in which verification is performed. */
+    PARCCryptoSuite suite;
+
+    /** The `PARCSignature` to verify. */
+    PARCSignature *signature;
+
+    /** Set by `parcVerifier_VerifyBatch` to the result of the verification. */
+    bool verified;
+} PARCVerifierBatchEntry;
+
 /**
  * Create a verifier context based on a concrete implementation.
  *
@@ -309,4 +332,37 @@ void parcVerifier_AddKey(PARCVerifier *verifier, PARCKey *key);
  * @endcode
  */
 void parcVerifier_RemoveKeyId(PARCVerifier *verifier, PARCKeyId *keyid);
+/**
+ * Verify many signatures, dividing them among the threads of a `PARCThreadPool`.
+ *
+ * Each entry is verified as by `parcVerifier_VerifyDigestSignature`
+ * and the result is stored in its `verified` field.
+ * The calling thread verifies a share of the entries itself and returns when all of them are done.
+ *
+ * The verifier is used by several threads at once,
+ * so keys must not be added to or removed from it while the batch is being verified.
+ *
+ * @param [in] verifier A `PARCVerifier` instance.
+ * @param [in] pool A `PARCThreadPool` instance, or NULL to verify every entry on the calling thread.
+ * @param [in] count The number of entries.
+ * @param [in,out] entries An array of @p count `PARCVerifierBatchEntry` values.
+ *
+ * @return The number of entries whose signature verified.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCVerifierBatchEntry entries[64];
+ *     for (size_t i = 0; i < 64; i++) {
+ *         entries[i].keyId = ...
+ *         entries[i].digest = ...
+ *         entries[i].suite = PARCCryptoSuite_RSA_SHA256;
+ *         entries[i].signature = ...
+ *     }
+ *
+ *     size_t verified = parcVerifier_VerifyBatch(verifier, pool, 64, entries);
+ * }
+ * @endcode
+ */
+size_t parcVerifier_VerifyBatch(PARCVerifier *verifier, PARCThreadPool *pool, size_t count, PARCVerifierBatchEntry entries[count]);
 #endif // libparc_parc_Verifier_h
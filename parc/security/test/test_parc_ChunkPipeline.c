@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+#include <LongBow/unit-test.h>
+
+// Include the file(s) containing the functions to be tested directly.
+// This permits internal static functions to be visible to this Test Framework.
+#include "../parc_ChunkPipeline.c"
+
+#include <stdio.h>
+
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/algol/parc_BufferChunker.h>
+#include <parc/developer/parc_Stopwatch.h>
+#include <parc/testing/parc_MemoryTesting.h>
+
+#include <parc/security/parc_Security.h>
+#include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/security/parc_KeyStore.h>
+#include <parc/security/parc_PublicKeySigner.h>
+
+static PARCBuffer *
+_createData(size_t length)
+{
+    PARCBuffer *result = parcBuffer_Allocate(length);
+    for (size_t i = 0; i < length; i++) {
+        parcBuffer_PutUint8(result, (uint8_t) (i * 31 + 7));
+    }
+    return parcBuffer_Flip(result);
+}
+
+static PARCChunker *
+_createChunker(PARCBuffer *data, size_t chunkSize)
+{
+    PARCBufferChunker *bufferChunker = parcBufferChunker_Create(data, chunkSize);
+    PARCChunker *result = parcChunker_Create(bufferChunker, PARCBufferChunkerAsChunker);
+    parcBufferChunker_Release(&bufferChunker);
+    return result;
+}
+
+static PARCSigner *
+_createSigner(void)
+{
+    PARCPkcs12KeyStore *pkcs12KeyStore = parcPkcs12KeyStore_Open("test_rsa.p12", "blueberry", PARCCryptoHashType_SHA256);
+    PARCKeyStore *keyStore = parcKeyStore_Create(pkcs12KeyStore, PARCPkcs12KeyStoreAsKeyStore);
+    parcPkcs12KeyStore_Release(&pkcs12KeyStore);
+
+    PARCPublicKeySigner *publicKeySigner = parcPublicKeySigner_Create(keyStore, PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256);
+    parcKeyStore_Release(&keyStore);
+
+    PARCSigner *result = parcSigner_Create(publicKeySigner, PARCPublicKeySignerAsSigner);
+    parcPublicKeySigner_Release(&publicKeySigner);
+
+    return result;
+}
+
+static PARCCryptoHash *
+_digest(const PARCBuffer *chunk)
+{
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(PARCCryptoHashType_SHA256);
+    parcCryptoHasher_Init(hasher);
+    parcCryptoHasher_UpdateBuffer(hasher, chunk);
+    PARCCryptoHash *result = parcCryptoHasher_Finalize(hasher);
+    parcCryptoHasher_Release(&hasher);
+    return result;
+}
+
+/*
+ * Drain the pipeline, checking that each chunk is delivered in order with the expected digest.
+ * Return the number of chunks delivered.
+ */
+static size_t
+_drainAndVerify(PARCChunkPipeline *pipeline, PARCSigner *signer)
+{
+    size_t expectedChunkNumber = 0;
+
+    PARCChunkPipelineResult *result;
+    while ((result = parcChunkPipeline_Next(pipeline)) != NULL) {
+        assertTrue(parcChunkPipelineResult_GetChunkNumber(result) == expectedChunkNumber,
+                   "Expected chunk %zu, actual %zu", expectedChunkNumber, parcChunkPipelineResult_GetChunkNumber(result));
+
+        PARCCryptoHash *expected = _digest(parcChunkPipelineResult_GetChunk(result));
+        assertTrue(parcCryptoHash_Equals(expected, parcChunkPipelineResult_GetDigest(result)),
+                   "Digest of chunk %zu does not match", expectedChunkNumber);
+
+        if (signer != NULL) {
+            PARCSignature *expectedSignature = parcSigner_SignDigest(signer, expected);
+            assertTrue(parcSignature_Equals(expectedSignature, parcChunkPipelineResult_GetSignature(result)),
+                       "Signature of chunk %zu does not match", expectedChunkNumber);
+            parcSignature_Release(&expectedSignature);
+        } else {
+            assertNull(parcChunkPipelineResult_GetSignature(result), "Expected no signature without a signer");
+        }
+
+        parcCryptoHash_Release(&expected);
+        parcChunkPipelineResult_Release(&result);
+        expectedChunkNumber++;
+    }
+
+    return expectedChunkNumber;
+}
+
+LONGBOW_TEST_RUNNER(parc_ChunkPipeline)
+{
+    LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
+    LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_ChunkPipeline)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_ChunkPipeline)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(CreateAcquireRelease)
+{
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateRelease);
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateWithThreadPool);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(CreateAcquireRelease)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(CreateAcquireRelease)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateRelease)
+{
+    PARCBuffer *data = _createData(10000);
+    PARCChunker *chunker = _createChunker(data, 1000);
+
+    PARCChunkPipeline *instance = parcChunkPipeline_Create(chunker, PARCCryptoHashType_SHA256, NULL, 2, 4);
+    assertNotNull(instance, "Expected non-null result from parcChunkPipeline_Create();");
+    parcChunkPipeline_AssertValid(instance);
+
+    PARCChunkPipeline *reference = parcChunkPipeline_Acquire(instance);
+    assertTrue(reference == instance, "Expected the same instance from parcChunkPipeline_Acquire");
+    parcChunkPipeline_Release(&reference);
+
+    parcChunkPipeline_Release(&instance);
+    assertNull(instance, "Expected null result from parcChunkPipeline_Release();");
+
+    parcChunker_Release(&chunker);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateWithThreadPool)
+{
+    PARCBuffer *data = _createData(10000);
+    PARCChunker *chunker = _createChunker(data, 1000);
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+
+    PARCChunkPipeline *instance = parcChunkPipeline_CreateWithThreadPool(chunker, PARCCryptoHashType_SHA256, NULL, pool, 4);
+    assertNotNull(instance, "Expected non-null result from parcChunkPipeline_CreateWithThreadPool();");
+    parcChunkPipeline_Release(&instance);
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    parcChunker_Release(&chunker);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_FIXTURE(Global)
+{
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Next);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Next_Signed);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Next_SharedThreadPool);
+    LONGBOW_RUN_TEST_CASE(Global, parcChunkPipeline_Cancel);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Global)
+{
+    parcSecurity_Init();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Global)
+{
+    parcSecurity_Fini();
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Next)
+{
+    PARCBuffer *data = _createData(100000);
+    PARCChunker *chunker = _createChunker(data, 1024);
+
+    // A depth smaller than the number of chunks makes the reader wait for the consumer.
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(chunker, PARCCryptoHashType_SHA256, NULL, 4, 3);
+
+    size_t delivered = _drainAndVerify(pipeline, NULL);
+    assertTrue(delivered == 98, "Expected 98 chunks, actual %zu", delivered);
+    assertTrue(parcChunkPipeline_GetDeliveredCount(pipeline) == delivered,
+               "Expected the delivered count to be %zu, actual %zu", delivered, parcChunkPipeline_GetDeliveredCount(pipeline));
+
+    assertNull(parcChunkPipeline_Next(pipeline), "Expected NULL after the last chunk was delivered");
+
+    parcChunkPipeline_Release(&pipeline);
+    parcChunker_Release(&chunker);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Next_Signed)
+{
+    PARCBuffer *data = _createData(20000);
+    PARCChunker *chunker = _createChunker(data, 1000);
+    PARCSigner *signer = _createSigner();
+
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(chunker, PARCCryptoHashType_SHA256, signer, 4, 8);
+
+    size_t delivered = _drainAndVerify(pipeline, signer);
+    assertTrue(delivered == 20, "Expected 20 chunks, actual %zu", delivered);
+
+    parcChunkPipeline_Release(&pipeline);
+    parcSigner_Release(&signer);
+    parcChunker_Release(&chunker);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Next_SharedThreadPool)
+{
+    PARCThreadPool *pool = parcThreadPool_Create(3);
+
+    // Each chunker moves the position of the buffer it reads from, so they cannot share one.
+    PARCBuffer *data1 = _createData(50000);
+    PARCBuffer *data2 = _createData(50000);
+    PARCChunker *chunker1 = _createChunker(data1, 1000);
+    PARCChunker *chunker2 = _createChunker(data2, 3000);
+
+    PARCChunkPipeline *pipeline1 = parcChunkPipeline_CreateWithThreadPool(chunker1, PARCCryptoHashType_SHA256, NULL, pool, 4);
+    PARCChunkPipeline *pipeline2 = parcChunkPipeline_CreateWithThreadPool(chunker2, PARCCryptoHashType_SHA256, NULL, pool, 4);
+
+    size_t delivered1 = _drainAndVerify(pipeline1, NULL);
+    size_t delivered2 = _drainAndVerify(pipeline2, NULL);
+    assertTrue(delivered1 == 50, "Expected 50 chunks, actual %zu", delivered1);
+    assertTrue(delivered2 == 17, "Expected 17 chunks, actual %zu", delivered2);
+
+    parcChunkPipeline_Release(&pipeline1);
+    parcChunkPipeline_Release(&pipeline2);
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+
+    parcChunker_Release(&chunker1);
+    parcChunker_Release(&chunker2);
+    parcBuffer_Release(&data1);
+    parcBuffer_Release(&data2);
+}
+
+LONGBOW_TEST_CASE(Global, parcChunkPipeline_Cancel)
+{
+    PARCBuffer *data = _createData(100000);
+    PARCChunker *chunker = _createChunker(data, 100);
+
+    PARCChunkPipeline *pipeline = parcChunkPipeline_Create(chunker, PARCCryptoHashType_SHA256, NULL, 2, 4);
+
+    PARCChunkPipelineResult *result = parcChunkPipeline_Next(pipeline);
+    assertNotNull(result, "Expected the first chunk");
+    parcChunkPipelineResult_Release(&result);
+
+    parcChunkPipeline_Cancel(pipeline);
+
+    assertNull(parcChunkPipeline_Next(pipeline), "Expected NULL after parcChunkPipeline_Cancel");
+    assertTrue(parcChunkPipeline_GetDeliveredCount(pipeline) == 1,
+               "Expected 1 delivered chunk, actual %zu", parcChunkPipeline_GetDeliveredCount(pipeline));
+
+    parcChunkPipeline_Release(&pipeline);
+    parcChunker_Release(&chunker);
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcChunkPipeline_Scaling);
+    LONGBOW_RUN_TEST_CASE(Performance, parcChunkPipeline_Scaling_Signed);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    parcSecurity_Init();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcSecurity_Fini();
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static void
+_measureScaling(const char *name, size_t dataLength, size_t chunkSize, PARCSigner *signer)
+{
+    PARCBuffer *data = _createData(dataLength);
+
+    printf("%s: %zu bytes in %zu byte chunks\n", name, dataLength, chunkSize);
+    for (size_t workers = 1; workers <= 8; workers *= 2) {
+        // The chunker moves the position of the buffer it reads from.
+        parcBuffer_Rewind(data);
+        PARCChunker *chunker = _createChunker(data, chunkSize);
+
+        PARCStopwatch *stopwatch = parcStopwatch_Create();
+        parcStopwatch_Start(stopwatch);
+
+        PARCChunkPipeline *pipeline = parcChunkPipeline_Create(chunker, PARCCryptoHashType_SHA256, signer, workers, workers * 4);
+        size_t chunks = 0;
+        PARCChunkPipelineResult *result;
+        while ((result = parcChunkPipeline_Next(pipeline)) != NULL) {
+            chunks++;
+            parcChunkPipelineResult_Release(&result);
+        }
+        parcChunkPipeline_Release(&pipeline);
+
+        uint64_t nanos = parcStopwatch_ElapsedTimeNanos(stopwatch);
+        parcStopwatch_Release(&stopwatch);
+
+        printf("  %zu workers: %zu chunks %.3f ms %.1f MB/s\n", workers, chunks, nanos / 1000000.0,
+               (dataLength / (1024.0 * 1024.0)) / (nanos / 1000000000.0));
+
+        parcChunker_Release(&chunker);
+    }
+
+    parcBuffer_Release(&data);
+}
+
+LONGBOW_TEST_CASE(Performance, parcChunkPipeline_Scaling)
+{
+    _measureScaling("SHA256", 64 * 1024 * 1024, 8192, NULL);
+}
+
+LONGBOW_TEST_CASE(Performance, parcChunkPipeline_Scaling_Signed)
+{
+    PARCSigner *signer = _createSigner();
+    _measureScaling("SHA256 + RSA", 4 * 1024 * 1024, 4096, signer);
+    parcSigner_Release(&signer);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_ChunkPipeline);
+    int exitStatus = longBowMain(argc, argv, testRunner, NULL);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -61,6 +61,7 @@
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_BufferComposer.h>
 #include <parc/security/parc_CryptoHashType.h>
+#include <parc/testing/parc_MemoryTesting.h>
 
 LONGBOW_TEST_RUNNER(parc_CryptoCache)
 {
@@ -69,6 +70,7 @@ LONGBOW_TEST_RUNNER(parc_CryptoCache)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Allocate);
     LONGBOW_RUN_TEST_FIXTURE(Global);
+    LONGBOW_RUN_TEST_FIXTURE(Sharded);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -257,6 +259,289 @@ LONGBOW_TEST_CASE(Global, parcCryptoCache_RemoveKey)
     parcKeyId_Release(&keyid1_copy);
 }
 
+LONGBOW_TEST_FIXTURE(Sharded)
+{
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_CreateSharded);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_Evict);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_Evict_CallbackUsesCache);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_Evict_KeepsReferenced);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_RemoveKey_Bounded);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_AcquireKey);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_AcquireKeyAndDecodedPublicKey);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_HitMissCount);
+    LONGBOW_RUN_TEST_CASE(Sharded, parcCryptoCache_ConcurrentLookup);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Sharded)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Sharded)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static PARCKeyId *
+_createKeyId(unsigned index)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(sizeof(uint32_t));
+    parcBuffer_Flip(parcBuffer_PutUint32(buffer, index));
+    PARCKeyId *result = parcKeyId_Create(buffer);
+    parcBuffer_Release(&buffer);
+
+    return result;
+}
+
+static void
+_addKey(PARCCryptoCache *cache, unsigned index)
+{
+    PARCKeyId *keyid = _createKeyId(index);
+    PARCBuffer *bytes = parcBuffer_WrapCString("quack quack");
+    PARCKey *key = parcKey_CreateFromSymmetricKey(keyid, PARCSigningAlgorithm_HMAC, bytes);
+
+    parcCryptoCache_AddKey(cache, key);
+
+    parcKey_Release(&key);
+    parcBuffer_Release(&bytes);
+    parcKeyId_Release(&keyid);
+}
+
+static bool
+_contains(PARCCryptoCache *cache, unsigned index)
+{
+    PARCKeyId *keyid = _createKeyId(index);
+    PARCKey *key = parcCryptoCache_AcquireKey(cache, keyid);
+    parcKeyId_Release(&keyid);
+
+    bool result = (key != NULL);
+    if (key != NULL) {
+        parcKey_Release(&key);
+    }
+    return result;
+}
+
+static void
+_countEviction(const PARCKey *key, void *context)
+{
+    unsigned *count = context;
+    (*count)++;
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_CreateSharded)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(8, 0, NULL, NULL);
+
+    for (unsigned i = 0; i < 100; i++) {
+        _addKey(cache, i);
+    }
+    assertTrue(parcCryptoCache_Size(cache) == 100, "Expected 100 keys, actual %zu", parcCryptoCache_Size(cache));
+    for (unsigned i = 0; i < 100; i++) {
+        assertTrue(_contains(cache, i), "Expected key %u in the cache", i);
+    }
+    assertTrue(parcCryptoCache_GetEvictionCount(cache) == 0, "Expected an unbounded cache to evict nothing");
+
+    parcCryptoCache_Destroy(&cache);
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_Evict)
+{
+    unsigned evicted = 0;
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(1, 4, _countEviction, &evicted);
+
+    for (unsigned i = 0; i < 6; i++) {
+        _addKey(cache, i);
+    }
+
+    assertTrue(parcCryptoCache_Size(cache) == 4, "Expected 4 keys, actual %zu", parcCryptoCache_Size(cache));
+    assertTrue(parcCryptoCache_GetEvictionCount(cache) == 2, "Expected 2 evictions, actual %" PRIu64, parcCryptoCache_GetEvictionCount(cache));
+    assertTrue(evicted == 2, "Expected the callback for 2 evictions, actual %u", evicted);
+    assertFalse(_contains(cache, 0), "Expected the oldest key to be evicted");
+    assertFalse(_contains(cache, 1), "Expected the second oldest key to be evicted");
+
+    parcCryptoCache_Destroy(&cache);
+}
+
+typedef struct {
+    PARCCryptoCache *cache;
+    bool evictedKeyFound;
+} _EvictionLookup;
+
+static void
+_lookupEvicted(const PARCKey *key, void *context)
+{
+    _EvictionLookup *lookup = context;
+    PARCKey *found = parcCryptoCache_AcquireKey(lookup->cache, parcKey_GetKeyId(key));
+    lookup->evictedKeyFound = (found != NULL);
+    if (found != NULL) {
+        parcKey_Release(&found);
+    }
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_Evict_CallbackUsesCache)
+{
+    _EvictionLookup lookup = { .cache = NULL, .evictedKeyFound = true };
+    lookup.cache = parcCryptoCache_CreateSharded(1, 1, _lookupEvicted, &lookup);
+
+    _addKey(lookup.cache, 1);
+    _addKey(lookup.cache, 2);
+
+    assertFalse(lookup.evictedKeyFound, "Expected the evicted key to have left the cache before the callback");
+    assertTrue(parcCryptoCache_GetEvictionCount(lookup.cache) == 1, "Expected 1 eviction, actual %" PRIu64, parcCryptoCache_GetEvictionCount(lookup.cache));
+
+    parcCryptoCache_Destroy(&lookup.cache);
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_Evict_KeepsReferenced)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(1, 2, NULL, NULL);
+
+    _addKey(cache, 1);
+    _addKey(cache, 2);
+    assertTrue(_contains(cache, 1), "Expected key 1 in the cache");
+
+    _addKey(cache, 3);
+
+    assertTrue(_contains(cache, 1), "Expected the recently used key to stay");
+    assertFalse(_contains(cache, 2), "Expected the unused key to be evicted");
+    assertTrue(_contains(cache, 3), "Expected the new key in the cache");
+
+    parcCryptoCache_Destroy(&cache);
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_RemoveKey_Bounded)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(1, 2, NULL, NULL);
+
+    _addKey(cache, 1);
+    _addKey(cache, 2);
+
+    PARCKeyId *keyid = _createKeyId(1);
+    parcCryptoCache_RemoveKey(cache, keyid);
+    parcKeyId_Release(&keyid);
+
+    _addKey(cache, 3);
+
+    assertTrue(parcCryptoCache_GetEvictionCount(cache) == 0, "Expected the removed key's slot to be reused");
+    assertTrue(_contains(cache, 2), "Expected key 2 in the cache");
+    assertTrue(_contains(cache, 3), "Expected key 3 in the cache");
+
+    parcCryptoCache_Destroy(&cache);
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_AcquireKey)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(4, 0, NULL, NULL);
+    _addKey(cache, 1);
+
+    PARCKeyId *keyid = _createKeyId(1);
+    PARCKey *key = parcCryptoCache_AcquireKey(cache, keyid);
+    assertNotNull(key, "Expected the key");
+
+    parcCryptoCache_RemoveKey(cache, keyid);
+    assertTrue(parcKeyId_Equals(keyid, parcKey_GetKeyId(key)), "Expected the acquired key to remain valid after removal");
+
+    assertNull(parcCryptoCache_AcquireDecodedPublicKey(cache, keyid), "Expected no decoded key for a removed key");
+
+    parcKey_Release(&key);
+    parcKeyId_Release(&keyid);
+    parcCryptoCache_Destroy(&cache);
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_AcquireKeyAndDecodedPublicKey)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(4, 0, NULL, NULL);
+    _addKey(cache, 1);
+
+    PARCKeyId *keyid = _createKeyId(1);
+    void *publicKey = (void *) 1;
+    PARCKey *key = parcCryptoCache_AcquireKeyAndDecodedPublicKey(cache, keyid, &publicKey);
+    assertNotNull(key, "Expected the key");
+    assertNull(publicKey, "Expected no decoded key for a symmetric key");
+    assertTrue(parcCryptoCache_GetHitCount(cache) == 1, "Expected a single lookup, actual %" PRIu64, parcCryptoCache_GetHitCount(cache));
+    parcKey_Release(&key);
+
+    parcCryptoCache_RemoveKey(cache, keyid);
+    assertNull(parcCryptoCache_AcquireKeyAndDecodedPublicKey(cache, keyid, &publicKey), "Expected no key after removal");
+    assertNull(publicKey, "Expected no decoded key after removal");
+
+    parcKeyId_Release(&keyid);
+    parcCryptoCache_Destroy(&cache);
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_HitMissCount)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(4, 0, NULL, NULL);
+    _addKey(cache, 1);
+
+    _contains(cache, 1);
+    _contains(cache, 1);
+    _contains(cache, 2);
+
+    assertTrue(parcCryptoCache_GetHitCount(cache) == 2, "Expected 2 hits, actual %" PRIu64, parcCryptoCache_GetHitCount(cache));
+    assertTrue(parcCryptoCache_GetMissCount(cache) == 1, "Expected 1 miss, actual %" PRIu64, parcCryptoCache_GetMissCount(cache));
+
+    parcCryptoCache_Destroy(&cache);
+}
+
+typedef struct {
+    PARCCryptoCache *cache;
+    unsigned found;
+} _LookupThread;
+
+static void *
+_lookup(void *parameter)
+{
+    _LookupThread *thread = parameter;
+    for (unsigned round = 0; round < 200; round++) {
+        for (unsigned i = 0; i < 16; i++) {
+            if (_contains(thread->cache, i)) {
+                thread->found++;
+            }
+        }
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Sharded, parcCryptoCache_ConcurrentLookup)
+{
+    PARCCryptoCache *cache = parcCryptoCache_CreateSharded(4, 8, NULL, NULL);
+    for (unsigned i = 0; i < 8; i++) {
+        _addKey(cache, i);
+    }
+
+    _LookupThread threads[4];
+    pthread_t ids[4];
+    for (int i = 0; i < 4; i++) {
+        threads[i].cache = cache;
+        threads[i].found = 0;
+        pthread_create(&ids[i], NULL, _lookup, &threads[i]);
+    }
+
+    // Churn the cache while the lookups run.
+    for (unsigned round = 0; round < 200; round++) {
+        _addKey(cache, 8 + (round % 8));
+        PARCKeyId *keyid = _createKeyId(round % 8);
+        parcCryptoCache_RemoveKey(cache, keyid);
+        parcKeyId_Release(&keyid);
+        _addKey(cache, round % 8);
+    }
+
+    for (int i = 0; i < 4; i++) {
+        pthread_join(ids[i], NULL);
+    }
+
+    uint64_t lookups = parcCryptoCache_GetHitCount(cache) + parcCryptoCache_GetMissCount(cache);
+    assertTrue(lookups >= 4 * 200 * 16, "Expected every lookup to be counted, actual %" PRIu64, lookups);
+    assertTrue(parcCryptoCache_Size(cache) <= 8, "Expected at most 8 keys, actual %zu", parcCryptoCache_Size(cache));
+
+    parcCryptoCache_Destroy(&cache);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -96,6 +96,33 @@ struct test_vector {
     { .crc32c = 0,          .length = 0,  .buffer = NULL }
 };
 
+static PARCBuffer *
+_createMessage(size_t length, uint8_t seed)
+{
+    PARCBuffer *result = parcBuffer_Allocate(length);
+    for (size_t i = 0; i < length; i++) {
+        parcBuffer_PutUint8(result, (uint8_t) (seed + i * 13));
+    }
+    return parcBuffer_Flip(result);
+}
+
+static PARCCryptoHash *
+_hashWithHasher(PARCCryptoHashType type, const PARCBuffer *buffer)
+{
+    PARCCryptoHasher *hasher = parcCryptoHasher_Create(type);
+    parcCryptoHasher_Init(hasher);
+    // parcCryptoHasher_UpdateBuffer cannot overlay an empty buffer.
+    if (parcBuffer_Remaining(buffer) > 0) {
+        parcCryptoHasher_UpdateBuffer(hasher, buffer);
+    }
+    PARCCryptoHash *result = parcCryptoHasher_Finalize(hasher);
+    parcCryptoHasher_Release(&hasher);
+    return result;
+}
+
+// Lengths either side of the block and padding boundaries of SHA256 and SHA512.
+static const size_t _messageLengths[] = { 0, 1, 55, 56, 63, 64, 65, 111, 112, 119, 120, 127, 128, 129, 1000, 1024 };
+#define _messageLengthsCount (sizeof(_messageLengths) / sizeof(_messageLengths[0]))
 
 LONGBOW_TEST_RUNNER(parc_CryptoHasher)
 {
@@ -132,6 +159,9 @@ LONGBOW_TEST_FIXTURE(Global)
     LONGBOW_RUN_TEST_CASE(Global, parcCryptoHasher_CRC32);
 
     LONGBOW_RUN_TEST_CASE(Global, parcCryptoHasher_CustomHasher);
+
+    LONGBOW_RUN_TEST_CASE(Global, parcCryptoHasher_HashBuffer);
+    LONGBOW_RUN_TEST_CASE(Global, parcCryptoHasher_HashMany);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Global)
@@ -331,11 +361,63 @@ LONGBOW_TEST_CASE(Global, parcCryptoHasher_CustomHasher)
     parcCryptoHasher_Release(&hasher);
 }
 
+LONGBOW_TEST_CASE(Global, parcCryptoHasher_HashBuffer)
+{
+    PARCCryptoHashType types[] = { PARCCryptoHashType_SHA256, PARCCryptoHashType_SHA512, PARCCryptoHashType_CRC32C };
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        for (size_t i = 0; i < _messageLengthsCount; i++) {
+            PARCBuffer *buffer = _createMessage(_messageLengths[i], (uint8_t) i);
+
+            PARCCryptoHash *expected = _hashWithHasher(types[t], buffer);
+            PARCCryptoHash *actual = parcCryptoHasher_HashBuffer(types[t], buffer);
+
+            assertTrue(parcCryptoHash_Equals(expected, actual),
+                       "Digest of %zu bytes with %s does not match", _messageLengths[i], parcCryptoHashType_ToString(types[t]));
+            assertTrue(parcBuffer_Position(buffer) == 0, "Expected the position of the buffer to be unchanged");
+
+            parcCryptoHash_Release(&expected);
+            parcCryptoHash_Release(&actual);
+            parcBuffer_Release(&buffer);
+        }
+    }
+}
+
+LONGBOW_TEST_CASE(Global, parcCryptoHasher_HashMany)
+{
+    PARCCryptoHashType types[] = { PARCCryptoHashType_SHA256, PARCCryptoHashType_SHA512 };
+    const size_t count = 2 * _messageLengthsCount + 3;
+
+    for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+        const PARCBuffer *buffers[count];
+        PARCCryptoHash *digests[count];
+
+        for (size_t i = 0; i < count; i++) {
+            PARCBuffer *buffer = _createMessage(_messageLengths[i % _messageLengthsCount] + 8, (uint8_t) i);
+            // Only the remaining bytes are hashed.
+            parcBuffer_SetPosition(buffer, 8);
+            buffers[i] = buffer;
+        }
+
+        parcCryptoHasher_HashMany(types[t], count, buffers, digests);
+
+        for (size_t i = 0; i < count; i++) {
+            PARCCryptoHash *expected = _hashWithHasher(types[t], buffers[i]);
+            assertTrue(parcCryptoHash_Equals(expected, digests[i]),
+                       "Digest %zu with %s does not match", i, parcCryptoHashType_ToString(types[t]));
+            parcCryptoHash_Release(&expected);
+            parcCryptoHash_Release(&digests[i]);
+            parcBuffer_Release((PARCBuffer **) &buffers[i]);
+        }
+    }
+}
+
 // ================================================
 
 LONGBOW_TEST_FIXTURE(Local)
 {
     LONGBOW_RUN_TEST_CASE(Local, computeCrc32C_Software);
+    LONGBOW_RUN_TEST_CASE(Local, sha256_HashLanes);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Local)
@@ -366,12 +448,54 @@ LONGBOW_TEST_CASE(Local, computeCrc32C_Software)
     }
 }
 
+LONGBOW_TEST_CASE(Local, sha256_HashLanes)
+{
+#if PARCCryptoHasher_SHA256_LANES > 1
+    if (!__builtin_cpu_supports("avx2")) {
+        testSkip("The CPU does not support AVX2");
+    }
+
+    // Hash every group of consecutive lengths, so each lane sees each length and the lanes finish at different blocks.
+    for (size_t start = 0; start < _messageLengthsCount; start++) {
+        size_t lanes = _messageLengthsCount - start;
+        if (lanes > PARCCryptoHasher_SHA256_LANES) {
+            lanes = PARCCryptoHasher_SHA256_LANES;
+        }
+
+        PARCBuffer *buffers[PARCCryptoHasher_SHA256_LANES];
+        const uint8_t *messages[PARCCryptoHasher_SHA256_LANES];
+        size_t lengths[PARCCryptoHasher_SHA256_LANES];
+        uint8_t digests[PARCCryptoHasher_SHA256_LANES][LENGTH_SHA256];
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            buffers[lane] = _createMessage(_messageLengths[start + lane], (uint8_t) lane);
+            messages[lane] = _parcCryptoHasher_RemainingBytes(buffers[lane], &lengths[lane]);
+        }
+
+        _sha256_HashLanes(lanes, messages, lengths, digests);
+
+        for (size_t lane = 0; lane < lanes; lane++) {
+            uint8_t expected[LENGTH_SHA256];
+            SHA256(messages[lane], lengths[lane], expected);
+            assertTrue(memcmp(expected, digests[lane], LENGTH_SHA256) == 0,
+                       "Digest of %zu bytes in lane %zu does not match", lengths[lane], lane);
+            parcBuffer_Release(&buffers[lane]);
+        }
+    }
+#else
+    testSkip("There is no multi-buffer SHA256 implementation for this platform");
+#endif
+}
+
 // =======================================================
 
 LONGBOW_TEST_FIXTURE(Performance)
 {
     LONGBOW_RUN_TEST_CASE(Performance, computeCrc32C);
     LONGBOW_RUN_TEST_CASE(Performance, computeCrc32C_Software);
+    LONGBOW_RUN_TEST_CASE(Performance, sha256_1KB_Hasher);
+    LONGBOW_RUN_TEST_CASE(Performance, sha256_1KB_HashBuffer);
+    LONGBOW_RUN_TEST_CASE(Performance, sha256_1KB_HashMany);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Performance)
@@ -436,6 +560,88 @@ LONGBOW_TEST_CASE(Performance, computeCrc32C_Software)
     printf("Best rate = %.3f for %d iterations\n", rate, maxreps);
 }
 
+#define _performanceMessages 100000
+#define _performanceBatch 64
+
+static PARCBuffer **
+_createPerformanceMessages(void)
+{
+    PARCBuffer **result = parcMemory_Allocate(_performanceBatch * sizeof(PARCBuffer *));
+    for (size_t i = 0; i < _performanceBatch; i++) {
+        result[i] = _createMessage(bufferLength, (uint8_t) i);
+    }
+    return result;
+}
+
+static void
+_releasePerformanceMessages(PARCBuffer ***messagesPtr)
+{
+    PARCBuffer **messages = *messagesPtr;
+    for (size_t i = 0; i < _performanceBatch; i++) {
+        parcBuffer_Release(&messages[i]);
+    }
+    parcMemory_Deallocate(messagesPtr);
+}
+
+static void
+_reportDigestRate(const char *name, struct timeval *t0)
+{
+    struct timeval t1;
+    gettimeofday(&t1, NULL);
+    timersub(&t1, t0, &t1);
+
+    double seconds = t1.tv_sec + t1.tv_usec * 1E-6;
+    printf("%s: %.0f digests/sec of %d bytes\n", name, _performanceMessages / seconds, bufferLength);
+}
+
+LONGBOW_TEST_CASE(Performance, sha256_1KB_Hasher)
+{
+    PARCBuffer **messages = _createPerformanceMessages();
+
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+    for (size_t i = 0; i < _performanceMessages; i++) {
+        PARCCryptoHash *digest = _hashWithHasher(PARCCryptoHashType_SHA256, messages[i % _performanceBatch]);
+        parcCryptoHash_Release(&digest);
+    }
+    _reportDigestRate("parcCryptoHasher_Create/Finalize", &t0);
+
+    _releasePerformanceMessages(&messages);
+}
+
+LONGBOW_TEST_CASE(Performance, sha256_1KB_HashBuffer)
+{
+    PARCBuffer **messages = _createPerformanceMessages();
+
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+    for (size_t i = 0; i < _performanceMessages; i++) {
+        PARCCryptoHash *digest = parcCryptoHasher_HashBuffer(PARCCryptoHashType_SHA256, messages[i % _performanceBatch]);
+        parcCryptoHash_Release(&digest);
+    }
+    _reportDigestRate("parcCryptoHasher_HashBuffer", &t0);
+
+    _releasePerformanceMessages(&messages);
+}
+
+LONGBOW_TEST_CASE(Performance, sha256_1KB_HashMany)
+{
+    PARCBuffer **messages = _createPerformanceMessages();
+    PARCCryptoHash *digests[_performanceBatch];
+
+    struct timeval t0;
+    gettimeofday(&t0, NULL);
+    for (size_t i = 0; i < _performanceMessages; i += _performanceBatch) {
+        parcCryptoHasher_HashMany(PARCCryptoHashType_SHA256, _performanceBatch, (const PARCBuffer **) messages, digests);
+        for (size_t j = 0; j < _performanceBatch; j++) {
+            parcCryptoHash_Release(&digests[j]);
+        }
+    }
+    _reportDigestRate(_sha256_UseLanes() ? "parcCryptoHasher_HashMany (AVX2 lanes)" : "parcCryptoHasher_HashMany", &t0);
+
+    _releasePerformanceMessages(&messages);
+}
+
 int
 main(int argc, char *argv[argc])
 {
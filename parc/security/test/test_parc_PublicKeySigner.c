@@ -60,17 +60,20 @@
 #include <sys/param.h>
 
 #include <fcntl.h>
+#include <unistd.h>
 
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
 
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
 
 #include <parc/testing/parc_MemoryTesting.h>
 #include <parc/testing/parc_ObjectTesting.h>
 
 #include <parc/security/parc_Pkcs12KeyStore.h>
+#include <parc/developer/parc_Stopwatch.h>
 
 LONGBOW_TEST_RUNNER(parc_PublicKeySigner)
 {
@@ -80,6 +83,7 @@ LONGBOW_TEST_RUNNER(parc_PublicKeySigner)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Object);
     LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -226,6 +230,9 @@ LONGBOW_TEST_FIXTURE(Specialization)
 {
     LONGBOW_RUN_TEST_CASE(Specialization, parcPkcs12KeyStore_VerifySignature_Cert);
     LONGBOW_RUN_TEST_CASE(Specialization, parcPkcs12KeyStore_SignBuffer);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcSigner_SignDigestAsync);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcSigner_SignDigestAsync_NoPool);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcSigner_SignBatch);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -303,6 +310,104 @@ LONGBOW_TEST_CASE(Specialization, parcPkcs12KeyStore_SignBuffer)
     parcCryptoHash_Release(&parcDigest);
 }
 
+static PARCSigner *
+_createTestSigner(void)
+{
+    PARCPkcs12KeyStore *publicKeyStore = parcPkcs12KeyStore_Open("test_rsa.p12", "blueberry", PARCCryptoHashType_SHA256);
+    PARCKeyStore *keyStore = parcKeyStore_Create(publicKeyStore, PARCPkcs12KeyStoreAsKeyStore);
+    parcPkcs12KeyStore_Release(&publicKeyStore);
+
+    PARCPublicKeySigner *publicKeySigner = parcPublicKeySigner_Create(keyStore, PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256);
+    parcKeyStore_Release(&keyStore);
+    PARCSigner *signer = parcSigner_Create(publicKeySigner, PARCPublicKeySignerAsSigner);
+    parcPublicKeySigner_Release(&publicKeySigner);
+
+    return signer;
+}
+
+static PARCCryptoHash *
+_createDigest(size_t index)
+{
+    PARCBuffer *buffer = parcBuffer_Allocate(sizeof(index));
+    parcBuffer_Flip(parcBuffer_PutUint64(buffer, index));
+    PARCCryptoHash *result = parcCryptoHasher_HashBuffer(PARCCryptoHashType_SHA256, buffer);
+    parcBuffer_Release(&buffer);
+
+    return result;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcSigner_SignDigestAsync)
+{
+    PARCSigner *signer = _createTestSigner();
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+
+    PARCCryptoHash *digest = _createDigest(1);
+    PARCSignature *expected = parcSigner_SignDigest(signer, digest);
+
+    PARCFutureTask *task = parcSigner_SignDigestAsync(signer, pool, digest);
+    PARCFutureTaskResult taskResult = parcFutureTask_Get(task, PARCTimeout_Never);
+    assertTrue(taskResult.execution == PARCExecution_OK, "Expected the signing task to complete");
+
+    PARCSignature *actual = parcSignature_Acquire(taskResult.value);
+    parcFutureTask_Release(&task);
+
+    assertTrue(parcBuffer_Equals(parcSignature_GetSignature(expected), parcSignature_GetSignature(actual)),
+               "Expected the asynchronous signature to equal the synchronous one");
+
+    parcSignature_Release(&actual);
+    parcSignature_Release(&expected);
+    parcCryptoHash_Release(&digest);
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    parcSigner_Release(&signer);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcSigner_SignDigestAsync_NoPool)
+{
+    PARCSigner *signer = _createTestSigner();
+    PARCCryptoHash *digest = _createDigest(2);
+
+    PARCFutureTask *task = parcSigner_SignDigestAsync(signer, NULL, digest);
+    assertTrue(parcFutureTask_IsDone(task), "Expected the task to be done when there is no pool");
+
+    // Releasing the task without collecting the signature must not leak it.
+    parcFutureTask_Release(&task);
+
+    parcCryptoHash_Release(&digest);
+    parcSigner_Release(&signer);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcSigner_SignBatch)
+{
+    PARCSigner *signer = _createTestSigner();
+    PARCThreadPool *pool = parcThreadPool_Create(3);
+
+    size_t count = 37;
+    PARCCryptoHash *digests[count];
+    PARCSignature *signatures[count];
+    for (size_t i = 0; i < count; i++) {
+        digests[i] = _createDigest(i);
+        signatures[i] = NULL;
+    }
+
+    size_t actual = parcSigner_SignBatch(signer, pool, count, digests, signatures);
+    assertTrue(actual == count, "Expected %zu signatures, actual %zu", count, actual);
+
+    for (size_t i = 0; i < count; i++) {
+        assertNotNull(signatures[i], "Expected signature %zu to be set", i);
+        PARCSignature *expected = parcSigner_SignDigest(signer, digests[i]);
+        assertTrue(parcBuffer_Equals(parcSignature_GetSignature(expected), parcSignature_GetSignature(signatures[i])),
+                   "Expected signature %zu to equal the synchronous one", i);
+        parcSignature_Release(&expected);
+        parcSignature_Release(&signatures[i]);
+        parcCryptoHash_Release(&digests[i]);
+    }
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    parcSigner_Release(&signer);
+}
+
 LONGBOW_TEST_CASE(Global, parcSigner_GetCertificateDigest)
 {
     char dirname[] = "pubkeystore_XXXXXX";
@@ -485,6 +590,72 @@ LONGBOW_TEST_CASE(Global, parcSigner_CreateKeyId)
     parcSigner_Release(&signer);
 }
 
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcSigner_SignBatch_Rate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    parcSecurity_Init();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcSecurity_Fini();
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static double
+_signaturesPerSecond(PARCSigner *signer, int threads, size_t count, PARCCryptoHash *digests[count])
+{
+    // The calling thread signs too, so a pool of threads - 1 keeps the given number of cores busy.
+    PARCThreadPool *pool = (threads > 1) ? parcThreadPool_Create(threads - 1) : NULL;
+    PARCSignature *signatures[count];
+
+    PARCStopwatch *timer = parcStopwatch_Create();
+    parcStopwatch_Start(timer);
+    parcSigner_SignBatch(signer, pool, count, digests, signatures);
+    uint64_t elapsed = parcStopwatch_ElapsedTimeNanos(timer);
+    parcStopwatch_Release(&timer);
+
+    for (size_t i = 0; i < count; i++) {
+        parcSignature_Release(&signatures[i]);
+    }
+    if (pool != NULL) {
+        parcThreadPool_ShutdownNow(pool);
+        parcThreadPool_Release(&pool);
+    }
+
+    return (double) count * 1000000000.0 / (double) elapsed;
+}
+
+LONGBOW_TEST_CASE(Performance, parcSigner_SignBatch_Rate)
+{
+    PARCSigner *signer = _createTestSigner();
+
+    size_t count = 4096;
+    PARCCryptoHash **digests = parcMemory_Allocate(count * sizeof(PARCCryptoHash *));
+    for (size_t i = 0; i < count; i++) {
+        digests[i] = _createDigest(i);
+    }
+
+    int cores = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    int threads[] = { 1, 4, cores };
+    for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+        printf("%3d cores: %10.0f signatures/sec\n", threads[i], _signaturesPerSecond(signer, threads[i], count, digests));
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        parcCryptoHash_Release(&digests[i]);
+    }
+    parcMemory_Deallocate((void **) &digests);
+    parcSigner_Release(&signer);
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -59,6 +59,136 @@
 
 #include <LongBow/unit-test.h>
 
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_StdlibMemory.h>
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/developer/parc_Stopwatch.h>
+#include <parc/security/parc_Security.h>
+#include <parc/security/parc_InMemoryVerifier.h>
+
+#include <openssl/evp.h>
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+/*
+ * A batch of signatures made with locally generated RSA keys, and a verifier that knows the keys.
+ */
+typedef struct {
+    PARCVerifier *verifier;
+    size_t keyCount;
+    PARCKeyId **keyIds;
+    size_t count;
+    PARCVerifierBatchEntry *entries;
+} _TestBatch;
+
+static EVP_PKEY *
+_generateRSAKey(int bits)
+{
+    EVP_PKEY *result = NULL;
+
+    EVP_PKEY_CTX *context = EVP_PKEY_CTX_new_id(EVP_PKEY_RSA, NULL);
+    EVP_PKEY_keygen_init(context);
+    EVP_PKEY_CTX_set_rsa_keygen_bits(context, bits);
+    EVP_PKEY_keygen(context, &result);
+    EVP_PKEY_CTX_free(context);
+
+    assertNotNull(result, "Could not generate an RSA key");
+    return result;
+}
+
+static PARCSignature *
+_sign(EVP_PKEY *privateKey, const PARCCryptoHash *digest)
+{
+    PARCBuffer *digestBuffer = parcCryptoHash_GetDigest(digest);
+
+    EVP_PKEY_CTX *context = EVP_PKEY_CTX_new(privateKey, NULL);
+    EVP_PKEY_sign_init(context);
+    EVP_PKEY_CTX_set_rsa_padding(context, RSA_PKCS1_PADDING);
+    EVP_PKEY_CTX_set_signature_md(context, EVP_sha256());
+
+    size_t signatureLength = (size_t) EVP_PKEY_size(privateKey);
+    PARCBuffer *signatureBuffer = parcBuffer_Allocate(signatureLength);
+    int success = EVP_PKEY_sign(context, parcBuffer_Overlay(signatureBuffer, 0), &signatureLength,
+                                parcBuffer_Overlay(digestBuffer, 0), parcBuffer_Remaining(digestBuffer));
+    assertTrue(success == 1, "EVP_PKEY_sign failed");
+    EVP_PKEY_CTX_free(context);
+    parcBuffer_SetLimit(signatureBuffer, signatureLength);
+
+    PARCSignature *result = parcSignature_Create(PARCSigningAlgorithm_RSA, PARCCryptoHashType_SHA256, signatureBuffer);
+    parcBuffer_Release(&signatureBuffer);
+    return result;
+}
+
+static _TestBatch *
+_createBatch(size_t keyCount, size_t count)
+{
+    _TestBatch *batch = parcMemory_AllocateAndClear(sizeof(_TestBatch));
+    batch->keyCount = keyCount;
+    batch->keyIds = parcMemory_AllocateAndClear(keyCount * sizeof(PARCKeyId *));
+    batch->count = count;
+    batch->entries = parcMemory_AllocateAndClear(count * sizeof(PARCVerifierBatchEntry));
+
+    PARCInMemoryVerifier *inMemoryVerifier = parcInMemoryVerifier_Create();
+    batch->verifier = parcVerifier_Create(inMemoryVerifier, PARCInMemoryVerifierAsVerifier);
+    parcInMemoryVerifier_Release(&inMemoryVerifier);
+
+    EVP_PKEY *privateKeys[keyCount];
+    for (size_t k = 0; k < keyCount; k++) {
+        privateKeys[k] = _generateRSAKey(2048);
+
+        uint8_t *der = NULL;
+        int derLength = i2d_PUBKEY(privateKeys[k], &der);
+        PARCBuffer *derBuffer = parcBuffer_Flip(parcBuffer_PutArray(parcBuffer_Allocate(derLength), derLength, der));
+        OPENSSL_free(der);
+
+        PARCCryptoHash *keyHash = parcCryptoHasher_HashBuffer(PARCCryptoHashType_SHA256, derBuffer);
+        batch->keyIds[k] = parcKeyId_Create(parcCryptoHash_GetDigest(keyHash));
+        parcCryptoHash_Release(&keyHash);
+
+        PARCKey *key = parcKey_CreateFromDerEncodedPublicKey(batch->keyIds[k], PARCSigningAlgorithm_RSA, derBuffer);
+        parcVerifier_AddKey(batch->verifier, key);
+        parcKey_Release(&key);
+        parcBuffer_Release(&derBuffer);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        PARCBuffer *content = parcBuffer_Flip(parcBuffer_PutUint64(parcBuffer_Allocate(sizeof(uint64_t)), i));
+
+        PARCVerifierBatchEntry *entry = &batch->entries[i];
+        entry->keyId = batch->keyIds[i % keyCount];
+        entry->digest = parcCryptoHasher_HashBuffer(PARCCryptoHashType_SHA256, content);
+        entry->suite = PARCCryptoSuite_RSA_SHA256;
+        entry->signature = _sign(privateKeys[i % keyCount], entry->digest);
+        entry->verified = false;
+
+        parcBuffer_Release(&content);
+    }
+
+    for (size_t k = 0; k < keyCount; k++) {
+        EVP_PKEY_free(privateKeys[k]);
+    }
+
+    return batch;
+}
+
+static void
+_destroyBatch(_TestBatch **batchPtr)
+{
+    _TestBatch *batch = *batchPtr;
+
+    for (size_t i = 0; i < batch->count; i++) {
+        parcCryptoHash_Release(&batch->entries[i].digest);
+        parcSignature_Release(&batch->entries[i].signature);
+    }
+    for (size_t k = 0; k < batch->keyCount; k++) {
+        parcKeyId_Release(&batch->keyIds[k]);
+    }
+    parcVerifier_Release(&batch->verifier);
+    parcMemory_Deallocate(&batch->entries);
+    parcMemory_Deallocate(&batch->keyIds);
+    parcMemory_Deallocate(batchPtr);
+}
+
 LONGBOW_TEST_RUNNER(parc_Verifier)
 {
     // The following Test Fixtures will run their corresponding Test Cases.
@@ -66,6 +196,8 @@ LONGBOW_TEST_RUNNER(parc_Verifier)
     // Never rely on the execution order of tests or share state between them.
     LONGBOW_RUN_TEST_FIXTURE(Global);
     LONGBOW_RUN_TEST_FIXTURE(Local);
+    LONGBOW_RUN_TEST_FIXTURE(Batch);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -150,6 +282,129 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Local)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_FIXTURE(Batch)
+{
+    LONGBOW_RUN_TEST_CASE(Batch, parcVerifier_VerifyBatch);
+    LONGBOW_RUN_TEST_CASE(Batch, parcVerifier_VerifyBatch_NoPool);
+    LONGBOW_RUN_TEST_CASE(Batch, parcVerifier_VerifyBatch_Rejected);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Batch)
+{
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    parcSecurity_Init();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Batch)
+{
+    parcSecurity_Fini();
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Batch, parcVerifier_VerifyBatch)
+{
+    _TestBatch *batch = _createBatch(3, 100);
+    PARCThreadPool *pool = parcThreadPool_Create(3);
+
+    size_t verified = parcVerifier_VerifyBatch(batch->verifier, pool, batch->count, batch->entries);
+    assertTrue(verified == batch->count, "Expected %zu verified signatures, actual %zu", batch->count, verified);
+    for (size_t i = 0; i < batch->count; i++) {
+        assertTrue(batch->entries[i].verified, "Expected entry %zu to verify", i);
+    }
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    _destroyBatch(&batch);
+}
+
+LONGBOW_TEST_CASE(Batch, parcVerifier_VerifyBatch_NoPool)
+{
+    _TestBatch *batch = _createBatch(2, 20);
+
+    size_t verified = parcVerifier_VerifyBatch(batch->verifier, NULL, batch->count, batch->entries);
+    assertTrue(verified == batch->count, "Expected %zu verified signatures, actual %zu", batch->count, verified);
+
+    _destroyBatch(&batch);
+}
+
+LONGBOW_TEST_CASE(Batch, parcVerifier_VerifyBatch_Rejected)
+{
+    _TestBatch *batch = _createBatch(2, 40);
+    PARCThreadPool *pool = parcThreadPool_Create(2);
+
+    // Pair every other signature with the digest of a different entry.
+    for (size_t i = 0; i < batch->count; i += 2) {
+        PARCCryptoHash *digest = batch->entries[i].digest;
+        batch->entries[i].digest = batch->entries[i + 1].digest;
+        batch->entries[i + 1].digest = digest;
+    }
+    for (size_t i = 1; i < batch->count; i += 4) {
+        PARCCryptoHash *digest = batch->entries[i].digest;
+        batch->entries[i].digest = batch->entries[i - 1].digest;
+        batch->entries[i - 1].digest = digest;
+    }
+
+    size_t verified = parcVerifier_VerifyBatch(batch->verifier, pool, batch->count, batch->entries);
+    assertTrue(verified == batch->count / 2, "Expected %zu verified signatures, actual %zu", batch->count / 2, verified);
+    for (size_t i = 0; i < batch->count; i++) {
+        bool expected = (i % 4) < 2;
+        assertTrue(batch->entries[i].verified == expected, "Expected entry %zu to %s", i, expected ? "verify" : "be rejected");
+    }
+
+    parcThreadPool_ShutdownNow(pool);
+    parcThreadPool_Release(&pool);
+    _destroyBatch(&batch);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcVerifier_VerifyBatch_Rate);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    parcMemory_SetInterface(&PARCStdlibMemoryAsPARCMemory);
+    parcSecurity_Init();
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    parcSecurity_Fini();
+    parcMemory_SetInterface(&PARCSafeMemoryAsPARCMemory);
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Performance, parcVerifier_VerifyBatch_Rate)
+{
+    _TestBatch *batch = _createBatch(4, 10000);
+
+    for (int threads = 0; threads <= 8; threads = (threads == 0) ? 1 : threads * 2) {
+        PARCThreadPool *pool = (threads == 0) ? NULL : parcThreadPool_Create(threads);
+
+        PARCStopwatch *stopwatch = parcStopwatch_Create();
+        parcStopwatch_Start(stopwatch);
+        size_t verified = parcVerifier_VerifyBatch(batch->verifier, pool, batch->count, batch->entries);
+        uint64_t nanos = parcStopwatch_ElapsedTimeNanos(stopwatch);
+        parcStopwatch_Release(&stopwatch);
+
+        assertTrue(verified == batch->count, "Expected %zu verified signatures, actual %zu", batch->count, verified);
+        printf("%d pool threads: %.0f verifications/sec\n", threads, batch->count / (nanos / 1000000000.0));
+
+        if (pool != NULL) {
+            parcThreadPool_ShutdownNow(pool);
+            parcThreadPool_Release(&pool);
+        }
+    }
+
+    _destroyBatch(&batch);
+}
+
 int
 main(int argc, char *argv[])
 {
@@ -66,24 +66,210 @@
 
 #include <parc/statistics/parc_BasicStats.h>
 
+#define _CACHE_LINE 64
+#define _SHARDS 32
+
+typedef struct parc_basic_stats_shard _PARCBasicStatsShard;
+
 struct PARCBasicStats {
     int64_t count;
     double maximum;
     double minimum;
     double mean;
     double variance;
+
+    // Non-NULL if this instance was created by parcBasicStats_CreateConcurrent.
+    _PARCBasicStatsShard *shards;
 };
 
+/*
+ * Each shard is a private accumulator for the threads mapped to it.
+ * The sequence number is odd while a writer is updating the shard,
+ * so a reader can detect, and retry, a read that overlapped an update without ever making the writer wait.
+ */
+struct parc_basic_stats_shard {
+    union {
+        struct {
+            volatile uint64_t sequence;
+            struct PARCBasicStats values;
+        };
+        char pad[((sizeof(uint64_t) + sizeof(struct PARCBasicStats) + _CACHE_LINE - 1) / _CACHE_LINE) * _CACHE_LINE];
+    };
+};
+
+static unsigned _parcBasicStats_NextThreadIndex;
+
+static __thread unsigned _parcBasicStats_ThreadIndex;
+
 static inline bool
 _parcBasicStats_FloatEquals(double x, double y, double e)
 {
     return fabs(x-y) < e;
 }
 
+/**
+ * Combine a set of observed values summarised by @p count, @p mean, @p variance, @p minimum and @p maximum into @p stats.
+ *
+ * This is the pairwise update of Chan, Golub and LeVeque, and is exact up to floating point rounding.
+ */
+static void
+_parcBasicStats_Combine(PARCBasicStats *stats, int64_t count, double mean, double variance, double minimum, double maximum)
+{
+    if (count == 0) {
+        return;
+    }
+
+    if (stats->count == 0) {
+        stats->count = count;
+        stats->mean = mean;
+        stats->variance = variance;
+        stats->minimum = minimum;
+        stats->maximum = maximum;
+        return;
+    }
+
+    int64_t total = stats->count + count;
+    double delta = mean - stats->mean;
+
+    double sumOfSquares = stats->variance * stats->count + variance * count
+                          + delta * delta * ((double) stats->count * (double) count / (double) total);
+
+    stats->mean = stats->mean + delta * (double) count / (double) total;
+    stats->variance = sumOfSquares / (double) total;
+    stats->count = total;
+
+    if (minimum < stats->minimum) {
+        stats->minimum = minimum;
+    }
+    if (maximum > stats->maximum) {
+        stats->maximum = maximum;
+    }
+}
+
+static void
+_parcBasicStats_Accumulate(PARCBasicStats *stats, double value)
+{
+    stats->count++;
+
+    if (stats->count == 1) {
+        stats->maximum = value;
+        stats->minimum = value;
+    }
+
+    if (value > stats->maximum) {
+        stats->maximum = value;
+    }
+
+    if (value < stats->minimum) {
+        stats->minimum = value;
+    }
+
+    double mean_ = stats->mean;
+
+    double xMinusOldMean = value - mean_;
+
+    stats->mean = mean_ + xMinusOldMean / stats->count;
+
+    double xMinusCurrentMean = value - stats->mean;
+
+    stats->variance = ((stats->variance * (stats->count - 1)) + xMinusOldMean * xMinusCurrentMean) / stats->count;
+}
+
+static _PARCBasicStatsShard *
+_parcBasicStats_ThreadShard(const PARCBasicStats *stats)
+{
+    if (_parcBasicStats_ThreadIndex == 0) {
+        _parcBasicStats_ThreadIndex = __sync_add_and_fetch(&_parcBasicStats_NextThreadIndex, 1);
+    }
+    return &stats->shards[_parcBasicStats_ThreadIndex % _SHARDS];
+}
+
+/**
+ * Begin writing to a shard.
+ *
+ * Only threads sharing the shard, which happens when there are more than _SHARDS threads, ever wait here.
+ */
+static void
+_parcBasicStats_ShardBeginWrite(_PARCBasicStatsShard *shard)
+{
+    for (;;) {
+        uint64_t sequence = shard->sequence;
+        if ((sequence & 1) == 0 && __sync_bool_compare_and_swap(&shard->sequence, sequence, sequence + 1)) {
+            break;
+        }
+    }
+}
+
+static void
+_parcBasicStats_ShardEndWrite(_PARCBasicStatsShard *shard)
+{
+    __atomic_store_n(&shard->sequence, shard->sequence + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Read a consistent copy of a shard, retrying if a writer updated the shard while it was being read.
+ */
+static void
+_parcBasicStats_ShardRead(const _PARCBasicStatsShard *shard, PARCBasicStats *values)
+{
+    for (;;) {
+        uint64_t before = __atomic_load_n(&shard->sequence, __ATOMIC_ACQUIRE);
+        if ((before & 1) == 0) {
+            values->count = shard->values.count;
+            values->mean = shard->values.mean;
+            values->variance = shard->values.variance;
+            values->minimum = shard->values.minimum;
+            values->maximum = shard->values.maximum;
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (shard->sequence == before) {
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * Merge every shard of a concurrent instance into @p snapshot.
+ */
+static void
+_parcBasicStats_Collect(const PARCBasicStats *stats, PARCBasicStats *snapshot)
+{
+    snapshot->count = 0;
+    snapshot->mean = 0;
+    snapshot->variance = 0;
+    snapshot->maximum = 0;
+    snapshot->minimum = 0;
+    snapshot->shards = NULL;
+
+    for (int i = 0; i < _SHARDS; i++) {
+        PARCBasicStats values;
+        _parcBasicStats_ShardRead(&stats->shards[i], &values);
+        _parcBasicStats_Combine(snapshot, values.count, values.mean, values.variance, values.minimum, values.maximum);
+    }
+}
+
+/**
+ * Return @p stats itself, or for a concurrent instance a snapshot of it held in @p snapshot.
+ */
+static const PARCBasicStats *
+_parcBasicStats_View(const PARCBasicStats *stats, PARCBasicStats *snapshot)
+{
+    if (stats->shards == NULL) {
+        return stats;
+    }
+    _parcBasicStats_Collect(stats, snapshot);
+    return snapshot;
+}
+
 static bool
 _parcBasicStats_Destructor(PARCBasicStats **instancePtr)
 {
     assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCBasicStats pointer.");
+    PARCBasicStats *stats = *instancePtr;
+
+    if (stats->shards != NULL) {
+        parcMemory_Deallocate((void **) &stats->shards);
+    }
 
     return true;
 }
@@ -122,6 +308,22 @@ parcBasicStats_Create(void)
         result->variance = 0;
         result->maximum = 0;
         result->minimum = 0;
+        result->shards = NULL;
+    }
+
+    return result;
+}
+
+PARCBasicStats *
+parcBasicStats_CreateConcurrent(void)
+{
+    PARCBasicStats *result = parcBasicStats_Create();
+
+    if (result != NULL) {
+        result->shards = parcMemory_AllocateAndClear(_SHARDS * sizeof(_PARCBasicStatsShard));
+        if (result->shards == NULL) {
+            parcBasicStats_Release(&result);
+        }
     }
 
     return result;
@@ -138,6 +340,9 @@ parcBasicStats_Compare(const PARCBasicStats *instance, const PARCBasicStats *oth
 PARCBasicStats *
 parcBasicStats_Copy(const PARCBasicStats *original)
 {
+    PARCBasicStats snapshot;
+    original = _parcBasicStats_View(original, &snapshot);
+
     PARCBasicStats *result = parcBasicStats_Create();
     result->count = original->count;
     result->mean = original->mean;
@@ -151,6 +356,9 @@ parcBasicStats_Copy(const PARCBasicStats *original)
 void
 parcBasicStats_Display(const PARCBasicStats *stats, int indentation)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     parcDisplayIndented_PrintLine(indentation,
                                   "PARCBasicStats@%p { .count=%" PRId64 " .minimum=%llf .maximum=%llf .mean=%llf }",
                                   stats, stats->count, stats->minimum, stats->maximum, stats->mean);
@@ -166,6 +374,11 @@ parcBasicStats_Equals(const PARCBasicStats *x, const PARCBasicStats *y)
     } else if (x == NULL || y == NULL) {
         result = false;
     } else {
+        PARCBasicStats xSnapshot;
+        PARCBasicStats ySnapshot;
+        x = _parcBasicStats_View(x, &xSnapshot);
+        y = _parcBasicStats_View(y, &ySnapshot);
+
         if (x->count == y->count) {
             if (_parcBasicStats_FloatEquals(x->maximum, y->maximum, 0.00001)) {
                 if (_parcBasicStats_FloatEquals(x->minimum, y->minimum, 0.00001)) {
@@ -203,6 +416,9 @@ parcBasicStats_IsValid(const PARCBasicStats *stats)
 PARCJSON *
 parcBasicStats_ToJSON(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     PARCJSON *result = parcJSON_Create();
 
     if (result != NULL) {
@@ -233,6 +449,9 @@ parcBasicStats_ToJSON(const PARCBasicStats *stats)
 char *
 parcBasicStats_ToString(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     char *result = parcMemory_Format("PARCBasicStats@%p { .count=%" PRId64 " .minimum=%llf .maximum=%llf .mean=%llf }",
                                      stats, stats->count, stats->minimum, stats->maximum, stats->mean);
 
@@ -242,59 +461,88 @@ parcBasicStats_ToString(const PARCBasicStats *stats)
 void
 parcBasicStats_Update(PARCBasicStats *stats, double value)
 {
-    stats->count++;
-
-    if (value > stats->maximum) {
-        stats->maximum = value;
-    }
-
-    if (value < stats->minimum) {
-        stats->minimum = value;
+    if (stats->shards == NULL) {
+        _parcBasicStats_Accumulate(stats, value);
+    } else {
+        _PARCBasicStatsShard *shard = _parcBasicStats_ThreadShard(stats);
+        _parcBasicStats_ShardBeginWrite(shard);
+        _parcBasicStats_Accumulate(&shard->values, value);
+        _parcBasicStats_ShardEndWrite(shard);
     }
+}
 
-    double mean_ = stats->mean;
-
-    double xMinusOldMean = value - mean_;
-
-    stats->mean = mean_ + xMinusOldMean / stats->count;
+void
+parcBasicStats_Merge(PARCBasicStats *stats, const PARCBasicStats *other)
+{
+    PARCBasicStats snapshot;
+    other = _parcBasicStats_View(other, &snapshot);
 
-    double xMinusCurrentMean = value - stats->mean;
+    if (stats->shards == NULL) {
+        _parcBasicStats_Combine(stats, other->count, other->mean, other->variance, other->minimum, other->maximum);
+    } else {
+        _PARCBasicStatsShard *shard = _parcBasicStats_ThreadShard(stats);
+        _parcBasicStats_ShardBeginWrite(shard);
+        _parcBasicStats_Combine(&shard->values, other->count, other->mean, other->variance, other->minimum, other->maximum);
+        _parcBasicStats_ShardEndWrite(shard);
+    }
+}
 
-    stats->variance = ((stats->variance * (stats->count - 1)) + xMinusOldMean * xMinusCurrentMean) / stats->count;
+PARCBasicStats *
+parcBasicStats_Snapshot(const PARCBasicStats *stats)
+{
+    return parcBasicStats_Copy(stats);
 }
 
 double
 parcBasicStats_Mean(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     return stats->mean;
 }
 
 double
 parcBasicStats_Variance(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     return stats->variance;
 }
 
 double
 parcBasicStats_StandardDeviation(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     return sqrt(stats->variance);
 }
 
 double
 parcBasicStats_Maximum(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     return stats->maximum;
 }
 
 double
 parcBasicStats_Minimum(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     return stats->minimum;
 }
 
 double
 parcBasicStats_Range(const PARCBasicStats *stats)
 {
+    PARCBasicStats snapshot;
+    stats = _parcBasicStats_View(stats, &snapshot);
+
     return stats->maximum - stats->minimum;
 }
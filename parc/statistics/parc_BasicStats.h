@@ -140,6 +140,35 @@ void parcBasicStats_AssertValid(const PARCBasicStats *instance);
  */
 PARCBasicStats *parcBasicStats_Create(void);
 
+/**
+ * Create an instance of PARCBasicStats that many threads may update at once.
+ *
+ * Each thread accumulates into one of a fixed set of private shards,
+ * so concurrent calls to `parcBasicStats_Update` do not contend with each other.
+ * Every function that reads the statistics reads a consistent snapshot of all shards merged together,
+ * without blocking the threads that are updating them.
+ *
+ * @return non-NULL A pointer to a valid PARCBasicStats instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBasicStats *stats = parcBasicStats_CreateConcurrent();
+ *
+ *     // In any number of threads
+ *     parcBasicStats_Update(stats, latency);
+ *
+ *     PARCBasicStats *snapshot = parcBasicStats_Snapshot(stats);
+ *     printf("%f\n", parcBasicStats_Mean(snapshot));
+ *     parcBasicStats_Release(&snapshot);
+ *
+ *     parcBasicStats_Release(&stats);
+ * }
+ * @endcode
+ */
+PARCBasicStats *parcBasicStats_CreateConcurrent(void);
+
 /**
  * Compares @p instance with @p other for order.
  *
@@ -409,6 +438,42 @@ char *parcBasicStats_ToString(const PARCBasicStats *instance);
  */
 void parcBasicStats_Update(PARCBasicStats *stats, double value);
 
+/**
+ * Add the values observed by @p other to the observed set of values of @p stats.
+ *
+ * The result is the same, up to floating point rounding, as if every value given to @p other had been given to @p stats.
+ * This allows per-thread instances to be combined into one.
+ *
+ * @param [in] stats A pointer to a valid `PARCBasicStats` instance.
+ * @param [in] other A pointer to a valid `PARCBasicStats` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCBasicStats *total = parcBasicStats_Create();
+ *
+ *     for (int i = 0; i < threadCount; i++) {
+ *         parcBasicStats_Merge(total, perThread[i]);
+ *     }
+ * }
+ * @endcode
+ */
+void parcBasicStats_Merge(PARCBasicStats *stats, const PARCBasicStats *other);
+
+/**
+ * Create a new instance of `PARCBasicStats` holding the current statistics of @p stats.
+ *
+ * If @p stats was created by `parcBasicStats_CreateConcurrent`, the snapshot is consistent per shard
+ * and never blocks threads updating @p stats.
+ * The result is an ordinary, single-threaded, instance.
+ *
+ * @param [in] stats A pointer to a valid `PARCBasicStats` instance.
+ *
+ * @return non-NULL A pointer to a valid PARCBasicStats instance.
+ * @return NULL An error occurred.
+ */
+PARCBasicStats *parcBasicStats_Snapshot(const PARCBasicStats *stats);
+
 /**
  * The arithmetic mean of the set of observed values.
  *
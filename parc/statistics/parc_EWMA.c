@@ -71,6 +71,9 @@ struct PARCEWMA {
     int64_t value;
     double coefficient;
     double coefficient_r;
+
+    // Non-zero if the coefficient of each update is computed from the elapsed time.
+    double timeConstant;
 };
 
 static inline bool
@@ -117,6 +120,20 @@ parcEWMA_Create(double coefficient)
         result->value = 0;
         result->coefficient = coefficient;
         result->coefficient_r = 1.0 - coefficient;
+        result->timeConstant = 0;
+    }
+
+    return result;
+}
+
+PARCEWMA *
+parcEWMA_CreateTimeDecay(uint64_t timeConstantNanoseconds)
+{
+    assertTrue(timeConstantNanoseconds > 0, "The time constant must be greater than 0");
+
+    PARCEWMA *result = parcEWMA_Create(1.0);
+    if (result != NULL) {
+        result->timeConstant = (double) timeConstantNanoseconds;
     }
 
     return result;
@@ -144,6 +161,7 @@ PARCEWMA *
 parcEWMA_Copy(const PARCEWMA *original)
 {
     PARCEWMA *result = parcEWMA_Create(original->coefficient);
+    result->timeConstant = original->timeConstant;
     result->initialized = original->initialized;
     result->value = original->value;
 
@@ -172,7 +190,7 @@ parcEWMA_Equals(const PARCEWMA *x, const PARCEWMA *y)
         result = false;
     } else {
         if (x->initialized == y->initialized) {
-            if (_parcEWMA_FloatEquals(x->coefficient, y->coefficient, 0.00001)) {
+            if (_parcEWMA_FloatEquals(x->coefficient, y->coefficient, 0.00001) && x->timeConstant == y->timeConstant) {
                 if (_parcEWMA_FloatEquals(x->value, y->value, 0.00001)) {
                     result = true;
                 }
@@ -225,13 +243,13 @@ parcEWMA_ToString(const PARCEWMA *ewma)
     return result;
 }
 
-int64_t
-parcEWMA_Update(PARCEWMA *ewma, const int64_t value)
+static int64_t
+_parcEWMA_Update(PARCEWMA *ewma, const int64_t value, double coefficient, double coefficient_r)
 {
     if (ewma->initialized) {
         // E_t = a * V + (1 - a) * E_(t-1)
-        double x = (ewma->coefficient * value);
-        double y = (ewma->coefficient_r * ewma->value);
+        double x = (coefficient * value);
+        double y = (coefficient_r * ewma->value);
 
         ewma->value = x + y;
     } else {
@@ -241,6 +259,24 @@ parcEWMA_Update(PARCEWMA *ewma, const int64_t value)
     return ewma->value;
 }
 
+int64_t
+parcEWMA_Update(PARCEWMA *ewma, const int64_t value)
+{
+    return _parcEWMA_Update(ewma, value, ewma->coefficient, ewma->coefficient_r);
+}
+
+int64_t
+parcEWMA_UpdateElapsed(PARCEWMA *ewma, const int64_t value, uint64_t elapsedNanoseconds)
+{
+    if (ewma->timeConstant == 0) {
+        return parcEWMA_Update(ewma, value);
+    }
+
+    // The weight of the previous value after decaying for the elapsed time.
+    double decay = exp(-(double) elapsedNanoseconds / ewma->timeConstant);
+    return _parcEWMA_Update(ewma, value, 1.0 - decay, decay);
+}
+
 int64_t
 parcEWMA_GetValue(const PARCEWMA *ewma)
 {
@@ -147,6 +147,30 @@ void parcEWMA_AssertValid(const PARCEWMA *instance);
  */
 PARCEWMA *parcEWMA_Create(double coefficient);
 
+/**
+ * Create an instance of PARCEWMA whose smoothing depends on elapsed time rather than on the number of samples.
+ *
+ * Each update made with `parcEWMA_UpdateElapsed` uses the coefficient _1 - e^(-elapsed / timeConstant)_,
+ * so a value observed `timeConstant` nanoseconds ago has a weight of _1/e_ relative to the newest value
+ * however often the filter is updated.
+ * This is the decay used by the Unix 1, 5 and 15 minute load averages.
+ *
+ * @param [in] timeConstantNanoseconds The time constant of the decay in nanoseconds, greater than 0.
+ *
+ * @return non-NULL A pointer to a valid PARCEWMA instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEWMA *oneMinute = parcEWMA_CreateTimeDecay(60 * 1000000000ULL);
+ *
+ *     parcEWMA_Release(&oneMinute);
+ * }
+ * @endcode
+ */
+PARCEWMA *parcEWMA_CreateTimeDecay(uint64_t timeConstantNanoseconds);
+
 /**
  * Compares @p instance with @p other for order.
  *
@@ -428,6 +452,31 @@ char *parcEWMA_ToString(const PARCEWMA *instance);
  */
 int64_t parcEWMA_Update(PARCEWMA *ewma, const int64_t value);
 
+/**
+ * Update the given `PARCEWMA` filter with a value observed over the given elapsed time.
+ *
+ * If @p ewma was created by `parcEWMA_CreateTimeDecay`, the weight of the new value grows with @p elapsedNanoseconds.
+ * Otherwise this is the same as `parcEWMA_Update`.
+ *
+ * @param [in] ewma A pointer to a valid `PARCEWMA` instance.
+ * @param [in] value The new value.
+ * @param [in] elapsedNanoseconds The time, in nanoseconds, since the previous update.
+ *
+ * @return The current exponentitally smoothed value of the filter.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCEWMA *ewma = parcEWMA_CreateTimeDecay(60 * 1000000000ULL);
+ *
+ *     parcEWMA_UpdateElapsed(ewma, 100, 5 * 1000000000ULL);
+ *
+ *     parcEWMA_Release(&ewma);
+ * }
+ * @endcode
+ */
+int64_t parcEWMA_UpdateElapsed(PARCEWMA *ewma, const int64_t value, uint64_t elapsedNanoseconds);
+
 /**
  * Get the current exponentitally smoothed value of the filter.
  *
@@ -0,0 +1,565 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * The counters are laid out as in HdrHistogram.
+ * With S sub-buckets per bucket (a power of 2), bucket 0 counts the values 0 to S - 1 exactly,
+ * and each bucket b > 0 counts the values S/2 * 2^b to S * 2^b - 1 in S/2 sub-buckets of width 2^b.
+ * Bucket b > 0 therefore only needs the upper half of its sub-buckets, so the counters of bucket b start at (b + 1) * S/2.
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <math.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_DisplayIndented.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/statistics/parc_Histogram.h>
+
+struct PARCHistogram {
+    uint64_t highestTrackableValue;
+    int significantDigits;
+
+    // log2 of half the number of sub-buckets per bucket.
+    int subBucketHalfCountMagnitude;
+    uint64_t subBucketHalfCount;
+    uint64_t subBucketMask;
+
+    size_t countsLength;
+    volatile uint64_t *counts;
+
+    // The total count is not kept, so recorders only touch their own counter; it is summed when read.
+    volatile uint64_t minimum;
+    volatile uint64_t maximum;
+};
+
+static uint64_t
+_parcHistogram_TotalCount(const PARCHistogram *histogram)
+{
+    uint64_t result = 0;
+    for (size_t i = 0; i < histogram->countsLength; i++) {
+        result += histogram->counts[i];
+    }
+    return result;
+}
+
+static int
+_parcHistogram_BucketIndex(const PARCHistogram *histogram, uint64_t value)
+{
+    // The position of the highest bit of the value, never less than that of the largest sub-bucket index.
+    int pow2Ceiling = 64 - __builtin_clzll(value | histogram->subBucketMask);
+    return pow2Ceiling - (histogram->subBucketHalfCountMagnitude + 1);
+}
+
+static size_t
+_parcHistogram_CountsIndex(const PARCHistogram *histogram, uint64_t value)
+{
+    int bucketIndex = _parcHistogram_BucketIndex(histogram, value);
+    uint64_t subBucketIndex = value >> bucketIndex;
+    return ((size_t) (bucketIndex + 1) << histogram->subBucketHalfCountMagnitude) + (subBucketIndex - histogram->subBucketHalfCount);
+}
+
+/**
+ * The smallest value counted by the given counter, and the number of values it counts.
+ */
+static uint64_t
+_parcHistogram_ValueFromIndex(const PARCHistogram *histogram, size_t index, uint64_t *widthPtr)
+{
+    int bucketIndex = (int) (index >> histogram->subBucketHalfCountMagnitude) - 1;
+    uint64_t subBucketIndex = (index & (histogram->subBucketHalfCount - 1)) + histogram->subBucketHalfCount;
+    if (bucketIndex < 0) {
+        subBucketIndex -= histogram->subBucketHalfCount;
+        bucketIndex = 0;
+    }
+    *widthPtr = (uint64_t) 1 << bucketIndex;
+    return subBucketIndex << bucketIndex;
+}
+
+static uint64_t
+_parcHistogram_HighestEquivalentValue(const PARCHistogram *histogram, size_t index)
+{
+    uint64_t width;
+    uint64_t lowest = _parcHistogram_ValueFromIndex(histogram, index, &width);
+    return lowest + width - 1;
+}
+
+static uint64_t
+_parcHistogram_MedianEquivalentValue(const PARCHistogram *histogram, size_t index)
+{
+    uint64_t width;
+    uint64_t lowest = _parcHistogram_ValueFromIndex(histogram, index, &width);
+    return lowest + width / 2;
+}
+
+static void
+_parcHistogram_UpdateMinimum(PARCHistogram *histogram, uint64_t value)
+{
+    uint64_t current = histogram->minimum;
+    while (value < current) {
+        uint64_t previous = __sync_val_compare_and_swap(&histogram->minimum, current, value);
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+}
+
+static void
+_parcHistogram_UpdateMaximum(PARCHistogram *histogram, uint64_t value)
+{
+    uint64_t current = histogram->maximum;
+    while (value > current) {
+        uint64_t previous = __sync_val_compare_and_swap(&histogram->maximum, current, value);
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+}
+
+static bool
+_parcHistogram_Destructor(PARCHistogram **instancePtr)
+{
+    assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCHistogram pointer.");
+    PARCHistogram *histogram = *instancePtr;
+
+    parcMemory_Deallocate((void **) &histogram->counts);
+
+    return true;
+}
+
+parcObject_ImplementAcquire(parcHistogram, PARCHistogram);
+
+parcObject_ImplementRelease(parcHistogram, PARCHistogram);
+
+parcObject_Override(
+    PARCHistogram, PARCObject,
+    .destructor = (PARCObjectDestructor *) _parcHistogram_Destructor,
+    .copy = (PARCObjectCopy *) parcHistogram_Copy,
+    .toString = (PARCObjectToString *)  parcHistogram_ToString,
+    .equals = (PARCObjectEquals *)  parcHistogram_Equals,
+    .hashCode = (PARCObjectHashCode *) parcHistogram_HashCode,
+    .toJSON = (PARCObjectToJSON *)  parcHistogram_ToJSON);
+
+void
+parcHistogram_AssertValid(const PARCHistogram *instance)
+{
+    assertTrue(parcHistogram_IsValid(instance),
+               "PARCHistogram is not valid.");
+}
+
+PARCHistogram *
+parcHistogram_Create(uint64_t highestTrackableValue, int significantDigits)
+{
+    assertTrue(significantDigits >= 1 && significantDigits <= 5, "significantDigits must be from 1 to 5, not %d", significantDigits);
+    assertTrue(highestTrackableValue >= 2, "highestTrackableValue must be at least 2");
+
+    PARCHistogram *result = parcObject_CreateAndClearInstance(PARCHistogram);
+
+    if (result != NULL) {
+        result->highestTrackableValue = highestTrackableValue;
+        result->significantDigits = significantDigits;
+
+        // Enough sub-buckets that one unit is within the requested precision of the smallest value of a bucket.
+        uint64_t largestValueWithSingleUnitResolution = 2;
+        for (int i = 0; i < significantDigits; i++) {
+            largestValueWithSingleUnitResolution *= 10;
+        }
+        int subBucketCountMagnitude = (int) ceil(log2((double) largestValueWithSingleUnitResolution));
+        result->subBucketHalfCountMagnitude = (subBucketCountMagnitude > 1 ? subBucketCountMagnitude : 1) - 1;
+        uint64_t subBucketCount = (uint64_t) 1 << (result->subBucketHalfCountMagnitude + 1);
+        result->subBucketHalfCount = subBucketCount / 2;
+        result->subBucketMask = subBucketCount - 1;
+
+        // Enough buckets that the highest trackable value falls in the last.
+        int bucketCount = _parcHistogram_BucketIndex(result, highestTrackableValue) + 1;
+        result->countsLength = (size_t) (bucketCount + 1) * result->subBucketHalfCount;
+
+        result->counts = parcMemory_AllocateAndClear(result->countsLength * sizeof(uint64_t));
+        if (result->counts == NULL) {
+            parcHistogram_Release(&result);
+        } else {
+            result->minimum = UINT64_MAX;
+        }
+    }
+
+    return result;
+}
+
+PARCHistogram *
+parcHistogram_Copy(const PARCHistogram *original)
+{
+    parcHistogram_OptionalAssertValid(original);
+
+    PARCHistogram *result = parcHistogram_Create(original->highestTrackableValue, original->significantDigits);
+
+    if (result != NULL) {
+        for (size_t i = 0; i < original->countsLength; i++) {
+            result->counts[i] = original->counts[i];
+        }
+        result->minimum = original->minimum;
+        result->maximum = original->maximum;
+    }
+
+    return result;
+}
+
+void
+parcHistogram_Display(const PARCHistogram *histogram, int indentation)
+{
+    parcDisplayIndented_PrintLine(indentation,
+                                  "PARCHistogram@%p { .count=%" PRIu64 " .minimum=%" PRIu64 " .maximum=%" PRIu64
+                                  " .p50=%" PRIu64 " .p99=%" PRIu64 " .p999=%" PRIu64 " }",
+                                  histogram, parcHistogram_GetCount(histogram),
+                                  parcHistogram_GetMinimum(histogram), parcHistogram_GetMaximum(histogram),
+                                  parcHistogram_GetValueAtPercentile(histogram, 50.0),
+                                  parcHistogram_GetValueAtPercentile(histogram, 99.0),
+                                  parcHistogram_GetValueAtPercentile(histogram, 99.9));
+}
+
+bool
+parcHistogram_Equals(const PARCHistogram *x, const PARCHistogram *y)
+{
+    bool result = false;
+
+    if (x == y) {
+        result = true;
+    } else if (x == NULL || y == NULL) {
+        result = false;
+    } else if (x->highestTrackableValue == y->highestTrackableValue && x->significantDigits == y->significantDigits
+               && x->minimum == y->minimum && x->maximum == y->maximum) {
+        result = true;
+        for (size_t i = 0; i < x->countsLength && result; i++) {
+            result = (x->counts[i] == y->counts[i]);
+        }
+    }
+
+    return result;
+}
+
+PARCHashCode
+parcHistogram_HashCode(const PARCHistogram *histogram)
+{
+    PARCHashCode result = parcHashCode_HashHashCode(0, histogram->highestTrackableValue);
+    result = parcHashCode_HashHashCode(result, (PARCHashCode) histogram->significantDigits);
+    result = parcHashCode_HashHashCode(result, _parcHistogram_TotalCount(histogram));
+
+    return result;
+}
+
+bool
+parcHistogram_IsValid(const PARCHistogram *histogram)
+{
+    bool result = false;
+
+    if (histogram != NULL) {
+        result = (histogram->counts != NULL);
+    }
+
+    return result;
+}
+
+static void
+_parcHistogram_AddDouble(PARCJSON *json, const char *name, double value)
+{
+    PARCJSONPair *pair = parcJSONPair_CreateFromDouble(name, value);
+    parcJSON_AddPair(json, pair);
+    parcJSONPair_Release(&pair);
+}
+
+PARCJSON *
+parcHistogram_ToJSON(const PARCHistogram *histogram)
+{
+    PARCJSON *result = parcJSON_Create();
+
+    if (result != NULL) {
+        parcJSON_AddInteger(result, "count", (int64_t) parcHistogram_GetCount(histogram));
+        parcJSON_AddInteger(result, "minimum", (int64_t) parcHistogram_GetMinimum(histogram));
+        parcJSON_AddInteger(result, "maximum", (int64_t) parcHistogram_GetMaximum(histogram));
+        _parcHistogram_AddDouble(result, "mean", parcHistogram_GetMean(histogram));
+
+        static const struct {
+            const char *name;
+            double percentile;
+        } percentiles[] = {
+            { "50",    50.0   },
+            { "90",    90.0   },
+            { "99",    99.0   },
+            { "99.9",  99.9   },
+            { "99.99", 99.99  },
+        };
+
+        PARCJSON *values = parcJSON_Create();
+        for (size_t i = 0; i < sizeof(percentiles) / sizeof(percentiles[0]); i++) {
+            parcJSON_AddInteger(values, percentiles[i].name,
+                                (int64_t) parcHistogram_GetValueAtPercentile(histogram, percentiles[i].percentile));
+        }
+        parcJSON_AddObject(result, "percentiles", values);
+        parcJSON_Release(&values);
+    }
+
+    return result;
+}
+
+char *
+parcHistogram_ToString(const PARCHistogram *histogram)
+{
+    char *result = parcMemory_Format("PARCHistogram@%p { .count=%" PRIu64 " .minimum=%" PRIu64 " .maximum=%" PRIu64
+                                     " .p50=%" PRIu64 " .p99=%" PRIu64 " .p999=%" PRIu64 " }",
+                                     histogram, parcHistogram_GetCount(histogram),
+                                     parcHistogram_GetMinimum(histogram), parcHistogram_GetMaximum(histogram),
+                                     parcHistogram_GetValueAtPercentile(histogram, 50.0),
+                                     parcHistogram_GetValueAtPercentile(histogram, 99.0),
+                                     parcHistogram_GetValueAtPercentile(histogram, 99.9));
+
+    return result;
+}
+
+bool
+parcHistogram_RecordCount(PARCHistogram *histogram, uint64_t value, uint64_t count)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    if (count == 0) {
+        // Nothing is recorded, so the minimum and maximum must not move either.
+        return value <= histogram->highestTrackableValue;
+    }
+
+    bool result = false;
+
+    if (value <= histogram->highestTrackableValue) {
+        __sync_fetch_and_add(&histogram->counts[_parcHistogram_CountsIndex(histogram, value)], count);
+        _parcHistogram_UpdateMinimum(histogram, value);
+        _parcHistogram_UpdateMaximum(histogram, value);
+        result = true;
+    }
+
+    return result;
+}
+
+bool
+parcHistogram_Record(PARCHistogram *histogram, uint64_t value)
+{
+    return parcHistogram_RecordCount(histogram, value, 1);
+}
+
+uint64_t
+parcHistogram_Add(PARCHistogram *histogram, const PARCHistogram *other)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+    parcHistogram_OptionalAssertValid(other);
+
+    uint64_t dropped = 0;
+
+    if (histogram->highestTrackableValue == other->highestTrackableValue && histogram->significantDigits == other->significantDigits) {
+        // The same layout, so counters correspond one to one.
+        uint64_t total = 0;
+        for (size_t i = 0; i < other->countsLength; i++) {
+            uint64_t count = other->counts[i];
+            if (count > 0) {
+                __sync_fetch_and_add(&histogram->counts[i], count);
+                total += count;
+            }
+        }
+        if (total > 0) {
+            _parcHistogram_UpdateMinimum(histogram, other->minimum);
+            _parcHistogram_UpdateMaximum(histogram, other->maximum);
+        }
+    } else {
+        for (size_t i = 0; i < other->countsLength; i++) {
+            uint64_t count = other->counts[i];
+            if (count > 0) {
+                uint64_t value = _parcHistogram_MedianEquivalentValue(other, i);
+                if (value > other->maximum) {
+                    value = other->maximum;
+                }
+                if (!parcHistogram_RecordCount(histogram, value, count)) {
+                    dropped += count;
+                }
+            }
+        }
+    }
+
+    return dropped;
+}
+
+void
+parcHistogram_Reset(PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    for (size_t i = 0; i < histogram->countsLength; i++) {
+        histogram->counts[i] = 0;
+    }
+    histogram->minimum = UINT64_MAX;
+    histogram->maximum = 0;
+}
+
+uint64_t
+parcHistogram_GetCount(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    return _parcHistogram_TotalCount(histogram);
+}
+
+uint64_t
+parcHistogram_GetMinimum(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    // Nothing has been recorded while the minimum is still above the maximum.
+    return (histogram->minimum > histogram->maximum) ? 0 : histogram->minimum;
+}
+
+uint64_t
+parcHistogram_GetMaximum(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    return histogram->maximum;
+}
+
+double
+parcHistogram_GetMean(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    double total = 0.0;
+    uint64_t count = 0;
+    for (size_t i = 0; i < histogram->countsLength; i++) {
+        uint64_t n = histogram->counts[i];
+        if (n > 0) {
+            total += (double) n * (double) _parcHistogram_MedianEquivalentValue(histogram, i);
+            count += n;
+        }
+    }
+
+    return (count == 0) ? 0.0 : total / (double) count;
+}
+
+double
+parcHistogram_GetStandardDeviation(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    double mean = parcHistogram_GetMean(histogram);
+    double total = 0.0;
+    uint64_t count = 0;
+    for (size_t i = 0; i < histogram->countsLength; i++) {
+        uint64_t n = histogram->counts[i];
+        if (n > 0) {
+            double deviation = (double) _parcHistogram_MedianEquivalentValue(histogram, i) - mean;
+            total += (double) n * deviation * deviation;
+            count += n;
+        }
+    }
+
+    return (count == 0) ? 0.0 : sqrt(total / (double) count);
+}
+
+uint64_t
+parcHistogram_GetValueAtPercentile(const PARCHistogram *histogram, double percentile)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    uint64_t total = _parcHistogram_TotalCount(histogram);
+    if (total == 0) {
+        return 0;
+    }
+
+    if (percentile < 0.0) {
+        percentile = 0.0;
+    } else if (percentile > 100.0) {
+        percentile = 100.0;
+    }
+    uint64_t target = (uint64_t) ((percentile / 100.0) * (double) total + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < histogram->countsLength; i++) {
+        cumulative += histogram->counts[i];
+        if (cumulative >= target) {
+            uint64_t result = _parcHistogram_HighestEquivalentValue(histogram, i);
+            // Never report more than was actually recorded.
+            return (result > histogram->maximum) ? histogram->maximum : result;
+        }
+    }
+
+    return histogram->maximum;
+}
+
+uint64_t
+parcHistogram_GetHighestTrackableValue(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    return histogram->highestTrackableValue;
+}
+
+size_t
+parcHistogram_GetMemorySize(const PARCHistogram *histogram)
+{
+    parcHistogram_OptionalAssertValid(histogram);
+
+    return histogram->countsLength * sizeof(uint64_t);
+}
@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_Histogram.h
+ * @ingroup statistics
+ * @brief A high dynamic range histogram of integer values, such as latencies, answering percentile queries.
+ *
+ * Values are counted in log-linear buckets, in the manner of HdrHistogram:
+ * the range of trackable values is divided into power-of-two buckets, and each bucket into the same number of
+ * linear sub-buckets.  The number of sub-buckets is chosen from the requested number of significant decimal digits,
+ * so every value is counted at a resolution within that relative precision, whatever its magnitude.
+ *
+ * Memory is allocated once, when the histogram is created, and depends only on the precision and on the highest
+ * trackable value.  For example, tracking nanosecond latencies up to one hour at 3 significant digits uses about 270 KB.
+ *
+ * Recording a value takes constant time and no locks: it is one atomic increment of a counter,
+ * so any number of threads may record into the same histogram concurrently.
+ * Queries and {@link parcHistogram_Copy} read the counters while recording continues,
+ * so they reflect some of the values recorded concurrently with them.
+ *
+ * Example:
+ * @code
+ * {
+ *     // Latencies in nanoseconds up to 10 seconds, to 3 significant digits.
+ *     PARCHistogram *latency = parcHistogram_Create(10 * 1000000000ULL, 3);
+ *
+ *     uint64_t start = parcTime_NowNanoseconds();
+ *     doWork();
+ *     parcHistogram_Record(latency, parcTime_NowNanoseconds() - start);
+ *
+ *     printf("p99 %" PRIu64 " ns\n", parcHistogram_GetValueAtPercentile(latency, 99.0));
+ *
+ *     parcHistogram_Release(&latency);
+ * }
+ * @endcode
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_Histogram
+#define PARCLibrary_parc_Histogram
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_HashCode.h>
+#include <parc/algol/parc_JSON.h>
+
+struct PARCHistogram;
+typedef struct PARCHistogram PARCHistogram;
+
+/**
+ * Increase the number of references to a `PARCHistogram` instance.
+ *
+ * Note that new `PARCHistogram` is not created,
+ * only that the given `PARCHistogram` reference count is incremented.
+ * Discard the reference by invoking `parcHistogram_Release`.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ *
+ * @return The same value as @p instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHistogram *a = parcHistogram_Create(3600000000000ULL, 3);
+ *
+ *     PARCHistogram *b = parcHistogram_Acquire(a);
+ *
+ *     parcHistogram_Release(&a);
+ *     parcHistogram_Release(&b);
+ * }
+ * @endcode
+ */
+PARCHistogram *parcHistogram_Acquire(const PARCHistogram *instance);
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcHistogram_OptionalAssertValid(_instance_)
+#else
+#  define parcHistogram_OptionalAssertValid(_instance_) parcHistogram_AssertValid(_instance_)
+#endif
+
+/**
+ * Assert that the given `PARCHistogram` instance is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHistogram *a = parcHistogram_Create(3600000000000ULL, 3);
+ *
+ *     parcHistogram_AssertValid(a);
+ *
+ *     parcHistogram_Release(&a);
+ * }
+ * @endcode
+ */
+void parcHistogram_AssertValid(const PARCHistogram *instance);
+
+/**
+ * Create an instance of `PARCHistogram` that tracks values from 0 to @p highestTrackableValue.
+ *
+ * @param [in] highestTrackableValue The largest value that can be recorded, at least 2.
+ * @param [in] significantDigits The number of significant decimal digits to which values are resolved, from 1 to 5.
+ *
+ * @return non-NULL A pointer to a valid PARCHistogram instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHistogram *a = parcHistogram_Create(3600000000000ULL, 3);
+ *
+ *     parcHistogram_Release(&a);
+ * }
+ * @endcode
+ */
+PARCHistogram *parcHistogram_Create(uint64_t highestTrackableValue, int significantDigits);
+
+/**
+ * Create a snapshot of the given `PARCHistogram`.
+ *
+ * The copy has the same configuration and the counts of the original at the time of the copy.
+ * Values recorded concurrently with the copy may or may not be included.
+ *
+ * @param [in] original A pointer to a valid PARCHistogram instance.
+ *
+ * @return NULL Memory could not be allocated.
+ * @return non-NULL A pointer to a new `PARCHistogram` instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHistogram *snapshot = parcHistogram_Copy(live);
+ *     parcHistogram_Reset(live);
+ *
+ *     PARCJSON *json = parcHistogram_ToJSON(snapshot);
+ *     ...
+ *     parcJSON_Release(&json);
+ *     parcHistogram_Release(&snapshot);
+ * }
+ * @endcode
+ */
+PARCHistogram *parcHistogram_Copy(const PARCHistogram *original);
+
+/**
+ * Print a human readable representation of the given `PARCHistogram`.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ * @param [in] indentation The indentation level to use for printing.
+ */
+void parcHistogram_Display(const PARCHistogram *instance, int indentation);
+
+/**
+ * Determine if two `PARCHistogram` instances have the same configuration and counts.
+ *
+ * @param [in] x A pointer to a valid PARCHistogram instance.
+ * @param [in] y A pointer to a valid PARCHistogram instance.
+ *
+ * @return true The instances are equal.
+ * @return false The instances are not equal.
+ */
+bool parcHistogram_Equals(const PARCHistogram *x, const PARCHistogram *y);
+
+/**
+ * Returns a hash code value for the given instance.
+ *
+ * Equal instances have equal hash codes.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ *
+ * @return The hashcode for the instance.
+ */
+PARCHashCode parcHistogram_HashCode(const PARCHistogram *instance);
+
+/**
+ * Determine if an instance of `PARCHistogram` is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ */
+bool parcHistogram_IsValid(const PARCHistogram *instance);
+
+/**
+ * Release a previously acquired reference to the given `PARCHistogram` instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and the instance's implementation will perform
+ * additional cleanup and release other privately held references.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ */
+void parcHistogram_Release(PARCHistogram **instancePtr);
+
+/**
+ * Create a `PARCJSON` instance summarising the given `PARCHistogram`.
+ *
+ * The summary has the count, minimum, maximum and mean,
+ * and a `percentiles` object giving the values at the 50th, 90th, 99th, 99.9th and 99.99th percentiles.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ *
+ * @return NULL Memory could not be allocated to contain the `PARCJSON` instance.
+ * @return non-NULL A pointer to a `PARCJSON` instance that must be released via parcJSON_Release().
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCJSON *json = parcHistogram_ToJSON(histogram);
+ *
+ *     char *string = parcJSON_ToString(json);
+ *     printf("%s\n", string);
+ *     parcMemory_Deallocate(&string);
+ *
+ *     parcJSON_Release(&json);
+ * }
+ * @endcode
+ */
+PARCJSON *parcHistogram_ToJSON(const PARCHistogram *instance);
+
+/**
+ * Produce a null-terminated string representation of the specified `PARCHistogram`.
+ *
+ * The result must be freed by the caller via {@link parcMemory_Deallocate}.
+ *
+ * @param [in] instance A pointer to a valid PARCHistogram instance.
+ *
+ * @return NULL Cannot allocate memory.
+ * @return non-NULL A pointer to an allocated null-terminated string that must be deallocated via {@link parcMemory_Deallocate}.
+ */
+char *parcHistogram_ToString(const PARCHistogram *instance);
+
+/**
+ * Record a value.
+ *
+ * This takes constant time, takes no locks, and may be called by many threads concurrently.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ * @param [in] value The value to record.
+ *
+ * @return true The value was recorded.
+ * @return false The value is greater than the highest trackable value and was not recorded.
+ */
+bool parcHistogram_Record(PARCHistogram *histogram, uint64_t value);
+
+/**
+ * Record the same value a number of times.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ * @param [in] value The value to record.
+ * @param [in] count The number of times to record it.
+ *
+ * @return true The value was recorded.
+ * @return false The value is greater than the highest trackable value and was not recorded.
+ */
+bool parcHistogram_RecordCount(PARCHistogram *histogram, uint64_t value, uint64_t count);
+
+/**
+ * Add the counts of one histogram to another.
+ *
+ * The histograms may have different configurations: each value counted in @p other is recorded in @p histogram
+ * at the resolution of @p histogram.  Values of @p other beyond the range of @p histogram are not added.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance to add to.
+ * @param [in] other A pointer to a valid PARCHistogram instance.
+ *
+ * @return The number of values of @p other that could not be added.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCHistogram *total = parcHistogram_Create(3600000000000ULL, 3);
+ *     for (int i = 0; i < workerCount; i++) {
+ *         parcHistogram_Add(total, worker[i].latency);
+ *     }
+ * }
+ * @endcode
+ */
+uint64_t parcHistogram_Add(PARCHistogram *histogram, const PARCHistogram *other);
+
+/**
+ * Discard all recorded values.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ */
+void parcHistogram_Reset(PARCHistogram *histogram);
+
+/**
+ * Get the number of values recorded.
+ *
+ * The count is summed over every counter, so it costs time proportional to
+ * {@link parcHistogram_GetMemorySize} rather than being kept by each record.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The number of values recorded.
+ */
+uint64_t parcHistogram_GetCount(const PARCHistogram *histogram);
+
+/**
+ * Get the smallest value recorded, or 0 if no value has been recorded.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The smallest value recorded, exactly.
+ */
+uint64_t parcHistogram_GetMinimum(const PARCHistogram *histogram);
+
+/**
+ * Get the largest value recorded, or 0 if no value has been recorded.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The largest value recorded, exactly.
+ */
+uint64_t parcHistogram_GetMaximum(const PARCHistogram *histogram);
+
+/**
+ * Get the mean of the recorded values, to the precision of the histogram.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The mean of the recorded values, or 0 if no value has been recorded.
+ */
+double parcHistogram_GetMean(const PARCHistogram *histogram);
+
+/**
+ * Get the standard deviation of the recorded values, to the precision of the histogram.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The standard deviation of the recorded values, or 0 if no value has been recorded.
+ */
+double parcHistogram_GetStandardDeviation(const PARCHistogram *histogram);
+
+/**
+ * Get the value at the given percentile of the recorded values.
+ *
+ * The result is the highest value equivalent, at the precision of the histogram,
+ * to the smallest recorded value that is greater than or equal to @p percentile percent of the recorded values.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ * @param [in] percentile The percentile, from 0 to 100.
+ *
+ * @return The value at @p percentile, or 0 if no value has been recorded.
+ *
+ * Example:
+ * @code
+ * {
+ *     uint64_t median = parcHistogram_GetValueAtPercentile(histogram, 50.0);
+ *     uint64_t p999 = parcHistogram_GetValueAtPercentile(histogram, 99.9);
+ * }
+ * @endcode
+ */
+uint64_t parcHistogram_GetValueAtPercentile(const PARCHistogram *histogram, double percentile);
+
+/**
+ * Get the highest value the histogram can record.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The highest trackable value given when the histogram was created.
+ */
+uint64_t parcHistogram_GetHighestTrackableValue(const PARCHistogram *histogram);
+
+/**
+ * Get the number of bytes of counters the histogram uses.
+ *
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return The size in bytes of the histogram's counters.
+ */
+size_t parcHistogram_GetMemorySize(const PARCHistogram *histogram);
+#endif // PARCLibrary_parc_Histogram
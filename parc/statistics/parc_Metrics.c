@@ -0,0 +1,571 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_DisplayIndented.h>
+#include <parc/algol/parc_Memory.h>
+
+#include <parc/statistics/parc_Metrics.h>
+
+#define _CACHE_LINE 64
+#define _COUNTER_CELLS 16
+
+typedef union {
+    volatile uint64_t value;
+    char pad[_CACHE_LINE];
+} _PARCMetricsCounterCell;
+
+struct PARCMetricsCounter {
+    _PARCMetricsCounterCell cells[_COUNTER_CELLS];
+};
+
+typedef enum {
+    _PARCMetricsType_Counter,
+    _PARCMetricsType_Gauge,
+    _PARCMetricsType_Histogram
+} _PARCMetricsType;
+
+typedef struct {
+    char *name;
+    _PARCMetricsType type;
+    union {
+        PARCMetricsCounter *counter;
+        struct {
+            PARCMetricsGaugeFunction *function;
+            PARCObject *object;
+        } gauge;
+        PARCHistogram *histogram;
+    };
+} _PARCMetricsEntry;
+
+struct PARCMetrics {
+    pthread_mutex_t lock;
+
+    // Sorted by name.
+    _PARCMetricsEntry *entries;
+    size_t length;
+    size_t capacity;
+
+    struct {
+        pthread_t thread;
+        pthread_mutex_t lock;
+        pthread_cond_t wakeup;
+        bool running;
+        bool stop;
+        PARCOutputStream *output;
+        uint64_t interval;
+    } dump;
+};
+
+static unsigned _parcMetrics_NextThreadIndex;
+
+static __thread unsigned _parcMetrics_ThreadIndex;
+
+parcObject_ImplementAcquire(parcMetricsCounter, PARCMetricsCounter);
+
+parcObject_ImplementRelease(parcMetricsCounter, PARCMetricsCounter);
+
+parcObject_Override(PARCMetricsCounter, PARCObject);
+
+PARCMetricsCounter *
+parcMetricsCounter_Create(void)
+{
+    return parcObject_CreateAndClearInstance(PARCMetricsCounter);
+}
+
+void
+parcMetricsCounter_Add(PARCMetricsCounter *counter, uint64_t amount)
+{
+    if (_parcMetrics_ThreadIndex == 0) {
+        _parcMetrics_ThreadIndex = __sync_add_and_fetch(&_parcMetrics_NextThreadIndex, 1);
+    }
+
+    // Threads beyond the number of cells share them, so the addition must still be atomic.
+    __sync_fetch_and_add(&counter->cells[_parcMetrics_ThreadIndex % _COUNTER_CELLS].value, amount);
+}
+
+void
+parcMetricsCounter_Increment(PARCMetricsCounter *counter)
+{
+    parcMetricsCounter_Add(counter, 1);
+}
+
+uint64_t
+parcMetricsCounter_GetValue(const PARCMetricsCounter *counter)
+{
+    uint64_t result = 0;
+
+    for (int i = 0; i < _COUNTER_CELLS; i++) {
+        result += counter->cells[i].value;
+    }
+
+    return result;
+}
+
+static void
+_parcMetrics_EntryRelease(_PARCMetricsEntry *entry)
+{
+    switch (entry->type) {
+        case _PARCMetricsType_Counter:
+            parcMetricsCounter_Release(&entry->counter);
+            break;
+        case _PARCMetricsType_Gauge:
+            if (entry->gauge.object != NULL) {
+                parcObject_Release(&entry->gauge.object);
+            }
+            break;
+        case _PARCMetricsType_Histogram:
+            parcHistogram_Release(&entry->histogram);
+            break;
+    }
+    parcMemory_Deallocate((void **) &entry->name);
+}
+
+/**
+ * Find the index of the entry with the given name, or the index at which it would be inserted.
+ */
+static size_t
+_parcMetrics_Search(const PARCMetrics *metrics, const char *name, bool *found)
+{
+    size_t low = 0;
+    size_t high = metrics->length;
+
+    *found = false;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        int comparison = strcmp(metrics->entries[middle].name, name);
+        if (comparison == 0) {
+            *found = true;
+            return middle;
+        } else if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low;
+}
+
+/**
+ * Insert a new entry with the given name and kind, and return it for the caller to fill in.
+ *
+ * The registry must be locked, and the name must not be registered.
+ */
+static _PARCMetricsEntry *
+_parcMetrics_Insert(PARCMetrics *metrics, size_t index, const char *name, _PARCMetricsType type)
+{
+    if (metrics->length == metrics->capacity) {
+        size_t capacity = (metrics->capacity == 0) ? 16 : metrics->capacity * 2;
+        _PARCMetricsEntry *entries = parcMemory_Allocate(capacity * sizeof(_PARCMetricsEntry));
+        trapOutOfMemoryIf(entries == NULL, "parcMemory_Allocate(%zu) returned NULL", capacity * sizeof(_PARCMetricsEntry));
+        if (metrics->entries != NULL) {
+            memcpy(entries, metrics->entries, metrics->length * sizeof(_PARCMetricsEntry));
+            parcMemory_Deallocate((void **) &metrics->entries);
+        }
+        metrics->entries = entries;
+        metrics->capacity = capacity;
+    }
+
+    memmove(&metrics->entries[index + 1], &metrics->entries[index], (metrics->length - index) * sizeof(_PARCMetricsEntry));
+    metrics->length++;
+
+    _PARCMetricsEntry *entry = &metrics->entries[index];
+    entry->name = parcMemory_StringDuplicate(name, strlen(name));
+    entry->type = type;
+
+    return entry;
+}
+
+static void
+_parcMetrics_Lock(const PARCMetrics *metrics)
+{
+    pthread_mutex_lock(&((PARCMetrics *) metrics)->lock);
+}
+
+static void
+_parcMetrics_Unlock(const PARCMetrics *metrics)
+{
+    pthread_mutex_unlock(&((PARCMetrics *) metrics)->lock);
+}
+
+static bool
+_parcMetrics_Destructor(PARCMetrics **instancePtr)
+{
+    assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCMetrics pointer.");
+    PARCMetrics *metrics = *instancePtr;
+
+    parcMetrics_StopPeriodicDump(metrics);
+
+    for (size_t i = 0; i < metrics->length; i++) {
+        _parcMetrics_EntryRelease(&metrics->entries[i]);
+    }
+    if (metrics->entries != NULL) {
+        parcMemory_Deallocate((void **) &metrics->entries);
+    }
+
+    pthread_cond_destroy(&metrics->dump.wakeup);
+    pthread_mutex_destroy(&metrics->dump.lock);
+    pthread_mutex_destroy(&metrics->lock);
+
+    return true;
+}
+
+parcObject_ImplementAcquire(parcMetrics, PARCMetrics);
+
+parcObject_ImplementRelease(parcMetrics, PARCMetrics);
+
+parcObject_Override(
+    PARCMetrics, PARCObject,
+    .destructor = (PARCObjectDestructor *) _parcMetrics_Destructor,
+    .toString = (PARCObjectToString *)  parcMetrics_ToString,
+    .toJSON = (PARCObjectToJSON *)  parcMetrics_ToJSON);
+
+void
+parcMetrics_AssertValid(const PARCMetrics *instance)
+{
+    assertTrue(parcMetrics_IsValid(instance),
+               "PARCMetrics is not valid.");
+}
+
+PARCMetrics *
+parcMetrics_Create(void)
+{
+    PARCMetrics *result = parcObject_CreateAndClearInstance(PARCMetrics);
+
+    if (result != NULL) {
+        pthread_mutex_init(&result->lock, NULL);
+        pthread_mutex_init(&result->dump.lock, NULL);
+        pthread_cond_init(&result->dump.wakeup, NULL);
+    }
+
+    return result;
+}
+
+void
+parcMetrics_Display(const PARCMetrics *metrics, int indentation)
+{
+    parcDisplayIndented_PrintLine(indentation, "PARCMetrics@%p {", metrics);
+
+    _parcMetrics_Lock(metrics);
+    for (size_t i = 0; i < metrics->length; i++) {
+        const _PARCMetricsEntry *entry = &metrics->entries[i];
+        switch (entry->type) {
+            case _PARCMetricsType_Counter:
+                parcDisplayIndented_PrintLine(indentation + 1, "%s=%" PRIu64, entry->name, parcMetricsCounter_GetValue(entry->counter));
+                break;
+            case _PARCMetricsType_Gauge:
+                parcDisplayIndented_PrintLine(indentation + 1, "%s=%" PRId64, entry->name, entry->gauge.function(entry->gauge.object));
+                break;
+            case _PARCMetricsType_Histogram:
+                parcDisplayIndented_PrintLine(indentation + 1, "%s=", entry->name);
+                parcHistogram_Display(entry->histogram, indentation + 2);
+                break;
+        }
+    }
+    _parcMetrics_Unlock(metrics);
+
+    parcDisplayIndented_PrintLine(indentation, "}");
+}
+
+bool
+parcMetrics_IsValid(const PARCMetrics *metrics)
+{
+    bool result = false;
+
+    if (metrics != NULL) {
+        result = (metrics->length <= metrics->capacity);
+    }
+
+    return result;
+}
+
+PARCJSON *
+parcMetrics_ToJSON(const PARCMetrics *metrics)
+{
+    PARCJSON *result = parcJSON_Create();
+
+    if (result != NULL) {
+        _parcMetrics_Lock(metrics);
+        for (size_t i = 0; i < metrics->length; i++) {
+            const _PARCMetricsEntry *entry = &metrics->entries[i];
+            switch (entry->type) {
+                case _PARCMetricsType_Counter:
+                    parcJSON_AddInteger(result, entry->name, (int64_t) parcMetricsCounter_GetValue(entry->counter));
+                    break;
+                case _PARCMetricsType_Gauge:
+                    parcJSON_AddInteger(result, entry->name, entry->gauge.function(entry->gauge.object));
+                    break;
+                case _PARCMetricsType_Histogram: {
+                    PARCJSON *histogram = parcHistogram_ToJSON(entry->histogram);
+                    parcJSON_AddObject(result, entry->name, histogram);
+                    parcJSON_Release(&histogram);
+                    break;
+                }
+            }
+        }
+        _parcMetrics_Unlock(metrics);
+    }
+
+    return result;
+}
+
+char *
+parcMetrics_ToString(const PARCMetrics *metrics)
+{
+    PARCJSON *json = parcMetrics_ToJSON(metrics);
+    char *result = parcJSON_ToCompactString(json);
+    parcJSON_Release(&json);
+
+    return result;
+}
+
+PARCMetricsCounter *
+parcMetrics_Counter(PARCMetrics *metrics, const char *name)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    PARCMetricsCounter *result = NULL;
+
+    _parcMetrics_Lock(metrics);
+    bool found;
+    size_t index = _parcMetrics_Search(metrics, name, &found);
+    if (found) {
+        if (metrics->entries[index].type == _PARCMetricsType_Counter) {
+            result = metrics->entries[index].counter;
+        }
+    } else {
+        _PARCMetricsEntry *entry = _parcMetrics_Insert(metrics, index, name, _PARCMetricsType_Counter);
+        entry->counter = parcMetricsCounter_Create();
+        result = entry->counter;
+    }
+    _parcMetrics_Unlock(metrics);
+
+    return result;
+}
+
+bool
+parcMetrics_AddCounter(PARCMetrics *metrics, const char *name, PARCMetricsCounter *counter)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    _parcMetrics_Lock(metrics);
+    bool found;
+    size_t index = _parcMetrics_Search(metrics, name, &found);
+    if (!found) {
+        _PARCMetricsEntry *entry = _parcMetrics_Insert(metrics, index, name, _PARCMetricsType_Counter);
+        entry->counter = parcMetricsCounter_Acquire(counter);
+    }
+    _parcMetrics_Unlock(metrics);
+
+    return !found;
+}
+
+bool
+parcMetrics_AddGauge(PARCMetrics *metrics, const char *name, PARCMetricsGaugeFunction *function, const PARCObject *object)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    _parcMetrics_Lock(metrics);
+    bool found;
+    size_t index = _parcMetrics_Search(metrics, name, &found);
+    if (!found) {
+        _PARCMetricsEntry *entry = _parcMetrics_Insert(metrics, index, name, _PARCMetricsType_Gauge);
+        entry->gauge.function = function;
+        entry->gauge.object = (object == NULL) ? NULL : parcObject_Acquire(object);
+    }
+    _parcMetrics_Unlock(metrics);
+
+    return !found;
+}
+
+bool
+parcMetrics_AddHistogram(PARCMetrics *metrics, const char *name, PARCHistogram *histogram)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    _parcMetrics_Lock(metrics);
+    bool found;
+    size_t index = _parcMetrics_Search(metrics, name, &found);
+    if (!found) {
+        _PARCMetricsEntry *entry = _parcMetrics_Insert(metrics, index, name, _PARCMetricsType_Histogram);
+        entry->histogram = parcHistogram_Acquire(histogram);
+    }
+    _parcMetrics_Unlock(metrics);
+
+    return !found;
+}
+
+bool
+parcMetrics_Remove(PARCMetrics *metrics, const char *name)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    _parcMetrics_Lock(metrics);
+    bool found;
+    size_t index = _parcMetrics_Search(metrics, name, &found);
+    if (found) {
+        _parcMetrics_EntryRelease(&metrics->entries[index]);
+        memmove(&metrics->entries[index], &metrics->entries[index + 1], (metrics->length - index - 1) * sizeof(_PARCMetricsEntry));
+        metrics->length--;
+    }
+    _parcMetrics_Unlock(metrics);
+
+    return found;
+}
+
+size_t
+parcMetrics_Size(const PARCMetrics *metrics)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    return metrics->length;
+}
+
+bool
+parcMetrics_Dump(const PARCMetrics *metrics, PARCOutputStream *output)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+
+    char *string = parcMetrics_ToString(metrics);
+    bool result = parcOutputStream_WriteCString(output, string) > 0 && parcOutputStream_WriteCString(output, "\n") > 0;
+    parcMemory_Deallocate((void **) &string);
+
+    return result;
+}
+
+static void *
+_parcMetrics_DumpThread(void *arg)
+{
+    PARCMetrics *metrics = arg;
+
+    pthread_mutex_lock(&metrics->dump.lock);
+    while (!metrics->dump.stop) {
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        uint64_t nanoseconds = (uint64_t) deadline.tv_nsec + metrics->dump.interval;
+        deadline.tv_sec += nanoseconds / 1000000000ULL;
+        deadline.tv_nsec = nanoseconds % 1000000000ULL;
+
+        int status = 0;
+        while (!metrics->dump.stop && status != ETIMEDOUT) {
+            status = pthread_cond_timedwait(&metrics->dump.wakeup, &metrics->dump.lock, &deadline);
+        }
+
+        if (!metrics->dump.stop) {
+            pthread_mutex_unlock(&metrics->dump.lock);
+            parcMetrics_Dump(metrics, metrics->dump.output);
+            pthread_mutex_lock(&metrics->dump.lock);
+        }
+    }
+    pthread_mutex_unlock(&metrics->dump.lock);
+
+    return NULL;
+}
+
+bool
+parcMetrics_StartPeriodicDump(PARCMetrics *metrics, PARCOutputStream *output, uint64_t intervalNanoseconds)
+{
+    parcMetrics_OptionalAssertValid(metrics);
+    assertTrue(intervalNanoseconds > 0, "The interval must be greater than 0");
+
+    bool result = false;
+
+    pthread_mutex_lock(&metrics->dump.lock);
+    if (!metrics->dump.running) {
+        metrics->dump.output = parcOutputStream_Acquire(output);
+        metrics->dump.interval = intervalNanoseconds;
+        metrics->dump.stop = false;
+        if (pthread_create(&metrics->dump.thread, NULL, _parcMetrics_DumpThread, metrics) == 0) {
+            metrics->dump.running = true;
+            result = true;
+        } else {
+            parcOutputStream_Release(&metrics->dump.output);
+        }
+    }
+    pthread_mutex_unlock(&metrics->dump.lock);
+
+    return result;
+}
+
+void
+parcMetrics_StopPeriodicDump(PARCMetrics *metrics)
+{
+    pthread_mutex_lock(&metrics->dump.lock);
+    bool running = metrics->dump.running;
+    if (running) {
+        metrics->dump.stop = true;
+        pthread_cond_signal(&metrics->dump.wakeup);
+    }
+    pthread_mutex_unlock(&metrics->dump.lock);
+
+    if (running) {
+        pthread_join(metrics->dump.thread, NULL);
+        parcOutputStream_Release(&metrics->dump.output);
+        metrics->dump.running = false;
+    }
+}
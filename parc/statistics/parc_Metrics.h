@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_Metrics.h
+ * @ingroup statistics
+ * @brief A registry of named counters, gauges and histograms that can be enumerated and exported as JSON.
+ *
+ * Subsystems register their metrics under dotted names, such as "bufferPool.cacheHits",
+ * and a monitoring component takes a snapshot of all of them as a single JSON object.
+ *
+ * There are three kinds of metric:
+ *
+ * * A counter, {@link PARCMetricsCounter}, is a monotonically increasing count.
+ *   It is made of a set of per-thread cells, each on its own cache line,
+ *   so many threads can increment the same counter without contending for one cache line.
+ * * A gauge is a function, called when a snapshot is taken, that returns a current value such as a queue depth.
+ *   Gauges export values a subsystem already keeps, without changing its hot paths.
+ * * A histogram is a {@link PARCHistogram}, exported through `parcHistogram_ToJSON`.
+ *
+ * Registering and removing metrics and taking snapshots are serialized by a lock in the registry.
+ * Updating a counter or recording into a histogram never touches the registry.
+ *
+ * The registry can also write a snapshot to a {@link PARCOutputStream} periodically,
+ * one compact JSON object per line, from a thread of its own.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCMetrics *metrics = parcMetrics_Create();
+ *
+ *     PARCMetricsCounter *requests = parcMetrics_Counter(metrics, "server.requests");
+ *     parcBufferPool_RegisterMetrics(pool, metrics, "server.bufferPool");
+ *
+ *     // On the hot path
+ *     parcMetricsCounter_Increment(requests);
+ *
+ *     PARCJSON *snapshot = parcMetrics_ToJSON(metrics);
+ *     ...
+ *     parcJSON_Release(&snapshot);
+ *
+ *     parcMetrics_Release(&metrics);
+ * }
+ * @endcode
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_Metrics
+#define PARCLibrary_parc_Metrics
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_JSON.h>
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_OutputStream.h>
+#include <parc/statistics/parc_Histogram.h>
+
+struct PARCMetrics;
+typedef struct PARCMetrics PARCMetrics;
+
+struct PARCMetricsCounter;
+typedef struct PARCMetricsCounter PARCMetricsCounter;
+
+/**
+ * A function returning the current value of a gauge.
+ *
+ * The function is called with the object given when the gauge was added, while the registry is locked,
+ * so it must not add or remove metrics in the same registry.
+ */
+typedef int64_t (PARCMetricsGaugeFunction)(const PARCObject *object);
+
+/**
+ * Create a counter with the value 0, not registered in any registry.
+ *
+ * @return non-NULL A pointer to a valid PARCMetricsCounter instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCMetricsCounter *counter = parcMetricsCounter_Create();
+ *
+ *     parcMetricsCounter_Release(&counter);
+ * }
+ * @endcode
+ */
+PARCMetricsCounter *parcMetricsCounter_Create(void);
+
+/**
+ * Increase the number of references to a `PARCMetricsCounter` instance.
+ *
+ * @param [in] instance A pointer to a valid PARCMetricsCounter instance.
+ *
+ * @return The same value as @p instance.
+ */
+PARCMetricsCounter *parcMetricsCounter_Acquire(const PARCMetricsCounter *instance);
+
+/**
+ * Release a previously acquired reference to the given `PARCMetricsCounter` instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ */
+void parcMetricsCounter_Release(PARCMetricsCounter **instancePtr);
+
+/**
+ * Add @p amount to the given counter.
+ *
+ * Any number of threads may add to the same counter concurrently.
+ *
+ * @param [in] counter A pointer to a valid PARCMetricsCounter instance.
+ * @param [in] amount The amount to add.
+ */
+void parcMetricsCounter_Add(PARCMetricsCounter *counter, uint64_t amount);
+
+/**
+ * Add 1 to the given counter.
+ *
+ * @param [in] counter A pointer to a valid PARCMetricsCounter instance.
+ */
+void parcMetricsCounter_Increment(PARCMetricsCounter *counter);
+
+/**
+ * Get the value of the given counter.
+ *
+ * The value is the sum of the counter's cells, which may include some of the additions made concurrently with this call.
+ *
+ * @param [in] counter A pointer to a valid PARCMetricsCounter instance.
+ *
+ * @return The value of the counter.
+ */
+uint64_t parcMetricsCounter_GetValue(const PARCMetricsCounter *counter);
+
+/**
+ * Increase the number of references to a `PARCMetrics` instance.
+ *
+ * Note that new `PARCMetrics` is not created,
+ * only that the given `PARCMetrics` reference count is incremented.
+ * Discard the reference by invoking `parcMetrics_Release`.
+ *
+ * @param [in] instance A pointer to a valid PARCMetrics instance.
+ *
+ * @return The same value as @p instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCMetrics *a = parcMetrics_Create();
+ *
+ *     PARCMetrics *b = parcMetrics_Acquire(a);
+ *
+ *     parcMetrics_Release(&a);
+ *     parcMetrics_Release(&b);
+ * }
+ * @endcode
+ */
+PARCMetrics *parcMetrics_Acquire(const PARCMetrics *instance);
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcMetrics_OptionalAssertValid(_instance_)
+#else
+#  define parcMetrics_OptionalAssertValid(_instance_) parcMetrics_AssertValid(_instance_)
+#endif
+
+/**
+ * Assert that the given `PARCMetrics` instance is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCMetrics instance.
+ */
+void parcMetrics_AssertValid(const PARCMetrics *instance);
+
+/**
+ * Create an empty registry of metrics.
+ *
+ * @return non-NULL A pointer to a valid PARCMetrics instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCMetrics *a = parcMetrics_Create();
+ *
+ *     parcMetrics_Release(&a);
+ * }
+ * @endcode
+ */
+PARCMetrics *parcMetrics_Create(void);
+
+/**
+ * Print a human readable representation of the given `PARCMetrics`.
+ *
+ * @param [in] instance A pointer to a valid PARCMetrics instance.
+ * @param [in] indentation The indentation level to use for printing.
+ */
+void parcMetrics_Display(const PARCMetrics *instance, int indentation);
+
+/**
+ * Determine if an instance of `PARCMetrics` is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCMetrics instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ */
+bool parcMetrics_IsValid(const PARCMetrics *instance);
+
+/**
+ * Release a previously acquired reference to the given `PARCMetrics` instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * any periodic dump is stopped and the references held to registered metrics and their objects are released.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ */
+void parcMetrics_Release(PARCMetrics **instancePtr);
+
+/**
+ * Take a snapshot of every metric in the registry as a `PARCJSON` object.
+ *
+ * The object has one member for each metric, in order of name.
+ * Counters and gauges are integers, and histograms are the objects produced by `parcHistogram_ToJSON`.
+ *
+ * @param [in] instance A pointer to a valid PARCMetrics instance.
+ *
+ * @return NULL Memory could not be allocated to contain the `PARCJSON` instance.
+ * @return non-NULL A pointer to a `PARCJSON` instance that must be released via parcJSON_Release().
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCJSON *json = parcMetrics_ToJSON(metrics);
+ *
+ *     char *string = parcJSON_ToString(json);
+ *     printf("%s\n", string);
+ *     parcMemory_Deallocate(&string);
+ *
+ *     parcJSON_Release(&json);
+ * }
+ * @endcode
+ */
+PARCJSON *parcMetrics_ToJSON(const PARCMetrics *instance);
+
+/**
+ * Produce a null-terminated string representation of the specified `PARCMetrics`.
+ *
+ * The result must be freed by the caller via {@link parcMemory_Deallocate}.
+ *
+ * @param [in] instance A pointer to a valid PARCMetrics instance.
+ *
+ * @return NULL Cannot allocate memory.
+ * @return non-NULL A pointer to an allocated, null-terminated C string that must be deallocated via {@link parcMemory_Deallocate}.
+ */
+char *parcMetrics_ToString(const PARCMetrics *instance);
+
+/**
+ * Get the counter registered under the given name, creating and registering it if there is none.
+ *
+ * The counter remains valid for as long as it is registered.
+ * A caller that keeps the counter after it might be removed must acquire its own reference.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] name The name of the counter.
+ *
+ * @return non-NULL A pointer to the counter registered under @p name.
+ * @return NULL A metric of a different kind is registered under @p name.
+ */
+PARCMetricsCounter *parcMetrics_Counter(PARCMetrics *metrics, const char *name);
+
+/**
+ * Register an existing counter under the given name.
+ *
+ * The registry acquires a reference to @p counter.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] name The name of the counter.
+ * @param [in] counter A pointer to a valid PARCMetricsCounter instance.
+ *
+ * @return true The counter was registered.
+ * @return false A metric is already registered under @p name.
+ */
+bool parcMetrics_AddCounter(PARCMetrics *metrics, const char *name, PARCMetricsCounter *counter);
+
+/**
+ * Register a gauge under the given name.
+ *
+ * Each snapshot calls @p function with @p object.
+ * The registry acquires a reference to @p object, if it is not NULL, for as long as the gauge is registered.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] name The name of the gauge.
+ * @param [in] function The function returning the value of the gauge.
+ * @param [in] object A pointer to a valid PARCObject passed to @p function, or NULL.
+ *
+ * @return true The gauge was registered.
+ * @return false A metric is already registered under @p name.
+ *
+ * Example:
+ * @code
+ * static int64_t
+ * _queueDepth(const PARCObject *queue)
+ * {
+ *     return parcDeque_Size(queue);
+ * }
+ *
+ * {
+ *     parcMetrics_AddGauge(metrics, "server.queueDepth", _queueDepth, queue);
+ * }
+ * @endcode
+ */
+bool parcMetrics_AddGauge(PARCMetrics *metrics, const char *name, PARCMetricsGaugeFunction *function, const PARCObject *object);
+
+/**
+ * Register a histogram under the given name.
+ *
+ * The registry acquires a reference to @p histogram.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] name The name of the histogram.
+ * @param [in] histogram A pointer to a valid PARCHistogram instance.
+ *
+ * @return true The histogram was registered.
+ * @return false A metric is already registered under @p name.
+ */
+bool parcMetrics_AddHistogram(PARCMetrics *metrics, const char *name, PARCHistogram *histogram);
+
+/**
+ * Remove the metric registered under the given name, releasing the references the registry holds for it.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] name The name of the metric.
+ *
+ * @return true The metric was removed.
+ * @return false No metric is registered under @p name.
+ */
+bool parcMetrics_Remove(PARCMetrics *metrics, const char *name);
+
+/**
+ * Get the number of metrics in the registry.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ *
+ * @return The number of metrics in the registry.
+ */
+size_t parcMetrics_Size(const PARCMetrics *metrics);
+
+/**
+ * Write a snapshot of the registry to the given output stream, as one line of compact JSON.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] output A pointer to a valid PARCOutputStream instance.
+ *
+ * @return true The snapshot was written.
+ * @return false The output stream failed to take the snapshot.
+ */
+bool parcMetrics_Dump(const PARCMetrics *metrics, PARCOutputStream *output);
+
+/**
+ * Start writing a snapshot of the registry to the given output stream every @p intervalNanoseconds.
+ *
+ * The snapshots are written, as by `parcMetrics_Dump`, from a thread started by this function.
+ * The registry acquires a reference to @p output until the dump is stopped.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ * @param [in] output A pointer to a valid PARCOutputStream instance.
+ * @param [in] intervalNanoseconds The time between snapshots, greater than 0.
+ *
+ * @return true The periodic dump was started.
+ * @return false A periodic dump is already running, or the thread could not be started.
+ */
+bool parcMetrics_StartPeriodicDump(PARCMetrics *metrics, PARCOutputStream *output, uint64_t intervalNanoseconds);
+
+/**
+ * Stop a periodic dump started by `parcMetrics_StartPeriodicDump`, waiting for its thread to finish.
+ *
+ * Nothing happens if no periodic dump is running.
+ *
+ * @param [in] metrics A pointer to a valid PARCMetrics instance.
+ */
+void parcMetrics_StopPeriodicDump(PARCMetrics *metrics);
+#endif
@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include <config.h>
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#include <parc/algol/parc_Object.h>
+#include <parc/algol/parc_DisplayIndented.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/statistics/parc_EWMA.h>
+#include <parc/statistics/parc_RateMeter.h>
+
+#define _NANOSECONDS_PER_SECOND 1000000000ULL
+#define _TICK_INTERVAL (5 * _NANOSECONDS_PER_SECOND)
+
+// The moving averages hold rates in events per second as fixed point numbers with 16 fractional bits.
+#define _FIXED_POINT_ONE 65536.0
+
+/*
+ * Each window bucket counts the events of one second in the low bits,
+ * and identifies which second in the high bits, so a single compare-and-swap both claims a stale bucket and counts into it.
+ */
+#define _WINDOW_BUCKETS 64
+#define _BUCKET_COUNT_BITS 40
+#define _BUCKET_COUNT_MASK ((1ULL << _BUCKET_COUNT_BITS) - 1)
+#define _BUCKET_SECOND_MASK ((1ULL << (64 - _BUCKET_COUNT_BITS)) - 1)
+
+struct PARCRateMeter {
+    uint64_t startTime;
+    volatile uint64_t count;
+
+    volatile uint64_t lastTick;
+    uint64_t countAtLastTick;
+    volatile int ticking;
+
+    PARCEWMA *oneMinute;
+    PARCEWMA *fiveMinute;
+    PARCEWMA *fifteenMinute;
+
+    volatile uint64_t window[_WINDOW_BUCKETS];
+};
+
+static inline uint64_t
+_parcRateMeter_BucketTag(uint64_t second)
+{
+    return (second & _BUCKET_SECOND_MASK) << _BUCKET_COUNT_BITS;
+}
+
+static void
+_parcRateMeter_CountInWindow(PARCRateMeter *meter, uint64_t count, uint64_t now)
+{
+    uint64_t second = now / _NANOSECONDS_PER_SECOND;
+    uint64_t tag = _parcRateMeter_BucketTag(second);
+    volatile uint64_t *bucket = &meter->window[second % _WINDOW_BUCKETS];
+
+    uint64_t current = *bucket;
+    for (;;) {
+        uint64_t counted = ((current & ~_BUCKET_COUNT_MASK) == tag) ? (current & _BUCKET_COUNT_MASK) : 0;
+        uint64_t previous = __sync_val_compare_and_swap(bucket, current, tag | ((counted + count) & _BUCKET_COUNT_MASK));
+        if (previous == current) {
+            break;
+        }
+        current = previous;
+    }
+}
+
+static uint64_t
+_parcRateMeter_WindowCount(const PARCRateMeter *meter, uint64_t second)
+{
+    uint64_t bucket = meter->window[second % _WINDOW_BUCKETS];
+    return ((bucket & ~_BUCKET_COUNT_MASK) == _parcRateMeter_BucketTag(second)) ? (bucket & _BUCKET_COUNT_MASK) : 0;
+}
+
+/**
+ * Update the moving averages if a tick is due.
+ *
+ * At most one thread performs a tick; any other thread finding a tick in progress carries on without waiting.
+ */
+static void
+_parcRateMeter_TickIfDue(PARCRateMeter *meter, uint64_t now)
+{
+    if (now < meter->lastTick + _TICK_INTERVAL) {
+        return;
+    }
+    if (__sync_lock_test_and_set(&meter->ticking, 1)) {
+        return;
+    }
+
+    uint64_t lastTick = meter->lastTick;
+    if (now >= lastTick + _TICK_INTERVAL) {
+        uint64_t elapsed = now - lastTick;
+        uint64_t count = meter->count;
+
+        double rate = (double) (count - meter->countAtLastTick) * _NANOSECONDS_PER_SECOND / (double) elapsed;
+        int64_t fixedPointRate = (int64_t) (rate * _FIXED_POINT_ONE);
+
+        parcEWMA_UpdateElapsed(meter->oneMinute, fixedPointRate, elapsed);
+        parcEWMA_UpdateElapsed(meter->fiveMinute, fixedPointRate, elapsed);
+        parcEWMA_UpdateElapsed(meter->fifteenMinute, fixedPointRate, elapsed);
+
+        meter->countAtLastTick = count;
+        meter->lastTick = now;
+    }
+
+    __sync_lock_release(&meter->ticking);
+}
+
+static void
+_parcRateMeter_MarkAt(PARCRateMeter *meter, uint64_t count, uint64_t now)
+{
+    __sync_fetch_and_add(&meter->count, count);
+    _parcRateMeter_CountInWindow(meter, count, now);
+    _parcRateMeter_TickIfDue(meter, now);
+}
+
+static double
+_parcRateMeter_WindowRateAt(const PARCRateMeter *meter, unsigned seconds, uint64_t now)
+{
+    uint64_t currentSecond = now / _NANOSECONDS_PER_SECOND;
+
+    uint64_t total = 0;
+    for (unsigned i = 1; i <= seconds; i++) {
+        total += _parcRateMeter_WindowCount(meter, currentSecond - i);
+    }
+
+    return (double) total / (double) seconds;
+}
+
+static double
+_parcRateMeter_MeanRateAt(const PARCRateMeter *meter, uint64_t now)
+{
+    double result = 0.0;
+
+    if (now > meter->startTime) {
+        result = (double) meter->count * _NANOSECONDS_PER_SECOND / (double) (now - meter->startTime);
+    }
+
+    return result;
+}
+
+static double
+_parcRateMeter_Rate(const PARCEWMA *ewma)
+{
+    return (double) parcEWMA_GetValue(ewma) / _FIXED_POINT_ONE;
+}
+
+static bool
+_parcRateMeter_Destructor(PARCRateMeter **instancePtr)
+{
+    assertNotNull(instancePtr, "Parameter must be a non-null pointer to a PARCRateMeter pointer.");
+    PARCRateMeter *meter = *instancePtr;
+
+    if (meter->oneMinute != NULL) {
+        parcEWMA_Release(&meter->oneMinute);
+    }
+    if (meter->fiveMinute != NULL) {
+        parcEWMA_Release(&meter->fiveMinute);
+    }
+    if (meter->fifteenMinute != NULL) {
+        parcEWMA_Release(&meter->fifteenMinute);
+    }
+
+    return true;
+}
+
+parcObject_ImplementAcquire(parcRateMeter, PARCRateMeter);
+
+parcObject_ImplementRelease(parcRateMeter, PARCRateMeter);
+
+parcObject_Override(
+    PARCRateMeter, PARCObject,
+    .destructor = (PARCObjectDestructor *) _parcRateMeter_Destructor,
+    .toString = (PARCObjectToString *)  parcRateMeter_ToString,
+    .toJSON = (PARCObjectToJSON *)  parcRateMeter_ToJSON);
+
+void
+parcRateMeter_AssertValid(const PARCRateMeter *instance)
+{
+    assertTrue(parcRateMeter_IsValid(instance),
+               "PARCRateMeter is not valid.");
+}
+
+static PARCRateMeter *
+_parcRateMeter_Create(uint64_t now)
+{
+    PARCRateMeter *result = parcObject_CreateAndClearInstance(PARCRateMeter);
+
+    if (result != NULL) {
+        result->startTime = now;
+        result->lastTick = now;
+
+        result->oneMinute = parcEWMA_CreateTimeDecay(60 * _NANOSECONDS_PER_SECOND);
+        result->fiveMinute = parcEWMA_CreateTimeDecay(5 * 60 * _NANOSECONDS_PER_SECOND);
+        result->fifteenMinute = parcEWMA_CreateTimeDecay(15 * 60 * _NANOSECONDS_PER_SECOND);
+
+        if (result->oneMinute == NULL || result->fiveMinute == NULL || result->fifteenMinute == NULL) {
+            parcRateMeter_Release(&result);
+        }
+    }
+
+    return result;
+}
+
+PARCRateMeter *
+parcRateMeter_Create(void)
+{
+    return _parcRateMeter_Create(parcTime_NowNanoseconds());
+}
+
+void
+parcRateMeter_Display(const PARCRateMeter *meter, int indentation)
+{
+    parcDisplayIndented_PrintLine(indentation,
+                                  "PARCRateMeter@%p { .count=%" PRIu64 " .meanRate=%lf .oneMinuteRate=%lf .fiveMinuteRate=%lf .fifteenMinuteRate=%lf }",
+                                  meter, meter->count, parcRateMeter_GetMeanRate(meter),
+                                  _parcRateMeter_Rate(meter->oneMinute),
+                                  _parcRateMeter_Rate(meter->fiveMinute),
+                                  _parcRateMeter_Rate(meter->fifteenMinute));
+}
+
+bool
+parcRateMeter_IsValid(const PARCRateMeter *meter)
+{
+    bool result = false;
+
+    if (meter != NULL) {
+        result = (meter->oneMinute != NULL && meter->fiveMinute != NULL && meter->fifteenMinute != NULL);
+    }
+
+    return result;
+}
+
+static void
+_parcRateMeter_AddDouble(PARCJSON *json, const char *name, double value)
+{
+    PARCJSONPair *pair = parcJSONPair_CreateFromDouble(name, value);
+    parcJSON_AddPair(json, pair);
+    parcJSONPair_Release(&pair);
+}
+
+PARCJSON *
+parcRateMeter_ToJSON(const PARCRateMeter *meter)
+{
+    PARCJSON *result = parcJSON_Create();
+
+    if (result != NULL) {
+        parcJSON_AddInteger(result, "count", (int64_t) meter->count);
+        _parcRateMeter_AddDouble(result, "meanRate", parcRateMeter_GetMeanRate(meter));
+        _parcRateMeter_AddDouble(result, "oneMinuteRate", _parcRateMeter_Rate(meter->oneMinute));
+        _parcRateMeter_AddDouble(result, "fiveMinuteRate", _parcRateMeter_Rate(meter->fiveMinute));
+        _parcRateMeter_AddDouble(result, "fifteenMinuteRate", _parcRateMeter_Rate(meter->fifteenMinute));
+    }
+
+    return result;
+}
+
+char *
+parcRateMeter_ToString(const PARCRateMeter *meter)
+{
+    char *result = parcMemory_Format("PARCRateMeter@%p { .count=%" PRIu64 " .meanRate=%lf .oneMinuteRate=%lf .fiveMinuteRate=%lf .fifteenMinuteRate=%lf }",
+                                     meter, meter->count, parcRateMeter_GetMeanRate(meter),
+                                     _parcRateMeter_Rate(meter->oneMinute),
+                                     _parcRateMeter_Rate(meter->fiveMinute),
+                                     _parcRateMeter_Rate(meter->fifteenMinute));
+
+    return result;
+}
+
+void
+parcRateMeter_Mark(PARCRateMeter *meter, uint64_t count)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+
+    _parcRateMeter_MarkAt(meter, count, parcTime_NowNanoseconds());
+}
+
+uint64_t
+parcRateMeter_GetCount(const PARCRateMeter *meter)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+
+    return meter->count;
+}
+
+double
+parcRateMeter_GetMeanRate(const PARCRateMeter *meter)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+
+    return _parcRateMeter_MeanRateAt(meter, parcTime_NowNanoseconds());
+}
+
+double
+parcRateMeter_GetOneMinuteRate(PARCRateMeter *meter)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+
+    _parcRateMeter_TickIfDue(meter, parcTime_NowNanoseconds());
+    return _parcRateMeter_Rate(meter->oneMinute);
+}
+
+double
+parcRateMeter_GetFiveMinuteRate(PARCRateMeter *meter)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+
+    _parcRateMeter_TickIfDue(meter, parcTime_NowNanoseconds());
+    return _parcRateMeter_Rate(meter->fiveMinute);
+}
+
+double
+parcRateMeter_GetFifteenMinuteRate(PARCRateMeter *meter)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+
+    _parcRateMeter_TickIfDue(meter, parcTime_NowNanoseconds());
+    return _parcRateMeter_Rate(meter->fifteenMinute);
+}
+
+double
+parcRateMeter_GetWindowRate(const PARCRateMeter *meter, unsigned seconds)
+{
+    parcRateMeter_OptionalAssertValid(meter);
+    assertTrue(seconds >= 1 && seconds <= PARCRateMeter_MaximumWindowSeconds,
+               "The window must be from 1 to %d seconds, not %u", PARCRateMeter_MaximumWindowSeconds, seconds);
+
+    return _parcRateMeter_WindowRateAt(meter, seconds, parcTime_NowNanoseconds());
+}
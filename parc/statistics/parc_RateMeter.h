@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @file parc_RateMeter.h
+ * @ingroup statistics
+ * @brief Measure the rate at which events occur, over the last few seconds and over the last 1, 5 and 15 minutes.
+ *
+ * A `PARCRateMeter` counts events marked by any number of threads.
+ * It reports two kinds of rate, in events per second:
+ *
+ * * Moving average rates over 1, 5 and 15 minutes.  These are {@link PARCEWMA} filters with time based decay,
+ *   in the manner of the Unix load averages, so they depend on wall clock time and not on how often events occur.
+ * * Exact rates over the last 1 to 60 whole seconds, counted in a ring of one-second buckets.
+ *
+ * Marking events takes no locks.  The moving averages are updated by a tick at most every 5 seconds,
+ * performed by whichever thread marks an event or reads a rate first after the tick is due.
+ * A single tick accounts for any length of time since the previous one, so an idle meter costs nothing.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCRateMeter *meter = parcRateMeter_Create();
+ *
+ *     // In any number of threads
+ *     parcRateMeter_Mark(meter, 1);
+ *
+ *     printf("%f packets per second\n", parcRateMeter_GetOneMinuteRate(meter));
+ *
+ *     parcRateMeter_Release(&meter);
+ * }
+ * @endcode
+ *
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#ifndef PARCLibrary_parc_RateMeter
+#define PARCLibrary_parc_RateMeter
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <parc/algol/parc_JSON.h>
+
+struct PARCRateMeter;
+typedef struct PARCRateMeter PARCRateMeter;
+
+/**
+ * The largest number of seconds over which `parcRateMeter_GetWindowRate` can report a rate.
+ */
+#define PARCRateMeter_MaximumWindowSeconds 60
+
+/**
+ * Increase the number of references to a `PARCRateMeter` instance.
+ *
+ * Note that new `PARCRateMeter` is not created,
+ * only that the given `PARCRateMeter` reference count is incremented.
+ * Discard the reference by invoking `parcRateMeter_Release`.
+ *
+ * @param [in] instance A pointer to a valid PARCRateMeter instance.
+ *
+ * @return The same value as @p instance.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCRateMeter *a = parcRateMeter_Create();
+ *
+ *     PARCRateMeter *b = parcRateMeter_Acquire(a);
+ *
+ *     parcRateMeter_Release(&a);
+ *     parcRateMeter_Release(&b);
+ * }
+ * @endcode
+ */
+PARCRateMeter *parcRateMeter_Acquire(const PARCRateMeter *instance);
+
+#ifdef PARCLibrary_DISABLE_VALIDATION
+#  define parcRateMeter_OptionalAssertValid(_instance_)
+#else
+#  define parcRateMeter_OptionalAssertValid(_instance_) parcRateMeter_AssertValid(_instance_)
+#endif
+
+/**
+ * Assert that the given `PARCRateMeter` instance is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCRateMeter instance.
+ */
+void parcRateMeter_AssertValid(const PARCRateMeter *instance);
+
+/**
+ * Create an instance of PARCRateMeter, starting its measurements now.
+ *
+ * @return non-NULL A pointer to a valid PARCRateMeter instance.
+ * @return NULL An error occurred.
+ *
+ * Example:
+ * @code
+ * {
+ *     PARCRateMeter *a = parcRateMeter_Create();
+ *
+ *     parcRateMeter_Release(&a);
+ * }
+ * @endcode
+ */
+PARCRateMeter *parcRateMeter_Create(void);
+
+/**
+ * Print a human readable representation of the given `PARCRateMeter`.
+ *
+ * @param [in] instance A pointer to a valid PARCRateMeter instance.
+ * @param [in] indentation The indentation level to use for printing.
+ */
+void parcRateMeter_Display(const PARCRateMeter *instance, int indentation);
+
+/**
+ * Determine if an instance of `PARCRateMeter` is valid.
+ *
+ * @param [in] instance A pointer to a valid PARCRateMeter instance.
+ *
+ * @return true The instance is valid.
+ * @return false The instance is not valid.
+ */
+bool parcRateMeter_IsValid(const PARCRateMeter *instance);
+
+/**
+ * Release a previously acquired reference to the given `PARCRateMeter` instance,
+ * decrementing the reference count for the instance.
+ *
+ * The pointer to the instance is set to NULL as a side-effect of this function.
+ *
+ * If the invocation causes the last reference to the instance to be released,
+ * the instance is deallocated and the instance's implementation will perform
+ * additional cleanup and release other privately held references.
+ *
+ * @param [in,out] instancePtr A pointer to a pointer to the instance to release.
+ */
+void parcRateMeter_Release(PARCRateMeter **instancePtr);
+
+/**
+ * Create a `PARCJSON` instance (representation) of the given object.
+ *
+ * The JSON object contains the total count and the mean, 1, 5 and 15 minute rates.
+ *
+ * @param [in] instance A pointer to a valid PARCRateMeter instance.
+ *
+ * @return NULL Memory could not be allocated to contain the `PARCJSON` instance.
+ * @return non-NULL A pointer to a `PARCJSON` instance that must be released via parcJSON_Release().
+ */
+PARCJSON *parcRateMeter_ToJSON(const PARCRateMeter *instance);
+
+/**
+ * Produce a null-terminated string representation of the specified `PARCRateMeter`.
+ *
+ * The result must be freed by the caller via {@link parcMemory_Deallocate}.
+ *
+ * @param [in] instance A pointer to a valid PARCRateMeter instance.
+ *
+ * @return NULL Cannot allocate memory.
+ * @return non-NULL A pointer to an allocated, null-terminated C string that must be deallocated via {@link parcMemory_Deallocate}.
+ */
+char *parcRateMeter_ToString(const PARCRateMeter *instance);
+
+/**
+ * Record that @p count events occurred now.
+ *
+ * Any number of threads may mark events on the same meter concurrently.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ * @param [in] count The number of events.
+ *
+ * Example:
+ * @code
+ * {
+ *     parcRateMeter_Mark(meter, parcBuffer_Remaining(packet));
+ * }
+ * @endcode
+ */
+void parcRateMeter_Mark(PARCRateMeter *meter, uint64_t count);
+
+/**
+ * Get the total number of events marked since the meter was created.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ *
+ * @return The total number of events.
+ */
+uint64_t parcRateMeter_GetCount(const PARCRateMeter *meter);
+
+/**
+ * Get the mean rate, in events per second, since the meter was created.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ *
+ * @return The mean rate in events per second.
+ */
+double parcRateMeter_GetMeanRate(const PARCRateMeter *meter);
+
+/**
+ * Get the exponentially weighted moving average rate, in events per second, with a time constant of 1 minute.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ *
+ * @return The 1 minute moving average rate in events per second.
+ */
+double parcRateMeter_GetOneMinuteRate(PARCRateMeter *meter);
+
+/**
+ * Get the exponentially weighted moving average rate, in events per second, with a time constant of 5 minutes.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ *
+ * @return The 5 minute moving average rate in events per second.
+ */
+double parcRateMeter_GetFiveMinuteRate(PARCRateMeter *meter);
+
+/**
+ * Get the exponentially weighted moving average rate, in events per second, with a time constant of 15 minutes.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ *
+ * @return The 15 minute moving average rate in events per second.
+ */
+double parcRateMeter_GetFifteenMinuteRate(PARCRateMeter *meter);
+
+/**
+ * Get the exact rate, in events per second, over the last @p seconds whole seconds.
+ *
+ * Events marked during the current, incomplete, second are not included.
+ *
+ * @param [in] meter A pointer to a valid PARCRateMeter instance.
+ * @param [in] seconds The length of the window, from 1 to `PARCRateMeter_MaximumWindowSeconds`.
+ *
+ * @return The rate in events per second over the window.
+ */
+double parcRateMeter_GetWindowRate(const PARCRateMeter *meter, unsigned seconds);
+#endif
@@ -60,12 +60,14 @@
 
 #include <inttypes.h>
 #include <math.h>
+#include <pthread.h>
 
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
 #include <parc/algol/parc_Memory.h>
 #include <parc/algol/parc_SafeMemory.h>
 #include <parc/algol/parc_DisplayIndented.h>
+#include <parc/algol/parc_Time.h>
 
 #include <parc/testing/parc_MemoryTesting.h>
 #include <parc/testing/parc_ObjectTesting.h>
@@ -78,6 +80,8 @@ LONGBOW_TEST_RUNNER(parc_BasicStats)
     LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
     LONGBOW_RUN_TEST_FIXTURE(Object);
     LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
 }
 
 // The Test Runner calls this function once before any Test Fixtures are run.
@@ -230,6 +234,10 @@ LONGBOW_TEST_CASE(Object, parcBasicStats_ToString)
 LONGBOW_TEST_FIXTURE(Specialization)
 {
     LONGBOW_RUN_TEST_CASE(Specialization, parcBasicStats_Update);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBasicStats_Update_MinimumMaximum);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBasicStats_Merge);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBasicStats_Merge_Empty);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcBasicStats_Snapshot);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -276,6 +284,259 @@ LONGBOW_TEST_CASE(Specialization, parcBasicStats_Update)
     parcBasicStats_Release(&stats);
 }
 
+LONGBOW_TEST_CASE(Specialization, parcBasicStats_Update_MinimumMaximum)
+{
+    PARCBasicStats *stats = parcBasicStats_Create();
+
+    parcBasicStats_Update(stats, 7);
+    parcBasicStats_Update(stats, 3);
+    parcBasicStats_Update(stats, 11);
+
+    assertTrue(parcBasicStats_Minimum(stats) == 3, "Expected 3 actual %lf", parcBasicStats_Minimum(stats));
+    assertTrue(parcBasicStats_Maximum(stats) == 11, "Expected 11 actual %lf", parcBasicStats_Maximum(stats));
+    assertTrue(parcBasicStats_Range(stats) == 8, "Expected 8 actual %lf", parcBasicStats_Range(stats));
+
+    parcBasicStats_Release(&stats);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBasicStats_Merge)
+{
+    PARCBasicStats *all = parcBasicStats_Create();
+    PARCBasicStats *low = parcBasicStats_Create();
+    PARCBasicStats *high = parcBasicStats_Create();
+
+    for (int i = 1; i <= 100; i++) {
+        double value = i * 0.5 + (i % 7);
+        parcBasicStats_Update(all, value);
+        parcBasicStats_Update(i <= 30 ? low : high, value);
+    }
+
+    parcBasicStats_Merge(low, high);
+
+    assertTrue(parcBasicStats_Equals(low, all), "Expected the merged statistics to equal the statistics of all values");
+    assertTrue(fabs(parcBasicStats_Variance(low) - parcBasicStats_Variance(all)) < 1e-9,
+               "Expected variance %lf actual %lf", parcBasicStats_Variance(all), parcBasicStats_Variance(low));
+
+    parcBasicStats_Release(&all);
+    parcBasicStats_Release(&low);
+    parcBasicStats_Release(&high);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBasicStats_Merge_Empty)
+{
+    PARCBasicStats *stats = parcBasicStats_Create();
+    PARCBasicStats *empty = parcBasicStats_Create();
+    PARCBasicStats *expected = parcBasicStats_Create();
+
+    parcBasicStats_Update(expected, -4);
+    parcBasicStats_Update(expected, -2);
+
+    parcBasicStats_Merge(stats, empty);
+    parcBasicStats_Merge(stats, expected);
+    parcBasicStats_Merge(stats, empty);
+
+    assertTrue(parcBasicStats_Equals(stats, expected), "Expected merging into and from an empty instance to change nothing");
+    assertTrue(parcBasicStats_Maximum(stats) == -2, "Expected -2 actual %lf", parcBasicStats_Maximum(stats));
+
+    parcBasicStats_Release(&stats);
+    parcBasicStats_Release(&empty);
+    parcBasicStats_Release(&expected);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcBasicStats_Snapshot)
+{
+    PARCBasicStats *stats = parcBasicStats_CreateConcurrent();
+
+    for (int i = 1; i <= 10; i++) {
+        parcBasicStats_Update(stats, i);
+    }
+
+    PARCBasicStats *snapshot = parcBasicStats_Snapshot(stats);
+    parcBasicStats_Update(stats, 1000);
+
+    assertTrue(fabs(parcBasicStats_Mean(snapshot) - 5.5) < 0.001, "Expected 5.5 actual %lf", parcBasicStats_Mean(snapshot));
+    assertTrue(fabs(parcBasicStats_Variance(snapshot) - 8.25) < 0.001, "Expected 8.25 actual %lf", parcBasicStats_Variance(snapshot));
+    assertTrue(parcBasicStats_Maximum(stats) == 1000, "Expected the concurrent instance to read its current state");
+    assertTrue(parcBasicStats_Maximum(snapshot) == 10, "Expected the snapshot to be independent of later updates");
+
+    parcBasicStats_Release(&snapshot);
+    parcBasicStats_Release(&stats);
+}
+
+#define _THREAD_COUNT 4
+#define _UPDATES_PER_THREAD 100000
+
+typedef struct {
+    PARCBasicStats *stats;
+    int thread;
+} _UpdaterArgs;
+
+static double
+_valueFor(int thread, int i)
+{
+    return (double) ((thread * 7919 + (int64_t) i * 104729) % 1000) / 10.0;
+}
+
+static void *
+_updater(void *arg)
+{
+    _UpdaterArgs *args = arg;
+    for (int i = 0; i < _UPDATES_PER_THREAD; i++) {
+        parcBasicStats_Update(args->stats, _valueFor(args->thread, i));
+    }
+    return NULL;
+}
+
+static volatile bool _readerDone;
+
+static void *
+_snapshotReader(void *arg)
+{
+    PARCBasicStats *stats = arg;
+    int64_t previousCount = 0;
+    while (!_readerDone) {
+        PARCBasicStats *snapshot = parcBasicStats_Snapshot(stats);
+        assertTrue(snapshot->count >= previousCount, "Expected the count never to decrease");
+        if (snapshot->count > 0) {
+            assertTrue(parcBasicStats_Minimum(snapshot) >= 0 && parcBasicStats_Maximum(snapshot) < 100,
+                       "Expected a consistent snapshot, minimum %lf maximum %lf",
+                       parcBasicStats_Minimum(snapshot), parcBasicStats_Maximum(snapshot));
+            assertTrue(parcBasicStats_Mean(snapshot) >= 0 && parcBasicStats_Mean(snapshot) < 100,
+                       "Expected a consistent snapshot, mean %lf", parcBasicStats_Mean(snapshot));
+        }
+        previousCount = snapshot->count;
+        parcBasicStats_Release(&snapshot);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcBasicStats_Update);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcBasicStats_Update)
+{
+    PARCBasicStats *stats = parcBasicStats_CreateConcurrent();
+    PARCBasicStats *expected = parcBasicStats_Create();
+
+    _readerDone = false;
+    pthread_t reader;
+    pthread_create(&reader, NULL, _snapshotReader, stats);
+
+    pthread_t threads[_THREAD_COUNT];
+    _UpdaterArgs args[_THREAD_COUNT];
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        args[i].stats = stats;
+        args[i].thread = i;
+        pthread_create(&threads[i], NULL, _updater, &args[i]);
+    }
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        for (int j = 0; j < _UPDATES_PER_THREAD; j++) {
+            parcBasicStats_Update(expected, _valueFor(i, j));
+        }
+    }
+    _readerDone = true;
+    pthread_join(reader, NULL);
+
+    PARCBasicStats *snapshot = parcBasicStats_Snapshot(stats);
+    assertTrue(snapshot->count == _THREAD_COUNT * _UPDATES_PER_THREAD,
+               "Expected %d updates, actual %" PRId64, _THREAD_COUNT * _UPDATES_PER_THREAD, snapshot->count);
+    assertTrue(parcBasicStats_Equals(snapshot, expected), "Expected no lost updates");
+    assertTrue(fabs(parcBasicStats_Variance(snapshot) - parcBasicStats_Variance(expected)) < 1e-6,
+               "Expected variance %lf actual %lf", parcBasicStats_Variance(expected), parcBasicStats_Variance(snapshot));
+
+    parcBasicStats_Release(&snapshot);
+    parcBasicStats_Release(&expected);
+    parcBasicStats_Release(&stats);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcBasicStats_Update);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _PERFORMANCE_UPDATES 10000000
+
+static pthread_mutex_t _performanceLock = PTHREAD_MUTEX_INITIALIZER;
+
+static void *
+_lockedUpdater(void *arg)
+{
+    PARCBasicStats *stats = arg;
+    for (int i = 0; i < _PERFORMANCE_UPDATES; i++) {
+        pthread_mutex_lock(&_performanceLock);
+        parcBasicStats_Update(stats, i & 1023);
+        pthread_mutex_unlock(&_performanceLock);
+    }
+    return NULL;
+}
+
+static void *
+_concurrentUpdater(void *arg)
+{
+    PARCBasicStats *stats = arg;
+    for (int i = 0; i < _PERFORMANCE_UPDATES; i++) {
+        parcBasicStats_Update(stats, i & 1023);
+    }
+    return NULL;
+}
+
+static double
+_timeUpdates(void *(*updater)(void *), PARCBasicStats *stats, int threadCount)
+{
+    pthread_t threads[threadCount];
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < threadCount; i++) {
+        pthread_create(&threads[i], NULL, updater, stats);
+    }
+    for (int i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return (double) (parcTime_NowNanoseconds() - start) / ((double) threadCount * _PERFORMANCE_UPDATES);
+}
+
+LONGBOW_TEST_CASE(Performance, parcBasicStats_Update)
+{
+    for (int threadCount = 1; threadCount <= _THREAD_COUNT; threadCount *= 2) {
+        PARCBasicStats *locked = parcBasicStats_Create();
+        PARCBasicStats *concurrent = parcBasicStats_CreateConcurrent();
+
+        double lockedTime = _timeUpdates(_lockedUpdater, locked, threadCount);
+        double concurrentTime = _timeUpdates(_concurrentUpdater, concurrent, threadCount);
+
+        printf("%d threads: mutex %.1f ns, concurrent %.1f ns per update\n", threadCount, lockedTime, concurrentTime);
+
+        parcBasicStats_Release(&locked);
+        parcBasicStats_Release(&concurrent);
+    }
+}
+
 int
 main(int argc, char *argv[argc])
 {
@@ -59,6 +59,7 @@
 #include "../parc_EWMA.c"
 #include <stdio.h>
 #include <inttypes.h>
+#include <stdlib.h>
 
 #include <LongBow/testing.h>
 #include <LongBow/debugging.h>
@@ -245,6 +246,8 @@ LONGBOW_TEST_FIXTURE(Specialization)
 {
     LONGBOW_RUN_TEST_CASE(Specialization, parcEWMA_Update);
     LONGBOW_RUN_TEST_CASE(Specialization, parcEWMA_GetValue);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcEWMA_UpdateElapsed);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcEWMA_UpdateElapsed_IntervalIndependent);
 }
 
 LONGBOW_TEST_FIXTURE_SETUP(Specialization)
@@ -286,6 +289,41 @@ LONGBOW_TEST_FIXTURE_TEARDOWN(Specialization)
     return LONGBOW_STATUS_SUCCEEDED;
 }
 
+LONGBOW_TEST_CASE(Specialization, parcEWMA_UpdateElapsed)
+{
+    PARCEWMA *instance = parcEWMA_CreateTimeDecay(1000000000ULL);
+
+    parcEWMA_UpdateElapsed(instance, 1000000, 0);
+    int64_t value = parcEWMA_UpdateElapsed(instance, 0, 1000000000ULL);
+
+    // After one time constant the previous value has decayed by a factor of e.
+    int64_t expected = (int64_t) (1000000 * exp(-1.0));
+    assertTrue(llabs(value - expected) <= 1, "Expected %" PRId64 ", actual %" PRId64 "", expected, value);
+
+    parcEWMA_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcEWMA_UpdateElapsed_IntervalIndependent)
+{
+    PARCEWMA *coarse = parcEWMA_CreateTimeDecay(60 * 1000000000ULL);
+    PARCEWMA *fine = parcEWMA_CreateTimeDecay(60 * 1000000000ULL);
+
+    parcEWMA_UpdateElapsed(coarse, 1000000000, 0);
+    parcEWMA_UpdateElapsed(fine, 1000000000, 0);
+
+    // Decaying toward 0 over 60 seconds in one step, or in 60 steps of one second, gives the same value.
+    int64_t coarseValue = parcEWMA_UpdateElapsed(coarse, 0, 60 * 1000000000ULL);
+    int64_t fineValue = 0;
+    for (int i = 0; i < 60; i++) {
+        fineValue = parcEWMA_UpdateElapsed(fine, 0, 1000000000ULL);
+    }
+
+    assertTrue(llabs(coarseValue - fineValue) <= 60, "Expected %" PRId64 ", actual %" PRId64 "", coarseValue, fineValue);
+
+    parcEWMA_Release(&coarse);
+    parcEWMA_Release(&fine);
+}
+
 int
 main(int argc, char *argv[argc])
 {
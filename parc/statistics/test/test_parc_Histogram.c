@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_Histogram.c"
+
+#include <inttypes.h>
+#include <pthread.h>
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_Histogram)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
+    LONGBOW_RUN_TEST_FIXTURE(Object);
+    LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_Histogram)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_Histogram)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(CreateAcquireRelease)
+{
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateRelease);
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, Create_MemorySize);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(CreateAcquireRelease)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(CreateAcquireRelease)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateRelease)
+{
+    PARCHistogram *instance = parcHistogram_Create(3600000000000ULL, 3);
+    assertNotNull(instance, "Expected non-null result from parcHistogram_Create();");
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcHistogram_Acquire, instance);
+
+    parcHistogram_Release(&instance);
+    assertNull(instance, "Expected null result from parcHistogram_Release();");
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, Create_MemorySize)
+{
+    // One hour in nanoseconds at 3 significant digits, as documented.
+    PARCHistogram *hour = parcHistogram_Create(3600000000000ULL, 3);
+    size_t hourSize = parcHistogram_GetMemorySize(hour);
+    assertTrue(hourSize < 300 * 1024, "Expected less than 300 KB, actual %zu", hourSize);
+
+    PARCHistogram *coarse = parcHistogram_Create(3600000000000ULL, 1);
+    assertTrue(parcHistogram_GetMemorySize(coarse) < hourSize / 50,
+               "Expected fewer significant digits to use much less memory, actual %zu", parcHistogram_GetMemorySize(coarse));
+
+    PARCHistogram *largest = parcHistogram_Create(UINT64_MAX, 2);
+    assertTrue(parcHistogram_Record(largest, UINT64_MAX), "Expected UINT64_MAX to be trackable.");
+    assertTrue(parcHistogram_GetValueAtPercentile(largest, 100.0) == UINT64_MAX, "Expected the maximum to be reported.");
+
+    parcHistogram_Release(&hour);
+    parcHistogram_Release(&coarse);
+    parcHistogram_Release(&largest);
+}
+
+LONGBOW_TEST_FIXTURE(Object)
+{
+    LONGBOW_RUN_TEST_CASE(Object, parcHistogram_Copy);
+    LONGBOW_RUN_TEST_CASE(Object, parcHistogram_Display);
+    LONGBOW_RUN_TEST_CASE(Object, parcHistogram_Equals);
+    LONGBOW_RUN_TEST_CASE(Object, parcHistogram_IsValid);
+    LONGBOW_RUN_TEST_CASE(Object, parcHistogram_ToJSON);
+    LONGBOW_RUN_TEST_CASE(Object, parcHistogram_ToString);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Object)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Object)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Object, parcHistogram_Copy)
+{
+    PARCHistogram *instance = parcHistogram_Create(1000000, 3);
+    parcHistogram_Record(instance, 5);
+    parcHistogram_Record(instance, 50000);
+
+    PARCHistogram *copy = parcHistogram_Copy(instance);
+    assertTrue(parcHistogram_Equals(instance, copy), "Expected the copy to be equal to the original");
+
+    parcHistogram_Record(instance, 7);
+    assertFalse(parcHistogram_Equals(instance, copy), "Expected the copy to be independent of the original");
+
+    parcHistogram_Release(&instance);
+    parcHistogram_Release(&copy);
+}
+
+LONGBOW_TEST_CASE(Object, parcHistogram_Display)
+{
+    PARCHistogram *instance = parcHistogram_Create(1000000, 3);
+    parcHistogram_Record(instance, 42);
+    parcHistogram_Display(instance, 0);
+    parcHistogram_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Object, parcHistogram_Equals)
+{
+    PARCHistogram *x = parcHistogram_Create(1000000, 3);
+    PARCHistogram *y = parcHistogram_Create(1000000, 3);
+    PARCHistogram *z = parcHistogram_Create(1000000, 3);
+    PARCHistogram *differentCount = parcHistogram_Create(1000000, 3);
+    PARCHistogram *differentPrecision = parcHistogram_Create(1000000, 2);
+
+    parcHistogram_Record(x, 10);
+    parcHistogram_Record(y, 10);
+    parcHistogram_Record(z, 10);
+    parcHistogram_Record(differentCount, 10);
+    parcHistogram_Record(differentCount, 10);
+    parcHistogram_Record(differentPrecision, 10);
+
+    parcObjectTesting_AssertEquals(x, y, z, differentCount, differentPrecision, NULL);
+
+    parcHistogram_Release(&x);
+    parcHistogram_Release(&y);
+    parcHistogram_Release(&z);
+    parcHistogram_Release(&differentCount);
+    parcHistogram_Release(&differentPrecision);
+}
+
+LONGBOW_TEST_CASE(Object, parcHistogram_IsValid)
+{
+    PARCHistogram *instance = parcHistogram_Create(1000000, 3);
+    assertTrue(parcHistogram_IsValid(instance), "Expected parcHistogram_Create to result in a valid instance.");
+
+    parcHistogram_Release(&instance);
+    assertFalse(parcHistogram_IsValid(instance), "Expected parcHistogram_Release to result in an invalid instance.");
+}
+
+LONGBOW_TEST_CASE(Object, parcHistogram_ToJSON)
+{
+    PARCHistogram *instance = parcHistogram_Create(1000000, 3);
+    for (uint64_t i = 1; i <= 1000; i++) {
+        parcHistogram_Record(instance, i);
+    }
+
+    PARCJSON *json = parcHistogram_ToJSON(instance);
+
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "count");
+    assertTrue(parcJSONValue_GetInteger(value) == 1000, "Expected count 1000");
+
+    value = parcJSON_GetValueByName(json, "maximum");
+    assertTrue(parcJSONValue_GetInteger(value) == 1000, "Expected maximum 1000");
+
+    value = parcJSON_GetValueByName(json, "percentiles");
+    assertNotNull(value, "Expected a percentiles member");
+    PARCJSON *percentiles = parcJSONValue_GetJSON(value);
+    value = parcJSON_GetValueByName(percentiles, "99");
+    assertTrue(parcJSONValue_GetInteger(value) == 990, "Expected p99 990, actual %" PRId64, parcJSONValue_GetInteger(value));
+    value = parcJSON_GetValueByName(percentiles, "99.9");
+    assertNotNull(value, "Expected a 99.9 member");
+
+    parcJSON_Release(&json);
+
+    parcHistogram_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Object, parcHistogram_ToString)
+{
+    PARCHistogram *instance = parcHistogram_Create(1000000, 3);
+
+    char *string = parcHistogram_ToString(instance);
+
+    assertNotNull(string, "Expected non-NULL result from parcHistogram_ToString");
+
+    parcMemory_Deallocate((void **) &string);
+    parcHistogram_Release(&instance);
+}
+
+LONGBOW_TEST_FIXTURE(Specialization)
+{
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_Index);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_Record);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_Record_OutOfRange);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_GetValueAtPercentile);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_GetValueAtPercentile_Precision);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_GetMean);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_Add);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_Add_DifferentPrecision);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcHistogram_Reset);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Specialization)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Specialization)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_Index)
+{
+    PARCHistogram *histogram = parcHistogram_Create(UINT64_MAX, 3);
+
+    // Every value maps to a counter whose range contains it, and the counters are in value order.
+    size_t previousIndex = 0;
+    for (uint64_t value = 0; value < 10000000; value = value + 1 + value / 997) {
+        size_t index = _parcHistogram_CountsIndex(histogram, value);
+        assertTrue(index < histogram->countsLength, "Index %zu out of range for %" PRIu64, index, value);
+        assertTrue(index >= previousIndex, "Expected indexes to be monotonic at %" PRIu64, value);
+
+        uint64_t width;
+        uint64_t lowest = _parcHistogram_ValueFromIndex(histogram, index, &width);
+        assertTrue(lowest <= value && value <= lowest + width - 1,
+                   "Expected %" PRIu64 " within [%" PRIu64 ", %" PRIu64 "]", value, lowest, lowest + width - 1);
+        previousIndex = index;
+    }
+    assertTrue(_parcHistogram_CountsIndex(histogram, UINT64_MAX) < histogram->countsLength, "Expected UINT64_MAX to be in range");
+
+    parcHistogram_Release(&histogram);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_Record)
+{
+    PARCHistogram *histogram = parcHistogram_Create(1000000, 3);
+
+    assertTrue(parcHistogram_GetCount(histogram) == 0, "Expected an empty histogram");
+    assertTrue(parcHistogram_GetMinimum(histogram) == 0, "Expected minimum 0 when empty");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 99.0) == 0, "Expected 0 when empty");
+
+    assertTrue(parcHistogram_Record(histogram, 123456), "Expected the value to be recorded");
+    assertTrue(parcHistogram_Record(histogram, 7), "Expected the value to be recorded");
+    assertTrue(parcHistogram_RecordCount(histogram, 1000, 8), "Expected the value to be recorded");
+    assertTrue(parcHistogram_RecordCount(histogram, 1, 0), "Expected a count of 0 to be accepted");
+    assertTrue(parcHistogram_RecordCount(histogram, 999999, 0), "Expected a count of 0 to be accepted");
+
+    assertTrue(parcHistogram_GetCount(histogram) == 10, "Expected 10, actual %" PRIu64, parcHistogram_GetCount(histogram));
+    assertTrue(parcHistogram_GetMinimum(histogram) == 7, "Expected 7, actual %" PRIu64, parcHistogram_GetMinimum(histogram));
+    assertTrue(parcHistogram_GetMaximum(histogram) == 123456, "Expected 123456, actual %" PRIu64, parcHistogram_GetMaximum(histogram));
+
+    parcHistogram_Release(&histogram);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_Record_OutOfRange)
+{
+    PARCHistogram *histogram = parcHistogram_Create(1000, 3);
+
+    assertTrue(parcHistogram_Record(histogram, 1000), "Expected the highest trackable value to be recorded");
+    assertFalse(parcHistogram_Record(histogram, 1001), "Expected a value above the highest trackable value to be refused");
+    assertTrue(parcHistogram_GetCount(histogram) == 1, "Expected 1, actual %" PRIu64, parcHistogram_GetCount(histogram));
+    assertTrue(parcHistogram_GetMaximum(histogram) == 1000, "Expected 1000, actual %" PRIu64, parcHistogram_GetMaximum(histogram));
+
+    parcHistogram_Release(&histogram);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_GetValueAtPercentile)
+{
+    PARCHistogram *histogram = parcHistogram_Create(1000000, 3);
+
+    // Values below 2048 are recorded exactly at 3 significant digits.
+    for (uint64_t i = 1; i <= 1000; i++) {
+        parcHistogram_Record(histogram, i);
+    }
+
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 0.0) == 1, "Expected p0 1");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 50.0) == 500, "Expected p50 500");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 90.0) == 900, "Expected p90 900");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 99.9) == 999, "Expected p99.9 999");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 100.0) == 1000, "Expected p100 1000");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, -5.0) == 1, "Expected a negative percentile to be clamped to p0");
+    assertTrue(parcHistogram_GetValueAtPercentile(histogram, 150.0) == 1000, "Expected a percentile above 100 to be clamped to p100");
+
+    parcHistogram_Release(&histogram);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_GetValueAtPercentile_Precision)
+{
+    PARCHistogram *histogram = parcHistogram_Create(3600000000000ULL, 3);
+
+    // A long tail: 99% of values near 1 millisecond, 1% near 1 second.
+    for (uint64_t i = 0; i < 9900; i++) {
+        parcHistogram_Record(histogram, 1000000 + i * 10);
+    }
+    for (uint64_t i = 0; i < 100; i++) {
+        parcHistogram_Record(histogram, 1000000000 + i * 1000000);
+    }
+
+    struct {
+        double percentile;
+        uint64_t expected;
+    } cases[] = {
+        { 50.0,  1000000 + 4999 * 10  },
+        { 99.0,  1000000 + 9899 * 10  },
+        { 99.5,  1000000000 + 49 * 1000000 },
+        { 99.99, 1000000000 + 98 * 1000000 },
+    };
+
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        uint64_t actual = parcHistogram_GetValueAtPercentile(histogram, cases[i].percentile);
+        double error = fabs((double) actual - (double) cases[i].expected) / (double) cases[i].expected;
+        assertTrue(error <= 0.001, "Expected p%g within 0.1%% of %" PRIu64 ", actual %" PRIu64,
+                   cases[i].percentile, cases[i].expected, actual);
+    }
+
+    parcHistogram_Release(&histogram);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_GetMean)
+{
+    PARCHistogram *histogram = parcHistogram_Create(1000000, 3);
+
+    parcHistogram_Record(histogram, 2);
+    parcHistogram_Record(histogram, 4);
+    parcHistogram_Record(histogram, 4);
+    parcHistogram_Record(histogram, 4);
+    parcHistogram_Record(histogram, 5);
+    parcHistogram_Record(histogram, 5);
+    parcHistogram_Record(histogram, 7);
+    parcHistogram_Record(histogram, 9);
+
+    assertTrue(parcHistogram_GetMean(histogram) == 5.0, "Expected mean 5, actual %g", parcHistogram_GetMean(histogram));
+    assertTrue(parcHistogram_GetStandardDeviation(histogram) == 2.0,
+               "Expected standard deviation 2, actual %g", parcHistogram_GetStandardDeviation(histogram));
+
+    parcHistogram_Release(&histogram);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_Add)
+{
+    PARCHistogram *x = parcHistogram_Create(1000000, 3);
+    PARCHistogram *y = parcHistogram_Create(1000000, 3);
+    PARCHistogram *expected = parcHistogram_Create(1000000, 3);
+
+    for (uint64_t i = 1; i <= 500; i++) {
+        parcHistogram_Record(x, i * 3);
+        parcHistogram_Record(expected, i * 3);
+    }
+    for (uint64_t i = 501; i <= 1000; i++) {
+        parcHistogram_Record(y, i * 997);
+        parcHistogram_Record(expected, i * 997);
+    }
+
+    uint64_t dropped = parcHistogram_Add(x, y);
+    assertTrue(dropped == 0, "Expected nothing dropped, actual %" PRIu64, dropped);
+    assertTrue(parcHistogram_Equals(x, expected), "Expected the sum to equal recording every value in one histogram");
+
+    parcHistogram_Release(&x);
+    parcHistogram_Release(&y);
+    parcHistogram_Release(&expected);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_Add_DifferentPrecision)
+{
+    PARCHistogram *x = parcHistogram_Create(1000, 2);
+    PARCHistogram *y = parcHistogram_Create(1000000, 3);
+
+    parcHistogram_Record(x, 10);
+    parcHistogram_RecordCount(y, 500, 9);
+    parcHistogram_Record(y, 5000);
+
+    uint64_t dropped = parcHistogram_Add(x, y);
+    assertTrue(dropped == 1, "Expected the value above 1000 dropped, actual %" PRIu64, dropped);
+    assertTrue(parcHistogram_GetCount(x) == 10, "Expected 10, actual %" PRIu64, parcHistogram_GetCount(x));
+    uint64_t p90 = parcHistogram_GetValueAtPercentile(x, 90.0);
+    assertTrue(p90 >= 495 && p90 <= 505, "Expected p90 near 500, actual %" PRIu64, p90);
+
+    parcHistogram_Release(&x);
+    parcHistogram_Release(&y);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcHistogram_Reset)
+{
+    PARCHistogram *histogram = parcHistogram_Create(1000000, 3);
+    PARCHistogram *empty = parcHistogram_Create(1000000, 3);
+
+    parcHistogram_Record(histogram, 17);
+    parcHistogram_Record(histogram, 170000);
+    parcHistogram_Reset(histogram);
+
+    assertTrue(parcHistogram_Equals(histogram, empty), "Expected a reset histogram to equal an empty one");
+
+    parcHistogram_Release(&histogram);
+    parcHistogram_Release(&empty);
+}
+
+#define _THREAD_COUNT 4
+#define _VALUES_PER_THREAD 100000
+
+static void *
+_recordValues(void *arg)
+{
+    PARCHistogram *histogram = arg;
+    for (uint64_t i = 1; i <= _VALUES_PER_THREAD; i++) {
+        parcHistogram_Record(histogram, i);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcHistogram_Record);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcHistogram_Record)
+{
+    PARCHistogram *histogram = parcHistogram_Create(1000000, 3);
+    PARCHistogram *expected = parcHistogram_Create(1000000, 3);
+
+    pthread_t threads[_THREAD_COUNT];
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, _recordValues, histogram);
+    }
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+        _recordValues(expected);
+    }
+
+    assertTrue(parcHistogram_GetCount(histogram) == _THREAD_COUNT * _VALUES_PER_THREAD,
+               "Expected %d, actual %" PRIu64, _THREAD_COUNT * _VALUES_PER_THREAD, parcHistogram_GetCount(histogram));
+    assertTrue(parcHistogram_Equals(histogram, expected), "Expected no lost updates");
+
+    parcHistogram_Release(&histogram);
+    parcHistogram_Release(&expected);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcHistogram_Record);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _PERFORMANCE_VALUES 10000000
+
+static void *
+_recordPerformanceValues(void *arg)
+{
+    PARCHistogram *histogram = arg;
+    uint64_t value = 88172645463325252ULL;
+    for (int i = 0; i < _PERFORMANCE_VALUES; i++) {
+        // xorshift, scaled to a latency-like range up to about 1 second.
+        value ^= value << 13;
+        value ^= value >> 7;
+        value ^= value << 17;
+        parcHistogram_Record(histogram, value >> 34);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Performance, parcHistogram_Record)
+{
+    PARCHistogram *histogram = parcHistogram_Create(3600000000000ULL, 3);
+
+    uint64_t start = parcTime_NowNanoseconds();
+    _recordPerformanceValues(histogram);
+    uint64_t elapsed = parcTime_NowNanoseconds() - start;
+    printf("1 thread: %.1f ns per Record\n", (double) elapsed / _PERFORMANCE_VALUES);
+
+    parcHistogram_Reset(histogram);
+
+    pthread_t threads[_THREAD_COUNT];
+    start = parcTime_NowNanoseconds();
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, _recordPerformanceValues, histogram);
+    }
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    elapsed = parcTime_NowNanoseconds() - start;
+    printf("%d threads: %.1f ns per Record\n", _THREAD_COUNT, (double) elapsed / (_THREAD_COUNT * _PERFORMANCE_VALUES));
+
+    parcHistogram_Display(histogram, 0);
+    parcHistogram_Release(&histogram);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_Histogram);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
@@ -0,0 +1,570 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_Metrics.c"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+#include <parc/algol/parc_FileOutputStream.h>
+#include <parc/algol/parc_Time.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+LONGBOW_TEST_RUNNER(parc_Metrics)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
+    LONGBOW_RUN_TEST_FIXTURE(Object);
+    LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_Metrics)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_Metrics)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(CreateAcquireRelease)
+{
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateRelease);
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, parcMetricsCounter_CreateRelease);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(CreateAcquireRelease)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(CreateAcquireRelease)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateRelease)
+{
+    PARCMetrics *instance = parcMetrics_Create();
+    assertNotNull(instance, "Expected non-null result from parcMetrics_Create();");
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcMetrics_Acquire, instance);
+
+    parcMetrics_Release(&instance);
+    assertNull(instance, "Expected null result from parcMetrics_Release();");
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, parcMetricsCounter_CreateRelease)
+{
+    PARCMetricsCounter *instance = parcMetricsCounter_Create();
+    assertNotNull(instance, "Expected non-null result from parcMetricsCounter_Create();");
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcMetricsCounter_Acquire, instance);
+
+    parcMetricsCounter_Release(&instance);
+    assertNull(instance, "Expected null result from parcMetricsCounter_Release();");
+}
+
+LONGBOW_TEST_FIXTURE(Object)
+{
+    LONGBOW_RUN_TEST_CASE(Object, parcMetrics_Display);
+    LONGBOW_RUN_TEST_CASE(Object, parcMetrics_IsValid);
+    LONGBOW_RUN_TEST_CASE(Object, parcMetrics_ToJSON);
+    LONGBOW_RUN_TEST_CASE(Object, parcMetrics_ToString);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Object)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Object)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+static int64_t
+_fortyTwo(const PARCObject *object)
+{
+    return 42;
+}
+
+static int64_t
+_histogramCount(const PARCObject *histogram)
+{
+    return (int64_t) parcHistogram_GetCount(histogram);
+}
+
+/**
+ * A registry with one metric of each kind.
+ */
+static PARCMetrics *
+_createMetrics(void)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+
+    parcMetricsCounter_Add(parcMetrics_Counter(metrics, "test.counter"), 7);
+    parcMetrics_AddGauge(metrics, "test.gauge", _fortyTwo, NULL);
+
+    PARCHistogram *histogram = parcHistogram_Create(1000000, 3);
+    parcHistogram_Record(histogram, 100);
+    parcMetrics_AddHistogram(metrics, "test.histogram", histogram);
+    parcHistogram_Release(&histogram);
+
+    return metrics;
+}
+
+LONGBOW_TEST_CASE(Object, parcMetrics_Display)
+{
+    PARCMetrics *instance = _createMetrics();
+    parcMetrics_Display(instance, 0);
+    parcMetrics_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Object, parcMetrics_IsValid)
+{
+    PARCMetrics *instance = parcMetrics_Create();
+    assertTrue(parcMetrics_IsValid(instance), "Expected parcMetrics_Create to result in a valid instance.");
+
+    parcMetrics_Release(&instance);
+    assertFalse(parcMetrics_IsValid(instance), "Expected parcMetrics_Release to result in an invalid instance.");
+}
+
+LONGBOW_TEST_CASE(Object, parcMetrics_ToJSON)
+{
+    PARCMetrics *instance = _createMetrics();
+
+    PARCJSON *json = parcMetrics_ToJSON(instance);
+
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "test.counter");
+    assertTrue(parcJSONValue_GetInteger(value) == 7, "Expected test.counter 7");
+
+    value = parcJSON_GetValueByName(json, "test.gauge");
+    assertTrue(parcJSONValue_GetInteger(value) == 42, "Expected test.gauge 42");
+
+    value = parcJSON_GetValueByName(json, "test.histogram");
+    assertTrue(parcJSONValue_IsJSON(value), "Expected test.histogram to be an object");
+    value = parcJSON_GetValueByName(parcJSONValue_GetJSON(value), "count");
+    assertTrue(parcJSONValue_GetInteger(value) == 1, "Expected the histogram count 1");
+
+    parcJSON_Release(&json);
+    parcMetrics_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Object, parcMetrics_ToString)
+{
+    PARCMetrics *instance = _createMetrics();
+
+    char *string = parcMetrics_ToString(instance);
+    assertNotNull(string, "Expected non-NULL result from parcMetrics_ToString");
+
+    // Members are in order of name.
+    char *counter = strstr(string, "test.counter");
+    char *gauge = strstr(string, "test.gauge");
+    char *histogram = strstr(string, "test.histogram");
+    assertTrue(counter != NULL && counter < gauge && gauge < histogram, "Expected the metrics in order of name: %s", string);
+
+    parcMemory_Deallocate((void **) &string);
+    parcMetrics_Release(&instance);
+}
+
+LONGBOW_TEST_FIXTURE(Specialization)
+{
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_Counter);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_Counter_WrongKind);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_AddCounter);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_AddGauge_Object);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_Remove);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_Many);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_Dump);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcMetrics_StartPeriodicDump);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Specialization)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Specialization)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_Counter)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+
+    PARCMetricsCounter *counter = parcMetrics_Counter(metrics, "requests");
+    parcMetricsCounter_Increment(counter);
+    parcMetricsCounter_Add(counter, 10);
+
+    assertTrue(parcMetrics_Counter(metrics, "requests") == counter, "Expected the same counter for the same name");
+    assertTrue(parcMetricsCounter_GetValue(counter) == 11, "Expected 11, actual %" PRIu64, parcMetricsCounter_GetValue(counter));
+    assertTrue(parcMetrics_Size(metrics) == 1, "Expected 1 metric, actual %zu", parcMetrics_Size(metrics));
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_Counter_WrongKind)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+
+    parcMetrics_AddGauge(metrics, "depth", _fortyTwo, NULL);
+    assertNull(parcMetrics_Counter(metrics, "depth"), "Expected NULL for a name registered to a gauge");
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_AddCounter)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+    PARCMetricsCounter *counter = parcMetricsCounter_Create();
+
+    assertTrue(parcMetrics_AddCounter(metrics, "hits", counter), "Expected the counter to be registered");
+    assertFalse(parcMetrics_AddCounter(metrics, "hits", counter), "Expected a duplicate name to be refused");
+    assertFalse(parcMetrics_AddGauge(metrics, "hits", _fortyTwo, NULL), "Expected a duplicate name to be refused");
+
+    // The registry holds its own reference.
+    parcMetricsCounter_Increment(counter);
+    parcMetricsCounter_Release(&counter);
+    assertTrue(parcMetricsCounter_GetValue(parcMetrics_Counter(metrics, "hits")) == 1, "Expected the registered counter to survive");
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_AddGauge_Object)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+    PARCHistogram *histogram = parcHistogram_Create(1000, 2);
+
+    parcMetrics_AddGauge(metrics, "latency.count", _histogramCount, histogram);
+    parcHistogram_Record(histogram, 5);
+    parcHistogram_Record(histogram, 6);
+    parcHistogram_Release(&histogram);
+
+    PARCJSON *json = parcMetrics_ToJSON(metrics);
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "latency.count");
+    assertTrue(parcJSONValue_GetInteger(value) == 2, "Expected 2, actual %" PRId64, parcJSONValue_GetInteger(value));
+    parcJSON_Release(&json);
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_Remove)
+{
+    PARCMetrics *metrics = _createMetrics();
+
+    assertTrue(parcMetrics_Remove(metrics, "test.gauge"), "Expected the gauge to be removed");
+    assertFalse(parcMetrics_Remove(metrics, "test.gauge"), "Expected nothing to remove");
+    assertTrue(parcMetrics_Remove(metrics, "test.histogram"), "Expected the histogram to be removed");
+    assertTrue(parcMetrics_Size(metrics) == 1, "Expected 1 metric, actual %zu", parcMetrics_Size(metrics));
+
+    PARCJSON *json = parcMetrics_ToJSON(metrics);
+    assertNull(parcJSON_GetValueByName(json, "test.gauge"), "Expected the gauge to be gone");
+    assertNotNull(parcJSON_GetValueByName(json, "test.counter"), "Expected the counter to remain");
+    parcJSON_Release(&json);
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_Many)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+
+    // Enough to grow the registry, registered out of order.
+    for (int i = 0; i < 100; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "counter.%03d", (i * 37) % 100);
+        parcMetricsCounter_Add(parcMetrics_Counter(metrics, name), (i * 37) % 100);
+    }
+    assertTrue(parcMetrics_Size(metrics) == 100, "Expected 100 metrics, actual %zu", parcMetrics_Size(metrics));
+
+    for (size_t i = 0; i < metrics->length; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "counter.%03zu", i);
+        assertTrue(strcmp(metrics->entries[i].name, name) == 0, "Expected %s, actual %s", name, metrics->entries[i].name);
+        assertTrue(parcMetricsCounter_GetValue(metrics->entries[i].counter) == i, "Expected %zu", i);
+    }
+
+    parcMetrics_Release(&metrics);
+}
+
+static char *
+_readFile(const char *path)
+{
+    static char contents[4096];
+
+    int fd = open(path, O_RDONLY);
+    ssize_t length = read(fd, contents, sizeof(contents) - 1);
+    close(fd);
+    contents[length < 0 ? 0 : length] = 0;
+
+    return contents;
+}
+
+static PARCOutputStream *
+_createFileOutputStream(const char *path)
+{
+    PARCFileOutputStream *fileOutput = parcFileOutputStream_Create(open(path, O_CREAT | O_WRONLY | O_TRUNC, 0600));
+    PARCOutputStream *result = parcFileOutputStream_AsOutputStream(fileOutput);
+    parcFileOutputStream_Release(&fileOutput);
+
+    return result;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_Dump)
+{
+    const char *path = "/tmp/test_parc_Metrics_Dump";
+    PARCMetrics *metrics = _createMetrics();
+    PARCOutputStream *output = _createFileOutputStream(path);
+
+    assertTrue(parcMetrics_Dump(metrics, output), "Expected the snapshot to be written");
+    parcOutputStream_Release(&output);
+
+    char *contents = _readFile(path);
+    unlink(path);
+
+    size_t length = strlen(contents);
+    assertTrue(length > 0 && contents[0] == '{' && contents[length - 1] == '\n' && strchr(contents, '\n') == &contents[length - 1], "Expected one line of JSON, actual '%s'", contents);
+    assertNotNull(strstr(contents, "\"test.gauge\":42"), "Expected the gauge in '%s'", contents);
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcMetrics_StartPeriodicDump)
+{
+    const char *path = "/tmp/test_parc_Metrics_StartPeriodicDump";
+    PARCMetrics *metrics = _createMetrics();
+    PARCOutputStream *output = _createFileOutputStream(path);
+
+    assertTrue(parcMetrics_StartPeriodicDump(metrics, output, 10 * 1000000ULL), "Expected the dump to start");
+    assertFalse(parcMetrics_StartPeriodicDump(metrics, output, 10 * 1000000ULL), "Expected a second dump to be refused");
+    parcOutputStream_Release(&output);
+
+    usleep(100 * 1000);
+    parcMetrics_StopPeriodicDump(metrics);
+
+    char *contents = _readFile(path);
+    unlink(path);
+
+    int lines = 0;
+    for (char *c = contents; *c != 0; c++) {
+        lines += (*c == '\n');
+    }
+    assertTrue(lines >= 2, "Expected several snapshots, actual %d", lines);
+
+    // Releasing the registry stops a running dump.
+    output = _createFileOutputStream(path);
+    parcMetrics_StartPeriodicDump(metrics, output, 1000000000ULL);
+    parcOutputStream_Release(&output);
+    unlink(path);
+
+    parcMetrics_Release(&metrics);
+}
+
+#define _THREAD_COUNT 4
+#define _INCREMENTS_PER_THREAD 100000
+
+static void *
+_incrementer(void *arg)
+{
+    PARCMetricsCounter *counter = arg;
+    for (int i = 0; i < _INCREMENTS_PER_THREAD; i++) {
+        parcMetricsCounter_Increment(counter);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcMetricsCounter_Increment);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcMetricsCounter_Increment)
+{
+    PARCMetrics *metrics = parcMetrics_Create();
+    PARCMetricsCounter *counter = parcMetrics_Counter(metrics, "increments");
+
+    pthread_t threads[_THREAD_COUNT];
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, _incrementer, counter);
+    }
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    assertTrue(parcMetricsCounter_GetValue(counter) == _THREAD_COUNT * _INCREMENTS_PER_THREAD,
+               "Expected %d, actual %" PRIu64, _THREAD_COUNT * _INCREMENTS_PER_THREAD, parcMetricsCounter_GetValue(counter));
+
+    parcMetrics_Release(&metrics);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcMetricsCounter_Increment);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _PERFORMANCE_INCREMENTS 10000000
+
+static volatile uint64_t _sharedCount;
+
+static void *
+_sharedIncrementer(void *arg)
+{
+    for (int i = 0; i < _PERFORMANCE_INCREMENTS; i++) {
+        __sync_fetch_and_add(&_sharedCount, 1);
+    }
+    return NULL;
+}
+
+static void *
+_counterIncrementer(void *arg)
+{
+    PARCMetricsCounter *counter = arg;
+    for (int i = 0; i < _PERFORMANCE_INCREMENTS; i++) {
+        parcMetricsCounter_Increment(counter);
+    }
+    return NULL;
+}
+
+static double
+_timeIncrements(void *(*incrementer)(void *), void *arg, int threadCount)
+{
+    pthread_t threads[threadCount];
+    uint64_t start = parcTime_NowNanoseconds();
+    for (int i = 0; i < threadCount; i++) {
+        pthread_create(&threads[i], NULL, incrementer, arg);
+    }
+    for (int i = 0; i < threadCount; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    return (double) (parcTime_NowNanoseconds() - start) / ((double) threadCount * _PERFORMANCE_INCREMENTS);
+}
+
+LONGBOW_TEST_CASE(Performance, parcMetricsCounter_Increment)
+{
+    PARCMetricsCounter *counter = parcMetricsCounter_Create();
+
+    for (int threadCount = 1; threadCount <= _THREAD_COUNT; threadCount *= 2) {
+        double shared = _timeIncrements(_sharedIncrementer, NULL, threadCount);
+        double sharded = _timeIncrements(_counterIncrementer, counter, threadCount);
+        printf("%d threads: shared atomic %.1f ns, sharded counter %.1f ns per increment\n", threadCount, shared, sharded);
+    }
+
+    parcMetricsCounter_Release(&counter);
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_Metrics);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}
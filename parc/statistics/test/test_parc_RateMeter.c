@@ -0,0 +1,480 @@
+/*
+ * Copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC)
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * * Redistributions of source code must retain the above copyright
+ *   notice, this list of conditions and the following disclaimer.
+ * * Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL XEROX OR PARC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ################################################################################
+ * #
+ * # PATENT NOTICE
+ * #
+ * # This software is distributed under the BSD 2-clause License (see LICENSE
+ * # file).  This BSD License does not make any patent claims and as such, does
+ * # not act as a patent grant.  The purpose of this section is for each contributor
+ * # to define their intentions with respect to intellectual property.
+ * #
+ * # Each contributor to this source code is encouraged to state their patent
+ * # claims and licensing mechanisms for any contributions made. At the end of
+ * # this section contributors may each make their own statements.  Contributor's
+ * # claims and grants only apply to the pieces (source code, programs, text,
+ * # media, etc) that they have contributed directly to this software.
+ * #
+ * # There is no guarantee that this section is complete, up to date or accurate. It
+ * # is up to the contributors to maintain their portion of this section and up to
+ * # the user of the software to verify any claims herein.
+ * #
+ * # Do not remove this header notification.  The contents of this section must be
+ * # present in all distributions of the software.  You may only modify your own
+ * # intellectual property statements.  Please provide contact information.
+ *
+ * - Palo Alto Research Center, Inc
+ * This software distribution does not grant any rights to patents owned by Palo
+ * Alto Research Center, Inc (PARC). Rights to these patents are available via
+ * various mechanisms. As of January 2016 PARC has committed to FRAND licensing any
+ * intellectual property used by its contributions to this software. You may
+ * contact PARC at cipo@parc.com for more information or visit http://www.ccnx.org
+ */
+/**
+ * @author Computing Science Laboratory, PARC
+ * @copyright (c) 2016, Xerox Corporation (Xerox) and Palo Alto Research Center, Inc (PARC).  All rights reserved.
+ */
+#include "../parc_RateMeter.c"
+
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+
+#include <LongBow/testing.h>
+#include <LongBow/debugging.h>
+#include <parc/algol/parc_Memory.h>
+#include <parc/algol/parc_SafeMemory.h>
+
+#include <parc/testing/parc_MemoryTesting.h>
+#include <parc/testing/parc_ObjectTesting.h>
+
+// An arbitrary time, in nanoseconds, at which the meters in these tests are created.
+#define _START (1000 * _NANOSECONDS_PER_SECOND)
+
+LONGBOW_TEST_RUNNER(parc_RateMeter)
+{
+    // The following Test Fixtures will run their corresponding Test Cases.
+    // Test Fixtures are run in the order specified, but all tests should be idempotent.
+    // Never rely on the execution order of tests or share state between them.
+    LONGBOW_RUN_TEST_FIXTURE(CreateAcquireRelease);
+    LONGBOW_RUN_TEST_FIXTURE(Object);
+    LONGBOW_RUN_TEST_FIXTURE(Specialization);
+    LONGBOW_RUN_TEST_FIXTURE(Concurrent);
+    LONGBOW_RUN_TEST_FIXTURE(Performance);
+}
+
+// The Test Runner calls this function once before any Test Fixtures are run.
+LONGBOW_TEST_RUNNER_SETUP(parc_RateMeter)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+// The Test Runner calls this function once after all the Test Fixtures are run.
+LONGBOW_TEST_RUNNER_TEARDOWN(parc_RateMeter)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE(CreateAcquireRelease)
+{
+    LONGBOW_RUN_TEST_CASE(CreateAcquireRelease, CreateRelease);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(CreateAcquireRelease)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(CreateAcquireRelease)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s leaked memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(CreateAcquireRelease, CreateRelease)
+{
+    PARCRateMeter *instance = parcRateMeter_Create();
+    assertNotNull(instance, "Expected non-null result from parcRateMeter_Create();");
+
+    parcObjectTesting_AssertAcquireReleaseContract(parcRateMeter_Acquire, instance);
+
+    parcRateMeter_Release(&instance);
+    assertNull(instance, "Expected null result from parcRateMeter_Release();");
+}
+
+LONGBOW_TEST_FIXTURE(Object)
+{
+    LONGBOW_RUN_TEST_CASE(Object, parcRateMeter_Display);
+    LONGBOW_RUN_TEST_CASE(Object, parcRateMeter_IsValid);
+    LONGBOW_RUN_TEST_CASE(Object, parcRateMeter_ToJSON);
+    LONGBOW_RUN_TEST_CASE(Object, parcRateMeter_ToString);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Object)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Object)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Object, parcRateMeter_Display)
+{
+    PARCRateMeter *instance = parcRateMeter_Create();
+    parcRateMeter_Mark(instance, 3);
+    parcRateMeter_Display(instance, 0);
+    parcRateMeter_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Object, parcRateMeter_IsValid)
+{
+    PARCRateMeter *instance = parcRateMeter_Create();
+    assertTrue(parcRateMeter_IsValid(instance), "Expected parcRateMeter_Create to result in a valid instance.");
+
+    parcRateMeter_Release(&instance);
+    assertFalse(parcRateMeter_IsValid(instance), "Expected parcRateMeter_Release to result in an invalid instance.");
+}
+
+LONGBOW_TEST_CASE(Object, parcRateMeter_ToJSON)
+{
+    PARCRateMeter *instance = parcRateMeter_Create();
+    parcRateMeter_Mark(instance, 42);
+
+    PARCJSON *json = parcRateMeter_ToJSON(instance);
+
+    const PARCJSONValue *value = parcJSON_GetValueByName(json, "count");
+    assertTrue(parcJSONValue_GetInteger(value) == 42, "Expected count 42");
+    assertNotNull(parcJSON_GetValueByName(json, "fifteenMinuteRate"), "Expected a fifteenMinuteRate member");
+
+    parcJSON_Release(&json);
+    parcRateMeter_Release(&instance);
+}
+
+LONGBOW_TEST_CASE(Object, parcRateMeter_ToString)
+{
+    PARCRateMeter *instance = parcRateMeter_Create();
+
+    char *string = parcRateMeter_ToString(instance);
+
+    assertNotNull(string, "Expected non-NULL result from parcRateMeter_ToString");
+
+    parcMemory_Deallocate((void **) &string);
+    parcRateMeter_Release(&instance);
+}
+
+LONGBOW_TEST_FIXTURE(Specialization)
+{
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_Mark);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_GetMeanRate);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_GetWindowRate);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_GetWindowRate_StaleBuckets);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_Tick_NotDue);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_GetOneMinuteRate_Steady);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_GetOneMinuteRate_Decay);
+    LONGBOW_RUN_TEST_CASE(Specialization, parcRateMeter_GetFifteenMinuteRate_Slower);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Specialization)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Specialization)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+/**
+ * Mark @p perSecond events in each of @p seconds seconds, starting at @p start, and return the time after the last second.
+ */
+static uint64_t
+_markSteadily(PARCRateMeter *meter, uint64_t perSecond, unsigned seconds, uint64_t start)
+{
+    for (unsigned i = 0; i < seconds; i++) {
+        _parcRateMeter_MarkAt(meter, perSecond, start + i * _NANOSECONDS_PER_SECOND);
+    }
+    return start + seconds * _NANOSECONDS_PER_SECOND;
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_Mark)
+{
+    PARCRateMeter *meter = parcRateMeter_Create();
+
+    parcRateMeter_Mark(meter, 1);
+    parcRateMeter_Mark(meter, 10);
+    parcRateMeter_Mark(meter, 100);
+
+    assertTrue(parcRateMeter_GetCount(meter) == 111, "Expected 111, actual %" PRIu64, parcRateMeter_GetCount(meter));
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_GetMeanRate)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    uint64_t now = _markSteadily(meter, 25, 10, _START);
+
+    double rate = _parcRateMeter_MeanRateAt(meter, now);
+    assertTrue(fabs(rate - 25.0) < 0.001, "Expected 25, actual %lf", rate);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_GetWindowRate)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    _parcRateMeter_MarkAt(meter, 5, _START + 100);
+    _parcRateMeter_MarkAt(meter, 7, _START + _NANOSECONDS_PER_SECOND + 100);
+    _parcRateMeter_MarkAt(meter, 1000, _START + 2 * _NANOSECONDS_PER_SECOND + 100);
+
+    uint64_t now = _START + 2 * _NANOSECONDS_PER_SECOND + 500;
+
+    // The events of the current second are not counted.
+    double rate = _parcRateMeter_WindowRateAt(meter, 1, now);
+    assertTrue(rate == 7.0, "Expected 7, actual %lf", rate);
+
+    rate = _parcRateMeter_WindowRateAt(meter, 2, now);
+    assertTrue(rate == 6.0, "Expected 6, actual %lf", rate);
+
+    rate = _parcRateMeter_WindowRateAt(meter, 4, now);
+    assertTrue(rate == 3.0, "Expected 3, actual %lf", rate);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_GetWindowRate_StaleBuckets)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    _parcRateMeter_MarkAt(meter, 5, _START);
+
+    // A later second sharing the same bucket replaces the old count rather than adding to it.
+    uint64_t later = _START + _WINDOW_BUCKETS * _NANOSECONDS_PER_SECOND;
+    _parcRateMeter_MarkAt(meter, 3, later);
+
+    double rate = _parcRateMeter_WindowRateAt(meter, 1, later + _NANOSECONDS_PER_SECOND);
+    assertTrue(rate == 3.0, "Expected 3, actual %lf", rate);
+
+    // Nor is a bucket last used a full ring ago counted for the second that maps to it now.
+    rate = _parcRateMeter_WindowRateAt(meter, 1, _START + 2 * _WINDOW_BUCKETS * _NANOSECONDS_PER_SECOND + _NANOSECONDS_PER_SECOND);
+    assertTrue(rate == 0.0, "Expected 0, actual %lf", rate);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_Tick_NotDue)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    _parcRateMeter_MarkAt(meter, 100, _START + _TICK_INTERVAL - 1);
+    assertTrue(meter->lastTick == _START, "Expected no tick before the tick interval");
+    assertTrue(parcEWMA_GetValue(meter->oneMinute) == 0, "Expected no rate before the first tick");
+
+    _parcRateMeter_MarkAt(meter, 0, _START + _TICK_INTERVAL);
+    assertTrue(meter->lastTick == _START + _TICK_INTERVAL, "Expected a tick at the tick interval");
+
+    double rate = _parcRateMeter_Rate(meter->oneMinute);
+    assertTrue(fabs(rate - 20.0) < 0.001, "Expected 20, actual %lf", rate);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_GetOneMinuteRate_Steady)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    // The marks themselves tick every 5 seconds, each tick seeing 500 events.
+    _markSteadily(meter, 100, 600, _START);
+
+    double rate = _parcRateMeter_Rate(meter->oneMinute);
+    assertTrue(fabs(rate - 100.0) < 0.1, "Expected 100, actual %lf", rate);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_GetOneMinuteRate_Decay)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    uint64_t now = _markSteadily(meter, 100, 600, _START);
+    _parcRateMeter_TickIfDue(meter, now);
+    double steady = _parcRateMeter_Rate(meter->oneMinute);
+
+    // One idle minute, seen as a single tick, decays the one minute rate by a factor of e.
+    _parcRateMeter_TickIfDue(meter, now + 60 * _NANOSECONDS_PER_SECOND);
+
+    double rate = _parcRateMeter_Rate(meter->oneMinute);
+    assertTrue(fabs(rate - steady * exp(-1.0)) < 0.01, "Expected %lf, actual %lf", steady * exp(-1.0), rate);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_CASE(Specialization, parcRateMeter_GetFifteenMinuteRate_Slower)
+{
+    PARCRateMeter *meter = _parcRateMeter_Create(_START);
+
+    uint64_t now = _markSteadily(meter, 10, 60, _START);
+    now = _markSteadily(meter, 1000, 60, now);
+    _parcRateMeter_TickIfDue(meter, now);
+
+    double one = _parcRateMeter_Rate(meter->oneMinute);
+    double five = _parcRateMeter_Rate(meter->fiveMinute);
+    double fifteen = _parcRateMeter_Rate(meter->fifteenMinute);
+
+    assertTrue(one > five && five > fifteen && fifteen > 10.0,
+               "Expected longer averages to follow a burst more slowly, actual %lf %lf %lf", one, five, fifteen);
+
+    parcRateMeter_Release(&meter);
+}
+
+#define _THREAD_COUNT 4
+#define _MARKS_PER_THREAD 100000
+
+static void *
+_marker(void *arg)
+{
+    PARCRateMeter *meter = arg;
+    for (int i = 0; i < _MARKS_PER_THREAD; i++) {
+        parcRateMeter_Mark(meter, 1);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_FIXTURE(Concurrent)
+{
+    LONGBOW_RUN_TEST_CASE(Concurrent, parcRateMeter_Mark);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Concurrent)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Concurrent)
+{
+    if (!parcMemoryTesting_ExpectedOutstanding(0, "%s mismanaged memory.", longBowTestCase_GetFullName(testCase))) {
+        return LONGBOW_STATUS_MEMORYLEAK;
+    }
+
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_CASE(Concurrent, parcRateMeter_Mark)
+{
+    PARCRateMeter *meter = parcRateMeter_Create();
+
+    pthread_t threads[_THREAD_COUNT];
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_create(&threads[i], NULL, _marker, meter);
+    }
+    for (int i = 0; i < _THREAD_COUNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    assertTrue(parcRateMeter_GetCount(meter) == _THREAD_COUNT * _MARKS_PER_THREAD,
+               "Expected %d, actual %" PRIu64, _THREAD_COUNT * _MARKS_PER_THREAD, parcRateMeter_GetCount(meter));
+
+    // Every mark landed in some bucket of the window.
+    uint64_t windowed = 0;
+    for (int i = 0; i < _WINDOW_BUCKETS; i++) {
+        windowed += meter->window[i] & _BUCKET_COUNT_MASK;
+    }
+    assertTrue(windowed == _THREAD_COUNT * _MARKS_PER_THREAD,
+               "Expected %d in the window, actual %" PRIu64, _THREAD_COUNT * _MARKS_PER_THREAD, windowed);
+
+    parcRateMeter_Release(&meter);
+}
+
+LONGBOW_TEST_FIXTURE_OPTIONS(Performance, .enabled = false)
+{
+    LONGBOW_RUN_TEST_CASE(Performance, parcRateMeter_Mark);
+}
+
+LONGBOW_TEST_FIXTURE_SETUP(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+LONGBOW_TEST_FIXTURE_TEARDOWN(Performance)
+{
+    return LONGBOW_STATUS_SUCCEEDED;
+}
+
+#define _PERFORMANCE_MARKS 10000000
+
+static void *
+_performanceMarker(void *arg)
+{
+    PARCRateMeter *meter = arg;
+    for (int i = 0; i < _PERFORMANCE_MARKS; i++) {
+        parcRateMeter_Mark(meter, 1);
+    }
+    return NULL;
+}
+
+LONGBOW_TEST_CASE(Performance, parcRateMeter_Mark)
+{
+    for (int threadCount = 1; threadCount <= _THREAD_COUNT; threadCount *= 2) {
+        PARCRateMeter *meter = parcRateMeter_Create();
+
+        pthread_t threads[threadCount];
+        uint64_t start = parcTime_NowNanoseconds();
+        for (int i = 0; i < threadCount; i++) {
+            pthread_create(&threads[i], NULL, _performanceMarker, meter);
+        }
+        for (int i = 0; i < threadCount; i++) {
+            pthread_join(threads[i], NULL);
+        }
+        uint64_t elapsed = parcTime_NowNanoseconds() - start;
+
+        printf("%d threads: %.1f ns per Mark\n", threadCount, (double) elapsed / ((double) threadCount * _PERFORMANCE_MARKS));
+
+        parcRateMeter_Release(&meter);
+    }
+}
+
+int
+main(int argc, char *argv[argc])
+{
+    LongBowRunner *testRunner = LONGBOW_TEST_RUNNER_CREATE(parc_RateMeter);
+    int exitStatus = LONGBOW_TEST_MAIN(argc, argv, testRunner);
+    longBowTestRunner_Destroy(&testRunner);
+    exit(exitStatus);
+}